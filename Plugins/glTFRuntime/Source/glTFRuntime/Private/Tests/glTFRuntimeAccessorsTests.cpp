@@ -0,0 +1,228 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeParser.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/Base64.h"
+
+namespace glTFRuntimeAccessorsTests
+{
+	// the glTF normalized integers formulas, computed one component at a time
+	float ReferenceComponent(const float Value, const bool bNormalized) { return Value; }
+	float ReferenceComponent(const int8 Value, const bool bNormalized) { return bNormalized ? FMath::Max(((float)Value) / 127.f, -1.f) : Value; }
+	float ReferenceComponent(const uint8 Value, const bool bNormalized) { return bNormalized ? ((float)Value) / 255.f : Value; }
+	float ReferenceComponent(const int16 Value, const bool bNormalized) { return bNormalized ? FMath::Max(((float)Value) / 32767.f, -1.f) : Value; }
+	float ReferenceComponent(const uint16 Value, const bool bNormalized) { return bNormalized ? ((float)Value) / 65535.f : Value; }
+
+	bool IsSameFloat(const float A, const float B)
+	{
+		return FMemory::Memcmp(&A, &B, sizeof(float)) == 0;
+	}
+
+	// random components, starting with the extremes of the type
+	template<typename ComponentType>
+	TArray<ComponentType> MakeComponents(const int32 Num, const int32 Seed)
+	{
+		FRandomStream RandomStream(Seed);
+		TArray<ComponentType> Components;
+		Components.Add(TNumericLimits<ComponentType>::Min());
+		Components.Add(TNumericLimits<ComponentType>::Max());
+		Components.Add(0);
+		while (Components.Num() < Num)
+		{
+			Components.Add(static_cast<ComponentType>(RandomStream.GetUnsignedInt()));
+		}
+		Components.SetNum(Num);
+		return Components;
+	}
+
+	template<typename ComponentType>
+	bool TestComponents(FAutomationTestBase& Test, const TCHAR* TypeName)
+	{
+		// an odd number of components covers both the vectorized loops and the scalar tails
+		for (const int32 Num : { 1, 7, 15, 16, 17, 1037 })
+		{
+			const TArray<ComponentType> Components = MakeComponents<ComponentType>(Num, Num);
+			for (const bool bNormalized : { false, true })
+			{
+				TArray<float> Values;
+				Values.SetNumUninitialized(Num);
+				FglTFRuntimeParser::DecodeAccessorComponents(Components.GetData(), Num, bNormalized, Values.GetData());
+				for (int32 Index = 0; Index < Num; Index++)
+				{
+					const float Expected = ReferenceComponent(Components[Index], bNormalized);
+					if (!IsSameFloat(Values[Index], Expected))
+					{
+						Test.AddError(FString::Printf(TEXT("%s component %d of %d (normalized: %d) is %.9g, expected %.9g"), TypeName, Index, Num, bNormalized, Values[Index], Expected));
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	template<typename IndexType>
+	bool TestIndices(FAutomationTestBase& Test, const TCHAR* TypeName)
+	{
+		for (const int32 Num : { 1, 7, 8, 9, 15, 16, 17, 3001 })
+		{
+			const TArray<IndexType> Indices = MakeComponents<IndexType>(Num, Num);
+			TArray<uint32> Values;
+			Values.SetNumUninitialized(Num);
+			FglTFRuntimeParser::DecodeIndices(Indices.GetData(), Num, Values.GetData());
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				if (Values[Index] != static_cast<uint32>(Indices[Index]))
+				{
+					Test.AddError(FString::Printf(TEXT("%s index %d of %d is %u, expected %u"), TypeName, Index, Num, Values[Index], static_cast<uint32>(Indices[Index])));
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// a glTF with the same normalized UNSIGNED_SHORT VEC4 values tightly packed (accessor 0) and interleaved with padding (accessor 1)
+	TSharedPtr<FglTFRuntimeParser> MakeAccessorsAsset(const TArray<uint16>& Components)
+	{
+		const int32 Count = Components.Num() / 4;
+
+		TArray<uint8> Buffer;
+		Buffer.Append(reinterpret_cast<const uint8*>(Components.GetData()), Components.Num() * sizeof(uint16));
+		const int32 InterleavedOffset = Buffer.Num();
+		for (int32 ElementIndex = 0; ElementIndex < Count; ElementIndex++)
+		{
+			Buffer.Append(reinterpret_cast<const uint8*>(Components.GetData() + ElementIndex * 4), 4 * sizeof(uint16));
+			Buffer.AddZeroed(4);
+		}
+
+		const FString Json = FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},")
+			TEXT("\"buffers\":[{\"byteLength\":%d,\"uri\":\"data:application/octet-stream;base64,%s\"}],")
+			TEXT("\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":%d},{\"buffer\":0,\"byteOffset\":%d,\"byteLength\":%d,\"byteStride\":12}],")
+			TEXT("\"accessors\":[{\"bufferView\":0,\"componentType\":5123,\"normalized\":true,\"count\":%d,\"type\":\"VEC4\"},{\"bufferView\":1,\"componentType\":5123,\"normalized\":true,\"count\":%d,\"type\":\"VEC4\"}]}"),
+			Buffer.Num(), *FBase64::Encode(Buffer), InterleavedOffset, InterleavedOffset, Buffer.Num() - InterleavedOffset, Count, Count);
+
+		return FglTFRuntimeParser::FromString(Json, FglTFRuntimeConfig());
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeAccessorsComponentsTest, "glTFRuntime.Accessors.Components", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeAccessorsComponentsTest::RunTest(const FString& Parameters)
+{
+	// the vectorized kernels must give exactly the same bits of the scalar formulas
+	return glTFRuntimeAccessorsTests::TestComponents<int8>(*this, TEXT("BYTE")) &&
+		glTFRuntimeAccessorsTests::TestComponents<uint8>(*this, TEXT("UNSIGNED_BYTE")) &&
+		glTFRuntimeAccessorsTests::TestComponents<int16>(*this, TEXT("SHORT")) &&
+		glTFRuntimeAccessorsTests::TestComponents<uint16>(*this, TEXT("UNSIGNED_SHORT"));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeAccessorsIndicesTest, "glTFRuntime.Accessors.Indices", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeAccessorsIndicesTest::RunTest(const FString& Parameters)
+{
+	return glTFRuntimeAccessorsTests::TestIndices<uint8>(*this, TEXT("UNSIGNED_BYTE")) &&
+		glTFRuntimeAccessorsTests::TestIndices<uint16>(*this, TEXT("UNSIGNED_SHORT")) &&
+		glTFRuntimeAccessorsTests::TestIndices<uint32>(*this, TEXT("UNSIGNED_INT"));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeAccessorsBuildTest, "glTFRuntime.Accessors.Build", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeAccessorsBuildTest::RunTest(const FString& Parameters)
+{
+	// more than one block of the vectorized path, and not a multiple of it
+	const TArray<uint16> Components = glTFRuntimeAccessorsTests::MakeComponents<uint16>(4 * 1000 + 4 * 3, 7);
+	TSharedPtr<FglTFRuntimeParser> Parser = glTFRuntimeAccessorsTests::MakeAccessorsAsset(Components);
+	if (!Parser)
+	{
+		AddError(TEXT("Unable to create the parser"));
+		return false;
+	}
+
+	// FVector4 is double based with large world coordinates, FglTFRuntimeUInt16Vector4 is uint16 based, both have 4 components
+	TArray<FVector4> PackedValues;
+	TArray<FVector4> InterleavedValues;
+	TArray<FglTFRuntimeUInt16Vector4> PackedJoints;
+	if (!Parser->BuildFromAccessorIndex(0, PackedValues, { 4 }, { 5123 }, [](FVector4 Value) { return Value; }, nullptr, false, nullptr) ||
+		!Parser->BuildFromAccessorIndex(1, InterleavedValues, { 4 }, { 5123 }, [](FVector4 Value) { return Value; }, nullptr, false, nullptr) ||
+		!Parser->BuildFromAccessorIndex(0, PackedJoints, { 4 }, { 5123 }, [](FglTFRuntimeUInt16Vector4 Value) { return Value; }, nullptr, false, nullptr))
+	{
+		AddError(TEXT("Unable to build the accessors"));
+		return false;
+	}
+
+	const int32 Count = Components.Num() / 4;
+	TestEqual(TEXT("Number of packed values"), PackedValues.Num(), Count);
+	TestEqual(TEXT("Number of interleaved values"), InterleavedValues.Num(), Count);
+	TestEqual(TEXT("Number of packed joints"), PackedJoints.Num(), Count);
+
+	for (int32 ElementIndex = 0; ElementIndex < Count && ElementIndex < PackedValues.Num() && ElementIndex < InterleavedValues.Num() && ElementIndex < PackedJoints.Num(); ElementIndex++)
+	{
+		for (int32 ComponentIndex = 0; ComponentIndex < 4; ComponentIndex++)
+		{
+			const uint16 Component = Components[ElementIndex * 4 + ComponentIndex];
+			const float Expected = glTFRuntimeAccessorsTests::ReferenceComponent(Component, true);
+			// the packed values go through the vectorized kernels, the interleaved ones through the scalar loop
+			if (!glTFRuntimeAccessorsTests::IsSameFloat(static_cast<float>(PackedValues[ElementIndex][ComponentIndex]), Expected) ||
+				!glTFRuntimeAccessorsTests::IsSameFloat(static_cast<float>(InterleavedValues[ElementIndex][ComponentIndex]), Expected))
+			{
+				AddError(FString::Printf(TEXT("Component %d of element %d differs from the reference"), ComponentIndex, ElementIndex));
+				return false;
+			}
+			// the normalized flag of the accessor applies to the joints too, so check against the same float truncated
+			if (PackedJoints[ElementIndex][ComponentIndex] != static_cast<uint16>(Expected))
+			{
+				AddError(FString::Printf(TEXT("Joint component %d of element %d differs from the reference"), ComponentIndex, ElementIndex));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeAccessorsBenchmarkTest, "glTFRuntime.Accessors.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeAccessorsBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumOfComponents = 4 * 1024 * 1024;
+	const TArray<uint16> Components = glTFRuntimeAccessorsTests::MakeComponents<uint16>(NumOfComponents, 11);
+	TArray<float> Values;
+	Values.SetNumUninitialized(NumOfComponents);
+	TArray<uint32> Indices;
+	Indices.SetNumUninitialized(NumOfComponents);
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumOfComponents; Index++)
+	{
+		Values[Index] = glTFRuntimeAccessorsTests::ReferenceComponent(Components[Index], true);
+	}
+	const double ScalarComponentsTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	FglTFRuntimeParser::DecodeAccessorComponents(Components.GetData(), NumOfComponents, true, Values.GetData());
+	const double ComponentsTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumOfComponents; Index++)
+	{
+		Indices[Index] = Components[Index];
+	}
+	const double ScalarIndicesTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	FglTFRuntimeParser::DecodeIndices(Components.GetData(), NumOfComponents, Indices.GetData());
+	const double IndicesTime = FPlatformTime::Seconds() - StartTime;
+
+	AddInfo(FString::Printf(TEXT("%d normalized UNSIGNED_SHORT components: scalar %.2f ms, kernel %.2f ms"), NumOfComponents, ScalarComponentsTime * 1000.0, ComponentsTime * 1000.0));
+	AddInfo(FString::Printf(TEXT("%d UNSIGNED_SHORT indices: scalar %.2f ms, kernel %.2f ms"), NumOfComponents, ScalarIndicesTime * 1000.0, IndicesTime * 1000.0));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,212 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeParser.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace glTFRuntimeAnimationTests
+{
+	// the linear search used before the binary search and the cursor, kept as the reference
+	float FindBestFramesLinear(const TArray<float>& FramesTimes, float WantedTime, int32& FirstIndex, int32& SecondIndex)
+	{
+		SecondIndex = INDEX_NONE;
+		for (int32 i = 0; i < FramesTimes.Num(); i++)
+		{
+			float TimeValue = FramesTimes[i] - FramesTimes[0];
+			if (FMath::IsNearlyEqual(TimeValue, WantedTime))
+			{
+				FirstIndex = i;
+				SecondIndex = i;
+				return 0;
+			}
+			else if (TimeValue > WantedTime)
+			{
+				SecondIndex = i;
+				break;
+			}
+		}
+
+		if (SecondIndex == INDEX_NONE)
+		{
+			SecondIndex = FramesTimes.Num() - 1;
+		}
+
+		if (SecondIndex == 0)
+		{
+			FirstIndex = 0;
+			return 1.f;
+		}
+
+		FirstIndex = SecondIndex - 1;
+
+		return ((WantedTime + FramesTimes[0]) - FramesTimes[FirstIndex]) / (FramesTimes[SecondIndex] - FramesTimes[FirstIndex]);
+	}
+
+	struct FBoneChannel
+	{
+		TArray<float> Timeline;
+		TArray<FQuat> Rotations;
+		TArray<FVector> Translations;
+	};
+
+	// sorted timelines not starting at 0, with repeated keys and keys landing exactly on (or very near to) the sampled frames
+	FBoneChannel MakeBoneChannel(FRandomStream& RandomStream, const int32 NumOfKeys, const float FramesPerSecond)
+	{
+		FBoneChannel Channel;
+		float Time = RandomStream.FRandRange(0.f, 0.5f);
+		const float FirstTime = Time;
+		for (int32 KeyIndex = 0; KeyIndex < NumOfKeys; KeyIndex++)
+		{
+			Channel.Timeline.Add(Time);
+			Channel.Rotations.Add(FQuat(RandomStream.FRandRange(-1.f, 1.f), RandomStream.FRandRange(-1.f, 1.f), RandomStream.FRandRange(-1.f, 1.f), RandomStream.FRandRange(-1.f, 1.f)).GetNormalized());
+			Channel.Translations.Add(RandomStream.VRand() * RandomStream.FRandRange(0.f, 100.f));
+
+			const int32 Kind = RandomStream.RandRange(0, 9);
+			if (Kind == 0)
+			{
+				// repeated key
+			}
+			else if (Kind == 1)
+			{
+				// next key exactly on the next frame
+				Time = FirstTime + (FMath::FloorToFloat((Time - FirstTime) * FramesPerSecond) + 1) / FramesPerSecond;
+			}
+			else if (Kind == 2)
+			{
+				// next key a tiny bit after the next frame
+				Time = FirstTime + (FMath::FloorToFloat((Time - FirstTime) * FramesPerSecond) + 1) / FramesPerSecond + KINDA_SMALL_NUMBER * 0.5f;
+			}
+			else
+			{
+				Time += RandomStream.FRandRange(0.001f, 0.1f);
+			}
+		}
+		return Channel;
+	}
+
+	struct FBonePose
+	{
+		FQuat Rotation;
+		FVector Translation;
+	};
+
+	// same interpolation of the skeletal animation loader
+	FBonePose SamplePose(const FBoneChannel& Channel, const int32 FirstIndex, const int32 SecondIndex, const float Alpha)
+	{
+		FBonePose Pose;
+		if (FirstIndex == SecondIndex)
+		{
+			Pose.Rotation = Channel.Rotations[FirstIndex];
+		}
+		else
+		{
+			Pose.Rotation = FQuat::Slerp(Channel.Rotations[FirstIndex], Channel.Rotations[SecondIndex], Alpha);
+		}
+		Pose.Translation = FMath::Lerp(Channel.Translations[FirstIndex], Channel.Translations[SecondIndex], Alpha);
+		return Pose;
+	}
+
+	bool IsSamePose(const FBonePose& A, const FBonePose& B)
+	{
+		return FMemory::Memcmp(&A.Rotation, &B.Rotation, sizeof(FQuat)) == 0 && FMemory::Memcmp(&A.Translation, &B.Translation, sizeof(FVector)) == 0;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeAnimationPosesTest, "glTFRuntime.Animation.Poses", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeAnimationPosesTest::RunTest(const FString& Parameters)
+{
+	FRandomStream RandomStream(40);
+
+	for (const float FramesPerSecond : { 24.f, 30.f, 60.f })
+	{
+		const float FrameDelta = 1.f / FramesPerSecond;
+
+		TArray<glTFRuntimeAnimationTests::FBoneChannel> Skeleton;
+		for (int32 BoneIndex = 0; BoneIndex < 32; BoneIndex++)
+		{
+			Skeleton.Add(glTFRuntimeAnimationTests::MakeBoneChannel(RandomStream, BoneIndex == 0 ? 1 : RandomStream.RandRange(2, 200), FramesPerSecond));
+		}
+
+		float Duration = 0;
+		for (const glTFRuntimeAnimationTests::FBoneChannel& Channel : Skeleton)
+		{
+			Duration = FMath::Max(Duration, Channel.Timeline.Last() - Channel.Timeline[0]);
+		}
+		// sample past the end of every channel too
+		const int32 NumFrames = FMath::CeilToInt(Duration * FramesPerSecond) + 3;
+
+		for (int32 BoneIndex = 0; BoneIndex < Skeleton.Num(); BoneIndex++)
+		{
+			const glTFRuntimeAnimationTests::FBoneChannel& Channel = Skeleton[BoneIndex];
+			int32 FrameCursor = 0;
+			for (int32 Frame = 0; Frame < NumFrames; Frame++)
+			{
+				const float FrameBase = FrameDelta * Frame;
+
+				int32 ExpectedFirstIndex, ExpectedSecondIndex;
+				const float ExpectedAlpha = glTFRuntimeAnimationTests::FindBestFramesLinear(Channel.Timeline, FrameBase, ExpectedFirstIndex, ExpectedSecondIndex);
+				const glTFRuntimeAnimationTests::FBonePose ExpectedPose = glTFRuntimeAnimationTests::SamplePose(Channel, ExpectedFirstIndex, ExpectedSecondIndex, ExpectedAlpha);
+
+				int32 FirstIndex, SecondIndex;
+				const float Alpha = FglTFRuntimeParser::FindBestFrames(Channel.Timeline, FrameBase, FirstIndex, SecondIndex);
+
+				int32 CursorFirstIndex, CursorSecondIndex;
+				const float CursorAlpha = FglTFRuntimeParser::FindBestFrames(Channel.Timeline, FrameBase, CursorFirstIndex, CursorSecondIndex, FrameCursor);
+
+				const bool bSameSearch = FirstIndex == ExpectedFirstIndex && SecondIndex == ExpectedSecondIndex && FMemory::Memcmp(&Alpha, &ExpectedAlpha, sizeof(float)) == 0;
+				const bool bSameCursor = CursorFirstIndex == ExpectedFirstIndex && CursorSecondIndex == ExpectedSecondIndex && FMemory::Memcmp(&CursorAlpha, &ExpectedAlpha, sizeof(float)) == 0;
+				if (!bSameSearch || !bSameCursor ||
+					!glTFRuntimeAnimationTests::IsSamePose(glTFRuntimeAnimationTests::SamplePose(Channel, FirstIndex, SecondIndex, Alpha), ExpectedPose) ||
+					!glTFRuntimeAnimationTests::IsSamePose(glTFRuntimeAnimationTests::SamplePose(Channel, CursorFirstIndex, CursorSecondIndex, CursorAlpha), ExpectedPose))
+				{
+					AddError(FString::Printf(TEXT("Bone %d at frame %d (%.0f fps): expected keys %d-%d alpha %.9g, binary search %d-%d alpha %.9g, cursor %d-%d alpha %.9g"),
+						BoneIndex, Frame, FramesPerSecond, ExpectedFirstIndex, ExpectedSecondIndex, ExpectedAlpha, FirstIndex, SecondIndex, Alpha, CursorFirstIndex, CursorSecondIndex, CursorAlpha));
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeAnimationSamplingBenchmarkTest, "glTFRuntime.Animation.SamplingBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeAnimationSamplingBenchmarkTest::RunTest(const FString& Parameters)
+{
+	FRandomStream RandomStream(41);
+	const float FramesPerSecond = 120.f;
+	const glTFRuntimeAnimationTests::FBoneChannel Channel = glTFRuntimeAnimationTests::MakeBoneChannel(RandomStream, 10000, FramesPerSecond);
+	const int32 NumFrames = FMath::CeilToInt((Channel.Timeline.Last() - Channel.Timeline[0]) * FramesPerSecond) + 1;
+
+	auto Measure = [&](auto Search)
+		{
+			double Checksum = 0;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Frame = 0; Frame < NumFrames; Frame++)
+			{
+				int32 FirstIndex, SecondIndex;
+				Checksum += Search(Frame / FramesPerSecond, FirstIndex, SecondIndex) + FirstIndex;
+			}
+			return MakeTuple(FPlatformTime::Seconds() - StartTime, Checksum);
+		};
+
+	const TTuple<double, double> Linear = Measure([&](const float WantedTime, int32& FirstIndex, int32& SecondIndex) { return glTFRuntimeAnimationTests::FindBestFramesLinear(Channel.Timeline, WantedTime, FirstIndex, SecondIndex); });
+	const TTuple<double, double> Binary = Measure([&](const float WantedTime, int32& FirstIndex, int32& SecondIndex) { return FglTFRuntimeParser::FindBestFrames(Channel.Timeline, WantedTime, FirstIndex, SecondIndex); });
+	int32 Cursor = 0;
+	const TTuple<double, double> Sequential = Measure([&](const float WantedTime, int32& FirstIndex, int32& SecondIndex) { return FglTFRuntimeParser::FindBestFrames(Channel.Timeline, WantedTime, FirstIndex, SecondIndex, Cursor); });
+
+	TestEqual(TEXT("Binary search checksum"), Binary.Value, Linear.Value);
+	TestEqual(TEXT("Cursor checksum"), Sequential.Value, Linear.Value);
+
+	AddInfo(FString::Printf(TEXT("10000 keys sampled at %d frames: linear %.2f ms, binary search %.2f ms, cursor %.2f ms"), NumFrames, Linear.Key * 1000.0, Binary.Key * 1000.0, Sequential.Key * 1000.0));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,292 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeParser.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+namespace glTFRuntimeBuffersTests
+{
+	constexpr int32 NumOfExternalBuffers = 4;
+
+	TArray<uint8> MakeBufferData(const int32 BufferIndex)
+	{
+		TArray<uint8> Data;
+		Data.SetNumUninitialized(4096 + BufferIndex * 16);
+		for (int32 ByteIndex = 0; ByteIndex < Data.Num(); ByteIndex++)
+		{
+			Data[ByteIndex] = static_cast<uint8>(ByteIndex * 31 + BufferIndex * 7);
+		}
+		return Data;
+	}
+
+	// writes a glTF with NumOfExternalBuffers external .bin files followed by one data uri buffer
+	FString WriteTestAsset()
+	{
+		const FString Directory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("glTFRuntimeBuffers"));
+
+		FString Buffers;
+		for (int32 BufferIndex = 0; BufferIndex < NumOfExternalBuffers; BufferIndex++)
+		{
+			const TArray<uint8> Data = MakeBufferData(BufferIndex);
+			const FString BufferFilename = FString::Printf(TEXT("buffer%d.bin"), BufferIndex);
+			FFileHelper::SaveArrayToFile(Data, *FPaths::Combine(Directory, BufferFilename));
+			Buffers += FString::Printf(TEXT("{\"byteLength\":%d,\"uri\":\"%s\"},"), Data.Num(), *BufferFilename);
+		}
+
+		const TArray<uint8> Data = MakeBufferData(NumOfExternalBuffers);
+		Buffers += FString::Printf(TEXT("{\"byteLength\":%d,\"uri\":\"data:application/octet-stream;base64,%s\"}"), Data.Num(), *FBase64::Encode(Data));
+
+		const FString Filename = FPaths::Combine(Directory, TEXT("buffers.gltf"));
+		FFileHelper::SaveStringToFile(FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"buffers\":[%s]}"), *Buffers), *Filename);
+		return Filename;
+	}
+
+	uint8 GetLargeBufferByte(const int64 Offset)
+	{
+		return static_cast<uint8>(Offset * 31 + (Offset >> 20));
+	}
+
+	// streams Header followed by DataNum generated bytes, so multi-GB files never need to fit in memory
+	bool WriteLargeFile(const FString& Filename, const TArray<uint8>& Header, const int64 DataNum)
+	{
+		TUniquePtr<IFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Filename));
+		if (!FileHandle || !FileHandle->Write(Header.GetData(), Header.Num()))
+		{
+			return false;
+		}
+
+		TArray64<uint8> Chunk;
+		Chunk.SetNumUninitialized(16 * 1024 * 1024);
+		for (int64 Offset = 0; Offset < DataNum; Offset += Chunk.Num())
+		{
+			const int64 ChunkNum = FMath::Min<int64>(Chunk.Num(), DataNum - Offset);
+			for (int64 ByteIndex = 0; ByteIndex < ChunkNum; ByteIndex++)
+			{
+				Chunk[ByteIndex] = GetLargeBufferByte(Offset + ByteIndex);
+			}
+			if (!FileHandle->Write(Chunk.GetData(), ChunkNum))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	TArray<uint8> MakeJsonChunk(const FString& Json)
+	{
+		FTCHARToUTF8 JsonConverter(*Json);
+		TArray<uint8> JsonChunk;
+		JsonChunk.Append(reinterpret_cast<const uint8*>(JsonConverter.Get()), JsonConverter.Length());
+		while (JsonChunk.Num() % 4)
+		{
+			JsonChunk.Add(' ');
+		}
+		return JsonChunk;
+	}
+
+	bool WriteLargeGlb(const FString& Filename, const int64 BinaryChunkNum)
+	{
+		const TArray<uint8> Json = MakeJsonChunk(FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":%lld}]}"), BinaryChunkNum));
+
+		auto AppendUInt32 = [](TArray<uint8>& Bytes, const uint32 Value)
+			{
+				Bytes.Append(reinterpret_cast<const uint8*>(&Value), sizeof(uint32));
+			};
+
+		TArray<uint8> Header;
+		AppendUInt32(Header, 0x46546C67);
+		AppendUInt32(Header, 2);
+		AppendUInt32(Header, static_cast<uint32>(12 + 8 + Json.Num() + 8 + BinaryChunkNum));
+		AppendUInt32(Header, static_cast<uint32>(Json.Num()));
+		AppendUInt32(Header, 0x4E4F534A);
+		Header.Append(Json);
+		AppendUInt32(Header, static_cast<uint32>(BinaryChunkNum));
+		AppendUInt32(Header, 0x004E4942);
+		return WriteLargeFile(Filename, Header, BinaryChunkNum);
+	}
+
+	bool WriteLargeExternalBuffer(const FString& Filename, const int64 BufferNum)
+	{
+		const FString BufferFilename = FPaths::GetBaseFilename(Filename) + TEXT(".bin");
+		if (!FFileHelper::SaveStringToFile(FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":%lld,\"uri\":\"%s\"}]}"), BufferNum, *BufferFilename), *Filename))
+		{
+			return false;
+		}
+		return WriteLargeFile(FPaths::Combine(FPaths::GetPath(Filename), BufferFilename), TArray<uint8>(), BufferNum);
+	}
+
+	struct FLargeBufferLoad
+	{
+		bool bValid = false;
+		double Time = 0;
+		int64 PeakMemoryGrowth = 0;
+	};
+
+	// loads the asset and reads the tail of its first buffer (as decoding a single mesh would), polling the process memory from another thread
+	FLargeBufferLoad LoadLargeBuffer(const FString& Filename, const bool bUseMemoryMappedFiles, const int64 BufferNum, const int64 ReadNum)
+	{
+		FLargeBufferLoad Load;
+
+		const int64 StartUsedPhysical = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+		FThreadSafeBool bDone = false;
+		TFuture<int64> PeakUsedPhysical = Async(EAsyncExecution::Thread, [&bDone, StartUsedPhysical]()
+			{
+				int64 Peak = StartUsedPhysical;
+				while (!bDone)
+				{
+					Peak = FMath::Max(Peak, static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical));
+					FPlatformProcess::Sleep(0.001f);
+				}
+				return Peak;
+			});
+
+		const double StartTime = FPlatformTime::Seconds();
+		{
+			FglTFRuntimeConfig LoaderConfig;
+			LoaderConfig.bUseMemoryMappedFiles = bUseMemoryMappedFiles;
+			TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromFilename(Filename, LoaderConfig);
+			FglTFRuntimeBlob Blob;
+			if (Parser && Parser->GetBuffer(0, Blob) && Blob.Num == BufferNum)
+			{
+				Load.bValid = true;
+				for (int64 Offset = BufferNum - ReadNum; Offset < BufferNum; Offset += 4093)
+				{
+					Load.bValid &= Blob.Data[Offset] == GetLargeBufferByte(Offset);
+				}
+			}
+			Load.Time = FPlatformTime::Seconds() - StartTime;
+		}
+
+		const int64 EndUsedPhysical = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+		bDone = true;
+		Load.PeakMemoryGrowth = FMath::Max(PeakUsedPhysical.Get(), EndUsedPhysical) - StartUsedPhysical;
+		return Load;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeBuffersCacheTest, "glTFRuntime.Buffers.Cache", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeBuffersCacheTest::RunTest(const FString& Parameters)
+{
+	const FString Filename = glTFRuntimeBuffersTests::WriteTestAsset();
+	const int32 NumOfBuffers = glTFRuntimeBuffersTests::NumOfExternalBuffers + 1;
+
+	for (const bool bUseMemoryMappedFiles : { false, true })
+	{
+		FglTFRuntimeConfig LoaderConfig;
+		LoaderConfig.bUseMemoryMappedFiles = bUseMemoryMappedFiles;
+		const FString Context = bUseMemoryMappedFiles ? TEXT("Mapped") : TEXT("Buffered");
+
+		TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromFilename(Filename, LoaderConfig);
+		if (!Parser)
+		{
+			AddError(FString::Printf(TEXT("Unable to load %s"), *Filename));
+			return false;
+		}
+
+		// cold cache: many threads racing on the same buffers must all end up with the same cached copy
+		constexpr int32 NumOfLookups = 512;
+		TArray<FglTFRuntimeBlob> Blobs;
+		Blobs.SetNum(NumOfLookups);
+		TArray<bool> Results;
+		Results.SetNumZeroed(NumOfLookups);
+		ParallelFor(NumOfLookups, [&](const int32 LookupIndex)
+			{
+				Results[LookupIndex] = Parser->GetBuffer(LookupIndex % NumOfBuffers, Blobs[LookupIndex]);
+			});
+
+		for (int32 BufferIndex = 0; BufferIndex < NumOfBuffers; BufferIndex++)
+		{
+			FglTFRuntimeBlob Blob;
+			if (!Parser->GetBuffer(BufferIndex, Blob))
+			{
+				AddError(FString::Printf(TEXT("%s: unable to get buffer %d"), *Context, BufferIndex));
+				return false;
+			}
+
+			const TArray<uint8> Expected = glTFRuntimeBuffersTests::MakeBufferData(BufferIndex);
+			TestEqual(FString::Printf(TEXT("%s: size of buffer %d"), *Context, BufferIndex), Blob.Num, static_cast<int64>(Expected.Num()));
+			TestTrue(FString::Printf(TEXT("%s: content of buffer %d"), *Context, BufferIndex), Blob.Num == Expected.Num() && FMemory::Memcmp(Blob.Data, Expected.GetData(), Expected.Num()) == 0);
+
+			FglTFRuntimeBlob CachedBlob;
+			Parser->GetBuffer(BufferIndex, CachedBlob);
+			TestTrue(FString::Printf(TEXT("%s: buffer %d is cached"), *Context, BufferIndex), CachedBlob.Data == Blob.Data && CachedBlob.Num == Blob.Num);
+
+			for (int32 LookupIndex = BufferIndex; LookupIndex < NumOfLookups; LookupIndex += NumOfBuffers)
+			{
+				if (!Results[LookupIndex] || Blobs[LookupIndex].Data != Blob.Data)
+				{
+					AddError(FString::Printf(TEXT("%s: concurrent lookup %d of buffer %d did not return the cached buffer"), *Context, LookupIndex, BufferIndex));
+					return false;
+				}
+			}
+		}
+
+		FglTFRuntimeBlob MissingBlob;
+		TestFalse(FString::Printf(TEXT("%s: missing buffer"), *Context), Parser->GetBuffer(NumOfBuffers, MissingBlob));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeBuffersMappedBenchmarkTest, "glTFRuntime.Buffers.MappedBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeBuffersMappedBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// 3 GB buffers (the GLB container is limited to 4 GB), of which a single 64 MB range is read
+	constexpr int64 BufferNum = 3ll * 1024 * 1024 * 1024;
+	constexpr int64 ReadNum = 64 * 1024 * 1024;
+	const FString Directory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("glTFRuntimeBuffers"));
+	const FString GlbFilename = FPaths::Combine(Directory, TEXT("large.glb"));
+	const FString GltfFilename = FPaths::Combine(Directory, TEXT("large.gltf"));
+	IFileManager::Get().MakeDirectory(*Directory, true);
+	ON_SCOPE_EXIT
+	{
+		IFileManager::Get().Delete(*GlbFilename, false, false, true);
+		IFileManager::Get().Delete(*GltfFilename, false, false, true);
+		IFileManager::Get().Delete(*FPaths::Combine(Directory, TEXT("large.bin")), false, false, true);
+	};
+
+	if (!glTFRuntimeBuffersTests::WriteLargeGlb(GlbFilename, BufferNum) || !glTFRuntimeBuffersTests::WriteLargeExternalBuffer(GltfFilename, BufferNum))
+	{
+		AddError(TEXT("Unable to write the benchmark assets"));
+		return false;
+	}
+
+	for (const FString& Filename : { GlbFilename, GltfFilename })
+	{
+		const FString Context = FPaths::GetExtension(Filename) == TEXT("glb") ? TEXT("GLB") : TEXT("External .bin");
+
+		const glTFRuntimeBuffersTests::FLargeBufferLoad MappedLoad = glTFRuntimeBuffersTests::LoadLargeBuffer(Filename, true, BufferNum, ReadNum);
+		const glTFRuntimeBuffersTests::FLargeBufferLoad BufferedLoad = glTFRuntimeBuffersTests::LoadLargeBuffer(Filename, false, BufferNum, ReadNum);
+		if (!MappedLoad.bValid || !BufferedLoad.bValid)
+		{
+			AddError(FString::Printf(TEXT("%s: unable to read the buffer (mapped %d, buffered %d)"), *Context, MappedLoad.bValid, BufferedLoad.bValid));
+			return false;
+		}
+
+		// only the pages actually read become resident, instead of the whole file (twice for the GLB binary chunk)
+		TestTrue(FString::Printf(TEXT("%s: mapped peak memory"), *Context), MappedLoad.PeakMemoryGrowth < BufferNum / 8);
+
+		AddInfo(FString::Printf(TEXT("%s, %.2f GB buffer: mapped %.2f ms, peak memory growth %.2f MB; LoadFileToArray %.2f ms, peak memory growth %.2f MB"),
+			*Context, BufferNum / (1024.0 * 1024.0 * 1024.0), MappedLoad.Time * 1000.0, MappedLoad.PeakMemoryGrowth / (1024.0 * 1024.0), BufferedLoad.Time * 1000.0, BufferedLoad.PeakMemoryGrowth / (1024.0 * 1024.0)));
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,439 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeParser.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+namespace glTFRuntimeDerivedDataCacheTests
+{
+	// exposes the cached tangents generation
+	class FTestParser : public FglTFRuntimeParser
+	{
+	public:
+		using FglTFRuntimeParser::FglTFRuntimeParser;
+		using FglTFRuntimeParser::LoadOrGenerateTangents;
+
+		void SetDerivedDataCache(TSharedPtr<FglTFRuntimeDerivedDataCache> InDerivedDataCache)
+		{
+			DerivedDataCache = InDerivedDataCache;
+		}
+	};
+
+	// every test starts from an empty cache
+	FString MakeCacheDirectory()
+	{
+		return FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("glTFRuntimeDerivedDataCache"), FGuid::NewGuid().ToString()));
+	}
+
+	int64 ScanEntries(const FString& Directory, int32& NumOfEntries)
+	{
+		int64 TotalSize = 0;
+		NumOfEntries = 0;
+		IFileManager::Get().IterateDirectoryStat(*Directory, [&](const TCHAR* Filename, const FFileStatData& StatData)
+			{
+				if (!StatData.bIsDirectory && FPaths::GetExtension(Filename) == TEXT("gltfddc"))
+				{
+					TotalSize += StatData.FileSize;
+					NumOfEntries++;
+				}
+				return true;
+			});
+		return TotalSize;
+	}
+
+	int32 CountEntries(const FString& Directory)
+	{
+		int32 NumOfEntries = 0;
+		ScanEntries(Directory, NumOfEntries);
+		return NumOfEntries;
+	}
+
+	FString GetEntryFilename(TSharedRef<FglTFRuntimeDerivedDataCache> DerivedDataCache, const FSHAHash& Key)
+	{
+		return FPaths::Combine(DerivedDataCache->GetDirectory(), Key.ToString() + TEXT(".gltfddc"));
+	}
+
+	// a successful Load() touches the entry, so an entry backdated before the load tells a hit from a miss
+	const FDateTime OldTimeStamp(2020, 1, 1);
+
+	void BackdateEntries(const FString& Directory)
+	{
+		IFileManager::Get().IterateDirectory(*Directory, [](const TCHAR* Filename, const bool bIsDirectory)
+			{
+				if (!bIsDirectory && FPaths::GetExtension(Filename) == TEXT("gltfddc"))
+				{
+					IFileManager::Get().SetTimeStamp(Filename, OldTimeStamp);
+				}
+				return true;
+			});
+	}
+
+	bool HasTouchedEntries(const FString& Directory)
+	{
+		bool bTouched = false;
+		IFileManager::Get().IterateDirectoryStat(*Directory, [&bTouched](const TCHAR* Filename, const FFileStatData& StatData)
+			{
+				bTouched |= FPaths::GetExtension(Filename) == TEXT("gltfddc") && StatData.ModificationTime > OldTimeStamp;
+				return true;
+			});
+		return bTouched;
+	}
+
+	// GridSize x GridSize vertices in an external grid.bin, the indices can be truncated for changing only the json
+	FString WriteGridAsset(const FString& Directory, const int32 GridSize, const float Height, const int32 NumOfTrianglesToSkip = 0)
+	{
+		TArray<float> Positions;
+		for (int32 Y = 0; Y < GridSize; Y++)
+		{
+			for (int32 X = 0; X < GridSize; X++)
+			{
+				Positions.Append({ static_cast<float>(X), Height + (X * Y) % 7 * 0.25f, static_cast<float>(Y) });
+			}
+		}
+
+		TArray<uint32> Indices;
+		for (int32 Y = 0; Y < GridSize - 1; Y++)
+		{
+			for (int32 X = 0; X < GridSize - 1; X++)
+			{
+				const uint32 Corner = Y * GridSize + X;
+				Indices.Append({ Corner, Corner + GridSize, Corner + 1, Corner + 1, Corner + GridSize, Corner + GridSize + 1 });
+			}
+		}
+
+		TArray<uint8> Buffer;
+		Buffer.Append(reinterpret_cast<const uint8*>(Positions.GetData()), Positions.Num() * sizeof(float));
+		const int32 IndicesOffset = Buffer.Num();
+		Buffer.Append(reinterpret_cast<const uint8*>(Indices.GetData()), Indices.Num() * sizeof(uint32));
+		FFileHelper::SaveArrayToFile(Buffer, *FPaths::Combine(Directory, TEXT("grid.bin")));
+
+		const FString Filename = FPaths::Combine(Directory, TEXT("grid.gltf"));
+		FFileHelper::SaveStringToFile(FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":%d,\"uri\":\"grid.bin\"}],")
+			TEXT("\"bufferViews\":[{\"buffer\":0,\"byteLength\":%d},{\"buffer\":0,\"byteOffset\":%d,\"byteLength\":%d}],")
+			TEXT("\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":%d,\"type\":\"VEC3\"},{\"bufferView\":1,\"componentType\":5125,\"count\":%d,\"type\":\"SCALAR\"}],")
+			TEXT("\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1}]}]}"),
+			Buffer.Num(), IndicesOffset, IndicesOffset, Buffer.Num() - IndicesOffset, GridSize * GridSize, Indices.Num() - NumOfTrianglesToSkip * 3), *Filename);
+		return Filename;
+	}
+
+	bool LoadGrid(const FString& Filename, const FString& CacheDirectory, FglTFRuntimeMeshLOD& LOD)
+	{
+		FglTFRuntimeConfig LoaderConfig;
+		LoaderConfig.DerivedDataCacheDirectory = CacheDirectory;
+		TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromFilename(Filename, LoaderConfig);
+		if (!Parser)
+		{
+			return false;
+		}
+
+		FglTFRuntimeMaterialsConfig MaterialsConfig;
+		MaterialsConfig.bSkipLoad = true;
+		return Parser->LoadMeshAsRuntimeLOD(0, LOD, MaterialsConfig) && LOD.Primitives.Num() == 1;
+	}
+
+	bool IsSameGeometry(const FglTFRuntimeMeshLOD& A, const FglTFRuntimeMeshLOD& B)
+	{
+		return A.Primitives.Num() == 1 && B.Primitives.Num() == 1 && A.Primitives[0].Positions == B.Primitives[0].Positions && A.Primitives[0].Indices == B.Primitives[0].Indices;
+	}
+
+	// 16x16 DXT1 with its full mips chain
+	FString MakeDDSUri()
+	{
+		TArray<uint32> Header;
+		Header.AddZeroed(32);
+		Header[0] = 0x20534444; // "DDS "
+		Header[1] = 124;
+		Header[2] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000;
+		Header[3] = 16;
+		Header[4] = 16;
+		Header[7] = 5;
+		Header[19] = 32;
+		Header[20] = 0x4;
+		Header[21] = 0x31545844; // DXT1
+
+		TArray<uint8> DDS;
+		DDS.Append(reinterpret_cast<const uint8*>(Header.GetData()), Header.Num() * sizeof(uint32));
+		// 16 + 4 + 1 + 1 + 1 blocks of 8 bytes
+		for (int32 ByteIndex = 0; ByteIndex < 23 * 8; ByteIndex++)
+		{
+			DDS.Add(static_cast<uint8>(ByteIndex * 13));
+		}
+		return TEXT("data:image/vnd-ms.dds;base64,") + FBase64::Encode(DDS);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeDerivedDataCacheEntriesTest, "glTFRuntime.DerivedDataCache.Entries", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeDerivedDataCacheEntriesTest::RunTest(const FString& Parameters)
+{
+	const FString CacheDirectory = glTFRuntimeDerivedDataCacheTests::MakeCacheDirectory();
+	TSharedPtr<FglTFRuntimeDerivedDataCache> DerivedDataCache = FglTFRuntimeDerivedDataCache::Get(CacheDirectory, 0);
+	if (!DerivedDataCache)
+	{
+		AddError(TEXT("Unable to create the derived data cache"));
+		return false;
+	}
+
+	auto MakeKey = [](const int32 Seed)
+		{
+			FglTFRuntimeDerivedDataKey Key(TEXT("test"));
+			Key.Update(Seed);
+			return Key.Finalize();
+		};
+
+	auto MakePayload = [](const int64 Num, const uint8 Seed)
+		{
+			TArray64<uint8> Payload;
+			Payload.SetNumUninitialized(Num);
+			for (int64 ByteIndex = 0; ByteIndex < Num; ByteIndex++)
+			{
+				Payload[ByteIndex] = static_cast<uint8>(ByteIndex * 7 + Seed);
+			}
+			return Payload;
+		};
+
+	auto IsTotalSizeValid = [&]()
+		{
+			int32 NumOfEntries = 0;
+			return DerivedDataCache->GetTotalSize() == glTFRuntimeDerivedDataCacheTests::ScanEntries(CacheDirectory, NumOfEntries);
+		};
+
+	const FSHAHash FirstKey = MakeKey(1);
+	const FSHAHash SecondKey = MakeKey(2);
+
+	// replacing an entry must account only for the new one
+	TestTrue(TEXT("Save"), DerivedDataCache->Save(FirstKey, MakePayload(1024 * 1024, 1)));
+	TestTrue(TEXT("Total size after the first save"), IsTotalSizeValid());
+	TestTrue(TEXT("Save over an existing key"), DerivedDataCache->Save(FirstKey, MakePayload(1000, 2)));
+	TestTrue(TEXT("Total size after the replacement"), IsTotalSizeValid());
+	TestTrue(TEXT("Save a second key"), DerivedDataCache->Save(SecondKey, MakePayload(300, 3)));
+	TestTrue(TEXT("Total size after the second key"), IsTotalSizeValid());
+	TestEqual(TEXT("Entries"), glTFRuntimeDerivedDataCacheTests::CountEntries(CacheDirectory), 2);
+
+	{
+		const uint8* PayloadData = nullptr;
+		int64 PayloadNum = 0;
+		TSharedPtr<FglTFRuntimeMappedFile> MappedFile = DerivedDataCache->Load(FirstKey, PayloadData, PayloadNum);
+		const TArray64<uint8> Expected = MakePayload(1000, 2);
+		TestTrue(TEXT("Load the replaced entry"), MappedFile.IsValid() && PayloadNum == Expected.Num() && FMemory::Memcmp(PayloadData, Expected.GetData(), PayloadNum) == 0);
+	}
+
+	// header, sampled payload and size are all verified
+	AddExpectedError(TEXT("Removing invalid derived data cache entry"), EAutomationExpectedErrorFlags::Contains, 3);
+
+	const TArray64<uint8> BigPayload = MakePayload(1024 * 1024, 4);
+	auto IsCorruptionDetected = [&](TFunctionRef<void(TArray<uint8>& Bytes)> Corrupt)
+		{
+			DerivedDataCache->Save(FirstKey, BigPayload);
+			const FString Filename = glTFRuntimeDerivedDataCacheTests::GetEntryFilename(DerivedDataCache.ToSharedRef(), FirstKey);
+			TArray<uint8> Bytes;
+			FFileHelper::LoadFileToArray(Bytes, *Filename);
+			Corrupt(Bytes);
+			FFileHelper::SaveArrayToFile(Bytes, *Filename);
+
+			const uint8* PayloadData = nullptr;
+			int64 PayloadNum = 0;
+			const bool bLoaded = DerivedDataCache->Load(FirstKey, PayloadData, PayloadNum).IsValid();
+			return !bLoaded && !IFileManager::Get().FileExists(*Filename);
+		};
+
+	TestTrue(TEXT("Corrupted key"), IsCorruptionDetected([](TArray<uint8>& Bytes) { Bytes[8] ^= 0xFF; }));
+	TestTrue(TEXT("Corrupted payload"), IsCorruptionDetected([](TArray<uint8>& Bytes) { Bytes.Last() ^= 0xFF; }));
+	TestTrue(TEXT("Truncated payload"), IsCorruptionDetected([](TArray<uint8>& Bytes) { Bytes.SetNum(Bytes.Num() - 100); }));
+	TestTrue(TEXT("Total size after the removals"), IsTotalSizeValid());
+
+	// the second entry is still there
+	const uint8* PayloadData = nullptr;
+	int64 PayloadNum = 0;
+	TestTrue(TEXT("Untouched entry"), DerivedDataCache->Load(SecondKey, PayloadData, PayloadNum).IsValid() && PayloadNum == 300);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeDerivedDataCacheInvalidationTest, "glTFRuntime.DerivedDataCache.Invalidation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeDerivedDataCacheInvalidationTest::RunTest(const FString& Parameters)
+{
+	const FString CacheDirectory = glTFRuntimeDerivedDataCacheTests::MakeCacheDirectory();
+	const FString AssetDirectory = FPaths::Combine(CacheDirectory, TEXT("Asset"));
+	const FString BufferFilename = FPaths::Combine(AssetDirectory, TEXT("grid.bin"));
+	const FDateTime BufferTimeStamp(2021, 1, 1);
+
+	const FString Filename = glTFRuntimeDerivedDataCacheTests::WriteGridAsset(AssetDirectory, 32, 0);
+	IFileManager::Get().SetTimeStamp(*BufferFilename, BufferTimeStamp);
+
+	FglTFRuntimeMeshLOD ColdLOD;
+	if (!glTFRuntimeDerivedDataCacheTests::LoadGrid(Filename, CacheDirectory, ColdLOD))
+	{
+		AddError(TEXT("Unable to load the grid"));
+		return false;
+	}
+	TestEqual(TEXT("Cold entries"), glTFRuntimeDerivedDataCacheTests::CountEntries(CacheDirectory), 1);
+
+	FglTFRuntimeMeshLOD ReferenceLOD;
+	glTFRuntimeDerivedDataCacheTests::LoadGrid(Filename, FString(), ReferenceLOD);
+	TestTrue(TEXT("Cold geometry"), glTFRuntimeDerivedDataCacheTests::IsSameGeometry(ColdLOD, ReferenceLOD));
+
+	glTFRuntimeDerivedDataCacheTests::BackdateEntries(CacheDirectory);
+	FglTFRuntimeMeshLOD WarmLOD;
+	glTFRuntimeDerivedDataCacheTests::LoadGrid(Filename, CacheDirectory, WarmLOD);
+	TestTrue(TEXT("Warm hit"), glTFRuntimeDerivedDataCacheTests::HasTouchedEntries(CacheDirectory));
+	TestEqual(TEXT("Warm entries"), glTFRuntimeDerivedDataCacheTests::CountEntries(CacheDirectory), 1);
+	TestTrue(TEXT("Warm geometry"), glTFRuntimeDerivedDataCacheTests::IsSameGeometry(WarmLOD, ReferenceLOD));
+
+	// external buffers are identified by path, size and modification time: the key never reads them
+	glTFRuntimeDerivedDataCacheTests::WriteGridAsset(AssetDirectory, 32, 1);
+	IFileManager::Get().SetTimeStamp(*BufferFilename, BufferTimeStamp);
+	FglTFRuntimeMeshLOD SameStatLOD;
+	glTFRuntimeDerivedDataCacheTests::LoadGrid(Filename, CacheDirectory, SameStatLOD);
+	TestTrue(TEXT("Same stats, same key"), glTFRuntimeDerivedDataCacheTests::IsSameGeometry(SameStatLOD, ReferenceLOD));
+
+	// a newer buffer invalidates the entry
+	IFileManager::Get().SetTimeStamp(*BufferFilename, BufferTimeStamp + FTimespan::FromHours(1));
+	FglTFRuntimeMeshLOD ChangedBufferLOD;
+	glTFRuntimeDerivedDataCacheTests::LoadGrid(Filename, CacheDirectory, ChangedBufferLOD);
+	FglTFRuntimeMeshLOD ChangedBufferReferenceLOD;
+	glTFRuntimeDerivedDataCacheTests::LoadGrid(Filename, FString(), ChangedBufferReferenceLOD);
+	TestEqual(TEXT("Changed buffer entries"), glTFRuntimeDerivedDataCacheTests::CountEntries(CacheDirectory), 2);
+	TestTrue(TEXT("Changed buffer geometry"), glTFRuntimeDerivedDataCacheTests::IsSameGeometry(ChangedBufferLOD, ChangedBufferReferenceLOD));
+	TestFalse(TEXT("Changed buffer is not stale"), glTFRuntimeDerivedDataCacheTests::IsSameGeometry(ChangedBufferLOD, SameStatLOD));
+
+	// so does a change of the accessors (the buffer is rewritten with the same content and stats)
+	glTFRuntimeDerivedDataCacheTests::WriteGridAsset(AssetDirectory, 32, 1, 1);
+	IFileManager::Get().SetTimeStamp(*BufferFilename, BufferTimeStamp + FTimespan::FromHours(1));
+	FglTFRuntimeMeshLOD ChangedJsonLOD;
+	glTFRuntimeDerivedDataCacheTests::LoadGrid(Filename, CacheDirectory, ChangedJsonLOD);
+	FglTFRuntimeMeshLOD ChangedJsonReferenceLOD;
+	glTFRuntimeDerivedDataCacheTests::LoadGrid(Filename, FString(), ChangedJsonReferenceLOD);
+	TestEqual(TEXT("Changed json entries"), glTFRuntimeDerivedDataCacheTests::CountEntries(CacheDirectory), 3);
+	TestTrue(TEXT("Changed json geometry"), glTFRuntimeDerivedDataCacheTests::IsSameGeometry(ChangedJsonLOD, ChangedJsonReferenceLOD));
+	TestEqual(TEXT("Changed json indices"), ChangedJsonLOD.Primitives.Num() == 1 ? ChangedJsonLOD.Primitives[0].Indices.Num() : 0, 31 * 31 * 6 - 3);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeDerivedDataCacheTangentsAndMipsTest, "glTFRuntime.DerivedDataCache.TangentsAndMips", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeDerivedDataCacheTangentsAndMipsTest::RunTest(const FString& Parameters)
+{
+	const FString CacheDirectory = glTFRuntimeDerivedDataCacheTests::MakeCacheDirectory();
+
+	FglTFRuntimeConfig LoaderConfig;
+	LoaderConfig.DerivedDataCacheDirectory = CacheDirectory;
+	const FString Json = FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"images\":[{\"uri\":\"%s\"}],\"textures\":[{\"source\":0}]}"), *glTFRuntimeDerivedDataCacheTests::MakeDDSUri());
+
+	TSharedPtr<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromString(Json);
+	if (!JsonTape)
+	{
+		AddError(TEXT("Unable to parse the test asset"));
+		return false;
+	}
+	TSharedRef<glTFRuntimeDerivedDataCacheTests::FTestParser> Parser = MakeShared<glTFRuntimeDerivedDataCacheTests::FTestParser>(JsonTape.ToSharedRef(), LoaderConfig.GetMatrix(), LoaderConfig.SceneScale);
+	Parser->SetDerivedDataCache(FglTFRuntimeDerivedDataCache::Get(CacheDirectory, 0));
+
+	FRandomStream RandomStream(46);
+	constexpr int32 NumOfCorners = 3 * 1000;
+	TArray<FVector3f> Positions;
+	TArray<FVector3f> Normals;
+	TArray<FVector2f> UVs;
+	TArray<uint32> Keys;
+	for (int32 Corner = 0; Corner < NumOfCorners; Corner++)
+	{
+		Positions.Add(FVector3f(RandomStream.FRand(), RandomStream.FRand(), RandomStream.FRand()));
+		Normals.Add(FVector3f(RandomStream.GetUnitVector()));
+		UVs.Add(FVector2f(RandomStream.FRand(), RandomStream.FRand()));
+		Keys.Add(RandomStream.RandHelper(NumOfCorners / 2));
+	}
+
+	TArray<FVector4f> ExpectedTangents;
+	FglTFRuntimeParser::GenerateTangents(Positions, Normals, UVs, Keys, ExpectedTangents);
+
+	TArray<FVector4f> ColdTangents;
+	Parser->LoadOrGenerateTangents(Positions, Normals, UVs, Keys, ColdTangents);
+	TestEqual(TEXT("Cold tangents entries"), glTFRuntimeDerivedDataCacheTests::CountEntries(CacheDirectory), 1);
+	TestTrue(TEXT("Cold tangents"), ColdTangents.Num() == NumOfCorners && FMemory::Memcmp(ColdTangents.GetData(), ExpectedTangents.GetData(), NumOfCorners * sizeof(FVector4f)) == 0);
+
+	glTFRuntimeDerivedDataCacheTests::BackdateEntries(CacheDirectory);
+	TArray<FVector4f> WarmTangents;
+	Parser->LoadOrGenerateTangents(Positions, Normals, UVs, Keys, WarmTangents);
+	TestTrue(TEXT("Warm tangents hit"), glTFRuntimeDerivedDataCacheTests::HasTouchedEntries(CacheDirectory));
+	TestTrue(TEXT("Warm tangents"), WarmTangents.Num() == NumOfCorners && FMemory::Memcmp(WarmTangents.GetData(), ExpectedTangents.GetData(), NumOfCorners * sizeof(FVector4f)) == 0);
+
+	UVs[0].X += 0.5f;
+	TArray<FVector4f> ChangedTangents;
+	Parser->LoadOrGenerateTangents(Positions, Normals, UVs, Keys, ChangedTangents);
+	TestEqual(TEXT("Changed uvs entries"), glTFRuntimeDerivedDataCacheTests::CountEntries(CacheDirectory), 2);
+
+	// block compressed mips are cached as they are
+	FglTFRuntimeMaterialsConfig MaterialsConfig;
+	MaterialsConfig.bLoadMipMaps = true;
+
+	TArray<FglTFRuntimeMipMap> ColdMips;
+	FglTFRuntimeTextureSampler Sampler;
+	Parser->LoadTexture(0, ColdMips, true, MaterialsConfig, Sampler);
+	TestEqual(TEXT("Cold mips entries"), glTFRuntimeDerivedDataCacheTests::CountEntries(CacheDirectory), 3);
+	if (ColdMips.Num() != 5 || ColdMips[0].PixelFormat != EPixelFormat::PF_DXT1)
+	{
+		AddError(TEXT("Unable to load the DDS mips"));
+		return false;
+	}
+
+	glTFRuntimeDerivedDataCacheTests::BackdateEntries(CacheDirectory);
+	TSharedRef<glTFRuntimeDerivedDataCacheTests::FTestParser> WarmParser = MakeShared<glTFRuntimeDerivedDataCacheTests::FTestParser>(JsonTape.ToSharedRef(), LoaderConfig.GetMatrix(), LoaderConfig.SceneScale);
+	WarmParser->SetDerivedDataCache(FglTFRuntimeDerivedDataCache::Get(CacheDirectory, 0));
+	TArray<FglTFRuntimeMipMap> WarmMips;
+	WarmParser->LoadTexture(0, WarmMips, true, MaterialsConfig, Sampler);
+	TestTrue(TEXT("Warm mips hit"), glTFRuntimeDerivedDataCacheTests::HasTouchedEntries(CacheDirectory));
+
+	bool bSameMips = WarmMips.Num() == ColdMips.Num();
+	for (int32 MipIndex = 0; bSameMips && MipIndex < ColdMips.Num(); MipIndex++)
+	{
+		bSameMips = WarmMips[MipIndex].PixelFormat == ColdMips[MipIndex].PixelFormat && WarmMips[MipIndex].Width == ColdMips[MipIndex].Width &&
+			WarmMips[MipIndex].Height == ColdMips[MipIndex].Height && WarmMips[MipIndex].Pixels == ColdMips[MipIndex].Pixels;
+	}
+	TestTrue(TEXT("Warm mips"), bSameMips);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeDerivedDataCacheBenchmarkTest, "glTFRuntime.DerivedDataCache.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeDerivedDataCacheBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const FString CacheDirectory = glTFRuntimeDerivedDataCacheTests::MakeCacheDirectory();
+	// 1000x1000 quads, 2M triangles
+	const FString Filename = glTFRuntimeDerivedDataCacheTests::WriteGridAsset(FPaths::Combine(CacheDirectory, TEXT("Asset")), 1001, 0);
+
+	auto Measure = [&](const FString& Directory, FglTFRuntimeMeshLOD& LOD)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			glTFRuntimeDerivedDataCacheTests::LoadGrid(Filename, Directory, LOD);
+			return FPlatformTime::Seconds() - StartTime;
+		};
+
+	FglTFRuntimeMeshLOD ReferenceLOD;
+	const double UncachedTime = Measure(FString(), ReferenceLOD);
+	FglTFRuntimeMeshLOD ColdLOD;
+	const double ColdTime = Measure(CacheDirectory, ColdLOD);
+	FglTFRuntimeMeshLOD WarmLOD;
+	const double WarmTime = Measure(CacheDirectory, WarmLOD);
+
+	TestTrue(TEXT("Cold geometry"), glTFRuntimeDerivedDataCacheTests::IsSameGeometry(ColdLOD, ReferenceLOD));
+	TestTrue(TEXT("Warm geometry"), glTFRuntimeDerivedDataCacheTests::IsSameGeometry(WarmLOD, ReferenceLOD));
+
+	AddInfo(FString::Printf(TEXT("%d triangles: %.2f ms without cache, %.2f ms cold, %.2f ms warm"),
+		ReferenceLOD.Primitives.Num() > 0 ? ReferenceLOD.Primitives[0].Indices.Num() / 3 : 0, UncachedTime * 1000.0, ColdTime * 1000.0, WarmTime * 1000.0));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,251 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeParser.h"
+#include "Async/Async.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeBool.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace glTFRuntimeGzipTests
+{
+	// half noise and half runs, so that deflate has some work to do without taking forever
+	TArray64<uint8> MakeBinaryChunk(const int64 Num)
+	{
+		TArray64<uint8> Data;
+		Data.SetNumUninitialized(Num);
+		uint32 State = 0x2545F491;
+		for (int64 ByteIndex = 0; ByteIndex < Num; ByteIndex++)
+		{
+			State ^= State << 13;
+			State ^= State >> 17;
+			State ^= State << 5;
+			Data[ByteIndex] = (ByteIndex / 4096) % 2 ? static_cast<uint8>(State) : static_cast<uint8>(ByteIndex / 4096);
+		}
+		return Data;
+	}
+
+	TArray64<uint8> MakeGlb(const TArray64<uint8>& BinaryChunk)
+	{
+		FTCHARToUTF8 JsonConverter(*FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":%lld}],\"nodes\":[{\"name\":\"Streamed\"}],\"scenes\":[{\"nodes\":[0]}]}"), BinaryChunk.Num()));
+		TArray64<uint8> Json;
+		Json.Append(reinterpret_cast<const uint8*>(JsonConverter.Get()), JsonConverter.Length());
+		while (Json.Num() % 4)
+		{
+			Json.Add(' ');
+		}
+
+		auto AppendUInt32 = [](TArray64<uint8>& Bytes, const uint32 Value)
+			{
+				Bytes.Append(reinterpret_cast<const uint8*>(&Value), sizeof(uint32));
+			};
+
+		TArray64<uint8> Glb;
+		Glb.Reserve(12 + 8 + Json.Num() + 8 + BinaryChunk.Num());
+		AppendUInt32(Glb, 0x46546C67);
+		AppendUInt32(Glb, 2);
+		AppendUInt32(Glb, static_cast<uint32>(12 + 8 + Json.Num() + 8 + BinaryChunk.Num()));
+		AppendUInt32(Glb, static_cast<uint32>(Json.Num()));
+		AppendUInt32(Glb, 0x4E4F534A);
+		Glb.Append(Json);
+		AppendUInt32(Glb, static_cast<uint32>(BinaryChunk.Num()));
+		AppendUInt32(Glb, 0x004E4942);
+		Glb.Append(BinaryChunk);
+		return Glb;
+	}
+
+	TArray64<uint8> Gzip(const TArray64<uint8>& Data)
+	{
+		TArray64<uint8> Compressed;
+		z_stream Stream;
+		FMemory::Memzero(Stream);
+		if (deflateInit2(&Stream, 1, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		{
+			return Compressed;
+		}
+		Compressed.SetNumUninitialized(deflateBound(&Stream, static_cast<uLong>(Data.Num())));
+		Stream.next_in = const_cast<Bytef*>(Data.GetData());
+		Stream.avail_in = static_cast<uInt>(Data.Num());
+		Stream.next_out = Compressed.GetData();
+		Stream.avail_out = static_cast<uInt>(Compressed.Num());
+		const int32 Result = deflate(&Stream, Z_FINISH);
+		Compressed.SetNum(Result == Z_STREAM_END ? Stream.total_out : 0);
+		deflateEnd(&Stream);
+		return Compressed;
+	}
+
+	// the old path: inflate everything, then parse the uncompressed copy
+	TSharedPtr<FglTFRuntimeParser> InflateAndParse(const TArray64<uint8>& Compressed, const int64 UncompressedNum)
+	{
+		TArray64<uint8> Uncompressed;
+		Uncompressed.SetNumUninitialized(UncompressedNum);
+		z_stream Stream;
+		FMemory::Memzero(Stream);
+		if (inflateInit2(&Stream, 16 + MAX_WBITS) != Z_OK)
+		{
+			return nullptr;
+		}
+		Stream.next_in = const_cast<Bytef*>(Compressed.GetData());
+		Stream.avail_in = static_cast<uInt>(Compressed.Num());
+		Stream.next_out = Uncompressed.GetData();
+		Stream.avail_out = static_cast<uInt>(Uncompressed.Num());
+		const int32 Result = inflate(&Stream, Z_FINISH);
+		inflateEnd(&Stream);
+		return Result == Z_STREAM_END ? FglTFRuntimeParser::FromData(Uncompressed.GetData(), Uncompressed.Num(), FglTFRuntimeConfig()) : nullptr;
+	}
+
+	// polls the process memory from another thread while the measured code runs
+	int64 MeasurePeakMemoryGrowth(TFunctionRef<void()> Callback)
+	{
+		const int64 StartUsedPhysical = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+		FThreadSafeBool bDone = false;
+		TFuture<int64> PeakUsedPhysical = Async(EAsyncExecution::Thread, [&bDone, StartUsedPhysical]()
+			{
+				int64 Peak = StartUsedPhysical;
+				while (!bDone)
+				{
+					Peak = FMath::Max(Peak, static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical));
+					FPlatformProcess::Sleep(0.001f);
+				}
+				return Peak;
+			});
+
+		Callback();
+		const int64 EndUsedPhysical = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+		bDone = true;
+		return FMath::Max(PeakUsedPhysical.Get(), EndUsedPhysical) - StartUsedPhysical;
+	}
+
+	bool HasBinaryChunk(TSharedPtr<FglTFRuntimeParser> Parser, const TArray64<uint8>& BinaryChunk)
+	{
+		FglTFRuntimeBlob Blob;
+		return Parser && Parser->GetBuffer(0, Blob) && Blob.Num == BinaryChunk.Num() && FMemory::Memcmp(Blob.Data, BinaryChunk.GetData(), Blob.Num) == 0;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeGzipStreamTest, "glTFRuntime.Gzip.Stream", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeGzipStreamTest::RunTest(const FString& Parameters)
+{
+	const TArray64<uint8> BinaryChunk = glTFRuntimeGzipTests::MakeBinaryChunk(3 * 1024 * 1024 + 12);
+	const TArray64<uint8> Glb = glTFRuntimeGzipTests::MakeGlb(BinaryChunk);
+	TArray64<uint8> Compressed = glTFRuntimeGzipTests::Gzip(Glb);
+	if (Compressed.Num() == 0)
+	{
+		AddError(TEXT("Unable to compress the test asset"));
+		return false;
+	}
+
+	TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromData(Compressed.GetData(), Compressed.Num(), FglTFRuntimeConfig());
+	TestTrue(TEXT("Streamed binary chunk"), glTFRuntimeGzipTests::HasBinaryChunk(Parser, BinaryChunk));
+	FglTFRuntimeNode Node;
+	TestTrue(TEXT("Streamed json chunk"), Parser && Parser->LoadNode(0, Node) && Node.Name == TEXT("Streamed"));
+
+	// gzipped json goes through the plain path
+	FTCHARToUTF8 JsonConverter(TEXT("{\"asset\":{\"version\":\"2.0\"},\"nodes\":[{\"name\":\"Plain\"}]}"));
+	TArray64<uint8> Json;
+	Json.Append(reinterpret_cast<const uint8*>(JsonConverter.Get()), JsonConverter.Length());
+	const TArray64<uint8> CompressedJson = glTFRuntimeGzipTests::Gzip(Json);
+	TSharedPtr<FglTFRuntimeParser> JsonParser = FglTFRuntimeParser::FromData(CompressedJson.GetData(), CompressedJson.Num(), FglTFRuntimeConfig());
+	FglTFRuntimeNode JsonNode;
+	TestTrue(TEXT("Gzipped json"), JsonParser && JsonParser->LoadNode(0, JsonNode) && JsonNode.Name == TEXT("Plain"));
+
+	// a wrong crc in the trailer is detected even if the whole binary chunk has been inflated
+	AddExpectedError(TEXT("Unable to uncompress Gzip data"), EAutomationExpectedErrorFlags::Contains, 1);
+	Compressed[Compressed.Num() - 8] ^= 0xFF;
+	TestFalse(TEXT("Corrupted trailer"), FglTFRuntimeParser::FromData(Compressed.GetData(), Compressed.Num(), FglTFRuntimeConfig()).IsValid());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeGzipPeakMemoryTest, "glTFRuntime.Gzip.PeakMemory", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeGzipPeakMemoryTest::RunTest(const FString& Parameters)
+{
+	constexpr int64 BinaryChunkNum = 128 * 1024 * 1024;
+	TArray64<uint8> Compressed;
+	{
+		const TArray64<uint8> BinaryChunk = glTFRuntimeGzipTests::MakeBinaryChunk(BinaryChunkNum);
+		Compressed = glTFRuntimeGzipTests::Gzip(glTFRuntimeGzipTests::MakeGlb(BinaryChunk));
+	}
+	if (Compressed.Num() == 0)
+	{
+		AddError(TEXT("Unable to compress the test asset"));
+		return false;
+	}
+
+	// only the parser buffer is allocated, inflating into a temporary copy would need twice the memory
+	TSharedPtr<FglTFRuntimeParser> Parser;
+	const int64 PeakGrowth = glTFRuntimeGzipTests::MeasurePeakMemoryGrowth([&]()
+		{
+			Parser = FglTFRuntimeParser::FromData(Compressed.GetData(), Compressed.Num(), FglTFRuntimeConfig());
+		});
+
+	FglTFRuntimeBlob Blob;
+	TestTrue(TEXT("Parsed"), Parser.IsValid() && Parser->GetBuffer(0, Blob) && Blob.Num == BinaryChunkNum);
+	TestTrue(TEXT("Peak memory"), PeakGrowth < BinaryChunkNum * 5 / 4);
+
+	AddInfo(FString::Printf(TEXT("%.2f MB binary chunk (%.2f MB gzipped): peak memory growth %.2f MB"),
+		BinaryChunkNum / (1024.0 * 1024.0), Compressed.Num() / (1024.0 * 1024.0), PeakGrowth / (1024.0 * 1024.0)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeGzipBenchmarkTest, "glTFRuntime.Gzip.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeGzipBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int64 BinaryChunkNum = 512 * 1024 * 1024;
+	TArray64<uint8> Compressed;
+	int64 UncompressedNum = 0;
+	{
+		const TArray64<uint8> Glb = glTFRuntimeGzipTests::MakeGlb(glTFRuntimeGzipTests::MakeBinaryChunk(BinaryChunkNum));
+		UncompressedNum = Glb.Num();
+		Compressed = glTFRuntimeGzipTests::Gzip(Glb);
+	}
+	if (Compressed.Num() == 0)
+	{
+		AddError(TEXT("Unable to compress the benchmark asset"));
+		return false;
+	}
+
+	auto Measure = [](TFunctionRef<TSharedPtr<FglTFRuntimeParser>()> Parse, bool& bParsed, int64& PeakGrowth)
+		{
+			double Time = 0;
+			PeakGrowth = glTFRuntimeGzipTests::MeasurePeakMemoryGrowth([&]()
+				{
+					const double StartTime = FPlatformTime::Seconds();
+					TSharedPtr<FglTFRuntimeParser> Parser = Parse();
+					Time = FPlatformTime::Seconds() - StartTime;
+					FglTFRuntimeBlob Blob;
+					bParsed = Parser.IsValid() && Parser->GetBuffer(0, Blob) && Blob.Num == BinaryChunkNum;
+				});
+			return Time;
+		};
+
+	bool bStreamedParsed = false;
+	int64 StreamedPeakGrowth = 0;
+	const double StreamedTime = Measure([&]() { return FglTFRuntimeParser::FromData(Compressed.GetData(), Compressed.Num(), FglTFRuntimeConfig()); }, bStreamedParsed, StreamedPeakGrowth);
+
+	bool bInflatedParsed = false;
+	int64 InflatedPeakGrowth = 0;
+	const double InflatedTime = Measure([&]() { return glTFRuntimeGzipTests::InflateAndParse(Compressed, UncompressedNum); }, bInflatedParsed, InflatedPeakGrowth);
+
+	TestTrue(TEXT("Streamed"), bStreamedParsed);
+	TestTrue(TEXT("Inflated"), bInflatedParsed);
+
+	AddInfo(FString::Printf(TEXT("%.2f MB glb (%.2f MB gzipped): streamed %.2f ms (peak growth %.2f MB), inflate then parse %.2f ms (peak growth %.2f MB)"),
+		UncompressedNum / (1024.0 * 1024.0), Compressed.Num() / (1024.0 * 1024.0), StreamedTime * 1000.0, StreamedPeakGrowth / (1024.0 * 1024.0), InflatedTime * 1000.0, InflatedPeakGrowth / (1024.0 * 1024.0)));
+
+	return true;
+}
+
+#endif
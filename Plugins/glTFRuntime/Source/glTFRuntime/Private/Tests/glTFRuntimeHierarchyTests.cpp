@@ -0,0 +1,385 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeParser.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace glTFRuntimeHierarchyTests
+{
+	// exposes the hierarchy queries used by the skeleton builders
+	class FTestParser : public FglTFRuntimeParser
+	{
+	public:
+		using FglTFRuntimeParser::FglTFRuntimeParser;
+		using FglTFRuntimeParser::IsNodeAncestor;
+		using FglTFRuntimeParser::FindLowestCommonAncestor;
+		using FglTFRuntimeParser::FindCommonRoot;
+		using FglTFRuntimeParser::FindTopRoot;
+		using FglTFRuntimeParser::HasRoot;
+	};
+
+	TSharedPtr<FTestParser> MakeParser(const FString& Json)
+	{
+		TSharedPtr<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromString(Json);
+		if (!JsonTape)
+		{
+			return nullptr;
+		}
+		const FglTFRuntimeConfig LoaderConfig;
+		return MakeShared<FTestParser>(JsonTape.ToSharedRef(), LoaderConfig.GetMatrix(), LoaderConfig.SceneScale);
+	}
+
+	// Children[NodeIndex] are serialized as the "children" of each node, without a RandomStream the nodes have identity transforms
+	FString MakeNodesJson(const TArray<TArray<int32>>& Children, FRandomStream* RandomStream)
+	{
+		FString Nodes;
+		for (int32 NodeIndex = 0; NodeIndex < Children.Num(); NodeIndex++)
+		{
+			FString ChildrenJson;
+			for (const int32 ChildIndex : Children[NodeIndex])
+			{
+				ChildrenJson += FString::Printf(TEXT("%s%d"), ChildrenJson.IsEmpty() ? TEXT("") : TEXT(","), ChildIndex);
+			}
+
+			if (!RandomStream)
+			{
+				Nodes += FString::Printf(TEXT("%s{\"children\":[%s]}"), NodeIndex > 0 ? TEXT(",") : TEXT(""), *ChildrenJson);
+				continue;
+			}
+
+			// uniform scales only, non uniform scales under rotations are not representable by FTransform
+			const FQuat Rotation = FQuat(RandomStream->FRandRange(-1.f, 1.f), RandomStream->FRandRange(-1.f, 1.f), RandomStream->FRandRange(-1.f, 1.f), RandomStream->FRandRange(-1.f, 1.f)).GetNormalized();
+			const FVector Translation = RandomStream->VRand() * RandomStream->FRandRange(0.f, 10.f);
+			const float Scale = RandomStream->FRandRange(0.8f, 1.25f);
+			Nodes += FString::Printf(TEXT("%s{\"children\":[%s],\"translation\":[%f,%f,%f],\"rotation\":[%f,%f,%f,%f],\"scale\":[%f,%f,%f]}"),
+				NodeIndex > 0 ? TEXT(",") : TEXT(""), *ChildrenJson,
+				Translation.X, Translation.Y, Translation.Z, Rotation.X, Rotation.Y, Rotation.Z, Rotation.W, Scale, Scale, Scale);
+		}
+		return FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"nodes\":[%s]}"), *Nodes);
+	}
+
+	// random forest with parents stored at random positions (not only before their children)
+	TArray<TArray<int32>> MakeForest(FRandomStream& RandomStream, const int32 NumOfNodes, const int32 NumOfRoots)
+	{
+		TArray<int32> Permutation;
+		for (int32 NodeIndex = 0; NodeIndex < NumOfNodes; NodeIndex++)
+		{
+			Permutation.Add(NodeIndex);
+		}
+		for (int32 NodeIndex = NumOfNodes - 1; NodeIndex > 0; NodeIndex--)
+		{
+			Permutation.Swap(NodeIndex, RandomStream.RandRange(0, NodeIndex));
+		}
+
+		TArray<TArray<int32>> Children;
+		Children.SetNum(NumOfNodes);
+		for (int32 Position = NumOfRoots; Position < NumOfNodes; Position++)
+		{
+			// mostly attached to a recent node, so some branches get deep
+			const int32 ParentPosition = RandomStream.RandRange(0, 3) == 0 ? RandomStream.RandRange(0, Position - 1) : FMath::Max(Position - RandomStream.RandRange(1, 4), 0);
+			Children[Permutation[ParentPosition]].Add(Permutation[Position]);
+		}
+		return Children;
+	}
+
+	// reference implementations walking the parent chain
+	TArray<int32> GetAncestors(const TArray<FglTFRuntimeNode>& Nodes, const int32 NodeIndex)
+	{
+		TArray<int32> Ancestors;
+		for (int32 CurrentIndex = NodeIndex; CurrentIndex != INDEX_NONE; CurrentIndex = Nodes[CurrentIndex].ParentIndex)
+		{
+			Ancestors.Add(CurrentIndex);
+		}
+		return Ancestors;
+	}
+
+	int32 FindLowestCommonAncestorNaive(const TArray<FglTFRuntimeNode>& Nodes, const int32 NodeIndexA, const int32 NodeIndexB)
+	{
+		const TArray<int32> AncestorsA = GetAncestors(Nodes, NodeIndexA);
+		for (int32 CurrentIndex = NodeIndexB; CurrentIndex != INDEX_NONE; CurrentIndex = Nodes[CurrentIndex].ParentIndex)
+		{
+			if (AncestorsA.Contains(CurrentIndex))
+			{
+				return CurrentIndex;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	FTransform GetNodeWorldTransformNaive(const TArray<FglTFRuntimeNode>& Nodes, const int32 NodeIndex)
+	{
+		FTransform WorldTransform = FTransform::Identity;
+		for (int32 CurrentIndex = Nodes[NodeIndex].ParentIndex; CurrentIndex != INDEX_NONE; CurrentIndex = Nodes[CurrentIndex].ParentIndex)
+		{
+			WorldTransform = Nodes[CurrentIndex].Transform * WorldTransform;
+		}
+		return WorldTransform * Nodes[NodeIndex].Transform;
+	}
+
+	bool HasRootNaive(const TArray<FglTFRuntimeNode>& Nodes, const int32 NodeIndex, const int32 RootIndex)
+	{
+		for (int32 CurrentIndex = NodeIndex; CurrentIndex != INDEX_NONE; CurrentIndex = Nodes[CurrentIndex].ParentIndex)
+		{
+			if (CurrentIndex == RootIndex)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// the common root search used before the flattened table: climb from the first joint until every joint is below it
+	int32 FindCommonRootNaive(const TArray<FglTFRuntimeNode>& Nodes, const TArray<int32>& Indices)
+	{
+		int32 CurrentRootIndex = Indices[0];
+		while (CurrentRootIndex != INDEX_NONE)
+		{
+			bool bTryNextParent = false;
+			for (const int32 Index : Indices)
+			{
+				if (!HasRootNaive(Nodes, Index, CurrentRootIndex))
+				{
+					bTryNextParent = true;
+					break;
+				}
+			}
+			if (!bTryNextParent)
+			{
+				return CurrentRootIndex;
+			}
+			CurrentRootIndex = Nodes[CurrentRootIndex].ParentIndex;
+		}
+		return INDEX_NONE;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeHierarchyLCATest, "glTFRuntime.Hierarchy.LCA", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeHierarchyLCATest::RunTest(const FString& Parameters)
+{
+	FRandomStream RandomStream(42);
+
+	for (const int32 NumOfRoots : { 1, 5 })
+	{
+		constexpr int32 NumOfNodes = 300;
+		TSharedPtr<glTFRuntimeHierarchyTests::FTestParser> Parser = glTFRuntimeHierarchyTests::MakeParser(glTFRuntimeHierarchyTests::MakeNodesJson(glTFRuntimeHierarchyTests::MakeForest(RandomStream, NumOfNodes, NumOfRoots), &RandomStream));
+		TArray<FglTFRuntimeNode> Nodes;
+		if (!Parser || !Parser->GetAllNodes(Nodes) || Nodes.Num() != NumOfNodes)
+		{
+			AddError(TEXT("Unable to load the nodes"));
+			return false;
+		}
+
+		for (int32 NodeIndex = 0; NodeIndex < NumOfNodes; NodeIndex++)
+		{
+			const FglTFRuntimeNode& Node = Nodes[NodeIndex];
+			const TArray<int32> Ancestors = glTFRuntimeHierarchyTests::GetAncestors(Nodes, NodeIndex);
+
+			const FTransform ExpectedWorldTransform = glTFRuntimeHierarchyTests::GetNodeWorldTransformNaive(Nodes, NodeIndex);
+			if (!Parser->GetNodeWorldTransform(Node).Equals(ExpectedWorldTransform, 1e-2))
+			{
+				AddError(FString::Printf(TEXT("%d roots: world transform of node %d is %s, expected %s"), NumOfRoots, NodeIndex, *Parser->GetNodeWorldTransform(Node).ToString(), *ExpectedWorldTransform.ToString()));
+				return false;
+			}
+
+			const FTransform ExpectedParentWorldTransform = Node.ParentIndex != INDEX_NONE ? glTFRuntimeHierarchyTests::GetNodeWorldTransformNaive(Nodes, Node.ParentIndex) : FTransform::Identity;
+			if (!Parser->GetParentNodeWorldTransform(Node).Equals(ExpectedParentWorldTransform, 1e-2))
+			{
+				AddError(FString::Printf(TEXT("%d roots: parent world transform of node %d differs"), NumOfRoots, NodeIndex));
+				return false;
+			}
+
+			if (Parser->FindTopRoot(NodeIndex) != Ancestors.Last())
+			{
+				AddError(FString::Printf(TEXT("%d roots: top root of node %d is %d, expected %d"), NumOfRoots, NodeIndex, Parser->FindTopRoot(NodeIndex), Ancestors.Last()));
+				return false;
+			}
+
+			for (int32 OtherIndex = 0; OtherIndex < NumOfNodes; OtherIndex++)
+			{
+				const int32 AncestorPosition = Ancestors.Find(OtherIndex);
+				const int32 ExpectedLCA = glTFRuntimeHierarchyTests::FindLowestCommonAncestorNaive(Nodes, NodeIndex, OtherIndex);
+				const int32 LCA = Parser->FindLowestCommonAncestor(NodeIndex, OtherIndex);
+				const bool bIsAncestor = AncestorPosition != INDEX_NONE;
+				if (LCA != ExpectedLCA || Parser->IsNodeAncestor(NodeIndex, OtherIndex) != bIsAncestor || Parser->HasRoot(NodeIndex, OtherIndex) != bIsAncestor ||
+					Parser->GetNodeDistance(Node, OtherIndex) != (bIsAncestor ? AncestorPosition : -1))
+				{
+					AddError(FString::Printf(TEXT("%d roots: nodes %d and %d: LCA %d (expected %d), ancestor %d (expected %d), distance %d (expected %d)"), NumOfRoots, NodeIndex, OtherIndex,
+						LCA, ExpectedLCA, Parser->IsNodeAncestor(NodeIndex, OtherIndex) ? 1 : 0, bIsAncestor ? 1 : 0, Parser->GetNodeDistance(Node, OtherIndex), bIsAncestor ? AncestorPosition : -1));
+					return false;
+				}
+			}
+		}
+
+		for (int32 Query = 0; Query < 1000; Query++)
+		{
+			TArray<int32> Joints;
+			const int32 NumOfJoints = RandomStream.RandRange(1, 6);
+			int32 ExpectedCommonRoot = INDEX_NONE;
+			for (int32 JointIndex = 0; JointIndex < NumOfJoints; JointIndex++)
+			{
+				const int32 Joint = RandomStream.RandRange(0, NumOfNodes - 1);
+				ExpectedCommonRoot = JointIndex == 0 ? Joint : (ExpectedCommonRoot != INDEX_NONE ? glTFRuntimeHierarchyTests::FindLowestCommonAncestorNaive(Nodes, ExpectedCommonRoot, Joint) : INDEX_NONE);
+				Joints.Add(Joint);
+			}
+
+			if (Parser->FindCommonRoot(Joints) != ExpectedCommonRoot)
+			{
+				AddError(FString::Printf(TEXT("%d roots: common root of %d joints is %d, expected %d"), NumOfRoots, NumOfJoints, Parser->FindCommonRoot(Joints), ExpectedCommonRoot));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeHierarchyDegenerateTest, "glTFRuntime.Hierarchy.Degenerate", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeHierarchyDegenerateTest::RunTest(const FString& Parameters)
+{
+	FRandomStream RandomStream(43);
+
+	// a chain deep enough to overflow the stack of a recursive visit
+	constexpr int32 ChainLength = 100000;
+	TArray<TArray<int32>> Chain;
+	Chain.SetNum(ChainLength);
+	for (int32 NodeIndex = 0; NodeIndex < ChainLength - 1; NodeIndex++)
+	{
+		Chain[NodeIndex].Add(NodeIndex + 1);
+	}
+
+	TSharedPtr<glTFRuntimeHierarchyTests::FTestParser> ChainParser = glTFRuntimeHierarchyTests::MakeParser(glTFRuntimeHierarchyTests::MakeNodesJson(Chain, nullptr));
+	TArray<FglTFRuntimeNode> ChainNodes;
+	if (!ChainParser || !ChainParser->GetAllNodes(ChainNodes))
+	{
+		AddError(TEXT("Unable to load the chain"));
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	TestEqual(TEXT("Chain distance"), ChainParser->GetNodeDistance(ChainNodes.Last(), 0), ChainLength - 1);
+	TestEqual(TEXT("Chain LCA"), ChainParser->FindLowestCommonAncestor(ChainLength - 1, ChainLength / 2), ChainLength / 2);
+	TestEqual(TEXT("Chain common root"), ChainParser->FindCommonRoot({ ChainLength - 1, ChainLength / 3, ChainLength / 2 }), ChainLength / 3);
+	TestTrue(TEXT("Chain root"), ChainParser->HasRoot(ChainLength - 1, 0));
+	TestFalse(TEXT("Chain inverted root"), ChainParser->HasRoot(0, ChainLength - 1));
+	AddInfo(FString::Printf(TEXT("%d nodes chain queries: %.2f ms"), ChainLength, (FPlatformTime::Seconds() - StartTime) * 1000.0));
+
+	// 0 -> 1 -> 2 -> 0 is a cycle without roots, 3 is a lone root and 4 is listed as child twice
+	TArray<TArray<int32>> Cycle;
+	Cycle.SetNum(6);
+	Cycle[0].Add(1);
+	Cycle[1].Add(2);
+	Cycle[2].Add(0);
+	Cycle[3].Append({ 4, 4, 5 });
+
+	TSharedPtr<glTFRuntimeHierarchyTests::FTestParser> CycleParser = glTFRuntimeHierarchyTests::MakeParser(glTFRuntimeHierarchyTests::MakeNodesJson(Cycle, &RandomStream));
+	TArray<FglTFRuntimeNode> CycleNodes;
+	if (!CycleParser || !CycleParser->GetAllNodes(CycleNodes))
+	{
+		AddError(TEXT("Unable to load the cycle"));
+		return false;
+	}
+
+	TestEqual(TEXT("Cycle LCA"), CycleParser->FindLowestCommonAncestor(0, 2), static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("Cycle and tree LCA"), CycleParser->FindLowestCommonAncestor(1, 4), static_cast<int32>(INDEX_NONE));
+	TestTrue(TEXT("Cycle node is its own root"), CycleParser->HasRoot(1, 1));
+	TestEqual(TEXT("Duplicated child LCA"), CycleParser->FindLowestCommonAncestor(4, 5), 3);
+	TestEqual(TEXT("Duplicated child distance"), CycleParser->GetNodeDistance(CycleNodes[4], 3), 1);
+	TestEqual(TEXT("Disjoint trees common root"), CycleParser->FindCommonRoot({ 4, 1 }), static_cast<int32>(INDEX_NONE));
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeHierarchyBenchmarkTest, "glTFRuntime.Hierarchy.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeHierarchyBenchmarkTest::RunTest(const FString& Parameters)
+{
+	FRandomStream RandomStream(44);
+
+	constexpr int32 NumOfNodes = 20000;
+	constexpr int32 NumOfQueries = 20000;
+	const FString Json = glTFRuntimeHierarchyTests::MakeNodesJson(glTFRuntimeHierarchyTests::MakeForest(RandomStream, NumOfNodes, 1), &RandomStream);
+
+	// the table is built by LoadNodes, so the first GetAllNodes pays for it
+	TSharedPtr<glTFRuntimeHierarchyTests::FTestParser> Parser = glTFRuntimeHierarchyTests::MakeParser(Json);
+	TArray<FglTFRuntimeNode> Nodes;
+	const double BuildStartTime = FPlatformTime::Seconds();
+	if (!Parser || !Parser->GetAllNodes(Nodes) || Nodes.Num() != NumOfNodes)
+	{
+		AddError(TEXT("Unable to load the nodes"));
+		return false;
+	}
+	const double BuildTime = FPlatformTime::Seconds() - BuildStartTime;
+
+	TArray<TArray<int32>> Queries;
+	for (int32 Query = 0; Query < NumOfQueries; Query++)
+	{
+		TArray<int32>& Joints = Queries.AddDefaulted_GetRef();
+		const int32 NumOfJoints = RandomStream.RandRange(2, 6);
+		for (int32 JointIndex = 0; JointIndex < NumOfJoints; JointIndex++)
+		{
+			Joints.Add(RandomStream.RandRange(0, NumOfNodes - 1));
+		}
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+	TArray<FVector> TableTranslations;
+	TableTranslations.Reserve(NumOfNodes);
+	for (const FglTFRuntimeNode& Node : Nodes)
+	{
+		TableTranslations.Add(Parser->GetNodeWorldTransform(Node).GetTranslation());
+	}
+	const double TableTransformsTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	TArray<FVector> NaiveTranslations;
+	NaiveTranslations.Reserve(NumOfNodes);
+	for (int32 NodeIndex = 0; NodeIndex < NumOfNodes; NodeIndex++)
+	{
+		NaiveTranslations.Add(glTFRuntimeHierarchyTests::GetNodeWorldTransformNaive(Nodes, NodeIndex).GetTranslation());
+	}
+	const double NaiveTransformsTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	TArray<int32> TableCommonRoots;
+	TableCommonRoots.Reserve(NumOfQueries);
+	for (const TArray<int32>& Joints : Queries)
+	{
+		TableCommonRoots.Add(Parser->FindCommonRoot(Joints));
+	}
+	const double TableCommonRootsTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	TArray<int32> NaiveCommonRoots;
+	NaiveCommonRoots.Reserve(NumOfQueries);
+	for (const TArray<int32>& Joints : Queries)
+	{
+		NaiveCommonRoots.Add(glTFRuntimeHierarchyTests::FindCommonRootNaive(Nodes, Joints));
+	}
+	const double NaiveCommonRootsTime = FPlatformTime::Seconds() - StartTime;
+
+	// the composition order differs (root first vs leaf first), so the error grows with the distance from the root
+	for (int32 NodeIndex = 0; NodeIndex < NumOfNodes; NodeIndex++)
+	{
+		if (!TableTranslations[NodeIndex].Equals(NaiveTranslations[NodeIndex], FMath::Max(NaiveTranslations[NodeIndex].GetAbsMax() * 1e-4, 1e-2)))
+		{
+			AddError(FString::Printf(TEXT("World translation of node %d is %s, expected %s"), NodeIndex, *TableTranslations[NodeIndex].ToString(), *NaiveTranslations[NodeIndex].ToString()));
+			return false;
+		}
+	}
+	TestTrue(TEXT("Common roots"), TableCommonRoots == NaiveCommonRoots);
+
+	AddInfo(FString::Printf(TEXT("%d nodes: table built in %.2f ms"), NumOfNodes, BuildTime * 1000.0));
+	AddInfo(FString::Printf(TEXT("World transforms: table %.2f ms, parent walk %.2f ms (%.2fx)"), TableTransformsTime * 1000.0, NaiveTransformsTime * 1000.0, NaiveTransformsTime / FMath::Max(TableTransformsTime, SMALL_NUMBER)));
+	AddInfo(FString::Printf(TEXT("%d common roots: table %.2f ms, parent walk %.2f ms (%.2fx)"), NumOfQueries, TableCommonRootsTime * 1000.0, NaiveCommonRootsTime * 1000.0, NaiveCommonRootsTime / FMath::Max(TableCommonRootsTime, SMALL_NUMBER)));
+
+	return true;
+}
+
+#endif
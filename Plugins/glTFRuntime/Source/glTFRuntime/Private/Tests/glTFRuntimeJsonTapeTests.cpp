@@ -0,0 +1,305 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeJsonTape.h"
+#include "glTFRuntimeParser.h"
+#include "HAL/PlatformTime.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace glTFRuntimeJsonTapeTests
+{
+	FString ToCondensedJson(const TSharedPtr<FJsonObject>& JsonObject)
+	{
+		FString Json;
+		if (JsonObject)
+		{
+			TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+			FJsonSerializer::Serialize(JsonObject.ToSharedRef(), JsonWriter);
+		}
+		return Json;
+	}
+
+	TSharedPtr<FJsonObject> Deserialize(const FString& Json)
+	{
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Json);
+		if (!FJsonSerializer::Deserialize(JsonReader, JsonObject))
+		{
+			return nullptr;
+		}
+		return JsonObject;
+	}
+
+	// a glTF-like document with NumNodes nodes (each one with its own mesh and accessor)
+	FString MakeTestDocument(const int32 NumNodes)
+	{
+		FString Nodes;
+		FString Meshes;
+		FString Accessors;
+		for (int32 Index = 0; Index < NumNodes; Index++)
+		{
+			const TCHAR* Separator = Index > 0 ? TEXT(",") : TEXT("");
+			Nodes += FString::Printf(TEXT("%s{\"name\":\"Node_%d\",\"mesh\":%d,\"translation\":[%d.5,-%d.25,1e-3],\"rotation\":[0,0,0.7071067811865476,0.7071067811865476],\"children\":[]}"), Separator, Index, Index, Index, Index);
+			Meshes += FString::Printf(TEXT("%s{\"name\":\"Mesh \\\"%d\\\"\",\"primitives\":[{\"attributes\":{\"POSITION\":%d},\"material\":0,\"mode\":4}]}"), Separator, Index, Index);
+			Accessors += FString::Printf(TEXT("%s{\"bufferView\":0,\"componentType\":5126,\"count\":%d,\"type\":\"VEC3\",\"min\":[-1,-1,-1],\"max\":[1,1,1]}"), Separator, Index + 1);
+		}
+		return FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\",\"generator\":\"caf\\u00e9 \\ud83d\\ude00\"},\"scene\":0,\"scenes\":[{\"name\":\"Scene\",\"nodes\":[0]}],\"nodes\":[%s],\"meshes\":[%s],\"accessors\":[%s],\"extras\":{\"flag\":true,\"nothing\":null}}"), *Nodes, *Meshes, *Accessors);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeJsonTapeEquivalenceTest, "glTFRuntime.JsonTape.Equivalence", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeJsonTapeEquivalenceTest::RunTest(const FString& Parameters)
+{
+	const TArray<FString> Documents = {
+		TEXT("{}"),
+		TEXT("{\"a\":[],\"b\":{},\"c\":[[],[{}]],\"d\":null}"),
+		TEXT("{\"escapes\":\"\\\"\\\\\\/\\b\\f\\n\\r\\t\\u0041\\u00e9\\u4e2d\",\"numbers\":[0,-0,1,-1,0.5,1e10,1E-10,-2.5e+3,123456789012]}"),
+		TEXT(" { \"spaces\" : [ 1 , 2 ] ,\n\t\"bools\" : [ true , false ] } "),
+		glTFRuntimeJsonTapeTests::MakeTestDocument(16)
+	};
+
+	for (const FString& Document : Documents)
+	{
+		TSharedPtr<FJsonObject> ExpectedObject = glTFRuntimeJsonTapeTests::Deserialize(Document);
+		if (!ExpectedObject)
+		{
+			AddError(FString::Printf(TEXT("FJsonSerializer could not parse %s"), *Document));
+			return false;
+		}
+		const FString Expected = glTFRuntimeJsonTapeTests::ToCondensedJson(ExpectedObject);
+
+		TSharedPtr<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromString(Document);
+		if (!JsonTape)
+		{
+			AddError(FString::Printf(TEXT("The tape could not parse %s"), *Document));
+			return false;
+		}
+		TestEqual(TEXT("Parsed tape"), glTFRuntimeJsonTapeTests::ToCondensedJson(JsonTape->ToJsonObject(JsonTape->GetRootNode())), Expected);
+
+		// flattening an existing tree must give the same tape as parsing its text
+		TSharedRef<FglTFRuntimeJsonTape> FlattenedJsonTape = FglTFRuntimeJsonTape::FromJsonObject(ExpectedObject.ToSharedRef());
+		TestEqual(TEXT("Flattened tape"), glTFRuntimeJsonTapeTests::ToCondensedJson(FlattenedJsonTape->ToJsonObject(FlattenedJsonTape->GetRootNode())), Expected);
+
+		TArray<uint8> ParsedBytes;
+		TArray<uint8> FlattenedBytes;
+		JsonTape->AppendNodeBytes(JsonTape->GetRootNode(), ParsedBytes);
+		FlattenedJsonTape->AppendNodeBytes(FlattenedJsonTape->GetRootNode(), FlattenedBytes);
+		TestTrue(TEXT("Parsed and flattened tapes have the same bytes"), ParsedBytes == FlattenedBytes);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeJsonTapeDuplicateKeysTest, "glTFRuntime.JsonTape.DuplicateKeys", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeJsonTapeDuplicateKeysTest::RunTest(const FString& Parameters)
+{
+	const FString Document = TEXT("{\"mesh\":1,\"name\":\"first\",\"mesh\":2,\"name\":\"last\"}");
+
+	TSharedPtr<FJsonObject> JsonObject = glTFRuntimeJsonTapeTests::Deserialize(Document);
+	TSharedPtr<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromString(Document);
+	if (!JsonObject || !JsonTape)
+	{
+		AddError(TEXT("Unable to parse the document"));
+		return false;
+	}
+
+	TestEqual(TEXT("FJsonObject mesh"), JsonObject->GetIntegerField(TEXT("mesh")), 2);
+	TestEqual(TEXT("Tape mesh"), JsonTape->GetIndexField(JsonTape->GetRootNode(), "mesh"), static_cast<int64>(2));
+	TestEqual(TEXT("Tape name"), JsonTape->GetStringField(JsonTape->GetRootNode(), "name"), JsonObject->GetStringField(TEXT("name")));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeJsonTapeConversionsTest, "glTFRuntime.JsonTape.Conversions", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeJsonTapeConversionsTest::RunTest(const FString& Parameters)
+{
+	const FString Document = TEXT("{\"values\":[true,false,0,1,-1,3.6,-2.5,2.5,0.5,1e20,-1e20,4294967296,\"42\",\"42.5\",\"-7\",\"true\",\"false\",\"text\",\"\",null,[],{}]}");
+
+	TSharedPtr<FJsonObject> JsonObject = glTFRuntimeJsonTapeTests::Deserialize(Document);
+	TSharedPtr<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromString(Document);
+	if (!JsonObject || !JsonTape)
+	{
+		AddError(TEXT("Unable to parse the document"));
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>& JsonValues = JsonObject->GetArrayField(TEXT("values"));
+	const int32 JsonValuesNode = JsonTape->GetArrayField(JsonTape->GetRootNode(), "values");
+	TestEqual(TEXT("Number of values"), JsonTape->GetArrayNum(JsonValuesNode), JsonValues.Num());
+
+	// every conversion must succeed or fail (and give the same value) exactly like FJsonValue does
+	for (int32 Index = 0; Index < JsonValues.Num(); Index++)
+	{
+		const int32 ValueNode = JsonTape->GetArrayItem(JsonValuesNode, Index);
+		const FString Context = FString::Printf(TEXT("Value %d"), Index);
+
+		double ExpectedDouble = 0, Double = 0;
+		const bool bExpectedDouble = JsonValues[Index]->TryGetNumber(ExpectedDouble);
+		TestEqual(Context + TEXT(" as double succeeds"), JsonTape->TryGetNumber(ValueNode, Double), bExpectedDouble);
+		if (bExpectedDouble)
+		{
+			TestEqual(Context + TEXT(" as double"), Double, ExpectedDouble);
+		}
+
+		int32 ExpectedInt32 = 0, Int32 = 0;
+		const bool bExpectedInt32 = JsonValues[Index]->TryGetNumber(ExpectedInt32);
+		TestEqual(Context + TEXT(" as int32 succeeds"), JsonTape->TryGetNumber(ValueNode, Int32), bExpectedInt32);
+		if (bExpectedInt32)
+		{
+			TestEqual(Context + TEXT(" as int32"), Int32, ExpectedInt32);
+		}
+
+		int64 ExpectedInt64 = 0, Int64 = 0;
+		const bool bExpectedInt64 = JsonValues[Index]->TryGetNumber(ExpectedInt64);
+		TestEqual(Context + TEXT(" as int64 succeeds"), JsonTape->TryGetNumber(ValueNode, Int64), bExpectedInt64);
+		if (bExpectedInt64)
+		{
+			TestEqual(Context + TEXT(" as int64"), Int64, ExpectedInt64);
+		}
+
+		bool bExpectedBool = false, bBool = false;
+		const bool bExpectedBoolResult = JsonValues[Index]->TryGetBool(bExpectedBool);
+		TestEqual(Context + TEXT(" as bool succeeds"), JsonTape->TryGetBool(ValueNode, bBool), bExpectedBoolResult);
+		if (bExpectedBoolResult)
+		{
+			TestEqual(Context + TEXT(" as bool"), bBool, bExpectedBool);
+		}
+
+		FString ExpectedString, String;
+		const bool bExpectedString = JsonValues[Index]->TryGetString(ExpectedString);
+		TestEqual(Context + TEXT(" as string succeeds"), JsonTape->TryGetString(ValueNode, String), bExpectedString);
+		if (bExpectedString)
+		{
+			TestEqual(Context + TEXT(" as string"), String, ExpectedString);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeJsonTapeInvalidInputTest, "glTFRuntime.JsonTape.InvalidInput", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeJsonTapeInvalidInputTest::RunTest(const FString& Parameters)
+{
+	for (const TCHAR* Document : { TEXT(""), TEXT("{"), TEXT("{\"a\":}"), TEXT("{\"a\" 1}"), TEXT("[1 2]"), TEXT("{\"a\":\"unterminated}"), TEXT("{} trailing") })
+	{
+		TestFalse(FString::Printf(TEXT("Parsing %s"), Document), FglTFRuntimeJsonTape::FromString(Document).IsValid());
+	}
+
+	// lookups on an empty tape or with invalid nodes must not read out of bounds
+	FglTFRuntimeJsonTape EmptyJsonTape;
+	TestTrue(TEXT("Root of an empty tape"), EmptyJsonTape.GetNodeType(EmptyJsonTape.GetRootNode()) == FglTFRuntimeJsonTape::ENodeType::Null);
+	TestEqual(TEXT("Field of an empty tape"), EmptyJsonTape.FindField(EmptyJsonTape.GetRootNode(), "asset"), static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("Item of an empty tape"), EmptyJsonTape.GetRootArrayItem("nodes", 0), static_cast<int32>(INDEX_NONE));
+
+	TSharedPtr<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromString(TEXT("{\"nodes\":[1]}"));
+	if (!JsonTape)
+	{
+		AddError(TEXT("Unable to parse the document"));
+		return false;
+	}
+	TestTrue(TEXT("Node past the end"), JsonTape->GetNodeType(1000) == FglTFRuntimeJsonTape::ENodeType::Null);
+	TestTrue(TEXT("Negative node"), JsonTape->GetNodeType(INDEX_NONE) == FglTFRuntimeJsonTape::ENodeType::Null);
+	TestEqual(TEXT("Item past the end"), JsonTape->GetRootArrayItem("nodes", 1), static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("Object field of an array"), JsonTape->GetObjectField(JsonTape->GetRootNode(), "nodes"), static_cast<int32>(INDEX_NONE));
+	TestFalse(TEXT("Object of an invalid node"), JsonTape->ToJsonObject(INDEX_NONE).IsValid());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeJsonTapeNodeBytesTest, "glTFRuntime.JsonTape.NodeBytes", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeJsonTapeNodeBytesTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromString(TEXT("{\"x\":{\"a\":[1,2],\"b\":\"s\"},\"y\":{\"a\":[1,2],\"b\":\"s\"},\"z\":{\"a\":[1,3],\"b\":\"s\"},\"w\":{\"a\":[1,2],\"c\":\"s\"}}"));
+	if (!JsonTape)
+	{
+		AddError(TEXT("Unable to parse the document"));
+		return false;
+	}
+
+	auto GetBytes = [&JsonTape](const ANSICHAR* FieldName)
+		{
+			TArray<uint8> Bytes;
+			JsonTape->AppendNodeBytes(JsonTape->FindField(JsonTape->GetRootNode(), FieldName), Bytes);
+			return Bytes;
+		};
+
+	TestTrue(TEXT("Same subtree at different offsets"), GetBytes("x") == GetBytes("y"));
+	TestFalse(TEXT("Different number"), GetBytes("x") == GetBytes("z"));
+	TestFalse(TEXT("Different key"), GetBytes("x") == GetBytes("w"));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeJsonTapeStaleRootTest, "glTFRuntime.JsonTape.StaleRoot", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeJsonTapeStaleRootTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromString(TEXT("{\"asset\":{\"version\":\"2.0\"},\"scenes\":[{\"name\":\"Before\",\"nodes\":[0]}],\"nodes\":[{\"name\":\"Root\"}]}"), FglTFRuntimeConfig());
+	if (!Parser)
+	{
+		AddError(TEXT("Unable to create the parser"));
+		return false;
+	}
+
+	FglTFRuntimeScene Scene;
+	TestTrue(TEXT("Scene loaded"), Parser->LoadScene(0, Scene));
+	TestEqual(TEXT("Scene name before the change"), Scene.Name, FString(TEXT("Before")));
+
+	// changes made to the tree returned by GetJsonRoot() must be visible to the following lookups
+	TSharedPtr<FJsonObject> JsonRoot = Parser->GetJsonRoot();
+	JsonRoot->GetObjectField(TEXT("asset"))->SetStringField(TEXT("version"), TEXT("2.1"));
+	JsonRoot->GetArrayField(TEXT("scenes"))[0]->AsObject()->SetStringField(TEXT("name"), TEXT("After"));
+
+	TestEqual(TEXT("Version after the change"), Parser->GetVersion(), FString(TEXT("2.1")));
+	TestTrue(TEXT("Scene reloaded"), Parser->LoadScene(0, Scene));
+	TestEqual(TEXT("Scene name after the change"), Scene.Name, FString(TEXT("After")));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeJsonTapeBenchmarkTest, "glTFRuntime.JsonTape.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeJsonTapeBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const FString Document = glTFRuntimeJsonTapeTests::MakeTestDocument(50000);
+	const FTCHARToUTF8 UTF8Document(*Document, Document.Len());
+
+	double StartTime = FPlatformTime::Seconds();
+	TSharedPtr<FJsonObject> JsonObject = glTFRuntimeJsonTapeTests::Deserialize(Document);
+	const double SerializerTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	TSharedPtr<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromUTF8(reinterpret_cast<const uint8*>(UTF8Document.Get()), UTF8Document.Length());
+	const double TapeTime = FPlatformTime::Seconds() - StartTime;
+
+	if (!JsonObject || !JsonTape)
+	{
+		AddError(TEXT("Unable to parse the document"));
+		return false;
+	}
+
+	StartTime = FPlatformTime::Seconds();
+	TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromJsonTape(JsonTape.ToSharedRef(), FglTFRuntimeConfig());
+	TArray<FglTFRuntimeNode> Nodes;
+	const bool bNodesLoaded = Parser && Parser->GetAllNodes(Nodes);
+	const double NodesTime = FPlatformTime::Seconds() - StartTime;
+
+	TestTrue(TEXT("Nodes loaded"), bNodesLoaded);
+	TestEqual(TEXT("Number of nodes"), Nodes.Num(), 50000);
+
+	AddInfo(FString::Printf(TEXT("%.1f MB of JSON: FJsonSerializer %.2f ms, tape %.2f ms (%.1fx), 50000 nodes loaded from the tape in %.2f ms"), UTF8Document.Length() / (1024.0 * 1024.0), SerializerTime * 1000.0, TapeTime * 1000.0, TapeTime > 0 ? SerializerTime / TapeTime : 0.0, NodesTime * 1000.0));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,1003 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeParser.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/Base64.h"
+
+namespace glTFRuntimeMeshOptimizerTests
+{
+	// EXT_meshopt_compression index codec (version 1) encoder, following the reference implementation of meshoptimizer
+	class FIndexEncoder
+	{
+	public:
+		static TArray<uint8> Encode(const TArray<uint32>& Indices)
+		{
+			FIndexEncoder Encoder;
+			return Encoder.EncodeIndices(Indices);
+		}
+
+	private:
+		static constexpr uint8 CodeAuxTable[16] = { 0x00, 0x76, 0x87, 0x56, 0x67, 0x78, 0xa9, 0x86, 0x65, 0x89, 0x68, 0x98, 0x01, 0x69, 0x00, 0x00 };
+		static constexpr int32 TriangleIndexOrder[3][3] = { { 0, 1, 2 }, { 1, 2, 0 }, { 2, 0, 1 } };
+
+		uint32 EdgeFifo[16][2];
+		uint32 VertexFifo[16];
+		int32 EdgeFifoOffset = 0;
+		int32 VertexFifoOffset = 0;
+		TArray<uint8> Codes;
+		TArray<uint8> Data;
+
+		FIndexEncoder()
+		{
+			FMemory::Memset(EdgeFifo, 0xff, sizeof(EdgeFifo));
+			FMemory::Memset(VertexFifo, 0xff, sizeof(VertexFifo));
+		}
+
+		int32 GetEdgeFifo(const uint32 A, const uint32 B, const uint32 C) const
+		{
+			for (int32 Index = 0; Index < 16; Index++)
+			{
+				const uint32* Edge = EdgeFifo[(EdgeFifoOffset - 1 - Index) & 15];
+				if (Edge[0] == A && Edge[1] == B)
+				{
+					return (Index << 2) | 0;
+				}
+				if (Edge[0] == B && Edge[1] == C)
+				{
+					return (Index << 2) | 1;
+				}
+				if (Edge[0] == C && Edge[1] == A)
+				{
+					return (Index << 2) | 2;
+				}
+			}
+			return -1;
+		}
+
+		int32 GetVertexFifo(const uint32 Vertex) const
+		{
+			for (int32 Index = 0; Index < 16; Index++)
+			{
+				if (VertexFifo[(VertexFifoOffset - 1 - Index) & 15] == Vertex)
+				{
+					return Index;
+				}
+			}
+			return -1;
+		}
+
+		void PushEdge(const uint32 A, const uint32 B)
+		{
+			EdgeFifo[EdgeFifoOffset][0] = A;
+			EdgeFifo[EdgeFifoOffset][1] = B;
+			EdgeFifoOffset = (EdgeFifoOffset + 1) & 15;
+		}
+
+		void PushVertex(const uint32 Vertex)
+		{
+			VertexFifo[VertexFifoOffset] = Vertex;
+			VertexFifoOffset = (VertexFifoOffset + 1) & 15;
+		}
+
+		void EncodeIndex(const uint32 Index, const uint32 Last)
+		{
+			const uint32 Delta = Index - Last;
+			uint32 Value = (Delta << 1) ^ static_cast<uint32>(static_cast<int32>(Delta) >> 31);
+			while (Value >= 128)
+			{
+				Data.Add(static_cast<uint8>((Value & 127) | 128));
+				Value >>= 7;
+			}
+			Data.Add(static_cast<uint8>(Value));
+		}
+
+		static int32 GetCodeAuxIndex(const uint8 CodeAux)
+		{
+			for (int32 Index = 0; Index < 16; Index++)
+			{
+				if (CodeAuxTable[Index] == CodeAux)
+				{
+					return Index;
+				}
+			}
+			return -1;
+		}
+
+		TArray<uint8> EncodeIndices(const TArray<uint32>& Indices)
+		{
+			constexpr int32 FecMax = 13;
+			uint32 Next = 0;
+			uint32 Last = 0;
+
+			for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+			{
+				const int32 EdgeResult = GetEdgeFifo(Indices[Index], Indices[Index + 1], Indices[Index + 2]);
+				if (EdgeResult >= 0 && (EdgeResult >> 2) < 15)
+				{
+					const int32* Order = TriangleIndexOrder[EdgeResult & 3];
+					const uint32 A = Indices[Index + Order[0]];
+					const uint32 B = Indices[Index + Order[1]];
+					const uint32 C = Indices[Index + Order[2]];
+
+					const int32 Fe = EdgeResult >> 2;
+					const int32 Fc = GetVertexFifo(C);
+					int32 Fec = 15;
+					if (Fc >= 1 && Fc < FecMax)
+					{
+						Fec = Fc;
+					}
+					else if (C == Next)
+					{
+						Next++;
+						Fec = 0;
+					}
+
+					if (Fec == 15)
+					{
+						if (C + 1 == Last)
+						{
+							Fec = 13;
+							Last = C;
+						}
+						if (C == Last + 1)
+						{
+							Fec = 14;
+							Last = C;
+						}
+					}
+
+					Codes.Add(static_cast<uint8>((Fe << 4) | Fec));
+
+					if (Fec == 15)
+					{
+						EncodeIndex(C, Last);
+						Last = C;
+					}
+
+					if (Fec == 0 || Fec >= FecMax)
+					{
+						PushVertex(C);
+					}
+
+					PushEdge(C, B);
+					PushEdge(A, C);
+				}
+				else
+				{
+					const uint32 V0 = Indices[Index];
+					const uint32 V1 = Indices[Index + 1];
+					const uint32 V2 = Indices[Index + 2];
+					const int32 Rotation = (V1 == Next) ? 1 : (V2 == Next) ? 2 : 0;
+					const int32* Order = TriangleIndexOrder[Rotation];
+					const uint32 A = Indices[Index + Order[0]];
+					const uint32 B = Indices[Index + Order[1]];
+					const uint32 C = Indices[Index + Order[2]];
+
+					bool bReset = false;
+					if (A == 0 && B == 1 && C == 2 && Next > 0)
+					{
+						bReset = true;
+						Next = 0;
+						FMemory::Memset(VertexFifo, 0xff, sizeof(VertexFifo));
+					}
+
+					const int32 Fb = GetVertexFifo(B);
+					const int32 Fc = GetVertexFifo(C);
+
+					int32 Fea = 15;
+					if (A == Next)
+					{
+						Next++;
+						Fea = 0;
+					}
+
+					int32 Feb = 15;
+					if (Fb >= 0 && Fb < 14)
+					{
+						Feb = Fb + 1;
+					}
+					else if (B == Next)
+					{
+						Next++;
+						Feb = 0;
+					}
+
+					int32 Fec = 15;
+					if (Fc >= 0 && Fc < 14)
+					{
+						Fec = Fc + 1;
+					}
+					else if (C == Next)
+					{
+						Next++;
+						Fec = 0;
+					}
+
+					const uint8 CodeAux = static_cast<uint8>((Feb << 4) | Fec);
+					const int32 CodeAuxIndex = GetCodeAuxIndex(CodeAux);
+
+					if (Fea == 0 && CodeAuxIndex >= 0 && CodeAuxIndex < 14 && !bReset)
+					{
+						Codes.Add(static_cast<uint8>((15 << 4) | CodeAuxIndex));
+					}
+					else
+					{
+						Codes.Add(static_cast<uint8>((15 << 4) | 14 | (Fea != 0 ? 1 : 0)));
+						Data.Add(CodeAux);
+					}
+
+					if (Fea == 15)
+					{
+						EncodeIndex(A, Last);
+						Last = A;
+					}
+					if (Feb == 15)
+					{
+						EncodeIndex(B, Last);
+						Last = B;
+					}
+					if (Fec == 15)
+					{
+						EncodeIndex(C, Last);
+						Last = C;
+					}
+
+					if (Fea == 0 || Fea == 15)
+					{
+						PushVertex(A);
+					}
+					if (Feb == 0 || Feb == 15)
+					{
+						PushVertex(B);
+					}
+					if (Fec == 0 || Fec == 15)
+					{
+						PushVertex(C);
+					}
+
+					PushEdge(B, A);
+					PushEdge(C, B);
+					PushEdge(A, C);
+				}
+			}
+
+			TArray<uint8> Encoded;
+			Encoded.Add(0xe1);
+			Encoded.Append(Codes);
+			Encoded.Append(Data);
+			Encoded.Append(CodeAuxTable, 16);
+			return Encoded;
+		}
+	};
+
+	// decodes an EXT_meshopt_compression TRIANGLES buffer view through the parser
+	bool DecodeTriangles(const TArray<uint8>& Encoded, const int32 IndexCount, const int32 Stride, TArray<uint32>& Indices)
+	{
+		const FString Json = FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"extensionsUsed\":[\"EXT_meshopt_compression\"],")
+			TEXT("\"buffers\":[{\"byteLength\":%d,\"uri\":\"data:application/octet-stream;base64,%s\"}],")
+			TEXT("\"bufferViews\":[{\"buffer\":0,\"byteLength\":%d,\"extensions\":{\"EXT_meshopt_compression\":{\"buffer\":0,\"byteOffset\":0,\"byteLength\":%d,\"byteStride\":%d,\"count\":%d,\"mode\":\"TRIANGLES\"}}}]}"),
+			Encoded.Num(), *FBase64::Encode(Encoded), IndexCount * Stride, Encoded.Num(), Stride, IndexCount);
+
+		TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromString(Json, FglTFRuntimeConfig());
+		if (!Parser)
+		{
+			return false;
+		}
+
+		FglTFRuntimeBlob Blob;
+		int64 BlobStride = 0;
+		if (!Parser->GetBufferView(0, Blob, BlobStride) || Blob.Num != IndexCount * Stride)
+		{
+			return false;
+		}
+
+		Indices.SetNum(IndexCount);
+		for (int32 Index = 0; Index < IndexCount; Index++)
+		{
+			Indices[Index] = Stride == 2 ? reinterpret_cast<const uint16*>(Blob.Data)[Index] : reinterpret_cast<const uint32*>(Blob.Data)[Index];
+		}
+		return true;
+	}
+
+	// EXT_meshopt_compression attributes codec (version 0) encoder, every group uses its smallest encoding
+	TArray<uint8> EncodeVertices(const TArray<uint8>& Vertices, const int32 Stride)
+	{
+		const int32 NumVertices = Vertices.Num() / Stride;
+		const int32 MaxBlockVertices = FMath::Min((8192 / Stride) & ~15, 256);
+
+		TArray<uint8> Encoded;
+		Encoded.Add(0xa0);
+
+		// the first vertex is the baseline of the first block
+		uint8 Last[256];
+		FMemory::Memcpy(Last, Vertices.GetData(), Stride);
+
+		for (int32 FirstVertex = 0; FirstVertex < NumVertices; FirstVertex += MaxBlockVertices)
+		{
+			const int32 BlockVertices = FMath::Min(NumVertices - FirstVertex, MaxBlockVertices);
+			const int32 NumGroups = (BlockVertices + 15) / 16;
+			for (int32 ByteIndex = 0; ByteIndex < Stride; ByteIndex++)
+			{
+				uint8 Deltas[256] = {};
+				for (int32 VertexIndex = 0; VertexIndex < BlockVertices; VertexIndex++)
+				{
+					const uint8 Value = Vertices[(FirstVertex + VertexIndex) * Stride + ByteIndex];
+					const uint8 Delta = Value - Last[ByteIndex];
+					Deltas[VertexIndex] = static_cast<uint8>(Delta << 1) ^ static_cast<uint8>(static_cast<int8>(Delta) >> 7);
+					Last[ByteIndex] = Value;
+				}
+
+				const int32 HeaderOffset = Encoded.Num();
+				Encoded.AddZeroed((NumGroups + 3) / 4);
+				for (int32 GroupIndex = 0; GroupIndex < NumGroups; GroupIndex++)
+				{
+					const uint8* Group = Deltas + GroupIndex * 16;
+
+					// 0, 2, 4 bits selectors (the highest value escapes to a full byte) or 8 bits
+					int32 BestBitsLog2 = 3;
+					int32 BestSize = 16;
+					for (int32 BitsLog2 = 0; BitsLog2 < 3; BitsLog2++)
+					{
+						const int32 Escape = BitsLog2 > 0 ? (1 << (1 << BitsLog2)) - 1 : 0;
+						int32 Size = BitsLog2 > 0 ? 2 << BitsLog2 : 0;
+						bool bValid = true;
+						for (int32 Index = 0; Index < 16; Index++)
+						{
+							if (BitsLog2 == 0)
+							{
+								bValid &= Group[Index] == 0;
+							}
+							else if (Group[Index] >= Escape)
+							{
+								Size++;
+							}
+						}
+						if (bValid && Size < BestSize)
+						{
+							BestSize = Size;
+							BestBitsLog2 = BitsLog2;
+						}
+					}
+
+					Encoded[HeaderOffset + GroupIndex / 4] |= BestBitsLog2 << ((GroupIndex % 4) * 2);
+					if (BestBitsLog2 == 3)
+					{
+						Encoded.Append(Group, 16);
+					}
+					else if (BestBitsLog2 > 0)
+					{
+						const int32 Bits = 1 << BestBitsLog2;
+						const int32 Escape = (1 << Bits) - 1;
+						const int32 ValuesPerByte = 8 / Bits;
+						for (int32 SelectorsIndex = 0; SelectorsIndex < 16 / ValuesPerByte; SelectorsIndex++)
+						{
+							uint8 Selectors = 0;
+							for (int32 Index = 0; Index < ValuesPerByte; Index++)
+							{
+								Selectors |= FMath::Min<int32>(Group[SelectorsIndex * ValuesPerByte + Index], Escape) << (8 - Bits * (Index + 1));
+							}
+							Encoded.Add(Selectors);
+						}
+						for (int32 Index = 0; Index < 16; Index++)
+						{
+							if (Group[Index] >= Escape)
+							{
+								Encoded.Add(Group[Index]);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		// the tail is padded to 32 bytes and ends with the first vertex
+		Encoded.AddZeroed(FMath::Max(Stride, 32) - Stride);
+		Encoded.Append(Vertices.GetData(), Stride);
+		return Encoded;
+	}
+
+	bool DecodeVertices(FglTFRuntimeParser& Parser, TArray<uint8>& Encoded, const int32 Stride, const int32 NumVertices, const FString& Filter, const bool bForceScalar, TArray64<uint8>& Vertices)
+	{
+		FglTFRuntimeBlob Blob;
+		Blob.Data = Encoded.GetData();
+		Blob.Num = Encoded.Num();
+		Vertices.Reset();
+		return Parser.DecompressMeshOptimizer(Blob, Stride, NumVertices, TEXT("ATTRIBUTES"), Filter, Vertices, bForceScalar);
+	}
+
+	// quantized position, octahedral normal and uv of a smooth surface, as exported by gltfpack
+	TArray<uint8> MakeVertices(const int32 NumVertices, const int32 Stride, const int32 Seed)
+	{
+		FRandomStream RandomStream(Seed);
+		TArray<uint8> Vertices;
+		Vertices.SetNumUninitialized(NumVertices * Stride);
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			uint8* Vertex = Vertices.GetData() + VertexIndex * Stride;
+			const int16 Position[4] = { static_cast<int16>((VertexIndex % 1000) * 30 + RandomStream.RandRange(0, 7)), static_cast<int16>((VertexIndex / 1000) * 30), static_cast<int16>(FMath::Sin(VertexIndex * 0.001f) * 1000), 0 };
+			const int8 Normal[4] = { static_cast<int8>(RandomStream.RandRange(-4, 4)), static_cast<int8>(RandomStream.RandRange(-4, 4)), 127, 0 };
+			const uint16 UV[2] = { static_cast<uint16>(VertexIndex * 7), static_cast<uint16>((VertexIndex / 1000) * 64) };
+
+			uint8 Full[16];
+			FMemory::Memcpy(Full, Position, 8);
+			FMemory::Memcpy(Full + 8, Normal, 4);
+			FMemory::Memcpy(Full + 12, UV, 4);
+			FMemory::Memcpy(Vertex, Full, FMath::Min(Stride, 16));
+			for (int32 ByteIndex = 16; ByteIndex < Stride; ByteIndex++)
+			{
+				Vertex[ByteIndex] = static_cast<uint8>(RandomStream.RandRange(0, 3));
+			}
+		}
+		return Vertices;
+	}
+
+	struct FFilteredStream
+	{
+		FString Filter;
+		int32 Stride;
+		TArray<uint8> Vertices;
+	};
+
+	// random inputs of each filter, with the components laid out as the encoders of meshoptimizer produce them
+	TArray<FFilteredStream> MakeFilteredStreams(const int32 NumVertices, const int32 Seed)
+	{
+		FRandomStream RandomStream(Seed);
+
+		FFilteredStream Octahedral8 = { TEXT("OCTAHEDRAL"), 4, TArray<uint8>() };
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			Octahedral8.Vertices.Append({ static_cast<uint8>(RandomStream.RandRange(-127, 127)), static_cast<uint8>(RandomStream.RandRange(-127, 127)), 127, static_cast<uint8>(RandomStream.RandRange(0, 255)) });
+		}
+
+		FFilteredStream Octahedral16 = { TEXT("OCTAHEDRAL"), 8, TArray<uint8>() };
+		FFilteredStream Quaternion = { TEXT("QUATERNION"), 8, TArray<uint8>() };
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			const int16 Normal[4] = { static_cast<int16>(RandomStream.RandRange(-32767, 32767)), static_cast<int16>(RandomStream.RandRange(-32767, 32767)), 32767, static_cast<int16>(RandomStream.RandRange(-32767, 32767)) };
+			Octahedral16.Vertices.Append(reinterpret_cast<const uint8*>(Normal), 8);
+
+			// 12 bits components, the scale in the high bits and the index of the dropped component in the low bits of the last one
+			const int16 Rotation[4] = { static_cast<int16>(RandomStream.RandRange(-2047, 2047)), static_cast<int16>(RandomStream.RandRange(-2047, 2047)), static_cast<int16>(RandomStream.RandRange(-2047, 2047)), static_cast<int16>((2047 << 2) | RandomStream.RandRange(0, 3)) };
+			Quaternion.Vertices.Append(reinterpret_cast<const uint8*>(Rotation), 8);
+		}
+
+		FFilteredStream Exponential = { TEXT("EXPONENTIAL"), 12, TArray<uint8>() };
+		for (int32 ComponentIndex = 0; ComponentIndex < NumVertices * 3; ComponentIndex++)
+		{
+			const uint32 Component = (static_cast<uint32>(RandomStream.RandRange(-20, 20)) << 24) | (RandomStream.GetUnsignedInt() & 0xFFFFFF);
+			Exponential.Vertices.Append(reinterpret_cast<const uint8*>(&Component), 4);
+		}
+
+		TArray<FFilteredStream> Streams;
+		Streams.Add(MoveTemp(Octahedral8));
+		Streams.Add(MoveTemp(Octahedral16));
+		Streams.Add(MoveTemp(Quaternion));
+		Streams.Add(MoveTemp(Exponential));
+		return Streams;
+	}
+
+	// vectorized filters may round one unit differently when the compiler fuses the multiply-adds of the scalar ones
+	bool AreFilteredStreamsEqual(const FFilteredStream& Stream, const TArray64<uint8>& A, const TArray64<uint8>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+		if (Stream.Filter == TEXT("EXPONENTIAL"))
+		{
+			return FMemory::Memcmp(A.GetData(), B.GetData(), A.Num()) == 0;
+		}
+		for (int64 Index = 0; Index < A.Num(); Index += Stream.Stride / 4)
+		{
+			const int32 ComponentA = Stream.Stride == 4 ? static_cast<int8>(A[Index]) : *reinterpret_cast<const int16*>(A.GetData() + Index);
+			const int32 ComponentB = Stream.Stride == 4 ? static_cast<int8>(B[Index]) : *reinterpret_cast<const int16*>(B.GetData() + Index);
+			if (FMath::Abs(ComponentA - ComponentB) > 1)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// the codec can rotate the vertices of each triangle
+	bool IsSameTriangle(const uint32* A, const uint32* B)
+	{
+		for (int32 Rotation = 0; Rotation < 3; Rotation++)
+		{
+			if (A[0] == B[Rotation] && A[1] == B[(Rotation + 1) % 3] && A[2] == B[(Rotation + 2) % 3])
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void AddGrid(TArray<uint32>& Indices, const int32 Width, const int32 Height, const uint32 FirstVertex)
+	{
+		for (int32 Y = 0; Y < Height; Y++)
+		{
+			for (int32 X = 0; X < Width; X++)
+			{
+				const uint32 V0 = FirstVertex + Y * (Width + 1) + X;
+				const uint32 V1 = V0 + 1;
+				const uint32 V2 = V0 + Width + 1;
+				const uint32 V3 = V2 + 1;
+				Indices.Append({ V0, V2, V1, V1, V2, V3 });
+			}
+		}
+	}
+
+	TArray<TArray<uint32>> MakeTestMeshes()
+	{
+		TArray<TArray<uint32>> Meshes;
+
+		// strip-like locality
+		AddGrid(Meshes.AddDefaulted_GetRef(), 64, 48, 0);
+
+		// a 0 1 2 triangle after the first mesh restarts the numbering (reset code)
+		TArray<uint32>& Reset = Meshes.AddDefaulted_GetRef();
+		AddGrid(Reset, 8, 8, 0);
+		Reset.Append({ 0, 1, 2, 2, 1, 3 });
+		AddGrid(Reset, 8, 8, 4);
+
+		// poor locality: shuffled triangles of a grid
+		TArray<uint32>& Shuffled = Meshes.AddDefaulted_GetRef();
+		AddGrid(Shuffled, 32, 32, 0);
+		FRandomStream RandomStream(3);
+		for (int32 Triangle = Shuffled.Num() / 3 - 1; Triangle > 0; Triangle--)
+		{
+			const int32 Other = RandomStream.RandRange(0, Triangle);
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				Shuffled.Swap(Triangle * 3 + Corner, Other * 3 + Corner);
+			}
+		}
+
+		// random soup with large and repeated indices (explicit varint indices, deltas in both directions)
+		TArray<uint32>& Soup = Meshes.AddDefaulted_GetRef();
+		for (int32 Triangle = 0; Triangle < 2000; Triangle++)
+		{
+			Soup.Add(RandomStream.RandRange(0, 60000));
+			Soup.Add(RandomStream.RandRange(0, 60000));
+			Soup.Add(RandomStream.RandRange(0, 3));
+		}
+
+		// a single triangle
+		Meshes.Add({ 0, 1, 2 });
+
+		return Meshes;
+	}
+
+	// average cache miss ratio (misses per triangle) of a FIFO post-transform cache
+	float ComputeACMR(const TArray<uint32>& Indices, const int32 NumVertices, const int32 CacheSize)
+	{
+		TArray<int32> CacheTimeStamps;
+		CacheTimeStamps.Init(-CacheSize, NumVertices);
+		int32 Time = 0;
+		int32 CacheMisses = 0;
+		for (const uint32 Index : Indices)
+		{
+			if (Time - CacheTimeStamps[Index] >= CacheSize)
+			{
+				CacheTimeStamps[Index] = Time++;
+				CacheMisses++;
+			}
+		}
+		return static_cast<float>(CacheMisses) / (Indices.Num() / 3);
+	}
+
+	void ShuffleTriangles(TArray<uint32>& Indices, const int32 Seed)
+	{
+		FRandomStream RandomStream(Seed);
+		for (int32 Triangle = Indices.Num() / 3 - 1; Triangle > 0; Triangle--)
+		{
+			const int32 Other = RandomStream.RandRange(0, Triangle);
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				Indices.Swap(Triangle * 3 + Corner, Other * 3 + Corner);
+			}
+		}
+	}
+
+	// each triangle rotated to start from its lowest index (winding is preserved), then sorted
+	TArray<FIntVector> GetSortedTriangles(const TArray<uint32>& Indices)
+	{
+		TArray<FIntVector> Triangles;
+		for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+		{
+			const int32 A = Indices[Index];
+			const int32 B = Indices[Index + 1];
+			const int32 C = Indices[Index + 2];
+			if (A <= B && A <= C)
+			{
+				Triangles.Add(FIntVector(A, B, C));
+			}
+			else if (B <= A && B <= C)
+			{
+				Triangles.Add(FIntVector(B, C, A));
+			}
+			else
+			{
+				Triangles.Add(FIntVector(C, A, B));
+			}
+		}
+		Triangles.Sort([](const FIntVector& A, const FIntVector& B)
+			{
+				return A.X != B.X ? A.X < B.X : (A.Y != B.Y ? A.Y < B.Y : A.Z < B.Z);
+			});
+		return Triangles;
+	}
+
+	struct FTestCacheMesh
+	{
+		FString Name;
+		TArray<uint32> Indices;
+		TArray<FVector> Positions;
+	};
+
+	TArray<FTestCacheMesh> MakeCacheMeshes()
+	{
+		TArray<FTestCacheMesh> Meshes;
+
+		FTestCacheMesh& Grid = Meshes.AddDefaulted_GetRef();
+		Grid.Name = TEXT("Grid");
+		AddGrid(Grid.Indices, 64, 64, 0);
+		for (int32 Y = 0; Y <= 64; Y++)
+		{
+			for (int32 X = 0; X <= 64; X++)
+			{
+				Grid.Positions.Add(FVector(X, Y, 0));
+			}
+		}
+
+		// closed, with degenerate triangles on the poles and a few unused vertices
+		FTestCacheMesh& Sphere = Meshes.AddDefaulted_GetRef();
+		Sphere.Name = TEXT("Sphere");
+		constexpr int32 Rings = 48;
+		constexpr int32 Segments = 96;
+		AddGrid(Sphere.Indices, Segments, Rings, 0);
+		for (int32 Ring = 0; Ring <= Rings; Ring++)
+		{
+			for (int32 Segment = 0; Segment <= Segments; Segment++)
+			{
+				const float Theta = PI * Ring / Rings;
+				const float Phi = 2 * PI * Segment / Segments;
+				Sphere.Positions.Add(FVector(FMath::Sin(Theta) * FMath::Cos(Phi), FMath::Sin(Theta) * FMath::Sin(Phi), FMath::Cos(Theta)) * 100);
+			}
+		}
+		Sphere.Positions.AddZeroed(5);
+
+		for (int32 MeshIndex = 0, NumMeshes = Meshes.Num(); MeshIndex < NumMeshes; MeshIndex++)
+		{
+			FTestCacheMesh Shuffled = Meshes[MeshIndex];
+			Shuffled.Name += TEXT(" (shuffled)");
+			ShuffleTriangles(Shuffled.Indices, MeshIndex + 1);
+			Meshes.Add(MoveTemp(Shuffled));
+		}
+
+		return Meshes;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeMeshOptimizerIndicesTest, "glTFRuntime.MeshOptimizer.Indices", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeMeshOptimizerIndicesTest::RunTest(const FString& Parameters)
+{
+	const TArray<TArray<uint32>> Meshes = glTFRuntimeMeshOptimizerTests::MakeTestMeshes();
+
+	for (int32 MeshIndex = 0; MeshIndex < Meshes.Num(); MeshIndex++)
+	{
+		const TArray<uint32>& Indices = Meshes[MeshIndex];
+		const TArray<uint8> Encoded = glTFRuntimeMeshOptimizerTests::FIndexEncoder::Encode(Indices);
+
+		for (const int32 Stride : { 2, 4 })
+		{
+			TArray<uint32> Decoded;
+			if (!glTFRuntimeMeshOptimizerTests::DecodeTriangles(Encoded, Indices.Num(), Stride, Decoded))
+			{
+				AddError(FString::Printf(TEXT("Unable to decode mesh %d with stride %d"), MeshIndex, Stride));
+				return false;
+			}
+
+			for (int32 Triangle = 0; Triangle < Indices.Num() / 3; Triangle++)
+			{
+				if (!glTFRuntimeMeshOptimizerTests::IsSameTriangle(Indices.GetData() + Triangle * 3, Decoded.GetData() + Triangle * 3))
+				{
+					AddError(FString::Printf(TEXT("Triangle %d of mesh %d (stride %d) is %u %u %u, expected %u %u %u"), Triangle, MeshIndex, Stride,
+						Decoded[Triangle * 3], Decoded[Triangle * 3 + 1], Decoded[Triangle * 3 + 2], Indices[Triangle * 3], Indices[Triangle * 3 + 1], Indices[Triangle * 3 + 2]));
+					return false;
+				}
+			}
+		}
+
+		// the whole stream up to the codeaux table must be consumed: extra or missing bytes are rejected
+		TArray<uint32> Decoded;
+		TArray<uint8> Longer = Encoded;
+		Longer.Insert(0, Longer.Num() - 16);
+		TestFalse(FString::Printf(TEXT("Mesh %d with an extra byte"), MeshIndex), glTFRuntimeMeshOptimizerTests::DecodeTriangles(Longer, Indices.Num(), 4, Decoded));
+
+		TArray<uint8> Shorter = Encoded;
+		Shorter.Pop();
+		TestFalse(FString::Printf(TEXT("Mesh %d without the last byte"), MeshIndex), glTFRuntimeMeshOptimizerTests::DecodeTriangles(Shorter, Indices.Num(), 4, Decoded));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeMeshOptimizerFuzzTest, "glTFRuntime.MeshOptimizer.Fuzz", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeMeshOptimizerFuzzTest::RunTest(const FString& Parameters)
+{
+	const TArray<TArray<uint32>> Meshes = glTFRuntimeMeshOptimizerTests::MakeTestMeshes();
+	FRandomStream RandomStream(1234);
+
+	// corrupted streams must be decoded or rejected without reading past the buffer (run with a memory checker for full coverage)
+	int32 NumOfRejected = 0;
+	for (int32 Iteration = 0; Iteration < 2000; Iteration++)
+	{
+		const TArray<uint32>& Indices = Meshes[Iteration % Meshes.Num()];
+		TArray<uint8> Encoded = glTFRuntimeMeshOptimizerTests::FIndexEncoder::Encode(Indices);
+
+		switch (Iteration % 4)
+		{
+		case 0: // flipped bits
+			for (int32 Flip = 0; Flip < 4; Flip++)
+			{
+				Encoded[RandomStream.RandRange(1, Encoded.Num() - 1)] ^= static_cast<uint8>(1 << RandomStream.RandRange(0, 7));
+			}
+			break;
+		case 1: // truncated
+			Encoded.SetNum(RandomStream.RandRange(1, Encoded.Num() - 1));
+			break;
+		case 2: // random bytes after the header, all codes with explicit indices are likely
+			for (int32 Index = 1; Index < Encoded.Num(); Index++)
+			{
+				Encoded[Index] = static_cast<uint8>(RandomStream.GetUnsignedInt());
+			}
+			break;
+		default: // varint continuation bytes everywhere in the data
+			for (int32 Index = 1 + Indices.Num() / 3; Index < Encoded.Num() - 16; Index++)
+			{
+				Encoded[Index] |= 0x80;
+			}
+			break;
+		}
+
+		TArray<uint32> Decoded;
+		if (!glTFRuntimeMeshOptimizerTests::DecodeTriangles(Encoded, Indices.Num(), (Iteration & 1) ? 2 : 4, Decoded))
+		{
+			NumOfRejected++;
+		}
+		else if (Decoded.Num() != Indices.Num())
+		{
+			AddError(FString::Printf(TEXT("Iteration %d decoded %d indices, expected %d"), Iteration, Decoded.Num(), Indices.Num()));
+			return false;
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("%d of 2000 corrupted streams rejected"), NumOfRejected));
+	TestTrue(TEXT("Corrupted streams are rejected"), NumOfRejected > 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeMeshOptimizerTrianglesOrderTest, "glTFRuntime.MeshOptimizer.TrianglesOrder", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeMeshOptimizerTrianglesOrderTest::RunTest(const FString& Parameters)
+{
+	for (const glTFRuntimeMeshOptimizerTests::FTestCacheMesh& Mesh : glTFRuntimeMeshOptimizerTests::MakeCacheMeshes())
+	{
+		TArray<uint32> Indices = Mesh.Indices;
+		FglTFRuntimeParser::OptimizeTrianglesOrder(Indices, Mesh.Positions);
+
+		// same triangles with the same winding, just in a different order
+		if (glTFRuntimeMeshOptimizerTests::GetSortedTriangles(Indices) != glTFRuntimeMeshOptimizerTests::GetSortedTriangles(Mesh.Indices))
+		{
+			AddError(FString::Printf(TEXT("%s: the optimized triangles do not match the original ones"), *Mesh.Name));
+			return false;
+		}
+
+		// Tipsify gets close to 0.6 on regular meshes, both for the already strip-like and for the shuffled order
+		const float SourceACMR = glTFRuntimeMeshOptimizerTests::ComputeACMR(Mesh.Indices, Mesh.Positions.Num(), 16);
+		const float OptimizedACMR = glTFRuntimeMeshOptimizerTests::ComputeACMR(Indices, Mesh.Positions.Num(), 16);
+		TestTrue(FString::Printf(TEXT("%s ACMR %f not worse than %f"), *Mesh.Name, OptimizedACMR, SourceACMR), OptimizedACMR <= SourceACMR);
+		TestTrue(FString::Printf(TEXT("%s ACMR %f"), *Mesh.Name, OptimizedACMR), OptimizedACMR < 0.7f);
+
+		AddInfo(FString::Printf(TEXT("%s: %d triangles, ACMR %.3f -> %.3f"), *Mesh.Name, Indices.Num() / 3, SourceACMR, OptimizedACMR));
+	}
+
+	// invalid and trivial lists are left untouched
+	const TArray<FVector> Positions = { FVector(0, 0, 0), FVector(1, 0, 0), FVector(0, 1, 0), FVector(1, 1, 0) };
+	for (const TArray<uint32>& Source : { TArray<uint32>({ 0, 1, 2 }), TArray<uint32>({ 0, 1, 2, 1, 3, 4 }), TArray<uint32>({ 0, 1, 2, 1, 3 }) })
+	{
+		TArray<uint32> Indices = Source;
+		FglTFRuntimeParser::OptimizeTrianglesOrder(Indices, Positions);
+		TestTrue(TEXT("Untouched indices"), Indices == Source);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeMeshOptimizerVertexFetchTest, "glTFRuntime.MeshOptimizer.VertexFetch", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeMeshOptimizerVertexFetchTest::RunTest(const FString& Parameters)
+{
+	for (const glTFRuntimeMeshOptimizerTests::FTestCacheMesh& Mesh : glTFRuntimeMeshOptimizerTests::MakeCacheMeshes())
+	{
+		TArray<uint32> SourceIndices = Mesh.Indices;
+		FglTFRuntimeParser::OptimizeTrianglesOrder(SourceIndices, Mesh.Positions);
+
+		TArray<uint32> Indices = SourceIndices;
+		TArray<uint32> VerticesOrder;
+		FglTFRuntimeParser::OptimizeVertexFetch(Indices, Mesh.Positions.Num(), VerticesOrder);
+
+		// only the referenced vertices are kept, each one once
+		TSet<uint32> UsedVertices(SourceIndices);
+		TSet<uint32> OrderedVertices(VerticesOrder);
+		TestEqual(FString::Printf(TEXT("%s number of vertices"), *Mesh.Name), VerticesOrder.Num(), UsedVertices.Num());
+		TestEqual(FString::Printf(TEXT("%s unique vertices"), *Mesh.Name), OrderedVertices.Num(), VerticesOrder.Num());
+		TestTrue(FString::Printf(TEXT("%s referenced vertices"), *Mesh.Name), OrderedVertices.Difference(UsedVertices).Num() == 0);
+
+		// the triangles order is not changed and the vertices are numbered by first use
+		uint32 NextVertex = 0;
+		for (int32 Index = 0; Index < Indices.Num(); Index++)
+		{
+			if (Indices[Index] > NextVertex || VerticesOrder[Indices[Index]] != SourceIndices[Index])
+			{
+				AddError(FString::Printf(TEXT("%s: index %d is %u, mapped to %u instead of %u"), *Mesh.Name, Index, Indices[Index], Indices[Index] < static_cast<uint32>(VerticesOrder.Num()) ? VerticesOrder[Indices[Index]] : MAX_uint32, SourceIndices[Index]));
+				return false;
+			}
+			if (Indices[Index] == NextVertex)
+			{
+				NextVertex++;
+			}
+		}
+
+		// renumbering cannot change the cache behaviour
+		TestEqual(FString::Printf(TEXT("%s ACMR"), *Mesh.Name), glTFRuntimeMeshOptimizerTests::ComputeACMR(Indices, VerticesOrder.Num(), 16), glTFRuntimeMeshOptimizerTests::ComputeACMR(SourceIndices, Mesh.Positions.Num(), 16));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeMeshOptimizerVerticesTest, "glTFRuntime.MeshOptimizer.Vertices", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeMeshOptimizerVerticesTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromString(TEXT("{\"asset\":{\"version\":\"2.0\"}}"), FglTFRuntimeConfig());
+	if (!Parser)
+	{
+		AddError(TEXT("Unable to create the parser"));
+		return false;
+	}
+
+	// strides not multiple of 4 always take the scalar path, partial blocks and groups exercise the padding
+	for (const int32 Stride : { 3, 4, 6, 8, 12, 16, 20 })
+	{
+		for (const int32 NumVertices : { 1, 15, 17, 255, 1000, 4099 })
+		{
+			const TArray<uint8> Vertices = glTFRuntimeMeshOptimizerTests::MakeVertices(NumVertices, Stride, Stride * NumVertices);
+			TArray<uint8> Encoded = glTFRuntimeMeshOptimizerTests::EncodeVertices(Vertices, Stride);
+
+			for (const bool bForceScalar : { false, true })
+			{
+				TArray64<uint8> Decoded;
+				const bool bDecoded = glTFRuntimeMeshOptimizerTests::DecodeVertices(*Parser, Encoded, Stride, NumVertices, TEXT("NONE"), bForceScalar, Decoded);
+				if (!bDecoded || Decoded.Num() != Vertices.Num() || FMemory::Memcmp(Decoded.GetData(), Vertices.GetData(), Vertices.Num()) != 0)
+				{
+					AddError(FString::Printf(TEXT("%d vertices of stride %d (%s) do not match the source"), NumVertices, Stride, bForceScalar ? TEXT("scalar") : TEXT("SIMD")));
+					return false;
+				}
+			}
+
+			Encoded.Pop();
+			TArray64<uint8> Decoded;
+			TestFalse(FString::Printf(TEXT("%d vertices of stride %d without the last byte"), NumVertices, Stride), glTFRuntimeMeshOptimizerTests::DecodeVertices(*Parser, Encoded, Stride, NumVertices, TEXT("NONE"), false, Decoded));
+		}
+	}
+
+	// 1003 elements: the vectorized filters leave the last 3 to the scalar ones
+	for (const glTFRuntimeMeshOptimizerTests::FFilteredStream& Stream : glTFRuntimeMeshOptimizerTests::MakeFilteredStreams(1003, 17))
+	{
+		TArray<uint8> Encoded = glTFRuntimeMeshOptimizerTests::EncodeVertices(Stream.Vertices, Stream.Stride);
+		TArray64<uint8> Decoded;
+		TArray64<uint8> ScalarDecoded;
+		if (!glTFRuntimeMeshOptimizerTests::DecodeVertices(*Parser, Encoded, Stream.Stride, 1003, Stream.Filter, false, Decoded) || !glTFRuntimeMeshOptimizerTests::DecodeVertices(*Parser, Encoded, Stream.Stride, 1003, Stream.Filter, true, ScalarDecoded))
+		{
+			AddError(FString::Printf(TEXT("Unable to decode the %s stream of stride %d"), *Stream.Filter, Stream.Stride));
+			return false;
+		}
+		TestTrue(FString::Printf(TEXT("%s filter of stride %d"), *Stream.Filter, Stream.Stride), glTFRuntimeMeshOptimizerTests::AreFilteredStreamsEqual(Stream, Decoded, ScalarDecoded));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeMeshOptimizerDecodeBenchmarkTest, "glTFRuntime.MeshOptimizer.DecodeBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeMeshOptimizerDecodeBenchmarkTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromString(TEXT("{\"asset\":{\"version\":\"2.0\"}}"), FglTFRuntimeConfig());
+	if (!Parser)
+	{
+		AddError(TEXT("Unable to create the parser"));
+		return false;
+	}
+
+	// best of 3 runs, in MB/s of decoded data
+	auto MeasureThroughput = [](TFunctionRef<bool(TArray64<uint8>&)> Decode, TArray64<uint8>& Decoded, bool& bDecoded)
+		{
+			double BestTime = MAX_dbl;
+			bDecoded = true;
+			for (int32 Run = 0; Run < 3; Run++)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				bDecoded &= Decode(Decoded);
+				BestTime = FMath::Min(BestTime, FPlatformTime::Seconds() - StartTime);
+			}
+			return Decoded.Num() / (1024.0 * 1024.0) / BestTime;
+		};
+
+	// 4M vertices of 16 bytes (64 MB)
+	constexpr int32 NumVertices = 4 * 1024 * 1024;
+	{
+		const TArray<uint8> Vertices = glTFRuntimeMeshOptimizerTests::MakeVertices(NumVertices, 16, 7);
+		TArray<uint8> Encoded = glTFRuntimeMeshOptimizerTests::EncodeVertices(Vertices, 16);
+
+		TArray64<uint8> Decoded[2];
+		bool bDecoded[2];
+		double Throughput[2];
+		for (int32 Path = 0; Path < 2; Path++)
+		{
+			Throughput[Path] = MeasureThroughput([&](TArray64<uint8>& Output) { return glTFRuntimeMeshOptimizerTests::DecodeVertices(*Parser, Encoded, 16, NumVertices, TEXT("NONE"), Path == 1, Output); }, Decoded[Path], bDecoded[Path]);
+		}
+		TestTrue(TEXT("Attributes decoded"), bDecoded[0] && bDecoded[1] && Decoded[0].Num() == Vertices.Num() && FMemory::Memcmp(Decoded[0].GetData(), Vertices.GetData(), Vertices.Num()) == 0 && Decoded[0] == Decoded[1]);
+		AddInfo(FString::Printf(TEXT("Attributes (%.2f%% of the decoded size): SIMD %.0f MB/s, scalar %.0f MB/s (%.2fx)"), Encoded.Num() * 100.0 / Vertices.Num(), Throughput[0], Throughput[1], Throughput[0] / Throughput[1]));
+	}
+
+	// 1M elements for each filter, decoding included
+	for (const glTFRuntimeMeshOptimizerTests::FFilteredStream& Stream : glTFRuntimeMeshOptimizerTests::MakeFilteredStreams(1024 * 1024, 11))
+	{
+		TArray<uint8> Encoded = glTFRuntimeMeshOptimizerTests::EncodeVertices(Stream.Vertices, Stream.Stride);
+		const int32 NumElements = Stream.Vertices.Num() / Stream.Stride;
+
+		TArray64<uint8> Decoded[2];
+		bool bDecoded[2];
+		double Throughput[2];
+		for (int32 Path = 0; Path < 2; Path++)
+		{
+			Throughput[Path] = MeasureThroughput([&](TArray64<uint8>& Output) { return glTFRuntimeMeshOptimizerTests::DecodeVertices(*Parser, Encoded, Stream.Stride, NumElements, Stream.Filter, Path == 1, Output); }, Decoded[Path], bDecoded[Path]);
+		}
+		TestTrue(FString::Printf(TEXT("%s stream of stride %d decoded"), *Stream.Filter, Stream.Stride), bDecoded[0] && bDecoded[1] && glTFRuntimeMeshOptimizerTests::AreFilteredStreamsEqual(Stream, Decoded[0], Decoded[1]));
+		AddInfo(FString::Printf(TEXT("%s filter, stride %d: SIMD %.0f MB/s, scalar %.0f MB/s (%.2fx)"), *Stream.Filter, Stream.Stride, Throughput[0], Throughput[1], Throughput[0] / Throughput[1]));
+	}
+
+	// 2M triangles of a grid, the index codec has a single path
+	{
+		TArray<uint32> Indices;
+		glTFRuntimeMeshOptimizerTests::AddGrid(Indices, 1024, 1024, 0);
+		TArray<uint8> Encoded = glTFRuntimeMeshOptimizerTests::FIndexEncoder::Encode(Indices);
+
+		TArray64<uint8> Decoded;
+		bool bDecoded;
+		const double Throughput = MeasureThroughput([&](TArray64<uint8>& Output)
+			{
+				FglTFRuntimeBlob Blob;
+				Blob.Data = Encoded.GetData();
+				Blob.Num = Encoded.Num();
+				Output.Reset();
+				return Parser->DecompressMeshOptimizer(Blob, 4, Indices.Num(), TEXT("TRIANGLES"), TEXT("NONE"), Output);
+			}, Decoded, bDecoded);
+		TestTrue(TEXT("Indices decoded"), bDecoded && Decoded.Num() == Indices.Num() * 4);
+		AddInfo(FString::Printf(TEXT("Indices (%.2f bytes per triangle): %.0f MB/s"), Encoded.Num() * 3.0 / Indices.Num(), Throughput));
+	}
+
+	return true;
+}
+
+#endif
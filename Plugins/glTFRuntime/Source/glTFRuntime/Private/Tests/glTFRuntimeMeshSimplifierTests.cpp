@@ -0,0 +1,277 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeParser.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+
+namespace glTFRuntimeMeshSimplifierTests
+{
+	struct FTestMesh
+	{
+		FString Name;
+		TArray<uint32> Indices;
+		TArray<FVector> Positions;
+	};
+
+	// closed sphere with shared poles, with bSeam the first column of vertices is duplicated like an UV seam
+	FTestMesh MakeSphere(const int32 Rings, const int32 Segments, const bool bSeam)
+	{
+		FTestMesh Mesh;
+		Mesh.Name = bSeam ? TEXT("Seam Sphere") : TEXT("Sphere");
+		const int32 Columns = bSeam ? Segments + 1 : Segments;
+
+		Mesh.Positions.Add(FVector(0, 0, 100));
+		for (int32 Ring = 1; Ring < Rings; Ring++)
+		{
+			for (int32 Column = 0; Column < Columns; Column++)
+			{
+				const double Theta = PI * Ring / Rings;
+				const double Phi = 2 * PI * (Column % Segments) / Segments;
+				Mesh.Positions.Add(FVector(FMath::Sin(Theta) * FMath::Cos(Phi), FMath::Sin(Theta) * FMath::Sin(Phi), FMath::Cos(Theta)) * 100);
+			}
+		}
+		Mesh.Positions.Add(FVector(0, 0, -100));
+
+		auto GetVertex = [&](const int32 Ring, const int32 Segment) -> uint32
+			{
+				if (Ring == 0)
+				{
+					return 0;
+				}
+				if (Ring == Rings)
+				{
+					return Mesh.Positions.Num() - 1;
+				}
+				return 1 + (Ring - 1) * Columns + (bSeam ? Segment : Segment % Segments);
+			};
+
+		for (int32 Ring = 0; Ring < Rings; Ring++)
+		{
+			for (int32 Segment = 0; Segment < Segments; Segment++)
+			{
+				const uint32 V0 = GetVertex(Ring, Segment);
+				const uint32 V1 = GetVertex(Ring, Segment + 1);
+				const uint32 V2 = GetVertex(Ring + 1, Segment);
+				const uint32 V3 = GetVertex(Ring + 1, Segment + 1);
+				if (Ring > 0)
+				{
+					Mesh.Indices.Append({ V0, V2, V1 });
+				}
+				if (Ring < Rings - 1)
+				{
+					Mesh.Indices.Append({ V1, V2, V3 });
+				}
+			}
+		}
+
+		return Mesh;
+	}
+
+	// open and wavy, so that the borders have to be preserved
+	FTestMesh MakeGrid(const int32 Width)
+	{
+		FTestMesh Mesh;
+		Mesh.Name = TEXT("Grid");
+		for (int32 Y = 0; Y <= Width; Y++)
+		{
+			for (int32 X = 0; X <= Width; X++)
+			{
+				Mesh.Positions.Add(FVector(X * 10, Y * 10, 30 * FMath::Sin(X * 0.2) * FMath::Cos(Y * 0.2)));
+			}
+		}
+		for (int32 Y = 0; Y < Width; Y++)
+		{
+			for (int32 X = 0; X < Width; X++)
+			{
+				const uint32 V0 = Y * (Width + 1) + X;
+				const uint32 V1 = V0 + 1;
+				const uint32 V2 = V0 + Width + 1;
+				const uint32 V3 = V2 + 1;
+				Mesh.Indices.Append({ V0, V2, V1, V1, V2, V3 });
+			}
+		}
+		return Mesh;
+	}
+
+	TArray<FTestMesh> MakeTestMeshes()
+	{
+		return { MakeSphere(24, 48, false), MakeSphere(24, 48, true), MakeGrid(32) };
+	}
+
+	// the largest distance of the surface of A (sampled on vertices, edges and centers) from the surface of B
+	double GetOneSidedDistance(const TArray<uint32>& A, const TArray<uint32>& B, const TArray<FVector>& Positions)
+	{
+		TArray<FVector> Samples;
+		for (int32 Index = 0; Index < A.Num(); Index += 3)
+		{
+			const FVector& Position0 = Positions[A[Index]];
+			const FVector& Position1 = Positions[A[Index + 1]];
+			const FVector& Position2 = Positions[A[Index + 2]];
+			Samples.Add(Position0);
+			Samples.Add((Position0 + Position1) / 2);
+			Samples.Add((Position0 + Position1 + Position2) / 3);
+		}
+
+		TArray<double> Distances;
+		Distances.AddUninitialized(Samples.Num());
+		ParallelFor(Samples.Num(), [&](const int32 SampleIndex)
+			{
+				double Distance = TNumericLimits<double>::Max();
+				for (int32 Index = 0; Index < B.Num(); Index += 3)
+				{
+					const FVector ClosestPoint = FMath::ClosestPointOnTriangleToPoint(Samples[SampleIndex], Positions[B[Index]], Positions[B[Index + 1]], Positions[B[Index + 2]]);
+					Distance = FMath::Min<double>(Distance, FVector::Distance(ClosestPoint, Samples[SampleIndex]));
+				}
+				Distances[SampleIndex] = Distance;
+			});
+
+		double MaxDistance = 0;
+		for (const double Distance : Distances)
+		{
+			MaxDistance = FMath::Max(MaxDistance, Distance);
+		}
+		return MaxDistance;
+	}
+
+	double GetHausdorffDistance(const TArray<uint32>& A, const TArray<uint32>& B, const TArray<FVector>& Positions)
+	{
+		return FMath::Max(GetOneSidedDistance(A, B, Positions), GetOneSidedDistance(B, A, Positions));
+	}
+
+	// half edges (by position) without an opposite one
+	int32 GetNumOfOpenEdges(const TArray<uint32>& Indices, const TArray<FVector>& Positions)
+	{
+		TSet<TPair<FVector, FVector>> Edges;
+		for (int32 Index = 0; Index < Indices.Num(); Index += 3)
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				Edges.Add(TPair<FVector, FVector>(Positions[Indices[Index + Corner]], Positions[Indices[Index + (Corner + 1) % 3]]));
+			}
+		}
+
+		int32 NumOfOpenEdges = 0;
+		for (const TPair<FVector, FVector>& Edge : Edges)
+		{
+			if (!Edges.Contains(TPair<FVector, FVector>(Edge.Value, Edge.Key)))
+			{
+				NumOfOpenEdges++;
+			}
+		}
+		return NumOfOpenEdges;
+	}
+
+	// geometry only
+	const auto NoAttributesDistance = [](const uint32 VertexA, const uint32 VertexB) -> double
+		{
+			return 0;
+		};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeMeshSimplifierBudgetTest, "glTFRuntime.MeshSimplifier.Budget", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeMeshSimplifierBudgetTest::RunTest(const FString& Parameters)
+{
+	for (const glTFRuntimeMeshSimplifierTests::FTestMesh& Mesh : glTFRuntimeMeshSimplifierTests::MakeTestMeshes())
+	{
+		double PreviousError = 0;
+		for (const float Ratio : { 0.5f, 0.25f, 0.1f })
+		{
+			const int32 TargetNumIndices = static_cast<int32>(Mesh.Indices.Num() / 3 * Ratio) * 3;
+			TArray<uint32> Indices = Mesh.Indices;
+			const double Error = FglTFRuntimeParser::SimplifyTriangles(Indices, Mesh.Positions, TargetNumIndices, glTFRuntimeMeshSimplifierTests::NoAttributesDistance);
+
+			// the last pass can overshoot by a collapse, but it must not go far below the budget
+			TestEqual(FString::Printf(TEXT("%s %.2f indices are triangles"), *Mesh.Name, Ratio), Indices.Num() % 3, 0);
+			TestTrue(FString::Printf(TEXT("%s %.2f: %d indices within %d"), *Mesh.Name, Ratio, Indices.Num(), TargetNumIndices), Indices.Num() <= TargetNumIndices);
+			TestTrue(FString::Printf(TEXT("%s %.2f: %d indices close to %d"), *Mesh.Name, Ratio, Indices.Num(), TargetNumIndices), Indices.Num() >= TargetNumIndices * 9 / 10);
+
+			for (const uint32 Index : Indices)
+			{
+				if (Index >= static_cast<uint32>(Mesh.Positions.Num()))
+				{
+					AddError(FString::Printf(TEXT("%s %.2f: invalid index %u"), *Mesh.Name, Ratio, Index));
+					return false;
+				}
+			}
+
+			TestTrue(FString::Printf(TEXT("%s %.2f error %f grows with the ratio"), *Mesh.Name, Ratio, Error), Error > PreviousError);
+			PreviousError = Error;
+		}
+	}
+
+	// nothing to do or invalid indices
+	const glTFRuntimeMeshSimplifierTests::FTestMesh Grid = glTFRuntimeMeshSimplifierTests::MakeGrid(4);
+	TArray<uint32> Indices = Grid.Indices;
+	TestEqual(TEXT("Budget larger than the mesh"), FglTFRuntimeParser::SimplifyTriangles(Indices, Grid.Positions, Indices.Num() + 3, glTFRuntimeMeshSimplifierTests::NoAttributesDistance), 0.0);
+	TestTrue(TEXT("Untouched mesh"), Indices == Grid.Indices);
+	Indices.Append({ 0, 1, static_cast<uint32>(Grid.Positions.Num()) });
+	const TArray<uint32> InvalidIndices = Indices;
+	FglTFRuntimeParser::SimplifyTriangles(Indices, Grid.Positions, 3, glTFRuntimeMeshSimplifierTests::NoAttributesDistance);
+	TestTrue(TEXT("Untouched invalid mesh"), Indices == InvalidIndices);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeMeshSimplifierHausdorffTest, "glTFRuntime.MeshSimplifier.Hausdorff", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeMeshSimplifierHausdorffTest::RunTest(const FString& Parameters)
+{
+	// maximum distance between the source and the simplified surfaces, relative to the bounds radius
+	const TArray<TPair<float, double>> RatiosBounds = { TPair<float, double>(0.5f, 0.02), TPair<float, double>(0.25f, 0.03), TPair<float, double>(0.1f, 0.06) };
+
+	for (const glTFRuntimeMeshSimplifierTests::FTestMesh& Mesh : glTFRuntimeMeshSimplifierTests::MakeTestMeshes())
+	{
+		const double Radius = FBox(Mesh.Positions).GetExtent().Size();
+		const int32 SourceNumOfOpenEdges = glTFRuntimeMeshSimplifierTests::GetNumOfOpenEdges(Mesh.Indices, Mesh.Positions);
+
+		for (const TPair<float, double>& RatioBound : RatiosBounds)
+		{
+			TArray<uint32> Indices = Mesh.Indices;
+			const double Error = FglTFRuntimeParser::SimplifyTriangles(Indices, Mesh.Positions, static_cast<int32>(Mesh.Indices.Num() / 3 * RatioBound.Key) * 3, glTFRuntimeMeshSimplifierTests::NoAttributesDistance);
+
+			const double HausdorffDistance = glTFRuntimeMeshSimplifierTests::GetHausdorffDistance(Mesh.Indices, Indices, Mesh.Positions);
+			TestTrue(FString::Printf(TEXT("%s %.2f Hausdorff distance %f within %f"), *Mesh.Name, RatioBound.Key, HausdorffDistance, RatioBound.Value * Radius), HausdorffDistance <= RatioBound.Value * Radius);
+
+			// seams follow each other, so the welded surface of the spheres stays closed
+			if (SourceNumOfOpenEdges == 0)
+			{
+				TestEqual(FString::Printf(TEXT("%s %.2f open edges"), *Mesh.Name, RatioBound.Key), glTFRuntimeMeshSimplifierTests::GetNumOfOpenEdges(Indices, Mesh.Positions), 0);
+			}
+
+			AddInfo(FString::Printf(TEXT("%s %.2f: %d -> %d triangles, error %.3f, Hausdorff distance %.3f (radius %.3f)"), *Mesh.Name, RatioBound.Key, Mesh.Indices.Num() / 3, Indices.Num() / 3, Error, HausdorffDistance, Radius));
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeMeshSimplifierBenchmarkTest, "glTFRuntime.MeshSimplifier.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeMeshSimplifierBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const glTFRuntimeMeshSimplifierTests::FTestMesh Mesh = glTFRuntimeMeshSimplifierTests::MakeSphere(256, 512, true);
+
+	for (const float Ratio : { 0.5f, 0.25f, 0.1f })
+	{
+		const int32 TargetNumIndices = static_cast<int32>(Mesh.Indices.Num() / 3 * Ratio) * 3;
+		TArray<uint32> Indices = Mesh.Indices;
+
+		const double StartTime = FPlatformTime::Seconds();
+		const double Error = FglTFRuntimeParser::SimplifyTriangles(Indices, Mesh.Positions, TargetNumIndices, glTFRuntimeMeshSimplifierTests::NoAttributesDistance);
+		const double Time = FPlatformTime::Seconds() - StartTime;
+
+		TestTrue(FString::Printf(TEXT("%.2f budget"), Ratio), Indices.Num() <= TargetNumIndices);
+
+		AddInfo(FString::Printf(TEXT("%.2f: %d -> %d triangles in %.2f ms (%.2f M source triangles per second), error %.4f"),
+			Ratio, Mesh.Indices.Num() / 3, Indices.Num() / 3, Time * 1000.0, Time > 0 ? Mesh.Indices.Num() / 3 / Time / 1000000.0 : 0.0, Error));
+	}
+
+	return true;
+}
+
+#endif
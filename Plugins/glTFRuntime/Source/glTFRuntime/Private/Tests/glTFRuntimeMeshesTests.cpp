@@ -0,0 +1,435 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeAsset.h"
+#include "glTFRuntimeAssetActorAsync.h"
+#include "glTFRuntimeParser.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Base64.h"
+#include "Misc/ScopeExit.h"
+
+namespace glTFRuntimeMeshesTests
+{
+	constexpr int32 NumOfSparseUVs = 8;
+
+	template<typename T>
+	int64 AppendToBuffer(TArray<uint8>& Buffer, const TArray<T>& Items)
+	{
+		const int64 Offset = Buffer.Num();
+		Buffer.Append(reinterpret_cast<const uint8*>(Items.GetData()), Items.Num() * sizeof(T));
+		return Offset;
+	}
+
+	// NumOfMeshes grids sharing the same indices and the same sparse TEXCOORD_0 (an accessor without bufferView, so zero filled and patched),
+	// every mesh has its own positions
+	FString MakeTestAsset(const int32 NumOfMeshes, const int32 GridSize)
+	{
+		TArray<uint8> Buffer;
+		FString BufferViews;
+
+		TArray<uint32> Indices;
+		for (int32 Y = 0; Y < GridSize - 1; Y++)
+		{
+			for (int32 X = 0; X < GridSize - 1; X++)
+			{
+				const uint32 Vertex = Y * GridSize + X;
+				Indices.Append({ Vertex, Vertex + GridSize, Vertex + 1, Vertex + 1, Vertex + GridSize, Vertex + GridSize + 1 });
+			}
+		}
+		BufferViews += FString::Printf(TEXT("{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%d},"), AppendToBuffer(Buffer, Indices), Indices.Num() * 4);
+
+		TArray<uint16> SparseIndices;
+		TArray<float> SparseValues;
+		for (int32 SparseIndex = 0; SparseIndex < NumOfSparseUVs; SparseIndex++)
+		{
+			SparseIndices.Add(SparseIndex * 3);
+			SparseValues.Append({ SparseIndex * 0.125f, 1.f - SparseIndex * 0.125f });
+		}
+		BufferViews += FString::Printf(TEXT("{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%d},"), AppendToBuffer(Buffer, SparseIndices), SparseIndices.Num() * 2);
+		BufferViews += FString::Printf(TEXT("{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%d}"), AppendToBuffer(Buffer, SparseValues), SparseValues.Num() * 4);
+
+		const int32 NumOfVertices = GridSize * GridSize;
+		FString Accessors = FString::Printf(TEXT("{\"bufferView\":0,\"componentType\":5125,\"count\":%d,\"type\":\"SCALAR\"},"), Indices.Num());
+		Accessors += FString::Printf(TEXT("{\"componentType\":5126,\"count\":%d,\"type\":\"VEC2\",\"sparse\":{\"count\":%d,\"indices\":{\"bufferView\":1,\"componentType\":5123},\"values\":{\"bufferView\":2}}}"), NumOfVertices, NumOfSparseUVs);
+
+		FString Meshes;
+		for (int32 MeshIndex = 0; MeshIndex < NumOfMeshes; MeshIndex++)
+		{
+			TArray<float> Positions;
+			for (int32 Y = 0; Y < GridSize; Y++)
+			{
+				for (int32 X = 0; X < GridSize; X++)
+				{
+					Positions.Append({ static_cast<float>(X), FMath::Sin(X * 0.1f + MeshIndex) * FMath::Cos(Y * 0.1f), static_cast<float>(Y + MeshIndex * GridSize) });
+				}
+			}
+			BufferViews += FString::Printf(TEXT(",{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%d}"), AppendToBuffer(Buffer, Positions), Positions.Num() * 4);
+			Accessors += FString::Printf(TEXT(",{\"bufferView\":%d,\"componentType\":5126,\"count\":%d,\"type\":\"VEC3\"}"), 3 + MeshIndex, NumOfVertices);
+			Meshes += FString::Printf(TEXT("%s{\"primitives\":[{\"attributes\":{\"POSITION\":%d,\"TEXCOORD_0\":1},\"indices\":0}]}"), MeshIndex > 0 ? TEXT(",") : TEXT(""), 2 + MeshIndex);
+		}
+
+		return FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":%d,\"uri\":\"data:application/octet-stream;base64,%s\"}],\"bufferViews\":[%s],\"accessors\":[%s],\"meshes\":[%s]}"),
+			Buffer.Num(), *FBase64::Encode(Buffer), *BufferViews, *Accessors, *Meshes);
+	}
+
+	// a GLB with NumOfMeshes grids attached to the same root node, every SkinnedMeshesInterval-th one is skinned to a single joint
+	// (indices, JOINTS_0, WEIGHTS_0 and the inverse bind matrix are shared, every mesh has its own positions)
+	TArray<uint8> MakeTestGlb(const int32 NumOfMeshes, const int32 GridSize, const int32 SkinnedMeshesInterval)
+	{
+		TArray<uint8> Buffer;
+		FString BufferViews;
+
+		TArray<uint32> Indices;
+		for (int32 Y = 0; Y < GridSize - 1; Y++)
+		{
+			for (int32 X = 0; X < GridSize - 1; X++)
+			{
+				const uint32 Vertex = Y * GridSize + X;
+				Indices.Append({ Vertex, Vertex + GridSize, Vertex + 1, Vertex + 1, Vertex + GridSize, Vertex + GridSize + 1 });
+			}
+		}
+
+		const int32 NumOfVertices = GridSize * GridSize;
+		TArray<uint8> Joints;
+		Joints.AddZeroed(NumOfVertices * 4);
+		TArray<float> Weights;
+		for (int32 VertexIndex = 0; VertexIndex < NumOfVertices; VertexIndex++)
+		{
+			Weights.Append({ 1.f, 0.f, 0.f, 0.f });
+		}
+		const TArray<float> InverseBindMatrix = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+		BufferViews += FString::Printf(TEXT("{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%d},"), AppendToBuffer(Buffer, Indices), Indices.Num() * 4);
+		BufferViews += FString::Printf(TEXT("{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%d},"), AppendToBuffer(Buffer, Joints), Joints.Num());
+		BufferViews += FString::Printf(TEXT("{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%d},"), AppendToBuffer(Buffer, Weights), Weights.Num() * 4);
+		BufferViews += FString::Printf(TEXT("{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%d}"), AppendToBuffer(Buffer, InverseBindMatrix), InverseBindMatrix.Num() * 4);
+
+		FString Accessors = FString::Printf(TEXT("{\"bufferView\":0,\"componentType\":5125,\"count\":%d,\"type\":\"SCALAR\"},"), Indices.Num());
+		Accessors += FString::Printf(TEXT("{\"bufferView\":1,\"componentType\":5121,\"count\":%d,\"type\":\"VEC4\"},"), NumOfVertices);
+		Accessors += FString::Printf(TEXT("{\"bufferView\":2,\"componentType\":5126,\"count\":%d,\"type\":\"VEC4\"},"), NumOfVertices);
+		Accessors += TEXT("{\"bufferView\":3,\"componentType\":5126,\"count\":1,\"type\":\"MAT4\"}");
+
+		// node 0 is the root, node 1 the joint, the meshes start from node 2
+		FString Meshes;
+		FString Nodes = TEXT("{\"name\":\"Root\",\"children\":[1");
+		FString MeshNodes;
+		for (int32 MeshIndex = 0; MeshIndex < NumOfMeshes; MeshIndex++)
+		{
+			TArray<float> Positions;
+			for (int32 Y = 0; Y < GridSize; Y++)
+			{
+				for (int32 X = 0; X < GridSize; X++)
+				{
+					Positions.Append({ static_cast<float>(X), FMath::Sin(X * 0.1f + MeshIndex) * FMath::Cos(Y * 0.1f), static_cast<float>(Y + MeshIndex * GridSize) });
+				}
+			}
+			// keep every bufferView 4 bytes aligned
+			while (Buffer.Num() % 4)
+			{
+				Buffer.Add(0);
+			}
+			BufferViews += FString::Printf(TEXT(",{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%d}"), AppendToBuffer(Buffer, Positions), Positions.Num() * 4);
+			Accessors += FString::Printf(TEXT(",{\"bufferView\":%d,\"componentType\":5126,\"count\":%d,\"type\":\"VEC3\"}"), 4 + MeshIndex, NumOfVertices);
+
+			const bool bSkinned = (MeshIndex % SkinnedMeshesInterval) == 0;
+			const FString SkinAttributes = bSkinned ? TEXT(",\"JOINTS_0\":1,\"WEIGHTS_0\":2") : TEXT("");
+			Meshes += FString::Printf(TEXT("%s{\"primitives\":[{\"attributes\":{\"POSITION\":%d%s},\"indices\":0}]}"), MeshIndex > 0 ? TEXT(",") : TEXT(""), 4 + MeshIndex, *SkinAttributes);
+			Nodes += FString::Printf(TEXT(",%d"), 2 + MeshIndex);
+			MeshNodes += FString::Printf(TEXT(",{\"name\":\"Mesh%d\",\"mesh\":%d%s}"), MeshIndex, MeshIndex, bSkinned ? TEXT(",\"skin\":0") : TEXT(""));
+		}
+		Nodes += TEXT("]},{\"name\":\"Bone\"}") + MeshNodes;
+
+		FTCHARToUTF8 JsonConverter(*FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":%d}],\"bufferViews\":[%s],\"accessors\":[%s],\"meshes\":[%s],")
+			TEXT("\"nodes\":[%s],\"skins\":[{\"joints\":[1],\"inverseBindMatrices\":3}],\"scenes\":[{\"nodes\":[0]}],\"scene\":0}"),
+			Buffer.Num(), *BufferViews, *Accessors, *Meshes, *Nodes));
+		TArray<uint8> Json;
+		Json.Append(reinterpret_cast<const uint8*>(JsonConverter.Get()), JsonConverter.Length());
+		while (Json.Num() % 4)
+		{
+			Json.Add(' ');
+		}
+		while (Buffer.Num() % 4)
+		{
+			Buffer.Add(0);
+		}
+
+		auto AppendUInt32 = [](TArray<uint8>& Bytes, const uint32 Value)
+			{
+				Bytes.Append(reinterpret_cast<const uint8*>(&Value), sizeof(uint32));
+			};
+
+		TArray<uint8> Glb;
+		Glb.Reserve(12 + 8 + Json.Num() + 8 + Buffer.Num());
+		AppendUInt32(Glb, 0x46546C67);
+		AppendUInt32(Glb, 2);
+		AppendUInt32(Glb, static_cast<uint32>(12 + 8 + Json.Num() + 8 + Buffer.Num()));
+		AppendUInt32(Glb, static_cast<uint32>(Json.Num()));
+		AppendUInt32(Glb, 0x4E4F534A);
+		Glb.Append(Json);
+		AppendUInt32(Glb, static_cast<uint32>(Buffer.Num()));
+		AppendUInt32(Glb, 0x004E4942);
+		Glb.Append(Buffer);
+		return Glb;
+	}
+
+	// number of mesh components of the actor with their mesh already assigned
+	int32 GetNumOfCommittedMeshes(AActor* Actor)
+	{
+		int32 NumOfCommittedMeshes = 0;
+		TInlineComponentArray<UStaticMeshComponent*> StaticMeshComponents(Actor);
+		for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+		{
+			NumOfCommittedMeshes += StaticMeshComponent->GetStaticMesh() ? 1 : 0;
+		}
+		TInlineComponentArray<USkeletalMeshComponent*> SkeletalMeshComponents(Actor);
+		for (const USkeletalMeshComponent* SkeletalMeshComponent : SkeletalMeshComponents)
+		{
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION > 0
+			NumOfCommittedMeshes += SkeletalMeshComponent->GetSkeletalMeshAsset() ? 1 : 0;
+#else
+			NumOfCommittedMeshes += SkeletalMeshComponent->SkeletalMesh ? 1 : 0;
+#endif
+		}
+		return NumOfCommittedMeshes;
+	}
+
+	bool IsSameLOD(const FglTFRuntimeMeshLOD& A, const FglTFRuntimeMeshLOD& B)
+	{
+		if (A.Primitives.Num() != B.Primitives.Num())
+		{
+			return false;
+		}
+
+		for (int32 PrimitiveIndex = 0; PrimitiveIndex < A.Primitives.Num(); PrimitiveIndex++)
+		{
+			const FglTFRuntimePrimitive& PrimitiveA = A.Primitives[PrimitiveIndex];
+			const FglTFRuntimePrimitive& PrimitiveB = B.Primitives[PrimitiveIndex];
+			if (PrimitiveA.Positions != PrimitiveB.Positions || PrimitiveA.Normals != PrimitiveB.Normals || PrimitiveA.Indices != PrimitiveB.Indices || PrimitiveA.UVs != PrimitiveB.UVs)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// loads every mesh NumOfLoadsPerMesh times, concurrently or one after the other
+	bool LoadLODs(FglTFRuntimeParser& Parser, const int32 NumOfMeshes, const int32 NumOfLoadsPerMesh, const bool bParallel, TArray<FglTFRuntimeMeshLOD>& LODs)
+	{
+		const int32 NumOfLoads = NumOfMeshes * NumOfLoadsPerMesh;
+		LODs.Empty();
+		LODs.SetNum(NumOfLoads);
+		TArray<bool> Results;
+		Results.SetNumZeroed(NumOfLoads);
+
+		ParallelFor(NumOfLoads, [&](const int32 LoadIndex)
+			{
+				Results[LoadIndex] = Parser.LoadMeshAsRuntimeLOD(LoadIndex % NumOfMeshes, LODs[LoadIndex], FglTFRuntimeMaterialsConfig());
+			}, !bParallel);
+
+		return !Results.Contains(false);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeMeshesConcurrentLODsTest, "glTFRuntime.Meshes.ConcurrentLODs", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeMeshesConcurrentLODsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumOfMeshes = 16;
+	constexpr int32 GridSize = 16;
+	constexpr int32 NumOfLoadsPerMesh = 8;
+	const FString Json = glTFRuntimeMeshesTests::MakeTestAsset(NumOfMeshes, GridSize);
+
+	TSharedPtr<FglTFRuntimeParser> SerialParser = FglTFRuntimeParser::FromString(Json, FglTFRuntimeConfig());
+	TSharedPtr<FglTFRuntimeParser> ParallelParser = FglTFRuntimeParser::FromString(Json, FglTFRuntimeConfig());
+	if (!SerialParser || !ParallelParser)
+	{
+		AddError(TEXT("Unable to parse the test asset"));
+		return false;
+	}
+
+	TArray<FglTFRuntimeMeshLOD> ExpectedLODs;
+	if (!glTFRuntimeMeshesTests::LoadLODs(*SerialParser, NumOfMeshes, 1, false, ExpectedLODs))
+	{
+		AddError(TEXT("Unable to load the meshes"));
+		return false;
+	}
+
+	// the sparse uvs must be patched over the zero filled accessor
+	const FglTFRuntimePrimitive& FirstPrimitive = ExpectedLODs[0].Primitives[0];
+	TestEqual(TEXT("Number of vertices"), FirstPrimitive.Positions.Num(), GridSize * GridSize);
+	TestTrue(TEXT("Sparse uv"), FirstPrimitive.UVs.Num() == 1 && FirstPrimitive.UVs[0].Num() == GridSize * GridSize && FirstPrimitive.UVs[0][3].Equals(FVector2D(0.125, 0.875)) && FirstPrimitive.UVs[0][4].IsZero());
+
+	// cold caches: every thread races on the same buffers, sparse accessor, zero buffer and LODs
+	TArray<FglTFRuntimeMeshLOD> LODs;
+	if (!glTFRuntimeMeshesTests::LoadLODs(*ParallelParser, NumOfMeshes, NumOfLoadsPerMesh, true, LODs))
+	{
+		AddError(TEXT("Unable to load the meshes concurrently"));
+		return false;
+	}
+
+	for (int32 LoadIndex = 0; LoadIndex < LODs.Num(); LoadIndex++)
+	{
+		if (!glTFRuntimeMeshesTests::IsSameLOD(LODs[LoadIndex], ExpectedLODs[LoadIndex % NumOfMeshes]))
+		{
+			AddError(FString::Printf(TEXT("Concurrent load %d of mesh %d differs from the serial one"), LoadIndex, LoadIndex % NumOfMeshes));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeMeshesConcurrentLODsBenchmarkTest, "glTFRuntime.Meshes.ConcurrentLODsBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeMeshesConcurrentLODsBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumOfMeshes = 32;
+	constexpr int32 GridSize = 192;
+	const FString Json = glTFRuntimeMeshesTests::MakeTestAsset(NumOfMeshes, GridSize);
+
+	auto Measure = [&](const bool bParallel, TArray<FglTFRuntimeMeshLOD>& LODs)
+		{
+			// a fresh parser for each run, so nothing is cached
+			TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromString(Json, FglTFRuntimeConfig());
+			if (!Parser)
+			{
+				return -1.0;
+			}
+			const double StartTime = FPlatformTime::Seconds();
+			if (!glTFRuntimeMeshesTests::LoadLODs(*Parser, NumOfMeshes, 1, bParallel, LODs))
+			{
+				return -1.0;
+			}
+			return FPlatformTime::Seconds() - StartTime;
+		};
+
+	TArray<FglTFRuntimeMeshLOD> SerialLODs;
+	const double SerialTime = Measure(false, SerialLODs);
+	TArray<FglTFRuntimeMeshLOD> ParallelLODs;
+	const double ParallelTime = Measure(true, ParallelLODs);
+	if (SerialTime < 0 || ParallelTime < 0)
+	{
+		AddError(TEXT("Unable to load the meshes"));
+		return false;
+	}
+
+	for (int32 MeshIndex = 0; MeshIndex < NumOfMeshes; MeshIndex++)
+	{
+		TestTrue(FString::Printf(TEXT("Mesh %d"), MeshIndex), glTFRuntimeMeshesTests::IsSameLOD(ParallelLODs[MeshIndex], SerialLODs[MeshIndex]));
+	}
+
+	AddInfo(FString::Printf(TEXT("%d meshes of %d vertices: serial %.2f ms, concurrent %.2f ms (%.2fx)"), NumOfMeshes, GridSize * GridSize, SerialTime * 1000.0, ParallelTime * 1000.0, SerialTime / FMath::Max(ParallelTime, SMALL_NUMBER)));
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeMeshesAsyncActorBenchmarkTest, "glTFRuntime.Meshes.AsyncActorBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeMeshesAsyncActorBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumOfMeshes = 500;
+	constexpr int32 GridSize = 16;
+	constexpr int32 SkinnedMeshesInterval = 25;
+	constexpr double TimeoutSeconds = 120.0;
+	// at least one mesh is committed per tick even when it alone exceeds the budget, so allow for a single commit over it
+	constexpr double MaxOverBudgetMs = 5.0;
+
+	const TArray<uint8> Glb = glTFRuntimeMeshesTests::MakeTestGlb(NumOfMeshes, GridSize, SkinnedMeshesInterval);
+	const int32 NumOfSkeletalMeshes = (NumOfMeshes + SkinnedMeshesInterval - 1) / SkinnedMeshesInterval;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+	ON_SCOPE_EXIT
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	};
+
+	struct FActorConfig
+	{
+		int32 MaxConcurrentMeshes;
+		float MeshesCommitBudgetMs;
+	};
+
+	// a budget of 0 means no limit, it is the reference for the worst frame
+	for (const FActorConfig& ActorConfig : { FActorConfig{ 1, 2.f }, FActorConfig{ 4, 2.f }, FActorConfig{ 16, 2.f }, FActorConfig{ 16, 0.f } })
+	{
+		UglTFRuntimeAsset* Asset = NewObject<UglTFRuntimeAsset>();
+		if (!Asset->LoadFromData(Glb, FglTFRuntimeConfig()))
+		{
+			AddError(TEXT("Unable to parse the generated GLB"));
+			return false;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		// BeginPlay (called by FinishSpawning) creates the components and starts loading
+		AglTFRuntimeAssetActorAsync* Actor = World->SpawnActorDeferred<AglTFRuntimeAssetActorAsync>(AglTFRuntimeAssetActorAsync::StaticClass(), FTransform::Identity);
+		Actor->Asset = Asset;
+		Actor->MaxConcurrentMeshes = ActorConfig.MaxConcurrentMeshes;
+		Actor->MeshesCommitBudgetMs = ActorConfig.MeshesCommitBudgetMs;
+		Actor->FinishSpawning(FTransform::Identity);
+		// the test drives the ticks itself, so every tick can be timed
+		Actor->SetActorTickEnabled(false);
+
+		const double SpawnTime = FPlatformTime::Seconds() - StartTime;
+
+		int32 NumOfFrames = 0;
+		double WorstTickTime = 0;
+		double TotalTickTime = 0;
+		int32 NumOfCommittedMeshes = 0;
+		while (NumOfCommittedMeshes < NumOfMeshes && FPlatformTime::Seconds() - StartTime < TimeoutSeconds)
+		{
+			// a frame: run the game thread tasks (the loaded meshes callbacks) and then tick the actor
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+			const double TickStartTime = FPlatformTime::Seconds();
+			Actor->TickActor(1.f / 60.f, LEVELTICK_All, Actor->PrimaryActorTick);
+			const double TickTime = FPlatformTime::Seconds() - TickStartTime;
+
+			WorstTickTime = FMath::Max(WorstTickTime, TickTime);
+			TotalTickTime += TickTime;
+			NumOfFrames++;
+
+			NumOfCommittedMeshes = glTFRuntimeMeshesTests::GetNumOfCommittedMeshes(Actor);
+			FPlatformProcess::Sleep(0);
+		}
+
+		const double LoadTime = FPlatformTime::Seconds() - StartTime;
+
+		Actor->Destroy();
+
+		const FString Context = FString::Printf(TEXT("MaxConcurrentMeshes %d, MeshesCommitBudgetMs %.1f"), ActorConfig.MaxConcurrentMeshes, ActorConfig.MeshesCommitBudgetMs);
+		if (!TestEqual(FString::Printf(TEXT("%s: committed meshes"), *Context), NumOfCommittedMeshes, NumOfMeshes))
+		{
+			return false;
+		}
+
+		if (ActorConfig.MeshesCommitBudgetMs > 0)
+		{
+			TestTrue(FString::Printf(TEXT("%s: worst tick %.2f ms within the budget"), *Context, WorstTickTime * 1000.0), WorstTickTime * 1000.0 <= ActorConfig.MeshesCommitBudgetMs + MaxOverBudgetMs);
+		}
+
+		AddInfo(FString::Printf(TEXT("%s: %d meshes (%d skeletal) loaded in %.2f ms (spawn %.2f ms) over %d frames, ticks %.2f ms total, worst tick %.2f ms"),
+			*Context, NumOfMeshes, NumOfSkeletalMeshes, LoadTime * 1000.0, SpawnTime * 1000.0, NumOfFrames, TotalTickTime * 1000.0, WorstTickTime * 1000.0));
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,216 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeParser.h"
+#include "HAL/PlatformTime.h"
+
+namespace glTFRuntimeTangentsTests
+{
+	// triangle list of a wavy grid, the right half has mirrored uvs (so the seam vertices have both handedness)
+	struct FTestMesh
+	{
+		TArray<FVector3f> Positions;
+		TArray<FVector3f> Normals;
+		TArray<FVector2f> UVs;
+		TArray<uint32> Keys;
+	};
+
+	FTestMesh MakeTestMesh(const int32 GridSize)
+	{
+		auto GetPosition = [](const int32 X, const int32 Y)
+			{
+				return FVector3f(X, Y, FMath::Sin(X * 0.2f) * FMath::Cos(Y * 0.15f) * 4.f);
+			};
+
+		auto GetNormal = [](const int32 X, const int32 Y)
+			{
+				const float DerivativeX = FMath::Cos(X * 0.2f) * 0.2f * FMath::Cos(Y * 0.15f) * 4.f;
+				const float DerivativeY = -FMath::Sin(X * 0.2f) * FMath::Sin(Y * 0.15f) * 0.15f * 4.f;
+				return FVector3f(-DerivativeX, -DerivativeY, 1).GetSafeNormal();
+			};
+
+		FTestMesh Mesh;
+		const int32 NumCorners = (GridSize - 1) * (GridSize - 1) * 6;
+		Mesh.Positions.Reserve(NumCorners);
+		Mesh.Normals.Reserve(NumCorners);
+		Mesh.UVs.Reserve(NumCorners);
+		Mesh.Keys.Reserve(NumCorners);
+
+		for (int32 Y = 0; Y < GridSize - 1; Y++)
+		{
+			for (int32 X = 0; X < GridSize - 1; X++)
+			{
+				const int32 Corners[6][2] = { { X, Y }, { X, Y + 1 }, { X + 1, Y }, { X + 1, Y }, { X, Y + 1 }, { X + 1, Y + 1 } };
+				const bool bMirrored = X >= GridSize / 2;
+				for (const int32* Corner : Corners)
+				{
+					const int32 CornerX = Corner[0];
+					const int32 CornerY = Corner[1];
+					Mesh.Positions.Add(GetPosition(CornerX, CornerY));
+					Mesh.Normals.Add(GetNormal(CornerX, CornerY));
+					const float U = static_cast<float>(CornerX) / (GridSize - 1);
+					Mesh.UVs.Add(FVector2f(bMirrored ? 1.f - U : U, static_cast<float>(CornerY) / (GridSize - 1)));
+					Mesh.Keys.Add(CornerY * GridSize + CornerX);
+				}
+			}
+		}
+
+		return Mesh;
+	}
+
+	// straightforward double precision version of the generator
+	TArray<FVector4> GenerateTangentsReference(const FTestMesh& Mesh)
+	{
+		TArray<FVector> CornersTangents;
+		TArray<int32> CornersW;
+		for (int32 Corner = 0; Corner < Mesh.Positions.Num(); Corner += 3)
+		{
+			const FVector Positions[3] = { FVector(Mesh.Positions[Corner]), FVector(Mesh.Positions[Corner + 1]), FVector(Mesh.Positions[Corner + 2]) };
+			const FVector2D DeltaUV0 = FVector2D(Mesh.UVs[Corner + 1] - Mesh.UVs[Corner]);
+			const FVector2D DeltaUV1 = FVector2D(Mesh.UVs[Corner + 2] - Mesh.UVs[Corner]);
+			const double Factor = 1.0 / (DeltaUV0.X * DeltaUV1.Y - DeltaUV0.Y * DeltaUV1.X);
+			const FVector TriangleTangent = ((Positions[1] - Positions[0]) * DeltaUV1.Y - (Positions[2] - Positions[0]) * DeltaUV0.Y) * Factor;
+			const FVector TriangleBitangent = ((Positions[2] - Positions[0]) * DeltaUV0.X - (Positions[1] - Positions[0]) * DeltaUV1.X) * Factor;
+
+			for (int32 TriangleCorner = 0; TriangleCorner < 3; TriangleCorner++)
+			{
+				const FVector Normal = FVector(Mesh.Normals[Corner + TriangleCorner]);
+				const FVector Tangent = (TriangleTangent - Normal * (Normal | TriangleTangent)).GetSafeNormal();
+				const FVector EdgeA = (Positions[(TriangleCorner + 1) % 3] - Positions[TriangleCorner]).GetSafeNormal();
+				const FVector EdgeB = (Positions[(TriangleCorner + 2) % 3] - Positions[TriangleCorner]).GetSafeNormal();
+				CornersTangents.Add(Tangent * FMath::Acos(FMath::Clamp<double>(EdgeA | EdgeB, -1.0, 1.0)));
+				CornersW.Add(((Normal ^ Tangent) | TriangleBitangent) < 0 ? -1 : 1);
+			}
+		}
+
+		TMap<TPair<uint32, int32>, FVector> Sums;
+		for (int32 Corner = 0; Corner < CornersTangents.Num(); Corner++)
+		{
+			Sums.FindOrAdd(TPair<uint32, int32>(Mesh.Keys[Corner], CornersW[Corner]), FVector::ZeroVector) += CornersTangents[Corner];
+		}
+
+		TArray<FVector4> Tangents;
+		for (int32 Corner = 0; Corner < CornersTangents.Num(); Corner++)
+		{
+			const FVector Normal = FVector(Mesh.Normals[Corner]);
+			const FVector& Sum = Sums[TPair<uint32, int32>(Mesh.Keys[Corner], CornersW[Corner])];
+			Tangents.Add(FVector4((Sum - Normal * (Normal | Sum)).GetSafeNormal(), CornersW[Corner]));
+		}
+		return Tangents;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeTangentsDeterminismTest, "glTFRuntime.Tangents.Determinism", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeTangentsDeterminismTest::RunTest(const FString& Parameters)
+{
+	// enough triangles for a few dozens of ranges
+	const glTFRuntimeTangentsTests::FTestMesh Mesh = glTFRuntimeTangentsTests::MakeTestMesh(256);
+
+	TArray<FVector4f> SingleThreadTangents;
+	FglTFRuntimeParser::GenerateTangents(Mesh.Positions, Mesh.Normals, Mesh.UVs, Mesh.Keys, SingleThreadTangents, true);
+	TArray<FVector3f> SingleThreadNormals;
+	FglTFRuntimeParser::GenerateFlatNormals(Mesh.Positions, SingleThreadNormals, true);
+
+	for (int32 Run = 0; Run < 4; Run++)
+	{
+		TArray<FVector4f> Tangents;
+		FglTFRuntimeParser::GenerateTangents(Mesh.Positions, Mesh.Normals, Mesh.UVs, Mesh.Keys, Tangents);
+		if (Tangents.Num() != SingleThreadTangents.Num() || FMemory::Memcmp(Tangents.GetData(), SingleThreadTangents.GetData(), Tangents.Num() * sizeof(FVector4f)) != 0)
+		{
+			AddError(FString::Printf(TEXT("Run %d: parallel tangents differ from the single thread ones"), Run));
+			return false;
+		}
+
+		TArray<FVector3f> Normals;
+		FglTFRuntimeParser::GenerateFlatNormals(Mesh.Positions, Normals);
+		if (Normals.Num() != SingleThreadNormals.Num() || FMemory::Memcmp(Normals.GetData(), SingleThreadNormals.GetData(), Normals.Num() * sizeof(FVector3f)) != 0)
+		{
+			AddError(FString::Printf(TEXT("Run %d: parallel flat normals differ from the single thread ones"), Run));
+			return false;
+		}
+	}
+
+	const TArray<FVector4> ExpectedTangents = glTFRuntimeTangentsTests::GenerateTangentsReference(Mesh);
+	int32 NumMirrored = 0;
+	for (int32 Corner = 0; Corner < SingleThreadTangents.Num(); Corner++)
+	{
+		const FVector Tangent = FVector(FVector3f(SingleThreadTangents[Corner]));
+		const FVector ExpectedTangent = FVector(ExpectedTangents[Corner]);
+		const FVector Normal = FVector(Mesh.Normals[Corner]);
+		if (SingleThreadTangents[Corner].W != ExpectedTangents[Corner].W || !Tangent.Equals(ExpectedTangent, 1e-3) || !FMath::IsNearlyEqual(Tangent.Size(), 1.0, 1e-4) || FMath::Abs(Tangent | Normal) > 1e-3)
+		{
+			AddError(FString::Printf(TEXT("Corner %d: tangent %s W %.0f, expected %s W %.0f"), Corner, *Tangent.ToString(), SingleThreadTangents[Corner].W, *ExpectedTangent.ToString(), static_cast<float>(ExpectedTangents[Corner].W)));
+			return false;
+		}
+
+		if (SingleThreadTangents[Corner].W < 0)
+		{
+			NumMirrored++;
+		}
+	}
+	TestTrue(TEXT("Mirrored uvs have the opposite handedness"), NumMirrored > 0 && NumMirrored < SingleThreadTangents.Num());
+
+	// flat normals face the side the runtime winding expects
+	for (int32 Corner = 0; Corner < SingleThreadNormals.Num(); Corner++)
+	{
+		if (!SingleThreadNormals[Corner].Equals(FVector3f(FVector::CrossProduct(FVector(Mesh.Positions[Corner / 3 * 3 + 2] - Mesh.Positions[Corner / 3 * 3]), FVector(Mesh.Positions[Corner / 3 * 3 + 1] - Mesh.Positions[Corner / 3 * 3])).GetSafeNormal()), 1e-4f))
+		{
+			AddError(FString::Printf(TEXT("Corner %d: wrong flat normal %s"), Corner, *SingleThreadNormals[Corner].ToString()));
+			return false;
+		}
+	}
+
+	// degenerate uvs still give a unit tangent on the normal plane
+	glTFRuntimeTangentsTests::FTestMesh DegenerateMesh;
+	DegenerateMesh.Positions = { FVector3f(0, 0, 0), FVector3f(0, 1, 0), FVector3f(1, 0, 0) };
+	DegenerateMesh.Normals = { FVector3f(0, 0, 1), FVector3f(0, 0, 1), FVector3f(0, 0, 1) };
+	DegenerateMesh.UVs = { FVector2f(0.5f, 0.5f), FVector2f(0.5f, 0.5f), FVector2f(0.5f, 0.5f) };
+	DegenerateMesh.Keys = { 0, 1, 2 };
+	TArray<FVector4f> DegenerateTangents;
+	FglTFRuntimeParser::GenerateTangents(DegenerateMesh.Positions, DegenerateMesh.Normals, DegenerateMesh.UVs, DegenerateMesh.Keys, DegenerateTangents);
+	for (const FVector4f& Tangent : DegenerateTangents)
+	{
+		TestTrue(TEXT("Degenerate uvs tangent"), FMath::IsNearlyEqual(FVector3f(Tangent).Size(), 1.f, 1e-4f) && FMath::Abs(Tangent.Z) < 1e-4f);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeTangentsBenchmarkTest, "glTFRuntime.Tangents.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeTangentsBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// 1000x1000 quads, 2M triangles
+	const glTFRuntimeTangentsTests::FTestMesh Mesh = glTFRuntimeTangentsTests::MakeTestMesh(1001);
+
+	auto Measure = [&](const bool bForceSingleThread, TArray<FVector3f>& Normals, TArray<FVector4f>& Tangents)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			FglTFRuntimeParser::GenerateFlatNormals(Mesh.Positions, Normals, bForceSingleThread);
+			const double NormalsTime = FPlatformTime::Seconds() - StartTime;
+			FglTFRuntimeParser::GenerateTangents(Mesh.Positions, Mesh.Normals, Mesh.UVs, Mesh.Keys, Tangents, bForceSingleThread);
+			return MakeTuple(NormalsTime, FPlatformTime::Seconds() - StartTime - NormalsTime);
+		};
+
+	TArray<FVector3f> SingleThreadNormals;
+	TArray<FVector4f> SingleThreadTangents;
+	const TTuple<double, double> SingleThread = Measure(true, SingleThreadNormals, SingleThreadTangents);
+
+	TArray<FVector3f> Normals;
+	TArray<FVector4f> Tangents;
+	const TTuple<double, double> Parallel = Measure(false, Normals, Tangents);
+
+	TestTrue(TEXT("Same normals"), FMemory::Memcmp(Normals.GetData(), SingleThreadNormals.GetData(), Normals.Num() * sizeof(FVector3f)) == 0);
+	TestTrue(TEXT("Same tangents"), FMemory::Memcmp(Tangents.GetData(), SingleThreadTangents.GetData(), Tangents.Num() * sizeof(FVector4f)) == 0);
+
+	AddInfo(FString::Printf(TEXT("%d triangles: flat normals %.2f ms single thread, %.2f ms parallel; tangents %.2f ms single thread, %.2f ms parallel"),
+		Mesh.Positions.Num() / 3, SingleThread.Key * 1000.0, Parallel.Key * 1000.0, SingleThread.Value * 1000.0, Parallel.Value * 1000.0));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,373 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeParser.h"
+#include "HAL/PlatformTime.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Math/RandomStream.h"
+#include "Misc/Base64.h"
+#include "Misc/ScopeExit.h"
+#include "Modules/ModuleManager.h"
+
+namespace glTFRuntimeTexturesTests
+{
+	TArray<uint8> MakePixels(const int32 Size, const int32 Seed)
+	{
+		TArray<uint8> Pixels;
+		for (int32 Y = 0; Y < Size; Y++)
+		{
+			for (int32 X = 0; X < Size; X++)
+			{
+				Pixels.Append({ static_cast<uint8>(X * 4 + Seed), static_cast<uint8>(Y * 4), static_cast<uint8>((X ^ Y) * Seed), static_cast<uint8>(255 - X) });
+			}
+		}
+		return Pixels;
+	}
+
+	TArray64<uint8> MakePng(const TArray<uint8>& Pixels, const int32 Size)
+	{
+		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+		if (!ImageWrapper || !ImageWrapper->SetRaw(Pixels.GetData(), Pixels.Num(), Size, Size, ERGBFormat::BGRA, 8))
+		{
+			return TArray64<uint8>();
+		}
+		const auto Compressed = ImageWrapper->GetCompressed();
+		TArray64<uint8> Png;
+		Png.Append(Compressed.GetData(), Compressed.Num());
+		return Png;
+	}
+
+	FString MakePngUri(const TArray<uint8>& Pixels, const int32 Size)
+	{
+		const TArray64<uint8> Png = MakePng(Pixels, Size);
+		if (Png.Num() == 0)
+		{
+			return FString();
+		}
+		return TEXT("data:image/png;base64,") + FBase64::Encode(Png.GetData(), Png.Num());
+	}
+
+	// texture 0 and 1 point to two images with the same content, texture 0 and 2 are used both as sRGB and linear
+	FString MakeTexturedAsset(const FString& FirstImageUri, const FString& SecondImageUri)
+	{
+		return FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"images\":[{\"uri\":\"%s\"},{\"uri\":\"%s\"},{\"uri\":\"%s\"}],")
+			TEXT("\"textures\":[{\"source\":0},{\"source\":1},{\"source\":2}],")
+			TEXT("\"materials\":[{\"pbrMetallicRoughness\":{\"baseColorTexture\":{\"index\":0}},\"occlusionTexture\":{\"index\":0},\"emissiveTexture\":{\"index\":1},\"normalTexture\":{\"index\":2}},")
+			TEXT("{\"pbrMetallicRoughness\":{\"baseColorTexture\":{\"index\":2}}}],")
+			TEXT("\"meshes\":[{\"primitives\":[{\"attributes\":{},\"material\":0}]},{\"primitives\":[{\"attributes\":{},\"material\":1}]}]}"),
+			*FirstImageUri, *FirstImageUri, *SecondImageUri);
+	}
+
+	bool IsSameMips(const TArray<FglTFRuntimeMipMap>& A, const TArray<FglTFRuntimeMipMap>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+
+		for (int32 MipIndex = 0; MipIndex < A.Num(); MipIndex++)
+		{
+			if (A[MipIndex].TextureIndex != B[MipIndex].TextureIndex || A[MipIndex].PixelFormat != B[MipIndex].PixelFormat ||
+				A[MipIndex].Width != B[MipIndex].Width || A[MipIndex].Height != B[MipIndex].Height || A[MipIndex].Pixels != B[MipIndex].Pixels)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// the 2x2 box filter with the rounding of FglTFRuntimeParser::DownsampleMipMap, one channel at a time
+	TArray<FColor> DownsampleReference(const TArray<FColor>& Pixels, const int32 Width, const int32 Height)
+	{
+		const int32 MipWidth = FMath::Max(Width / 2, 1);
+		const int32 MipHeight = FMath::Max(Height / 2, 1);
+		TArray<FColor> MipPixels;
+		for (int32 MipY = 0; MipY < MipHeight; MipY++)
+		{
+			for (int32 MipX = 0; MipX < MipWidth; MipX++)
+			{
+				const int32 X0 = FMath::Min(MipX * 2, Width - 1);
+				const int32 X1 = FMath::Min(MipX * 2 + 1, Width - 1);
+				const int32 Y0 = FMath::Min(MipY * 2, Height - 1);
+				const int32 Y1 = FMath::Min(MipY * 2 + 1, Height - 1);
+				const FColor& A = Pixels[Y0 * Width + X0];
+				const FColor& B = Pixels[Y0 * Width + X1];
+				const FColor& C = Pixels[Y1 * Width + X0];
+				const FColor& D = Pixels[Y1 * Width + X1];
+				MipPixels.Add(FColor((A.R + B.R + C.R + D.R + 2) / 4, (A.G + B.G + C.G + D.G + 2) / 4, (A.B + B.B + C.B + D.B + 2) / 4, (A.A + B.A + C.A + D.A + 2) / 4));
+			}
+		}
+		return MipPixels;
+	}
+
+	// mean absolute difference of the channels of two mip chains with the same layout (-1 if the layouts differ)
+	double GetMipsDifference(const TArray<FglTFRuntimeMipMap>& A, const TArray<FglTFRuntimeMipMap>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return -1;
+		}
+
+		int64 Difference = 0;
+		int64 Num = 0;
+		for (int32 MipIndex = 0; MipIndex < A.Num(); MipIndex++)
+		{
+			if (A[MipIndex].Width != B[MipIndex].Width || A[MipIndex].Height != B[MipIndex].Height || A[MipIndex].Pixels.Num() != B[MipIndex].Pixels.Num())
+			{
+				return -1;
+			}
+			for (int64 ByteIndex = 0; ByteIndex < A[MipIndex].Pixels.Num(); ByteIndex++)
+			{
+				Difference += FMath::Abs(static_cast<int32>(A[MipIndex].Pixels[ByteIndex]) - static_cast<int32>(B[MipIndex].Pixels[ByteIndex]));
+			}
+			Num += A[MipIndex].Pixels.Num();
+		}
+		return Num > 0 ? static_cast<double>(Difference) / Num : 0;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeTexturesPrefetchTest, "glTFRuntime.Textures.Prefetch", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeTexturesPrefetchTest::RunTest(const FString& Parameters)
+{
+	const TArray<uint8> FirstPixels = glTFRuntimeTexturesTests::MakePixels(64, 3);
+	const FString FirstImageUri = glTFRuntimeTexturesTests::MakePngUri(FirstPixels, 64);
+	const FString SecondImageUri = glTFRuntimeTexturesTests::MakePngUri(glTFRuntimeTexturesTests::MakePixels(32, 7), 32);
+	if (FirstImageUri.IsEmpty() || SecondImageUri.IsEmpty())
+	{
+		AddError(TEXT("Unable to encode the test images"));
+		return false;
+	}
+
+	const FString Json = glTFRuntimeTexturesTests::MakeTexturedAsset(FirstImageUri, SecondImageUri);
+	TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromString(Json, FglTFRuntimeConfig());
+	TSharedPtr<FglTFRuntimeParser> ReferenceParser = FglTFRuntimeParser::FromString(Json, FglTFRuntimeConfig());
+	if (!Parser || !ReferenceParser)
+	{
+		AddError(TEXT("Unable to parse the test asset"));
+		return false;
+	}
+
+	int32 NumOfImageIndexBroadcasts = 0;
+	const FDelegateHandle ImageIndexHandle = FglTFRuntimeParser::OnTextureImageIndex.AddLambda([&](TSharedRef<FglTFRuntimeParser> InParser, TSharedRef<FJsonObject> JsonTextureObject, int64& ImageIndex)
+		{
+			if (&InParser.Get() == Parser.Get())
+			{
+				NumOfImageIndexBroadcasts++;
+			}
+		});
+	ON_SCOPE_EXIT
+	{
+		FglTFRuntimeParser::OnTextureImageIndex.Remove(ImageIndexHandle);
+	};
+
+	FglTFRuntimeMaterialsConfig MaterialsConfig;
+	MaterialsConfig.bGeneratesMipMaps = true;
+	FglTFRuntimeMaterialsConfig PrefetchMaterialsConfig = MaterialsConfig;
+	Parser->PrefetchMeshesTextures({ 0, 1 }, PrefetchMaterialsConfig);
+	if (!PrefetchMaterialsConfig.PrefetchedTextures)
+	{
+		AddError(TEXT("No textures prefetched"));
+		return false;
+	}
+
+	// five slots, but the two images with the same content share the decoded sRGB mips
+	const FglTFRuntimePrefetchedTextures& PrefetchedTextures = *PrefetchMaterialsConfig.PrefetchedTextures;
+	TestEqual(TEXT("Textures"), PrefetchedTextures.TexturesImages.Num(), 3);
+	TestEqual(TEXT("Texture slots"), PrefetchedTextures.TexturesContents.Num(), 5);
+	TestEqual(TEXT("Decoded contents"), PrefetchedTextures.ContentsMips.Num(), 4);
+	TestTrue(TEXT("Same content"), PrefetchedTextures.TexturesContents[TPair<int32, bool>(0, true)] == PrefetchedTextures.TexturesContents[TPair<int32, bool>(1, true)]);
+	TestTrue(TEXT("Color space in the content key"), !(PrefetchedTextures.TexturesContents[TPair<int32, bool>(0, true)] == PrefetchedTextures.TexturesContents[TPair<int32, bool>(0, false)]));
+
+	const TPair<int32, bool> TexturesSlots[] = { TPair<int32, bool>(0, true), TPair<int32, bool>(0, false), TPair<int32, bool>(1, true), TPair<int32, bool>(2, false), TPair<int32, bool>(2, true) };
+	for (const TPair<int32, bool>& TextureSlot : TexturesSlots)
+	{
+		TArray<FglTFRuntimeMipMap> Mips;
+		FglTFRuntimeTextureSampler Sampler;
+		Parser->LoadTexture(TextureSlot.Key, Mips, TextureSlot.Value, PrefetchMaterialsConfig, Sampler);
+
+		TArray<FglTFRuntimeMipMap> ExpectedMips;
+		FglTFRuntimeTextureSampler ExpectedSampler;
+		ReferenceParser->LoadTexture(TextureSlot.Key, ExpectedMips, TextureSlot.Value, MaterialsConfig, ExpectedSampler);
+
+		if (ExpectedMips.Num() < 2 || !glTFRuntimeTexturesTests::IsSameMips(Mips, ExpectedMips))
+		{
+			AddError(FString::Printf(TEXT("Texture %d (sRGB %d): prefetched mips differ from the serially decoded ones"), TextureSlot.Key, TextureSlot.Value ? 1 : 0));
+			return false;
+		}
+	}
+
+	// the prefetch asked the image of each texture once, LoadTexture did not ask again
+	TestEqual(TEXT("OnTextureImageIndex broadcasts"), NumOfImageIndexBroadcasts, 3);
+
+	TArray<FglTFRuntimeMipMap> Mips;
+	FglTFRuntimeTextureSampler Sampler;
+	Parser->LoadTexture(1, Mips, true, PrefetchMaterialsConfig, Sampler);
+	TestTrue(TEXT("Decoded pixels"), Mips.Num() > 0 && Mips[0].PixelFormat == EPixelFormat::PF_B8G8R8A8 && Mips[0].Width == 64 && Mips[0].Height == 64 &&
+		Mips[0].Pixels.Num() == FirstPixels.Num() && FMemory::Memcmp(Mips[0].Pixels.GetData(), FirstPixels.GetData(), FirstPixels.Num()) == 0);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeTexturesBoxMipsTest, "glTFRuntime.Textures.BoxMips", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeTexturesBoxMipsTest::RunTest(const FString& Parameters)
+{
+	FRandomStream RandomStream(47);
+
+	// every power of two layout up to 256, including the 1 pixel wide and tall levels at the end of the chains
+	for (int32 Width = 1; Width <= 256; Width *= 2)
+	{
+		for (int32 Height = 1; Height <= 256; Height *= 2)
+		{
+			TArray<FColor> Pixels;
+			for (int32 PixelIndex = 0; PixelIndex < Width * Height; PixelIndex++)
+			{
+				Pixels.Add(FColor(RandomStream.RandRange(0, 255), RandomStream.RandRange(0, 255), RandomStream.RandRange(0, 255), RandomStream.RandRange(0, 255)));
+			}
+
+			const TArray<FColor> ExpectedMipPixels = glTFRuntimeTexturesTests::DownsampleReference(Pixels, Width, Height);
+			for (const bool bForceScalar : { false, true })
+			{
+				TArray<FColor> MipPixels;
+				MipPixels.AddUninitialized(ExpectedMipPixels.Num());
+				FglTFRuntimeParser::DownsampleMipMap(Pixels.GetData(), Width, Height, MipPixels.GetData(), false, bForceScalar);
+				if (MipPixels != ExpectedMipPixels)
+				{
+					AddError(FString::Printf(TEXT("%dx%d (scalar %d): box filtered mip differs from the reference"), Width, Height, bForceScalar ? 1 : 0));
+					return false;
+				}
+			}
+		}
+	}
+
+	// sRGB colors are averaged in linear space: black and white give the linear middle gray (187.5 in sRGB, not 128)
+	const TArray<FColor> Checker = { FColor::Black, FColor::White, FColor::White, FColor::Black };
+	FColor CheckerMip;
+	FglTFRuntimeParser::DownsampleMipMap(Checker.GetData(), 2, 2, &CheckerMip, true);
+	TestTrue(TEXT("sRGB average"), CheckerMip.R >= 187 && CheckerMip.R <= 188 && CheckerMip.G == CheckerMip.R && CheckerMip.B == CheckerMip.R && CheckerMip.A == 255);
+
+	// the whole chain through LoadBlobToMips, every level from the previous one
+	TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromString(TEXT("{\"asset\":{\"version\":\"2.0\"}}"), FglTFRuntimeConfig());
+	const TArray64<uint8> Png = glTFRuntimeTexturesTests::MakePng(glTFRuntimeTexturesTests::MakePixels(64, 5), 64);
+	if (!Parser || Png.Num() == 0)
+	{
+		AddError(TEXT("Unable to create the test image"));
+		return false;
+	}
+
+	FglTFRuntimeMaterialsConfig MaterialsConfig;
+	MaterialsConfig.bGeneratesMipMaps = true;
+	MaterialsConfig.bGenerateMipMapsFromPreviousMip = true;
+	for (const bool sRGB : { false, true })
+	{
+		TArray<FglTFRuntimeMipMap> Mips;
+		if (!Parser->LoadBlobToMips(Png, Mips, sRGB, MaterialsConfig) || Mips.Num() != 7)
+		{
+			AddError(FString::Printf(TEXT("sRGB %d: unable to generate the mips"), sRGB ? 1 : 0));
+			return false;
+		}
+
+		for (int32 MipIndex = 1; MipIndex < Mips.Num(); MipIndex++)
+		{
+			const FglTFRuntimeMipMap& PreviousMipMap = Mips[MipIndex - 1];
+			TArray64<uint8> ExpectedPixels;
+			ExpectedPixels.AddUninitialized(Mips[MipIndex].Width * Mips[MipIndex].Height * sizeof(FColor));
+			FglTFRuntimeParser::DownsampleMipMap(reinterpret_cast<const FColor*>(PreviousMipMap.Pixels.GetData()), PreviousMipMap.Width, PreviousMipMap.Height, reinterpret_cast<FColor*>(ExpectedPixels.GetData()), sRGB);
+			if (Mips[MipIndex].Width != 64 >> MipIndex || Mips[MipIndex].Height != 64 >> MipIndex || Mips[MipIndex].Pixels != ExpectedPixels)
+			{
+				AddError(FString::Printf(TEXT("sRGB %d: mip %d is not the box filter of the previous one"), sRGB ? 1 : 0, MipIndex));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeTexturesMipsBenchmarkTest, "glTFRuntime.Textures.MipsBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeTexturesMipsBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumOfTextures = 64;
+	constexpr int32 Size = 512;
+
+	TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromString(TEXT("{\"asset\":{\"version\":\"2.0\"}}"), FglTFRuntimeConfig());
+	if (!Parser)
+	{
+		AddError(TEXT("Unable to create the parser"));
+		return false;
+	}
+
+	TArray<TArray64<uint8>> Pngs;
+	for (int32 TextureIndex = 0; TextureIndex < NumOfTextures; TextureIndex++)
+	{
+		Pngs.Add(glTFRuntimeTexturesTests::MakePng(glTFRuntimeTexturesTests::MakePixels(Size, TextureIndex + 1), Size));
+		if (Pngs.Last().Num() == 0)
+		{
+			AddError(TEXT("Unable to encode the test images"));
+			return false;
+		}
+	}
+
+	// the decoding is the same for every run, so the mips cost is the difference with the run without mips
+	auto Measure = [&](const bool sRGB, const bool bGeneratesMipMaps, const bool bGenerateMipMapsFromPreviousMip, TArray<TArray<FglTFRuntimeMipMap>>& TexturesMips)
+		{
+			FglTFRuntimeMaterialsConfig MaterialsConfig;
+			MaterialsConfig.bGeneratesMipMaps = bGeneratesMipMaps;
+			MaterialsConfig.bGenerateMipMapsFromPreviousMip = bGenerateMipMapsFromPreviousMip;
+			TexturesMips.SetNum(NumOfTextures);
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 TextureIndex = 0; TextureIndex < NumOfTextures; TextureIndex++)
+			{
+				if (!Parser->LoadBlobToMips(Pngs[TextureIndex], TexturesMips[TextureIndex], sRGB, MaterialsConfig))
+				{
+					return -1.0;
+				}
+			}
+			return FPlatformTime::Seconds() - StartTime;
+		};
+
+	for (const bool sRGB : { false, true })
+	{
+		TArray<TArray<FglTFRuntimeMipMap>> DecodedMips;
+		TArray<TArray<FglTFRuntimeMipMap>> ResizedMips;
+		TArray<TArray<FglTFRuntimeMipMap>> BoxFilteredMips;
+		const double DecodeTime = Measure(sRGB, false, false, DecodedMips);
+		const double ResizeTime = Measure(sRGB, true, false, ResizedMips);
+		const double BoxFilterTime = Measure(sRGB, true, true, BoxFilteredMips);
+		if (DecodeTime < 0 || ResizeTime < 0 || BoxFilterTime < 0)
+		{
+			AddError(TEXT("Unable to load the textures"));
+			return false;
+		}
+
+		double Difference = 0;
+		for (int32 TextureIndex = 0; TextureIndex < NumOfTextures; TextureIndex++)
+		{
+			const double TextureDifference = glTFRuntimeTexturesTests::GetMipsDifference(ResizedMips[TextureIndex], BoxFilteredMips[TextureIndex]);
+			if (TextureDifference < 0)
+			{
+				AddError(FString::Printf(TEXT("sRGB %d: texture %d mips layouts differ"), sRGB ? 1 : 0, TextureIndex));
+				return false;
+			}
+			Difference += TextureDifference / NumOfTextures;
+		}
+
+		const double ResizeMipsTime = FMath::Max(ResizeTime - DecodeTime, 0.0);
+		const double BoxFilterMipsTime = FMath::Max(BoxFilterTime - DecodeTime, 0.0);
+		AddInfo(FString::Printf(TEXT("%d %dx%d textures (sRGB %d): decoding %.2f ms, mips from the full image %.2f ms, mips from the previous level %.2f ms (%.2fx), mean channel difference %.2f"),
+			NumOfTextures, Size, Size, sRGB ? 1 : 0, DecodeTime * 1000.0, ResizeMipsTime * 1000.0, BoxFilterMipsTime * 1000.0, ResizeMipsTime / FMath::Max(BoxFilterMipsTime, SMALL_NUMBER), Difference));
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,387 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "glTFRuntimeParser.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace glTFRuntimeZipFileTests
+{
+	// minimal streaming zip writer (no zip64, archives must stay below 4 GB)
+	class FZipWriter
+	{
+	public:
+		FZipWriter(const FString& Filename) : FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Filename)), Offset(0), NumOfEntries(0)
+		{
+		}
+
+		bool IsValid() const
+		{
+			return FileHandle.IsValid();
+		}
+
+		bool AddEntry(const FString& Name, const TArray64<uint8>& Data, const bool bDeflate)
+		{
+			uLong Crc32 = crc32(0, nullptr, 0);
+			for (int64 CrcOffset = 0; CrcOffset < Data.Num(); CrcOffset += MAX_uint32)
+			{
+				Crc32 = crc32(Crc32, Data.GetData() + CrcOffset, static_cast<uInt>(FMath::Min<int64>(MAX_uint32, Data.Num() - CrcOffset)));
+			}
+
+			TArray64<uint8> Deflated;
+			if (bDeflate)
+			{
+				z_stream Stream;
+				FMemory::Memzero(Stream);
+				if (deflateInit2(&Stream, 1, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+				{
+					return false;
+				}
+				Deflated.SetNumUninitialized(deflateBound(&Stream, static_cast<uLong>(Data.Num())));
+				Stream.next_in = const_cast<Bytef*>(Data.GetData());
+				Stream.avail_in = static_cast<uInt>(Data.Num());
+				Stream.next_out = Deflated.GetData();
+				Stream.avail_out = static_cast<uInt>(Deflated.Num());
+				const int32 Result = deflate(&Stream, Z_FINISH);
+				Deflated.SetNum(Stream.total_out);
+				deflateEnd(&Stream);
+				if (Result != Z_STREAM_END)
+				{
+					return false;
+				}
+			}
+
+			const TArray64<uint8>& Payload = bDeflate ? Deflated : Data;
+			FTCHARToUTF8 NameConverter(*Name);
+
+			TArray<uint8> Header;
+			WriteUInt32(Header, 0x04034b50);
+			WriteUInt16(Header, 20);
+			WriteUInt16(Header, 0);
+			WriteUInt16(Header, bDeflate ? 8 : 0);
+			WriteUInt32(Header, 0);
+			WriteUInt32(Header, Crc32);
+			WriteUInt32(Header, static_cast<uint32>(Payload.Num()));
+			WriteUInt32(Header, static_cast<uint32>(Data.Num()));
+			WriteUInt16(Header, NameConverter.Length());
+			WriteUInt16(Header, 0);
+			Header.Append(reinterpret_cast<const uint8*>(NameConverter.Get()), NameConverter.Length());
+
+			// central directory record
+			WriteUInt32(CentralDirectory, 0x02014b50);
+			WriteUInt16(CentralDirectory, 20);
+			CentralDirectory.Append(Header.GetData() + 4, 26);
+			WriteUInt16(CentralDirectory, 0);
+			WriteUInt16(CentralDirectory, 0);
+			WriteUInt16(CentralDirectory, 0);
+			WriteUInt32(CentralDirectory, 0);
+			WriteUInt32(CentralDirectory, static_cast<uint32>(Offset));
+			CentralDirectory.Append(reinterpret_cast<const uint8*>(NameConverter.Get()), NameConverter.Length());
+			NumOfEntries++;
+
+			return Write(Header.GetData(), Header.Num()) && Write(Payload.GetData(), Payload.Num());
+		}
+
+		bool Close()
+		{
+			const int64 CentralDirectoryOffset = Offset;
+			TArray<uint8> Trailer;
+			WriteUInt32(Trailer, 0x06054b50);
+			WriteUInt16(Trailer, 0);
+			WriteUInt16(Trailer, 0);
+			WriteUInt16(Trailer, NumOfEntries);
+			WriteUInt16(Trailer, NumOfEntries);
+			WriteUInt32(Trailer, CentralDirectory.Num());
+			WriteUInt32(Trailer, static_cast<uint32>(CentralDirectoryOffset));
+			WriteUInt16(Trailer, 0);
+
+			const bool bSuccess = Write(CentralDirectory.GetData(), CentralDirectory.Num()) && Write(Trailer.GetData(), Trailer.Num()) && Offset <= MAX_uint32;
+			FileHandle.Reset();
+			return bSuccess;
+		}
+
+	protected:
+		static void WriteUInt16(TArray<uint8>& Bytes, const uint16 Value)
+		{
+			Bytes.Append({ static_cast<uint8>(Value), static_cast<uint8>(Value >> 8) });
+		}
+
+		static void WriteUInt32(TArray<uint8>& Bytes, const uint32 Value)
+		{
+			WriteUInt16(Bytes, static_cast<uint16>(Value));
+			WriteUInt16(Bytes, static_cast<uint16>(Value >> 16));
+		}
+
+		bool Write(const uint8* Data, const int64 Num)
+		{
+			Offset += Num;
+			return FileHandle->Write(Data, Num);
+		}
+
+		TUniquePtr<IFileHandle> FileHandle;
+		int64 Offset;
+		TArray<uint8> CentralDirectory;
+		uint16 NumOfEntries;
+	};
+
+	// compressible entries repeat a short pattern, the others are noise
+	TArray64<uint8> MakeEntryData(const int64 Num, const uint32 Seed, const bool bCompressible)
+	{
+		TArray64<uint8> Data;
+		Data.SetNumUninitialized(Num);
+		uint64 State = 0x9E3779B97F4A7C15ull * (Seed + 1);
+		for (int64 ByteIndex = 0; ByteIndex < Num; ByteIndex += 8)
+		{
+			State ^= State << 13;
+			State ^= State >> 7;
+			State ^= State << 17;
+			const uint64 Value = bCompressible ? (ByteIndex / 8 % 61) * 0x0101010101010101ull + Seed : State;
+			FMemory::Memcpy(Data.GetData() + ByteIndex, &Value, FMath::Min<int64>(8, Num - ByteIndex));
+		}
+		return Data;
+	}
+
+	FString MakeAssetJson(const int32 AssetIndex, const int64 BufferNum)
+	{
+		return FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":%lld,\"uri\":\"asset%03d.bin\"}]}"), BufferNum, AssetIndex);
+	}
+
+	struct FArchiveEntry
+	{
+		FString Name;
+		int64 Num;
+		uint32 Seed;
+		bool bCompressible;
+	};
+
+	// every asset is a .gltf (deflated) referencing its own .bin (stored, or deflated when compressible)
+	bool WriteAssetsArchive(const FString& Filename, const int32 NumOfAssets, const int64 BufferNum, const int32 CompressibleEvery, TArray<FArchiveEntry>& Entries)
+	{
+		FZipWriter ZipWriter(Filename);
+		if (!ZipWriter.IsValid())
+		{
+			return false;
+		}
+
+		for (int32 AssetIndex = 0; AssetIndex < NumOfAssets; AssetIndex++)
+		{
+			FTCHARToUTF8 JsonConverter(*MakeAssetJson(AssetIndex, BufferNum));
+			TArray64<uint8> Json;
+			Json.Append(reinterpret_cast<const uint8*>(JsonConverter.Get()), JsonConverter.Length());
+
+			FArchiveEntry BufferEntry = { FString::Printf(TEXT("asset%03d.bin"), AssetIndex), BufferNum, static_cast<uint32>(AssetIndex), (AssetIndex % CompressibleEvery) == 0 };
+			if (!ZipWriter.AddEntry(FString::Printf(TEXT("asset%03d.gltf"), AssetIndex), Json, true) ||
+				!ZipWriter.AddEntry(BufferEntry.Name, MakeEntryData(BufferEntry.Num, BufferEntry.Seed, BufferEntry.bCompressible), BufferEntry.bCompressible))
+			{
+				return false;
+			}
+			Entries.Add(BufferEntry);
+		}
+
+		return ZipWriter.AddEntry(TEXT("empty.txt"), TArray64<uint8>(), false) && ZipWriter.Close();
+	}
+
+	int64 GetUsedPhysical()
+	{
+		return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeZipFileEntriesTest, "glTFRuntime.ZipFile.Entries", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeZipFileEntriesTest::RunTest(const FString& Parameters)
+{
+	const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("glTFRuntimeZipFile"), TEXT("entries.zip"));
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+
+	TArray<glTFRuntimeZipFileTests::FArchiveEntry> Entries;
+	// 1 MB buffers (bigger than the 256k read chunk), deflated for the even assets and stored for the odd ones
+	if (!glTFRuntimeZipFileTests::WriteAssetsArchive(Filename, 8, 1024 * 1024 + 3, 2, Entries))
+	{
+		AddError(TEXT("Unable to write the test archive"));
+		return false;
+	}
+
+	TArray64<uint8> ArchiveBytes;
+	FFileHelper::LoadFileToArray(ArchiveBytes, *Filename);
+
+	TSharedRef<FglTFRuntimeZipFile> FileZip = MakeShared<FglTFRuntimeZipFile>();
+	TSharedRef<FglTFRuntimeZipFile> MemoryZip = MakeShared<FglTFRuntimeZipFile>();
+	if (!FileZip->FromFile(Filename) || !MemoryZip->FromData(ArchiveBytes.GetData(), ArchiveBytes.Num()))
+	{
+		AddError(TEXT("Unable to open the test archive"));
+		return false;
+	}
+
+	for (const TSharedRef<FglTFRuntimeZipFile>& Zip : { FileZip, MemoryZip })
+	{
+		TArray<FString> Items;
+		Zip->GetItems(Items);
+		TestEqual(TEXT("Items"), Items.Num(), Entries.Num() * 2 + 1);
+
+		// concurrent reads, every entry read by several threads
+		constexpr int32 NumOfReads = 64;
+		TArray<bool> Results;
+		Results.SetNumZeroed(NumOfReads);
+		ParallelFor(NumOfReads, [&](const int32 ReadIndex)
+			{
+				const glTFRuntimeZipFileTests::FArchiveEntry& Entry = Entries[ReadIndex % Entries.Num()];
+				TArray64<uint8> Content;
+				Results[ReadIndex] = Zip->GetFileContent(Entry.Name, Content) && Content == glTFRuntimeZipFileTests::MakeEntryData(Entry.Num, Entry.Seed, Entry.bCompressible);
+			});
+		TestFalse(TEXT("Concurrent reads"), Results.Contains(false));
+
+		// caller provided buffers
+		TArray64<uint8> Buffer;
+		Buffer.SetNumUninitialized(Zip->GetFileSize(Entries[1].Name));
+		TestTrue(TEXT("Read into a buffer"), Zip->GetFileContent(Entries[1].Name, Buffer.GetData(), Buffer.Num()) && Buffer == glTFRuntimeZipFileTests::MakeEntryData(Entries[1].Num, Entries[1].Seed, Entries[1].bCompressible));
+		TestFalse(TEXT("Buffer too small"), Zip->GetFileContent(Entries[1].Name, Buffer.GetData(), Buffer.Num() - 1));
+
+		TArray64<uint8> Json;
+		const bool bJsonRead = Zip->GetFileContent(TEXT("asset003.gltf"), Json);
+		FUTF8ToTCHAR JsonConverter(reinterpret_cast<const ANSICHAR*>(Json.GetData()), Json.Num());
+		TestTrue(TEXT("Deflated json"), bJsonRead && FString(JsonConverter.Length(), JsonConverter.Get()) == glTFRuntimeZipFileTests::MakeAssetJson(3, Entries[3].Num));
+
+		TArray64<uint8> Empty;
+		TestTrue(TEXT("Empty entry"), Zip->GetFileContent(TEXT("empty.txt"), Empty) && Empty.Num() == 0);
+		TestFalse(TEXT("Missing entry"), Zip->FileExists(TEXT("missing.bin")));
+		TestEqual(TEXT("Missing entry size"), Zip->GetFileSize(TEXT("missing.bin")), static_cast<int64>(INDEX_NONE));
+	}
+
+	// a corrupted stored entry fails its crc check, without affecting the others
+	const TArray64<uint8> StoredData = glTFRuntimeZipFileTests::MakeEntryData(Entries[1].Num, Entries[1].Seed, Entries[1].bCompressible);
+	int64 StoredDataOffset = INDEX_NONE;
+	for (int64 Offset = 0; Offset + 64 <= ArchiveBytes.Num() && StoredDataOffset == INDEX_NONE; Offset++)
+	{
+		if (FMemory::Memcmp(ArchiveBytes.GetData() + Offset, StoredData.GetData(), 64) == 0)
+		{
+			StoredDataOffset = Offset;
+		}
+	}
+	if (StoredDataOffset == INDEX_NONE)
+	{
+		AddError(TEXT("Unable to find the stored entry"));
+		return false;
+	}
+	ArchiveBytes[StoredDataOffset + StoredData.Num() / 2] ^= 0xFF;
+	TSharedRef<FglTFRuntimeZipFile> CorruptedZip = MakeShared<FglTFRuntimeZipFile>();
+	if (!CorruptedZip->FromData(ArchiveBytes.GetData(), ArchiveBytes.Num()))
+	{
+		AddError(TEXT("Unable to open the corrupted archive"));
+		return false;
+	}
+
+	int32 NumOfValidEntries = 0;
+	for (const glTFRuntimeZipFileTests::FArchiveEntry& Entry : Entries)
+	{
+		TArray64<uint8> Content;
+		NumOfValidEntries += CorruptedZip->GetFileContent(Entry.Name, Content) ? 1 : 0;
+	}
+	TestEqual(TEXT("Valid entries after the corruption"), NumOfValidEntries, Entries.Num() - 1);
+
+	// the parser reads the assets (and their buffers) from the archive
+	FglTFRuntimeConfig LoaderConfig;
+	LoaderConfig.ArchiveEntryPoint = TEXT("asset005.gltf");
+	TSharedPtr<FglTFRuntimeParser> Parser = FglTFRuntimeParser::FromFilename(Filename, LoaderConfig);
+	FglTFRuntimeBlob Blob;
+	if (!Parser || !Parser->GetBuffer(0, Blob))
+	{
+		AddError(TEXT("Unable to load an asset from the archive"));
+		return false;
+	}
+	const TArray64<uint8> Expected = glTFRuntimeZipFileTests::MakeEntryData(Entries[5].Num, Entries[5].Seed, Entries[5].bCompressible);
+	TestTrue(TEXT("Asset buffer"), Blob.Num == Expected.Num() && FMemory::Memcmp(Blob.Data, Expected.GetData(), Blob.Num) == 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeZipFileBenchmarkTest, "glTFRuntime.ZipFile.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FglTFRuntimeZipFileBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// 256 assets with 8 MB buffers, 2 GB archive
+	constexpr int32 NumOfAssets = 256;
+	constexpr int64 BufferNum = 8 * 1024 * 1024;
+	const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("glTFRuntimeZipFile"), TEXT("benchmark.zip"));
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+	ON_SCOPE_EXIT
+	{
+		IFileManager::Get().Delete(*Filename, false, false, true);
+	};
+
+	TArray<glTFRuntimeZipFileTests::FArchiveEntry> Entries;
+	if (!glTFRuntimeZipFileTests::WriteAssetsArchive(Filename, NumOfAssets, BufferNum, 8, Entries))
+	{
+		AddError(TEXT("Unable to write the benchmark archive"));
+		return false;
+	}
+	const int64 ArchiveSize = IFileManager::Get().FileSize(*Filename);
+
+	const int64 StartUsedPhysical = glTFRuntimeZipFileTests::GetUsedPhysical();
+	int64 PeakUsedPhysical = StartUsedPhysical;
+
+	double StartTime = FPlatformTime::Seconds();
+	TSharedRef<FglTFRuntimeZipFile> Zip = MakeShared<FglTFRuntimeZipFile>();
+	if (!Zip->FromFile(Filename))
+	{
+		AddError(TEXT("Unable to open the benchmark archive"));
+		return false;
+	}
+	const double OpenTime = FPlatformTime::Seconds() - StartTime;
+	PeakUsedPhysical = FMath::Max(PeakUsedPhysical, glTFRuntimeZipFileTests::GetUsedPhysical());
+
+	// sequential reads into the same caller provided buffer
+	TArray64<uint8> Buffer;
+	Buffer.SetNumUninitialized(BufferNum);
+	double MaxLatency = 0;
+	bool bAllRead = true;
+	StartTime = FPlatformTime::Seconds();
+	for (const glTFRuntimeZipFileTests::FArchiveEntry& Entry : Entries)
+	{
+		const double EntryStartTime = FPlatformTime::Seconds();
+		bAllRead &= Zip->GetFileContent(Entry.Name, Buffer.GetData(), Buffer.Num());
+		MaxLatency = FMath::Max(MaxLatency, FPlatformTime::Seconds() - EntryStartTime);
+		PeakUsedPhysical = FMath::Max(PeakUsedPhysical, glTFRuntimeZipFileTests::GetUsedPhysical());
+	}
+	const double SequentialTime = FPlatformTime::Seconds() - StartTime;
+	TestTrue(TEXT("Sequential reads"), bAllRead);
+
+	TestTrue(TEXT("Last entry"), Buffer == glTFRuntimeZipFileTests::MakeEntryData(Entries.Last().Num, Entries.Last().Seed, Entries.Last().bCompressible));
+
+	// concurrent reads, each worker with its own buffer
+	TArray<bool> Results;
+	Results.SetNumZeroed(Entries.Num());
+	StartTime = FPlatformTime::Seconds();
+	ParallelFor(Entries.Num(), [&](const int32 EntryIndex)
+		{
+			TArray64<uint8> EntryBuffer;
+			EntryBuffer.SetNumUninitialized(BufferNum);
+			Results[EntryIndex] = Zip->GetFileContent(Entries[EntryIndex].Name, EntryBuffer.GetData(), EntryBuffer.Num());
+		});
+	const double ParallelTime = FPlatformTime::Seconds() - StartTime;
+	TestFalse(TEXT("Concurrent reads"), Results.Contains(false));
+
+	// the archive is never loaded: the memory only grows by the directory and the read buffers
+	const int64 PeakGrowth = PeakUsedPhysical - StartUsedPhysical;
+	TestTrue(TEXT("Peak memory"), PeakGrowth < ArchiveSize / 8);
+
+	AddInfo(FString::Printf(TEXT("%.2f GB archive, %d entries: open %.2f ms, sequential %.2f ms/entry (max %.2f ms), %.2f ms total parallel, peak memory growth %.2f MB"),
+		ArchiveSize / (1024.0 * 1024.0 * 1024.0), Entries.Num() * 2 + 1, OpenTime * 1000.0, SequentialTime * 1000.0 / Entries.Num(), MaxLatency * 1000.0, ParallelTime * 1000.0, PeakGrowth / (1024.0 * 1024.0)));
+
+	return true;
+}
+
+#endif
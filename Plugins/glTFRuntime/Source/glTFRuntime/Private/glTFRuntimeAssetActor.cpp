@@ -7,6 +7,7 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "Engine/StaticMeshSocket.h"
 #include "Animation/AnimSequence.h"
+#include "Misc/ScopeExit.h"
 #include "glTFRuntimeSkeletalMeshComponent.h"
 
 // Sets default values
@@ -39,6 +40,8 @@ void AglTFRuntimeAssetActor::BeginPlay()
 
 	double LoadingStartTime = FPlatformTime::Seconds();
 
+	TArray<FglTFRuntimeNode> RootNodes;
+	TArray<FglTFRuntimeScene> Scenes;
 	if (RootNodeIndex > INDEX_NONE)
 	{
 		FglTFRuntimeNode Node;
@@ -46,12 +49,52 @@ void AglTFRuntimeAssetActor::BeginPlay()
 		{
 			return;
 		}
+		RootNodes.Add(Node);
+	}
+	else
+	{
+		Scenes = Asset->GetScenes();
+		for (const FglTFRuntimeScene& Scene : Scenes)
+		{
+			for (const int32 NodeIndex : Scene.RootNodesIndices)
+			{
+				FglTFRuntimeNode Node;
+				if (Asset->GetNode(NodeIndex, Node))
+				{
+					RootNodes.Add(Node);
+				}
+			}
+		}
+	}
+
+	// decode the textures of the whole scene in parallel, instead of mesh by mesh while building the components
+	TArray<int32> StaticMeshesIndices;
+	TArray<int32> SkeletalMeshesIndices;
+	for (const FglTFRuntimeNode& Node : RootNodes)
+	{
+		GetNodeMeshes(Node, StaticMeshesIndices, SkeletalMeshesIndices);
+	}
+	if (StaticMeshesIndices.Num() > 0)
+	{
+		Asset->GetParser()->PrefetchMeshesTextures(StaticMeshesIndices, StaticMeshConfig.MaterialsConfig);
+	}
+	if (SkeletalMeshesIndices.Num() > 0)
+	{
+		Asset->GetParser()->PrefetchMeshesTextures(SkeletalMeshesIndices, SkeletalMeshConfig.MaterialsConfig);
+	}
+	ON_SCOPE_EXIT
+	{
+		StaticMeshConfig.MaterialsConfig.PrefetchedTextures.Reset();
+		SkeletalMeshConfig.MaterialsConfig.PrefetchedTextures.Reset();
+	};
+
+	if (RootNodeIndex > INDEX_NONE)
+	{
 		AssetRoot = nullptr;
-		ProcessNode(nullptr, NAME_None, Node);
+		ProcessNode(nullptr, NAME_None, RootNodes[0]);
 	}
 	else
 	{
-		TArray<FglTFRuntimeScene> Scenes = Asset->GetScenes();
 		for (FglTFRuntimeScene& Scene : Scenes)
 		{
 			USceneComponent* SceneComponent = NewObject<USceneComponent>(this, *FString::Printf(TEXT("Scene %d"), Scene.Index));
@@ -87,6 +130,47 @@ void AglTFRuntimeAssetActor::BeginPlay()
 	UE_LOG(LogGLTFRuntime, Log, TEXT("Asset loaded in %f seconds"), FPlatformTime::Seconds() - LoadingStartTime);
 }
 
+void AglTFRuntimeAssetActor::GetNodeMeshes(const FglTFRuntimeNode& Node, TArray<int32>& StaticMeshesIndices, TArray<int32>& SkeletalMeshesIndices)
+{
+	// same rules of ProcessNode: meshes of bones and of camera nodes are not loaded
+	const bool bIsBone = Asset->NodeIsBone(Node.Index);
+	if (!bIsBone && !(bAllowCameras && Node.CameraIndex != INDEX_NONE) && Node.MeshIndex > INDEX_NONE)
+	{
+		if (Node.SkinIndex < 0 && !bStaticMeshesAsSkeletal)
+		{
+			StaticMeshesIndices.AddUnique(Node.MeshIndex);
+
+			TArray<int32> LODNodeIndices;
+			if (Asset->GetNodeExtensionIndices(Node.Index, "MSFT_lod", "ids", LODNodeIndices))
+			{
+				for (const int32 LODNodeIndex : LODNodeIndices)
+				{
+					FglTFRuntimeNode LODNode;
+					if (!Asset->GetNode(LODNodeIndex, LODNode) || LODNode.MeshIndex <= INDEX_NONE)
+					{
+						break;
+					}
+					StaticMeshesIndices.AddUnique(LODNode.MeshIndex);
+				}
+			}
+		}
+		else
+		{
+			SkeletalMeshesIndices.AddUnique(Node.MeshIndex);
+		}
+	}
+
+	for (const int32 ChildIndex : Node.ChildrenIndices)
+	{
+		FglTFRuntimeNode Child;
+		if (!Asset->GetNode(ChildIndex, Child))
+		{
+			return;
+		}
+		GetNodeMeshes(Child, StaticMeshesIndices, SkeletalMeshesIndices);
+	}
+}
+
 void AglTFRuntimeAssetActor::ProcessNode(USceneComponent* NodeParentComponent, const FName SocketName, FglTFRuntimeNode& Node)
 {
 	// special case for bones/joints
@@ -17,6 +17,12 @@ AglTFRuntimeAssetActorAsync::AglTFRuntimeAssetActorAsync()
 
 	bShowWhileLoading = true;
 	bStaticMeshesAsSkeletal = false;
+	MaxConcurrentMeshes = 4;
+	MeshesCommitBudgetMs = 2;
+
+	MeshesInFlight = 0;
+	bLoadingMeshes = false;
+	CurrentPrimitiveComponent = nullptr;
 }
 
 // Called when the game starts or when spawned
@@ -49,7 +55,49 @@ void AglTFRuntimeAssetActorAsync::BeginPlay()
 		}
 	}
 
+	bLoadingMeshes = MeshesToLoad.Num() > 0;
+	LoadNextMeshAsync();
+}
+
+void AglTFRuntimeAssetActorAsync::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bLoadingMeshes)
+	{
+		return;
+	}
+
+	// assign the loaded meshes to their components, spreading the work over multiple frames
+	const double CommitStartTime = FPlatformTime::Seconds();
+	int32 NumCommitted = 0;
+	while (NumCommitted < LoadedMeshesToCommit.Num())
+	{
+		if (NumCommitted > 0 && MeshesCommitBudgetMs > 0 && (FPlatformTime::Seconds() - CommitStartTime) * 1000 >= MeshesCommitBudgetMs)
+		{
+			break;
+		}
+
+		const FglTFRuntimeAssetActorAsyncLoadedMesh& LoadedMesh = LoadedMeshesToCommit[NumCommitted++];
+		if (UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(LoadedMesh.PrimitiveComponent))
+		{
+			CommitStaticMesh(StaticMeshComponent, LoadedMesh.StaticMesh);
+		}
+		else if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(LoadedMesh.PrimitiveComponent))
+		{
+			CommitSkeletalMesh(SkeletalMeshComponent, LoadedMesh.SkeletalMesh);
+		}
+	}
+	LoadedMeshesToCommit.RemoveAt(0, NumCommitted);
+
 	LoadNextMeshAsync();
+
+	// trigger event
+	if (MeshesToLoad.Num() == 0 && MeshesInFlight == 0 && LoadedMeshesToCommit.Num() == 0)
+	{
+		bLoadingMeshes = false;
+		ScenesLoaded();
+	}
 }
 
 void AglTFRuntimeAssetActorAsync::ProcessNode(USceneComponent* NodeParentComponent, const FName SocketName, FglTFRuntimeNode& Node)
@@ -130,89 +178,99 @@ void AglTFRuntimeAssetActorAsync::ProcessNode(USceneComponent* NodeParentCompone
 
 void AglTFRuntimeAssetActorAsync::LoadNextMeshAsync()
 {
-	if (MeshesToLoad.Num() == 0)
+	if (!Asset || !Asset->GetParser())
 	{
 		return;
 	}
 
-	auto It = MeshesToLoad.CreateIterator();
-	if (UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(It->Key))
+	// static meshes are loaded concurrently, skeletal meshes share the skeleton caches so they are loaded exclusively
+	for (auto It = MeshesToLoad.CreateIterator(); It && !CurrentPrimitiveComponent && MeshesInFlight < FMath::Max(MaxConcurrentMeshes, 1); ++It)
 	{
-		CurrentPrimitiveComponent = StaticMeshComponent;
-		if (StaticMeshConfig.Outer == nullptr)
+		if (UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(It->Key))
 		{
-			StaticMeshConfig.Outer = StaticMeshComponent;
-		}
-		FglTFRuntimeStaticMeshAsync Delegate;
-		Delegate.BindDynamic(this, &AglTFRuntimeAssetActorAsync::LoadStaticMeshAsync);
-		Asset->LoadStaticMeshAsync(It->Value.MeshIndex, Delegate, StaticMeshConfig);
-	}
-	else if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(It->Key))
-	{
-		CurrentPrimitiveComponent = SkeletalMeshComponent;
-		FglTFRuntimeSkeletalMeshAsync Delegate;
-		Delegate.BindDynamic(this, &AglTFRuntimeAssetActorAsync::LoadSkeletalMeshAsync);
-		Asset->LoadSkeletalMeshAsync(It->Value.MeshIndex, It->Value.SkinIndex, Delegate, SkeletalMeshConfig);
-	}
-}
+			const int32 MeshIndex = It->Value.MeshIndex;
+			It.RemoveCurrent();
+			if (StaticMeshConfig.Outer == nullptr)
+			{
+				StaticMeshConfig.Outer = StaticMeshComponent;
+			}
 
-void AglTFRuntimeAssetActorAsync::LoadStaticMeshAsync(UStaticMesh* StaticMesh)
-{
-	if (UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(CurrentPrimitiveComponent))
-	{
-		DiscoveredStaticMeshComponents.Add(StaticMeshComponent, StaticMesh);
-		if (bShowWhileLoading)
-		{
-			StaticMeshComponent->SetStaticMesh(StaticMesh);
-		}
+			MeshesInFlight++;
+			TWeakObjectPtr<AglTFRuntimeAssetActorAsync> WeakThis(this);
+			TWeakObjectPtr<UStaticMeshComponent> WeakStaticMeshComponent(StaticMeshComponent);
+			Asset->GetParser()->LoadStaticMeshAsync(MeshIndex, [WeakThis, WeakStaticMeshComponent](UStaticMesh* StaticMesh)
+				{
+					if (!WeakThis.IsValid())
+					{
+						return;
+					}
 
-		if (StaticMesh && !StaticMeshConfig.ExportOriginalPivotToSocket.IsEmpty())
+					WeakThis->MeshesInFlight--;
+					FglTFRuntimeAssetActorAsyncLoadedMesh LoadedMesh;
+					LoadedMesh.PrimitiveComponent = WeakStaticMeshComponent.Get();
+					LoadedMesh.StaticMesh = StaticMesh;
+					WeakThis->LoadedMeshesToCommit.Add(LoadedMesh);
+				}, StaticMeshConfig);
+		}
+		else if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(It->Key))
 		{
-			UStaticMeshSocket* DeltaSocket = StaticMesh->FindSocket(FName(StaticMeshConfig.ExportOriginalPivotToSocket));
-			if (DeltaSocket)
+			if (MeshesInFlight > 0)
 			{
-				FTransform NewTransform = StaticMeshComponent->GetRelativeTransform();
-				FVector DeltaLocation = -DeltaSocket->RelativeLocation * NewTransform.GetScale3D();
-				DeltaLocation = NewTransform.GetRotation().RotateVector(DeltaLocation);
-				NewTransform.AddToTranslation(DeltaLocation);
-				StaticMeshComponent->SetRelativeTransform(NewTransform);
+				continue;
 			}
-		}
 
-	}
+			const int32 MeshIndex = It->Value.MeshIndex;
+			const int32 SkinIndex = It->Value.SkinIndex;
+			It.RemoveCurrent();
 
-	MeshesToLoad.Remove(CurrentPrimitiveComponent);
-	if (MeshesToLoad.Num() > 0)
-	{
-		LoadNextMeshAsync();
-	}
-	// trigger event
-	else
-	{
-		ScenesLoaded();
+			MeshesInFlight++;
+			CurrentPrimitiveComponent = SkeletalMeshComponent;
+			FglTFRuntimeSkeletalMeshAsync Delegate;
+			Delegate.BindDynamic(this, &AglTFRuntimeAssetActorAsync::LoadSkeletalMeshAsync);
+			Asset->LoadSkeletalMeshAsync(MeshIndex, SkinIndex, Delegate, SkeletalMeshConfig);
+		}
 	}
 }
 
 void AglTFRuntimeAssetActorAsync::LoadSkeletalMeshAsync(USkeletalMesh* SkeletalMesh)
 {
-	if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(CurrentPrimitiveComponent))
+	FglTFRuntimeAssetActorAsyncLoadedMesh LoadedMesh;
+	LoadedMesh.PrimitiveComponent = CurrentPrimitiveComponent;
+	LoadedMesh.SkeletalMesh = SkeletalMesh;
+	LoadedMeshesToCommit.Add(LoadedMesh);
+
+	MeshesInFlight--;
+	CurrentPrimitiveComponent = nullptr;
+}
+
+void AglTFRuntimeAssetActorAsync::CommitStaticMesh(UStaticMeshComponent* StaticMeshComponent, UStaticMesh* StaticMesh)
+{
+	DiscoveredStaticMeshComponents.Add(StaticMeshComponent, StaticMesh);
+	if (bShowWhileLoading)
 	{
-		DiscoveredSkeletalMeshComponents.Add(SkeletalMeshComponent, SkeletalMesh);
-		if (bShowWhileLoading)
-		{
-			SkeletalMeshComponent->SetSkeletalMesh(SkeletalMesh);
-		}
+		StaticMeshComponent->SetStaticMesh(StaticMesh);
 	}
 
-	MeshesToLoad.Remove(CurrentPrimitiveComponent);
-	if (MeshesToLoad.Num() > 0)
+	if (StaticMesh && !StaticMeshConfig.ExportOriginalPivotToSocket.IsEmpty())
 	{
-		LoadNextMeshAsync();
+		UStaticMeshSocket* DeltaSocket = StaticMesh->FindSocket(FName(StaticMeshConfig.ExportOriginalPivotToSocket));
+		if (DeltaSocket)
+		{
+			FTransform NewTransform = StaticMeshComponent->GetRelativeTransform();
+			FVector DeltaLocation = -DeltaSocket->RelativeLocation * NewTransform.GetScale3D();
+			DeltaLocation = NewTransform.GetRotation().RotateVector(DeltaLocation);
+			NewTransform.AddToTranslation(DeltaLocation);
+			StaticMeshComponent->SetRelativeTransform(NewTransform);
+		}
 	}
-	// trigger event
-	else
+}
+
+void AglTFRuntimeAssetActorAsync::CommitSkeletalMesh(USkeletalMeshComponent* SkeletalMeshComponent, USkeletalMesh* SkeletalMesh)
+{
+	DiscoveredSkeletalMeshComponents.Add(SkeletalMeshComponent, SkeletalMesh);
+	if (bShowWhileLoading)
 	{
-		ScenesLoaded();
+		SkeletalMeshComponent->SetSkeletalMesh(SkeletalMesh);
 	}
 }
 
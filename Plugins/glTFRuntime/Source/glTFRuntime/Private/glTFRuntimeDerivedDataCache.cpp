@@ -0,0 +1,310 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "glTFRuntimeDerivedDataCache.h"
+#include "glTFRuntimeParser.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/UniquePtr.h"
+
+namespace
+{
+	// bump it whenever the layout of a payload changes
+	constexpr uint32 DerivedDataVersion = 2;
+	constexpr uint32 DerivedDataMagic = 0x43444767; // gGDC
+
+	struct FglTFRuntimeDerivedDataHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint8 Key[20];
+		int64 PayloadNum;
+		uint64 PayloadSamplesHash;
+	};
+
+	// payloads shorter than all the samples together are fully hashed
+	constexpr int64 PayloadSampleSize = 4096;
+	constexpr int64 PayloadNumSamples = 16;
+
+	uint64 HashBytes(const uint8* Data, int64 Num)
+	{
+		uint64 Hash = Num;
+		// CityHash64 works on 32bit sizes
+		while (Num > 0)
+		{
+			const uint32 ChunkNum = static_cast<uint32>(FMath::Min<int64>(Num, MAX_uint32));
+			Hash = CityHash64WithSeed(reinterpret_cast<const char*>(Data), ChunkNum, Hash);
+			Data += ChunkNum;
+			Num -= ChunkNum;
+		}
+		return Hash;
+	}
+
+	// entries are moved in place only when completely written, so the header and the size already catch
+	// stale and truncated files: the samples (head, tail and evenly spaced blocks) catch most of the remaining corruptions
+	// without reading the whole mapped payload (that is what the cache is meant to avoid)
+	uint64 HashPayloadSamples(const uint8* Data, const int64 Num)
+	{
+		if (Num <= PayloadSampleSize * (PayloadNumSamples + 2))
+		{
+			return HashBytes(Data, Num);
+		}
+
+		uint64 Hash = HashBytes(Data, PayloadSampleSize);
+		const int64 SamplesStride = (Num - PayloadSampleSize) / (PayloadNumSamples + 1);
+		for (int64 SampleIndex = 1; SampleIndex <= PayloadNumSamples; SampleIndex++)
+		{
+			Hash = CityHash64WithSeed(reinterpret_cast<const char*>(Data + SampleIndex * SamplesStride), PayloadSampleSize, Hash);
+		}
+		return CityHash64WithSeed(reinterpret_cast<const char*>(Data + Num - PayloadSampleSize), PayloadSampleSize, Hash ^ Num);
+	}
+
+	struct FglTFRuntimeDerivedDataEntry
+	{
+		FString Filename;
+		int64 Size;
+		FDateTime TimeStamp;
+	};
+
+	int64 ScanEntries(const FString& Directory, TArray<FglTFRuntimeDerivedDataEntry>& Entries)
+	{
+		int64 TotalSize = 0;
+		IFileManager::Get().IterateDirectoryStat(*Directory, [&Entries, &TotalSize](const TCHAR* Filename, const FFileStatData& StatData)
+			{
+				if (!StatData.bIsDirectory && FPaths::GetExtension(Filename) == TEXT("gltfddc"))
+				{
+					FglTFRuntimeDerivedDataEntry Entry;
+					Entry.Filename = Filename;
+					Entry.Size = StatData.FileSize;
+					Entry.TimeStamp = StatData.ModificationTime;
+					Entries.Add(Entry);
+					TotalSize += StatData.FileSize;
+				}
+				return true;
+			});
+		return TotalSize;
+	}
+}
+
+FglTFRuntimeDerivedDataKey::FglTFRuntimeDerivedDataKey(const TCHAR* Kind)
+{
+	Update(DerivedDataVersion);
+	// payloads store raw vectors, so their precision must match
+	Update(static_cast<uint32>(sizeof(FVector)));
+	Update(FString(Kind));
+}
+
+void FglTFRuntimeDerivedDataKey::Update(const FString& Value)
+{
+	FTCHARToUTF8 Converter(*Value);
+	Update(Converter.Length());
+	Sha1.Update(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+}
+
+void FglTFRuntimeDerivedDataKey::UpdateBytes(const uint8* Data, const int64 Num)
+{
+	Update(HashBytes(Data, Num));
+}
+
+FSHAHash FglTFRuntimeDerivedDataKey::Finalize()
+{
+	FSHAHash Hash;
+	Sha1.Final();
+	Sha1.GetHash(Hash.Hash);
+	return Hash;
+}
+
+void FglTFRuntimeDerivedDataWriter::WriteString(const FString& Value)
+{
+	FTCHARToUTF8 Converter(*Value);
+	Write<int32>(Converter.Length());
+	Bytes.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+}
+
+bool FglTFRuntimeDerivedDataReader::ReadString(FString& Value)
+{
+	int32 Length = 0;
+	if (!Read(Length) || Length < 0 || Length > Num - Offset)
+	{
+		return false;
+	}
+
+	FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data + Offset), Length);
+	Value = FString(Converter.Length(), Converter.Get());
+	Offset += Length;
+	return true;
+}
+
+FglTFRuntimeDerivedDataCache::FglTFRuntimeDerivedDataCache(const FString& InDirectory, const int64 InMaxSize) : Directory(InDirectory), MaxSize(InMaxSize), TotalSize(INDEX_NONE)
+{
+}
+
+TSharedPtr<FglTFRuntimeDerivedDataCache> FglTFRuntimeDerivedDataCache::Get(const FString& Directory, const int64 MaxSize)
+{
+	static FCriticalSection InstancesLock;
+	static TMap<FString, TSharedPtr<FglTFRuntimeDerivedDataCache>> Instances;
+
+	FString FullDirectory = FPaths::IsRelative(Directory) ? FPaths::Combine(FPaths::ProjectSavedDir(), Directory) : Directory;
+	FullDirectory = FPaths::ConvertRelativePathToFull(FullDirectory);
+	FPaths::NormalizeDirectoryName(FullDirectory);
+
+	FScopeLock Lock(&InstancesLock);
+
+	if (TSharedPtr<FglTFRuntimeDerivedDataCache>* Instance = Instances.Find(FullDirectory))
+	{
+		(*Instance)->MaxSize = MaxSize;
+		return *Instance;
+	}
+
+	if (!IFileManager::Get().MakeDirectory(*FullDirectory, true))
+	{
+		UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to create derived data cache directory %s"), *FullDirectory);
+		return nullptr;
+	}
+
+	TSharedPtr<FglTFRuntimeDerivedDataCache> NewInstance = MakeShareable(new FglTFRuntimeDerivedDataCache(FullDirectory, MaxSize));
+	Instances.Add(FullDirectory, NewInstance);
+	return NewInstance;
+}
+
+FString FglTFRuntimeDerivedDataCache::GetEntryFilename(const FSHAHash& Key) const
+{
+	return FPaths::Combine(Directory, Key.ToString() + TEXT(".gltfddc"));
+}
+
+TSharedPtr<FglTFRuntimeMappedFile> FglTFRuntimeDerivedDataCache::Load(const FSHAHash& Key, const uint8*& PayloadData, int64& PayloadNum)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeDerivedDataCache_Load, FColor::Magenta);
+
+	const FString Filename = GetEntryFilename(Key);
+	if (IFileManager::Get().FileSize(*Filename) < static_cast<int64>(sizeof(FglTFRuntimeDerivedDataHeader)))
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FglTFRuntimeMappedFile> MappedFile = FglTFRuntimeMappedFile::Open(Filename);
+	if (!MappedFile || MappedFile->GetSize() < static_cast<int64>(sizeof(FglTFRuntimeDerivedDataHeader)))
+	{
+		return nullptr;
+	}
+
+	FglTFRuntimeDerivedDataHeader Header;
+	FMemory::Memcpy(&Header, MappedFile->GetData(), sizeof(FglTFRuntimeDerivedDataHeader));
+
+	const uint8* Data = MappedFile->GetData() + sizeof(FglTFRuntimeDerivedDataHeader);
+	const int64 Num = MappedFile->GetSize() - sizeof(FglTFRuntimeDerivedDataHeader);
+
+	// stale (older versions) or corrupted entries are just removed
+	if (Header.Magic != DerivedDataMagic || Header.Version != DerivedDataVersion ||
+		FMemory::Memcmp(Header.Key, Key.Hash, sizeof(Header.Key)) != 0 ||
+		Header.PayloadNum != Num || Header.PayloadSamplesHash != HashPayloadSamples(Data, Num))
+	{
+		UE_LOG(LogGLTFRuntime, Warning, TEXT("Removing invalid derived data cache entry %s"), *Filename);
+		const int64 EntrySize = MappedFile->GetSize();
+		MappedFile.Reset();
+		FScopeLock Lock(&TotalSizeLock);
+		if (IFileManager::Get().Delete(*Filename, false, false, true) && TotalSize != INDEX_NONE)
+		{
+			TotalSize -= EntrySize;
+		}
+		return nullptr;
+	}
+
+	// the modification time tracks the last usage for the LRU eviction
+	IFileManager::Get().SetTimeStamp(*Filename, FDateTime::UtcNow());
+
+	PayloadData = Data;
+	PayloadNum = Num;
+	return MappedFile;
+}
+
+bool FglTFRuntimeDerivedDataCache::Save(const FSHAHash& Key, const TArray64<uint8>& Payload)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeDerivedDataCache_Save, FColor::Magenta);
+
+	FglTFRuntimeDerivedDataHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = DerivedDataMagic;
+	Header.Version = DerivedDataVersion;
+	FMemory::Memcpy(Header.Key, Key.Hash, sizeof(Header.Key));
+	Header.PayloadNum = Payload.Num();
+	Header.PayloadSamplesHash = HashPayloadSamples(Payload.GetData(), Payload.Num());
+
+	// write to a temporary file and move it in place, so that concurrent readers never see partial entries
+	const FString Filename = GetEntryFilename(Key);
+	const FString TempFilename = Filename + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempFilename));
+		if (!Writer)
+		{
+			UE_LOG(LogGLTFRuntime, Warning, TEXT("Unable to write derived data cache entry %s"), *TempFilename);
+			return false;
+		}
+		Writer->Serialize(&Header, sizeof(FglTFRuntimeDerivedDataHeader));
+		Writer->Serialize(const_cast<uint8*>(Payload.GetData()), Payload.Num());
+		if (!Writer->Close())
+		{
+			Writer.Reset();
+			IFileManager::Get().Delete(*TempFilename, false, false, true);
+			return false;
+		}
+	}
+
+	// replacing an entry (concurrent loads of the same asset, or a corrupted entry) must not count it twice
+	FScopeLock Lock(&TotalSizeLock);
+	const int64 ReplacedSize = IFileManager::Get().FileSize(*Filename);
+	if (!IFileManager::Get().Move(*Filename, *TempFilename, true, true))
+	{
+		IFileManager::Get().Delete(*TempFilename, false, false, true);
+		return false;
+	}
+
+	if (TotalSize == INDEX_NONE)
+	{
+		TArray<FglTFRuntimeDerivedDataEntry> Entries;
+		TotalSize = ScanEntries(Directory, Entries);
+	}
+	else
+	{
+		TotalSize += sizeof(FglTFRuntimeDerivedDataHeader) + Payload.Num() - FMath::Max<int64>(ReplacedSize, 0);
+	}
+
+	if (MaxSize > 0 && TotalSize > MaxSize)
+	{
+		Evict();
+	}
+
+	return true;
+}
+
+int64 FglTFRuntimeDerivedDataCache::GetTotalSize()
+{
+	FScopeLock Lock(&TotalSizeLock);
+	return TotalSize;
+}
+
+void FglTFRuntimeDerivedDataCache::Evict()
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeDerivedDataCache_Evict, FColor::Magenta);
+
+	TArray<FglTFRuntimeDerivedDataEntry> Entries;
+	TotalSize = ScanEntries(Directory, Entries);
+
+	Entries.Sort([](const FglTFRuntimeDerivedDataEntry& A, const FglTFRuntimeDerivedDataEntry& B) { return A.TimeStamp < B.TimeStamp; });
+
+	for (const FglTFRuntimeDerivedDataEntry& Entry : Entries)
+	{
+		if (TotalSize <= MaxSize)
+		{
+			break;
+		}
+
+		// entries still mapped by a reader could be locked on some platforms
+		if (IFileManager::Get().Delete(*Entry.Filename, false, false, true))
+		{
+			TotalSize -= Entry.Size;
+		}
+	}
+}
@@ -0,0 +1,890 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "glTFRuntimeJsonTape.h"
+
+namespace
+{
+	constexpr int32 JsonTapeMaxDepth = 1024;
+
+	FORCEINLINE void SkipWhitespace(const uint8*& Ptr, const uint8* End)
+	{
+		while (Ptr < End && (*Ptr == ' ' || *Ptr == '\n' || *Ptr == '\r' || *Ptr == '\t'))
+		{
+			Ptr++;
+		}
+	}
+
+	FORCEINLINE bool MatchLiteral(const uint8*& Ptr, const uint8* End, const ANSICHAR* Literal, const int32 LiteralLen)
+	{
+		if (End - Ptr < LiteralLen || FMemory::Memcmp(Ptr, Literal, LiteralLen) != 0)
+		{
+			return false;
+		}
+		Ptr += LiteralLen;
+		return true;
+	}
+
+	bool ParseHex4(const uint8*& Ptr, const uint8* End, uint32& Value)
+	{
+		if (End - Ptr < 4)
+		{
+			return false;
+		}
+
+		Value = 0;
+		for (int32 Index = 0; Index < 4; Index++)
+		{
+			const uint8 Char = *Ptr++;
+			Value <<= 4;
+			if (Char >= '0' && Char <= '9')
+			{
+				Value |= Char - '0';
+			}
+			else if (Char >= 'a' && Char <= 'f')
+			{
+				Value |= Char - 'a' + 10;
+			}
+			else if (Char >= 'A' && Char <= 'F')
+			{
+				Value |= Char - 'A' + 10;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void AppendUTF8(TArray<ANSICHAR>& Strings, const uint32 CodePoint)
+	{
+		if (CodePoint < 0x80)
+		{
+			Strings.Add(static_cast<ANSICHAR>(CodePoint));
+		}
+		else if (CodePoint < 0x800)
+		{
+			Strings.Add(static_cast<ANSICHAR>(0xC0 | (CodePoint >> 6)));
+			Strings.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Strings.Add(static_cast<ANSICHAR>(0xE0 | (CodePoint >> 12)));
+			Strings.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Strings.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Strings.Add(static_cast<ANSICHAR>(0xF0 | (CodePoint >> 18)));
+			Strings.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Strings.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Strings.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+}
+
+TSharedPtr<FglTFRuntimeJsonTape> FglTFRuntimeJsonTape::FromUTF8(const uint8* DataPtr, const int64 DataNum)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeJsonTape_FromUTF8, FColor::Magenta);
+
+	if (!DataPtr || DataNum <= 0 || DataNum > MAX_int32)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FglTFRuntimeJsonTape> JsonTape = MakeShared<FglTFRuntimeJsonTape>();
+	if (!JsonTape->Parse(DataPtr, DataNum))
+	{
+		return nullptr;
+	}
+
+	return JsonTape;
+}
+
+TSharedPtr<FglTFRuntimeJsonTape> FglTFRuntimeJsonTape::FromString(const FString& JsonData)
+{
+	FTCHARToUTF8 Converter(*JsonData, JsonData.Len());
+	return FromUTF8(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+}
+
+TSharedRef<FglTFRuntimeJsonTape> FglTFRuntimeJsonTape::FromJsonObject(TSharedRef<FJsonObject> JsonObject)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeJsonTape_FromJsonObject, FColor::Magenta);
+
+	TSharedRef<FglTFRuntimeJsonTape> JsonTape = MakeShared<FglTFRuntimeJsonTape>();
+	JsonTape->AppendJsonObject(JsonObject);
+	JsonTape->ItemsStack.Empty();
+
+	return JsonTape;
+}
+
+void FglTFRuntimeJsonTape::AppendString(const FString& Value, int32& Offset, int32& Len)
+{
+	Offset = Strings.Num();
+	FTCHARToUTF8 Converter(*Value, Value.Len());
+	Strings.Append(Converter.Get(), Converter.Length());
+	Len = Converter.Length();
+}
+
+void FglTFRuntimeJsonTape::AppendJsonObject(const TSharedRef<FJsonObject>& JsonObject)
+{
+	const int32 NodeIndex = Nodes.AddUninitialized();
+
+	FNode Node;
+	Node.Number = 0;
+	Node.Num = JsonObject->Values.Num();
+	Node.Offset = 0;
+	Node.Type = ENodeType::Object;
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : JsonObject->Values)
+	{
+		FNode KeyNode;
+		KeyNode.Number = 0;
+		KeyNode.Type = ENodeType::String;
+		AppendString(Pair.Key, KeyNode.Offset, KeyNode.Num);
+		KeyNode.Next = Nodes.Num() + 1;
+		Nodes.Add(KeyNode);
+
+		AppendJsonValue(Pair.Value);
+	}
+
+	Node.Next = Nodes.Num();
+	Nodes[NodeIndex] = Node;
+}
+
+void FglTFRuntimeJsonTape::AppendJsonValue(const TSharedPtr<FJsonValue>& JsonValue)
+{
+	if (JsonValue && JsonValue->Type == EJson::Object && JsonValue->AsObject())
+	{
+		AppendJsonObject(JsonValue->AsObject().ToSharedRef());
+		return;
+	}
+
+	const int32 NodeIndex = Nodes.AddUninitialized();
+
+	FNode Node;
+	Node.Number = 0;
+	Node.Num = 0;
+	Node.Offset = 0;
+	Node.Type = ENodeType::Null;
+
+	if (JsonValue)
+	{
+		switch (JsonValue->Type)
+		{
+		case EJson::Boolean:
+			Node.Type = ENodeType::Boolean;
+			Node.Number = JsonValue->AsBool() ? 1 : 0;
+			break;
+		case EJson::Number:
+			Node.Type = ENodeType::Number;
+			JsonValue->TryGetNumber(Node.Number);
+			break;
+		case EJson::String:
+			Node.Type = ENodeType::String;
+			AppendString(JsonValue->AsString(), Node.Offset, Node.Num);
+			break;
+		case EJson::Array:
+		{
+			Node.Type = ENodeType::Array;
+			const TArray<TSharedPtr<FJsonValue>>& JsonItems = JsonValue->AsArray();
+			const int32 ItemsStackStart = ItemsStack.Num();
+			for (const TSharedPtr<FJsonValue>& JsonItem : JsonItems)
+			{
+				ItemsStack.Add(Nodes.Num());
+				AppendJsonValue(JsonItem);
+			}
+			Node.Num = ItemsStack.Num() - ItemsStackStart;
+			Node.Offset = Items.Num();
+			Items.Append(ItemsStack.GetData() + ItemsStackStart, Node.Num);
+			ItemsStack.RemoveAt(ItemsStackStart, Node.Num, false);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	Node.Next = Nodes.Num();
+	Nodes[NodeIndex] = Node;
+}
+
+bool FglTFRuntimeJsonTape::Parse(const uint8* DataPtr, const int64 DataNum)
+{
+	const uint8* Ptr = DataPtr;
+	const uint8* End = DataPtr + DataNum;
+
+	// UTF-8 BOM
+	if (DataNum >= 3 && Ptr[0] == 0xEF && Ptr[1] == 0xBB && Ptr[2] == 0xBF)
+	{
+		Ptr += 3;
+	}
+
+	// rough estimate to avoid most of the reallocations
+	Nodes.Reserve(static_cast<int32>(DataNum / 12) + 1);
+	Strings.Reserve(static_cast<int32>(DataNum / 4) + 1);
+
+	if (!ParseValue(Ptr, End, 0))
+	{
+		return false;
+	}
+
+	// allow whitespace and zero padding after the root value
+	while (Ptr < End && (*Ptr == ' ' || *Ptr == '\n' || *Ptr == '\r' || *Ptr == '\t' || *Ptr == 0))
+	{
+		Ptr++;
+	}
+
+	ItemsStack.Empty();
+
+	return Ptr == End;
+}
+
+bool FglTFRuntimeJsonTape::ParseValue(const uint8*& Ptr, const uint8* End, const int32 Depth)
+{
+	if (Depth > JsonTapeMaxDepth)
+	{
+		return false;
+	}
+
+	SkipWhitespace(Ptr, End);
+	if (Ptr >= End)
+	{
+		return false;
+	}
+
+	// children are appended after this node, so fill it only at the end
+	const int32 NodeIndex = Nodes.AddUninitialized();
+
+	FNode Node;
+	Node.Number = 0;
+	Node.Num = 0;
+	Node.Offset = 0;
+
+	switch (*Ptr)
+	{
+	case '{':
+		Node.Type = ENodeType::Object;
+		Ptr++;
+		SkipWhitespace(Ptr, End);
+		if (Ptr < End && *Ptr == '}')
+		{
+			Ptr++;
+			break;
+		}
+		for (;;)
+		{
+			SkipWhitespace(Ptr, End);
+			if (Ptr >= End || *Ptr != '"')
+			{
+				return false;
+			}
+
+			FNode KeyNode;
+			KeyNode.Number = 0;
+			KeyNode.Type = ENodeType::String;
+			if (!ParseString(Ptr, End, KeyNode.Offset, KeyNode.Num))
+			{
+				return false;
+			}
+			KeyNode.Next = Nodes.Num() + 1;
+			Nodes.Add(KeyNode);
+
+			SkipWhitespace(Ptr, End);
+			if (Ptr >= End || *Ptr != ':')
+			{
+				return false;
+			}
+			Ptr++;
+
+			if (!ParseValue(Ptr, End, Depth + 1))
+			{
+				return false;
+			}
+			Node.Num++;
+
+			SkipWhitespace(Ptr, End);
+			if (Ptr >= End)
+			{
+				return false;
+			}
+			if (*Ptr == ',')
+			{
+				Ptr++;
+				continue;
+			}
+			if (*Ptr == '}')
+			{
+				Ptr++;
+				break;
+			}
+			return false;
+		}
+		break;
+	case '[':
+	{
+		Node.Type = ENodeType::Array;
+		Ptr++;
+		const int32 ItemsStackStart = ItemsStack.Num();
+		SkipWhitespace(Ptr, End);
+		if (Ptr < End && *Ptr == ']')
+		{
+			Ptr++;
+		}
+		else
+		{
+			for (;;)
+			{
+				ItemsStack.Add(Nodes.Num());
+				if (!ParseValue(Ptr, End, Depth + 1))
+				{
+					return false;
+				}
+
+				SkipWhitespace(Ptr, End);
+				if (Ptr >= End)
+				{
+					return false;
+				}
+				if (*Ptr == ',')
+				{
+					Ptr++;
+					continue;
+				}
+				if (*Ptr == ']')
+				{
+					Ptr++;
+					break;
+				}
+				return false;
+			}
+		}
+		Node.Num = ItemsStack.Num() - ItemsStackStart;
+		Node.Offset = Items.Num();
+		Items.Append(ItemsStack.GetData() + ItemsStackStart, Node.Num);
+		ItemsStack.RemoveAt(ItemsStackStart, Node.Num, false);
+		break;
+	}
+	case '"':
+		Node.Type = ENodeType::String;
+		if (!ParseString(Ptr, End, Node.Offset, Node.Num))
+		{
+			return false;
+		}
+		break;
+	case 't':
+		Node.Type = ENodeType::Boolean;
+		Node.Number = 1;
+		if (!MatchLiteral(Ptr, End, "true", 4))
+		{
+			return false;
+		}
+		break;
+	case 'f':
+		Node.Type = ENodeType::Boolean;
+		if (!MatchLiteral(Ptr, End, "false", 5))
+		{
+			return false;
+		}
+		break;
+	case 'n':
+		Node.Type = ENodeType::Null;
+		if (!MatchLiteral(Ptr, End, "null", 4))
+		{
+			return false;
+		}
+		break;
+	default:
+		Node.Type = ENodeType::Number;
+		if (!ParseNumber(Ptr, End, Node.Number))
+		{
+			return false;
+		}
+		break;
+	}
+
+	Node.Next = Nodes.Num();
+	Nodes[NodeIndex] = Node;
+
+	return true;
+}
+
+bool FglTFRuntimeJsonTape::ParseString(const uint8*& Ptr, const uint8* End, int32& Offset, int32& Len)
+{
+	// skip the opening quote
+	Ptr++;
+
+	Offset = Strings.Num();
+
+	for (;;)
+	{
+		const uint8* Start = Ptr;
+		while (Ptr < End && *Ptr != '"' && *Ptr != '\\')
+		{
+			Ptr++;
+		}
+
+		if (Ptr >= End)
+		{
+			return false;
+		}
+
+		Strings.Append(reinterpret_cast<const ANSICHAR*>(Start), static_cast<int32>(Ptr - Start));
+
+		if (*Ptr++ == '"')
+		{
+			break;
+		}
+
+		if (Ptr >= End)
+		{
+			return false;
+		}
+
+		switch (*Ptr++)
+		{
+		case '"':
+			Strings.Add('"');
+			break;
+		case '\\':
+			Strings.Add('\\');
+			break;
+		case '/':
+			Strings.Add('/');
+			break;
+		case 'b':
+			Strings.Add('\b');
+			break;
+		case 'f':
+			Strings.Add('\f');
+			break;
+		case 'n':
+			Strings.Add('\n');
+			break;
+		case 'r':
+			Strings.Add('\r');
+			break;
+		case 't':
+			Strings.Add('\t');
+			break;
+		case 'u':
+		{
+			uint32 CodePoint;
+			if (!ParseHex4(Ptr, End, CodePoint))
+			{
+				return false;
+			}
+			// surrogate pair ?
+			if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && End - Ptr >= 6 && Ptr[0] == '\\' && Ptr[1] == 'u')
+			{
+				const uint8* LowPtr = Ptr + 2;
+				uint32 LowSurrogate;
+				if (ParseHex4(LowPtr, End, LowSurrogate) && LowSurrogate >= 0xDC00 && LowSurrogate <= 0xDFFF)
+				{
+					CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+					Ptr = LowPtr;
+				}
+			}
+			AppendUTF8(Strings, CodePoint);
+			break;
+		}
+		default:
+			return false;
+		}
+	}
+
+	Len = Strings.Num() - Offset;
+	return true;
+}
+
+bool FglTFRuntimeJsonTape::ParseNumber(const uint8*& Ptr, const uint8* End, double& Number)
+{
+	const uint8* Start = Ptr;
+
+	const bool bNegative = *Ptr == '-';
+	if (bNegative)
+	{
+		Ptr++;
+	}
+
+	// integers (the vast majority of glTF numbers) do not need strtod
+	int64 Integer = 0;
+	int32 Digits = 0;
+	while (Ptr < End && *Ptr >= '0' && *Ptr <= '9')
+	{
+		if (Digits < 16)
+		{
+			Integer = Integer * 10 + (*Ptr - '0');
+		}
+		Digits++;
+		Ptr++;
+	}
+
+	if (Digits == 0)
+	{
+		return false;
+	}
+
+	bool bInteger = true;
+	while (Ptr < End && ((*Ptr >= '0' && *Ptr <= '9') || *Ptr == '.' || *Ptr == 'e' || *Ptr == 'E' || *Ptr == '+' || *Ptr == '-'))
+	{
+		bInteger = false;
+		Ptr++;
+	}
+
+	if (bInteger && Digits <= 15)
+	{
+		Number = static_cast<double>(bNegative ? -Integer : Integer);
+		return true;
+	}
+
+	ANSICHAR Buffer[128];
+	const int64 NumberLen = Ptr - Start;
+	if (NumberLen >= static_cast<int64>(UE_ARRAY_COUNT(Buffer)))
+	{
+		return false;
+	}
+	FMemory::Memcpy(Buffer, Start, NumberLen);
+	Buffer[NumberLen] = 0;
+
+	Number = FCStringAnsi::Atod(Buffer);
+	return true;
+}
+
+FString FglTFRuntimeJsonTape::GetString(const FNode& Node) const
+{
+	if (Node.Num == 0)
+	{
+		return FString();
+	}
+
+	FUTF8ToTCHAR Converter(Strings.GetData() + Node.Offset, Node.Num);
+	return FString(Converter.Length(), Converter.Get());
+}
+
+int32 FglTFRuntimeJsonTape::GetArrayNum(const int32 ArrayNode) const
+{
+	if (!Nodes.IsValidIndex(ArrayNode) || Nodes[ArrayNode].Type != ENodeType::Array)
+	{
+		return 0;
+	}
+	return Nodes[ArrayNode].Num;
+}
+
+int32 FglTFRuntimeJsonTape::GetArrayItem(const int32 ArrayNode, const int32 Index) const
+{
+	if (Index < 0 || Index >= GetArrayNum(ArrayNode))
+	{
+		return INDEX_NONE;
+	}
+	return Items[Nodes[ArrayNode].Offset + Index];
+}
+
+int32 FglTFRuntimeJsonTape::FindField(const int32 ObjectNode, const ANSICHAR* FieldName) const
+{
+	if (!Nodes.IsValidIndex(ObjectNode) || Nodes[ObjectNode].Type != ENodeType::Object)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 FieldNameLen = FCStringAnsi::Strlen(FieldName);
+
+	// keep scanning after a match, FJsonObject keeps the last value of a duplicated key
+	int32 ValueNode = INDEX_NONE;
+	int32 KeyNode = ObjectNode + 1;
+	for (int32 FieldIndex = 0; FieldIndex < Nodes[ObjectNode].Num; FieldIndex++)
+	{
+		const FNode& Key = Nodes[KeyNode];
+		if (Key.Num == FieldNameLen && FMemory::Memcmp(Strings.GetData() + Key.Offset, FieldName, FieldNameLen) == 0)
+		{
+			ValueNode = KeyNode + 1;
+		}
+		KeyNode = Nodes[KeyNode + 1].Next;
+	}
+
+	return ValueNode;
+}
+
+int32 FglTFRuntimeJsonTape::GetObjectField(const int32 ObjectNode, const ANSICHAR* FieldName) const
+{
+	const int32 ValueNode = FindField(ObjectNode, FieldName);
+	return IsObject(ValueNode) ? ValueNode : INDEX_NONE;
+}
+
+int32 FglTFRuntimeJsonTape::GetArrayField(const int32 ObjectNode, const ANSICHAR* FieldName) const
+{
+	const int32 ValueNode = FindField(ObjectNode, FieldName);
+	return IsArray(ValueNode) ? ValueNode : INDEX_NONE;
+}
+
+void FglTFRuntimeJsonTape::ForEachField(const int32 ObjectNode, TFunctionRef<void(const FString& FieldName, const int32 ValueNode)> Callback) const
+{
+	if (!Nodes.IsValidIndex(ObjectNode) || Nodes[ObjectNode].Type != ENodeType::Object)
+	{
+		return;
+	}
+
+	int32 KeyNode = ObjectNode + 1;
+	for (int32 FieldIndex = 0; FieldIndex < Nodes[ObjectNode].Num; FieldIndex++)
+	{
+		Callback(GetString(Nodes[KeyNode]), KeyNode + 1);
+		KeyNode = Nodes[KeyNode + 1].Next;
+	}
+}
+
+bool FglTFRuntimeJsonTape::TryGetNumber(const int32 Node, double& Value) const
+{
+	if (!Nodes.IsValidIndex(Node))
+	{
+		return false;
+	}
+
+	switch (Nodes[Node].Type)
+	{
+	case ENodeType::Boolean:
+	case ENodeType::Number:
+		Value = Nodes[Node].Number;
+		return true;
+	case ENodeType::String:
+	{
+		const FString String = GetString(Nodes[Node]);
+		if (String.IsNumeric())
+		{
+			Value = FCString::Atod(*String);
+			return true;
+		}
+		return false;
+	}
+	default:
+		break;
+	}
+
+	return false;
+}
+
+bool FglTFRuntimeJsonTape::TryGetNumber(const int32 Node, float& Value) const
+{
+	double Number;
+	if (!TryGetNumber(Node, Number))
+	{
+		return false;
+	}
+	Value = static_cast<float>(Number);
+	return true;
+}
+
+bool FglTFRuntimeJsonTape::TryGetNumber(const int32 Node, int32& Value) const
+{
+	double Number;
+	if (!TryGetNumber(Node, Number) || Number < static_cast<double>(MIN_int32) || Number > static_cast<double>(MAX_int32))
+	{
+		return false;
+	}
+	Value = static_cast<int32>(FMath::RoundHalfFromZero(Number));
+	return true;
+}
+
+bool FglTFRuntimeJsonTape::TryGetNumber(const int32 Node, int64& Value) const
+{
+	double Number;
+	if (!TryGetNumber(Node, Number) || Number < static_cast<double>(MIN_int64) || Number > static_cast<double>(MAX_int64))
+	{
+		return false;
+	}
+	Value = static_cast<int64>(FMath::RoundHalfFromZero(Number));
+	return true;
+}
+
+bool FglTFRuntimeJsonTape::TryGetBool(const int32 Node, bool& Value) const
+{
+	if (!Nodes.IsValidIndex(Node))
+	{
+		return false;
+	}
+
+	switch (Nodes[Node].Type)
+	{
+	case ENodeType::Boolean:
+	case ENodeType::Number:
+		Value = Nodes[Node].Number != 0;
+		return true;
+	case ENodeType::String:
+		Value = GetString(Nodes[Node]).ToBool();
+		return true;
+	default:
+		break;
+	}
+
+	return false;
+}
+
+bool FglTFRuntimeJsonTape::TryGetString(const int32 Node, FString& Value) const
+{
+	if (!Nodes.IsValidIndex(Node))
+	{
+		return false;
+	}
+
+	switch (Nodes[Node].Type)
+	{
+	case ENodeType::Boolean:
+		Value = Nodes[Node].Number != 0 ? TEXT("true") : TEXT("false");
+		return true;
+	case ENodeType::Number:
+		Value = FString::SanitizeFloat(Nodes[Node].Number, 0);
+		return true;
+	case ENodeType::String:
+		Value = GetString(Nodes[Node]);
+		return true;
+	default:
+		break;
+	}
+
+	return false;
+}
+
+bool FglTFRuntimeJsonTape::TryGetNumbers(const int32 ArrayNode, double* Values, const int32 ValuesNum) const
+{
+	if (!IsArray(ArrayNode) || GetArrayNum(ArrayNode) != ValuesNum)
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < ValuesNum; Index++)
+	{
+		if (!TryGetNumber(GetArrayItem(ArrayNode, Index), Values[Index]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FglTFRuntimeJsonTape::TryGetBoolField(const int32 ObjectNode, const ANSICHAR* FieldName, bool& Value) const
+{
+	return TryGetBool(FindField(ObjectNode, FieldName), Value);
+}
+
+bool FglTFRuntimeJsonTape::TryGetStringField(const int32 ObjectNode, const ANSICHAR* FieldName, FString& Value) const
+{
+	return TryGetString(FindField(ObjectNode, FieldName), Value);
+}
+
+bool FglTFRuntimeJsonTape::TryGetStringArrayField(const int32 ObjectNode, const ANSICHAR* FieldName, TArray<FString>& Values) const
+{
+	const int32 ArrayNode = FindField(ObjectNode, FieldName);
+	if (!Nodes.IsValidIndex(ArrayNode) || Nodes[ArrayNode].Type != ENodeType::Array)
+	{
+		return false;
+	}
+
+	const int32 ItemsNum = GetArrayNum(ArrayNode);
+	for (int32 Index = 0; Index < ItemsNum; Index++)
+	{
+		FString Value;
+		if (!TryGetString(GetArrayItem(ArrayNode, Index), Value))
+		{
+			return false;
+		}
+		Values.Add(Value);
+	}
+
+	return true;
+}
+
+int64 FglTFRuntimeJsonTape::GetIndexField(const int32 ObjectNode, const ANSICHAR* FieldName, const int64 DefaultValue) const
+{
+	int64 Value;
+	if (!TryGetNumberField(ObjectNode, FieldName, Value))
+	{
+		return DefaultValue;
+	}
+	return Value;
+}
+
+FString FglTFRuntimeJsonTape::GetStringField(const int32 ObjectNode, const ANSICHAR* FieldName, const FString& DefaultValue) const
+{
+	FString Value;
+	if (!TryGetStringField(ObjectNode, FieldName, Value))
+	{
+		return DefaultValue;
+	}
+	return Value;
+}
+
+TSharedPtr<FJsonValue> FglTFRuntimeJsonTape::ToJsonValue(const int32 Node) const
+{
+	if (!Nodes.IsValidIndex(Node))
+	{
+		return nullptr;
+	}
+
+	switch (Nodes[Node].Type)
+	{
+	case ENodeType::Boolean:
+		return MakeShared<FJsonValueBoolean>(Nodes[Node].Number != 0);
+	case ENodeType::Number:
+		return MakeShared<FJsonValueNumber>(Nodes[Node].Number);
+	case ENodeType::String:
+		return MakeShared<FJsonValueString>(GetString(Nodes[Node]));
+	case ENodeType::Array:
+	{
+		TArray<TSharedPtr<FJsonValue>> JsonValues;
+		JsonValues.Reserve(Nodes[Node].Num);
+		for (int32 Index = 0; Index < Nodes[Node].Num; Index++)
+		{
+			JsonValues.Add(ToJsonValue(Items[Nodes[Node].Offset + Index]));
+		}
+		return MakeShared<FJsonValueArray>(JsonValues);
+	}
+	case ENodeType::Object:
+		return MakeShared<FJsonValueObject>(ToJsonObject(Node));
+	default:
+		break;
+	}
+
+	return MakeShared<FJsonValueNull>();
+}
+
+TSharedPtr<FJsonObject> FglTFRuntimeJsonTape::ToJsonObject(const int32 Node) const
+{
+	if (!Nodes.IsValidIndex(Node) || Nodes[Node].Type != ENodeType::Object)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->Values.Reserve(Nodes[Node].Num);
+
+	ForEachField(Node, [this, JsonObject](const FString& FieldName, const int32 ValueNode)
+		{
+			JsonObject->Values.Add(FieldName, ToJsonValue(ValueNode));
+		});
+
+	return JsonObject;
+}
+
+void FglTFRuntimeJsonTape::AppendNodeBytes(const int32 Node, TArray<uint8>& Bytes) const
+{
+	if (!Nodes.IsValidIndex(Node))
+	{
+		return;
+	}
+
+	// children always follow their container, so the subtree is a contiguous range of nodes
+	for (int32 NodeIndex = Node; NodeIndex < Nodes[Node].Next; NodeIndex++)
+	{
+		const FNode& CurrentNode = Nodes[NodeIndex];
+		Bytes.Add(static_cast<uint8>(CurrentNode.Type));
+		Bytes.Append(reinterpret_cast<const uint8*>(&CurrentNode.Num), sizeof(CurrentNode.Num));
+		if (CurrentNode.Type == ENodeType::Number || CurrentNode.Type == ENodeType::Boolean)
+		{
+			Bytes.Append(reinterpret_cast<const uint8*>(&CurrentNode.Number), sizeof(CurrentNode.Number));
+		}
+		else if (CurrentNode.Type == ENodeType::String)
+		{
+			Bytes.Append(reinterpret_cast<const uint8*>(Strings.GetData() + CurrentNode.Offset), CurrentNode.Num);
+		}
+	}
+}
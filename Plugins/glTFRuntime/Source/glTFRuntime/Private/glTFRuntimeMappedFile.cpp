@@ -0,0 +1,51 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "glTFRuntimeMappedFile.h"
+#include "glTFRuntimeParser.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+
+FglTFRuntimeMappedFile::~FglTFRuntimeMappedFile()
+{
+	MappedFileRegion.Reset();
+	MappedFileHandle.Reset();
+}
+
+TSharedPtr<FglTFRuntimeMappedFile> FglTFRuntimeMappedFile::Open(const FString& Filename)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeMappedFile_Open, FColor::Magenta);
+
+	TUniquePtr<IMappedFileHandle> MappedFileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (!MappedFileHandle.IsValid() || MappedFileHandle->GetFileSize() <= 0)
+	{
+		UE_LOG(LogGLTFRuntime, Verbose, TEXT("Unable to memory map file %s"), *Filename);
+		return nullptr;
+	}
+
+	TUniquePtr<IMappedFileRegion> MappedFileRegion(MappedFileHandle->MapRegion(0, MappedFileHandle->GetFileSize()));
+	if (!MappedFileRegion.IsValid() || !MappedFileRegion->GetMappedPtr())
+	{
+		UE_LOG(LogGLTFRuntime, Verbose, TEXT("Unable to map region of file %s"), *Filename);
+		return nullptr;
+	}
+
+	TSharedPtr<FglTFRuntimeMappedFile> MappedFile = MakeShareable(new FglTFRuntimeMappedFile());
+	MappedFile->MappedFileHandle = MoveTemp(MappedFileHandle);
+	MappedFile->MappedFileRegion = MoveTemp(MappedFileRegion);
+	return MappedFile;
+}
+
+const uint8* FglTFRuntimeMappedFile::GetData() const
+{
+	return MappedFileRegion->GetMappedPtr();
+}
+
+int64 FglTFRuntimeMappedFile::GetSize() const
+{
+	return MappedFileRegion->GetMappedSize();
+}
+
+bool FglTFRuntimeMappedFile::Contains(const uint8* DataPtr, const int64 DataNum) const
+{
+	return DataPtr >= GetData() && DataNum >= 0 && DataPtr + DataNum <= GetData() + GetSize();
+}
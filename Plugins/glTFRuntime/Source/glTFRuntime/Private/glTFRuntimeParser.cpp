@@ -2,11 +2,13 @@
 
 #include "glTFRuntimeParser.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Engine/Texture2D.h"
 #include "Misc/FileHelper.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "Animation/Skeleton.h"
 #include "Materials/Material.h"
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 2
@@ -15,17 +17,278 @@
 #include "MaterialShared.h"
 #endif
 #include "Misc/Base64.h"
-#include "Misc/Compression.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/ScopeLock.h"
 #include "Interfaces/IPluginManager.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 2
 #include "RenderMath.h"
 #else
 #include "RenderUtils.h"
 #endif
 
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
 DEFINE_LOG_CATEGORY(LogGLTFRuntime);
 
+namespace
+{
+	template<typename IndexType>
+	void DecodeIndicesWithStride(const uint8* Data, const int64 Stride, const int64 Count, uint32* Indices)
+	{
+		// tightly packed indices (the common case) are widened by the vectorized kernels
+		if (Stride == sizeof(IndexType))
+		{
+			FglTFRuntimeParser::DecodeIndices(reinterpret_cast<const IndexType*>(Data), Count, Indices);
+			return;
+		}
+
+		for (int64 i = 0; i < Count; i++)
+		{
+			Indices[i] = *reinterpret_cast<const IndexType*>(Data + i * Stride);
+		}
+	}
+
+	// true for the first frame (and all of the following ones, as the timeline is sorted) matching or following WantedTime
+	FORCEINLINE bool IsFrameReached(const TArray<float>& FramesTimes, const int32 Index, const float WantedTime)
+	{
+		const float TimeValue = FramesTimes[Index] - FramesTimes[0];
+		return FMath::IsNearlyEqual(TimeValue, WantedTime) || TimeValue > WantedTime;
+	}
+
+	// zip structures are little endian and not aligned
+	FORCEINLINE uint16 ZipUInt16(const uint8* Data)
+	{
+		return Data[0] | (Data[1] << 8);
+	}
+
+	FORCEINLINE uint32 ZipUInt32(const uint8* Data)
+	{
+		return ZipUInt16(Data) | (static_cast<uint32>(ZipUInt16(Data + 2)) << 16);
+	}
+
+	FORCEINLINE uint64 ZipUInt64(const uint8* Data)
+	{
+		return ZipUInt32(Data) | (static_cast<uint64>(ZipUInt32(Data + 4)) << 32);
+	}
+
+	template<typename T>
+	void WriteArrays(FglTFRuntimeDerivedDataWriter& Writer, const TArray<TArray<T>>& Arrays)
+	{
+		Writer.Write<int32>(Arrays.Num());
+		for (const TArray<T>& Array : Arrays)
+		{
+			Writer.WriteArray(Array);
+		}
+	}
+
+	template<typename T>
+	bool ReadArrays(FglTFRuntimeDerivedDataReader& Reader, TArray<TArray<T>>& Arrays)
+	{
+		int32 ArraysNum = 0;
+		if (!Reader.Read(ArraysNum) || ArraysNum < 0)
+		{
+			return false;
+		}
+		Arrays.SetNum(ArraysNum);
+		for (TArray<T>& Array : Arrays)
+		{
+			if (!Reader.ReadArray(Array))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// only the decoded geometry is cached, materials are always resolved by LoadPrimitive
+	void WritePrimitiveGeometry(FglTFRuntimeDerivedDataWriter& Writer, const FglTFRuntimePrimitive& Primitive)
+	{
+		Writer.Write(Primitive.Mode);
+		Writer.Write(Primitive.bHighPrecisionUVs);
+		Writer.Write(Primitive.bHighPrecisionWeights);
+		Writer.WriteArray(Primitive.Positions);
+		Writer.WriteArray(Primitive.Normals);
+		Writer.WriteArray(Primitive.Tangents);
+		WriteArrays(Writer, Primitive.UVs);
+		Writer.WriteArray(Primitive.Indices);
+		WriteArrays(Writer, Primitive.Joints);
+		WriteArrays(Writer, Primitive.Weights);
+		Writer.WriteArray(Primitive.Colors);
+		Writer.Write<int32>(Primitive.MorphTargets.Num());
+		for (const FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
+		{
+			Writer.WriteString(MorphTarget.Name);
+			Writer.WriteArray(MorphTarget.Positions);
+			Writer.WriteArray(MorphTarget.Normals);
+		}
+	}
+
+	bool ReadPrimitiveGeometry(FglTFRuntimeDerivedDataReader& Reader, FglTFRuntimePrimitive& Primitive)
+	{
+		int32 MorphTargetsNum = 0;
+		if (!Reader.Read(Primitive.Mode) ||
+			!Reader.Read(Primitive.bHighPrecisionUVs) ||
+			!Reader.Read(Primitive.bHighPrecisionWeights) ||
+			!Reader.ReadArray(Primitive.Positions) ||
+			!Reader.ReadArray(Primitive.Normals) ||
+			!Reader.ReadArray(Primitive.Tangents) ||
+			!ReadArrays(Reader, Primitive.UVs) ||
+			!Reader.ReadArray(Primitive.Indices) ||
+			!ReadArrays(Reader, Primitive.Joints) ||
+			!ReadArrays(Reader, Primitive.Weights) ||
+			!Reader.ReadArray(Primitive.Colors) ||
+			!Reader.Read(MorphTargetsNum) || MorphTargetsNum < 0)
+		{
+			return false;
+		}
+
+		Primitive.MorphTargets.SetNum(MorphTargetsNum);
+		for (FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
+		{
+			if (!Reader.ReadString(MorphTarget.Name) || !Reader.ReadArray(MorphTarget.Positions) || !Reader.ReadArray(MorphTarget.Normals))
+			{
+				return false;
+			}
+		}
+
+		return Reader.Offset == Reader.Num;
+	}
+}
+
+/**
+ * Inflates the raw deflate payload of an in-memory gzip file on demand, straight into caller provided buffers.
+ * The trailer (CRC32 and size) is checked by Finish() once all of the expected data has been read.
+ */
+class FglTFRuntimeGzipStream
+{
+public:
+	FglTFRuntimeGzipStream(const uint8* InCompressedData, const int64 InCompressedNum, const uint32 InExpectedCrc32, const uint32 InExpectedNum) :
+		CompressedData(InCompressedData), CompressedNum(InCompressedNum), CompressedOffset(0), ExpectedCrc32(InExpectedCrc32), ExpectedNum(InExpectedNum), Crc32(crc32(0, nullptr, 0)), UncompressedNum(0), bFinished(false)
+	{
+		FMemory::Memzero(Stream);
+		bError = inflateInit2(&Stream, -MAX_WBITS) != Z_OK;
+		bInitialized = !bError;
+	}
+
+	~FglTFRuntimeGzipStream()
+	{
+		if (bInitialized)
+		{
+			inflateEnd(&Stream);
+		}
+	}
+
+	bool Read(uint8* OutData, int64 Num)
+	{
+		while (Num > 0)
+		{
+			int64 InflatedNum = 0;
+			if (bFinished || !Inflate(OutData, Num, InflatedNum))
+			{
+				bError = true;
+				return false;
+			}
+			OutData += InflatedNum;
+			Num -= InflatedNum;
+		}
+		return true;
+	}
+
+	bool Skip(int64 Num)
+	{
+		uint8 Scratch[4096];
+		while (Num > 0)
+		{
+			const int64 ReadNum = FMath::Min<int64>(Num, sizeof(Scratch));
+			if (!Read(Scratch, ReadNum))
+			{
+				return false;
+			}
+			Num -= ReadNum;
+		}
+		return true;
+	}
+
+	bool Finish()
+	{
+		// the end of the stream could still be pending, any further byte means a wrong trailer
+		while (!bFinished && !bError)
+		{
+			uint8 Extra = 0;
+			int64 InflatedNum = 0;
+			if (!Inflate(&Extra, 1, InflatedNum) || InflatedNum > 0)
+			{
+				bError = true;
+			}
+		}
+
+		if (!bError && (Crc32 != ExpectedCrc32 || static_cast<uint32>(UncompressedNum) != ExpectedNum))
+		{
+			bError = true;
+		}
+		return !bError;
+	}
+
+	bool HasError() const
+	{
+		return bError;
+	}
+
+protected:
+	bool Inflate(uint8* OutData, const int64 Num, int64& InflatedNum)
+	{
+		if (bError)
+		{
+			return false;
+		}
+
+		if (Stream.avail_in == 0)
+		{
+			const int64 InputNum = FMath::Min<int64>(MAX_uint32, CompressedNum - CompressedOffset);
+			if (InputNum <= 0)
+			{
+				return false;
+			}
+			Stream.next_in = const_cast<Bytef*>(CompressedData + CompressedOffset);
+			Stream.avail_in = static_cast<uInt>(InputNum);
+			CompressedOffset += InputNum;
+		}
+
+		const int64 OutputNum = FMath::Min<int64>(MAX_uint32, Num);
+		Stream.next_out = OutData;
+		Stream.avail_out = static_cast<uInt>(OutputNum);
+
+		const int32 Result = inflate(&Stream, Z_NO_FLUSH);
+		if (Result != Z_OK && Result != Z_STREAM_END)
+		{
+			return false;
+		}
+
+		InflatedNum = OutputNum - Stream.avail_out;
+		Crc32 = crc32(Crc32, OutData, static_cast<uInt>(InflatedNum));
+		UncompressedNum += InflatedNum;
+		bFinished = Result == Z_STREAM_END;
+		return true;
+	}
+
+	z_stream Stream;
+	const uint8* CompressedData;
+	int64 CompressedNum;
+	int64 CompressedOffset;
+	uint32 ExpectedCrc32;
+	uint32 ExpectedNum;
+	uLong Crc32;
+	int64 UncompressedNum;
+	bool bFinished;
+	bool bError;
+	bool bInitialized;
+};
+
 FglTFRuntimeOnPreLoadedPrimitive FglTFRuntimeParser::OnPreLoadedPrimitive;
 FglTFRuntimeOnLoadedPrimitive FglTFRuntimeParser::OnLoadedPrimitive;
 FglTFRuntimeOnLoadedRefSkeleton FglTFRuntimeParser::OnLoadedRefSkeleton;
@@ -75,14 +338,33 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromFilename(const FString& F
 		}
 	}
 
-	TArray64<uint8> Content;
-	if (!FFileHelper::LoadFileToArray(Content, *TruePath))
+	TSharedPtr<FglTFRuntimeParser> Parser = nullptr;
+
+	TSharedPtr<FglTFRuntimeMappedFile> MappedFile = LoaderConfig.bUseMemoryMappedFiles ? FglTFRuntimeMappedFile::Open(TruePath) : nullptr;
+	if (MappedFile)
 	{
-		UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to load file %s"), *Filename);
-		return nullptr;
+		Parser = FromData(MappedFile->GetData(), MappedFile->GetSize(), LoaderConfig, MappedFile);
 	}
+	else
+	{
+		// zip archives are read on demand instead of being fully loaded in memory
+		TSharedRef<FglTFRuntimeZipFile> ZipFile = MakeShared<FglTFRuntimeZipFile>();
+		if (ZipFile->FromFile(TruePath))
+		{
+			Parser = FromZipFile(ZipFile, LoaderConfig);
+		}
+		else
+		{
+			TArray64<uint8> Content;
+			if (!FFileHelper::LoadFileToArray(Content, *TruePath))
+			{
+				UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to load file %s"), *Filename);
+				return nullptr;
+			}
 
-	TSharedPtr<FglTFRuntimeParser> Parser = FromData(Content.GetData(), Content.Num(), LoaderConfig);
+			Parser = FromData(Content.GetData(), Content.Num(), LoaderConfig);
+		}
+	}
 
 	if (Parser && LoaderConfig.bAllowExternalFiles)
 	{
@@ -93,12 +375,12 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromFilename(const FString& F
 	return Parser;
 }
 
-TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromData(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig)
+TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromData(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeMappedFile> InMappedFile)
 {
 	SCOPED_NAMED_EVENT(FglTFRuntimeParser_FromData, FColor::Magenta);
 
-	// required for Gzip;
-	TArray<uint8> UncompressedData;
+	// required for Gzip (when not streamed);
+	TArray64<uint8> UncompressedData;
 
 	// Gzip Compressed ? 10 bytes header and 8 bytes footer
 	if (DataNum > 18 && DataPtr[0] == 0x1F && DataPtr[1] == 0x8B && DataPtr[2] == 0x08)
@@ -171,8 +453,33 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromData(const uint8* DataPtr
 			StartOfBuffer += 2;
 		}
 
-		UncompressedData.AddUninitialized(*GzipOriginalSize);
-		if (!FCompression::UncompressMemory(NAME_Zlib, UncompressedData.GetData(), *GzipOriginalSize, &DataPtr[StartOfBuffer], DataNum - StartOfBuffer - 8, COMPRESS_NoFlags, -15))
+		uint32* GzipCrc32 = (uint32*)(&DataPtr[DataNum - 8]);
+		FglTFRuntimeGzipStream GzipStream(&DataPtr[StartOfBuffer], DataNum - StartOfBuffer - 8, *GzipCrc32, *GzipOriginalSize);
+
+		// inflate just the header first: glTF binaries are streamed chunk by chunk into their final buffers
+		const int64 HeaderNum = FMath::Min<int64>(12, *GzipOriginalSize);
+		UncompressedData.AddUninitialized(HeaderNum);
+		if (GzipStream.Read(UncompressedData.GetData(), HeaderNum))
+		{
+			if (!LoaderConfig.bAsBlob && *GzipOriginalSize > 20 &&
+				UncompressedData[0] == 0x67 &&
+				UncompressedData[1] == 0x6C &&
+				UncompressedData[2] == 0x54 &&
+				UncompressedData[3] == 0x46)
+			{
+				TSharedPtr<FglTFRuntimeParser> Parser = FromBinaryStream(GzipStream, *GzipOriginalSize, LoaderConfig);
+				if (!Parser && GzipStream.HasError())
+				{
+					UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to uncompress Gzip data."));
+				}
+				return Parser;
+			}
+
+			UncompressedData.AddUninitialized(*GzipOriginalSize - HeaderNum);
+			GzipStream.Read(UncompressedData.GetData() + HeaderNum, *GzipOriginalSize - HeaderNum);
+		}
+
+		if (!GzipStream.Finish())
 		{
 			UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to uncompress Gzip data."));
 			return nullptr;
@@ -189,64 +496,71 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromData(const uint8* DataPtr
 	}
 
 	// Zip archive ?
-	TSharedPtr<FglTFRuntimeZipFile> ZipFile = nullptr;
-	TArray64<uint8> UnzippedData;
 	if (DataNum > 4 && DataPtr[0] == 0x50 && DataPtr[1] == 0x4b && DataPtr[2] == 0x03 && DataPtr[3] == 0x04)
 	{
-		ZipFile = MakeShared<FglTFRuntimeZipFile>();
-		if (!ZipFile->FromData(DataPtr, DataNum))
+		TSharedRef<FglTFRuntimeZipFile> ZipFile = MakeShared<FglTFRuntimeZipFile>();
+		if (!ZipFile->FromData(DataPtr, DataNum, InMappedFile))
 		{
 			UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to parse Zip archive."));
 			return nullptr;
 		}
 
-		FString Filename = LoaderConfig.ArchiveEntryPoint;
+		return FromZipFile(ZipFile, LoaderConfig);
+	}
+
+	return FromUncompressedData(DataPtr, DataNum, LoaderConfig, nullptr, InMappedFile);
+}
+
+TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromZipFile(TSharedRef<FglTFRuntimeZipFile> InZipFile, const FglTFRuntimeConfig& LoaderConfig)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_FromZipFile, FColor::Magenta);
+
+	FString Filename = LoaderConfig.ArchiveEntryPoint;
 
-		if (Filename.IsEmpty())
+	if (Filename.IsEmpty())
+	{
+		TArray<FString> Extensions;
+		LoaderConfig.ArchiveAutoEntryPointExtensions.ParseIntoArray(Extensions, TEXT(" "), true);
+		for (const FString& Extension : Extensions)
 		{
-			TArray<FString> Extensions;
-			LoaderConfig.ArchiveAutoEntryPointExtensions.ParseIntoArray(Extensions, TEXT(" "), true);
-			for (const FString& Extension : Extensions)
+			Filename = InZipFile->GetFirstFilenameByExtension(Extension);
+			if (!Filename.IsEmpty())
 			{
-				Filename = ZipFile->GetFirstFilenameByExtension(Extension);
-				if (!Filename.IsEmpty())
-				{
-					break;
-				}
+				break;
 			}
 		}
+	}
 
-		if (!LoaderConfig.bAsBlob && Filename.IsEmpty())
-		{
-			UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to find entry point from Zip archive."), *Filename);
-			return nullptr;
-		}
+	if (!LoaderConfig.bAsBlob && Filename.IsEmpty())
+	{
+		UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to find entry point from Zip archive."), *Filename);
+		return nullptr;
+	}
 
-		if (!LoaderConfig.bAsBlob && !ZipFile->GetFileContent(Filename, UnzippedData))
-		{
-			UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to get %s from Zip archive."), *Filename);
-			return nullptr;
-		}
+	TArray64<uint8> UnzippedData;
+	if (!LoaderConfig.bAsBlob && !InZipFile->GetFileContent(Filename, UnzippedData))
+	{
+		UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to get %s from Zip archive."), *Filename);
+		return nullptr;
+	}
 
-		if (UnzippedData.Num() > 0)
-		{
-			DataPtr = UnzippedData.GetData();
-			DataNum = UnzippedData.Num();
-		}
-		else
-		{
-			DataPtr = nullptr;
-			DataNum = 0;
-		}
+	if (UnzippedData.Num() > 0)
+	{
+		return FromUncompressedData(UnzippedData.GetData(), UnzippedData.Num(), LoaderConfig, InZipFile, nullptr);
 	}
 
+	return FromUncompressedData(nullptr, 0, LoaderConfig, InZipFile, nullptr);
+}
+
+TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromUncompressedData(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeZipFile> InZipFile, TSharedPtr<FglTFRuntimeMappedFile> InMappedFile)
+{
 	if (LoaderConfig.bAsBlob)
 	{
 		TSharedPtr<FglTFRuntimeParser> NewParser = MakeShared<FglTFRuntimeParser>(MakeShared<FJsonObject>(), LoaderConfig.GetMatrix(), LoaderConfig.SceneScale);
 		if (NewParser)
 		{
 			NewParser->AsBlob.Append(DataPtr, DataNum);
-			NewParser->ZipFile = ZipFile;
+			NewParser->ZipFile = InZipFile;
 		}
 		return NewParser;
 	}
@@ -259,15 +573,22 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromData(const uint8* DataPtr
 			DataPtr[2] == 0x54 &&
 			DataPtr[3] == 0x46)
 		{
-			return FromBinary(DataPtr, DataNum, LoaderConfig, ZipFile);
+			return FromBinary(DataPtr, DataNum, LoaderConfig, InZipFile, InMappedFile);
 		}
 	}
 
 	if (DataNum > 0 && DataNum <= INT32_MAX)
 	{
+		TSharedPtr<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromUTF8(DataPtr, DataNum);
+		if (JsonTape)
+		{
+			return FromJsonTape(JsonTape.ToSharedRef(), LoaderConfig, InZipFile);
+		}
+
+		// fallback for non UTF-8 encodings
 		FString JsonData;
 		FFileHelper::BufferToString(JsonData, DataPtr, (int32)DataNum);
-		return FromString(JsonData, LoaderConfig, ZipFile);
+		return FromString(JsonData, LoaderConfig, InZipFile);
 	}
 
 	return nullptr;
@@ -277,19 +598,23 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromString(const FString& Jso
 {
 	SCOPED_NAMED_EVENT(FglTFRuntimeParser_FromString, FColor::Magenta);
 
-	TSharedPtr<FJsonValue> RootValue;
-
-	TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(JsonData);
-	if (!FJsonSerializer::Deserialize(JsonReader, RootValue))
+	TSharedPtr<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromString(JsonData);
+	if (!JsonTape)
 	{
 		return nullptr;
 	}
 
-	TSharedPtr<FJsonObject> JsonObject = RootValue->AsObject();
-	if (!JsonObject)
+	return FromJsonTape(JsonTape.ToSharedRef(), LoaderConfig, InZipFile);
+}
+
+TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromJsonTape(TSharedRef<FglTFRuntimeJsonTape> InJsonTape, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeZipFile> InZipFile)
+{
+	if (InJsonTape->GetNodeType(InJsonTape->GetRootNode()) != FglTFRuntimeJsonTape::ENodeType::Object)
+	{
 		return nullptr;
+	}
 
-	TSharedPtr<FglTFRuntimeParser> Parser = MakeShared<FglTFRuntimeParser>(JsonObject.ToSharedRef(), LoaderConfig.GetMatrix(), LoaderConfig.SceneScale);
+	TSharedPtr<FglTFRuntimeParser> Parser = MakeShared<FglTFRuntimeParser>(InJsonTape, LoaderConfig.GetMatrix(), LoaderConfig.SceneScale);
 
 	if (Parser)
 	{
@@ -306,17 +631,25 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromString(const FString& Jso
 		}
 		Parser->DefaultPrefixForUnnamedNodes = LoaderConfig.PrefixForUnnamedNodes;
 		Parser->ZipFile = InZipFile;
+		Parser->bUseMemoryMappedFiles = LoaderConfig.bUseMemoryMappedFiles;
+		if (!LoaderConfig.DerivedDataCacheDirectory.IsEmpty())
+		{
+			Parser->DerivedDataCache = FglTFRuntimeDerivedDataCache::Get(LoaderConfig.DerivedDataCacheDirectory, static_cast<int64>(LoaderConfig.DerivedDataCacheMaxSizeMB) * 1024 * 1024);
+		}
 	}
 
 	return Parser;
 }
 
-TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromBinary(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeZipFile> InZipFile)
+TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromBinary(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeZipFile> InZipFile, TSharedPtr<FglTFRuntimeMappedFile> InMappedFile)
 {
 	SCOPED_NAMED_EVENT(FglTFRuntimeParser_FromBinary, FColor::Magenta);
 
-	FString JsonData;
+	const uint8* JsonDataPtr = nullptr;
+	int64 JsonDataNum = 0;
 	TArray64<uint8> BinaryBuffer;
+	const uint8* MappedBinaryPtr = nullptr;
+	int64 MappedBinaryNum = 0;
 
 	bool bJsonFound = false;
 	bool bBinaryFound = false;
@@ -342,13 +675,23 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromBinary(const uint8* DataP
 		if (*ChunkType == 0x4E4F534A && !bJsonFound)
 		{
 			bJsonFound = true;
-			FFileHelper::BufferToString(JsonData, &DataPtr[BlobIndex], *ChunkLength);
+			JsonDataPtr = &DataPtr[BlobIndex];
+			JsonDataNum = *ChunkLength;
 		}
 
 		else if (*ChunkType == 0x004E4942 && !bBinaryFound)
 		{
 			bBinaryFound = true;
-			BinaryBuffer.Append(&DataPtr[BlobIndex], *ChunkLength);
+			// no need to copy the chunk when it comes from a mapped file (decompressed data lives elsewhere)
+			if (InMappedFile && InMappedFile->Contains(&DataPtr[BlobIndex], *ChunkLength))
+			{
+				MappedBinaryPtr = &DataPtr[BlobIndex];
+				MappedBinaryNum = *ChunkLength;
+			}
+			else
+			{
+				BinaryBuffer.Append(&DataPtr[BlobIndex], *ChunkLength);
+			}
 		}
 
 		BlobIndex += *ChunkLength;
@@ -359,14 +702,108 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromBinary(const uint8* DataP
 		return nullptr;
 	}
 
-	TSharedPtr<FglTFRuntimeParser> Parser = FromString(JsonData, LoaderConfig, InZipFile);
+	// the JSON chunk is always UTF-8
+	TSharedPtr<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromUTF8(JsonDataPtr, JsonDataNum);
+	if (!JsonTape)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FglTFRuntimeParser> Parser = FromJsonTape(JsonTape.ToSharedRef(), LoaderConfig, InZipFile);
 
 	if (Parser)
 	{
-		if (bBinaryFound)
+		if (MappedBinaryPtr)
+		{
+			Parser->SetBinaryBuffer(InMappedFile.ToSharedRef(), MappedBinaryPtr, MappedBinaryNum);
+		}
+		else if (bBinaryFound)
+		{
+			Parser->SetBinaryBuffer(MoveTemp(BinaryBuffer));
+		}
+	}
+
+	return Parser;
+}
+
+TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromBinaryStream(FglTFRuntimeGzipStream& Stream, const int64 DataNum, const FglTFRuntimeConfig& LoaderConfig)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_FromBinaryStream, FColor::Magenta);
+
+	TSharedPtr<FglTFRuntimeJsonTape> JsonTape;
+	TArray64<uint8> BinaryBuffer;
+
+	bool bBinaryFound = false;
+	// the 12 bytes header has already been consumed
+	int64 BlobIndex = 12;
+
+	while (BlobIndex < DataNum)
+	{
+		if (BlobIndex + 8 > DataNum)
+		{
+			return nullptr;
+		}
+
+		uint32 ChunkHeader[2];
+		if (!Stream.Read(reinterpret_cast<uint8*>(ChunkHeader), sizeof(ChunkHeader)))
+		{
+			return nullptr;
+		}
+
+		const uint32 ChunkLength = ChunkHeader[0];
+		const uint32 ChunkType = ChunkHeader[1];
+
+		BlobIndex += 8;
+
+		if ((BlobIndex + ChunkLength) > DataNum)
+		{
+			return nullptr;
+		}
+
+		if (ChunkType == 0x4E4F534A && !JsonTape)
 		{
-			Parser->SetBinaryBuffer(BinaryBuffer);
+			// the JSON chunk is parsed as soon as it is available and its text released before inflating the binary chunk
+			TArray64<uint8> JsonData;
+			JsonData.AddUninitialized(ChunkLength);
+			if (!Stream.Read(JsonData.GetData(), ChunkLength))
+			{
+				return nullptr;
+			}
+
+			// the JSON chunk is always UTF-8
+			JsonTape = FglTFRuntimeJsonTape::FromUTF8(JsonData.GetData(), ChunkLength);
+			if (!JsonTape)
+			{
+				return nullptr;
+			}
+		}
+		else if (ChunkType == 0x004E4942 && !bBinaryFound)
+		{
+			bBinaryFound = true;
+			BinaryBuffer.AddUninitialized(ChunkLength);
+			if (!Stream.Read(BinaryBuffer.GetData(), ChunkLength))
+			{
+				return nullptr;
+			}
+		}
+		else if (!Stream.Skip(ChunkLength))
+		{
+			return nullptr;
 		}
+
+		BlobIndex += ChunkLength;
+	}
+
+	if (!Stream.Finish() || !JsonTape)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FglTFRuntimeParser> Parser = FromJsonTape(JsonTape.ToSharedRef(), LoaderConfig, nullptr);
+
+	if (Parser && bBinaryFound)
+	{
+		Parser->SetBinaryBuffer(MoveTemp(BinaryBuffer));
 	}
 
 	return Parser;
@@ -550,10 +987,21 @@ void FglTFRuntimeParser::LoadAndFillBaseMaterials()
 }
 
 
-FglTFRuntimeParser::FglTFRuntimeParser(TSharedRef<FJsonObject> JsonObject, const FMatrix& InSceneBasis, float InSceneScale) : Root(JsonObject), SceneBasis(InSceneBasis), SceneScale(InSceneScale)
+FglTFRuntimeParser::FglTFRuntimeParser(TSharedRef<FJsonObject> JsonObject, const FMatrix& InSceneBasis, float InSceneScale) : CurrentJsonTape(FglTFRuntimeJsonTape::FromJsonObject(JsonObject)), bJsonTapeStale(false), Root(JsonObject), SceneBasis(InSceneBasis), SceneScale(InSceneScale)
+{
+	InitializeFromJsonRoot();
+}
+
+FglTFRuntimeParser::FglTFRuntimeParser(TSharedRef<FglTFRuntimeJsonTape> InJsonTape, const FMatrix& InSceneBasis, float InSceneScale) : CurrentJsonTape(InJsonTape), bJsonTapeStale(false), SceneBasis(InSceneBasis), SceneScale(InSceneScale)
+{
+	InitializeFromJsonRoot();
+}
+
+void FglTFRuntimeParser::InitializeFromJsonRoot()
 {
 	bAllNodesCached = false;
 	DownloadTime = 0;
+	bUseMemoryMappedFiles = false;
 
 	if (IsInGameThread())
 	{
@@ -568,8 +1016,9 @@ FglTFRuntimeParser::FglTFRuntimeParser(TSharedRef<FJsonObject> JsonObject, const
 		FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
 	}
 
-	JsonObject->TryGetStringArrayField("extensionsUsed", ExtensionsUsed);
-	JsonObject->TryGetStringArrayField("extensionsRequired", ExtensionsRequired);
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	JsonTape->TryGetStringArrayField(JsonTape->GetRootNode(), "extensionsUsed", ExtensionsUsed);
+	JsonTape->TryGetStringArrayField(JsonTape->GetRootNode(), "extensionsRequired", ExtensionsRequired);
 
 	if (ExtensionsUsed.Contains("KHR_materials_variants"))
 	{
@@ -597,32 +1046,176 @@ FglTFRuntimeParser::FglTFRuntimeParser(TSharedRef<FJsonObject> JsonObject, const
 	}
 }
 
-bool FglTFRuntimeParser::LoadNodes()
+TSharedPtr<FJsonObject> FglTFRuntimeParser::GetJsonRoot() const
+{
+	TSharedRef<FJsonObject> JsonRootObject = GetJsonRootObject();
+
+	// the caller can change the tree, so the tape is rebuilt from it on the next internal lookup
+	FScopeLock Lock(&JsonRootLock);
+	bJsonTapeStale = true;
+
+	return JsonRootObject;
+}
+
+TSharedRef<FglTFRuntimeJsonTape> FglTFRuntimeParser::GetJsonTape() const
+{
+	FScopeLock Lock(&JsonRootLock);
+
+	if (bJsonTapeStale && Root)
+	{
+		CurrentJsonTape = FglTFRuntimeJsonTape::FromJsonObject(Root.ToSharedRef());
+		// the tree items are the authority now
+		JsonRootItemsCache.Empty();
+		bJsonTapeStale = false;
+	}
+
+	return CurrentJsonTape;
+}
+
+TSharedRef<FJsonObject> FglTFRuntimeParser::GetJsonRootObject() const
+{
+	FScopeLock Lock(&JsonRootLock);
+
+	if (!Root)
+	{
+		SCOPED_NAMED_EVENT(FglTFRuntimeParser_GetJsonRootObject, FColor::Magenta);
+
+		const TSharedRef<FglTFRuntimeJsonTape> JsonTape = CurrentJsonTape;
+		TSharedRef<FJsonObject> JsonRootObject = MakeShared<FJsonObject>();
+		JsonTape->ForEachField(JsonTape->GetRootNode(), [this, &JsonTape, JsonRootObject](const FString& FieldName, const int32 ValueNode)
+			{
+				if (!JsonTape->IsArray(ValueNode))
+				{
+					JsonRootObject->Values.Add(FieldName, JsonTape->ToJsonValue(ValueNode));
+					return;
+				}
+
+				// reuse the items already returned by GetJsonObjectFromRootIndex()
+				const int32 ItemsNum = JsonTape->GetArrayNum(ValueNode);
+				TArray<TSharedPtr<FJsonObject>>& CachedItems = JsonRootItemsCache.FindOrAdd(FieldName);
+				CachedItems.SetNum(ItemsNum);
+
+				TArray<TSharedPtr<FJsonValue>> JsonItems;
+				JsonItems.Reserve(ItemsNum);
+				for (int32 Index = 0; Index < ItemsNum; Index++)
+				{
+					const int32 ItemNode = JsonTape->GetArrayItem(ValueNode, Index);
+					if (!JsonTape->IsObject(ItemNode))
+					{
+						JsonItems.Add(JsonTape->ToJsonValue(ItemNode));
+						continue;
+					}
+
+					if (!CachedItems[Index])
+					{
+						CachedItems[Index] = JsonTape->ToJsonObject(ItemNode);
+					}
+					JsonItems.Add(MakeShared<FJsonValueObject>(CachedItems[Index]));
+				}
+
+				JsonRootObject->Values.Add(FieldName, MakeShared<FJsonValueArray>(JsonItems));
+			});
+
+		Root = JsonRootObject;
+	}
+
+	return Root.ToSharedRef();
+}
+
+int32 FglTFRuntimeParser::GetJsonRootArrayNum(const ANSICHAR* FieldName) const
+{
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonArrayNode = JsonTape->GetArrayField(JsonTape->GetRootNode(), FieldName);
+	if (JsonArrayNode == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	return JsonTape->GetArrayNum(JsonArrayNode);
+}
+
+bool FglTFRuntimeParser::HasJsonRootObject(const ANSICHAR* FieldName, const int32 Index) const
+{
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	return JsonTape->IsObject(JsonTape->GetRootArrayItem(FieldName, Index));
+}
+
+TSharedPtr<FJsonObject> FglTFRuntimeParser::GetJsonObjectFromRootIndex(const FString& FieldName, const int32 Index) const
+{
+	if (Index < 0)
+	{
+		return nullptr;
+	}
+
+	FScopeLock Lock(&JsonRootLock);
+
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+
+	TArray<TSharedPtr<FJsonObject>>* CachedItems = JsonRootItemsCache.Find(FieldName);
+	if (!CachedItems)
+	{
+		const int32 ItemsNum = GetJsonRootArrayNum(TCHAR_TO_UTF8(*FieldName));
+		CachedItems = &JsonRootItemsCache.Add(FieldName);
+		CachedItems->SetNum(FMath::Max(ItemsNum, 0));
+	}
+
+	if (Index >= CachedItems->Num())
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FJsonObject>& JsonItemObject = (*CachedItems)[Index];
+	if (!JsonItemObject)
+	{
+		// the tree has been provided by (or returned to) the user, keep its objects
+		if (Root)
+		{
+			const TArray<TSharedPtr<FJsonValue>>* JsonItems;
+			if (Root->TryGetArrayField(FieldName, JsonItems) && JsonItems->IsValidIndex(Index))
+			{
+				JsonItemObject = (*JsonItems)[Index]->AsObject();
+			}
+		}
+		else
+		{
+			JsonItemObject = JsonTape->ToJsonObject(JsonTape->GetRootArrayItem(TCHAR_TO_UTF8(*FieldName), Index));
+		}
+	}
+
+	return JsonItemObject;
+}
+
+bool FglTFRuntimeParser::LoadNodes()
 {
 	if (bAllNodesCached)
 	{
 		return true;
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonNodes;
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonNodesNode = JsonTape->GetArrayField(JsonTape->GetRootNode(), "nodes");
 
 	// no nodes ?
-	if (!Root->TryGetArrayField("nodes", JsonNodes))
+	if (JsonNodesNode == INDEX_NONE)
 	{
 		return false;
 	}
 
+	const int32 NodesNum = JsonTape->GetArrayNum(JsonNodesNode);
+
+	AllNodesCache.Reserve(NodesNum);
+
 	// first round for getting all nodes
-	for (int32 Index = 0; Index < JsonNodes->Num(); Index++)
+	for (int32 Index = 0; Index < NodesNum; Index++)
 	{
-		TSharedPtr<FJsonObject> JsonNodeObject = (*JsonNodes)[Index]->AsObject();
-		if (!JsonNodeObject)
+		const int32 JsonNodeNode = JsonTape->GetArrayItem(JsonNodesNode, Index);
+		if (!JsonTape->IsObject(JsonNodeNode))
 		{
 			return false;
 		}
 
 		FglTFRuntimeNode Node;
-		if (!LoadNode_Internal(Index, JsonNodeObject.ToSharedRef(), JsonNodes->Num(), Node))
+		if (!LoadNode_Internal(Index, *JsonTape, JsonNodeNode, NodesNum, Node))
 		{
 			return false;
 		}
@@ -630,23 +1223,179 @@ bool FglTFRuntimeParser::LoadNodes()
 		AllNodesCache.Add(Node);
 	}
 
-	for (FglTFRuntimeNode& Node : AllNodesCache)
+	for (const FglTFRuntimeNode& Node : AllNodesCache)
 	{
-		FixNodeParent(Node);
+		for (const int32 ChildIndex : Node.ChildrenIndices)
+		{
+			if (AllNodesCache.IsValidIndex(ChildIndex))
+			{
+				AllNodesCache[ChildIndex].ParentIndex = Node.Index;
+			}
+		}
 	}
 
+	BuildNodesHierarchy();
+
 	bAllNodesCached = true;
 
 	return true;
 }
 
-void FglTFRuntimeParser::FixNodeParent(FglTFRuntimeNode& Node)
+void FglTFRuntimeParser::BuildNodesHierarchy()
 {
-	for (int32 Index : Node.ChildrenIndices)
+	SCOPED_NAMED_EVENT(BuildNodesHierarchy, FColor::Magenta);
+
+	const int32 NodesNum = AllNodesCache.Num();
+
+	// children lists are rebuilt from the fixed parents, so a node listed as child by multiple nodes is visited only once
+	TArray<int32> ChildrenOffsets;
+	ChildrenOffsets.AddZeroed(NodesNum + 1);
+	for (const FglTFRuntimeNode& Node : AllNodesCache)
+	{
+		if (Node.ParentIndex > INDEX_NONE)
+		{
+			ChildrenOffsets[Node.ParentIndex + 1]++;
+		}
+	}
+	for (int32 Index = 0; Index < NodesNum; Index++)
+	{
+		ChildrenOffsets[Index + 1] += ChildrenOffsets[Index];
+	}
+
+	TArray<int32> Children;
+	Children.AddUninitialized(ChildrenOffsets[NodesNum]);
+	TArray<int32> ChildrenFill = ChildrenOffsets;
+	for (const FglTFRuntimeNode& Node : AllNodesCache)
+	{
+		if (Node.ParentIndex > INDEX_NONE)
+		{
+			Children[ChildrenFill[Node.ParentIndex]++] = Node.Index;
+		}
+	}
+
+	NodesWorldTransformsCache.Reset(NodesNum);
+	NodesDepthCache.Reset(NodesNum);
+	NodesEulerFirstCache.Reset(NodesNum);
+	NodesEulerLastCache.Reset(NodesNum);
+	for (const FglTFRuntimeNode& Node : AllNodesCache)
+	{
+		NodesWorldTransformsCache.Add(Node.Transform);
+	}
+	NodesDepthCache.AddZeroed(NodesNum);
+	NodesEulerFirstCache.Init(INDEX_NONE, NodesNum);
+	NodesEulerLastCache.Init(INDEX_NONE, NodesNum);
+	NodesEulerTourCache.Reset(FMath::Max(NodesNum * 2 - 1, 0));
+
+	// iterative depth-first visit of every root: parents are always visited before their children,
+	// so world transforms and depths are computed in a single pass while recording the Euler tour
+	TArray<TPair<int32, int32>> Stack;
+	for (int32 RootIndex = 0; RootIndex < NodesNum; RootIndex++)
+	{
+		if (AllNodesCache[RootIndex].ParentIndex > INDEX_NONE)
+		{
+			continue;
+		}
+
+		NodesEulerFirstCache[RootIndex] = NodesEulerTourCache.Add(RootIndex);
+		Stack.Add(TPair<int32, int32>(RootIndex, ChildrenOffsets[RootIndex]));
+
+		while (Stack.Num() > 0)
+		{
+			TPair<int32, int32>& Top = Stack.Last();
+			const int32 NodeIndex = Top.Key;
+			if (Top.Value < ChildrenOffsets[NodeIndex + 1])
+			{
+				const int32 ChildIndex = Children[Top.Value++];
+				NodesWorldTransformsCache[ChildIndex] = NodesWorldTransformsCache[NodeIndex] * AllNodesCache[ChildIndex].Transform;
+				NodesDepthCache[ChildIndex] = NodesDepthCache[NodeIndex] + 1;
+				NodesEulerFirstCache[ChildIndex] = NodesEulerTourCache.Add(ChildIndex);
+				Stack.Add(TPair<int32, int32>(ChildIndex, ChildrenOffsets[ChildIndex]));
+			}
+			else
+			{
+				NodesEulerLastCache[NodeIndex] = NodesEulerTourCache.Num() - 1;
+				Stack.Pop();
+				if (Stack.Num() > 0)
+				{
+					NodesEulerTourCache.Add(Stack.Last().Key);
+				}
+			}
+		}
+	}
+
+	// level 0 is the tour itself, level N stores the shallowest node in [Index, Index + 2^N)
+	const int32 TourNum = NodesEulerTourCache.Num();
+	const int32 LevelsNum = TourNum > 0 ? FMath::FloorLog2(TourNum) + 1 : 0;
+	NodesEulerSparseTableCache.Reset(TourNum * LevelsNum);
+	NodesEulerSparseTableCache.Append(NodesEulerTourCache);
+	for (int32 Level = 1; Level < LevelsNum; Level++)
+	{
+		const int32 PreviousLevelOffset = (Level - 1) * TourNum;
+		const int32 HalfRange = 1 << (Level - 1);
+		for (int32 Index = 0; Index < TourNum; Index++)
+		{
+			const int32 Left = NodesEulerSparseTableCache[PreviousLevelOffset + Index];
+			if (Index + HalfRange >= TourNum)
+			{
+				NodesEulerSparseTableCache.Add(Left);
+				continue;
+			}
+			const int32 Right = NodesEulerSparseTableCache[PreviousLevelOffset + Index + HalfRange];
+			NodesEulerSparseTableCache.Add(NodesDepthCache[Right] < NodesDepthCache[Left] ? Right : Left);
+		}
+	}
+}
+
+bool FglTFRuntimeParser::IsNodeAncestor(const int32 NodeIndex, const int32 AncestorIndex) const
+{
+	if (!NodesEulerFirstCache.IsValidIndex(NodeIndex) || !NodesEulerFirstCache.IsValidIndex(AncestorIndex))
+	{
+		return false;
+	}
+
+	if (NodesEulerFirstCache[NodeIndex] == INDEX_NONE || NodesEulerFirstCache[AncestorIndex] == INDEX_NONE)
+	{
+		return NodeIndex == AncestorIndex;
+	}
+
+	return NodesEulerFirstCache[AncestorIndex] <= NodesEulerFirstCache[NodeIndex] && NodesEulerLastCache[NodeIndex] <= NodesEulerLastCache[AncestorIndex];
+}
+
+int32 FglTFRuntimeParser::FindLowestCommonAncestor(const int32 NodeIndexA, const int32 NodeIndexB) const
+{
+	if (!NodesEulerFirstCache.IsValidIndex(NodeIndexA) || !NodesEulerFirstCache.IsValidIndex(NodeIndexB))
+	{
+		return INDEX_NONE;
+	}
+
+	if (NodeIndexA == NodeIndexB)
+	{
+		return NodeIndexA;
+	}
+
+	const int32 FirstA = NodesEulerFirstCache[NodeIndexA];
+	const int32 FirstB = NodesEulerFirstCache[NodeIndexB];
+	if (FirstA == INDEX_NONE || FirstB == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	// the shallowest node between the first occurrences of the two nodes in the Euler tour
+	const int32 Left = FMath::Min(FirstA, FirstB);
+	const int32 Right = FMath::Max(FirstA, FirstB);
+	const int32 Level = FMath::FloorLog2(Right - Left + 1);
+	const int32 LevelOffset = Level * NodesEulerTourCache.Num();
+	const int32 CandidateLeft = NodesEulerSparseTableCache[LevelOffset + Left];
+	const int32 CandidateRight = NodesEulerSparseTableCache[LevelOffset + Right - (1 << Level) + 1];
+	const int32 Ancestor = NodesDepthCache[CandidateRight] < NodesDepthCache[CandidateLeft] ? CandidateRight : CandidateLeft;
+
+	// nodes in different trees have no common ancestor (the shallowest node is the root of a tree in between)
+	if (!IsNodeAncestor(NodeIndexA, Ancestor) || !IsNodeAncestor(NodeIndexB, Ancestor))
 	{
-		AllNodesCache[Index].ParentIndex = Node.Index;
-		FixNodeParent(AllNodesCache[Index]);
+		return INDEX_NONE;
 	}
+
+	return Ancestor;
 }
 
 bool FglTFRuntimeParser::LoadNodesRecursive(const int32 NodeIndex, TArray<FglTFRuntimeNode>& Nodes)
@@ -673,34 +1422,24 @@ bool FglTFRuntimeParser::LoadNodesRecursive(const int32 NodeIndex, TArray<FglTFR
 
 int32 FglTFRuntimeParser::GetNumMeshes() const
 {
-	const TArray<TSharedPtr<FJsonValue>>* JsonArray;
-	if (Root->TryGetArrayField("meshes", JsonArray))
-	{
-		return JsonArray->Num();
-	}
-	return 0;
+	return FMath::Max(GetJsonRootArrayNum("meshes"), 0);
 }
 
 int32 FglTFRuntimeParser::GetNumImages() const
 {
-	const TArray<TSharedPtr<FJsonValue>>* JsonArray;
-	if (Root->TryGetArrayField("images", JsonArray))
-	{
-		return JsonArray->Num();
-	}
-	return 0;
+	return FMath::Max(GetJsonRootArrayNum("images"), 0);
 }
 
 bool FglTFRuntimeParser::LoadScenes(TArray<FglTFRuntimeScene>& Scenes)
 {
-	const TArray<TSharedPtr<FJsonValue>>* JsonScenes;
+	const int32 ScenesNum = GetJsonRootArrayNum("scenes");
 	// no scenes ?
-	if (!Root->TryGetArrayField("scenes", JsonScenes))
+	if (ScenesNum < 0)
 	{
 		return false;
 	}
 
-	for (int32 Index = 0; Index < JsonScenes->Num(); Index++)
+	for (int32 Index = 0; Index < ScenesNum; Index++)
 	{
 		FglTFRuntimeScene Scene;
 		if (!LoadScene(Index, Scene))
@@ -998,22 +1737,23 @@ TArray<double> FglTFRuntimeParser::GetJsonExtensionObjectNumbers(TSharedRef<FJso
 
 bool FglTFRuntimeParser::LoadScene(int32 SceneIndex, FglTFRuntimeScene& Scene)
 {
-	TSharedPtr<FJsonObject> JsonSceneObject = GetJsonObjectFromRootIndex("scenes", SceneIndex);
-	if (!JsonSceneObject)
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonSceneNode = JsonTape->GetRootArrayItem("scenes", SceneIndex);
+	if (!JsonTape->IsObject(JsonSceneNode))
 	{
 		return false;
 	}
 
 	Scene.Index = SceneIndex;
-	Scene.Name = GetJsonObjectString(JsonSceneObject.ToSharedRef(), "name", FString::FromInt(Scene.Index));
+	Scene.Name = JsonTape->GetStringField(JsonSceneNode, "name", FString::FromInt(Scene.Index));
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonSceneNodes;
-	if (JsonSceneObject->TryGetArrayField("nodes", JsonSceneNodes))
+	const int32 JsonSceneNodesNode = JsonTape->GetArrayField(JsonSceneNode, "nodes");
+	if (JsonSceneNodesNode != INDEX_NONE)
 	{
-		for (TSharedPtr<FJsonValue> JsonSceneNode : *JsonSceneNodes)
+		for (int32 SceneNodeIndex = 0; SceneNodeIndex < JsonTape->GetArrayNum(JsonSceneNodesNode); SceneNodeIndex++)
 		{
 			int64 NodeIndex;
-			if (!JsonSceneNode->TryGetNumber(NodeIndex))
+			if (!JsonTape->TryGetNumber(JsonTape->GetArrayItem(JsonSceneNodesNode, SceneNodeIndex), NodeIndex))
 			{
 				return false;
 			}
@@ -1123,6 +1863,7 @@ bool FglTFRuntimeParser::LoadJointByName(const int64 RootBoneIndex, const FStrin
 
 void FglTFRuntimeParser::AddError(const FString& ErrorContext, const FString& ErrorMessage)
 {
+	FScopeLock Lock(&ErrorsLock);
 	FString FullMessage = ErrorContext + ": " + ErrorMessage;
 	Errors.Add(FullMessage);
 	UE_LOG(LogGLTFRuntime, Error, TEXT("%s"), *FullMessage);
@@ -1156,96 +1897,107 @@ bool FglTFRuntimeParser::FillJsonMatrix(const TArray<TSharedPtr<FJsonValue>>* Js
 	return true;
 }
 
-bool FglTFRuntimeParser::LoadNode_Internal(int32 Index, TSharedRef<FJsonObject> JsonNodeObject, int32 NodesCount, FglTFRuntimeNode& Node)
+bool FglTFRuntimeParser::LoadNode_Internal(int32 Index, const FglTFRuntimeJsonTape& JsonTape, const int32 JsonNodeNode, int32 NodesCount, FglTFRuntimeNode& Node)
 {
 	Node.Index = Index;
-	Node.Name = GetJsonObjectString(JsonNodeObject, "name", DefaultPrefixForUnnamedNodes + FString::FromInt(Node.Index));
+	Node.Name = JsonTape.GetStringField(JsonNodeNode, "name", DefaultPrefixForUnnamedNodes + FString::FromInt(Node.Index));
 
-	Node.MeshIndex = GetJsonObjectIndex(JsonNodeObject, "mesh", INDEX_NONE);
+	Node.MeshIndex = static_cast<int32>(JsonTape.GetIndexField(JsonNodeNode, "mesh"));
 
-	Node.SkinIndex = GetJsonObjectIndex(JsonNodeObject, "skin", INDEX_NONE);
+	Node.SkinIndex = static_cast<int32>(JsonTape.GetIndexField(JsonNodeNode, "skin"));
 
-	Node.CameraIndex = GetJsonObjectIndex(JsonNodeObject, "camera", INDEX_NONE);
+	Node.CameraIndex = static_cast<int32>(JsonTape.GetIndexField(JsonNodeNode, "camera"));
 
 	FMatrix Matrix = FMatrix::Identity;
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonMatrixValues;
-	if (JsonNodeObject->TryGetArrayField("matrix", JsonMatrixValues))
+	const int32 JsonMatrixNode = JsonTape.GetArrayField(JsonNodeNode, "matrix");
+	if (JsonMatrixNode != INDEX_NONE)
 	{
-		if (!FillJsonMatrix(JsonMatrixValues, Matrix))
+		double Values[16];
+		if (!JsonTape.TryGetNumbers(JsonMatrixNode, Values, 16))
 		{
 			return false;
 		}
+
+		for (int32 i = 0; i < 16; i++)
+		{
+			Matrix.M[i / 4][i % 4] = Values[i];
+		}
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonScaleValues;
-	if (JsonNodeObject->TryGetArrayField("scale", JsonScaleValues))
+	const int32 JsonScaleNode = JsonTape.GetArrayField(JsonNodeNode, "scale");
+	if (JsonScaleNode != INDEX_NONE)
 	{
-		FVector MatrixScale;
-		if (!GetJsonVector<3>(JsonScaleValues, MatrixScale))
+		double Values[3];
+		if (!JsonTape.TryGetNumbers(JsonScaleNode, Values, 3))
 		{
 			return false;
 		}
 
-		Matrix *= FScaleMatrix(MatrixScale);
+		Matrix *= FScaleMatrix(FVector(Values[0], Values[1], Values[2]));
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonRotationValues;
-	if (JsonNodeObject->TryGetArrayField("rotation", JsonRotationValues))
+	const int32 JsonRotationNode = JsonTape.GetArrayField(JsonNodeNode, "rotation");
+	if (JsonRotationNode != INDEX_NONE)
 	{
-		FVector4 Vector;
-		if (!GetJsonVector<4>(JsonRotationValues, Vector))
+		double Values[4];
+		if (!JsonTape.TryGetNumbers(JsonRotationNode, Values, 4))
 		{
 			return false;
 		}
-		FQuat Quat = { Vector.X, Vector.Y, Vector.Z, Vector.W };
+		FQuat Quat = { Values[0], Values[1], Values[2], Values[3] };
 		Matrix *= FQuatRotationMatrix(Quat);
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonTranslationValues;
-	if (JsonNodeObject->TryGetArrayField("translation", JsonTranslationValues))
+	const int32 JsonTranslationNode = JsonTape.GetArrayField(JsonNodeNode, "translation");
+	if (JsonTranslationNode != INDEX_NONE)
 	{
-		FVector Translation;
-		if (!GetJsonVector<3>(JsonTranslationValues, Translation))
+		double Values[3];
+		if (!JsonTape.TryGetNumbers(JsonTranslationNode, Values, 3))
 		{
 			return false;
 		}
 
-		Matrix *= FTranslationMatrix(Translation);
+		Matrix *= FTranslationMatrix(FVector(Values[0], Values[1], Values[2]));
 	}
 
 	Matrix.ScaleTranslation(FVector(SceneScale, SceneScale, SceneScale));
 	Node.Transform = FTransform(SceneBasis.Inverse() * Matrix * SceneBasis);
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonChildren;
-	if (JsonNodeObject->TryGetArrayField("children", JsonChildren))
+	const int32 JsonChildrenNode = JsonTape.GetArrayField(JsonNodeNode, "children");
+	const int32 ChildrenNum = JsonTape.GetArrayNum(JsonChildrenNode);
+	for (int32 i = 0; i < ChildrenNum; i++)
 	{
-		for (int32 i = 0; i < JsonChildren->Num(); i++)
+		int64 ChildIndex;
+		if (!JsonTape.TryGetNumber(JsonTape.GetArrayItem(JsonChildrenNode, i), ChildIndex))
 		{
-			int64 ChildIndex;
-			if (!(*JsonChildren)[i]->TryGetNumber(ChildIndex))
-			{
-				return false;
-			}
-
-			if (ChildIndex >= NodesCount)
-			{
-				return false;
-			}
+			return false;
+		}
 
-			Node.ChildrenIndices.Add(ChildIndex);
+		if (ChildIndex >= NodesCount)
+		{
+			return false;
 		}
+
+		Node.ChildrenIndices.Add(ChildIndex);
 	}
 
 	return true;
 }
 
-bool FglTFRuntimeParser::LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnimationObject, float& Duration, FString& Name, TFunctionRef<void(const FglTFRuntimeNode& Node, const FString& Path, const FglTFRuntimeAnimationCurve& Curve)> Callback, TFunctionRef<bool(const FglTFRuntimeNode& Node)> NodeFilter, const TArray<FglTFRuntimePathItem>& OverrideTrackNameFromExtension)
+bool FglTFRuntimeParser::LoadAnimation_Internal(const int32 AnimationIndex, float& Duration, FString& Name, TFunctionRef<void(const FglTFRuntimeNode& Node, const FString& Path, const FglTFRuntimeAnimationCurve& Curve)> Callback, TFunctionRef<bool(const FglTFRuntimeNode& Node)> NodeFilter, const TArray<FglTFRuntimePathItem>& OverrideTrackNameFromExtension)
 {
-	Name = GetJsonObjectString(JsonAnimationObject, "name", "");
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonAnimationNode = JsonTape->GetRootArrayItem("animations", AnimationIndex);
+	if (!JsonTape->IsObject(JsonAnimationNode))
+	{
+		return false;
+	}
+
+	Name = JsonTape->GetStringField(JsonAnimationNode, "name", "");
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonSamplers;
-	if (!JsonAnimationObject->TryGetArrayField("samplers", JsonSamplers))
+	const int32 JsonSamplersNode = JsonTape->GetArrayField(JsonAnimationNode, "samplers");
+	if (JsonSamplersNode == INDEX_NONE)
 	{
 		return false;
 	}
@@ -1254,33 +2006,30 @@ bool FglTFRuntimeParser::LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnim
 
 	TArray<FglTFRuntimeAnimationCurve> Samplers;
 
-	for (int32 SamplerIndex = 0; SamplerIndex < JsonSamplers->Num(); SamplerIndex++)
+	const int32 SamplersNum = JsonTape->GetArrayNum(JsonSamplersNode);
+	for (int32 SamplerIndex = 0; SamplerIndex < SamplersNum; SamplerIndex++)
 	{
-		TSharedPtr<FJsonObject> JsonSamplerObject = (*JsonSamplers)[SamplerIndex]->AsObject();
-		if (!JsonSamplerObject)
+		const int32 JsonSamplerNode = JsonTape->GetArrayItem(JsonSamplersNode, SamplerIndex);
+		if (!JsonTape->IsObject(JsonSamplerNode))
 		{
 			return false;
 		}
 
 		FglTFRuntimeAnimationCurve AnimationCurve;
 
-		if (!BuildFromAccessorField(JsonSamplerObject.ToSharedRef(), "input", AnimationCurve.Timeline, { 5126 }, INDEX_NONE, false, nullptr))
+		if (!BuildFromAccessorField(*JsonTape, JsonSamplerNode, "input", AnimationCurve.Timeline, { 5126 }, INDEX_NONE, false, nullptr))
 		{
 			AddError("LoadAnimation_Internal()", FString::Printf(TEXT("Unable to retrieve \"input\" from sampler %d"), SamplerIndex));
 			return false;
 		}
 
-		if (!BuildFromAccessorField(JsonSamplerObject.ToSharedRef(), "output", AnimationCurve.Values, { 1, 3, 4 }, { 5126, 5120, 5121, 5122, 5123 }, INDEX_NONE, true, nullptr))
+		if (!BuildFromAccessorField(*JsonTape, JsonSamplerNode, "output", AnimationCurve.Values, { 1, 3, 4 }, { 5126, 5120, 5121, 5122, 5123 }, INDEX_NONE, true, nullptr))
 		{
 			AddError("LoadAnimation_Internal()", FString::Printf(TEXT("Unable to retrieve \"output\" from sampler %d"), SamplerIndex));
 			return false;
 		}
 
-		FString SamplerInterpolation;
-		if (!JsonSamplerObject->TryGetStringField("interpolation", SamplerInterpolation))
-		{
-			SamplerInterpolation = "LINEAR";
-		}
+		const FString SamplerInterpolation = JsonTape->GetStringField(JsonSamplerNode, "interpolation", "LINEAR");
 
 		// get animation valid duration
 		for (float Time : AnimationCurve.Timeline)
@@ -1314,20 +2063,21 @@ bool FglTFRuntimeParser::LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnim
 	}
 
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonChannels;
-	if (!JsonAnimationObject->TryGetArrayField("channels", JsonChannels))
+	const int32 JsonChannelsNode = JsonTape->GetArrayField(JsonAnimationNode, "channels");
+	if (JsonChannelsNode == INDEX_NONE)
 	{
 		return false;
 	}
 
-	for (int32 ChannelIndex = 0; ChannelIndex < JsonChannels->Num(); ChannelIndex++)
+	const int32 ChannelsNum = JsonTape->GetArrayNum(JsonChannelsNode);
+	for (int32 ChannelIndex = 0; ChannelIndex < ChannelsNum; ChannelIndex++)
 	{
-		TSharedPtr<FJsonObject> JsonChannelObject = (*JsonChannels)[ChannelIndex]->AsObject();
-		if (!JsonChannelObject)
+		const int32 JsonChannelNode = JsonTape->GetArrayItem(JsonChannelsNode, ChannelIndex);
+		if (!JsonTape->IsObject(JsonChannelNode))
 			return false;
 
 		int32 Sampler;
-		if (!JsonChannelObject->TryGetNumberField("sampler", Sampler))
+		if (!JsonTape->TryGetNumberField(JsonChannelNode, "sampler", Sampler))
 		{
 			return false;
 		}
@@ -1337,8 +2087,8 @@ bool FglTFRuntimeParser::LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnim
 			return false;
 		}
 
-		const TSharedPtr<FJsonObject>* JsonTargetObject;
-		if (!JsonChannelObject->TryGetObjectField("target", JsonTargetObject))
+		const int32 JsonTargetNode = JsonTape->GetObjectField(JsonChannelNode, "target");
+		if (JsonTargetNode == INDEX_NONE)
 		{
 			return false;
 		}
@@ -1346,10 +2096,11 @@ bool FglTFRuntimeParser::LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnim
 		FglTFRuntimeNode Node;
 		if (OverrideTrackNameFromExtension.Num() > 0)
 		{
-			const TSharedPtr<FJsonObject>* JsonTargetExtensions;
-			if ((*JsonTargetObject)->TryGetObjectField("extensions", JsonTargetExtensions))
+			// the relative path lookup works on trees, so only the target extensions are materialized
+			TSharedPtr<FJsonObject> JsonTargetExtensions = JsonTape->ToJsonObject(JsonTape->GetObjectField(JsonTargetNode, "extensions"));
+			if (JsonTargetExtensions)
 			{
-				TSharedPtr<FJsonValue> JsonTrackName = GetJSONObjectFromRelativePath(JsonTargetExtensions->ToSharedRef(), OverrideTrackNameFromExtension);
+				TSharedPtr<FJsonValue> JsonTrackName = GetJSONObjectFromRelativePath(JsonTargetExtensions.ToSharedRef(), OverrideTrackNameFromExtension);
 				if (JsonTrackName)
 				{
 					JsonTrackName->TryGetString(Node.Name);
@@ -1360,7 +2111,7 @@ bool FglTFRuntimeParser::LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnim
 		if (Node.Name.IsEmpty())
 		{
 			int64 NodeIndex;
-			if (!(*JsonTargetObject)->TryGetNumberField("node", NodeIndex))
+			if (!JsonTape->TryGetNumberField(JsonTargetNode, "node", NodeIndex))
 			{
 				return false;
 			}
@@ -1377,7 +2128,7 @@ bool FglTFRuntimeParser::LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnim
 		}
 
 		FString Path;
-		if (!(*JsonTargetObject)->TryGetStringField("path", Path))
+		if (!JsonTape->TryGetStringField(JsonTargetNode, "path", Path))
 		{
 			return false;
 		}
@@ -1391,22 +2142,12 @@ bool FglTFRuntimeParser::LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnim
 TArray<FString> FglTFRuntimeParser::GetCamerasNames()
 {
 	TArray<FString> CamerasNames;
-	const TArray<TSharedPtr<FJsonValue>>* JsonCameras;
-	if (!Root->TryGetArrayField("cameras", JsonCameras))
-	{
-		return CamerasNames;
-	}
-
-	for (TSharedPtr<FJsonValue> JsonCamera : *JsonCameras)
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonCamerasNode = JsonTape->GetArrayField(JsonTape->GetRootNode(), "cameras");
+	for (int32 CameraIndex = 0; CameraIndex < JsonTape->GetArrayNum(JsonCamerasNode); CameraIndex++)
 	{
-		TSharedPtr<FJsonObject> JsonCameraObject = JsonCamera->AsObject();
-		if (!JsonCameraObject)
-		{
-			continue;
-		}
-
 		FString CameraName;
-		if (!JsonCameraObject->TryGetStringField("name", CameraName))
+		if (!JsonTape->TryGetStringField(JsonTape->GetArrayItem(JsonCamerasNode, CameraIndex), "name", CameraName))
 		{
 			continue;
 		}
@@ -1425,8 +2166,8 @@ UglTFRuntimeAnimationCurve* FglTFRuntimeParser::LoadNodeAnimationCurve(const int
 		return nullptr;
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonAnimations;
-	if (!Root->TryGetArrayField("animations", JsonAnimations))
+	const int32 AnimationsNum = GetJsonRootArrayNum("animations");
+	if (AnimationsNum < 0)
 	{
 		return nullptr;
 	}
@@ -1483,16 +2224,15 @@ UglTFRuntimeAnimationCurve* FglTFRuntimeParser::LoadNodeAnimationCurve(const int
 			bAnimationFound = true;
 		};
 
-	for (int32 JsonAnimationIndex = 0; JsonAnimationIndex < JsonAnimations->Num(); JsonAnimationIndex++)
+	for (int32 JsonAnimationIndex = 0; JsonAnimationIndex < AnimationsNum; JsonAnimationIndex++)
 	{
-		TSharedPtr<FJsonObject> JsonAnimationObject = (*JsonAnimations)[JsonAnimationIndex]->AsObject();
-		if (!JsonAnimationObject)
+		if (!HasJsonRootObject("animations", JsonAnimationIndex))
 		{
 			return nullptr;
 		}
 		float Duration;
 		FString Name;
-		if (!LoadAnimation_Internal(JsonAnimationObject.ToSharedRef(), Duration, Name, Callback, [&](const FglTFRuntimeNode& Node) -> bool { return Node.Index == NodeIndex; }, {}))
+		if (!LoadAnimation_Internal(JsonAnimationIndex, Duration, Name, Callback, [&](const FglTFRuntimeNode& Node) -> bool { return Node.Index == NodeIndex; }, {}))
 		{
 			return nullptr;
 		}
@@ -1520,8 +2260,8 @@ TArray<UglTFRuntimeAnimationCurve*> FglTFRuntimeParser::LoadAllNodeAnimationCurv
 		return AnimationCurves;
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonAnimations;
-	if (!Root->TryGetArrayField("animations", JsonAnimations))
+	const int32 AnimationsNum = GetJsonRootArrayNum("animations");
+	if (AnimationsNum < 0)
 	{
 		return AnimationCurves;
 	}
@@ -1576,17 +2316,16 @@ TArray<UglTFRuntimeAnimationCurve*> FglTFRuntimeParser::LoadAllNodeAnimationCurv
 			bAnimationFound = true;
 		};
 
-	for (int32 JsonAnimationIndex = 0; JsonAnimationIndex < JsonAnimations->Num(); JsonAnimationIndex++)
+	for (int32 JsonAnimationIndex = 0; JsonAnimationIndex < AnimationsNum; JsonAnimationIndex++)
 	{
-		TSharedPtr<FJsonObject> JsonAnimationObject = (*JsonAnimations)[JsonAnimationIndex]->AsObject();
-		if (!JsonAnimationObject)
+		if (!HasJsonRootObject("animations", JsonAnimationIndex))
 			continue;
 		float Duration;
 		FString Name;
 		bAnimationFound = false;
 		AnimationCurve = NewObject<UglTFRuntimeAnimationCurve>(GetTransientPackage(), NAME_None, RF_Public);
 		AnimationCurve->SetDefaultValues(OriginalTransform.GetLocation(), OriginalTransform.Rotator().Euler(), OriginalTransform.GetScale3D());
-		if (!LoadAnimation_Internal(JsonAnimationObject.ToSharedRef(), Duration, Name, Callback, [&](const FglTFRuntimeNode& Node) -> bool { return Node.Index == NodeIndex; }, {}))
+		if (!LoadAnimation_Internal(JsonAnimationIndex, Duration, Name, Callback, [&](const FglTFRuntimeNode& Node) -> bool { return Node.Index == NodeIndex; }, {}))
 		{
 			continue;
 		}
@@ -1609,19 +2348,13 @@ bool FglTFRuntimeParser::HasRoot(int32 Index, int32 RootIndex)
 	if (Index == RootIndex)
 		return true;
 
-	FglTFRuntimeNode Node;
-	if (!LoadNode(Index, Node))
-		return false;
-
-	while (Node.ParentIndex != INDEX_NONE)
+	if (!bAllNodesCached)
 	{
-		if (!LoadNode(Node.ParentIndex, Node))
+		if (!LoadNodes())
 			return false;
-		if (Node.Index == RootIndex)
-			return true;
 	}
 
-	return false;
+	return IsNodeAncestor(Index, RootIndex);
 }
 
 int32 FglTFRuntimeParser::FindTopRoot(int32 Index)
@@ -1640,25 +2373,24 @@ int32 FglTFRuntimeParser::FindTopRoot(int32 Index)
 
 int32 FglTFRuntimeParser::FindCommonRoot(const TArray<int32>& Indices)
 {
-	int32 CurrentRootIndex = Indices[0];
-	bool bTryNextParent = true;
+	if (Indices.Num() == 0)
+		return INDEX_NONE;
 
-	while (bTryNextParent)
+	if (!bAllNodesCached)
 	{
-		FglTFRuntimeNode Node;
-		if (!LoadNode(CurrentRootIndex, Node))
+		if (!LoadNodes())
 			return INDEX_NONE;
+	}
 
-		bTryNextParent = false;
-		for (int32 Index : Indices)
-		{
-			if (!HasRoot(Index, CurrentRootIndex))
-			{
-				bTryNextParent = true;
-				CurrentRootIndex = Node.ParentIndex;
-				break;
-			}
-		}
+	if (!AllNodesCache.IsValidIndex(Indices[0]))
+		return INDEX_NONE;
+
+	int32 CurrentRootIndex = Indices[0];
+	for (int32 Index : Indices)
+	{
+		CurrentRootIndex = FindLowestCommonAncestor(CurrentRootIndex, Index);
+		if (CurrentRootIndex == INDEX_NONE)
+			return INDEX_NONE;
 	}
 
 	return CurrentRootIndex;
@@ -1754,8 +2486,7 @@ bool FglTFRuntimeParser::LoadCameraIntoCameraComponent(const int32 CameraIndex,
 
 USkeleton* FglTFRuntimeParser::LoadSkeleton(const int32 SkinIndex, const FglTFRuntimeSkeletonConfig& SkeletonConfig)
 {
-	TSharedPtr<FJsonObject> JsonSkinObject = GetJsonObjectFromRootIndex("skins", SkinIndex);
-	if (!JsonSkinObject)
+	if (!HasJsonRootObject("skins", SkinIndex))
 	{
 		return nullptr;
 	}
@@ -1776,7 +2507,7 @@ USkeleton* FglTFRuntimeParser::LoadSkeleton(const int32 SkinIndex, const FglTFRu
 	FReferenceSkeleton& RefSkeleton = SkeletalMesh->RefSkeleton;
 #endif
 
-	if (!FillReferenceSkeleton(JsonSkinObject.ToSharedRef(), RefSkeleton, BoneMap, SkeletonConfig))
+	if (!FillReferenceSkeleton(SkinIndex, RefSkeleton, BoneMap, SkeletonConfig))
 	{
 		AddError("FillReferenceSkeleton()", "Unable to fill RefSkeleton.");
 		return nullptr;
@@ -1858,34 +2589,21 @@ USkeleton* FglTFRuntimeParser::LoadSkeletonFromNode(const FglTFRuntimeNode& Node
 
 bool FglTFRuntimeParser::NodeIsBone(const int32 NodeIndex)
 {
-	const TArray<TSharedPtr<FJsonValue>>* JsonSkins;
-	if (!Root->TryGetArrayField("skins", JsonSkins))
-	{
-		return false;
-	}
-
-	for (TSharedPtr<FJsonValue> JsonSkin : *JsonSkins)
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonSkinsNode = JsonTape->GetArrayField(JsonTape->GetRootNode(), "skins");
+	const int32 SkinsNum = JsonTape->GetArrayNum(JsonSkinsNode);
+	for (int32 SkinIndex = 0; SkinIndex < SkinsNum; SkinIndex++)
 	{
-		TSharedPtr<FJsonObject> JsonSkinObject = JsonSkin->AsObject();
-		if (!JsonSkinObject)
-		{
-			continue;
-		}
-
-		const TArray<TSharedPtr<FJsonValue>>* JsonJoints;
-		if (!JsonSkinObject->TryGetArrayField("joints", JsonJoints))
-		{
-			continue;
-		}
-
-		for (TSharedPtr<FJsonValue> JsonJoint : *JsonJoints)
+		const int32 JsonJointsNode = JsonTape->GetArrayField(JsonTape->GetArrayItem(JsonSkinsNode, SkinIndex), "joints");
+		const int32 JointsNum = JsonTape->GetArrayNum(JsonJointsNode);
+		for (int32 JointIndex = 0; JointIndex < JointsNum; JointIndex++)
 		{
-			int64 JointIndex;
-			if (!JsonJoint->TryGetNumber(JointIndex))
+			int64 JointNodeIndex;
+			if (!JsonTape->TryGetNumber(JsonTape->GetArrayItem(JsonJointsNode, JointIndex), JointNodeIndex))
 			{
 				continue;
 			}
-			if (JointIndex == NodeIndex)
+			if (JointNodeIndex == NodeIndex)
 			{
 				return true;
 			}
@@ -2035,20 +2753,24 @@ bool FglTFRuntimeParser::FillFakeSkeleton(FReferenceSkeleton& RefSkeleton, TMap<
 
 
 bool FglTFRuntimeParser::GetRootBoneIndex(TSharedRef<FJsonObject> JsonSkinObject, int64& RootBoneIndex, TArray<int32>& Joints, const FglTFRuntimeSkeletonConfig& SkeletonConfig)
+{
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromJsonObject(JsonSkinObject);
+	return GetRootBoneIndex(*JsonTape, JsonTape->GetRootNode(), RootBoneIndex, Joints, SkeletonConfig);
+}
+
+bool FglTFRuntimeParser::GetRootBoneIndex(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonSkinNode, int64& RootBoneIndex, TArray<int32>& Joints, const FglTFRuntimeSkeletonConfig& SkeletonConfig)
 {
 	// get the list of valid joints	
-	const TArray<TSharedPtr<FJsonValue>>* JsonJoints;
-	if (JsonSkinObject->TryGetArrayField("joints", JsonJoints))
+	const int32 JsonJointsNode = JsonTape.GetArrayField(JsonSkinNode, "joints");
+	const int32 JointsNum = JsonTape.GetArrayNum(JsonJointsNode);
+	for (int32 JointIndex = 0; JointIndex < JointsNum; JointIndex++)
 	{
-		for (TSharedPtr<FJsonValue> JsonJoint : *JsonJoints)
+		int64 JointNodeIndex;
+		if (!JsonTape.TryGetNumber(JsonTape.GetArrayItem(JsonJointsNode, JointIndex), JointNodeIndex))
 		{
-			int64 JointIndex;
-			if (!JsonJoint->TryGetNumber(JointIndex))
-			{
-				return false;
-			}
-			Joints.Add(JointIndex);
+			return false;
 		}
+		Joints.Add(JointNodeIndex);
 	}
 
 	if (Joints.Num() == 0)
@@ -2071,7 +2793,7 @@ bool FglTFRuntimeParser::GetRootBoneIndex(TSharedRef<FJsonObject> JsonSkinObject
 			RootBoneIndex = RootNode.Index;
 		}
 	}
-	else if (JsonSkinObject->TryGetNumberField("skeleton", RootBoneIndex))
+	else if (JsonTape.TryGetNumberField(JsonSkinNode, "skeleton", RootBoneIndex))
 	{
 		// use the "skeleton" field as the root bone
 	}
@@ -2089,12 +2811,19 @@ bool FglTFRuntimeParser::GetRootBoneIndex(TSharedRef<FJsonObject> JsonSkinObject
 	return true;
 }
 
-bool FglTFRuntimeParser::FillReferenceSkeleton(TSharedRef<FJsonObject> JsonSkinObject, FReferenceSkeleton& RefSkeleton, TMap<int32, FName>& BoneMap, const FglTFRuntimeSkeletonConfig& SkeletonConfig)
+bool FglTFRuntimeParser::FillReferenceSkeleton(const int32 SkinIndex, FReferenceSkeleton& RefSkeleton, TMap<int32, FName>& BoneMap, const FglTFRuntimeSkeletonConfig& SkeletonConfig)
 {
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonSkinNode = JsonTape->GetRootArrayItem("skins", SkinIndex);
+	if (!JsonTape->IsObject(JsonSkinNode))
+	{
+		return false;
+	}
+
 	int64 RootBoneIndex = INDEX_NONE;
 	TArray<int32> Joints;
 
-	if (!GetRootBoneIndex(JsonSkinObject, RootBoneIndex, Joints, SkeletonConfig))
+	if (!GetRootBoneIndex(*JsonTape, JsonSkinNode, RootBoneIndex, Joints, SkeletonConfig))
 	{
 		return false;
 	}
@@ -2110,7 +2839,7 @@ bool FglTFRuntimeParser::FillReferenceSkeleton(TSharedRef<FJsonObject> JsonSkinO
 
 	TMap<int32, FMatrix> InverseBindMatricesMap;
 	int64 InverseBindMatricesIndex;
-	if (JsonSkinObject->TryGetNumberField("inverseBindMatrices", InverseBindMatricesIndex))
+	if (JsonTape->TryGetNumberField(JsonSkinNode, "inverseBindMatrices", InverseBindMatricesIndex))
 	{
 		FglTFRuntimeBlob InverseBindMatricesBytes;
 		int64 ComponentType, Stride, Elements, ElementSize, Count;
@@ -2157,7 +2886,10 @@ bool FglTFRuntimeParser::FillReferenceSkeleton(TSharedRef<FJsonObject> JsonSkinO
 		return false;
 	}
 
-	OnLoadedRefSkeleton.Broadcast(AsShared(), JsonSkinObject, Modifier);
+	if (OnLoadedRefSkeleton.IsBound())
+	{
+		OnLoadedRefSkeleton.Broadcast(AsShared(), JsonTape->ToJsonObject(JsonSkinNode), Modifier);
+	}
 
 	return true;
 }
@@ -2457,10 +3189,27 @@ bool FglTFRuntimeParser::TraverseJoints(FReferenceSkeletonModifier& Modifier, co
 }
 
 bool FglTFRuntimeParser::LoadPrimitives(TSharedRef<FJsonObject> JsonMeshObject, TArray<FglTFRuntimePrimitive>& Primitives, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+{
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromJsonObject(JsonMeshObject);
+	return LoadPrimitives(*JsonTape, JsonTape->GetRootNode(), Primitives, MaterialsConfig);
+}
+
+bool FglTFRuntimeParser::LoadPrimitives(const int32 MeshIndex, TArray<FglTFRuntimePrimitive>& Primitives, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+{
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonMeshNode = JsonTape->GetRootArrayItem("meshes", MeshIndex);
+	if (!JsonTape->IsObject(JsonMeshNode))
+	{
+		return false;
+	}
+	return LoadPrimitives(*JsonTape, JsonMeshNode, Primitives, MaterialsConfig);
+}
+
+bool FglTFRuntimeParser::LoadPrimitives(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonMeshNode, TArray<FglTFRuntimePrimitive>& Primitives, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
 {
 	// get primitives
-	const TArray<TSharedPtr<FJsonValue>>* JsonPrimitives;
-	if (!JsonMeshObject->TryGetArrayField("primitives", JsonPrimitives))
+	const int32 JsonPrimitivesNode = JsonTape.GetArrayField(JsonMeshNode, "primitives");
+	if (JsonPrimitivesNode == INDEX_NONE)
 	{
 		AddError("LoadPrimitives()", "No primitives defined in the asset.");
 		return false;
@@ -2468,16 +3217,33 @@ bool FglTFRuntimeParser::LoadPrimitives(TSharedRef<FJsonObject> JsonMeshObject,
 
 	int32 FirstPrimitive = Primitives.Num();
 
-	for (TSharedPtr<FJsonValue> JsonPrimitive : *JsonPrimitives)
+	const int32 PrimitivesNum = JsonTape.GetArrayNum(JsonPrimitivesNode);
+
+	// decode the textures of all the primitives materials in parallel before loading them one by one (unless the caller already did it, for example for a whole scene)
+	FglTFRuntimeMaterialsConfig PrefetchMaterialsConfig;
+	const FglTFRuntimeMaterialsConfig* PrimitivesMaterialsConfig = &MaterialsConfig;
+	if (!MaterialsConfig.PrefetchedTextures)
+	{
+		TArray<int32> MaterialsIndices;
+		GetMeshMaterials(JsonTape, JsonMeshNode, MaterialsIndices);
+		if (MaterialsIndices.Num() > 0)
+		{
+			PrefetchMaterialsConfig = MaterialsConfig;
+			PrefetchMaterialsConfig.PrefetchedTextures = PrefetchMaterialsTextures(MaterialsIndices, MaterialsConfig);
+			PrimitivesMaterialsConfig = &PrefetchMaterialsConfig;
+		}
+	}
+
+	for (int32 PrimitiveIndex = 0; PrimitiveIndex < PrimitivesNum; PrimitiveIndex++)
 	{
-		TSharedPtr<FJsonObject> JsonPrimitiveObject = JsonPrimitive->AsObject();
-		if (!JsonPrimitiveObject)
+		const int32 JsonPrimitiveNode = JsonTape.GetArrayItem(JsonPrimitivesNode, PrimitiveIndex);
+		if (!JsonTape.IsObject(JsonPrimitiveNode))
 		{
 			return false;
 		}
 
 		FglTFRuntimePrimitive Primitive;
-		if (!LoadPrimitive(JsonPrimitiveObject.ToSharedRef(), Primitive, MaterialsConfig))
+		if (!LoadPrimitive(JsonTape, JsonPrimitiveNode, Primitive, *PrimitivesMaterialsConfig))
 		{
 			return false;
 		}
@@ -2489,11 +3255,11 @@ bool FglTFRuntimeParser::LoadPrimitives(TSharedRef<FJsonObject> JsonMeshObject,
 		}
 	}
 
-	const TSharedPtr<FJsonObject>* JsonExtrasObject;
-	if (JsonMeshObject->TryGetObjectField("extras", JsonExtrasObject))
+	const int32 JsonExtrasNode = JsonTape.GetObjectField(JsonMeshNode, "extras");
+	if (JsonExtrasNode != INDEX_NONE)
 	{
-		const TArray<TSharedPtr<FJsonValue>>* JsonTargetNamesArray;
-		if ((*JsonExtrasObject)->TryGetArrayField("targetNames", JsonTargetNamesArray))
+		const int32 JsonTargetNamesNode = JsonTape.GetArrayField(JsonExtrasNode, "targetNames");
+		if (JsonTargetNamesNode != INDEX_NONE)
 		{
 			auto ApplyTargetName = [FirstPrimitive](TArray<FglTFRuntimePrimitive>& Primitives, const int32 TargetNameIndex, const FString& TargetName)
 				{
@@ -2512,9 +3278,10 @@ bool FglTFRuntimeParser::LoadPrimitives(TSharedRef<FJsonObject> JsonMeshObject,
 						}
 					}
 				};
-			for (int32 TargetNameIndex = 0; TargetNameIndex < JsonTargetNamesArray->Num(); TargetNameIndex++)
+			for (int32 TargetNameIndex = 0; TargetNameIndex < JsonTape.GetArrayNum(JsonTargetNamesNode); TargetNameIndex++)
 			{
-				const FString TargetName = (*JsonTargetNamesArray)[TargetNameIndex]->AsString();
+				FString TargetName;
+				JsonTape.TryGetString(JsonTape.GetArrayItem(JsonTargetNamesNode, TargetNameIndex), TargetName);
 				ApplyTargetName(Primitives, TargetNameIndex, TargetName);
 			}
 		}
@@ -2577,26 +3344,318 @@ FVector4 FglTFRuntimeParser::TransformVector4(FVector4 Vector) const
 	return SceneBasis.TransformFVector4(Vector);
 }
 
-bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObject, FglTFRuntimePrimitive& Primitive, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+bool FglTFRuntimeParser::GetPrimitiveDerivedDataKey(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonPrimitiveNode, FSHAHash& Key)
 {
-	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadPrimitive, FColor::Magenta);
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_GetPrimitiveDerivedDataKey, FColor::Magenta);
 
-	OnPreLoadedPrimitive.Broadcast(AsShared(), JsonPrimitiveObject, Primitive);
+	FglTFRuntimeDerivedDataKey DerivedDataKey(TEXT("primitive"));
 
-	if (!JsonPrimitiveObject->TryGetNumberField("mode", Primitive.Mode))
-	{
-		Primitive.Mode = 4; // triangles
-	}
+	TArray<uint8> DescriptionBytes;
+	JsonTape.AppendNodeBytes(JsonPrimitiveNode, DescriptionBytes);
 
-	const TSharedPtr<FJsonObject>* JsonAttributesObject;
-	if (!JsonPrimitiveObject->TryGetObjectField("attributes", JsonAttributesObject))
+	DerivedDataKey.Update(SceneBasis);
+	DerivedDataKey.Update(SceneScale);
+	DerivedDataKey.Update(ExtensionsRequired.Contains("KHR_mesh_quantization"));
+
+	// the key describes where the data comes from (accessors, buffer views and the identity of their buffers) without reading it
+	TArray<int64> AccessorsIndices;
+	auto AddAccessors = [&JsonTape, &AccessorsIndices](const int32 JsonObjectNode)
+		{
+			JsonTape.ForEachField(JsonObjectNode, [&JsonTape, &AccessorsIndices](const FString& FieldName, const int32 ValueNode)
+				{
+					int64 AccessorIndex;
+					if (JsonTape.TryGetNumber(ValueNode, AccessorIndex))
+					{
+						AccessorsIndices.Add(AccessorIndex);
+					}
+				});
+		};
+
+	AddAccessors(JsonTape.GetObjectField(JsonPrimitiveNode, "attributes"));
+
+	const int32 JsonTargetsNode = JsonTape.GetArrayField(JsonPrimitiveNode, "targets");
+	for (int32 TargetIndex = 0; TargetIndex < JsonTape.GetArrayNum(JsonTargetsNode); TargetIndex++)
+	{
+		AddAccessors(JsonTape.GetArrayItem(JsonTargetsNode, TargetIndex));
+	}
+
+	int64 IndicesAccessorIndex;
+	if (JsonTape.TryGetNumberField(JsonPrimitiveNode, "indices", IndicesAccessorIndex))
+	{
+		AccessorsIndices.Add(IndicesAccessorIndex);
+	}
+
+	// compressed primitives (like KHR_draco_mesh_compression) reference their buffer view from the extension
+	TArray<int64> BufferViewsIndices;
+	auto AddExtensionsIndices = [](const FglTFRuntimeJsonTape& InJsonTape, const int32 JsonObjectNode, const ANSICHAR* FieldName, TArray<int64>& Indices)
+		{
+			InJsonTape.ForEachField(InJsonTape.GetObjectField(JsonObjectNode, "extensions"), [&InJsonTape, FieldName, &Indices](const FString& ExtensionName, const int32 ExtensionNode)
+				{
+					int64 Index;
+					if (InJsonTape.TryGetNumberField(ExtensionNode, FieldName, Index))
+					{
+						Indices.Add(Index);
+					}
+				});
+		};
+
+	AddExtensionsIndices(JsonTape, JsonPrimitiveNode, "bufferView", BufferViewsIndices);
+
+	// the primitive could come from a standalone tape, accessors always live in the asset one
+	const TSharedRef<FglTFRuntimeJsonTape> AssetJsonTape = GetJsonTape();
+
+	for (const int64 AccessorIndex : AccessorsIndices)
+	{
+		const int32 JsonAccessorNode = AssetJsonTape->GetRootArrayItem("accessors", static_cast<int32>(AccessorIndex));
+		if (!AssetJsonTape->IsObject(JsonAccessorNode))
+		{
+			return false;
+		}
+
+		AssetJsonTape->AppendNodeBytes(JsonAccessorNode, DescriptionBytes);
+
+		int64 BufferViewIndex;
+		if (AssetJsonTape->TryGetNumberField(JsonAccessorNode, "bufferView", BufferViewIndex))
+		{
+			BufferViewsIndices.Add(BufferViewIndex);
+		}
+
+		const int32 JsonSparseNode = AssetJsonTape->GetObjectField(JsonAccessorNode, "sparse");
+		if (AssetJsonTape->TryGetNumberField(AssetJsonTape->GetObjectField(JsonSparseNode, "indices"), "bufferView", BufferViewIndex))
+		{
+			BufferViewsIndices.Add(BufferViewIndex);
+		}
+		if (AssetJsonTape->TryGetNumberField(AssetJsonTape->GetObjectField(JsonSparseNode, "values"), "bufferView", BufferViewIndex))
+		{
+			BufferViewsIndices.Add(BufferViewIndex);
+		}
+	}
+
+	// meshopt compressed buffer views reference the buffer of the compressed data from the extension
+	TArray<int64> BuffersIndices;
+	for (const int64 BufferViewIndex : BufferViewsIndices)
+	{
+		const int32 JsonBufferViewNode = AssetJsonTape->GetRootArrayItem("bufferViews", static_cast<int32>(BufferViewIndex));
+		if (!AssetJsonTape->IsObject(JsonBufferViewNode))
+		{
+			return false;
+		}
+
+		AssetJsonTape->AppendNodeBytes(JsonBufferViewNode, DescriptionBytes);
+
+		int64 BufferIndex;
+		if (AssetJsonTape->TryGetNumberField(JsonBufferViewNode, "buffer", BufferIndex))
+		{
+			BuffersIndices.AddUnique(BufferIndex);
+		}
+		AddExtensionsIndices(*AssetJsonTape, JsonBufferViewNode, "buffer", BuffersIndices);
+	}
+
+	DerivedDataKey.UpdateBytes(DescriptionBytes.GetData(), DescriptionBytes.Num());
+
+	for (const int64 BufferIndex : BuffersIndices)
+	{
+		FSHAHash BufferIdentity;
+		if (!GetBufferIdentity(static_cast<int32>(BufferIndex), BufferIdentity))
+		{
+			return false;
+		}
+		DerivedDataKey.Update(BufferIndex);
+		DerivedDataKey.Update(BufferIdentity);
+	}
+
+	Key = DerivedDataKey.Finalize();
+	return true;
+}
+
+bool FglTFRuntimeParser::GetBufferIdentity(const int32 Index, FSHAHash& Identity)
+{
+	{
+		FScopeLock Lock(&BuffersCacheLock);
+		if (const FSHAHash* CachedIdentity = BuffersIdentitiesCache.Find(Index))
+		{
+			Identity = *CachedIdentity;
+			return true;
+		}
+	}
+
+	FglTFRuntimeDerivedDataKey IdentityKey(TEXT("buffer"));
+
+	// follows the same lookup order of GetBuffer()
+	const bool bIsBinaryChunk = Index == 0 && (BinaryBuffer.Num() > 0 || BinaryMappedFile);
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonBufferNode = JsonTape->GetRootArrayItem("buffers", Index);
+	FString Uri;
+	if (!bIsBinaryChunk && (!JsonTape->IsObject(JsonBufferNode) || !JsonTape->TryGetStringField(JsonBufferNode, "uri", Uri)))
+	{
+		return false;
+	}
+
+	if (!bIsBinaryChunk && !Uri.StartsWith("data:") && !(ZipFile && ZipFile->FileExists(Uri)) && !BaseDirectory.IsEmpty())
+	{
+		// external files are identified by their stats, so they are never read for building a key
+		const FString BufferFilename = FPaths::ConvertRelativePathToFull(FPaths::Combine(BaseDirectory, Uri));
+		const FFileStatData StatData = IFileManager::Get().GetStatData(*BufferFilename);
+		if (!StatData.bIsValid || StatData.bIsDirectory)
+		{
+			return false;
+		}
+
+		IdentityKey.Update(BufferFilename);
+		IdentityKey.Update(StatData.FileSize);
+		IdentityKey.Update(StatData.ModificationTime.GetTicks());
+	}
+	else
+	{
+		// embedded data (glb chunk, data uri or zip entry) is hashed once per asset
+		FglTFRuntimeBlob Blob;
+		if (!GetBuffer(Index, Blob))
+		{
+			return false;
+		}
+		IdentityKey.UpdateBytes(Blob.Data, Blob.Num);
+	}
+
+	Identity = IdentityKey.Finalize();
+
+	FScopeLock Lock(&BuffersCacheLock);
+	BuffersIdentitiesCache.Add(Index, Identity);
+	return true;
+}
+
+bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObject, FglTFRuntimePrimitive& Primitive, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+{
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = FglTFRuntimeJsonTape::FromJsonObject(JsonPrimitiveObject);
+	return LoadPrimitive(*JsonTape, JsonTape->GetRootNode(), Primitive, MaterialsConfig);
+}
+
+bool FglTFRuntimeParser::LoadPrimitive(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonPrimitiveNode, FglTFRuntimePrimitive& Primitive, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadPrimitive, FColor::Magenta);
+
+	if (OnPreLoadedPrimitive.IsBound())
+	{
+		OnPreLoadedPrimitive.Broadcast(AsShared(), JsonTape.ToJsonObject(JsonPrimitiveNode).ToSharedRef(), Primitive);
+	}
+
+	// plugins hooking OnPreLoadedPrimitive can change the decoding, so they always bypass the cache
+	FSHAHash DerivedDataKey;
+	const bool bUseDerivedDataCache = DerivedDataCache && !OnPreLoadedPrimitive.IsBound() && GetPrimitiveDerivedDataKey(JsonTape, JsonPrimitiveNode, DerivedDataKey);
+
+	bool bLoadedFromDerivedDataCache = false;
+	if (bUseDerivedDataCache)
+	{
+		const uint8* PayloadData = nullptr;
+		int64 PayloadNum = 0;
+		TSharedPtr<FglTFRuntimeMappedFile> MappedFile = DerivedDataCache->Load(DerivedDataKey, PayloadData, PayloadNum);
+		if (MappedFile)
+		{
+			FglTFRuntimeDerivedDataReader Reader(PayloadData, PayloadNum);
+			bLoadedFromDerivedDataCache = ReadPrimitiveGeometry(Reader, Primitive);
+			if (!bLoadedFromDerivedDataCache)
+			{
+				Primitive = FglTFRuntimePrimitive();
+			}
+		}
+	}
+
+	if (!bLoadedFromDerivedDataCache)
+	{
+		if (!LoadPrimitiveGeometry(JsonTape, JsonPrimitiveNode, Primitive))
+		{
+			return false;
+		}
+
+		if (bUseDerivedDataCache)
+		{
+			FglTFRuntimeDerivedDataWriter Writer;
+			WritePrimitiveGeometry(Writer, Primitive);
+			DerivedDataCache->Save(DerivedDataKey, Writer.Bytes);
+		}
+	}
+
+	Primitive.Material = UMaterial::GetDefaultMaterial(MD_Surface);
+
+	if (!MaterialsConfig.bSkipLoad)
+	{
+		int64 MaterialIndex = INDEX_NONE;
+		if (!MaterialsConfig.Variant.IsEmpty() && MaterialsVariants.Contains(MaterialsConfig.Variant))
+		{
+			int32 WantedIndex = MaterialsVariants.IndexOfByKey(MaterialsConfig.Variant);
+			const int32 JsonMappingsNode = JsonTape.GetArrayField(JsonTape.GetObjectField(JsonTape.GetObjectField(JsonPrimitiveNode, "extensions"), "KHR_materials_variants"), "mappings");
+			bool bMappingFound = false;
+			for (int32 MappingIndex = 0; MappingIndex < JsonTape.GetArrayNum(JsonMappingsNode); MappingIndex++)
+			{
+				const int32 JsonMappingNode = JsonTape.GetArrayItem(JsonMappingsNode, MappingIndex);
+				const int32 JsonVariantsNode = JsonTape.GetArrayField(JsonMappingNode, "variants");
+				for (int32 VariantItemIndex = 0; VariantItemIndex < JsonTape.GetArrayNum(JsonVariantsNode); VariantItemIndex++)
+				{
+					int64 VariantIndex;
+					if (JsonTape.TryGetNumber(JsonTape.GetArrayItem(JsonVariantsNode, VariantItemIndex), VariantIndex) && VariantIndex == WantedIndex)
+					{
+						MaterialIndex = JsonTape.GetIndexField(JsonMappingNode, "material", 0);
+						bMappingFound = true;
+						break;
+					}
+				}
+				if (bMappingFound)
+				{
+					break;
+				}
+			}
+		}
+
+		if (MaterialIndex == INDEX_NONE)
+		{
+			if (!JsonTape.TryGetNumberField(JsonPrimitiveNode, "material", MaterialIndex))
+			{
+				MaterialIndex = INDEX_NONE;
+			}
+		}
+
+		if (MaterialIndex != INDEX_NONE)
+		{
+			Primitive.Material = LoadMaterial(MaterialIndex, MaterialsConfig, Primitive.Colors.Num() > 0, Primitive.MaterialName);
+			if (!Primitive.Material)
+			{
+				AddError("LoadPrimitive()", FString::Printf(TEXT("Unable to load material %lld"), MaterialIndex));
+				return false;
+			}
+			Primitive.bHasMaterial = true;
+		}
+		// special case for primitives without a material but with a color buffer
+		else if (Primitive.Colors.Num() > 0)
+		{
+			Primitive.Material = BuildVertexColorOnlyMaterial(MaterialsConfig);
+		}
+	}
+
+	if (OnLoadedPrimitive.IsBound())
+	{
+		OnLoadedPrimitive.Broadcast(AsShared(), JsonTape.ToJsonObject(JsonPrimitiveNode).ToSharedRef(), Primitive);
+	}
+
+	return true;
+}
+
+bool FglTFRuntimeParser::LoadPrimitiveGeometry(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonPrimitiveNode, FglTFRuntimePrimitive& Primitive)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadPrimitiveGeometry, FColor::Magenta);
+
+	if (!JsonTape.TryGetNumberField(JsonPrimitiveNode, "mode", Primitive.Mode))
+	{
+		Primitive.Mode = 4; // triangles
+	}
+
+	const int32 JsonAttributesNode = JsonTape.GetObjectField(JsonPrimitiveNode, "attributes");
+	if (JsonAttributesNode == INDEX_NONE)
 	{
 		AddError("LoadPrimitive()", "No attributes array available");
 		return false;
 	}
 
 	// POSITION is required for generating a valid Mesh
-	if (!(*JsonAttributesObject)->HasField("POSITION"))
+	if (!JsonTape.FindField(JsonAttributesNode, "POSITION") != INDEX_NONE)
 	{
 		AddError("LoadPrimitive()", "POSITION attribute is required");
 		return false;
@@ -2617,16 +3676,16 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		SupportedTexCoordComponentTypes.Append({ 5120, 5122 });
 	}
 
-	if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "POSITION", Primitive.Positions,
+	if (!BuildFromAccessorField(JsonTape, JsonAttributesNode, "POSITION", Primitive.Positions,
 		{ 3 }, SupportedPositionComponentTypes, [&](FVector Value) -> FVector {return SceneBasis.TransformPosition(Value) * SceneScale; }, Primitive.AdditionalBufferView, false, nullptr))
 	{
 		AddError("LoadPrimitive()", "Unable to load POSITION attribute");
 		return false;
 	}
 
-	if ((*JsonAttributesObject)->HasField("NORMAL"))
+	if (JsonTape.FindField(JsonAttributesNode, "NORMAL") != INDEX_NONE)
 	{
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "NORMAL", Primitive.Normals,
+		if (!BuildFromAccessorField(JsonTape, JsonAttributesNode, "NORMAL", Primitive.Normals,
 			{ 3 }, SupportedNormalComponentTypes, [&](FVector Value) -> FVector { return SceneBasis.TransformVector(Value); }, Primitive.AdditionalBufferView, true, nullptr))
 		{
 			AddError("LoadPrimitive()", "Unable to load NORMAL attribute");
@@ -2634,9 +3693,9 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		}
 	}
 
-	if ((*JsonAttributesObject)->HasField("TANGENT"))
+	if (JsonTape.FindField(JsonAttributesNode, "TANGENT") != INDEX_NONE)
 	{
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "TANGENT", Primitive.Tangents,
+		if (!BuildFromAccessorField(JsonTape, JsonAttributesNode, "TANGENT", Primitive.Tangents,
 			{ 4 }, SupportedTangentComponentTypes, [&](FVector4 Value) -> FVector4 { return SceneBasis.TransformFVector4(Value); }, Primitive.AdditionalBufferView, true, nullptr))
 		{
 			AddError("LoadPrimitive()", "Unable to load TANGENT attribute");
@@ -2644,11 +3703,11 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		}
 	}
 
-	if ((*JsonAttributesObject)->HasField("TEXCOORD_0"))
+	if (JsonTape.FindField(JsonAttributesNode, "TEXCOORD_0") != INDEX_NONE)
 	{
 		TArray<FVector2D> UV;
 		int64 TexCoordComponentType = 0;
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "TEXCOORD_0", UV,
+		if (!BuildFromAccessorField(JsonTape, JsonAttributesNode, "TEXCOORD_0", UV,
 			{ 2 }, SupportedTexCoordComponentTypes, [&](FVector2D Value) -> FVector2D {return FVector2D(Value.X, Value.Y); }, Primitive.AdditionalBufferView, !bHasMeshQuantization, &TexCoordComponentType))
 		{
 			AddError("LoadPrimitive()", "Error loading TEXCOORD_0");
@@ -2663,11 +3722,11 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		Primitive.UVs.Add(UV);
 	}
 
-	if ((*JsonAttributesObject)->HasField("TEXCOORD_1"))
+	if (JsonTape.FindField(JsonAttributesNode, "TEXCOORD_1") != INDEX_NONE)
 	{
 		TArray<FVector2D> UV;
 		int64 TexCoordComponentType = 0;
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "TEXCOORD_1", UV,
+		if (!BuildFromAccessorField(JsonTape, JsonAttributesNode, "TEXCOORD_1", UV,
 			{ 2 }, SupportedTexCoordComponentTypes, [&](FVector2D Value) -> FVector2D {return FVector2D(Value.X, Value.Y); }, Primitive.AdditionalBufferView, !bHasMeshQuantization, &TexCoordComponentType))
 		{
 			AddError("LoadPrimitive()", "Error loading TEXCOORD_1");
@@ -2682,10 +3741,10 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		Primitive.UVs.Add(UV);
 	}
 
-	if ((*JsonAttributesObject)->HasField("JOINTS_0"))
+	if (JsonTape.FindField(JsonAttributesNode, "JOINTS_0") != INDEX_NONE)
 	{
 		TArray<FglTFRuntimeUInt16Vector4> Joints;
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "JOINTS_0", Joints,
+		if (!BuildFromAccessorField(JsonTape, JsonAttributesNode, "JOINTS_0", Joints,
 			{ 4 }, { 5121, 5123 }, Primitive.AdditionalBufferView, false, nullptr))
 		{
 			AddError("LoadPrimitive()", "Error loading JOINTS_0");
@@ -2695,10 +3754,10 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		Primitive.Joints.Add(Joints);
 	}
 
-	if ((*JsonAttributesObject)->HasField("JOINTS_1"))
+	if (JsonTape.FindField(JsonAttributesNode, "JOINTS_1") != INDEX_NONE)
 	{
 		TArray<FglTFRuntimeUInt16Vector4> Joints;
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "JOINTS_1", Joints,
+		if (!BuildFromAccessorField(JsonTape, JsonAttributesNode, "JOINTS_1", Joints,
 			{ 4 }, { 5121, 5123 }, Primitive.AdditionalBufferView, false, nullptr))
 		{
 			AddError("LoadPrimitive()", "Error loading JOINTS_1");
@@ -2708,10 +3767,10 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		Primitive.Joints.Add(Joints);
 	}
 
-	if ((*JsonAttributesObject)->HasField("JOINTS_2"))
+	if (JsonTape.FindField(JsonAttributesNode, "JOINTS_2") != INDEX_NONE)
 	{
 		TArray<FglTFRuntimeUInt16Vector4> Joints;
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "JOINTS_2", Joints,
+		if (!BuildFromAccessorField(JsonTape, JsonAttributesNode, "JOINTS_2", Joints,
 			{ 4 }, { 5121, 5123 }, Primitive.AdditionalBufferView, false, nullptr))
 		{
 			AddError("LoadPrimitive()", "Error loading JOINTS_2");
@@ -2721,11 +3780,11 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		Primitive.Joints.Add(Joints);
 	}
 
-	if ((*JsonAttributesObject)->HasField("WEIGHTS_0"))
+	if (JsonTape.FindField(JsonAttributesNode, "WEIGHTS_0") != INDEX_NONE)
 	{
 		TArray<FVector4> Weights;
 		int64 WeightsComponentType = 0;
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "WEIGHTS_0", Weights,
+		if (!BuildFromAccessorField(JsonTape, JsonAttributesNode, "WEIGHTS_0", Weights,
 			{ 4 }, { 5126, 5121, 5123 }, Primitive.AdditionalBufferView, true, &WeightsComponentType))
 		{
 			AddError("LoadPrimitive()", "Error loading WEIGHTS_0");
@@ -2740,11 +3799,11 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		Primitive.Weights.Add(Weights);
 	}
 
-	if ((*JsonAttributesObject)->HasField("WEIGHTS_1"))
+	if (JsonTape.FindField(JsonAttributesNode, "WEIGHTS_1") != INDEX_NONE)
 	{
 		TArray<FVector4> Weights;
 		int64 WeightsComponentType = 0;
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "WEIGHTS_1", Weights,
+		if (!BuildFromAccessorField(JsonTape, JsonAttributesNode, "WEIGHTS_1", Weights,
 			{ 4 }, { 5126, 5121, 5123 }, Primitive.AdditionalBufferView, true, &WeightsComponentType))
 		{
 			AddError("LoadPrimitive()", "Error loading WEIGHTS_1");
@@ -2759,11 +3818,11 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		Primitive.Weights.Add(Weights);
 	}
 
-	if ((*JsonAttributesObject)->HasField("WEIGHTS_2"))
+	if (JsonTape.FindField(JsonAttributesNode, "WEIGHTS_2") != INDEX_NONE)
 	{
 		TArray<FVector4> Weights;
 		int64 WeightsComponentType = 0;
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "WEIGHTS_2", Weights,
+		if (!BuildFromAccessorField(JsonTape, JsonAttributesNode, "WEIGHTS_2", Weights,
 			{ 4 }, { 5126, 5121, 5123 }, Primitive.AdditionalBufferView, true, &WeightsComponentType))
 		{
 			AddError("LoadPrimitive()", "Error loading WEIGHTS_2");
@@ -2778,9 +3837,9 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		Primitive.Weights.Add(Weights);
 	}
 
-	if ((*JsonAttributesObject)->HasField("COLOR_0"))
+	if (JsonTape.FindField(JsonAttributesNode, "COLOR_0") != INDEX_NONE)
 	{
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "COLOR_0", Primitive.Colors,
+		if (!BuildFromAccessorField(JsonTape, JsonAttributesNode, "COLOR_0", Primitive.Colors,
 			{ 3, 4 }, { 5126, 5121, 5123 }, Primitive.AdditionalBufferView, true, nullptr))
 		{
 			AddError("LoadPrimitive()", "Error loading COLOR_0");
@@ -2788,13 +3847,13 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		}
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonTargetsArray;
-	if (JsonPrimitiveObject->TryGetArrayField("targets", JsonTargetsArray))
+	const int32 JsonTargetsNode = JsonTape.GetArrayField(JsonPrimitiveNode, "targets");
+	if (JsonTargetsNode != INDEX_NONE)
 	{
-		for (TSharedPtr<FJsonValue> JsonTargetItem : *JsonTargetsArray)
+		for (int32 TargetIndex = 0; TargetIndex < JsonTape.GetArrayNum(JsonTargetsNode); TargetIndex++)
 		{
-			TSharedPtr<FJsonObject> JsonTargetObject = JsonTargetItem->AsObject();
-			if (!JsonTargetObject)
+			const int32 JsonTargetNode = JsonTape.GetArrayItem(JsonTargetsNode, TargetIndex);
+			if (!JsonTape.IsObject(JsonTargetNode))
 			{
 				AddError("LoadPrimitive()", "Error on MorphTarget item: expected an object.");
 				return false;
@@ -2804,9 +3863,9 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 
 			bool bValid = false;
 
-			if (JsonTargetObject->HasField("POSITION"))
+			if (JsonTape.FindField(JsonTargetNode, "POSITION") != INDEX_NONE)
 			{
-				if (!BuildFromAccessorField(JsonTargetObject.ToSharedRef(), "POSITION", MorphTarget.Positions,
+				if (!BuildFromAccessorField(JsonTape, JsonTargetNode, "POSITION", MorphTarget.Positions,
 					{ 3 }, SupportedPositionComponentTypes, [&](FVector Value) -> FVector { return SceneBasis.TransformPosition(Value) * SceneScale; }, INDEX_NONE, false, nullptr))
 				{
 					AddError("LoadPrimitive()", "Unable to load POSITION attribute for MorphTarget");
@@ -2820,9 +3879,9 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 				bValid = true;
 			}
 
-			if (JsonTargetObject->HasField("NORMAL"))
+			if (JsonTape.FindField(JsonTargetNode, "NORMAL") != INDEX_NONE)
 			{
-				if (!BuildFromAccessorField(JsonTargetObject.ToSharedRef(), "NORMAL", MorphTarget.Normals,
+				if (!BuildFromAccessorField(JsonTape, JsonTargetNode, "NORMAL", MorphTarget.Normals,
 					{ 3 }, SupportedNormalComponentTypes, [&](FVector Value) -> FVector { return SceneBasis.TransformVector(Value); }, INDEX_NONE, true, nullptr))
 				{
 					AddError("LoadPrimitive()", "Unable to load NORMAL attribute for MorphTarget");
@@ -2844,7 +3903,7 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 	}
 
 	int64 IndicesAccessorIndex;
-	if (JsonPrimitiveObject->TryGetNumberField("indices", IndicesAccessorIndex))
+	if (JsonTape.TryGetNumberField(JsonPrimitiveNode, "indices", IndicesAccessorIndex))
 	{
 		FglTFRuntimeBlob IndicesBytes;
 		int64 ComponentType, Stride, Elements, ElementSize, Count;
@@ -2866,33 +3925,25 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 			return false;
 		}
 
-		Primitive.Indices.AddUninitialized(Count);
-		for (int64 i = 0; i < Count; i++)
+		if (ComponentType != 5121 && ComponentType != 5123 && ComponentType != 5125)
 		{
-			int64 IndexIndex = i * Stride;
-
-			uint32 VertexIndex;
-			if (ComponentType == 5121)
-			{
-				VertexIndex = IndicesBytes.Data[IndexIndex];
-			}
-			else if (ComponentType == 5123)
-			{
-				uint16* IndexPtr = (uint16*)&(IndicesBytes.Data[IndexIndex]);
-				VertexIndex = *IndexPtr;
-			}
-			else if (ComponentType == 5125)
-			{
-				uint32* IndexPtr = (uint32*)&(IndicesBytes.Data[IndexIndex]);
-				VertexIndex = *IndexPtr;
-			}
-			else
-			{
-				AddError("LoadPrimitive()", FString::Printf(TEXT("Invalid component type for indices: %lld"), ComponentType));
-				return false;
-			}
+			AddError("LoadPrimitive()", FString::Printf(TEXT("Invalid component type for indices: %lld"), ComponentType));
+			return false;
+		}
 
-			Primitive.Indices[i] = VertexIndex;
+		const int64 FirstIndex = Primitive.Indices.AddUninitialized(Count);
+		uint32* Indices = Primitive.Indices.GetData() + FirstIndex;
+		if (ComponentType == 5121)
+		{
+			DecodeIndicesWithStride<uint8>(IndicesBytes.Data, Stride, Count, Indices);
+		}
+		else if (ComponentType == 5123)
+		{
+			DecodeIndicesWithStride<uint16>(IndicesBytes.Data, Stride, Count, Indices);
+		}
+		else
+		{
+			DecodeIndicesWithStride<uint32>(IndicesBytes.Data, Stride, Count, Indices);
 		}
 	}
 	else
@@ -2946,66 +3997,6 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 		Primitive.Indices = FanIndices;
 	}
 
-	Primitive.Material = UMaterial::GetDefaultMaterial(MD_Surface);
-
-	if (!MaterialsConfig.bSkipLoad)
-	{
-		int64 MaterialIndex = INDEX_NONE;
-		if (!MaterialsConfig.Variant.IsEmpty() && MaterialsVariants.Contains(MaterialsConfig.Variant))
-		{
-			int32 WantedIndex = MaterialsVariants.IndexOfByKey(MaterialsConfig.Variant);
-			TArray<TSharedRef<FJsonObject>> VariantsMappings = GetJsonObjectArrayFromExtension(JsonPrimitiveObject, "KHR_materials_variants", "mappings");
-			bool bMappingFound = false;
-			for (TSharedRef<FJsonObject> VariantsMapping : VariantsMappings)
-			{
-				const TArray<TSharedPtr<FJsonValue>>* Variants;
-				if (VariantsMapping->TryGetArrayField("variants", Variants))
-				{
-					for (TSharedPtr<FJsonValue> Variant : (*Variants))
-					{
-						int64 VariantIndex;
-						if (Variant->TryGetNumber(VariantIndex) && VariantIndex == WantedIndex)
-						{
-							MaterialIndex = VariantsMapping->GetNumberField("material");
-							bMappingFound = true;
-							break;
-						}
-					}
-				}
-				if (bMappingFound)
-				{
-					break;
-				}
-			}
-		}
-
-		if (MaterialIndex == INDEX_NONE)
-		{
-			if (!JsonPrimitiveObject->TryGetNumberField("material", MaterialIndex))
-			{
-				MaterialIndex = INDEX_NONE;
-			}
-		}
-
-		if (MaterialIndex != INDEX_NONE)
-		{
-			Primitive.Material = LoadMaterial(MaterialIndex, MaterialsConfig, Primitive.Colors.Num() > 0, Primitive.MaterialName);
-			if (!Primitive.Material)
-			{
-				AddError("LoadPrimitive()", FString::Printf(TEXT("Unable to load material %lld"), MaterialIndex));
-				return false;
-			}
-			Primitive.bHasMaterial = true;
-		}
-		// special case for primitives without a material but with a color buffer
-		else if (Primitive.Colors.Num() > 0)
-		{
-			Primitive.Material = BuildVertexColorOnlyMaterial(MaterialsConfig);
-		}
-	}
-
-	OnLoadedPrimitive.Broadcast(AsShared(), JsonPrimitiveObject, Primitive);
-
 	return true;
 }
 
@@ -3024,41 +4015,33 @@ bool FglTFRuntimeParser::GetBuffer(const int32 Index, FglTFRuntimeBlob& Blob)
 		return true;
 	}
 
-	// first check cache
-	if (BuffersCache.Contains(Index))
+	if (Index == 0 && BinaryMappedFile)
 	{
-		Blob.Data = BuffersCache[Index].GetData();
-		Blob.Num = BuffersCache[Index].Num();
+		Blob = BinaryMappedBlob;
 		return true;
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonBuffers;
-
-	// no buffers ?
-	if (!Root->TryGetArrayField("buffers", JsonBuffers))
-	{
-		return false;
-	}
-
-	if (Index >= JsonBuffers->Num())
+	// first check cache
+	if (GetCachedBuffer(Index, Blob))
 	{
-		return false;
+		return true;
 	}
 
-	TSharedPtr<FJsonObject> JsonBufferObject = (*JsonBuffers)[Index]->AsObject();
-	if (!JsonBufferObject)
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonBufferNode = JsonTape->GetRootArrayItem("buffers", Index);
+	if (!JsonTape->IsObject(JsonBufferNode))
 	{
 		return false;
 	}
 
 	int64 ByteLength;
-	if (!JsonBufferObject->TryGetNumberField("byteLength", ByteLength))
+	if (!JsonTape->TryGetNumberField(JsonBufferNode, "byteLength", ByteLength))
 	{
 		return false;
 	}
 
 	FString Uri;
-	if (!JsonBufferObject->TryGetStringField("uri", Uri))
+	if (!JsonTape->TryGetStringField(JsonBufferNode, "uri", Uri))
 	{
 		return false;
 	}
@@ -3069,9 +4052,7 @@ bool FglTFRuntimeParser::GetBuffer(const int32 Index, FglTFRuntimeBlob& Blob)
 		TArray64<uint8> Base64Data;
 		if (ParseBase64Uri(Uri, Base64Data))
 		{
-			BuffersCache.Add(Index, Base64Data);
-			Blob.Data = BuffersCache[Index].GetData();
-			Blob.Num = BuffersCache[Index].Num();
+			AddCachedBuffer(Index, MoveTemp(Base64Data), Blob);
 			return true;
 		}
 		return false;
@@ -3082,9 +4063,7 @@ bool FglTFRuntimeParser::GetBuffer(const int32 Index, FglTFRuntimeBlob& Blob)
 		TArray64<uint8> ZipData;
 		if (ZipFile->GetFileContent(Uri, ZipData))
 		{
-			BuffersCache.Add(Index, ZipData);
-			Blob.Data = BuffersCache[Index].GetData();
-			Blob.Num = BuffersCache[Index].Num();
+			AddCachedBuffer(Index, MoveTemp(ZipData), Blob);
 			return true;
 		}
 	}
@@ -3092,20 +4071,68 @@ bool FglTFRuntimeParser::GetBuffer(const int32 Index, FglTFRuntimeBlob& Blob)
 	// fallback
 	if (!BaseDirectory.IsEmpty())
 	{
-		TArray64<uint8> FileData;
-		if (FFileHelper::LoadFileToArray(FileData, *FPaths::Combine(BaseDirectory, Uri)))
+		const FString BufferFilename = FPaths::Combine(BaseDirectory, Uri);
+
+		TSharedPtr<FglTFRuntimeMappedFile> MappedBuffer = bUseMemoryMappedFiles ? FglTFRuntimeMappedFile::Open(BufferFilename) : nullptr;
+		if (MappedBuffer)
 		{
-			BuffersCache.Add(Index, FileData);
-			Blob.Data = BuffersCache[Index].GetData();
-			Blob.Num = BuffersCache[Index].Num();
+			FScopeLock Lock(&BuffersCacheLock);
+			// another thread could have loaded the same buffer in the meantime, keep the first one as blobs may already point to it
+			if (!GetCachedBuffer(Index, Blob))
+			{
+				MappedBuffersCache.Add(Index, MappedBuffer);
+				Blob.Data = const_cast<uint8*>(MappedBuffer->GetData());
+				Blob.Num = MappedBuffer->GetSize();
+			}
 			return true;
 		}
-	}
+
+		TArray64<uint8> FileData;
+		if (FFileHelper::LoadFileToArray(FileData, *BufferFilename))
+		{
+			AddCachedBuffer(Index, MoveTemp(FileData), Blob);
+			return true;
+		}
+	}
 
 	AddError("GetBuffer()", FString::Printf(TEXT("Unable to load buffer %d from Uri %s (you may want to enable external files loading...)"), Index, *Uri));
 	return false;
 }
 
+bool FglTFRuntimeParser::GetCachedBuffer(const int32 Index, FglTFRuntimeBlob& Blob)
+{
+	FScopeLock Lock(&BuffersCacheLock);
+
+	if (TArray64<uint8>* Buffer = BuffersCache.Find(Index))
+	{
+		Blob.Data = Buffer->GetData();
+		Blob.Num = Buffer->Num();
+		return true;
+	}
+
+	if (TSharedPtr<FglTFRuntimeMappedFile>* MappedBuffer = MappedBuffersCache.Find(Index))
+	{
+		Blob.Data = const_cast<uint8*>((*MappedBuffer)->GetData());
+		Blob.Num = (*MappedBuffer)->GetSize();
+		return true;
+	}
+
+	return false;
+}
+
+void FglTFRuntimeParser::AddCachedBuffer(const int32 Index, TArray64<uint8>&& Buffer, FglTFRuntimeBlob& Blob)
+{
+	FScopeLock Lock(&BuffersCacheLock);
+
+	// the data of the cached arrays does not move when the map grows, so blobs stay valid
+	if (!GetCachedBuffer(Index, Blob))
+	{
+		TArray64<uint8>& CachedBuffer = BuffersCache.Add(Index, MoveTemp(Buffer));
+		Blob.Data = CachedBuffer.GetData();
+		Blob.Num = CachedBuffer.Num();
+	}
+}
+
 bool FglTFRuntimeParser::ParseBase64Uri(const FString& Uri, TArray64<uint8>& Bytes)
 {
 	const FString Base64Signature = ";base64,";
@@ -3129,27 +4156,30 @@ bool FglTFRuntimeParser::ParseBase64Uri(const FString& Uri, TArray64<uint8>& Byt
 
 bool FglTFRuntimeParser::GetBufferView(const int32 Index, FglTFRuntimeBlob& Blob, int64& Stride)
 {
-	TSharedPtr<FJsonObject> JsonBufferViewObject = GetJsonObjectFromRootIndex("bufferViews", Index);
-	if (!JsonBufferViewObject)
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	int32 JsonBufferViewNode = JsonTape->GetRootArrayItem("bufferViews", Index);
+	if (!JsonTape->IsObject(JsonBufferViewNode))
 	{
 		return false;
 	}
 
-	TSharedPtr<FJsonObject> JsonBufferViewCompressedObject = GetJsonObjectExtension(JsonBufferViewObject.ToSharedRef(), "EXT_meshopt_compression");
-	if (JsonBufferViewCompressedObject)
+	const int32 JsonBufferViewCompressedNode = JsonTape->GetObjectField(JsonTape->GetObjectField(JsonBufferViewNode, "extensions"), "EXT_meshopt_compression");
+	const bool bCompressed = JsonBufferViewCompressedNode != INDEX_NONE;
+	if (bCompressed)
 	{
-		JsonBufferViewObject = JsonBufferViewCompressedObject;
-		if (CompressedBufferViewsCache.Contains(Index))
+		JsonBufferViewNode = JsonBufferViewCompressedNode;
+		FScopeLock Lock(&BuffersCacheLock);
+		if (TArray64<uint8>* CompressedBufferView = CompressedBufferViewsCache.Find(Index))
 		{
-			Blob.Data = CompressedBufferViewsCache[Index].GetData();
-			Blob.Num = CompressedBufferViewsCache[Index].Num();
+			Blob.Data = CompressedBufferView->GetData();
+			Blob.Num = CompressedBufferView->Num();
 			Stride = CompressedBufferViewsStridesCache[Index];
 			return true;
 		}
 	}
 
 	int64 BufferIndex;
-	if (!JsonBufferViewObject->TryGetNumberField("buffer", BufferIndex))
+	if (!JsonTape->TryGetNumberField(JsonBufferViewNode, "buffer", BufferIndex))
 	{
 		return false;
 	}
@@ -3161,18 +4191,18 @@ bool FglTFRuntimeParser::GetBufferView(const int32 Index, FglTFRuntimeBlob& Blob
 	}
 
 	int64 ByteLength;
-	if (!JsonBufferViewObject->TryGetNumberField("byteLength", ByteLength))
+	if (!JsonTape->TryGetNumberField(JsonBufferViewNode, "byteLength", ByteLength))
 	{
 		return false;
 	}
 
 	int64 ByteOffset;
-	if (!JsonBufferViewObject->TryGetNumberField("byteOffset", ByteOffset))
+	if (!JsonTape->TryGetNumberField(JsonBufferViewNode, "byteOffset", ByteOffset))
 	{
 		ByteOffset = 0;
 	}
 
-	if (!JsonBufferViewObject->TryGetNumberField("byteStride", Stride))
+	if (!JsonTape->TryGetNumberField(JsonBufferViewNode, "byteStride", Stride))
 	{
 		Stride = 0;
 	}
@@ -3185,7 +4215,7 @@ bool FglTFRuntimeParser::GetBufferView(const int32 Index, FglTFRuntimeBlob& Blob
 	Blob.Data = BufferBlob.Data + ByteOffset;
 	Blob.Num = ByteLength;
 
-	if (JsonBufferViewCompressedObject)
+	if (bCompressed)
 	{
 		// decompress bitstream
 		if (Stride == 0)
@@ -3193,30 +4223,41 @@ bool FglTFRuntimeParser::GetBufferView(const int32 Index, FglTFRuntimeBlob& Blob
 			return false;
 		}
 		int64 Elements;
-		if (!JsonBufferViewObject->TryGetNumberField("count", Elements))
+		if (!JsonTape->TryGetNumberField(JsonBufferViewNode, "count", Elements))
 		{
 			return false;
 		}
 		FString MeshOptMode;
-		if (!JsonBufferViewObject->TryGetStringField("mode", MeshOptMode))
+		if (!JsonTape->TryGetStringField(JsonBufferViewNode, "mode", MeshOptMode))
 		{
 			return false;
 		}
 		FString MeshOptFilter;
-		if (!JsonBufferViewObject->TryGetStringField("filter", MeshOptFilter))
+		if (!JsonTape->TryGetStringField(JsonBufferViewNode, "filter", MeshOptFilter))
 		{
 			MeshOptFilter = "NONE";
 		}
 
-		CompressedBufferViewsCache.Add(Index);
-		if (!DecompressMeshOptimizer(Blob, Stride, Elements, MeshOptMode, MeshOptFilter, CompressedBufferViewsCache[Index]))
+		// decode outside of the lock, the views of other accessors can be decoded in parallel
+		TArray64<uint8> UncompressedBytes;
+		if (!DecompressMeshOptimizer(Blob, Stride, Elements, MeshOptMode, MeshOptFilter, UncompressedBytes))
 		{
-			CompressedBufferViewsCache.Remove(Index);
 			return false;
 		}
-		Blob.Data = CompressedBufferViewsCache[Index].GetData();
-		Blob.Num = CompressedBufferViewsCache[Index].Num();
-		CompressedBufferViewsStridesCache.Add(Index, Stride);
+
+		FScopeLock Lock(&BuffersCacheLock);
+		TArray64<uint8>* CompressedBufferView = CompressedBufferViewsCache.Find(Index);
+		if (CompressedBufferView)
+		{
+			Stride = CompressedBufferViewsStridesCache[Index];
+		}
+		else
+		{
+			CompressedBufferView = &CompressedBufferViewsCache.Add(Index, MoveTemp(UncompressedBytes));
+			CompressedBufferViewsStridesCache.Add(Index, Stride);
+		}
+		Blob.Data = CompressedBufferView->GetData();
+		Blob.Num = CompressedBufferView->Num();
 	}
 
 	return true;
@@ -3224,9 +4265,9 @@ bool FglTFRuntimeParser::GetBufferView(const int32 Index, FglTFRuntimeBlob& Blob
 
 bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, int64& Stride, int64& Elements, int64& ElementSize, int64& Count, bool& bNormalized, FglTFRuntimeBlob& Blob, const FglTFRuntimeBlob* AdditionalBufferView)
 {
-
-	TSharedPtr<FJsonObject> JsonAccessorObject = GetJsonObjectFromRootIndex("accessors", Index);
-	if (!JsonAccessorObject)
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonAccessorNode = JsonTape->GetRootArrayItem("accessors", Index);
+	if (!JsonTape->IsObject(JsonAccessorNode))
 	{
 		return false;
 	}
@@ -3239,43 +4280,44 @@ bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, in
 
 	if (!AdditionalBufferView)
 	{
-		if (!JsonAccessorObject->TryGetNumberField("bufferView", BufferViewIndex))
+		if (!JsonTape->TryGetNumberField(JsonAccessorNode, "bufferView", BufferViewIndex))
 		{
 			bInitWithZeros = true;
 		}
 
 
-		if (!JsonAccessorObject->TryGetNumberField("byteOffset", ByteOffset))
+		if (!JsonTape->TryGetNumberField(JsonAccessorNode, "byteOffset", ByteOffset))
 		{
 			ByteOffset = 0;
 		}
 	}
 
-	const TSharedPtr<FJsonObject>* JsonSparseObject = nullptr;
-	if (JsonAccessorObject->TryGetObjectField("sparse", JsonSparseObject))
+	// sparse accessors are rare, so just materialize them
+	TSharedPtr<FJsonObject> JsonSparseObject = JsonTape->ToJsonObject(JsonTape->FindField(JsonAccessorNode, "sparse"));
+	if (JsonSparseObject)
 	{
 		bHasSparse = true;
 	}
 
 	const bool bOriginalNormalized = bNormalized;
 
-	if (!JsonAccessorObject->TryGetBoolField("normalized", bNormalized))
+	if (!JsonTape->TryGetBoolField(JsonAccessorNode, "normalized", bNormalized))
 	{
 		bNormalized = bOriginalNormalized;
 	}
 
-	if (!JsonAccessorObject->TryGetNumberField("componentType", ComponentType))
+	if (!JsonTape->TryGetNumberField(JsonAccessorNode, "componentType", ComponentType))
 	{
 		return false;
 	}
 
-	if (!JsonAccessorObject->TryGetNumberField("count", Count))
+	if (!JsonTape->TryGetNumberField(JsonAccessorNode, "count", Count))
 	{
 		return false;
 	}
 
 	FString Type;
-	if (!JsonAccessorObject->TryGetStringField("type", Type))
+	if (!JsonTape->TryGetStringField(JsonAccessorNode, "type", Type))
 	{
 		return false;
 	}
@@ -3310,12 +4352,7 @@ bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, in
 	}
 	else if (bInitWithZeros)
 	{
-
-		if (ZeroBuffer.Num() < FinalSize)
-		{
-			ZeroBuffer.AddZeroed(FinalSize - ZeroBuffer.Num());
-		}
-		Blob.Data = ZeroBuffer.GetData();
+		Blob.Data = GetZeroBuffer(FinalSize);
 		Blob.Num = FinalSize;
 		if (!bHasSparse)
 		{
@@ -3361,16 +4398,19 @@ bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, in
 		}
 	}
 
-	if (SparseAccessorsCache.Contains(Index))
 	{
-		Stride = SparseAccessorsStridesCache[Index];
-		Blob.Data = SparseAccessorsCache[Index].GetData();
-		Blob.Num = SparseAccessorsCache[Index].Num();
-		return true;
+		FScopeLock Lock(&SparseAccessorsCacheLock);
+		if (SparseAccessorsCache.Contains(Index))
+		{
+			Stride = SparseAccessorsStridesCache[Index];
+			Blob.Data = SparseAccessorsCache[Index].GetData();
+			Blob.Num = SparseAccessorsCache[Index].Num();
+			return true;
+		}
 	}
 
 	int64 SparseCount;
-	if (!(*JsonSparseObject)->TryGetNumberField("count", SparseCount))
+	if (!JsonSparseObject->TryGetNumberField("count", SparseCount))
 	{
 		return false;
 	}
@@ -3381,7 +4421,7 @@ bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, in
 	}
 
 	const TSharedPtr<FJsonObject>* JsonSparseIndicesObject = nullptr;
-	if (!(*JsonSparseObject)->TryGetObjectField("indices", JsonSparseIndicesObject))
+	if (!JsonSparseObject->TryGetObjectField("indices", JsonSparseIndicesObject))
 	{
 		return true;
 	}
@@ -3452,7 +4492,7 @@ bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, in
 	}
 
 	const TSharedPtr<FJsonObject>* JsonSparseValuesObject = nullptr;
-	if (!(*JsonSparseObject)->TryGetObjectField("values", JsonSparseValuesObject))
+	if (!JsonSparseObject->TryGetObjectField("values", JsonSparseValuesObject))
 	{
 		return true;
 	}
@@ -3483,9 +4523,8 @@ bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, in
 
 	Stride = SparseBufferViewValuesStride;
 
-	SparseAccessorsCache.Add(Index);
-	SparseAccessorsStridesCache.Add(Index, Stride);
-	TArray64<uint8>& SparseData = SparseAccessorsCache[Index];
+	// patched out of the cache, concurrent loads of the same accessor keep the first one
+	TArray64<uint8> SparseData;
 	SparseData.Append(Blob.Data, Blob.Num);
 
 	for (int32 IndexToChange = 0; IndexToChange < SparseCount; IndexToChange++)
@@ -3501,11 +4540,32 @@ bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, in
 		FMemory::Memcpy(OriginalValuePtr, NewValuePtr, SparseBufferViewValuesStride);
 	}
 
-	Blob.Data = SparseData.GetData();
+	FScopeLock Lock(&SparseAccessorsCacheLock);
+	if (!SparseAccessorsCache.Contains(Index))
+	{
+		SparseAccessorsCache.Add(Index, MoveTemp(SparseData));
+		SparseAccessorsStridesCache.Add(Index, Stride);
+	}
+
+	Stride = SparseAccessorsStridesCache[Index];
+	Blob.Data = SparseAccessorsCache[Index].GetData();
+	Blob.Num = SparseAccessorsCache[Index].Num();
 
 	return true;
 }
 
+uint8* FglTFRuntimeParser::GetZeroBuffer(const int64 Size)
+{
+	FScopeLock Lock(&ZeroBuffersLock);
+	if (ZeroBuffers.Num() == 0 || ZeroBuffers.Last()->Num() < Size)
+	{
+		TUniquePtr<TArray64<uint8>> NewZeroBuffer = MakeUnique<TArray64<uint8>>();
+		NewZeroBuffer->AddZeroed(Size);
+		ZeroBuffers.Add(MoveTemp(NewZeroBuffer));
+	}
+	return ZeroBuffers.Last()->GetData();
+}
+
 int64 FglTFRuntimeParser::GetComponentTypeSize(const int64 ComponentType) const
 {
 	switch (ComponentType)
@@ -3577,28 +4637,44 @@ void FglTFRuntimeParser::ClearCache()
 
 float FglTFRuntimeParser::FindBestFrames(const TArray<float>& FramesTimes, float WantedTime, int32& FirstIndex, int32& SecondIndex)
 {
-	SecondIndex = INDEX_NONE;
-	// first search for second (higher value)
-	for (int32 i = 0; i < FramesTimes.Num(); i++)
+	// binary search (the specs require the timeline to be strictly increasing)
+	int32 Low = 0;
+	int32 High = FramesTimes.Num();
+	while (Low < High)
 	{
-		float TimeValue = FramesTimes[i] - FramesTimes[0];
-		if (FMath::IsNearlyEqual(TimeValue, WantedTime))
+		const int32 Middle = Low + (High - Low) / 2;
+		if (IsFrameReached(FramesTimes, Middle, WantedTime))
 		{
-			FirstIndex = i;
-			SecondIndex = i;
-			return 0;
+			High = Middle;
 		}
-		else if (TimeValue > WantedTime)
+		else
 		{
-			SecondIndex = i;
-			break;
+			Low = Middle + 1;
 		}
 	}
 
+	return GetBestFramesAlpha(FramesTimes, WantedTime, Low, FirstIndex, SecondIndex);
+}
+
+float FglTFRuntimeParser::FindBestFrames(const TArray<float>& FramesTimes, float WantedTime, int32& FirstIndex, int32& SecondIndex, int32& Cursor)
+{
+	while (Cursor < FramesTimes.Num() && !IsFrameReached(FramesTimes, Cursor, WantedTime))
+	{
+		Cursor++;
+	}
+
+	return GetBestFramesAlpha(FramesTimes, WantedTime, Cursor, FirstIndex, SecondIndex);
+}
+
+float FglTFRuntimeParser::GetBestFramesAlpha(const TArray<float>& FramesTimes, float WantedTime, const int32 FoundIndex, int32& FirstIndex, int32& SecondIndex)
+{
 	// not found ? use the last value
-	if (SecondIndex == INDEX_NONE)
+	SecondIndex = FoundIndex < FramesTimes.Num() ? FoundIndex : FramesTimes.Num() - 1;
+
+	if (FoundIndex < FramesTimes.Num() && FMath::IsNearlyEqual(FramesTimes[FoundIndex] - FramesTimes[0], WantedTime))
 	{
-		SecondIndex = FramesTimes.Num() - 1;
+		FirstIndex = FoundIndex;
+		return 0;
 	}
 
 	if (SecondIndex == 0)
@@ -3725,15 +4801,16 @@ bool FglTFRuntimeParser::MergePrimitives(TArray<FglTFRuntimePrimitive> SourcePri
 
 bool FglTFRuntimeParser::GetMorphTargetNames(const int32 MeshIndex, TArray<FName>& MorphTargetNames)
 {
-	TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-	if (!JsonMeshObject)
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonMeshNode = JsonTape->GetRootArrayItem("meshes", MeshIndex);
+	if (!JsonTape->IsObject(JsonMeshNode))
 	{
 		AddError("GetMorphTargetNames()", FString::Printf(TEXT("Unable to find Mesh with index %d"), MeshIndex));
 		return false;
 	}
 	// get primitives
-	const TArray<TSharedPtr<FJsonValue>>* JsonPrimitives;
-	if (!JsonMeshObject->TryGetArrayField("primitives", JsonPrimitives))
+	const int32 JsonPrimitivesNode = JsonTape->GetArrayField(JsonMeshNode, "primitives");
+	if (JsonPrimitivesNode == INDEX_NONE)
 	{
 		AddError("GetMorphTargetNames()", "No primitives defined in the asset.");
 		return false;
@@ -3741,32 +4818,34 @@ bool FglTFRuntimeParser::GetMorphTargetNames(const int32 MeshIndex, TArray<FName
 
 	int32 MorphTargetIndex = 0;
 	bool bCheckOnly = false;
-	for (TSharedPtr<FJsonValue> JsonPrimitive : *JsonPrimitives)
+	for (int32 PrimitiveIndex = 0; PrimitiveIndex < JsonTape->GetArrayNum(JsonPrimitivesNode); PrimitiveIndex++)
 	{
-		TSharedPtr<FJsonObject> JsonPrimitiveObject = JsonPrimitive->AsObject();
-		if (!JsonPrimitiveObject)
+		const int32 JsonPrimitiveNode = JsonTape->GetArrayItem(JsonPrimitivesNode, PrimitiveIndex);
+		if (!JsonTape->IsObject(JsonPrimitiveNode))
 		{
 			return false;
 		}
 
-		const TArray<TSharedPtr<FJsonValue>>* JsonTargetsArray;
-		if (!JsonPrimitiveObject->TryGetArrayField("targets", JsonTargetsArray))
+		const int32 JsonTargetsNode = JsonTape->GetArrayField(JsonPrimitiveNode, "targets");
+		if (JsonTargetsNode == INDEX_NONE)
 		{
 			AddError("GetMorphTargetNames()", "No MorphTarget defined in the asset.");
 			return false;
 		}
 
+		const int32 TargetsNum = JsonTape->GetArrayNum(JsonTargetsNode);
+
 		// check only ? (all primitives must have the same number of morph targets)
 		if (bCheckOnly)
 		{
-			if (JsonTargetsArray->Num() != MorphTargetNames.Num())
+			if (TargetsNum != MorphTargetNames.Num())
 			{
-				AddError("GetMorphTargetNames()", FString::Printf(TEXT("Invalid number of morph targets: %d, expected %d"), JsonTargetsArray->Num(), MorphTargetNames.Num()));
+				AddError("GetMorphTargetNames()", FString::Printf(TEXT("Invalid number of morph targets: %d, expected %d"), TargetsNum, MorphTargetNames.Num()));
 			}
 			continue;
 		}
 
-		for (int32 MorphIndex = 0; MorphIndex < JsonTargetsArray->Num(); MorphIndex++)
+		for (int32 MorphIndex = 0; MorphIndex < TargetsNum; MorphIndex++)
 		{
 			FName MorphTargetName = FName(FString::Printf(TEXT("MorphTarget_%d"), MorphTargetIndex++));
 			MorphTargetNames.Add(MorphTargetName);
@@ -3776,17 +4855,18 @@ bool FglTFRuntimeParser::GetMorphTargetNames(const int32 MeshIndex, TArray<FName
 	}
 
 	// eventually cleanup names using targetNames extras
-	const TSharedPtr<FJsonObject>* JsonExtrasObject;
-	if (JsonMeshObject->TryGetObjectField("extras", JsonExtrasObject))
+	const int32 JsonExtrasNode = JsonTape->GetObjectField(JsonMeshNode, "extras");
+	if (JsonExtrasNode != INDEX_NONE)
 	{
-		const TArray<TSharedPtr<FJsonValue>>* JsonTargetNamesArray;
-		if ((*JsonExtrasObject)->TryGetArrayField("targetNames", JsonTargetNamesArray))
+		const int32 JsonTargetNamesNode = JsonTape->GetArrayField(JsonExtrasNode, "targetNames");
+		if (JsonTargetNamesNode != INDEX_NONE)
 		{
-			for (int32 TargetNameIndex = 0; TargetNameIndex < JsonTargetNamesArray->Num(); TargetNameIndex++)
+			for (int32 TargetNameIndex = 0; TargetNameIndex < JsonTape->GetArrayNum(JsonTargetNamesNode); TargetNameIndex++)
 			{
-				if (MorphTargetNames.IsValidIndex(TargetNameIndex))
+				FString TargetName;
+				if (MorphTargetNames.IsValidIndex(TargetNameIndex) && JsonTape->TryGetString(JsonTape->GetArrayItem(JsonTargetNamesNode, TargetNameIndex), TargetName))
 				{
-					MorphTargetNames[TargetNameIndex] = FName((*JsonTargetNamesArray)[TargetNameIndex]->AsString());
+					MorphTargetNames[TargetNameIndex] = FName(TargetName);
 				}
 			}
 		}
@@ -3795,161 +4875,357 @@ bool FglTFRuntimeParser::GetMorphTargetNames(const int32 MeshIndex, TArray<FName
 	return true;
 }
 
-bool FglTFRuntimeZipFile::FromData(const uint8* DataPtr, const int64 DataNum)
+bool FglTFRuntimeZipFile::FromData(const uint8* DataPtr, const int64 DataNum, TSharedPtr<FglTFRuntimeMappedFile> InMappedFile)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeZipFile_FromData, FColor::Magenta);
+
+	if (InMappedFile && InMappedFile->Contains(DataPtr, DataNum))
+	{
+		MappedFile = InMappedFile;
+		ArchiveData = DataPtr;
+	}
+	else
+	{
+		Data.Append(DataPtr, DataNum);
+		ArchiveData = Data.GetData();
+	}
+	ArchiveSize = DataNum;
+
+	return ParseCentralDirectory();
+}
+
+bool FglTFRuntimeZipFile::FromFile(const FString& Filename)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeZipFile_FromFile, FColor::Magenta);
+
+	FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Filename));
+	if (!FileHandle)
+	{
+		return false;
+	}
+
+	ArchiveSize = FileHandle->Size();
+
+	uint8 Magic[4];
+	if (!ReadBytes(0, Magic, 4) || ZipUInt32(Magic) != 0x04034b50 || !ParseCentralDirectory())
+	{
+		FileHandle.Reset();
+		EntriesMap.Empty();
+		return false;
+	}
+
+	return true;
+}
+
+bool FglTFRuntimeZipFile::ReadBytes(const int64 Offset, uint8* OutData, const int64 Num)
+{
+	if (Offset < 0 || Num < 0 || Offset + Num > ArchiveSize)
+	{
+		return false;
+	}
+
+	if (ArchiveData)
+	{
+		FMemory::Memcpy(OutData, ArchiveData + Offset, Num);
+		return true;
+	}
+
+	FScopeLock Lock(&FileHandleLock);
+	return FileHandle->Seek(Offset) && FileHandle->Read(OutData, Num);
+}
+
+bool FglTFRuntimeZipFile::ParseCentralDirectory()
 {
-	Data.Append(DataPtr, DataNum);
+	constexpr int64 TrailerMinSize = 22;
+	constexpr int64 CentralDirectoryMinSize = 46;
+
+	if (ArchiveSize < TrailerMinSize)
+	{
+		return false;
+	}
+
+	// step0: retrieve the trailer magic (it can only be followed by the comment, up to 64k)
+	const int64 TailSize = FMath::Min<int64>(ArchiveSize, TrailerMinSize + MAX_uint16);
+	TArray64<uint8> Tail;
+	Tail.AddUninitialized(TailSize);
+	if (!ReadBytes(ArchiveSize - TailSize, Tail.GetData(), TailSize))
+	{
+		return false;
+	}
 
-	// step0: retrieve the trailer magic
-	TArray<uint8> Magic;
-	bool bIndexFound = false;
-	uint64 Index = 0;
-	for (Index = Data.Num() - 1; Index >= 0; Index--)
+	int64 TrailerIndex = INDEX_NONE;
+	for (int64 Index = TailSize - TrailerMinSize; Index >= 0; Index--)
 	{
-		Magic.Insert(Data[Index], 0);
-		if (Magic.Num() == 4)
+		if (ZipUInt32(Tail.GetData() + Index) == 0x06054b50)
 		{
-			if (Magic[0] == 0x50 && Magic[1] == 0x4b && Magic[2] == 0x05 && Magic[3] == 0x06)
-			{
-				bIndexFound = true;
-				break;
-			}
-			Magic.Pop();
+			TrailerIndex = Index;
+			break;
 		}
 	}
 
-	if (!bIndexFound)
+	if (TrailerIndex == INDEX_NONE)
 	{
 		return false;
 	}
 
-	uint16 DiskEntries = 0;
-	uint16 TotalEntries = 0;
-	uint32 CentralDirectorySize = 0;
-	uint32 CentralDirectoryOffset = 0;
-	uint16 CommentLen = 0;
+	const uint8* Trailer = Tail.GetData() + TrailerIndex;
+	uint64 DirectoryEntries = FMath::Min(ZipUInt16(Trailer + 8), ZipUInt16(Trailer + 10));
+	uint64 CentralDirectorySize = ZipUInt32(Trailer + 12);
+	uint64 CentralDirectoryOffset = ZipUInt32(Trailer + 16);
 
-	constexpr uint64 TrailerMinSize = 22;
-	constexpr uint64 CentralDirectoryMinSize = 46;
+	// zip64 archives store the real values in a record referenced by the locator preceding the trailer
+	if (TrailerIndex >= 20 && ZipUInt32(Trailer - 20) == 0x07064b50)
+	{
+		uint8 Zip64Trailer[56];
+		if (!ReadBytes(ZipUInt64(Trailer - 20 + 8), Zip64Trailer, 56) || ZipUInt32(Zip64Trailer) != 0x06064b50)
+		{
+			return false;
+		}
+		DirectoryEntries = FMath::Min(ZipUInt64(Zip64Trailer + 24), ZipUInt64(Zip64Trailer + 32));
+		CentralDirectorySize = ZipUInt64(Zip64Trailer + 40);
+		CentralDirectoryOffset = ZipUInt64(Zip64Trailer + 48);
+	}
 
-	if (Index + TrailerMinSize > Data.Num())
+	if (CentralDirectorySize > static_cast<uint64>(ArchiveSize))
 	{
 		return false;
 	}
 
-	// skip signature and disk data
-	Data.Seek(Index + 8);
-	Data << DiskEntries;
-	Data << TotalEntries;
-	Data << CentralDirectorySize;
-	Data << CentralDirectoryOffset;
-	Data << CommentLen;
-
-	uint16 DirectoryEntries = FMath::Min(DiskEntries, TotalEntries);
+	TArray64<uint8> CentralDirectory;
+	CentralDirectory.AddUninitialized(CentralDirectorySize);
+	if (!ReadBytes(CentralDirectoryOffset, CentralDirectory.GetData(), CentralDirectorySize))
+	{
+		return false;
+	}
 
-	for (uint16 DirectoryIndex = 0; DirectoryIndex < DirectoryEntries; DirectoryIndex++)
+	int64 Offset = 0;
+	for (uint64 DirectoryIndex = 0; DirectoryIndex < DirectoryEntries; DirectoryIndex++)
 	{
-		if (CentralDirectoryOffset + CentralDirectoryMinSize > Data.Num())
+		if (Offset + CentralDirectoryMinSize > CentralDirectory.Num())
 		{
 			return false;
 		}
 
-		uint16 FilenameLen = 0;
-		uint16 ExtraFieldLen = 0;
-		uint16 EntryCommentLen = 0;
-		uint32 EntryOffset = 0;
+		const uint8* Header = CentralDirectory.GetData() + Offset;
+		if (ZipUInt32(Header) != 0x02014b50)
+		{
+			return false;
+		}
 
-		// seek to FilenameLen
-		Data.Seek(CentralDirectoryOffset + 28);
-		Data << FilenameLen;
-		Data << ExtraFieldLen;
-		Data << EntryCommentLen;
-		// seek to EntryOffset
-		Data.Seek(CentralDirectoryOffset + 42);
-		Data << EntryOffset;
+		FEntry Entry;
+		Entry.Compression = ZipUInt16(Header + 10);
+		Entry.Crc32 = ZipUInt32(Header + 16);
+		Entry.CompressedSize = ZipUInt32(Header + 20);
+		Entry.UncompressedSize = ZipUInt32(Header + 24);
+		const uint16 FilenameLen = ZipUInt16(Header + 28);
+		const uint16 ExtraFieldLen = ZipUInt16(Header + 30);
+		const uint16 EntryCommentLen = ZipUInt16(Header + 32);
+		Entry.LocalHeaderOffset = ZipUInt32(Header + 42);
 
-		if (CentralDirectoryOffset + CentralDirectoryMinSize + FilenameLen + ExtraFieldLen + EntryCommentLen > Data.Num())
+		if (Offset + CentralDirectoryMinSize + FilenameLen + ExtraFieldLen + EntryCommentLen > CentralDirectory.Num())
 		{
 			return false;
 		}
 
-		TArray64<uint8> FilenameBytes;
-		FilenameBytes.Append(Data.GetData() + CentralDirectoryOffset + CentralDirectoryMinSize, FilenameLen);
-		FilenameBytes.Add(0);
+		// zip64 extended information: 64bit values are stored only for the fields set to 0xFFFFFFFF
+		const uint8* ExtraField = Header + CentralDirectoryMinSize + FilenameLen;
+		int64 ExtraFieldOffset = 0;
+		while (ExtraFieldOffset + 4 <= ExtraFieldLen)
+		{
+			const uint16 ExtraFieldId = ZipUInt16(ExtraField + ExtraFieldOffset);
+			const uint16 ExtraFieldSize = ZipUInt16(ExtraField + ExtraFieldOffset + 2);
+			if (ExtraFieldOffset + 4 + ExtraFieldSize > ExtraFieldLen)
+			{
+				break;
+			}
 
-		FString Filename = FString(UTF8_TO_TCHAR(FilenameBytes.GetData()));
+			if (ExtraFieldId == 0x0001)
+			{
+				const uint8* Zip64Field = ExtraField + ExtraFieldOffset + 4;
+				int64 Zip64FieldOffset = 0;
+				auto ReadZip64Value = [Zip64Field, ExtraFieldSize, &Zip64FieldOffset](int64& Value)
+					{
+						if (Value == MAX_uint32 && Zip64FieldOffset + 8 <= ExtraFieldSize)
+						{
+							Value = ZipUInt64(Zip64Field + Zip64FieldOffset);
+							Zip64FieldOffset += 8;
+						}
+					};
+				ReadZip64Value(Entry.UncompressedSize);
+				ReadZip64Value(Entry.CompressedSize);
+				ReadZip64Value(Entry.LocalHeaderOffset);
+			}
+
+			ExtraFieldOffset += 4 + ExtraFieldSize;
+		}
 
-		OffsetsMap.Add(Filename, EntryOffset);
+		FUTF8ToTCHAR FilenameConverter(reinterpret_cast<const ANSICHAR*>(Header + CentralDirectoryMinSize), FilenameLen);
+		EntriesMap.Add(FString(FilenameConverter.Length(), FilenameConverter.Get()), Entry);
 
-		CentralDirectoryOffset += CentralDirectoryMinSize + FilenameLen + ExtraFieldLen + EntryCommentLen;
+		Offset += CentralDirectoryMinSize + FilenameLen + ExtraFieldLen + EntryCommentLen;
 	}
 
 	return true;
 }
 
-bool FglTFRuntimeZipFile::GetFileContent(const FString& Filename, TArray64<uint8>& OutData)
+bool FglTFRuntimeZipFile::ReadEntry(const FEntry& Entry, uint8* OutData)
 {
-	uint32* Offset = OffsetsMap.Find(Filename);
-	if (!Offset)
+	SCOPED_NAMED_EVENT(FglTFRuntimeZipFile_ReadEntry, FColor::Magenta);
+
+	constexpr int64 LocalEntryMinSize = 30;
+
+	uint8 LocalHeader[LocalEntryMinSize];
+	if (!ReadBytes(Entry.LocalHeaderOffset, LocalHeader, LocalEntryMinSize) || ZipUInt32(LocalHeader) != 0x04034b50)
 	{
 		return false;
 	}
 
-	constexpr uint64 LocalEntryMinSize = 30;
-
-	if (*Offset + LocalEntryMinSize > Data.Num())
+	// the local extra field can differ from the central directory one
+	const int64 EntryDataOffset = Entry.LocalHeaderOffset + LocalEntryMinSize + ZipUInt16(LocalHeader + 26) + ZipUInt16(LocalHeader + 28);
+	if (Entry.CompressedSize < 0 || EntryDataOffset + Entry.CompressedSize > ArchiveSize)
 	{
 		return false;
 	}
 
-	uint16 Compression = 0;
-	uint32 CompressedSize;
-	uint32 UncompressedSize = 0;
-	uint16 FilenameLen = 0;
-	uint16 ExtraFieldLen = 0;
-
-	// seek to Compression
-	Data.Seek(*Offset + 8);
-	Data << Compression;
-	// seek to CompressedSize
-	Data.Seek(*Offset + 18);
-	Data << CompressedSize;
-	Data << UncompressedSize;
-	Data << FilenameLen;
-	Data << ExtraFieldLen;
-
-	if (*Offset + LocalEntryMinSize + FilenameLen + ExtraFieldLen + CompressedSize > Data.Num())
+	// nothing to inflate (and OutData could be null)
+	if (Entry.UncompressedSize == 0)
 	{
-		return false;
+		return Entry.Crc32 == 0;
 	}
 
-	if (Compression == 8)
+	uLong Crc32 = crc32(0, nullptr, 0);
+
+	if (Entry.Compression == 8)
 	{
-		OutData.AddUninitialized(UncompressedSize);
-		if (!FCompression::UncompressMemory(NAME_Zlib, OutData.GetData(), UncompressedSize, Data.GetData() + *Offset + LocalEntryMinSize + FilenameLen + ExtraFieldLen, CompressedSize, COMPRESS_NoFlags, -15))
+		z_stream Stream;
+		FMemory::Memzero(Stream);
+		if (inflateInit2(&Stream, -MAX_WBITS) != Z_OK)
+		{
+			return false;
+		}
+
+		ON_SCOPE_EXIT
+		{
+			inflateEnd(&Stream);
+		};
+
+		// file-backed archives are streamed in chunks, in-memory ones are inflated in place
+		constexpr int64 ChunkSize = 256 * 1024;
+		TArray<uint8> Chunk;
+
+		int64 CompressedOffset = 0;
+		int64 UncompressedOffset = 0;
+		int32 Result = Z_OK;
+		while (Result != Z_STREAM_END)
+		{
+			if (Stream.avail_in == 0)
+			{
+				const int64 InputNum = FMath::Min<int64>(ArchiveData ? MAX_uint32 : ChunkSize, Entry.CompressedSize - CompressedOffset);
+				if (InputNum <= 0)
+				{
+					return false;
+				}
+
+				if (ArchiveData)
+				{
+					Stream.next_in = const_cast<Bytef*>(ArchiveData + EntryDataOffset + CompressedOffset);
+				}
+				else
+				{
+					Chunk.SetNumUninitialized(InputNum);
+					if (!ReadBytes(EntryDataOffset + CompressedOffset, Chunk.GetData(), InputNum))
+					{
+						return false;
+					}
+					Stream.next_in = Chunk.GetData();
+				}
+				Stream.avail_in = static_cast<uInt>(InputNum);
+				CompressedOffset += InputNum;
+			}
+
+			const int64 OutputNum = FMath::Min<int64>(MAX_uint32, Entry.UncompressedSize - UncompressedOffset);
+			Stream.next_out = OutData + UncompressedOffset;
+			Stream.avail_out = static_cast<uInt>(OutputNum);
+
+			Result = inflate(&Stream, Z_NO_FLUSH);
+			if (Result != Z_OK && Result != Z_STREAM_END)
+			{
+				return false;
+			}
+
+			const int64 InflatedNum = OutputNum - Stream.avail_out;
+			Crc32 = crc32(Crc32, OutData + UncompressedOffset, static_cast<uInt>(InflatedNum));
+			UncompressedOffset += InflatedNum;
+		}
+
+		if (UncompressedOffset != Entry.UncompressedSize)
 		{
 			return false;
 		}
 	}
-	else if (Compression == 0 && CompressedSize == UncompressedSize)
+	else if (Entry.Compression == 0 && Entry.CompressedSize == Entry.UncompressedSize)
 	{
-		OutData.Append(Data.GetData() + *Offset + LocalEntryMinSize + FilenameLen + ExtraFieldLen, UncompressedSize);
+		if (!ReadBytes(EntryDataOffset, OutData, Entry.UncompressedSize))
+		{
+			return false;
+		}
+
+		for (int64 Offset = 0; Offset < Entry.UncompressedSize; Offset += MAX_uint32)
+		{
+			Crc32 = crc32(Crc32, OutData + Offset, static_cast<uInt>(FMath::Min<int64>(MAX_uint32, Entry.UncompressedSize - Offset)));
+		}
 	}
 	else
 	{
 		return false;
 	}
 
+	return Crc32 == Entry.Crc32;
+}
+
+bool FglTFRuntimeZipFile::GetFileContent(const FString& Filename, TArray64<uint8>& OutData)
+{
+	const FEntry* Entry = EntriesMap.Find(Filename);
+	if (!Entry || Entry->UncompressedSize < 0)
+	{
+		return false;
+	}
+
+	const int64 FirstByte = OutData.AddUninitialized(Entry->UncompressedSize);
+	if (!ReadEntry(*Entry, OutData.GetData() + FirstByte))
+	{
+		OutData.SetNum(FirstByte);
+		return false;
+	}
+
 	return true;
 }
 
+bool FglTFRuntimeZipFile::GetFileContent(const FString& Filename, uint8* OutData, const int64 OutDataNum)
+{
+	const FEntry* Entry = EntriesMap.Find(Filename);
+	if (!Entry || Entry->UncompressedSize < 0 || OutDataNum < Entry->UncompressedSize)
+	{
+		return false;
+	}
+
+	return ReadEntry(*Entry, OutData);
+}
+
+int64 FglTFRuntimeZipFile::GetFileSize(const FString& Filename) const
+{
+	const FEntry* Entry = EntriesMap.Find(Filename);
+	return Entry ? Entry->UncompressedSize : INDEX_NONE;
+}
+
 bool FglTFRuntimeZipFile::FileExists(const FString& Filename) const
 {
-	return OffsetsMap.Contains(Filename);
+	return EntriesMap.Contains(Filename);
 }
 
 FString FglTFRuntimeZipFile::GetFirstFilenameByExtension(const FString& Extension) const
 {
-	for (const TPair<FString, uint32>& Pair : OffsetsMap)
+	for (const TPair<FString, FEntry>& Pair : EntriesMap)
 	{
 		if (Pair.Key.EndsWith(Extension, ESearchCase::IgnoreCase))
 		{
@@ -4043,16 +5319,13 @@ TArray<TSharedRef<FJsonObject>> FglTFRuntimeParser::GetMeshes() const
 {
 	TArray<TSharedRef<FJsonObject>> Meshes;
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonArray;
-	if (Root->TryGetArrayField("meshes", JsonArray))
+	const int32 MeshesNum = GetJsonRootArrayNum("meshes");
+	for (int32 MeshIndex = 0; MeshIndex < MeshesNum; MeshIndex++)
 	{
-		for (TSharedPtr<FJsonValue> JsonValue : *JsonArray)
+		TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
+		if (JsonMeshObject)
 		{
-			const TSharedPtr<FJsonObject>* JsonObject;
-			if (JsonValue->TryGetObject(JsonObject))
-			{
-				Meshes.Add(JsonObject->ToSharedRef());
-			}
+			Meshes.Add(JsonMeshObject.ToSharedRef());
 		}
 	}
 
@@ -4166,7 +5439,7 @@ void FglTFRuntimeParser::AddAdditionalBufferView(const int64 Index, const FStrin
 
 bool FglTFRuntimeParser::GetNumberFromExtras(const FString& Key, float& Value) const
 {
-	TSharedPtr<FJsonObject> JsonExtras = GetJsonObjectExtras(Root);
+	TSharedPtr<FJsonObject> JsonExtras = GetJsonObjectExtras(GetJsonRootObject());
 	if (!JsonExtras)
 	{
 		return false;
@@ -4185,7 +5458,7 @@ bool FglTFRuntimeParser::GetNumberFromExtras(const FString& Key, float& Value) c
 
 bool FglTFRuntimeParser::GetStringFromExtras(const FString& Key, FString& Value) const
 {
-	TSharedPtr<FJsonObject> JsonExtras = GetJsonObjectExtras(Root);
+	TSharedPtr<FJsonObject> JsonExtras = GetJsonObjectExtras(GetJsonRootObject());
 	if (!JsonExtras)
 	{
 		return false;
@@ -4196,7 +5469,7 @@ bool FglTFRuntimeParser::GetStringFromExtras(const FString& Key, FString& Value)
 
 bool FglTFRuntimeParser::GetBooleanFromExtras(const FString& Key, bool& Value) const
 {
-	TSharedPtr<FJsonObject> JsonExtras = GetJsonObjectExtras(Root);
+	TSharedPtr<FJsonObject> JsonExtras = GetJsonObjectExtras(GetJsonRootObject());
 	if (!JsonExtras)
 	{
 		return false;
@@ -4207,7 +5480,7 @@ bool FglTFRuntimeParser::GetBooleanFromExtras(const FString& Key, bool& Value) c
 
 bool FglTFRuntimeParser::GetStringMapFromExtras(const FString& Key, TMap<FString, FString>& StringMap) const
 {
-	TSharedPtr<FJsonObject> JsonExtras = GetJsonObjectExtras(Root);
+	TSharedPtr<FJsonObject> JsonExtras = GetJsonObjectExtras(GetJsonRootObject());
 	if (!JsonExtras)
 	{
 		return false;
@@ -4240,7 +5513,7 @@ bool FglTFRuntimeParser::GetStringMapFromExtras(const FString& Key, TMap<FString
 
 bool FglTFRuntimeParser::GetStringArrayFromExtras(const FString& Key, TArray<FString>& StringArray) const
 {
-	TSharedPtr<FJsonObject> JsonExtras = GetJsonObjectExtras(Root);
+	TSharedPtr<FJsonObject> JsonExtras = GetJsonObjectExtras(GetJsonRootObject());
 	if (!JsonExtras)
 	{
 		return false;
@@ -4251,7 +5524,7 @@ bool FglTFRuntimeParser::GetStringArrayFromExtras(const FString& Key, TArray<FSt
 
 bool FglTFRuntimeParser::GetNumberArrayFromExtras(const FString& Key, TArray<float>& NumberArray) const
 {
-	TSharedPtr<FJsonObject> JsonExtras = GetJsonObjectExtras(Root);
+	TSharedPtr<FJsonObject> JsonExtras = GetJsonObjectExtras(GetJsonRootObject());
 	if (!JsonExtras)
 	{
 		return false;
@@ -4292,623 +5565,22 @@ TSharedPtr<FJsonObject> FglTFRuntimeParser::GetNodeObject(const int32 NodeIndex)
 	return GetJsonObjectFromRootIndex("nodes", NodeIndex);
 }
 
-bool FglTFRuntimeParser::DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, const int64 Stride, const int64 Elements, const FString& Mode, const FString& Filter, TArray64<uint8>& UncompressedBytes)
+FTransform FglTFRuntimeParser::GetParentNodeWorldTransform(const FglTFRuntimeNode& Node)
 {
-	auto DecodeZigZag = [](uint8 V)
-		{
-			return ((V & 1) != 0) ? ~(V >> 1) : (V >> 1);
-		};
-
-	if (Mode == "ATTRIBUTES" && Blob.Num > 32 && Blob.Data[0] == 0xa0)
-	{
-		int64 Offset = 1;
-		const int64 Limit = Blob.Num - Stride;
-
-		TArray<uint8> BaseLine;
-		BaseLine.Append(Blob.Data + Blob.Num - Stride, Stride);
-		if (BaseLine.Num() < 16)
-		{
-			BaseLine.AddZeroed(16 - BaseLine.Num());
-		}
-
-		const int64 MaxBlockElements = FMath::Min<int64>((8192 / Stride) & ~15, 256);
-
-		// preallocated
-		UncompressedBytes.AddUninitialized(Elements * Stride);
-
-		for (int64 ElementIndex = 0; ElementIndex < Elements; ElementIndex += MaxBlockElements)
-		{
-			int64 BlockElements = FMath::Min<int64>(Elements - ElementIndex, MaxBlockElements);
-
-#if ENGINE_MAJOR_VERSION > 4
-			int64 GroupCount = FMath::CeilToInt64(BlockElements / 16.0);
-#else
-			int64 GroupCount = FMath::CeilToInt(BlockElements / 16.0);
-#endif
-
-			int64 NumberOfHeaderBytes = GroupCount / 4;
-			if ((GroupCount % 4) > 0)
-			{
-				NumberOfHeaderBytes++;
-			}
-
-			for (int64 ElementByteIndex = 0; ElementByteIndex < Stride; ElementByteIndex++)
-			{
-
-				if (Offset + NumberOfHeaderBytes > Limit)
-				{
-					return false;
-				}
-
-				TArray64<uint8> Groups;
-				for (int64 i = 0; i < NumberOfHeaderBytes; i++)
-				{
-					Groups.Add(Blob.Data[Offset] & 0x03);
-					Groups.Add((Blob.Data[Offset] >> 2) & 0x03);
-					Groups.Add((Blob.Data[Offset] >> 4) & 0x03);
-					Groups.Add((Blob.Data[Offset] >> 6) & 0x03);
-					Offset++;
-				}
-
-				for (int64 GroupIndex = 0; GroupIndex < GroupCount; GroupIndex++)
-				{
-					if (Groups[GroupIndex] == 0)
-					{
-						for (int32 ByteIndex = 0; ByteIndex < 16; ByteIndex++)
-						{
-							const int64 DestinationOffset = (ElementIndex + (GroupIndex * 16) + ByteIndex) * Stride + ElementByteIndex;
-							if (DestinationOffset >= UncompressedBytes.Num())
-							{
-								break;
-							}
-							UncompressedBytes[DestinationOffset] = BaseLine[ElementByteIndex];
-						}
-					}
-					else if (Groups[GroupIndex] == 1)
-					{
-						if (Offset + 4 > Limit)
-						{
-							return false;
-						}
-						TArray<uint8> Deltas;
-						for (int32 ByteIndex = 0; ByteIndex < 4; ByteIndex++)
-						{
-							Deltas.Add((Blob.Data[Offset] >> 6) & 0x03);
-							Deltas.Add((Blob.Data[Offset] >> 4) & 0x03);
-							Deltas.Add((Blob.Data[Offset] >> 2) & 0x03);
-							Deltas.Add(Blob.Data[Offset] & 0x03);
-							Offset++;
-						}
-
-						for (int32 ByteIndex = 0; ByteIndex < 16; ByteIndex++)
-						{
-							uint8 Delta = 0;
-							if (Deltas[ByteIndex] == 0x03)
-							{
-								if (Offset + 1 <= Limit)
-								{
-									Delta = DecodeZigZag(Blob.Data[Offset++]);
-								}
-								else
-								{
-									return false;
-								}
-							}
-							else
-							{
-								Delta = DecodeZigZag(Deltas[ByteIndex]);
-							}
-
-							const int64 DestinationOffset = (ElementIndex + (GroupIndex * 16) + ByteIndex) * Stride + ElementByteIndex;
-							if (DestinationOffset >= UncompressedBytes.Num())
-							{
-								continue;
-							}
-							BaseLine[ElementByteIndex] += Delta;
-							UncompressedBytes[DestinationOffset] = BaseLine[ElementByteIndex];
-						}
-					}
-					else if (Groups[GroupIndex] == 2)
-					{
-						if (Offset + 8 > Limit)
-						{
-							return false;
-						}
-						TArray<uint8> Deltas;
-						for (int32 ByteIndex = 0; ByteIndex < 8; ByteIndex++)
-						{
-							Deltas.Add((Blob.Data[Offset] >> 4) & 0x0F);
-							Deltas.Add(Blob.Data[Offset] & 0x0F);
-							Offset++;
-						}
-
-						for (int32 ByteIndex = 0; ByteIndex < 16; ByteIndex++)
-						{
-							uint8 Delta = 0;
-							if (Deltas[ByteIndex] == 0x0F)
-							{
-								if (Offset + 1 <= Limit)
-								{
-									Delta = DecodeZigZag(Blob.Data[Offset++]);
-								}
-								else
-								{
-									return false;
-								}
-							}
-							else
-							{
-								Delta = DecodeZigZag(Deltas[ByteIndex]);
-							}
-
-							const int64 DestinationOffset = (ElementIndex + (GroupIndex * 16) + ByteIndex) * Stride + ElementByteIndex;
-							if (DestinationOffset >= UncompressedBytes.Num())
-							{
-								continue;
-							}
-							BaseLine[ElementByteIndex] += Delta;
-							UncompressedBytes[DestinationOffset] = BaseLine[ElementByteIndex];
-						}
-					}
-					else if (Groups[GroupIndex] == 3)
-					{
-						if (Offset + 16 > Limit)
-						{
-							return false;
-						}
-						for (int32 ByteIndex = 0; ByteIndex < 16; ByteIndex++)
-						{
-							uint8 Delta = DecodeZigZag(Blob.Data[Offset++]);
-							const int64 DestinationOffset = (ElementIndex + (GroupIndex * 16) + ByteIndex) * Stride + ElementByteIndex;
-							if (DestinationOffset >= UncompressedBytes.Num())
-							{
-								continue;
-							}
-							BaseLine[ElementByteIndex] += Delta;
-							UncompressedBytes[DestinationOffset] = BaseLine[ElementByteIndex];
-						}
-					}
-				}
-			}
-		}
-
-	}
-	else if (Mode == "TRIANGLES" && Blob.Num >= 17 && Blob.Data[0] == 0xe1 && (Stride == 2 || Stride == 4) && ((Elements % 3) == 0))
-	{
-		TArray<uint8> CodeAux;
-		const int64 Limit = Blob.Num - 16;
-		CodeAux.Append(Blob.Data + Limit, 16);
-
-		uint32 Next = 0;
-		uint32 Last = 0;
-		TArray<TPair<uint32, uint32>> EdgeFifo;
-		TArray<uint32> VertexFifo;
-
-		int64 Offset = 1;
-		const uint32 TrianglesNum = Elements / 3;
-		int64 DataOffset = Offset + TrianglesNum;
-		int64 TriangleOffset = 0;
-
-		UncompressedBytes.AddUninitialized(Elements * Stride);
-
-		auto EmitTriangle = [Stride, &TriangleOffset, &UncompressedBytes](const uint32 A, const uint32 B, const uint32 C)
-			{
-				if (Stride == 2)
-				{
-					const uint16 AShort = A;
-					const uint16 BShort = B;
-					const uint16 CShort = C;
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&AShort)[0];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&AShort)[1];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&BShort)[0];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&BShort)[1];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&CShort)[0];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&CShort)[1];
-
-				}
-				else
-				{
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&A)[0];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&A)[1];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&A)[2];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&A)[3];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&B)[0];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&B)[1];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&B)[2];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&B)[3];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&C)[0];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&C)[1];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&C)[2];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&C)[3];
-				}
-			};
-
-		auto DecodeIndex = [&Blob, &DataOffset, &Last, Limit]() -> bool
-			{
-				uint32 V = 0;
-				for (int32 Shift = 0; ; Shift += 7)
-				{
-					if (DataOffset >= Limit)
-					{
-						return false;
-					}
-
-					const uint32 Byte = Blob.Data[DataOffset++];
-					V |= (Byte & 0x7F) << Shift;
-
-					if (Byte < 0x80)
-					{
-						break;
-					}
-				}
-
-				int32 Delta = ((V & 1) != 0) ? ~(V >> 1) : (V >> 1);
-
-				Last += Delta;
-				return true;
-			};
-
-		for (uint32 TriangleIndex = 0; TriangleIndex < TrianglesNum; TriangleIndex++)
-		{
-			if (Offset >= Limit)
-			{
-				return false;
-			}
-			uint8 Code = Blob.Data[Offset++];
-			uint8 NibbleLeft = Code >> 4;
-			uint8 NibbleRight = Code & 0x0f;
-
-			if (NibbleLeft < 0xf && NibbleRight == 0) // 0xX0
-			{
-				if (NibbleLeft >= EdgeFifo.Num())
-				{
-					return false;
-				}
-				const TPair<uint32, uint32> AB = EdgeFifo[NibbleLeft];
-				const uint32 C = Next++;
-
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, AB.Value), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(AB.Key, C), 0); // push AC
-				VertexFifo.Insert(C, 0);
-
-				EmitTriangle(AB.Key, AB.Value, C);
-			}
-			else if (NibbleLeft < 0xf && NibbleRight > 0 && NibbleRight < 0x0d) // 0xXY
-			{
-				if (NibbleLeft >= EdgeFifo.Num())
-				{
-					return false;
-				}
-				const TPair<uint32, uint32> AB = EdgeFifo[NibbleLeft];
-
-				if (NibbleRight >= VertexFifo.Num())
-				{
-					return false;
-				}
-
-				const uint32 C = VertexFifo[NibbleRight];
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, AB.Value), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(AB.Key, C), 0); // push AC
-
-				EmitTriangle(AB.Key, AB.Value, C);
-			}
-			else if (NibbleLeft < 0xf && NibbleRight == 0x0d) // 0xXd
-			{
-				if (NibbleLeft >= EdgeFifo.Num())
-				{
-					return false;
-				}
-				const TPair<uint32, uint32> AB = EdgeFifo[NibbleLeft];
-
-				const uint32 C = Last - 1;
-				Last = C;
-
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, AB.Value), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(AB.Key, C), 0); // push AC
-				VertexFifo.Insert(C, 0);
-
-				EmitTriangle(AB.Key, AB.Value, C);
-			}
-			else if (NibbleLeft < 0xf && NibbleRight == 0x0e) // 0xXe
-			{
-				if (NibbleLeft >= EdgeFifo.Num())
-				{
-					return false;
-				}
-				const TPair<uint32, uint32> AB = EdgeFifo[NibbleLeft];
-
-				const uint32 C = Last + 1;
-				Last = C;
-
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, AB.Value), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(AB.Key, C), 0); // push AC
-				VertexFifo.Insert(C, 0);
-
-				EmitTriangle(AB.Key, AB.Value, C);
-			}
-			else if (NibbleLeft < 0xf && NibbleRight == 0x0f) // 0xXf
-			{
-				if (NibbleLeft >= EdgeFifo.Num())
-				{
-					return false;
-				}
-				const TPair<uint32, uint32> AB = EdgeFifo[NibbleLeft];
-
-				if (!DecodeIndex())
-				{
-					return false;
-				}
-
-				const uint32 C = Last;
-
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, AB.Value), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(AB.Key, C), 0); // push AC
-				VertexFifo.Insert(C, 0);
-
-				EmitTriangle(AB.Key, AB.Value, C);
-			}
-			else if (NibbleLeft == 0xf && NibbleRight < 0xe) // 0xfY
-			{
-				const uint8 ZW = CodeAux[NibbleRight];
-				const uint8 Z = ZW >> 4;
-				const uint8 W = ZW & 0x0f;
-
-				const uint32 A = Next++;
-				uint32 B = 0;
-				uint32 C = 0;
-
-				if (Z == 0)
-				{
-					B = Next++;
-				}
-				else
-				{
-					if (Z - 1 >= VertexFifo.Num())
-					{
-						return false;
-					}
-					B = VertexFifo[Z - 1];
-				}
-
-				if (W == 0)
-				{
-					C = Next++;
-				}
-				else
-				{
-					if (W - 1 >= VertexFifo.Num())
-					{
-						return false;
-					}
-					C = VertexFifo[W - 1];
-				}
-
-				EdgeFifo.Insert(TPair<uint32, uint32>(B, A), 0); // push BA
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, B), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(A, C), 0); // push AC
-				VertexFifo.Insert(A, 0);
-				if (Z == 0)
-				{
-					VertexFifo.Insert(B, 0);
-				}
-				if (W == 0)
-				{
-					VertexFifo.Insert(C, 0);
-				}
-
-				EmitTriangle(A, B, C);
-			}
-			else if (Code == 0xfe || Code == 0xff) // 0xfe - 0xff
-			{
-				if (DataOffset >= Limit)
-				{
-					return false;
-				}
-
-				uint8 ZW = Blob.Data[DataOffset++];
-				uint8 Z = ZW >> 4;
-				uint8 W = ZW & 0x0f;
-				if (ZW == 0)
-				{
-					Next = 0;
-				}
-
-				uint32 A = 0;
-				if (Code == 0xfe)
-				{
-					A = Next++;
-				}
-				else
-				{
-					if (!DecodeIndex())
-					{
-						return false;
-					}
-					A = Last;
-				}
-
-				uint32 B = 0;
-				if (Z == 0)
-				{
-					B = Next++;
-				}
-				else if (Z < 0xf)
-				{
-					if (Z - 1 >= VertexFifo.Num())
-					{
-						return false;
-					}
-					B = VertexFifo[Z - 1];
-				}
-				else
-				{
-					if (!DecodeIndex())
-					{
-						return false;
-					}
-					B = Last;
-				}
-
-				uint32 C = 0;
-				if (W == 0)
-				{
-					C = Next++;
-				}
-				else if (W < 0xf)
-				{
-					if (W - 1 >= VertexFifo.Num())
-					{
-						return false;
-					}
-					C = VertexFifo[W - 1];
-				}
-				else
-				{
-					if (!DecodeIndex())
-					{
-						return false;
-					}
-					C = Last;
-				}
-
-				EdgeFifo.Insert(TPair<uint32, uint32>(B, A), 0); // push BA
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, B), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(A, C), 0); // push AC
-				VertexFifo.Insert(A, 0);
-				if (Z == 0 || Z == 0xf)
-				{
-					VertexFifo.Insert(B, 0);
-				}
-				if (W == 0 || W == 0xf)
-				{
-					VertexFifo.Insert(C, 0);
-				}
-
-				EmitTriangle(A, B, C);
-			}
-		}
-	}
-	else
-	{
-		return false;
-	}
-
-	if (UncompressedBytes.Num() > 0)
+	if (!bAllNodesCached)
 	{
-		if (Filter == "OCTAHEDRAL" && (Stride == 4 || Stride == 8))
-		{
-			for (int64 ElementIndex = 0; ElementIndex < Elements; ElementIndex++)
-			{
-				int64 Offset = ElementIndex * Stride;
-				if (Stride == 4)
-				{
-					int8* Data = reinterpret_cast<int8*>(UncompressedBytes.GetData());
-					float One = Data[Offset + 2];
-					float X = Data[Offset] / One;
-					float Y = Data[Offset + 1] / One;
-					float Z = 1.0f - FMath::Abs(X) - FMath::Abs(Y);
-
-					float T = FMath::Max(-Z, 0.0f);
-
-					X -= (X >= 0) ? T : -T;
-					Y -= (Y >= 0) ? T : -T;
-
-					float Len = FMath::Sqrt(X * X + Y * Y + Z * Z);
-
-					X /= Len;
-					Y /= Len;
-					Z /= Len;
-
-					Data[Offset] = FMath::RoundToInt(X * 127);
-					Data[Offset + 1] = FMath::RoundToInt(Y * 127);
-					Data[Offset + 2] = FMath::RoundToInt(Z * 127);
-				}
-				else
-				{
-					int16* Data = reinterpret_cast<int16*>(UncompressedBytes.GetData());
-					float One = Data[Offset + 2];
-					float X = Data[Offset] / One;
-					float Y = Data[Offset + 1] / One;
-					float Z = 1.0f - FMath::Abs(X) - FMath::Abs(Y);
-
-					float T = FMath::Max(-Z, 0.0f);
-
-					X -= (X >= 0) ? T : -T;
-					Y -= (Y >= 0) ? T : -T;
-
-					float Len = FMath::Sqrt(X * X + Y * Y + Z * Z);
-
-					X /= Len;
-					Y /= Len;
-					Z /= Len;
-
-					Data[Offset] = FMath::RoundToInt(X * 32767);
-					Data[Offset + 1] = FMath::RoundToInt(Y * 32767);
-					Data[Offset + 2] = FMath::RoundToInt(Z * 32767);
-				}
-			}
-		}
-		else if (Filter == "QUATERNION" && Stride == 8)
-		{
-			int16* Data = reinterpret_cast<int16*>(UncompressedBytes.GetData());
-
-			const float Range = 1.0f / FMath::Sqrt(2.0f);
-
-			for (int64 Offset = 0; Offset < Elements * 4; Offset += 4)
-			{
-				float One = Data[Offset + 3] | 3;
-
-				float X = Data[Offset] / One * Range;
-				float Y = Data[Offset + 1] / One * Range;
-				float Z = Data[Offset + 2] / One * Range;
-
-				float W = FMath::Sqrt(FMath::Max(0.0, 1.0 - X * X - Y * Y - Z * Z));
-
-				int32 MaxComp = Data[Offset + 3] & 3;
-
-				Data[Offset + ((MaxComp + 1) % 4)] = FMath::RoundToInt(X * 32767.0);
-				Data[Offset + ((MaxComp + 2) % 4)] = FMath::RoundToInt(Y * 32767.0);
-				Data[Offset + ((MaxComp + 3) % 4)] = FMath::RoundToInt(Z * 32767.0);
-				Data[Offset + ((MaxComp + 0) % 4)] = FMath::RoundToInt(W * 32767.0);
-			}
-		}
-		else if (Filter == "EXPONENTIAL" && (Stride % 4) == 0)
-		{
-			int32* Data = reinterpret_cast<int32*>(UncompressedBytes.GetData());
-			for (int64 Offset = 0; Offset < UncompressedBytes.Num() / 4; Offset += 4)
-			{
-				int32 E = Data[Offset] >> 24;
-				int32 M = (Data[Offset] << 8) >> 8;
-				Data[Offset] = FMath::Pow(2.0f, E) * M;
-			}
-		}
-		else if (Filter != "" && Filter != "NONE")
+		if (!LoadNodes())
 		{
-			AddError("DecompressMeshOptimizer()", "Unsupported Filter");
-			return false;
+			return FTransform::Identity;
 		}
 	}
 
-	return true;
-}
-
-FTransform FglTFRuntimeParser::GetParentNodeWorldTransform(const FglTFRuntimeNode& Node)
-{
-	FTransform WorldTransform = FTransform::Identity;
-	int32 ParentIndex = Node.ParentIndex;
-	while (ParentIndex > INDEX_NONE)
+	if (!NodesWorldTransformsCache.IsValidIndex(Node.ParentIndex))
 	{
-		FglTFRuntimeNode ParentNode;
-		if (!LoadNode(ParentIndex, ParentNode))
-		{
-			break;
-		}
-
-		WorldTransform = ParentNode.Transform * WorldTransform;
-		ParentIndex = ParentNode.ParentIndex;
+		return FTransform::Identity;
 	}
 
-	return WorldTransform;
+	return NodesWorldTransformsCache[Node.ParentIndex];
 }
 
 FTransform FglTFRuntimeParser::GetNodeWorldTransform(const FglTFRuntimeNode& Node)
@@ -4920,7 +5592,7 @@ FString FglTFRuntimeParser::ToJsonString() const
 {
 	FString Json;
 	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&Json);
-	FJsonSerializer::Serialize(MakeShared<FJsonValueObject>(GetJsonRoot()), "", JsonWriter);
+	FJsonSerializer::Serialize(MakeShared<FJsonValueObject>(GetJsonRootObject()), "", JsonWriter);
 
 	return Json;
 }
@@ -4932,46 +5604,32 @@ int32 FglTFRuntimeParser::GetNodeDistance(const FglTFRuntimeNode& Node, const in
 		return 0;
 	}
 
-	int32 Distance = 0;
-
-	FglTFRuntimeNode CurrentNode = Node;
-	while (CurrentNode.ParentIndex > INDEX_NONE)
+	if (!bAllNodesCached)
 	{
-		Distance++;
-		if (!LoadNode(CurrentNode.ParentIndex, CurrentNode))
+		if (!LoadNodes())
 		{
 			return -1;
 		}
+	}
 
-		if (CurrentNode.Index == Ancestor)
-		{
-			return Distance;
-		}
+	if (!IsNodeAncestor(Node.Index, Ancestor))
+	{
+		return -1;
 	}
 
-	return -1;
+	return NodesDepthCache[Node.Index] - NodesDepthCache[Ancestor];
 }
 
 FString FglTFRuntimeParser::GetVersion() const
 {
-	TSharedPtr<FJsonObject> Asset = GetJsonObjectFromObject(GetJsonRoot().ToSharedRef(), "asset");
-	if (!Asset)
-	{
-		return "";
-	}
-
-	return GetJsonObjectString(Asset.ToSharedRef(), "version", "");
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	return JsonTape->GetStringField(JsonTape->GetObjectField(JsonTape->GetRootNode(), "asset"), "version", "");
 }
 
 FString FglTFRuntimeParser::GetGenerator() const
 {
-	TSharedPtr<FJsonObject> Asset = GetJsonObjectFromObject(GetJsonRoot().ToSharedRef(), "asset");
-	if (!Asset)
-	{
-		return "";
-	}
-
-	return GetJsonObjectString(Asset.ToSharedRef(), "generator", "");
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	return JsonTape->GetStringField(JsonTape->GetObjectField(JsonTape->GetRootNode(), "asset"), "generator", "");
 }
 
 bool FglTFRuntimeParser::IsArchive() const
@@ -5002,16 +5660,16 @@ bool FglTFRuntimeParser::GetBlobByName(const FString& Name, TArray64<uint8>& Blo
 
 void FglTFRuntimeParser::LoadMeshAsRuntimeLODAsync(const int32 MeshIndex, const FglTFRuntimeMeshLODAsync& AsyncCallback, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
 {
-	TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-	if (!JsonMeshObject)
+	if (!HasJsonRootObject("meshes", MeshIndex))
 	{
 		AsyncCallback.ExecuteIfBound(false, FglTFRuntimeMeshLOD());
+		return;
 	}
 
-	Async(EAsyncExecution::Thread, [this, JsonMeshObject, MaterialsConfig, AsyncCallback]()
+	Async(EAsyncExecution::Thread, [this, MeshIndex, MaterialsConfig, AsyncCallback]()
 		{
 			FglTFRuntimeMeshLOD* LOD;
-			bool bSuccess = LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, MaterialsConfig);
+			bool bSuccess = LoadMeshIntoMeshLOD(MeshIndex, LOD, MaterialsConfig);
 			FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([bSuccess, LOD, AsyncCallback]()
 				{
 					AsyncCallback.ExecuteIfBound(bSuccess, bSuccess ? *LOD : FglTFRuntimeMeshLOD());
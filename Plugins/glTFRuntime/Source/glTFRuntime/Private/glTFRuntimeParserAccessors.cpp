@@ -0,0 +1,255 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#define GLTFRUNTIME_ACCESSORS_NEON 1
+#include <arm_neon.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+// SSE2 is enough for widening and converting the components
+#define GLTFRUNTIME_ACCESSORS_SSE 1
+#include <emmintrin.h>
+#endif
+
+#ifndef GLTFRUNTIME_ACCESSORS_NEON
+#define GLTFRUNTIME_ACCESSORS_NEON 0
+#endif
+
+#ifndef GLTFRUNTIME_ACCESSORS_SSE
+#define GLTFRUNTIME_ACCESSORS_SSE 0
+#endif
+
+namespace
+{
+	// the scalar tails use the same formulas of DecodeAccessorComponent, int32 to float conversions of 8 and 16 bit values and IEEE divisions are exact, so every lane matches the scalar result bit by bit
+	template<typename ComponentType>
+	FORCEINLINE float DecodeComponent(const ComponentType Value, const float Divisor, const bool bSigned, const bool bNormalized)
+	{
+		if (!bNormalized)
+		{
+			return Value;
+		}
+		return bSigned ? FMath::Max(((float)Value) / Divisor, -1.f) : ((float)Value) / Divisor;
+	}
+
+#if GLTFRUNTIME_ACCESSORS_SSE
+	FORCEINLINE void StoreComponents(const __m128i Value, const __m128 Divisor, const bool bSigned, const bool bNormalized, float* Values)
+	{
+		__m128 Result = _mm_cvtepi32_ps(Value);
+		if (bNormalized)
+		{
+			Result = _mm_div_ps(Result, Divisor);
+			if (bSigned)
+			{
+				Result = _mm_max_ps(Result, _mm_set1_ps(-1.f));
+			}
+		}
+		_mm_storeu_ps(Values, Result);
+	}
+#elif GLTFRUNTIME_ACCESSORS_NEON
+	FORCEINLINE void StoreComponents(const int32x4_t Value, const float32x4_t Divisor, const bool bSigned, const bool bNormalized, float* Values)
+	{
+		float32x4_t Result = vcvtq_f32_s32(Value);
+		if (bNormalized)
+		{
+			Result = vdivq_f32(Result, Divisor);
+			if (bSigned)
+			{
+				Result = vmaxq_f32(Result, vdupq_n_f32(-1.f));
+			}
+		}
+		vst1q_f32(Values, Result);
+	}
+#endif
+}
+
+void FglTFRuntimeParser::DecodeAccessorComponents(const int8* Components, const int64 Num, const bool bNormalized, float* Values)
+{
+	int64 Index = 0;
+#if GLTFRUNTIME_ACCESSORS_SSE
+	const __m128 Divisor = _mm_set1_ps(127.f);
+	for (; Index + 16 <= Num; Index += 16)
+	{
+		const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Components + Index));
+		// sign extension: the byte goes in the high half of each lane and is shifted back arithmetically
+		const __m128i Low16 = _mm_srai_epi16(_mm_unpacklo_epi8(Bytes, Bytes), 8);
+		const __m128i High16 = _mm_srai_epi16(_mm_unpackhi_epi8(Bytes, Bytes), 8);
+		StoreComponents(_mm_srai_epi32(_mm_unpacklo_epi16(Low16, Low16), 16), Divisor, true, bNormalized, Values + Index);
+		StoreComponents(_mm_srai_epi32(_mm_unpackhi_epi16(Low16, Low16), 16), Divisor, true, bNormalized, Values + Index + 4);
+		StoreComponents(_mm_srai_epi32(_mm_unpacklo_epi16(High16, High16), 16), Divisor, true, bNormalized, Values + Index + 8);
+		StoreComponents(_mm_srai_epi32(_mm_unpackhi_epi16(High16, High16), 16), Divisor, true, bNormalized, Values + Index + 12);
+	}
+#elif GLTFRUNTIME_ACCESSORS_NEON
+	const float32x4_t Divisor = vdupq_n_f32(127.f);
+	for (; Index + 16 <= Num; Index += 16)
+	{
+		const int8x16_t Bytes = vld1q_s8(Components + Index);
+		const int16x8_t Low16 = vmovl_s8(vget_low_s8(Bytes));
+		const int16x8_t High16 = vmovl_s8(vget_high_s8(Bytes));
+		StoreComponents(vmovl_s16(vget_low_s16(Low16)), Divisor, true, bNormalized, Values + Index);
+		StoreComponents(vmovl_s16(vget_high_s16(Low16)), Divisor, true, bNormalized, Values + Index + 4);
+		StoreComponents(vmovl_s16(vget_low_s16(High16)), Divisor, true, bNormalized, Values + Index + 8);
+		StoreComponents(vmovl_s16(vget_high_s16(High16)), Divisor, true, bNormalized, Values + Index + 12);
+	}
+#endif
+	for (; Index < Num; Index++)
+	{
+		Values[Index] = DecodeComponent(Components[Index], 127.f, true, bNormalized);
+	}
+}
+
+void FglTFRuntimeParser::DecodeAccessorComponents(const uint8* Components, const int64 Num, const bool bNormalized, float* Values)
+{
+	int64 Index = 0;
+#if GLTFRUNTIME_ACCESSORS_SSE
+	const __m128 Divisor = _mm_set1_ps(255.f);
+	const __m128i Zero = _mm_setzero_si128();
+	for (; Index + 16 <= Num; Index += 16)
+	{
+		const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Components + Index));
+		const __m128i Low16 = _mm_unpacklo_epi8(Bytes, Zero);
+		const __m128i High16 = _mm_unpackhi_epi8(Bytes, Zero);
+		StoreComponents(_mm_unpacklo_epi16(Low16, Zero), Divisor, false, bNormalized, Values + Index);
+		StoreComponents(_mm_unpackhi_epi16(Low16, Zero), Divisor, false, bNormalized, Values + Index + 4);
+		StoreComponents(_mm_unpacklo_epi16(High16, Zero), Divisor, false, bNormalized, Values + Index + 8);
+		StoreComponents(_mm_unpackhi_epi16(High16, Zero), Divisor, false, bNormalized, Values + Index + 12);
+	}
+#elif GLTFRUNTIME_ACCESSORS_NEON
+	const float32x4_t Divisor = vdupq_n_f32(255.f);
+	for (; Index + 16 <= Num; Index += 16)
+	{
+		const uint8x16_t Bytes = vld1q_u8(Components + Index);
+		const uint16x8_t Low16 = vmovl_u8(vget_low_u8(Bytes));
+		const uint16x8_t High16 = vmovl_u8(vget_high_u8(Bytes));
+		StoreComponents(vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(Low16))), Divisor, false, bNormalized, Values + Index);
+		StoreComponents(vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(Low16))), Divisor, false, bNormalized, Values + Index + 4);
+		StoreComponents(vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(High16))), Divisor, false, bNormalized, Values + Index + 8);
+		StoreComponents(vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(High16))), Divisor, false, bNormalized, Values + Index + 12);
+	}
+#endif
+	for (; Index < Num; Index++)
+	{
+		Values[Index] = DecodeComponent(Components[Index], 255.f, false, bNormalized);
+	}
+}
+
+void FglTFRuntimeParser::DecodeAccessorComponents(const int16* Components, const int64 Num, const bool bNormalized, float* Values)
+{
+	int64 Index = 0;
+#if GLTFRUNTIME_ACCESSORS_SSE
+	const __m128 Divisor = _mm_set1_ps(32767.f);
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		const __m128i Shorts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Components + Index));
+		StoreComponents(_mm_srai_epi32(_mm_unpacklo_epi16(Shorts, Shorts), 16), Divisor, true, bNormalized, Values + Index);
+		StoreComponents(_mm_srai_epi32(_mm_unpackhi_epi16(Shorts, Shorts), 16), Divisor, true, bNormalized, Values + Index + 4);
+	}
+#elif GLTFRUNTIME_ACCESSORS_NEON
+	const float32x4_t Divisor = vdupq_n_f32(32767.f);
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		const int16x8_t Shorts = vld1q_s16(Components + Index);
+		StoreComponents(vmovl_s16(vget_low_s16(Shorts)), Divisor, true, bNormalized, Values + Index);
+		StoreComponents(vmovl_s16(vget_high_s16(Shorts)), Divisor, true, bNormalized, Values + Index + 4);
+	}
+#endif
+	for (; Index < Num; Index++)
+	{
+		Values[Index] = DecodeComponent(Components[Index], 32767.f, true, bNormalized);
+	}
+}
+
+void FglTFRuntimeParser::DecodeAccessorComponents(const uint16* Components, const int64 Num, const bool bNormalized, float* Values)
+{
+	int64 Index = 0;
+#if GLTFRUNTIME_ACCESSORS_SSE
+	const __m128 Divisor = _mm_set1_ps(65535.f);
+	const __m128i Zero = _mm_setzero_si128();
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		const __m128i Shorts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Components + Index));
+		StoreComponents(_mm_unpacklo_epi16(Shorts, Zero), Divisor, false, bNormalized, Values + Index);
+		StoreComponents(_mm_unpackhi_epi16(Shorts, Zero), Divisor, false, bNormalized, Values + Index + 4);
+	}
+#elif GLTFRUNTIME_ACCESSORS_NEON
+	const float32x4_t Divisor = vdupq_n_f32(65535.f);
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		const uint16x8_t Shorts = vld1q_u16(Components + Index);
+		StoreComponents(vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(Shorts))), Divisor, false, bNormalized, Values + Index);
+		StoreComponents(vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(Shorts))), Divisor, false, bNormalized, Values + Index + 4);
+	}
+#endif
+	for (; Index < Num; Index++)
+	{
+		Values[Index] = DecodeComponent(Components[Index], 65535.f, false, bNormalized);
+	}
+}
+
+void FglTFRuntimeParser::DecodeAccessorComponents(const float* Components, const int64 Num, const bool bNormalized, float* Values)
+{
+	FMemory::Memcpy(Values, Components, Num * sizeof(float));
+}
+
+void FglTFRuntimeParser::DecodeIndices(const uint8* Indices, const int64 Num, uint32* Values)
+{
+	int64 Index = 0;
+#if GLTFRUNTIME_ACCESSORS_SSE
+	const __m128i Zero = _mm_setzero_si128();
+	for (; Index + 16 <= Num; Index += 16)
+	{
+		const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Indices + Index));
+		const __m128i Low16 = _mm_unpacklo_epi8(Bytes, Zero);
+		const __m128i High16 = _mm_unpackhi_epi8(Bytes, Zero);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Values + Index), _mm_unpacklo_epi16(Low16, Zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Values + Index + 4), _mm_unpackhi_epi16(Low16, Zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Values + Index + 8), _mm_unpacklo_epi16(High16, Zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Values + Index + 12), _mm_unpackhi_epi16(High16, Zero));
+	}
+#elif GLTFRUNTIME_ACCESSORS_NEON
+	for (; Index + 16 <= Num; Index += 16)
+	{
+		const uint8x16_t Bytes = vld1q_u8(Indices + Index);
+		const uint16x8_t Low16 = vmovl_u8(vget_low_u8(Bytes));
+		const uint16x8_t High16 = vmovl_u8(vget_high_u8(Bytes));
+		vst1q_u32(Values + Index, vmovl_u16(vget_low_u16(Low16)));
+		vst1q_u32(Values + Index + 4, vmovl_u16(vget_high_u16(Low16)));
+		vst1q_u32(Values + Index + 8, vmovl_u16(vget_low_u16(High16)));
+		vst1q_u32(Values + Index + 12, vmovl_u16(vget_high_u16(High16)));
+	}
+#endif
+	for (; Index < Num; Index++)
+	{
+		Values[Index] = Indices[Index];
+	}
+}
+
+void FglTFRuntimeParser::DecodeIndices(const uint16* Indices, const int64 Num, uint32* Values)
+{
+	int64 Index = 0;
+#if GLTFRUNTIME_ACCESSORS_SSE
+	const __m128i Zero = _mm_setzero_si128();
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		const __m128i Shorts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Indices + Index));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Values + Index), _mm_unpacklo_epi16(Shorts, Zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Values + Index + 4), _mm_unpackhi_epi16(Shorts, Zero));
+	}
+#elif GLTFRUNTIME_ACCESSORS_NEON
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		const uint16x8_t Shorts = vld1q_u16(Indices + Index);
+		vst1q_u32(Values + Index, vmovl_u16(vget_low_u16(Shorts)));
+		vst1q_u32(Values + Index + 4, vmovl_u16(vget_high_u16(Shorts)));
+	}
+#endif
+	for (; Index < Num; Index++)
+	{
+		Values[Index] = Indices[Index];
+	}
+}
+
+void FglTFRuntimeParser::DecodeIndices(const uint32* Indices, const int64 Num, uint32* Values)
+{
+	FMemory::Memcpy(Values, Indices, Num * sizeof(uint32));
+}
@@ -66,7 +66,7 @@ TSharedPtr<FJsonValue> FglTFRuntimeParser::GetJSONObjectFromRelativePath(TShared
 
 TSharedPtr<FJsonValue> FglTFRuntimeParser::GetJSONObjectFromPath(const TArray<FglTFRuntimePathItem>& Path) const
 {
-	return GetJSONObjectFromRelativePath(Root, Path);
+	return GetJSONObjectFromRelativePath(GetJsonRootObject(), Path);
 }
 
 FString FglTFRuntimeParser::GetJSONStringFromPath(const TArray<FglTFRuntimePathItem>& Path, bool& bFound) const
@@ -2,6 +2,7 @@
 
 #include "glTFRuntimeParser.h"
 #include "Runtime/Launch/Resources/Version.h"
+#include "Async/ParallelFor.h"
 #include "Engine/Texture2D.h"
 #include "IImageWrapperModule.h"
 #include "IImageWrapper.h"
@@ -18,8 +19,204 @@
 #include "Modules/ModuleManager.h"
 #include "TextureResource.h"
 
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#define GLTFRUNTIME_MIPS_NEON 1
+#include <arm_neon.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+// SSE2 is enough for the 16 bit sums of the box filter
+#define GLTFRUNTIME_MIPS_SSE 1
+#include <emmintrin.h>
+#endif
+
+#ifndef GLTFRUNTIME_MIPS_NEON
+#define GLTFRUNTIME_MIPS_NEON 0
+#endif
+
+#ifndef GLTFRUNTIME_MIPS_SSE
+#define GLTFRUNTIME_MIPS_SSE 0
+#endif
 
-UMaterialInterface* FglTFRuntimeParser::LoadMaterial_Internal(const int32 Index, const FString& MaterialName, TSharedRef<FJsonObject> JsonMaterialObject, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const bool bUseVertexColors)
+namespace
+{
+	enum class EglTFRuntimeTextureSlot : uint8
+	{
+		BaseColor,
+		MetallicRoughness,
+		Normal,
+		Occlusion,
+		Emissive,
+		Diffuse,
+		SpecularGlossiness,
+		Transmission,
+		Specular,
+		Max
+	};
+
+	struct FglTFRuntimeTextureSlot
+	{
+		// object of the material holding the texture (nullptr for the material itself)
+		const ANSICHAR* ObjectName;
+		bool bExtension;
+		const ANSICHAR* ParamName;
+		bool sRGB;
+	};
+
+	// the textures of a material, shared by LoadMaterial_Internal and PrefetchMaterialsTextures
+	const FglTFRuntimeTextureSlot TextureSlots[] =
+	{
+		{ "pbrMetallicRoughness", false, "baseColorTexture", true },
+		{ "pbrMetallicRoughness", false, "metallicRoughnessTexture", false },
+		{ nullptr, false, "normalTexture", false },
+		{ nullptr, false, "occlusionTexture", false },
+		{ nullptr, false, "emissiveTexture", true },
+		{ "KHR_materials_pbrSpecularGlossiness", true, "diffuseTexture", true },
+		{ "KHR_materials_pbrSpecularGlossiness", true, "specularGlossinessTexture", true },
+		{ "KHR_materials_transmission", true, "transmissionTexture", false },
+		{ "KHR_materials_specular", true, "specularTexture", false },
+	};
+	static_assert(UE_ARRAY_COUNT(TextureSlots) == static_cast<int32>(EglTFRuntimeTextureSlot::Max), "TextureSlots does not match EglTFRuntimeTextureSlot");
+
+	int32 GetTextureSlotObject(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonMaterialNode, const FglTFRuntimeTextureSlot& TextureSlot)
+	{
+		if (!TextureSlot.ObjectName)
+		{
+			return JsonMaterialNode;
+		}
+		return JsonTape.GetObjectField(TextureSlot.bExtension ? JsonTape.GetObjectField(JsonMaterialNode, "extensions") : JsonMaterialNode, TextureSlot.ObjectName);
+	}
+
+	struct FglTFRuntimeTextureToPrefetch
+	{
+		int32 TextureIndex;
+		bool sRGB;
+		TSharedPtr<FJsonObject> JsonTextureObject;
+		TSharedPtr<FJsonObject> JsonImageObject;
+		TArray64<uint8> Blob;
+		FSHAHash ContentKey;
+		TArray<FglTFRuntimeMipMap> Mips;
+		bool bLoaded;
+	};
+
+	void WriteMips(FglTFRuntimeDerivedDataWriter& Writer, const TArray<FglTFRuntimeMipMap>& Mips)
+	{
+		Writer.Write<int32>(Mips.Num());
+		for (const FglTFRuntimeMipMap& MipMap : Mips)
+		{
+			Writer.Write<int32>(MipMap.PixelFormat);
+			Writer.Write<int32>(MipMap.Width);
+			Writer.Write<int32>(MipMap.Height);
+			Writer.WriteArray(MipMap.Pixels);
+		}
+	}
+
+	bool ReadMips(FglTFRuntimeDerivedDataReader& Reader, const int32 TextureIndex, TArray<FglTFRuntimeMipMap>& Mips)
+	{
+		int32 MipsNum = 0;
+		if (!Reader.Read(MipsNum) || MipsNum <= 0)
+		{
+			return false;
+		}
+
+		for (int32 MipIndex = 0; MipIndex < MipsNum; MipIndex++)
+		{
+			int32 PixelFormat = 0;
+			int32 Width = 0;
+			int32 Height = 0;
+			if (!Reader.Read(PixelFormat) || PixelFormat <= PF_Unknown || PixelFormat >= PF_MAX || !Reader.Read(Width) || !Reader.Read(Height))
+			{
+				return false;
+			}
+
+			FglTFRuntimeMipMap MipMap(TextureIndex, static_cast<EPixelFormat>(PixelFormat), Width, Height);
+			if (!Reader.ReadArray(MipMap.Pixels))
+			{
+				return false;
+			}
+			Mips.Add(MoveTemp(MipMap));
+		}
+
+		return Reader.Offset == Reader.Num;
+	}
+
+	// 2x2 box filter of a row pair, every channel is (A + B + C + D + 2) / 4 (the SIMD paths compute exactly the same rounding)
+	void DownsampleMipRowLinear(const FColor* Row0, const FColor* Row1, const int32 Width, FColor* MipRow, const int32 MipWidth, const bool bForceScalar)
+	{
+		int32 MipX = 0;
+#if GLTFRUNTIME_MIPS_SSE || GLTFRUNTIME_MIPS_NEON
+		// 8 source pixels of both rows for 4 mip pixels
+		if (!bForceScalar && Width == MipWidth * 2)
+		{
+			const uint8* Source0 = reinterpret_cast<const uint8*>(Row0);
+			const uint8* Source1 = reinterpret_cast<const uint8*>(Row1);
+			uint8* Destination = reinterpret_cast<uint8*>(MipRow);
+#if GLTFRUNTIME_MIPS_SSE
+			const __m128i Zero = _mm_setzero_si128();
+			const __m128i Two = _mm_set1_epi16(2);
+			// sums the two rows of 4 pixels and then the pixels pairs, the results are 2 mip pixels as 16 bit channels
+			auto SumQuads = [&](const __m128i Pixels0, const __m128i Pixels1)
+				{
+					const __m128i Low = _mm_add_epi16(_mm_unpacklo_epi8(Pixels0, Zero), _mm_unpacklo_epi8(Pixels1, Zero));
+					const __m128i High = _mm_add_epi16(_mm_unpackhi_epi8(Pixels0, Zero), _mm_unpackhi_epi8(Pixels1, Zero));
+					const __m128i Pairs = _mm_unpacklo_epi64(_mm_add_epi16(Low, _mm_srli_si128(Low, 8)), _mm_add_epi16(High, _mm_srli_si128(High, 8)));
+					return _mm_srli_epi16(_mm_add_epi16(Pairs, Two), 2);
+				};
+
+			for (; MipX + 4 <= MipWidth; MipX += 4)
+			{
+				const __m128i First = SumQuads(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Source0 + MipX * 8)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source1 + MipX * 8)));
+				const __m128i Second = SumQuads(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Source0 + MipX * 8 + 16)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source1 + MipX * 8 + 16)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Destination + MipX * 4), _mm_packus_epi16(First, Second));
+			}
+#else
+			for (; MipX + 4 <= MipWidth; MipX += 4)
+			{
+				// even and odd pixels are deinterleaved, so every lane pairs horizontally adjacent pixels
+				const uint32x4x2_t Pixels0 = vld2q_u32(reinterpret_cast<const uint32*>(Source0 + MipX * 8));
+				const uint32x4x2_t Pixels1 = vld2q_u32(reinterpret_cast<const uint32*>(Source1 + MipX * 8));
+				const uint8x16_t Even0 = vreinterpretq_u8_u32(Pixels0.val[0]);
+				const uint8x16_t Odd0 = vreinterpretq_u8_u32(Pixels0.val[1]);
+				const uint8x16_t Even1 = vreinterpretq_u8_u32(Pixels1.val[0]);
+				const uint8x16_t Odd1 = vreinterpretq_u8_u32(Pixels1.val[1]);
+				const uint16x8_t Low = vaddq_u16(vaddl_u8(vget_low_u8(Even0), vget_low_u8(Odd0)), vaddl_u8(vget_low_u8(Even1), vget_low_u8(Odd1)));
+				const uint16x8_t High = vaddq_u16(vaddl_u8(vget_high_u8(Even0), vget_high_u8(Odd0)), vaddl_u8(vget_high_u8(Even1), vget_high_u8(Odd1)));
+				// rounding narrow shift: (Sum + 2) >> 2
+				vst1q_u8(Destination + MipX * 4, vcombine_u8(vrshrn_n_u16(Low, 2), vrshrn_n_u16(High, 2)));
+			}
+#endif
+		}
+#endif
+
+		for (; MipX < MipWidth; MipX++)
+		{
+			const int32 X0 = FMath::Min(MipX * 2, Width - 1);
+			const int32 X1 = FMath::Min(MipX * 2 + 1, Width - 1);
+			const uint8* Pixels[4] = { reinterpret_cast<const uint8*>(Row0 + X0), reinterpret_cast<const uint8*>(Row0 + X1), reinterpret_cast<const uint8*>(Row1 + X0), reinterpret_cast<const uint8*>(Row1 + X1) };
+			uint8* MipPixel = reinterpret_cast<uint8*>(MipRow + MipX);
+			for (int32 Channel = 0; Channel < 4; Channel++)
+			{
+				MipPixel[Channel] = static_cast<uint8>((Pixels[0][Channel] + Pixels[1][Channel] + Pixels[2][Channel] + Pixels[3][Channel] + 2) >> 2);
+			}
+		}
+	}
+
+	// sRGB colors are averaged in linear space (like FImageUtils::ImageResize does for sRGB textures), alpha is always linear
+	void DownsampleMipRowSRGB(const FColor* Row0, const FColor* Row1, const int32 Width, FColor* MipRow, const int32 MipWidth)
+	{
+		for (int32 MipX = 0; MipX < MipWidth; MipX++)
+		{
+			const int32 X0 = FMath::Min(MipX * 2, Width - 1);
+			const int32 X1 = FMath::Min(MipX * 2 + 1, Width - 1);
+			const FLinearColor Average = (FLinearColor(Row0[X0]) + FLinearColor(Row0[X1]) + FLinearColor(Row1[X0]) + FLinearColor(Row1[X1])) * 0.25f;
+#if ENGINE_MAJOR_VERSION >= 5
+			MipRow[MipX] = Average.ToFColorSRGB();
+#else
+			MipRow[MipX] = Average.ToFColor(true);
+#endif
+		}
+	}
+}
+
+UMaterialInterface* FglTFRuntimeParser::LoadMaterial_Internal(const int32 Index, const FString& MaterialName, const FglTFRuntimeJsonTape& JsonTape, const int32 JsonMaterialNode, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const bool bUseVertexColors)
 {
 	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadMaterial_Internal, FColor::Magenta);
 	FglTFRuntimeMaterial RuntimeMaterial;
@@ -37,13 +234,13 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial_Internal(const int32 Index,
 		RuntimeMaterial.BaseSpecularFactor = MaterialsConfig.SpecularFactor;
 	}
 
-	if (!JsonMaterialObject->TryGetBoolField("doubleSided", RuntimeMaterial.bTwoSided))
+	if (!JsonTape.TryGetBoolField(JsonMaterialNode, "doubleSided", RuntimeMaterial.bTwoSided))
 	{
 		RuntimeMaterial.bTwoSided = false;
 	}
 
 	FString AlphaMode;
-	if (!JsonMaterialObject->TryGetStringField("alphaMode", AlphaMode))
+	if (!JsonTape.TryGetStringField(JsonMaterialNode, "alphaMode", AlphaMode))
 	{
 		AlphaMode = "OPAQUE";
 	}
@@ -56,7 +253,7 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial_Internal(const int32 Index,
 	{
 		RuntimeMaterial.bMasked = true;
 		double AlphaCutoffDouble;
-		if (!JsonMaterialObject->TryGetNumberField("alphaCutoff", AlphaCutoffDouble))
+		if (!JsonTape.TryGetNumberField(JsonMaterialNode, "alphaCutoff", AlphaCutoffDouble))
 		{
 			RuntimeMaterial.AlphaCutoff = 0.5f;
 		}
@@ -71,7 +268,7 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial_Internal(const int32 Index,
 		return nullptr;
 	}
 
-	if (!JsonMaterialObject->TryGetBoolField("useColorRamp", RuntimeMaterial.bUseColorRamp))
+	if (!JsonTape.TryGetBoolField(JsonMaterialNode, "useColorRamp", RuntimeMaterial.bUseColorRamp))
 	{
 		RuntimeMaterial.bUseColorRamp = false;
 	}
@@ -97,12 +294,12 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial_Internal(const int32 Index,
 		RuntimeMaterial.MaterialType = EglTFRuntimeMaterialType::TwoSided;
 	}
 
-	auto GetMaterialVector = [](const TSharedRef<FJsonObject> JsonMaterialObject, const FString& ParamName, const int32 Fields, bool& bHasParam, FLinearColor& ParamValue)
+	auto GetMaterialVector = [&JsonTape](const int32 JsonObjectNode, const ANSICHAR* ParamName, const int32 Fields, bool& bHasParam, FLinearColor& ParamValue)
 	{
-		const TArray<TSharedPtr<FJsonValue>>* JsonValues;
-		if (JsonMaterialObject->TryGetArrayField(ParamName, JsonValues))
+		const int32 JsonValuesNode = JsonTape.GetArrayField(JsonObjectNode, ParamName);
+		if (JsonValuesNode != INDEX_NONE)
 		{
-			if (JsonValues->Num() != Fields)
+			if (JsonTape.GetArrayNum(JsonValuesNode) != Fields)
 			{
 				return;
 			}
@@ -113,7 +310,7 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial_Internal(const int32 Index,
 
 			for (int32 Index = 0; Index < Fields; Index++)
 			{
-				(*JsonValues)[Index]->TryGetNumber(Values[Index]);
+				JsonTape.TryGetNumber(JsonTape.GetArrayItem(JsonValuesNode, Index), Values[Index]);
 			}
 
 			bHasParam = true;
@@ -121,131 +318,137 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial_Internal(const int32 Index,
 		}
 	};
 
-	auto GetMaterialTexture = [this, MaterialsConfig](const TSharedRef<FJsonObject> JsonMaterialObject, const FString& ParamName, const bool sRGB, UTexture2D*& ParamTextureCache, TArray<FglTFRuntimeMipMap>& ParamMips, FglTFRuntimeTextureTransform& ParamTransform, FglTFRuntimeTextureSampler& Sampler, const bool bForceNormalMapCompression) -> const TSharedPtr<FJsonObject>
+	auto GetMaterialTexture = [this, &JsonTape, MaterialsConfig](const int32 JsonObjectNode, const EglTFRuntimeTextureSlot Slot, UTexture2D*& ParamTextureCache, TArray<FglTFRuntimeMipMap>& ParamMips, FglTFRuntimeTextureTransform& ParamTransform, FglTFRuntimeTextureSampler& Sampler) -> int32
 	{
-		const TSharedPtr<FJsonObject>* JsonTextureObject;
-		if (JsonMaterialObject->TryGetObjectField(ParamName, JsonTextureObject))
+		const ANSICHAR* ParamName = TextureSlots[static_cast<int32>(Slot)].ParamName;
+		const int32 JsonTextureNode = JsonTape.GetObjectField(JsonObjectNode, ParamName);
+		if (JsonTextureNode != INDEX_NONE)
 		{
 			int64 TextureIndex;
-			if (!(*JsonTextureObject)->TryGetNumberField("index", TextureIndex))
+			if (!JsonTape.TryGetNumberField(JsonTextureNode, "index", TextureIndex))
 			{
-				return nullptr;
+				return INDEX_NONE;
 			}
 
-			if (!(*JsonTextureObject)->TryGetNumberField("texCoord", ParamTransform.TexCoord))
+			if (!JsonTape.TryGetNumberField(JsonTextureNode, "texCoord", ParamTransform.TexCoord))
 			{
 				ParamTransform.TexCoord = 0;
 			}
 
-			ParamTransform.Rotation = (1.0 / (PI * 2)) * GetJsonExtensionObjectNumber(JsonTextureObject->ToSharedRef(), "KHR_texture_transform", "rotation", 0) * -1;
-			TArray<double> Offset = GetJsonExtensionObjectNumbers(JsonTextureObject->ToSharedRef(), "KHR_texture_transform", "offset");
-			if (Offset.Num() >= 2)
+			const int32 JsonTextureTransformNode = JsonTape.GetObjectField(JsonTape.GetObjectField(JsonTextureNode, "extensions"), "KHR_texture_transform");
+			double Rotation = 0;
+			JsonTape.TryGetNumberField(JsonTextureTransformNode, "rotation", Rotation);
+			ParamTransform.Rotation = (1.0 / (PI * 2)) * Rotation * -1;
+			double Offset[2];
+			const int32 JsonOffsetNode = JsonTape.GetArrayField(JsonTextureTransformNode, "offset");
+			if (JsonTape.TryGetNumber(JsonTape.GetArrayItem(JsonOffsetNode, 0), Offset[0]) && JsonTape.TryGetNumber(JsonTape.GetArrayItem(JsonOffsetNode, 1), Offset[1]))
 			{
 				ParamTransform.Offset = FLinearColor(Offset[0], Offset[1], 0, 0);
 			}
-			TArray<double> Scale = GetJsonExtensionObjectNumbers(JsonTextureObject->ToSharedRef(), "KHR_texture_transform", "scale");
-			if (Scale.Num() >= 2)
+			double Scale[2];
+			const int32 JsonScaleNode = JsonTape.GetArrayField(JsonTextureTransformNode, "scale");
+			if (JsonTape.TryGetNumber(JsonTape.GetArrayItem(JsonScaleNode, 0), Scale[0]) && JsonTape.TryGetNumber(JsonTape.GetArrayItem(JsonScaleNode, 1), Scale[1]))
 			{
 				ParamTransform.Scale = FLinearColor(Scale[0], Scale[1], 1, 1);
 			}
-			ParamTransform.TexCoord = GetJsonExtensionObjectIndex(JsonTextureObject->ToSharedRef(), "KHR_texture_transform", "texCoord", ParamTransform.TexCoord);
+			JsonTape.TryGetNumberField(JsonTextureTransformNode, "texCoord", ParamTransform.TexCoord);
 
 			if (ParamTransform.TexCoord < 0 || ParamTransform.TexCoord > 3)
 			{
-				AddError("LoadMaterial_Internal()", FString::Printf(TEXT("Invalid UV Set for %s: %d"), *ParamName, ParamTransform.TexCoord));
-				return nullptr;
+				AddError("LoadMaterial_Internal()", FString::Printf(TEXT("Invalid UV Set for %s: %d"), ANSI_TO_TCHAR(ParamName), ParamTransform.TexCoord));
+				return INDEX_NONE;
 			}
 
 			// hack for allowing BC5 compression for plugins
-			if (bForceNormalMapCompression)
+			if (Slot == EglTFRuntimeTextureSlot::Normal)
 			{
 				FglTFRuntimeImagesConfig& ImagesConfig = const_cast<FglTFRuntimeImagesConfig&>(MaterialsConfig.ImagesConfig);
 				ImagesConfig.Compression = TextureCompressionSettings::TC_Normalmap;
 			}
 
-			ParamTextureCache = LoadTexture(TextureIndex, ParamMips, sRGB, MaterialsConfig, Sampler);
-			return *JsonTextureObject;
+			ParamTextureCache = LoadTexture(TextureIndex, ParamMips, TextureSlots[static_cast<int32>(Slot)].sRGB, MaterialsConfig, Sampler);
+			return JsonTextureNode;
 		}
-		return nullptr;
+		return INDEX_NONE;
 	};
 
-	const TSharedPtr<FJsonObject>* JsonPBRObject;
-	if (JsonMaterialObject->TryGetObjectField("pbrMetallicRoughness", JsonPBRObject))
+	const int32 JsonPBRNode = JsonTape.GetObjectField(JsonMaterialNode, "pbrMetallicRoughness");
+	if (JsonPBRNode != INDEX_NONE)
 	{
-		GetMaterialVector(JsonPBRObject->ToSharedRef(), "baseColorFactor", 4, RuntimeMaterial.bHasBaseColorFactor, RuntimeMaterial.BaseColorFactor);
-		GetMaterialTexture(JsonPBRObject->ToSharedRef(), "baseColorTexture", true, RuntimeMaterial.BaseColorTextureCache, RuntimeMaterial.BaseColorTextureMips, RuntimeMaterial.BaseColorTransform, RuntimeMaterial.BaseColorSampler, false);
+		GetMaterialVector(JsonPBRNode, "baseColorFactor", 4, RuntimeMaterial.bHasBaseColorFactor, RuntimeMaterial.BaseColorFactor);
+		GetMaterialTexture(JsonPBRNode, EglTFRuntimeTextureSlot::BaseColor, RuntimeMaterial.BaseColorTextureCache, RuntimeMaterial.BaseColorTextureMips, RuntimeMaterial.BaseColorTransform, RuntimeMaterial.BaseColorSampler);
 
-		if ((*JsonPBRObject)->TryGetNumberField("metallicFactor", RuntimeMaterial.MetallicFactor))
+		if (JsonTape.TryGetNumberField(JsonPBRNode, "metallicFactor", RuntimeMaterial.MetallicFactor))
 		{
 			RuntimeMaterial.bHasMetallicFactor = true;
 		}
 
-		if ((*JsonPBRObject)->TryGetNumberField("roughnessFactor", RuntimeMaterial.RoughnessFactor))
+		if (JsonTape.TryGetNumberField(JsonPBRNode, "roughnessFactor", RuntimeMaterial.RoughnessFactor))
 		{
 			RuntimeMaterial.bHasRoughnessFactor = true;
 		}
 
-		GetMaterialTexture(JsonPBRObject->ToSharedRef(), "metallicRoughnessTexture", false, RuntimeMaterial.MetallicRoughnessTextureCache, RuntimeMaterial.MetallicRoughnessTextureMips, RuntimeMaterial.MetallicRoughnessTransform, RuntimeMaterial.MetallicRoughnessSampler, false);
+		GetMaterialTexture(JsonPBRNode, EglTFRuntimeTextureSlot::MetallicRoughness, RuntimeMaterial.MetallicRoughnessTextureCache, RuntimeMaterial.MetallicRoughnessTextureMips, RuntimeMaterial.MetallicRoughnessTransform, RuntimeMaterial.MetallicRoughnessSampler);
 	}
 
-	if (const TSharedPtr<FJsonObject> JsonNormalTexture = GetMaterialTexture(JsonMaterialObject, "normalTexture", false, RuntimeMaterial.NormalTextureCache, RuntimeMaterial.NormalTextureMips, RuntimeMaterial.NormalTransform, RuntimeMaterial.NormalSampler, true))
+	const int32 JsonNormalTextureNode = GetMaterialTexture(JsonMaterialNode, EglTFRuntimeTextureSlot::Normal, RuntimeMaterial.NormalTextureCache, RuntimeMaterial.NormalTextureMips, RuntimeMaterial.NormalTransform, RuntimeMaterial.NormalSampler);
+	if (JsonNormalTextureNode != INDEX_NONE)
 	{
-		JsonNormalTexture->TryGetNumberField("scale", RuntimeMaterial.NormalTextureScale);
+		JsonTape.TryGetNumberField(JsonNormalTextureNode, "scale", RuntimeMaterial.NormalTextureScale);
 	}
 
-	GetMaterialTexture(JsonMaterialObject, "occlusionTexture", false, RuntimeMaterial.OcclusionTextureCache, RuntimeMaterial.OcclusionTextureMips, RuntimeMaterial.OcclusionTransform, RuntimeMaterial.OcclusionSampler, false);
+	GetMaterialTexture(JsonMaterialNode, EglTFRuntimeTextureSlot::Occlusion, RuntimeMaterial.OcclusionTextureCache, RuntimeMaterial.OcclusionTextureMips, RuntimeMaterial.OcclusionTransform, RuntimeMaterial.OcclusionSampler);
 
-	GetMaterialVector(JsonMaterialObject, "emissiveFactor", 3, RuntimeMaterial.bHasEmissiveFactor, RuntimeMaterial.EmissiveFactor);
+	GetMaterialVector(JsonMaterialNode, "emissiveFactor", 3, RuntimeMaterial.bHasEmissiveFactor, RuntimeMaterial.EmissiveFactor);
 
-	GetMaterialTexture(JsonMaterialObject, "emissiveTexture", true, RuntimeMaterial.EmissiveTextureCache, RuntimeMaterial.EmissiveTextureMips, RuntimeMaterial.EmissiveTransform, RuntimeMaterial.EmissiveSampler, false);
+	GetMaterialTexture(JsonMaterialNode, EglTFRuntimeTextureSlot::Emissive, RuntimeMaterial.EmissiveTextureCache, RuntimeMaterial.EmissiveTextureMips, RuntimeMaterial.EmissiveTransform, RuntimeMaterial.EmissiveSampler);
 
-	const TSharedPtr<FJsonObject>* JsonExtensions;
-	if (JsonMaterialObject->TryGetObjectField("extensions", JsonExtensions))
+	const int32 JsonExtensionsNode = JsonTape.GetObjectField(JsonMaterialNode, "extensions");
+	if (JsonExtensionsNode != INDEX_NONE)
 	{
 		// KHR_materials_pbrSpecularGlossiness
-		const TSharedPtr<FJsonObject>* JsonPbrSpecularGlossiness;
-		if ((*JsonExtensions)->TryGetObjectField("KHR_materials_pbrSpecularGlossiness", JsonPbrSpecularGlossiness))
+		const int32 JsonPbrSpecularGlossinessNode = JsonTape.GetObjectField(JsonExtensionsNode, "KHR_materials_pbrSpecularGlossiness");
+		if (JsonPbrSpecularGlossinessNode != INDEX_NONE)
 		{
-			GetMaterialVector(JsonPbrSpecularGlossiness->ToSharedRef(), "diffuseFactor", 4, RuntimeMaterial.bHasDiffuseFactor, RuntimeMaterial.DiffuseFactor);
-			GetMaterialTexture(JsonPbrSpecularGlossiness->ToSharedRef(), "diffuseTexture", true, RuntimeMaterial.DiffuseTextureCache, RuntimeMaterial.DiffuseTextureMips, RuntimeMaterial.DiffuseTransform, RuntimeMaterial.DiffuseSampler, false);
+			GetMaterialVector(JsonPbrSpecularGlossinessNode, "diffuseFactor", 4, RuntimeMaterial.bHasDiffuseFactor, RuntimeMaterial.DiffuseFactor);
+			GetMaterialTexture(JsonPbrSpecularGlossinessNode, EglTFRuntimeTextureSlot::Diffuse, RuntimeMaterial.DiffuseTextureCache, RuntimeMaterial.DiffuseTextureMips, RuntimeMaterial.DiffuseTransform, RuntimeMaterial.DiffuseSampler);
 
-			GetMaterialVector(JsonPbrSpecularGlossiness->ToSharedRef(), "specularFactor", 3, RuntimeMaterial.bHasSpecularFactor, RuntimeMaterial.SpecularFactor);
+			GetMaterialVector(JsonPbrSpecularGlossinessNode, "specularFactor", 3, RuntimeMaterial.bHasSpecularFactor, RuntimeMaterial.SpecularFactor);
 
-			if ((*JsonPbrSpecularGlossiness)->TryGetNumberField("glossinessFactor", RuntimeMaterial.GlossinessFactor))
+			if (JsonTape.TryGetNumberField(JsonPbrSpecularGlossinessNode, "glossinessFactor", RuntimeMaterial.GlossinessFactor))
 			{
 				RuntimeMaterial.bHasGlossinessFactor = true;
 			}
 
-			GetMaterialTexture(JsonPbrSpecularGlossiness->ToSharedRef(), "specularGlossinessTexture", true, RuntimeMaterial.SpecularGlossinessTextureCache, RuntimeMaterial.SpecularGlossinessTextureMips, RuntimeMaterial.SpecularGlossinessTransform, RuntimeMaterial.SpecularGlossinessSampler, false);
+			GetMaterialTexture(JsonPbrSpecularGlossinessNode, EglTFRuntimeTextureSlot::SpecularGlossiness, RuntimeMaterial.SpecularGlossinessTextureCache, RuntimeMaterial.SpecularGlossinessTextureMips, RuntimeMaterial.SpecularGlossinessTransform, RuntimeMaterial.SpecularGlossinessSampler);
 
 			RuntimeMaterial.bKHR_materials_pbrSpecularGlossiness = true;
 		}
 
 		// KHR_materials_transmission
-		const TSharedPtr<FJsonObject>* JsonMaterialTransmission;
-		if ((*JsonExtensions)->TryGetObjectField("KHR_materials_transmission", JsonMaterialTransmission))
+		const int32 JsonMaterialTransmissionNode = JsonTape.GetObjectField(JsonExtensionsNode, "KHR_materials_transmission");
+		if (JsonMaterialTransmissionNode != INDEX_NONE)
 		{
-			if ((*JsonMaterialTransmission)->TryGetNumberField("transmissionFactor", RuntimeMaterial.TransmissionFactor))
+			if (JsonTape.TryGetNumberField(JsonMaterialTransmissionNode, "transmissionFactor", RuntimeMaterial.TransmissionFactor))
 			{
 				RuntimeMaterial.bHasTransmissionFactor = true;
 			}
-			GetMaterialTexture(JsonMaterialTransmission->ToSharedRef(), "transmissionTexture", false, RuntimeMaterial.TransmissionTextureCache, RuntimeMaterial.TransmissionTextureMips, RuntimeMaterial.TransmissionTransform, RuntimeMaterial.TransmissionSampler, false);
+			GetMaterialTexture(JsonMaterialTransmissionNode, EglTFRuntimeTextureSlot::Transmission, RuntimeMaterial.TransmissionTextureCache, RuntimeMaterial.TransmissionTextureMips, RuntimeMaterial.TransmissionTransform, RuntimeMaterial.TransmissionSampler);
 
 			RuntimeMaterial.bKHR_materials_transmission = true;
 		}
 
 		// KHR_materials_unlit 
-		const TSharedPtr<FJsonObject>* JsonMaterialUnlit;
-		if ((*JsonExtensions)->TryGetObjectField("KHR_materials_unlit", JsonMaterialUnlit))
+		if (JsonTape.GetObjectField(JsonExtensionsNode, "KHR_materials_unlit") != INDEX_NONE)
 		{
 			RuntimeMaterial.bKHR_materials_unlit = true;
 		}
 
 		// KHR_materials_ior
-		const TSharedPtr<FJsonObject>* JsonMaterialIOR;
-		if ((*JsonExtensions)->TryGetObjectField("KHR_materials_ior", JsonMaterialIOR))
+		const int32 JsonMaterialIORNode = JsonTape.GetObjectField(JsonExtensionsNode, "KHR_materials_ior");
+		if (JsonMaterialIORNode != INDEX_NONE)
 		{
-			if (!(*JsonMaterialIOR)->TryGetNumberField("ior", RuntimeMaterial.IOR))
+			if (!JsonTape.TryGetNumberField(JsonMaterialIORNode, "ior", RuntimeMaterial.IOR))
 			{
 				RuntimeMaterial.IOR = 1.5;
 			}
@@ -253,27 +456,27 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial_Internal(const int32 Index,
 		}
 
 		// KHR_materials_specular
-		const TSharedPtr<FJsonObject>* JsonMaterialSpecular;
-		if ((*JsonExtensions)->TryGetObjectField("KHR_materials_specular", JsonMaterialSpecular))
+		const int32 JsonMaterialSpecularNode = JsonTape.GetObjectField(JsonExtensionsNode, "KHR_materials_specular");
+		if (JsonMaterialSpecularNode != INDEX_NONE)
 		{
-			if (!(*JsonMaterialSpecular)->TryGetNumberField("specularFactor", RuntimeMaterial.BaseSpecularFactor))
+			if (!JsonTape.TryGetNumberField(JsonMaterialSpecularNode, "specularFactor", RuntimeMaterial.BaseSpecularFactor))
 			{
 				RuntimeMaterial.BaseSpecularFactor = 1;
 			}
-			GetMaterialTexture(JsonMaterialSpecular->ToSharedRef(), "specularTexture", false, RuntimeMaterial.SpecularTextureCache, RuntimeMaterial.SpecularTextureMips, RuntimeMaterial.SpecularTransform, RuntimeMaterial.SpecularSampler, false);
+			GetMaterialTexture(JsonMaterialSpecularNode, EglTFRuntimeTextureSlot::Specular, RuntimeMaterial.SpecularTextureCache, RuntimeMaterial.SpecularTextureMips, RuntimeMaterial.SpecularTransform, RuntimeMaterial.SpecularSampler);
 			RuntimeMaterial.bKHR_materials_specular = true;
 		}
 
 		// KHR_materials_clearcoat
-		const TSharedPtr<FJsonObject>* JsonMaterialClearCoat;
-		if ((*JsonExtensions)->TryGetObjectField("KHR_materials_clearcoat", JsonMaterialClearCoat))
+		const int32 JsonMaterialClearCoatNode = JsonTape.GetObjectField(JsonExtensionsNode, "KHR_materials_clearcoat");
+		if (JsonMaterialClearCoatNode != INDEX_NONE)
 		{
-			if (!(*JsonMaterialClearCoat)->TryGetNumberField("clearcoatFactor", RuntimeMaterial.ClearCoatFactor))
+			if (!JsonTape.TryGetNumberField(JsonMaterialClearCoatNode, "clearcoatFactor", RuntimeMaterial.ClearCoatFactor))
 			{
 				RuntimeMaterial.ClearCoatFactor = 0;
 			}
 
-			if (!(*JsonMaterialClearCoat)->TryGetNumberField("clearcoatRoughnessFactor", RuntimeMaterial.ClearCoatRoughnessFactor))
+			if (!JsonTape.TryGetNumberField(JsonMaterialClearCoatNode, "clearcoatRoughnessFactor", RuntimeMaterial.ClearCoatRoughnessFactor))
 			{
 				RuntimeMaterial.ClearCoatRoughnessFactor = 0;
 			}
@@ -388,6 +591,7 @@ UTexture2D* FglTFRuntimeParser::BuildTexture(UObject* Outer, const TArray<FglTFR
 
 	Texture->UpdateResource();
 
+	FScopeLock Lock(&MaterialsCacheLock);
 	TexturesCache.Add(Mips[0].TextureIndex, Texture);
 
 	return Texture;
@@ -644,7 +848,10 @@ UMaterialInterface* FglTFRuntimeParser::BuildMaterial(const int32 Index, const F
 
 bool FglTFRuntimeParser::LoadImageFromBlob(const TArray64<uint8>& Blob, TSharedRef<FJsonObject> JsonImageObject, TArray64<uint8>& UncompressedBytes, int32& Width, int32& Height, EPixelFormat& PixelFormat, const FglTFRuntimeImagesConfig& ImagesConfig)
 {
-	OnTexturePixels.Broadcast(AsShared(), JsonImageObject, Blob, Width, Height, PixelFormat, UncompressedBytes, ImagesConfig);
+	if (OnTexturePixels.IsBound())
+	{
+		OnTexturePixels.Broadcast(AsShared(), JsonImageObject, Blob, Width, Height, PixelFormat, UncompressedBytes, ImagesConfig);
+	}
 
 	if (UncompressedBytes.Num() == 0)
 	{
@@ -783,33 +990,38 @@ UTexture2D* FglTFRuntimeParser::LoadTexture(const int32 TextureIndex, TArray<Fgl
 	}
 
 	// first check cache
-	if (TexturesCache.Contains(TextureIndex))
 	{
-		return TexturesCache[TextureIndex];
+		FScopeLock Lock(&MaterialsCacheLock);
+		if (TexturesCache.Contains(TextureIndex))
+		{
+			return TexturesCache[TextureIndex];
+		}
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonTextures;
-	// no images ?
-	if (!Root->TryGetArrayField("textures", JsonTextures))
+	TSharedPtr<FJsonObject> JsonTextureObject = GetJsonObjectFromRootIndex("textures", TextureIndex);
+	if (!JsonTextureObject)
 	{
 		return nullptr;
 	}
 
-	if (TextureIndex >= JsonTextures->Num())
+	const FglTFRuntimePrefetchedTextures* PrefetchedTextures = MaterialsConfig.PrefetchedTextures.Get();
+
+	int64 ImageIndex = INDEX_NONE;
+	// the prefetch already asked the delegates
+	if (PrefetchedTextures && PrefetchedTextures->TexturesImages.Contains(TextureIndex))
 	{
-		return nullptr;
+		ImageIndex = PrefetchedTextures->TexturesImages[TextureIndex];
 	}
-
-	TSharedPtr<FJsonObject> JsonTextureObject = (*JsonTextures)[TextureIndex]->AsObject();
-	if (!JsonTextureObject)
+	else
 	{
-		return nullptr;
+		OnTextureImageIndex.Broadcast(AsShared(), JsonTextureObject.ToSharedRef(), ImageIndex);
+		if (ImageIndex <= INDEX_NONE)
+		{
+			JsonTextureObject->TryGetNumberField("source", ImageIndex);
+		}
 	}
 
-	int64 ImageIndex = INDEX_NONE;
-	OnTextureImageIndex.Broadcast(AsShared(), JsonTextureObject.ToSharedRef(), ImageIndex);
-
-	if (ImageIndex <= INDEX_NONE && !JsonTextureObject->TryGetNumberField("source", ImageIndex))
+	if (ImageIndex <= INDEX_NONE)
 	{
 		return nullptr;
 	}
@@ -819,40 +1031,61 @@ UTexture2D* FglTFRuntimeParser::LoadTexture(const int32 TextureIndex, TArray<Fgl
 		return MaterialsConfig.ImagesOverrideMap[ImageIndex];
 	}
 
-	TSharedPtr<FJsonObject> JsonImageObject;
-	TArray64<uint8> CompressedBytes;
-	if (!LoadImageBytes(ImageIndex, JsonImageObject, CompressedBytes))
+	const TArray<FglTFRuntimeMipMap>* PrefetchedMips = nullptr;
+	if (PrefetchedTextures)
 	{
-		return nullptr;
+		const FSHAHash* ContentKey = PrefetchedTextures->TexturesContents.Find(TPair<int32, bool>(TextureIndex, sRGB));
+		if (ContentKey)
+		{
+			PrefetchedMips = PrefetchedTextures->ContentsMips.Find(*ContentKey);
+		}
 	}
 
-	if (!LoadBlobToMips(TextureIndex, JsonTextureObject.ToSharedRef(), JsonImageObject.ToSharedRef(), CompressedBytes, Mips, sRGB, MaterialsConfig))
+	if (PrefetchedMips)
 	{
-		return nullptr;
+		for (const FglTFRuntimeMipMap& MipMap : *PrefetchedMips)
+		{
+			Mips.Add(FglTFRuntimeMipMap(TextureIndex, MipMap.PixelFormat, MipMap.Width, MipMap.Height, MipMap.Pixels));
+		}
+	}
+	else
+	{
+		TSharedPtr<FJsonObject> JsonImageObject;
+		TArray64<uint8> CompressedBytes;
+		if (!LoadImageBytes(ImageIndex, JsonImageObject, CompressedBytes))
+		{
+			return nullptr;
+		}
+
+		if (!LoadBlobToMips(TextureIndex, JsonTextureObject.ToSharedRef(), JsonImageObject.ToSharedRef(), CompressedBytes, Mips, sRGB, MaterialsConfig))
+		{
+			return nullptr;
+		}
 	}
 
 	int64 SamplerIndex;
 	if (JsonTextureObject->TryGetNumberField("sampler", SamplerIndex))
 	{
-		const TArray<TSharedPtr<FJsonValue>>* JsonSamplers;
+		const int32 SamplersNum = GetJsonRootArrayNum("samplers");
 		// no samplers ?
-		if (!Root->TryGetArrayField("samplers", JsonSamplers))
+		if (SamplersNum < 0)
 		{
 			UE_LOG(LogGLTFRuntime, Warning, TEXT("No texture sampler defined!"));
 		}
 		else
 		{
-			if (SamplerIndex >= JsonSamplers->Num())
+			if (SamplerIndex >= SamplersNum)
 			{
 				UE_LOG(LogGLTFRuntime, Warning, TEXT("Invalid texture sampler index: %lld"), SamplerIndex);
 			}
 			else
 			{
-				TSharedPtr<FJsonObject> JsonSamplerObject = (*JsonSamplers)[SamplerIndex]->AsObject();
-				if (JsonSamplerObject)
+				const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+				const int32 JsonSamplerNode = JsonTape->GetRootArrayItem("samplers", SamplerIndex);
+				if (JsonTape->IsObject(JsonSamplerNode))
 				{
 					int64 MinFilter;
-					if (JsonSamplerObject->TryGetNumberField("minFilter", MinFilter))
+					if (JsonTape->TryGetNumberField(JsonSamplerNode, "minFilter", MinFilter))
 					{
 						if (MinFilter == 9728)
 						{
@@ -860,7 +1093,7 @@ UTexture2D* FglTFRuntimeParser::LoadTexture(const int32 TextureIndex, TArray<Fgl
 						}
 					}
 					int64 MagFilter;
-					if (JsonSamplerObject->TryGetNumberField("magFilter", MagFilter))
+					if (JsonTape->TryGetNumberField(JsonSamplerNode, "magFilter", MagFilter))
 					{
 						if (MagFilter == 9728)
 						{
@@ -868,7 +1101,7 @@ UTexture2D* FglTFRuntimeParser::LoadTexture(const int32 TextureIndex, TArray<Fgl
 						}
 					}
 					int64 WrapS;
-					if (JsonSamplerObject->TryGetNumberField("wrapS", WrapS))
+					if (JsonTape->TryGetNumberField(JsonSamplerNode, "wrapS", WrapS))
 					{
 						if (WrapS == 33071)
 						{
@@ -880,7 +1113,7 @@ UTexture2D* FglTFRuntimeParser::LoadTexture(const int32 TextureIndex, TArray<Fgl
 						}
 					}
 					int64 WrapT;
-					if (JsonSamplerObject->TryGetNumberField("wrapT", WrapT))
+					if (JsonTape->TryGetNumberField(JsonSamplerNode, "wrapT", WrapT))
 					{
 						if (WrapT == 33071)
 						{
@@ -899,11 +1132,265 @@ UTexture2D* FglTFRuntimeParser::LoadTexture(const int32 TextureIndex, TArray<Fgl
 	return nullptr;
 }
 
+void FglTFRuntimeParser::GetMeshMaterials(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonMeshNode, TArray<int32>& MaterialsIndices) const
+{
+	const int32 JsonPrimitivesNode = JsonTape.GetArrayField(JsonMeshNode, "primitives");
+	if (JsonPrimitivesNode == INDEX_NONE)
+	{
+		return;
+	}
+
+	for (int32 PrimitiveIndex = 0; PrimitiveIndex < JsonTape.GetArrayNum(JsonPrimitivesNode); PrimitiveIndex++)
+	{
+		int64 MaterialIndex;
+		if (JsonTape.TryGetNumberField(JsonTape.GetArrayItem(JsonPrimitivesNode, PrimitiveIndex), "material", MaterialIndex))
+		{
+			MaterialsIndices.AddUnique(MaterialIndex);
+		}
+	}
+}
+
+void FglTFRuntimeParser::PrefetchMeshesTextures(const TArray<int32>& MeshesIndices, FglTFRuntimeMaterialsConfig& MaterialsConfig)
+{
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	TArray<int32> MaterialsIndices;
+	for (const int32 MeshIndex : MeshesIndices)
+	{
+		const int32 JsonMeshNode = JsonTape->GetRootArrayItem("meshes", MeshIndex);
+		if (JsonTape->IsObject(JsonMeshNode))
+		{
+			GetMeshMaterials(*JsonTape, JsonMeshNode, MaterialsIndices);
+		}
+	}
+
+	MaterialsConfig.PrefetchedTextures = PrefetchMaterialsTextures(MaterialsIndices, MaterialsConfig);
+}
+
+TSharedRef<const FglTFRuntimePrefetchedTextures> FglTFRuntimeParser::PrefetchMaterialsTextures(const TArray<int32>& MaterialsIndices, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_PrefetchMaterialsTextures, FColor::Magenta);
+
+	TSharedRef<FglTFRuntimePrefetchedTextures> PrefetchedTextures = MakeShared<FglTFRuntimePrefetchedTextures>();
+
+	// plugins hooking the decoding pipeline get the textures one by one (from LoadTexture)
+	if (OnTextureMips.IsBound() || OnTexturePixels.IsBound() || OnLoadedTexturePixels.IsBound() || OnTextureFilterMips.IsBound())
+	{
+		return PrefetchedTextures;
+	}
+
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	TArray<TPair<int32, bool>> TexturesKeys;
+	for (const int32 MaterialIndex : MaterialsIndices)
+	{
+		if (MaterialIndex < 0)
+		{
+			continue;
+		}
+
+		if (!MaterialsConfig.bMaterialsOverrideMapInjectParams && MaterialsConfig.MaterialsOverrideMap.Contains(MaterialIndex))
+		{
+			continue;
+		}
+
+		if (CanReadFromCache(MaterialsConfig.CacheMode))
+		{
+			FScopeLock Lock(&MaterialsCacheLock);
+			if (MaterialsCache.Contains(MaterialIndex))
+			{
+				continue;
+			}
+		}
+
+		const int32 JsonMaterialNode = JsonTape->GetRootArrayItem("materials", MaterialIndex);
+		if (!JsonTape->IsObject(JsonMaterialNode))
+		{
+			continue;
+		}
+
+		FString MaterialName;
+		if (!MaterialsConfig.bMaterialsOverrideMapInjectParams && JsonTape->TryGetStringField(JsonMaterialNode, "name", MaterialName) && MaterialsConfig.MaterialsOverrideByNameMap.Contains(MaterialName))
+		{
+			continue;
+		}
+
+		for (const FglTFRuntimeTextureSlot& TextureSlot : TextureSlots)
+		{
+			int64 TextureIndex;
+			if (JsonTape->TryGetNumberField(JsonTape->GetObjectField(GetTextureSlotObject(*JsonTape, JsonMaterialNode, TextureSlot), TextureSlot.ParamName), "index", TextureIndex) && TextureIndex >= 0)
+			{
+				TexturesKeys.AddUnique(TPair<int32, bool>(static_cast<int32>(TextureIndex), TextureSlot.sRGB));
+			}
+		}
+	}
+
+	// load the compressed images, only the first texture slot with a given content is decoded
+	TArray<FglTFRuntimeTextureToPrefetch> TexturesToDecode;
+	TSet<FSHAHash> ContentsToDecode;
+	for (const TPair<int32, bool>& Key : TexturesKeys)
+	{
+		const int32 TextureIndex = Key.Key;
+		if (MaterialsConfig.TexturesOverrideMap.Contains(TextureIndex))
+		{
+			continue;
+		}
+
+		{
+			FScopeLock Lock(&MaterialsCacheLock);
+			if (TexturesCache.Contains(TextureIndex))
+			{
+				continue;
+			}
+		}
+
+		TSharedPtr<FJsonObject> JsonTextureObject = GetJsonObjectFromRootIndex("textures", TextureIndex);
+		if (!JsonTextureObject)
+		{
+			continue;
+		}
+
+		// the same texture can be used both as sRGB and linear
+		if (!PrefetchedTextures->TexturesImages.Contains(TextureIndex))
+		{
+			int64 ImageIndex = INDEX_NONE;
+			OnTextureImageIndex.Broadcast(AsShared(), JsonTextureObject.ToSharedRef(), ImageIndex);
+			if (ImageIndex <= INDEX_NONE)
+			{
+				JsonTextureObject->TryGetNumberField("source", ImageIndex);
+			}
+			PrefetchedTextures->TexturesImages.Add(TextureIndex, ImageIndex);
+		}
+
+		const int64 ImageIndex = PrefetchedTextures->TexturesImages[TextureIndex];
+		if (ImageIndex <= INDEX_NONE || MaterialsConfig.ImagesOverrideMap.Contains(ImageIndex))
+		{
+			continue;
+		}
+
+		// errors are reported by LoadTexture
+		TSharedPtr<FJsonObject> JsonImageObject = GetJsonObjectFromRootIndex("images", ImageIndex);
+		if (!JsonImageObject)
+		{
+			continue;
+		}
+
+		FglTFRuntimeTextureToPrefetch TextureToPrefetch;
+		if (!GetJsonObjectBytes(JsonImageObject.ToSharedRef(), TextureToPrefetch.Blob))
+		{
+			continue;
+		}
+
+		FglTFRuntimeDerivedDataKey ContentKey(TEXT("texture"));
+		ContentKey.UpdateBytes(TextureToPrefetch.Blob.GetData(), TextureToPrefetch.Blob.Num());
+		ContentKey.Update(Key.Value);
+		TextureToPrefetch.ContentKey = ContentKey.Finalize();
+		PrefetchedTextures->TexturesContents.Add(Key, TextureToPrefetch.ContentKey);
+
+		if (ContentsToDecode.Contains(TextureToPrefetch.ContentKey))
+		{
+			continue;
+		}
+
+		ContentsToDecode.Add(TextureToPrefetch.ContentKey);
+		TextureToPrefetch.TextureIndex = TextureIndex;
+		TextureToPrefetch.sRGB = Key.Value;
+		TextureToPrefetch.JsonTextureObject = JsonTextureObject;
+		TextureToPrefetch.JsonImageObject = JsonImageObject;
+		TextureToPrefetch.bLoaded = false;
+		TexturesToDecode.Add(MoveTemp(TextureToPrefetch));
+	}
+
+	if (TexturesToDecode.Num() == 0)
+	{
+		return PrefetchedTextures;
+	}
+
+	// ensure the module is loaded before spawning the tasks
+	FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+	ParallelFor(TexturesToDecode.Num(), [&](const int32 Index)
+		{
+			FglTFRuntimeTextureToPrefetch& TextureToPrefetch = TexturesToDecode[Index];
+			TextureToPrefetch.bLoaded = LoadBlobToMips(TextureToPrefetch.TextureIndex, TextureToPrefetch.JsonTextureObject.ToSharedRef(), TextureToPrefetch.JsonImageObject.ToSharedRef(), TextureToPrefetch.Blob, TextureToPrefetch.Mips, TextureToPrefetch.sRGB, MaterialsConfig);
+			TextureToPrefetch.Blob.Empty();
+		});
+
+	// failed textures are decoded again (and their errors reported) by LoadTexture
+	for (FglTFRuntimeTextureToPrefetch& TextureToPrefetch : TexturesToDecode)
+	{
+		if (TextureToPrefetch.bLoaded && TextureToPrefetch.Mips.Num() > 0)
+		{
+			PrefetchedTextures->ContentsMips.Add(TextureToPrefetch.ContentKey, MoveTemp(TextureToPrefetch.Mips));
+		}
+	}
+
+	return PrefetchedTextures;
+}
+
+void FglTFRuntimeParser::DownsampleMipMap(const FColor* Pixels, const int32 Width, const int32 Height, FColor* MipPixels, const bool sRGB, const bool bForceScalar)
+{
+	const int32 MipWidth = FMath::Max(Width / 2, 1);
+	const int32 MipHeight = FMath::Max(Height / 2, 1);
+
+	// one task per mip row (small mips run on the calling thread, they are not worth the tasks)
+	ParallelFor(MipHeight, [&](const int32 MipY)
+		{
+			const FColor* Row0 = Pixels + static_cast<int64>(FMath::Min(MipY * 2, Height - 1)) * Width;
+			const FColor* Row1 = Pixels + static_cast<int64>(FMath::Min(MipY * 2 + 1, Height - 1)) * Width;
+			FColor* MipRow = MipPixels + static_cast<int64>(MipY) * MipWidth;
+			if (sRGB)
+			{
+				DownsampleMipRowSRGB(Row0, Row1, Width, MipRow, MipWidth);
+			}
+			else
+			{
+				DownsampleMipRowLinear(Row0, Row1, Width, MipRow, MipWidth, bForceScalar);
+			}
+		}, static_cast<int64>(MipWidth) * MipHeight < 64 * 64);
+}
+
 bool FglTFRuntimeParser::LoadBlobToMips(const int32 TextureIndex, TSharedRef<FJsonObject> JsonTextureObject, TSharedRef<FJsonObject> JsonImageObject, const TArray64<uint8>& Blob, TArray<FglTFRuntimeMipMap>& Mips, const bool sRGB, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
 {
+	// plugins hooking the decoding pipeline always bypass the cache, block compressed mips (DDS) are cached as they are
+	FSHAHash DerivedDataKey;
+	const bool bUseDerivedDataCache = DerivedDataCache && !OnTextureMips.IsBound() && !OnTexturePixels.IsBound() && !OnLoadedTexturePixels.IsBound();
+	if (bUseDerivedDataCache)
+	{
+		FglTFRuntimeDerivedDataKey Key(TEXT("mips"));
+		Key.UpdateBytes(Blob.GetData(), Blob.Num());
+		Key.Update(sRGB);
+		Key.Update(MaterialsConfig.bLoadMipMaps);
+		Key.Update(MaterialsConfig.bGeneratesMipMaps);
+		Key.Update(MaterialsConfig.bGenerateMipMapsFromPreviousMip);
+		Key.Update(MaterialsConfig.ImagesConfig.MaxWidth);
+		Key.Update(MaterialsConfig.ImagesConfig.MaxHeight);
+		Key.Update(MaterialsConfig.ImagesConfig.bVerticalFlip);
+		Key.Update(MaterialsConfig.ImagesConfig.bForceHDR);
+		DerivedDataKey = Key.Finalize();
+
+		const uint8* PayloadData = nullptr;
+		int64 PayloadNum = 0;
+		TSharedPtr<FglTFRuntimeMappedFile> MappedFile = DerivedDataCache->Load(DerivedDataKey, PayloadData, PayloadNum);
+		if (MappedFile)
+		{
+			FglTFRuntimeDerivedDataReader Reader(PayloadData, PayloadNum);
+			if (ReadMips(Reader, TextureIndex, Mips))
+			{
+				if (OnTextureFilterMips.IsBound())
+				{
+					OnTextureFilterMips.Broadcast(AsShared(), Mips, MaterialsConfig.ImagesConfig);
+				}
+				return true;
+			}
+			Mips.Empty();
+		}
+	}
+
 	if (MaterialsConfig.bLoadMipMaps)
 	{
-		OnTextureMips.Broadcast(AsShared(), TextureIndex, JsonTextureObject, JsonImageObject, Blob, Mips, MaterialsConfig.ImagesConfig);
+		if (OnTextureMips.IsBound())
+		{
+			OnTextureMips.Broadcast(AsShared(), TextureIndex, JsonTextureObject, JsonImageObject, Blob, Mips, MaterialsConfig.ImagesConfig);
+		}
 		// if no Mips have been loaded, attempt parsing a DDS asset
 		if (Mips.Num() == 0)
 		{
@@ -927,7 +1414,10 @@ bool FglTFRuntimeParser::LoadBlobToMips(const int32 TextureIndex, TSharedRef<FJs
 			return false;
 		}
 
-		OnLoadedTexturePixels.Broadcast(AsShared(), JsonTextureObject, Width, Height, reinterpret_cast<FColor*>(UncompressedBytes.GetData()));
+		if (OnLoadedTexturePixels.IsBound())
+		{
+			OnLoadedTexturePixels.Broadcast(AsShared(), JsonTextureObject, Width, Height, reinterpret_cast<FColor*>(UncompressedBytes.GetData()));
+		}
 
 		if (Width > 0 && Height > 0 &&
 			(Width % GPixelFormats[PixelFormat].BlockSizeX) == 0 &&
@@ -954,64 +1444,76 @@ bool FglTFRuntimeParser::LoadBlobToMips(const int32 TextureIndex, TSharedRef<FJs
 
 			int32 NumOfMips = 1;
 
+			// the box filter works on 8 bit BGRA pixels only
+			const bool bMipsFromPreviousMip = MaterialsConfig.bGenerateMipMapsFromPreviousMip && PixelFormat == EPixelFormat::PF_B8G8R8A8;
+
 			TArray64<FColor> UncompressedColors;
 
 			if (MaterialsConfig.bGeneratesMipMaps && GPixelFormats[PixelFormat].BlockSizeX == 1 && GPixelFormats[PixelFormat].BlockSizeY == 1 && FMath::IsPowerOfTwo(Width) && FMath::IsPowerOfTwo(Height))
 			{
 				NumOfMips = FMath::FloorLog2(FMath::Max(Width, Height)) + 1;
 
-				for (int32 MipY = 0; MipY < Height; MipY++)
+				// BGRA bytes share the FColor memory layout
+				if (!bMipsFromPreviousMip)
 				{
-					for (int32 MipX = 0; MipX < Width; MipX++)
-					{
-						int64 MipColorIndex = ((MipY * Width) + MipX) * 4;
-						uint8 MipColorB = UncompressedBytes[MipColorIndex];
-						uint8 MipColorG = UncompressedBytes[MipColorIndex + 1];
-						uint8 MipColorR = UncompressedBytes[MipColorIndex + 2];
-						uint8 MipColorA = UncompressedBytes[MipColorIndex + 3];
-						UncompressedColors.Add(FColor(MipColorR, MipColorG, MipColorB, MipColorA));
-					}
+					UncompressedColors.AddUninitialized(static_cast<int64>(Width) * Height);
+					FMemory::Memcpy(UncompressedColors.GetData(), UncompressedBytes.GetData(), UncompressedColors.Num() * sizeof(FColor));
 				}
 			}
 
+			const int32 FirstMipIndex = Mips.Num();
+
 			int32 MipWidth = Width;
 			int32 MipHeight = Height;
 
 			for (int32 MipIndex = 0; MipIndex < NumOfMips; MipIndex++)
 			{
-				FglTFRuntimeMipMap MipMap(TextureIndex);
-				MipMap.Width = MipWidth;
-				MipMap.Height = MipHeight;
-				MipMap.PixelFormat = PixelFormat;
-
-				// Resize Image
-				if (MipIndex > 0)
-				{
-					TArray64<FColor> ResizedMipData;
-					ResizedMipData.AddUninitialized(MipWidth * MipHeight);
-					FImageUtils::ImageResize(Width, Height, UncompressedColors, MipWidth, MipHeight, ResizedMipData, sRGB);
-					for (FColor& Color : ResizedMipData)
-					{
-						MipMap.Pixels.Add(Color.B);
-						MipMap.Pixels.Add(Color.G);
-						MipMap.Pixels.Add(Color.R);
-						MipMap.Pixels.Add(Color.A);
-					}
-				}
-				else
-				{
-					MipMap.Pixels = UncompressedBytes;
-				}
-
-				Mips.Add(MipMap);
+				Mips.Add(FglTFRuntimeMipMap(TextureIndex, PixelFormat, MipWidth, MipHeight));
 
 				MipWidth = FMath::Max(MipWidth / 2, 1);
 				MipHeight = FMath::Max(MipHeight / 2, 1);
 			}
+
+			Mips[FirstMipIndex].Pixels = MoveTemp(UncompressedBytes);
+
+			if (bMipsFromPreviousMip)
+			{
+				// each mip is box filtered from the previous one, so the levels are generated in sequence (the rows of every level in parallel)
+				for (int32 MipIndex = FirstMipIndex + 1; MipIndex < FirstMipIndex + NumOfMips; MipIndex++)
+				{
+					const FglTFRuntimeMipMap& PreviousMipMap = Mips[MipIndex - 1];
+					FglTFRuntimeMipMap& MipMap = Mips[MipIndex];
+					MipMap.Pixels.AddUninitialized(static_cast<int64>(MipMap.Width) * MipMap.Height * sizeof(FColor));
+					DownsampleMipMap(reinterpret_cast<const FColor*>(PreviousMipMap.Pixels.GetData()), PreviousMipMap.Width, PreviousMipMap.Height, reinterpret_cast<FColor*>(MipMap.Pixels.GetData()), sRGB);
+				}
+			}
+			else
+			{
+				// each mip is resized from the full image, so they can be generated in parallel
+				ParallelFor(NumOfMips - 1, [&](const int32 Index)
+					{
+						FglTFRuntimeMipMap& MipMap = Mips[FirstMipIndex + Index + 1];
+						TArray64<FColor> ResizedMipData;
+						ResizedMipData.AddUninitialized(MipMap.Width * MipMap.Height);
+						FImageUtils::ImageResize(Width, Height, UncompressedColors, MipMap.Width, MipMap.Height, ResizedMipData, sRGB);
+						MipMap.Pixels.AddUninitialized(ResizedMipData.Num() * sizeof(FColor));
+						FMemory::Memcpy(MipMap.Pixels.GetData(), ResizedMipData.GetData(), MipMap.Pixels.Num());
+					});
+			}
 		}
 	}
 
-	OnTextureFilterMips.Broadcast(AsShared(), Mips, MaterialsConfig.ImagesConfig);
+	if (bUseDerivedDataCache && Mips.Num() > 0)
+	{
+		FglTFRuntimeDerivedDataWriter Writer;
+		WriteMips(Writer, Mips);
+		DerivedDataCache->Save(DerivedDataKey, Writer.Bytes);
+	}
+
+	if (OnTextureFilterMips.IsBound())
+	{
+		OnTextureFilterMips.Broadcast(AsShared(), Mips, MaterialsConfig.ImagesConfig);
+	}
 
 	return true;
 }
@@ -1029,36 +1531,28 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial(const int32 Index, const Fg
 	}
 
 	// first check cache
-	if (CanReadFromCache(MaterialsConfig.CacheMode) && MaterialsCache.Contains(Index))
+	if (CanReadFromCache(MaterialsConfig.CacheMode))
 	{
-		if (MaterialsNameCache.Contains(MaterialsCache[Index]))
+		FScopeLock Lock(&MaterialsCacheLock);
+		if (MaterialsCache.Contains(Index))
 		{
-			MaterialName = MaterialsNameCache[MaterialsCache[Index]];
+			if (MaterialsNameCache.Contains(MaterialsCache[Index]))
+			{
+				MaterialName = MaterialsNameCache[MaterialsCache[Index]];
+			}
+			return MaterialsCache[Index];
 		}
-		return MaterialsCache[Index];
-	}
-
-	const TArray<TSharedPtr<FJsonValue>>* JsonMaterials;
-
-	// no materials ?
-	if (!Root->TryGetArrayField("materials", JsonMaterials))
-	{
-		return nullptr;
-	}
-
-	if (Index >= JsonMaterials->Num())
-	{
-		return nullptr;
 	}
 
-	TSharedPtr<FJsonObject> JsonMaterialObject = (*JsonMaterials)[Index]->AsObject();
-	if (!JsonMaterialObject)
+	const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+	const int32 JsonMaterialNode = JsonTape->GetRootArrayItem("materials", Index);
+	if (!JsonTape->IsObject(JsonMaterialNode))
 	{
 		return nullptr;
 	}
 
 
-	if (!JsonMaterialObject->TryGetStringField("name", MaterialName))
+	if (!JsonTape->TryGetStringField(JsonMaterialNode, "name", MaterialName))
 	{
 		MaterialName = "";
 	}
@@ -1068,7 +1562,7 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial(const int32 Index, const Fg
 		return MaterialsConfig.MaterialsOverrideByNameMap[MaterialName];
 	}
 
-	UMaterialInterface* Material = LoadMaterial_Internal(Index, MaterialName, JsonMaterialObject.ToSharedRef(), MaterialsConfig, bUseVertexColors);
+	UMaterialInterface* Material = LoadMaterial_Internal(Index, MaterialName, *JsonTape, JsonMaterialNode, MaterialsConfig, bUseVertexColors);
 	if (!Material)
 	{
 		AddError("LoadMaterial()", "Unable to load material");
@@ -1077,6 +1571,7 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial(const int32 Index, const Fg
 
 	if (CanWriteToCache(MaterialsConfig.CacheMode))
 	{
+		FScopeLock Lock(&MaterialsCacheLock);
 		MaterialsNameCache.Add(Material, MaterialName);
 		MaterialsCache.Add(Index, Material);
 	}
@@ -0,0 +1,1397 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+#include "Algo/StableSort.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#define GLTFRUNTIME_MESHOPT_NEON 1
+#include <arm_neon.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+#if defined(__SSSE3__) || defined(__AVX__)
+#define GLTFRUNTIME_MESHOPT_SSE 1
+#elif defined(PLATFORM_ALWAYS_HAS_SSE4_1)
+#if PLATFORM_ALWAYS_HAS_SSE4_1
+#define GLTFRUNTIME_MESHOPT_SSE 1
+#endif
+#endif
+#if defined(GLTFRUNTIME_MESHOPT_SSE)
+#include <tmmintrin.h>
+#endif
+#endif
+
+#ifndef GLTFRUNTIME_MESHOPT_NEON
+#define GLTFRUNTIME_MESHOPT_NEON 0
+#endif
+
+#ifndef GLTFRUNTIME_MESHOPT_SSE
+#define GLTFRUNTIME_MESHOPT_SSE 0
+#endif
+
+#define GLTFRUNTIME_MESHOPT_SIMD (GLTFRUNTIME_MESHOPT_NEON || GLTFRUNTIME_MESHOPT_SSE)
+
+// the filters need vector square roots and divisions, only available on AArch64 with NEON
+#if GLTFRUNTIME_MESHOPT_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+#define GLTFRUNTIME_MESHOPT_NEON_FILTERS 1
+#else
+#define GLTFRUNTIME_MESHOPT_NEON_FILTERS 0
+#endif
+
+#define GLTFRUNTIME_MESHOPT_SIMD_FILTERS (GLTFRUNTIME_MESHOPT_NEON_FILTERS || GLTFRUNTIME_MESHOPT_SSE)
+
+namespace
+{
+	constexpr int32 MeshOptByteGroupSize = 16;
+	// max number of bytes a single group can consume (8 bytes of 4 bits selectors + 16 escaped bytes)
+	constexpr int64 MeshOptByteGroupDecodeLimit = 24;
+	constexpr int64 MeshOptVertexBlockSizeBytes = 8192;
+	constexpr int64 MeshOptVertexBlockMaxSize = 256;
+	constexpr int64 MeshOptTailMinSize = 32;
+
+	FORCEINLINE uint8 UnZigZag8(const uint8 Value)
+	{
+		return static_cast<uint8>(-(Value & 1)) ^ (Value >> 1);
+	}
+
+	// scalar reference implementation, used when SIMD is not available and for strides not multiple of 4
+	const uint8* DecodeBytesGroupScalar(const uint8* Data, uint8* Destination, const int32 BitsLog2)
+	{
+		switch (BitsLog2)
+		{
+		case 0:
+			FMemory::Memzero(Destination, MeshOptByteGroupSize);
+			return Data;
+		case 1:
+		{
+			const uint8* Escaped = Data + 4;
+			for (int32 ByteIndex = 0; ByteIndex < 4; ByteIndex++)
+			{
+				const uint8 Selectors = Data[ByteIndex];
+				for (int32 Shift = 6; Shift >= 0; Shift -= 2)
+				{
+					const uint8 Value = (Selectors >> Shift) & 0x03;
+					*Destination++ = Value == 0x03 ? *Escaped++ : Value;
+				}
+			}
+			return Escaped;
+		}
+		case 2:
+		{
+			const uint8* Escaped = Data + 8;
+			for (int32 ByteIndex = 0; ByteIndex < 8; ByteIndex++)
+			{
+				const uint8 Selectors = Data[ByteIndex];
+				for (int32 Shift = 4; Shift >= 0; Shift -= 4)
+				{
+					const uint8 Value = (Selectors >> Shift) & 0x0F;
+					*Destination++ = Value == 0x0F ? *Escaped++ : Value;
+				}
+			}
+			return Escaped;
+		}
+		default:
+			FMemory::Memcpy(Destination, Data, MeshOptByteGroupSize);
+			return Data + MeshOptByteGroupSize;
+		}
+	}
+
+#if GLTFRUNTIME_MESHOPT_SIMD
+	// for each 8 bits mask of escaped values: the shuffle for gathering escaped bytes and the number of escaped bytes
+	struct FMeshOptByteGroupTables
+	{
+		uint8 Shuffle[256][8];
+		uint8 Count[256];
+
+		FMeshOptByteGroupTables()
+		{
+			for (int32 Mask = 0; Mask < 256; Mask++)
+			{
+				uint8 Escaped = 0;
+				for (int32 Bit = 0; Bit < 8; Bit++)
+				{
+					const bool bEscaped = ((Mask >> Bit) & 1) != 0;
+					Shuffle[Mask][Bit] = bEscaped ? Escaped : 0x80;
+					Escaped += bEscaped ? 1 : 0;
+				}
+				Count[Mask] = Escaped;
+			}
+		}
+	};
+
+	const FMeshOptByteGroupTables& GetMeshOptByteGroupTables()
+	{
+		static const FMeshOptByteGroupTables Tables;
+		return Tables;
+	}
+#endif
+
+#if GLTFRUNTIME_MESHOPT_SSE
+	FORCEINLINE __m128i DecodeShuffleMask(const FMeshOptByteGroupTables& Tables, const uint8 Mask0, const uint8 Mask1)
+	{
+		const __m128i Shuffle0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(Tables.Shuffle[Mask0]));
+		const __m128i Shuffle1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(Tables.Shuffle[Mask1]));
+		// the second half gathers the escaped bytes following the ones of the first half (0x80 entries stay >= 0x80)
+		const __m128i Shuffle1Offset = _mm_add_epi8(Shuffle1, _mm_set1_epi8(static_cast<char>(Tables.Count[Mask0])));
+		return _mm_unpacklo_epi64(Shuffle0, Shuffle1Offset);
+	}
+
+	FORCEINLINE const uint8* DecodeBytesGroupSelectors(const FMeshOptByteGroupTables& Tables, const uint8* Escaped, const __m128i Selectors, const __m128i EscapeValue, uint8* Destination)
+	{
+		const __m128i Rest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Escaped));
+		const __m128i Mask = _mm_cmpeq_epi8(Selectors, EscapeValue);
+		const int32 Mask16 = _mm_movemask_epi8(Mask);
+		const uint8 Mask0 = static_cast<uint8>(Mask16 & 0xFF);
+		const uint8 Mask1 = static_cast<uint8>(Mask16 >> 8);
+
+		const __m128i Result = _mm_or_si128(_mm_shuffle_epi8(Rest, DecodeShuffleMask(Tables, Mask0, Mask1)), _mm_andnot_si128(Mask, Selectors));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), Result);
+		return Escaped + Tables.Count[Mask0] + Tables.Count[Mask1];
+	}
+
+	const uint8* DecodeBytesGroupSIMD(const FMeshOptByteGroupTables& Tables, const uint8* Data, uint8* Destination, const int32 BitsLog2)
+	{
+		switch (BitsLog2)
+		{
+		case 0:
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), _mm_setzero_si128());
+			return Data;
+		case 1:
+		{
+			int32 Packed;
+			FMemory::Memcpy(&Packed, Data, sizeof(int32));
+			// expand the 2 bits selectors (highest bits first) to 16 bytes
+			const __m128i Selectors2 = _mm_cvtsi32_si128(Packed);
+			const __m128i Selectors22 = _mm_unpacklo_epi8(_mm_srli_epi16(Selectors2, 4), Selectors2);
+			const __m128i Selectors2222 = _mm_unpacklo_epi8(_mm_srli_epi16(Selectors22, 2), Selectors22);
+			const __m128i Selectors = _mm_and_si128(Selectors2222, _mm_set1_epi8(0x03));
+			return DecodeBytesGroupSelectors(Tables, Data + 4, Selectors, _mm_set1_epi8(0x03), Destination);
+		}
+		case 2:
+		{
+			// expand the 4 bits selectors (highest bits first) to 16 bytes
+			const __m128i Selectors4 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(Data));
+			const __m128i Selectors44 = _mm_unpacklo_epi8(_mm_srli_epi16(Selectors4, 4), Selectors4);
+			const __m128i Selectors = _mm_and_si128(Selectors44, _mm_set1_epi8(0x0F));
+			return DecodeBytesGroupSelectors(Tables, Data + 8, Selectors, _mm_set1_epi8(0x0F), Destination);
+		}
+		default:
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data)));
+			return Data + MeshOptByteGroupSize;
+		}
+	}
+
+	// unzigzag 4 channels of 16 elements, transpose them to 16 elements of 4 bytes and apply the deltas
+	FORCEINLINE void DecodeDeltas4(const uint8* Channels, const int64 ChannelSize, uint8* Destination, const int64 Stride, const int64 Elements, uint8* Baseline)
+	{
+		const __m128i One = _mm_set1_epi8(1);
+		const __m128i LowBits = _mm_set1_epi8(0x7F);
+		auto LoadChannel = [&](const int32 ChannelIndex)
+			{
+				const __m128i Value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Channels + ChannelIndex * ChannelSize));
+				return _mm_xor_si128(_mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(Value, One)), _mm_and_si128(_mm_srli_epi16(Value, 1), LowBits));
+			};
+
+		const __m128i Channel0 = LoadChannel(0);
+		const __m128i Channel1 = LoadChannel(1);
+		const __m128i Channel2 = LoadChannel(2);
+		const __m128i Channel3 = LoadChannel(3);
+
+		const __m128i Channel01Low = _mm_unpacklo_epi8(Channel0, Channel1);
+		const __m128i Channel01High = _mm_unpackhi_epi8(Channel0, Channel1);
+		const __m128i Channel23Low = _mm_unpacklo_epi8(Channel2, Channel3);
+		const __m128i Channel23High = _mm_unpackhi_epi8(Channel2, Channel3);
+
+		__m128i Quads[4];
+		Quads[0] = _mm_unpacklo_epi16(Channel01Low, Channel23Low);
+		Quads[1] = _mm_unpackhi_epi16(Channel01Low, Channel23Low);
+		Quads[2] = _mm_unpacklo_epi16(Channel01High, Channel23High);
+		Quads[3] = _mm_unpackhi_epi16(Channel01High, Channel23High);
+
+		int32 Packed;
+		FMemory::Memcpy(&Packed, Baseline, sizeof(int32));
+		__m128i Previous = _mm_set1_epi32(Packed);
+
+		for (int32 QuadIndex = 0; QuadIndex < 4; QuadIndex++)
+		{
+			// byte-wise prefix sum of the 4 elements
+			__m128i Quad = Quads[QuadIndex];
+			Quad = _mm_add_epi8(Quad, _mm_slli_si128(Quad, 4));
+			Quad = _mm_add_epi8(Quad, _mm_slli_si128(Quad, 8));
+			Quad = _mm_add_epi8(Quad, Previous);
+			Previous = _mm_shuffle_epi32(Quad, 0xFF);
+
+			alignas(16) uint8 Values[16];
+			_mm_store_si128(reinterpret_cast<__m128i*>(Values), Quad);
+			const int64 QuadElements = FMath::Min<int64>(Elements - QuadIndex * 4, 4);
+			for (int64 ElementIndex = 0; ElementIndex < QuadElements; ElementIndex++)
+			{
+				FMemory::Memcpy(Destination + (QuadIndex * 4 + ElementIndex) * Stride, Values + ElementIndex * 4, 4);
+			}
+		}
+
+		Packed = _mm_cvtsi128_si32(Previous);
+		FMemory::Memcpy(Baseline, &Packed, sizeof(int32));
+	}
+#endif
+
+#if GLTFRUNTIME_MESHOPT_NEON
+	FORCEINLINE void NeonMoveMask(const uint8x16_t Mask, uint8& Mask0, uint8& Mask1)
+	{
+		// gathers the top bit of each byte (the mask is made of 0x00 and 0xff bytes)
+		const uint64 Magic = 0x000103070f1f3f80ull;
+		const uint64x2_t Mask2 = vreinterpretq_u64_u8(Mask);
+		Mask0 = static_cast<uint8>((vgetq_lane_u64(Mask2, 0) * Magic) >> 56);
+		Mask1 = static_cast<uint8>((vgetq_lane_u64(Mask2, 1) * Magic) >> 56);
+	}
+
+	FORCEINLINE const uint8* DecodeBytesGroupSelectors(const FMeshOptByteGroupTables& Tables, const uint8* Escaped, const uint8x16_t Selectors, const uint8x16_t EscapeValue, uint8* Destination)
+	{
+		const uint8x16_t Mask = vceqq_u8(Selectors, EscapeValue);
+		uint8 Mask0;
+		uint8 Mask1;
+		NeonMoveMask(Mask, Mask0, Mask1);
+
+		const uint8x8_t Rest0 = vld1_u8(Escaped);
+		const uint8x8_t Rest1 = vld1_u8(Escaped + Tables.Count[Mask0]);
+		const uint8x16_t Gathered = vcombine_u8(vtbl1_u8(Rest0, vld1_u8(Tables.Shuffle[Mask0])), vtbl1_u8(Rest1, vld1_u8(Tables.Shuffle[Mask1])));
+
+		vst1q_u8(Destination, vbslq_u8(Mask, Gathered, Selectors));
+		return Escaped + Tables.Count[Mask0] + Tables.Count[Mask1];
+	}
+
+	const uint8* DecodeBytesGroupSIMD(const FMeshOptByteGroupTables& Tables, const uint8* Data, uint8* Destination, const int32 BitsLog2)
+	{
+		switch (BitsLog2)
+		{
+		case 0:
+			vst1q_u8(Destination, vdupq_n_u8(0));
+			return Data;
+		case 1:
+		{
+			// expand the 2 bits selectors (highest bits first) to 16 bytes
+			const uint8x8_t Selectors2 = vld1_u8(Data);
+			const uint8x8_t Selectors22 = vzip_u8(vshr_n_u8(Selectors2, 4), Selectors2).val[0];
+			const uint8x8x2_t Selectors2222 = vzip_u8(vshr_n_u8(Selectors22, 2), Selectors22);
+			const uint8x16_t Selectors = vandq_u8(vcombine_u8(Selectors2222.val[0], Selectors2222.val[1]), vdupq_n_u8(0x03));
+			return DecodeBytesGroupSelectors(Tables, Data + 4, Selectors, vdupq_n_u8(0x03), Destination);
+		}
+		case 2:
+		{
+			// expand the 4 bits selectors (highest bits first) to 16 bytes
+			const uint8x8_t Selectors4 = vld1_u8(Data);
+			const uint8x8x2_t Selectors44 = vzip_u8(vshr_n_u8(Selectors4, 4), Selectors4);
+			const uint8x16_t Selectors = vandq_u8(vcombine_u8(Selectors44.val[0], Selectors44.val[1]), vdupq_n_u8(0x0F));
+			return DecodeBytesGroupSelectors(Tables, Data + 8, Selectors, vdupq_n_u8(0x0F), Destination);
+		}
+		default:
+			vst1q_u8(Destination, vld1q_u8(Data));
+			return Data + MeshOptByteGroupSize;
+		}
+	}
+
+	// unzigzag 4 channels of 16 elements, transpose them to 16 elements of 4 bytes and apply the deltas
+	FORCEINLINE void DecodeDeltas4(const uint8* Channels, const int64 ChannelSize, uint8* Destination, const int64 Stride, const int64 Elements, uint8* Baseline)
+	{
+		auto LoadChannel = [&](const int32 ChannelIndex)
+			{
+				const uint8x16_t Value = vld1q_u8(Channels + ChannelIndex * ChannelSize);
+				return veorq_u8(vsubq_u8(vdupq_n_u8(0), vandq_u8(Value, vdupq_n_u8(1))), vshrq_n_u8(Value, 1));
+			};
+
+		const uint8x16x2_t Channel01 = vzipq_u8(LoadChannel(0), LoadChannel(1));
+		const uint8x16x2_t Channel23 = vzipq_u8(LoadChannel(2), LoadChannel(3));
+
+		const uint16x8x2_t Quads0123 = vzipq_u16(vreinterpretq_u16_u8(Channel01.val[0]), vreinterpretq_u16_u8(Channel23.val[0]));
+		const uint16x8x2_t Quads4567 = vzipq_u16(vreinterpretq_u16_u8(Channel01.val[1]), vreinterpretq_u16_u8(Channel23.val[1]));
+
+		uint8x16_t Quads[4];
+		Quads[0] = vreinterpretq_u8_u16(Quads0123.val[0]);
+		Quads[1] = vreinterpretq_u8_u16(Quads0123.val[1]);
+		Quads[2] = vreinterpretq_u8_u16(Quads4567.val[0]);
+		Quads[3] = vreinterpretq_u8_u16(Quads4567.val[1]);
+
+		uint32 Packed;
+		FMemory::Memcpy(&Packed, Baseline, sizeof(uint32));
+		uint8x16_t Previous = vreinterpretq_u8_u32(vdupq_n_u32(Packed));
+		const uint8x16_t Zero = vdupq_n_u8(0);
+
+		for (int32 QuadIndex = 0; QuadIndex < 4; QuadIndex++)
+		{
+			// byte-wise prefix sum of the 4 elements
+			uint8x16_t Quad = Quads[QuadIndex];
+			Quad = vaddq_u8(Quad, vextq_u8(Zero, Quad, 12));
+			Quad = vaddq_u8(Quad, vextq_u8(Zero, Quad, 8));
+			Quad = vaddq_u8(Quad, Previous);
+			Previous = vreinterpretq_u8_u32(vdupq_n_u32(vgetq_lane_u32(vreinterpretq_u32_u8(Quad), 3)));
+
+			uint8 Values[16];
+			vst1q_u8(Values, Quad);
+			const int64 QuadElements = FMath::Min<int64>(Elements - QuadIndex * 4, 4);
+			for (int64 ElementIndex = 0; ElementIndex < QuadElements; ElementIndex++)
+			{
+				FMemory::Memcpy(Destination + (QuadIndex * 4 + ElementIndex) * Stride, Values + ElementIndex * 4, 4);
+			}
+		}
+
+		Packed = vgetq_lane_u32(vreinterpretq_u32_u8(Previous), 0);
+		FMemory::Memcpy(Baseline, &Packed, sizeof(uint32));
+	}
+#endif
+
+	// decodes a byte channel of a vertex block (Num is a multiple of the group size), returns nullptr on truncated data
+	template<bool bSIMD>
+	const uint8* DecodeBytes(const uint8* Data, const uint8* DataEnd, uint8* Destination, const int64 Num)
+	{
+		const uint8* Header = Data;
+		const int64 GroupCount = Num / MeshOptByteGroupSize;
+		const int64 HeaderSize = (GroupCount + 3) / 4;
+		if (DataEnd - Data < HeaderSize)
+		{
+			return nullptr;
+		}
+
+		Data += HeaderSize;
+
+#if GLTFRUNTIME_MESHOPT_SIMD
+		const FMeshOptByteGroupTables& Tables = GetMeshOptByteGroupTables();
+#endif
+
+		for (int64 GroupIndex = 0; GroupIndex < GroupCount; GroupIndex++)
+		{
+			// the tail of the stream guarantees that a whole group can be read without further checks
+			if (DataEnd - Data < MeshOptByteGroupDecodeLimit)
+			{
+				return nullptr;
+			}
+
+			const int32 BitsLog2 = (Header[GroupIndex / 4] >> ((GroupIndex % 4) * 2)) & 0x03;
+#if GLTFRUNTIME_MESHOPT_SIMD
+			if (bSIMD)
+			{
+				Data = DecodeBytesGroupSIMD(Tables, Data, Destination + GroupIndex * MeshOptByteGroupSize, BitsLog2);
+				continue;
+			}
+#endif
+			Data = DecodeBytesGroupScalar(Data, Destination + GroupIndex * MeshOptByteGroupSize, BitsLog2);
+		}
+
+		return Data;
+	}
+
+	const uint8* DecodeVertexBlockScalar(const uint8* Data, const uint8* DataEnd, uint8* Destination, const int64 Elements, const int64 Stride, uint8* Baseline)
+	{
+		uint8 Deltas[MeshOptVertexBlockMaxSize];
+		const int64 AlignedElements = Align(Elements, MeshOptByteGroupSize);
+
+		for (int64 ElementByteIndex = 0; ElementByteIndex < Stride; ElementByteIndex++)
+		{
+			Data = DecodeBytes<false>(Data, DataEnd, Deltas, AlignedElements);
+			if (!Data)
+			{
+				return nullptr;
+			}
+
+			uint8 Value = Baseline[ElementByteIndex];
+			uint8* Output = Destination + ElementByteIndex;
+			for (int64 ElementIndex = 0; ElementIndex < Elements; ElementIndex++)
+			{
+				Value += UnZigZag8(Deltas[ElementIndex]);
+				*Output = Value;
+				Output += Stride;
+			}
+			Baseline[ElementByteIndex] = Value;
+		}
+
+		return Data;
+	}
+
+#if GLTFRUNTIME_MESHOPT_SIMD
+	// requires Stride to be a multiple of 4 (as mandated by EXT_meshopt_compression for attributes)
+	const uint8* DecodeVertexBlockSIMD(const uint8* Data, const uint8* DataEnd, uint8* Destination, const int64 Elements, const int64 Stride, uint8* Baseline)
+	{
+		uint8 Deltas[MeshOptVertexBlockMaxSize * 4];
+		const int64 AlignedElements = Align(Elements, MeshOptByteGroupSize);
+
+		for (int64 ElementByteIndex = 0; ElementByteIndex < Stride; ElementByteIndex += 4)
+		{
+			for (int32 ChannelIndex = 0; ChannelIndex < 4; ChannelIndex++)
+			{
+				Data = DecodeBytes<true>(Data, DataEnd, Deltas + ChannelIndex * AlignedElements, AlignedElements);
+				if (!Data)
+				{
+					return nullptr;
+				}
+			}
+
+			for (int64 ElementIndex = 0; ElementIndex < Elements; ElementIndex += MeshOptByteGroupSize)
+			{
+				DecodeDeltas4(Deltas + ElementIndex, AlignedElements, Destination + ElementIndex * Stride + ElementByteIndex, Stride, Elements - ElementIndex, Baseline + ElementByteIndex);
+			}
+
+			// the padding elements of the last group must not leak into the baseline
+			FMemory::Memcpy(Baseline + ElementByteIndex, Destination + (Elements - 1) * Stride + ElementByteIndex, 4);
+		}
+
+		return Data;
+	}
+#endif
+
+	struct FMeshOptIndexFifos
+	{
+		uint32 Edges[16][2];
+		uint32 Vertices[16];
+		int32 EdgesOffset = 0;
+		int32 VerticesOffset = 0;
+		int32 EdgesNum = 0;
+		int32 VerticesNum = 0;
+
+		// Index 0 is the most recently pushed entry
+		FORCEINLINE bool GetEdge(const int32 Index, uint32& A, uint32& B) const
+		{
+			if (Index >= EdgesNum)
+			{
+				return false;
+			}
+			const uint32* Edge = Edges[(EdgesOffset - 1 - Index) & 15];
+			A = Edge[0];
+			B = Edge[1];
+			return true;
+		}
+
+		FORCEINLINE bool GetVertex(const int32 Index, uint32& Vertex) const
+		{
+			if (Index >= VerticesNum)
+			{
+				return false;
+			}
+			Vertex = Vertices[(VerticesOffset - 1 - Index) & 15];
+			return true;
+		}
+
+		FORCEINLINE void PushEdge(const uint32 A, const uint32 B)
+		{
+			Edges[EdgesOffset][0] = A;
+			Edges[EdgesOffset][1] = B;
+			EdgesOffset = (EdgesOffset + 1) & 15;
+			EdgesNum = FMath::Min(EdgesNum + 1, 16);
+		}
+
+		FORCEINLINE void PushVertex(const uint32 Vertex)
+		{
+			Vertices[VerticesOffset] = Vertex;
+			VerticesOffset = (VerticesOffset + 1) & 15;
+			VerticesNum = FMath::Min(VerticesNum + 1, 16);
+		}
+	};
+
+	// the caller guarantees at least 5 readable bytes (the codeaux table follows the data)
+	FORCEINLINE uint32 DecodeIndex(const uint8*& Data, const uint32 Last)
+	{
+		uint32 Value = 0;
+		for (int32 Shift = 0; Shift < 35; Shift += 7)
+		{
+			const uint8 Byte = *Data++;
+			Value |= static_cast<uint32>(Byte & 0x7F) << Shift;
+			if (Byte < 0x80)
+			{
+				break;
+			}
+		}
+
+		return Last + (((Value & 1) != 0) ? ~(Value >> 1) : (Value >> 1));
+	}
+
+	// scalar reference filters, also used for the elements left over by the SIMD ones
+	template<typename T>
+	void DecodeOctahedralFilterScalar(T* Data, const int64 Elements)
+	{
+		const float Max = static_cast<float>((1 << (sizeof(T) * 8 - 1)) - 1);
+		for (int64 ElementIndex = 0; ElementIndex < Elements; ElementIndex++)
+		{
+			T* Element = Data + ElementIndex * 4;
+			// the third component encodes 1.0 at the same bit count
+			float X = Element[0];
+			float Y = Element[1];
+			const float Z = Element[2] - FMath::Abs(X) - FMath::Abs(Y);
+
+			const float Fixup = FMath::Min(Z, 0.0f);
+			X += X >= 0 ? Fixup : -Fixup;
+			Y += Y >= 0 ? Fixup : -Fixup;
+
+			const float Scale = Max / FMath::Sqrt(X * X + Y * Y + Z * Z);
+			X *= Scale;
+			Y *= Scale;
+			const float ScaledZ = Z * Scale;
+
+			Element[0] = static_cast<T>(static_cast<int32>(X + (X >= 0 ? 0.5f : -0.5f)));
+			Element[1] = static_cast<T>(static_cast<int32>(Y + (Y >= 0 ? 0.5f : -0.5f)));
+			Element[2] = static_cast<T>(static_cast<int32>(ScaledZ + (ScaledZ >= 0 ? 0.5f : -0.5f)));
+		}
+	}
+
+	void DecodeQuaternionFilterScalar(int16* Data, const int64 Elements)
+	{
+		const float Range = 1.0f / FMath::Sqrt(2.0f);
+		for (int64 ElementIndex = 0; ElementIndex < Elements; ElementIndex++)
+		{
+			int16* Element = Data + ElementIndex * 4;
+			// the scale is stored in the high bits of the last component
+			const float Scale = Range / static_cast<float>(Element[3] | 3);
+
+			const float X = Element[0] * Scale;
+			const float Y = Element[1] * Scale;
+			const float Z = Element[2] * Scale;
+			const float W = FMath::Sqrt(FMath::Max(1.0f - X * X - Y * Y - Z * Z, 0.0f));
+
+			const int32 MaxComponent = Element[3] & 3;
+			Element[(MaxComponent + 1) & 3] = static_cast<int16>(static_cast<int32>(X * 32767.0f + (X >= 0 ? 0.5f : -0.5f)));
+			Element[(MaxComponent + 2) & 3] = static_cast<int16>(static_cast<int32>(Y * 32767.0f + (Y >= 0 ? 0.5f : -0.5f)));
+			Element[(MaxComponent + 3) & 3] = static_cast<int16>(static_cast<int32>(Z * 32767.0f + (Z >= 0 ? 0.5f : -0.5f)));
+			Element[MaxComponent] = static_cast<int16>(static_cast<int32>(W * 32767.0f + 0.5f));
+		}
+	}
+
+	void DecodeExponentialFilterScalar(uint32* Data, const int64 Num)
+	{
+		for (int64 Index = 0; Index < Num; Index++)
+		{
+			// 8 bits signed exponent and 24 bits signed mantissa, the result is a float
+			const int32 Exponent = static_cast<int32>(Data[Index]) >> 24;
+			const int32 Mantissa = static_cast<int32>(Data[Index] << 8) >> 8;
+
+			const uint32 ScaleBits = static_cast<uint32>(Exponent + 127) << 23;
+			float Scale;
+			FMemory::Memcpy(&Scale, &ScaleBits, sizeof(float));
+
+			const float Value = Scale * static_cast<float>(Mantissa);
+			FMemory::Memcpy(&Data[Index], &Value, sizeof(float));
+		}
+	}
+
+#if GLTFRUNTIME_MESHOPT_SSE
+	// Value >= 0 ? Positive : -Positive, as the scalar filters
+	FORCEINLINE __m128 SelectBySign(const __m128 Value, const __m128 Positive)
+	{
+		const __m128 Mask = _mm_cmpge_ps(Value, _mm_setzero_ps());
+		return _mm_or_ps(_mm_and_ps(Mask, Positive), _mm_andnot_ps(Mask, _mm_xor_ps(Positive, _mm_set1_ps(-0.0f))));
+	}
+
+	// rounds half away from zero
+	FORCEINLINE __m128i RoundToInt(const __m128 Value)
+	{
+		return _mm_cvttps_epi32(_mm_add_ps(Value, SelectBySign(Value, _mm_set1_ps(0.5f))));
+	}
+
+	// sign extends the 8 or 16 bits component at the given bit offset of each 32 bits lane
+	template<int32 Bits, int32 Offset>
+	FORCEINLINE __m128i ExtractComponent(const __m128i Packed)
+	{
+		return _mm_srai_epi32(_mm_slli_epi32(Packed, 32 - Bits - Offset), 32 - Bits);
+	}
+
+	// 4 elements at once, in the same order of operations of the scalar filter
+	FORCEINLINE void DecodeOctahedral4(const __m128i InX, const __m128i InY, const __m128i InZ, const float Max, __m128i& OutX, __m128i& OutY, __m128i& OutZ)
+	{
+		const __m128 SignMask = _mm_set1_ps(-0.0f);
+		__m128 X = _mm_cvtepi32_ps(InX);
+		__m128 Y = _mm_cvtepi32_ps(InY);
+		const __m128 Z = _mm_sub_ps(_mm_sub_ps(_mm_cvtepi32_ps(InZ), _mm_andnot_ps(SignMask, X)), _mm_andnot_ps(SignMask, Y));
+
+		const __m128 Fixup = _mm_min_ps(Z, _mm_setzero_ps());
+		X = _mm_add_ps(X, SelectBySign(X, Fixup));
+		Y = _mm_add_ps(Y, SelectBySign(Y, Fixup));
+
+		const __m128 Scale = _mm_div_ps(_mm_set1_ps(Max), _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(X, X), _mm_mul_ps(Y, Y)), _mm_mul_ps(Z, Z))));
+		OutX = RoundToInt(_mm_mul_ps(X, Scale));
+		OutY = RoundToInt(_mm_mul_ps(Y, Scale));
+		OutZ = RoundToInt(_mm_mul_ps(Z, Scale));
+	}
+
+	// processes the elements in groups of 4, returns the number of processed elements
+	int64 DecodeOctahedralFilterSIMD(int8* Data, const int64 Elements)
+	{
+		const __m128i ByteMask = _mm_set1_epi32(0xFF);
+		const __m128i WMask = _mm_set1_epi32(static_cast<int32>(0xFF000000));
+		int64 ElementIndex = 0;
+		for (; ElementIndex + 4 <= Elements; ElementIndex += 4)
+		{
+			__m128i* Elements4 = reinterpret_cast<__m128i*>(Data + ElementIndex * 4);
+			const __m128i Packed = _mm_loadu_si128(Elements4);
+
+			__m128i X, Y, Z;
+			DecodeOctahedral4(ExtractComponent<8, 0>(Packed), ExtractComponent<8, 8>(Packed), ExtractComponent<8, 16>(Packed), 127.0f, X, Y, Z);
+
+			const __m128i XY = _mm_or_si128(_mm_and_si128(X, ByteMask), _mm_slli_epi32(_mm_and_si128(Y, ByteMask), 8));
+			const __m128i ZW = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(Z, ByteMask), 16), _mm_and_si128(Packed, WMask));
+			_mm_storeu_si128(Elements4, _mm_or_si128(XY, ZW));
+		}
+		return ElementIndex;
+	}
+
+	// gathers the XY and the ZW halves of 4 elements of 16 bits components
+	FORCEINLINE void LoadElements16(const int16* Data, __m128i& XY, __m128i& ZW)
+	{
+		const __m128 Packed0 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Data)));
+		const __m128 Packed1 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + 8)));
+		XY = _mm_castps_si128(_mm_shuffle_ps(Packed0, Packed1, _MM_SHUFFLE(2, 0, 2, 0)));
+		ZW = _mm_castps_si128(_mm_shuffle_ps(Packed0, Packed1, _MM_SHUFFLE(3, 1, 3, 1)));
+	}
+
+	FORCEINLINE void StoreElements16(int16* Data, const __m128i Low, const __m128i High)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Data), _mm_unpacklo_epi32(Low, High));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Data + 8), _mm_unpackhi_epi32(Low, High));
+	}
+
+	int64 DecodeOctahedralFilterSIMD(int16* Data, const int64 Elements)
+	{
+		const __m128i LowMask = _mm_set1_epi32(0xFFFF);
+		const __m128i HighMask = _mm_set1_epi32(static_cast<int32>(0xFFFF0000));
+		int64 ElementIndex = 0;
+		for (; ElementIndex + 4 <= Elements; ElementIndex += 4)
+		{
+			int16* Elements4 = Data + ElementIndex * 4;
+			__m128i PackedXY, PackedZW;
+			LoadElements16(Elements4, PackedXY, PackedZW);
+
+			__m128i X, Y, Z;
+			DecodeOctahedral4(ExtractComponent<16, 0>(PackedXY), ExtractComponent<16, 16>(PackedXY), ExtractComponent<16, 0>(PackedZW), 32767.0f, X, Y, Z);
+
+			StoreElements16(Elements4, _mm_or_si128(_mm_and_si128(X, LowMask), _mm_slli_epi32(Y, 16)), _mm_or_si128(_mm_and_si128(Z, LowMask), _mm_and_si128(PackedZW, HighMask)));
+		}
+		return ElementIndex;
+	}
+
+	int64 DecodeQuaternionFilterSIMD(int16* Data, const int64 Elements)
+	{
+		const __m128i LowMask = _mm_set1_epi32(0xFFFF);
+		const __m128 Range = _mm_set1_ps(1.0f / FMath::Sqrt(2.0f));
+		const __m128 One = _mm_set1_ps(1.0f);
+		const __m128 Max = _mm_set1_ps(32767.0f);
+		int64 ElementIndex = 0;
+		for (; ElementIndex + 4 <= Elements; ElementIndex += 4)
+		{
+			int16* Elements4 = Data + ElementIndex * 4;
+			__m128i PackedXY, PackedZW;
+			LoadElements16(Elements4, PackedXY, PackedZW);
+
+			const __m128i ScaleBits = ExtractComponent<16, 16>(PackedZW);
+			const __m128 Scale = _mm_div_ps(Range, _mm_cvtepi32_ps(_mm_or_si128(ScaleBits, _mm_set1_epi32(3))));
+
+			const __m128 X = _mm_mul_ps(_mm_cvtepi32_ps(ExtractComponent<16, 0>(PackedXY)), Scale);
+			const __m128 Y = _mm_mul_ps(_mm_cvtepi32_ps(ExtractComponent<16, 16>(PackedXY)), Scale);
+			const __m128 Z = _mm_mul_ps(_mm_cvtepi32_ps(ExtractComponent<16, 0>(PackedZW)), Scale);
+			const __m128 W = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_sub_ps(_mm_sub_ps(One, _mm_mul_ps(X, X)), _mm_mul_ps(Y, Y)), _mm_mul_ps(Z, Z)), _mm_setzero_ps()));
+
+			const __m128i WX = _mm_or_si128(_mm_and_si128(_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(W, Max), _mm_set1_ps(0.5f))), LowMask), _mm_slli_epi32(RoundToInt(_mm_mul_ps(X, Max)), 16));
+			const __m128i YZ = _mm_or_si128(_mm_and_si128(RoundToInt(_mm_mul_ps(Y, Max)), LowMask), _mm_slli_epi32(RoundToInt(_mm_mul_ps(Z, Max)), 16));
+
+			// WXYZ, rotated per element so that W ends at the index of the max component
+			alignas(16) uint64 Rotated[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(Rotated), _mm_unpacklo_epi32(WX, YZ));
+			_mm_store_si128(reinterpret_cast<__m128i*>(Rotated + 2), _mm_unpackhi_epi32(WX, YZ));
+			for (int32 Index = 0; Index < 4; Index++)
+			{
+				const int32 Shift = (Elements4[Index * 4 + 3] & 3) * 16;
+				const uint64 Element = Shift ? (Rotated[Index] << Shift) | (Rotated[Index] >> (64 - Shift)) : Rotated[Index];
+				FMemory::Memcpy(Elements4 + Index * 4, &Element, sizeof(uint64));
+			}
+		}
+		return ElementIndex;
+	}
+
+	int64 DecodeExponentialFilterSIMD(uint32* Data, const int64 Num)
+	{
+		int64 Index = 0;
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			__m128i* Values4 = reinterpret_cast<__m128i*>(Data + Index);
+			const __m128i Packed = _mm_loadu_si128(Values4);
+			const __m128 Scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_srai_epi32(Packed, 24), _mm_set1_epi32(127)), 23));
+			const __m128 Mantissa = _mm_cvtepi32_ps(ExtractComponent<24, 0>(Packed));
+			_mm_storeu_si128(Values4, _mm_castps_si128(_mm_mul_ps(Scale, Mantissa)));
+		}
+		return Index;
+	}
+#endif
+
+#if GLTFRUNTIME_MESHOPT_NEON_FILTERS
+	// Value >= 0 ? Positive : -Positive, as the scalar filters
+	FORCEINLINE float32x4_t SelectBySign(const float32x4_t Value, const float32x4_t Positive)
+	{
+		return vbslq_f32(vcgeq_f32(Value, vdupq_n_f32(0.0f)), Positive, vnegq_f32(Positive));
+	}
+
+	// rounds half away from zero
+	FORCEINLINE int32x4_t RoundToInt(const float32x4_t Value)
+	{
+		return vcvtq_s32_f32(vaddq_f32(Value, SelectBySign(Value, vdupq_n_f32(0.5f))));
+	}
+
+	// sign extends the 8 or 16 bits component at the given bit offset of each 32 bits lane
+	template<int32 Bits, int32 Offset>
+	FORCEINLINE int32x4_t ExtractComponent(const int32x4_t Packed)
+	{
+		return vshrq_n_s32(vshlq_n_s32(Packed, 32 - Bits - Offset), 32 - Bits);
+	}
+
+	// 4 elements at once, in the same order of operations of the scalar filter
+	FORCEINLINE void DecodeOctahedral4(const int32x4_t InX, const int32x4_t InY, const int32x4_t InZ, const float Max, int32x4_t& OutX, int32x4_t& OutY, int32x4_t& OutZ)
+	{
+		float32x4_t X = vcvtq_f32_s32(InX);
+		float32x4_t Y = vcvtq_f32_s32(InY);
+		const float32x4_t Z = vsubq_f32(vsubq_f32(vcvtq_f32_s32(InZ), vabsq_f32(X)), vabsq_f32(Y));
+
+		const float32x4_t Fixup = vminq_f32(Z, vdupq_n_f32(0.0f));
+		X = vaddq_f32(X, SelectBySign(X, Fixup));
+		Y = vaddq_f32(Y, SelectBySign(Y, Fixup));
+
+		const float32x4_t Scale = vdivq_f32(vdupq_n_f32(Max), vsqrtq_f32(vaddq_f32(vaddq_f32(vmulq_f32(X, X), vmulq_f32(Y, Y)), vmulq_f32(Z, Z))));
+		OutX = RoundToInt(vmulq_f32(X, Scale));
+		OutY = RoundToInt(vmulq_f32(Y, Scale));
+		OutZ = RoundToInt(vmulq_f32(Z, Scale));
+	}
+
+	// processes the elements in groups of 4, returns the number of processed elements
+	int64 DecodeOctahedralFilterSIMD(int8* Data, const int64 Elements)
+	{
+		const int32x4_t ByteMask = vdupq_n_s32(0xFF);
+		const int32x4_t WMask = vdupq_n_s32(static_cast<int32>(0xFF000000));
+		int64 ElementIndex = 0;
+		for (; ElementIndex + 4 <= Elements; ElementIndex += 4)
+		{
+			int8* Elements4 = Data + ElementIndex * 4;
+			const int32x4_t Packed = vreinterpretq_s32_s8(vld1q_s8(Elements4));
+
+			int32x4_t X, Y, Z;
+			DecodeOctahedral4(ExtractComponent<8, 0>(Packed), ExtractComponent<8, 8>(Packed), ExtractComponent<8, 16>(Packed), 127.0f, X, Y, Z);
+
+			const int32x4_t XY = vorrq_s32(vandq_s32(X, ByteMask), vshlq_n_s32(vandq_s32(Y, ByteMask), 8));
+			const int32x4_t ZW = vorrq_s32(vshlq_n_s32(vandq_s32(Z, ByteMask), 16), vandq_s32(Packed, WMask));
+			vst1q_s8(Elements4, vreinterpretq_s8_s32(vorrq_s32(XY, ZW)));
+		}
+		return ElementIndex;
+	}
+
+	// gathers the XY and the ZW halves of 4 elements of 16 bits components
+	FORCEINLINE void LoadElements16(const int16* Data, int32x4_t& XY, int32x4_t& ZW)
+	{
+		const int32x4x2_t Halves = vuzpq_s32(vreinterpretq_s32_s16(vld1q_s16(Data)), vreinterpretq_s32_s16(vld1q_s16(Data + 8)));
+		XY = Halves.val[0];
+		ZW = Halves.val[1];
+	}
+
+	FORCEINLINE void StoreElements16(int16* Data, const int32x4_t Low, const int32x4_t High)
+	{
+		const int32x4x2_t Elements = vzipq_s32(Low, High);
+		vst1q_s16(Data, vreinterpretq_s16_s32(Elements.val[0]));
+		vst1q_s16(Data + 8, vreinterpretq_s16_s32(Elements.val[1]));
+	}
+
+	int64 DecodeOctahedralFilterSIMD(int16* Data, const int64 Elements)
+	{
+		const int32x4_t LowMask = vdupq_n_s32(0xFFFF);
+		const int32x4_t HighMask = vdupq_n_s32(static_cast<int32>(0xFFFF0000));
+		int64 ElementIndex = 0;
+		for (; ElementIndex + 4 <= Elements; ElementIndex += 4)
+		{
+			int16* Elements4 = Data + ElementIndex * 4;
+			int32x4_t PackedXY, PackedZW;
+			LoadElements16(Elements4, PackedXY, PackedZW);
+
+			int32x4_t X, Y, Z;
+			DecodeOctahedral4(ExtractComponent<16, 0>(PackedXY), ExtractComponent<16, 16>(PackedXY), ExtractComponent<16, 0>(PackedZW), 32767.0f, X, Y, Z);
+
+			StoreElements16(Elements4, vorrq_s32(vandq_s32(X, LowMask), vshlq_n_s32(Y, 16)), vorrq_s32(vandq_s32(Z, LowMask), vandq_s32(PackedZW, HighMask)));
+		}
+		return ElementIndex;
+	}
+
+	int64 DecodeQuaternionFilterSIMD(int16* Data, const int64 Elements)
+	{
+		const int32x4_t LowMask = vdupq_n_s32(0xFFFF);
+		const float32x4_t Range = vdupq_n_f32(1.0f / FMath::Sqrt(2.0f));
+		const float32x4_t One = vdupq_n_f32(1.0f);
+		const float32x4_t Max = vdupq_n_f32(32767.0f);
+		int64 ElementIndex = 0;
+		for (; ElementIndex + 4 <= Elements; ElementIndex += 4)
+		{
+			int16* Elements4 = Data + ElementIndex * 4;
+			int32x4_t PackedXY, PackedZW;
+			LoadElements16(Elements4, PackedXY, PackedZW);
+
+			const int32x4_t ScaleBits = ExtractComponent<16, 16>(PackedZW);
+			const float32x4_t Scale = vdivq_f32(Range, vcvtq_f32_s32(vorrq_s32(ScaleBits, vdupq_n_s32(3))));
+
+			const float32x4_t X = vmulq_f32(vcvtq_f32_s32(ExtractComponent<16, 0>(PackedXY)), Scale);
+			const float32x4_t Y = vmulq_f32(vcvtq_f32_s32(ExtractComponent<16, 16>(PackedXY)), Scale);
+			const float32x4_t Z = vmulq_f32(vcvtq_f32_s32(ExtractComponent<16, 0>(PackedZW)), Scale);
+			const float32x4_t W = vsqrtq_f32(vmaxq_f32(vsubq_f32(vsubq_f32(vsubq_f32(One, vmulq_f32(X, X)), vmulq_f32(Y, Y)), vmulq_f32(Z, Z)), vdupq_n_f32(0.0f)));
+
+			const int32x4_t WX = vorrq_s32(vandq_s32(vcvtq_s32_f32(vaddq_f32(vmulq_f32(W, Max), vdupq_n_f32(0.5f))), LowMask), vshlq_n_s32(RoundToInt(vmulq_f32(X, Max)), 16));
+			const int32x4_t YZ = vorrq_s32(vandq_s32(RoundToInt(vmulq_f32(Y, Max)), LowMask), vshlq_n_s32(RoundToInt(vmulq_f32(Z, Max)), 16));
+
+			// WXYZ, rotated per element so that W ends at the index of the max component
+			const int32x4x2_t Packed = vzipq_s32(WX, YZ);
+			uint64 Rotated[4];
+			vst1q_s32(reinterpret_cast<int32*>(Rotated), Packed.val[0]);
+			vst1q_s32(reinterpret_cast<int32*>(Rotated + 2), Packed.val[1]);
+			for (int32 Index = 0; Index < 4; Index++)
+			{
+				const int32 Shift = (Elements4[Index * 4 + 3] & 3) * 16;
+				const uint64 Element = Shift ? (Rotated[Index] << Shift) | (Rotated[Index] >> (64 - Shift)) : Rotated[Index];
+				FMemory::Memcpy(Elements4 + Index * 4, &Element, sizeof(uint64));
+			}
+		}
+		return ElementIndex;
+	}
+
+	int64 DecodeExponentialFilterSIMD(uint32* Data, const int64 Num)
+	{
+		int64 Index = 0;
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			const int32x4_t Packed = vreinterpretq_s32_u32(vld1q_u32(Data + Index));
+			const float32x4_t Scale = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vshrq_n_s32(Packed, 24), vdupq_n_s32(127)), 23));
+			const float32x4_t Mantissa = vcvtq_f32_s32(ExtractComponent<24, 0>(Packed));
+			vst1q_u32(Data + Index, vreinterpretq_u32_f32(vmulq_f32(Scale, Mantissa)));
+		}
+		return Index;
+	}
+#endif
+
+	template<typename T>
+	void DecodeOctahedralFilter(T* Data, const int64 Elements, const bool bSIMD)
+	{
+		int64 ElementIndex = 0;
+#if GLTFRUNTIME_MESHOPT_SIMD_FILTERS
+		if (bSIMD)
+		{
+			ElementIndex = DecodeOctahedralFilterSIMD(Data, Elements);
+		}
+#endif
+		DecodeOctahedralFilterScalar(Data + ElementIndex * 4, Elements - ElementIndex);
+	}
+
+	void DecodeQuaternionFilter(int16* Data, const int64 Elements, const bool bSIMD)
+	{
+		int64 ElementIndex = 0;
+#if GLTFRUNTIME_MESHOPT_SIMD_FILTERS
+		if (bSIMD)
+		{
+			ElementIndex = DecodeQuaternionFilterSIMD(Data, Elements);
+		}
+#endif
+		DecodeQuaternionFilterScalar(Data + ElementIndex * 4, Elements - ElementIndex);
+	}
+
+	void DecodeExponentialFilter(uint32* Data, const int64 Num, const bool bSIMD)
+	{
+		int64 Index = 0;
+#if GLTFRUNTIME_MESHOPT_SIMD_FILTERS
+		if (bSIMD)
+		{
+			Index = DecodeExponentialFilterSIMD(Data, Num);
+		}
+#endif
+		DecodeExponentialFilterScalar(Data + Index, Num - Index);
+	}
+}
+
+bool FglTFRuntimeParser::DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, const int64 Stride, const int64 Elements, const FString& Mode, const FString& Filter, TArray64<uint8>& UncompressedBytes, const bool bForceScalar)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_DecompressMeshOptimizer, FColor::Magenta);
+
+	if (Mode == "ATTRIBUTES" && Blob.Num > 32 && Blob.Data[0] == 0xa0 && Stride > 0 && Stride <= 256)
+	{
+		const int64 TailSize = FMath::Max<int64>(Stride, MeshOptTailMinSize);
+		if (Blob.Num < 1 + TailSize)
+		{
+			return false;
+		}
+
+		// the first element is stored at the end of the stream
+		uint8 BaseLine[256];
+		FMemory::Memcpy(BaseLine, Blob.Data + Blob.Num - Stride, Stride);
+
+		const int64 MaxBlockElements = FMath::Min<int64>((MeshOptVertexBlockSizeBytes / Stride) & ~(MeshOptByteGroupSize - 1), MeshOptVertexBlockMaxSize);
+
+		// preallocated
+		UncompressedBytes.AddUninitialized(Elements * Stride);
+
+		const uint8* Data = Blob.Data + 1;
+		const uint8* DataEnd = Blob.Data + Blob.Num;
+#if GLTFRUNTIME_MESHOPT_SIMD
+		const bool bSIMD = !bForceScalar && (Stride % 4) == 0;
+#endif
+
+		for (int64 ElementIndex = 0; ElementIndex < Elements; ElementIndex += MaxBlockElements)
+		{
+			const int64 BlockElements = FMath::Min<int64>(Elements - ElementIndex, MaxBlockElements);
+			uint8* Destination = UncompressedBytes.GetData() + ElementIndex * Stride;
+#if GLTFRUNTIME_MESHOPT_SIMD
+			if (bSIMD)
+			{
+				Data = DecodeVertexBlockSIMD(Data, DataEnd, Destination, BlockElements, Stride, BaseLine);
+			}
+			else
+#endif
+			{
+				Data = DecodeVertexBlockScalar(Data, DataEnd, Destination, BlockElements, Stride, BaseLine);
+			}
+
+			if (!Data)
+			{
+				return false;
+			}
+		}
+
+		if (DataEnd - Data != TailSize)
+		{
+			return false;
+		}
+	}
+	else if (Mode == "TRIANGLES" && Blob.Num >= 17 && Blob.Data[0] == 0xe1 && (Stride == 2 || Stride == 4) && ((Elements % 3) == 0))
+	{
+		const int64 TrianglesNum = Elements / 3;
+		const uint8* CodeAux = Blob.Data + Blob.Num - 16;
+		const uint8* Data = Blob.Data + 1 + TrianglesNum;
+		// every triangle consumes at most 16 bytes of data, so checking once per triangle is enough
+		const uint8* DataSafeEnd = CodeAux;
+
+		if (Data > DataSafeEnd)
+		{
+			return false;
+		}
+
+		FMeshOptIndexFifos Fifos;
+		uint32 Next = 0;
+		uint32 Last = 0;
+
+		UncompressedBytes.AddUninitialized(Elements * Stride);
+		uint16* Indices16 = reinterpret_cast<uint16*>(UncompressedBytes.GetData());
+		uint32* Indices32 = reinterpret_cast<uint32*>(UncompressedBytes.GetData());
+
+		for (int64 TriangleIndex = 0; TriangleIndex < TrianglesNum; TriangleIndex++)
+		{
+			if (Data > DataSafeEnd)
+			{
+				return false;
+			}
+
+			const uint8 Code = Blob.Data[1 + TriangleIndex];
+			const uint8 NibbleLeft = Code >> 4;
+			const uint8 NibbleRight = Code & 0x0f;
+
+			uint32 A = 0;
+			uint32 B = 0;
+			uint32 C = 0;
+
+			if (NibbleLeft < 0xf)
+			{
+				if (!Fifos.GetEdge(NibbleLeft, A, B))
+				{
+					return false;
+				}
+
+				if (NibbleRight == 0) // 0xX0
+				{
+					C = Next++;
+					Fifos.PushVertex(C);
+				}
+				else if (NibbleRight < 0x0d) // 0xXY
+				{
+					if (!Fifos.GetVertex(NibbleRight, C))
+					{
+						return false;
+					}
+				}
+				else // 0xXd 0xXe 0xXf
+				{
+					if (NibbleRight == 0x0d)
+					{
+						C = Last - 1;
+					}
+					else if (NibbleRight == 0x0e)
+					{
+						C = Last + 1;
+					}
+					else
+					{
+						C = DecodeIndex(Data, Last);
+					}
+					Last = C;
+					Fifos.PushVertex(C);
+				}
+
+				Fifos.PushEdge(C, B);
+				Fifos.PushEdge(A, C);
+			}
+			else
+			{
+				uint8 ZW = 0;
+				if (NibbleRight < 0xe) // 0xfY
+				{
+					ZW = CodeAux[NibbleRight];
+				}
+				else // 0xfe - 0xff
+				{
+					ZW = *Data++;
+					if (ZW == 0)
+					{
+						Next = 0;
+					}
+				}
+
+				const uint8 Z = ZW >> 4;
+				const uint8 W = ZW & 0x0f;
+				const bool bExplicit = NibbleRight >= 0xe;
+
+				if (NibbleRight == 0x0f)
+				{
+					A = DecodeIndex(Data, Last);
+					Last = A;
+				}
+				else
+				{
+					A = Next++;
+				}
+
+				if (Z == 0)
+				{
+					B = Next++;
+				}
+				else if (Z < 0xf || !bExplicit)
+				{
+					if (!Fifos.GetVertex(Z - 1, B))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					B = DecodeIndex(Data, Last);
+					Last = B;
+				}
+
+				if (W == 0)
+				{
+					C = Next++;
+				}
+				else if (W < 0xf || !bExplicit)
+				{
+					if (!Fifos.GetVertex(W - 1, C))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					C = DecodeIndex(Data, Last);
+					Last = C;
+				}
+
+				Fifos.PushEdge(B, A);
+				Fifos.PushEdge(C, B);
+				Fifos.PushEdge(A, C);
+				Fifos.PushVertex(A);
+				if (Z == 0 || (bExplicit && Z == 0xf))
+				{
+					Fifos.PushVertex(B);
+				}
+				if (W == 0 || (bExplicit && W == 0xf))
+				{
+					Fifos.PushVertex(C);
+				}
+			}
+
+			if (Stride == 2)
+			{
+				Indices16[TriangleIndex * 3] = static_cast<uint16>(A);
+				Indices16[TriangleIndex * 3 + 1] = static_cast<uint16>(B);
+				Indices16[TriangleIndex * 3 + 2] = static_cast<uint16>(C);
+			}
+			else
+			{
+				Indices32[TriangleIndex * 3] = A;
+				Indices32[TriangleIndex * 3 + 1] = B;
+				Indices32[TriangleIndex * 3 + 2] = C;
+			}
+		}
+
+		// a valid stream is consumed exactly up to the codeaux table
+		if (Data != DataSafeEnd)
+		{
+			return false;
+		}
+	}
+	else
+	{
+		return false;
+	}
+
+	if (UncompressedBytes.Num() > 0)
+	{
+		if (Filter == "OCTAHEDRAL" && (Stride == 4 || Stride == 8))
+		{
+			if (Stride == 4)
+			{
+				DecodeOctahedralFilter(reinterpret_cast<int8*>(UncompressedBytes.GetData()), Elements, !bForceScalar);
+			}
+			else
+			{
+				DecodeOctahedralFilter(reinterpret_cast<int16*>(UncompressedBytes.GetData()), Elements, !bForceScalar);
+			}
+		}
+		else if (Filter == "QUATERNION" && Stride == 8)
+		{
+			DecodeQuaternionFilter(reinterpret_cast<int16*>(UncompressedBytes.GetData()), Elements, !bForceScalar);
+		}
+		else if (Filter == "EXPONENTIAL" && (Stride % 4) == 0)
+		{
+			DecodeExponentialFilter(reinterpret_cast<uint32*>(UncompressedBytes.GetData()), UncompressedBytes.Num() / 4, !bForceScalar);
+		}
+		else if (Filter != "" && Filter != "NONE")
+		{
+			AddError("DecompressMeshOptimizer()", "Unsupported Filter");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+namespace
+{
+	// a conservative size for the post-transform cache of current GPUs
+	constexpr int32 MeshOptVertexCacheSize = 16;
+
+	struct FglTFRuntimeTrianglesCluster
+	{
+		int32 FirstTriangle;
+		int32 NumTriangles;
+		float SortKey;
+	};
+}
+
+void FglTFRuntimeParser::OptimizeTrianglesOrder(TArray<uint32>& Indices, const TArray<FVector>& Positions)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_OptimizeTrianglesOrder, FColor::Magenta);
+
+	const int32 NumVertices = Positions.Num();
+	const int32 NumTriangles = Indices.Num() / 3;
+	if (NumTriangles < 2 || (Indices.Num() % 3) != 0)
+	{
+		return;
+	}
+
+	// vertex -> triangles adjacency
+	TArray<int32> TrianglesOffsets;
+	TrianglesOffsets.AddZeroed(NumVertices + 1);
+	for (const uint32 Index : Indices)
+	{
+		if (Index >= static_cast<uint32>(NumVertices))
+		{
+			return;
+		}
+		TrianglesOffsets[Index + 1]++;
+	}
+
+	TArray<int32> LiveTriangles;
+	LiveTriangles.AddUninitialized(NumVertices);
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+	{
+		LiveTriangles[VertexIndex] = TrianglesOffsets[VertexIndex + 1];
+		TrianglesOffsets[VertexIndex + 1] += TrianglesOffsets[VertexIndex];
+	}
+
+	TArray<int32> AdjacentTriangles;
+	AdjacentTriangles.AddUninitialized(Indices.Num());
+	{
+		TArray<int32> TrianglesFill(TrianglesOffsets.GetData(), NumVertices);
+		for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++)
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				AdjacentTriangles[TrianglesFill[Indices[TriangleIndex * 3 + Corner]]++] = TriangleIndex;
+			}
+		}
+	}
+
+	// Tipsify (Sander et al. 2007): fan around the vertex that will most likely still be in the cache
+	TArray<int32> CacheTimeStamps;
+	CacheTimeStamps.AddZeroed(NumVertices);
+	TArray<bool> EmittedTriangles;
+	EmittedTriangles.AddZeroed(NumTriangles);
+	TArray<int32> DeadEndStack;
+	DeadEndStack.AddUninitialized(Indices.Num());
+	int32 DeadEndStackNum = 0;
+	TArray<int32> Candidates;
+
+	TArray<uint32> OptimizedIndices;
+	OptimizedIndices.Reserve(Indices.Num());
+	// triangles missing the cache for all of their vertices start a new cluster
+	TArray<FglTFRuntimeTrianglesCluster> Clusters;
+
+	int32 Time = MeshOptVertexCacheSize + 1;
+	int32 Cursor = 0;
+	int32 FanningVertex = 0;
+
+	while (FanningVertex != INDEX_NONE)
+	{
+		Candidates.Reset();
+
+		for (int32 AdjacencyIndex = TrianglesOffsets[FanningVertex]; AdjacencyIndex < TrianglesOffsets[FanningVertex + 1]; AdjacencyIndex++)
+		{
+			const int32 TriangleIndex = AdjacentTriangles[AdjacencyIndex];
+			if (EmittedTriangles[TriangleIndex])
+			{
+				continue;
+			}
+
+			int32 CacheMisses = 0;
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const uint32 VertexIndex = Indices[TriangleIndex * 3 + Corner];
+				OptimizedIndices.Add(VertexIndex);
+				DeadEndStack[DeadEndStackNum++] = VertexIndex;
+				Candidates.Add(VertexIndex);
+				LiveTriangles[VertexIndex]--;
+				if (Time - CacheTimeStamps[VertexIndex] > MeshOptVertexCacheSize)
+				{
+					CacheTimeStamps[VertexIndex] = Time++;
+					CacheMisses++;
+				}
+			}
+
+			if (CacheMisses == 3 || Clusters.Num() == 0)
+			{
+				Clusters.Add({ OptimizedIndices.Num() / 3 - 1, 0, 0 });
+			}
+			Clusters.Last().NumTriangles++;
+
+			EmittedTriangles[TriangleIndex] = true;
+		}
+
+		// prefer the candidate that will still be in the cache after emitting all of its triangles
+		FanningVertex = INDEX_NONE;
+		int32 BestPriority = -1;
+		for (const int32 Candidate : Candidates)
+		{
+			if (LiveTriangles[Candidate] > 0)
+			{
+				int32 Priority = 0;
+				if (Time - CacheTimeStamps[Candidate] + 2 * LiveTriangles[Candidate] <= MeshOptVertexCacheSize)
+				{
+					Priority = Time - CacheTimeStamps[Candidate];
+				}
+				if (Priority > BestPriority)
+				{
+					BestPriority = Priority;
+					FanningVertex = Candidate;
+				}
+			}
+		}
+
+		// dead end: go back to the most recently used vertices, and then to the input order
+		while (FanningVertex == INDEX_NONE && DeadEndStackNum > 0)
+		{
+			const int32 VertexIndex = DeadEndStack[--DeadEndStackNum];
+			if (LiveTriangles[VertexIndex] > 0)
+			{
+				FanningVertex = VertexIndex;
+			}
+		}
+
+		while (FanningVertex == INDEX_NONE && Cursor < NumVertices)
+		{
+			if (LiveTriangles[Cursor] > 0)
+			{
+				FanningVertex = Cursor;
+			}
+			Cursor++;
+		}
+	}
+
+	// overdraw: the clusters facing away from the center of the mesh are the most likely to occlude the others, so draw them first
+	if (Clusters.Num() > 1)
+	{
+		FVector MeshCenter = FVector::ZeroVector;
+		double MeshArea = 0;
+
+		TArray<FVector> ClustersCenters;
+		ClustersCenters.AddUninitialized(Clusters.Num());
+		TArray<FVector> ClustersNormals;
+		ClustersNormals.AddUninitialized(Clusters.Num());
+
+		for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ClusterIndex++)
+		{
+			const FglTFRuntimeTrianglesCluster& Cluster = Clusters[ClusterIndex];
+			FVector ClusterCenter = FVector::ZeroVector;
+			FVector ClusterNormal = FVector::ZeroVector;
+			double ClusterArea = 0;
+
+			for (int32 TriangleIndex = Cluster.FirstTriangle; TriangleIndex < Cluster.FirstTriangle + Cluster.NumTriangles; TriangleIndex++)
+			{
+				const FVector& Position0 = Positions[OptimizedIndices[TriangleIndex * 3]];
+				const FVector& Position1 = Positions[OptimizedIndices[TriangleIndex * 3 + 1]];
+				const FVector& Position2 = Positions[OptimizedIndices[TriangleIndex * 3 + 2]];
+
+				// same winding used for generating normals
+				const FVector Normal = FVector::CrossProduct(Position2 - Position0, Position1 - Position0);
+				const double Area = Normal.Size();
+
+				ClusterCenter += (Position0 + Position1 + Position2) * (Area / 3);
+				ClusterNormal += Normal;
+				ClusterArea += Area;
+			}
+
+			MeshCenter += ClusterCenter;
+			MeshArea += ClusterArea;
+
+			ClustersCenters[ClusterIndex] = ClusterArea > 0 ? ClusterCenter / ClusterArea : ClusterCenter;
+			ClustersNormals[ClusterIndex] = ClusterNormal.GetSafeNormal();
+		}
+
+		if (MeshArea > 0)
+		{
+			MeshCenter /= MeshArea;
+		}
+
+		for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ClusterIndex++)
+		{
+			Clusters[ClusterIndex].SortKey = FVector::DotProduct(ClustersCenters[ClusterIndex] - MeshCenter, ClustersNormals[ClusterIndex]);
+		}
+
+		Algo::StableSort(Clusters, [](const FglTFRuntimeTrianglesCluster& A, const FglTFRuntimeTrianglesCluster& B) { return A.SortKey > B.SortKey; });
+
+		int32 IndexOffset = 0;
+		for (const FglTFRuntimeTrianglesCluster& Cluster : Clusters)
+		{
+			FMemory::Memcpy(Indices.GetData() + IndexOffset, OptimizedIndices.GetData() + Cluster.FirstTriangle * 3, Cluster.NumTriangles * 3 * sizeof(uint32));
+			IndexOffset += Cluster.NumTriangles * 3;
+		}
+	}
+	else
+	{
+		Indices = MoveTemp(OptimizedIndices);
+	}
+}
+
+void FglTFRuntimeParser::OptimizeVertexFetch(TArray<uint32>& Indices, const int32 NumVertices, TArray<uint32>& VerticesOrder)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_OptimizeVertexFetch, FColor::Magenta);
+
+	TArray<uint32> VerticesRemap;
+	VerticesRemap.Init(MAX_uint32, NumVertices);
+
+	VerticesOrder.Reset(NumVertices);
+
+	for (uint32& Index : Indices)
+	{
+		if (VerticesRemap[Index] == MAX_uint32)
+		{
+			VerticesRemap[Index] = VerticesOrder.Add(Index);
+		}
+		Index = VerticesRemap[Index];
+	}
+}
@@ -0,0 +1,754 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	// the vertex kinds drive which collapses are allowed (see meshoptimizer simplifier for the original idea)
+	enum class EglTFRuntimeSimplifierVertexKind : uint8
+	{
+		Manifold, // not on a border nor on an attributes seam, can collapse anywhere
+		Border, // on an open edge, can collapse only along the border
+		Seam, // on an attributes seam (two vertices sharing the position), can collapse only along the seam
+		Locked // anything else (corners, complex seams, non manifold edges)
+	};
+
+	FORCEINLINE bool CanCollapse(const EglTFRuntimeSimplifierVertexKind From, const EglTFRuntimeSimplifierVertexKind To)
+	{
+		if (From == EglTFRuntimeSimplifierVertexKind::Manifold)
+		{
+			return true;
+		}
+		return From != EglTFRuntimeSimplifierVertexKind::Locked && From == To;
+	}
+
+	struct FglTFRuntimeQuadric
+	{
+		double A00 = 0, A11 = 0, A22 = 0;
+		double A10 = 0, A20 = 0, A21 = 0;
+		double B0 = 0, B1 = 0, B2 = 0;
+		double C = 0;
+		double Weight = 0;
+
+		void AddPlane(const FVector& Normal, const double Distance, const double PlaneWeight)
+		{
+			A00 += PlaneWeight * Normal.X * Normal.X;
+			A11 += PlaneWeight * Normal.Y * Normal.Y;
+			A22 += PlaneWeight * Normal.Z * Normal.Z;
+			A10 += PlaneWeight * Normal.Y * Normal.X;
+			A20 += PlaneWeight * Normal.Z * Normal.X;
+			A21 += PlaneWeight * Normal.Z * Normal.Y;
+			B0 += PlaneWeight * Normal.X * Distance;
+			B1 += PlaneWeight * Normal.Y * Distance;
+			B2 += PlaneWeight * Normal.Z * Distance;
+			C += PlaneWeight * Distance * Distance;
+			Weight += PlaneWeight;
+		}
+
+		void Add(const FglTFRuntimeQuadric& Other)
+		{
+			A00 += Other.A00;
+			A11 += Other.A11;
+			A22 += Other.A22;
+			A10 += Other.A10;
+			A20 += Other.A20;
+			A21 += Other.A21;
+			B0 += Other.B0;
+			B1 += Other.B1;
+			B2 += Other.B2;
+			C += Other.C;
+			Weight += Other.Weight;
+		}
+
+		// weighted mean of the squared distances from the accumulated planes
+		double Error(const FVector& Position) const
+		{
+			const double RX = Position.X * A00 + Position.Y * A10 + Position.Z * A20 + B0;
+			const double RY = Position.X * A10 + Position.Y * A11 + Position.Z * A21 + B1;
+			const double RZ = Position.X * A20 + Position.Y * A21 + Position.Z * A22 + B2;
+			const double R = Position.X * RX + Position.Y * RY + Position.Z * RZ + (B0 * Position.X + B1 * Position.Y + B2 * Position.Z) + C;
+			return Weight > 0 ? FMath::Abs(R) / Weight : 0;
+		}
+	};
+
+	struct FglTFRuntimeEdgeCollapse
+	{
+		uint32 From;
+		uint32 To;
+		bool bBidirectional;
+		double Error;
+		double GeometricError;
+	};
+
+	// open edges and seams are preserved more than flat areas
+	constexpr double BorderEdgeWeight = 10;
+	constexpr double SeamEdgeWeight = 1;
+	// the cost of collapsing onto a vertex with totally different skin weights, relative to the mesh size
+	constexpr double SkinWeightsErrorScale = 0.5;
+
+	FORCEINLINE bool HasTriangleFlip(const FVector& A, const FVector& B, const FVector& C0, const FVector& C1)
+	{
+		const FVector EdgeB = B - A;
+		return FVector::DotProduct(FVector::CrossProduct(EdgeB, C0 - A), FVector::CrossProduct(EdgeB, C1 - A)) <= 0;
+	}
+
+	template<typename T>
+	void CompactVertexAttribute(TArray<T>& Attribute, const TArray<uint32>& VerticesOrder)
+	{
+		TArray<T> CompactedAttribute;
+		CompactedAttribute.AddUninitialized(VerticesOrder.Num());
+		for (int32 VertexIndex = 0; VertexIndex < VerticesOrder.Num(); VertexIndex++)
+		{
+			CompactedAttribute[VertexIndex] = Attribute[VerticesOrder[VertexIndex]];
+		}
+		Attribute = MoveTemp(CompactedAttribute);
+	}
+}
+
+double FglTFRuntimeParser::SimplifyTriangles(TArray<uint32>& Indices, const TArray<FVector>& Positions, const int32 TargetNumIndices, TFunctionRef<double(const uint32 VertexA, const uint32 VertexB)> AttributesDistance)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_SimplifyTriangles, FColor::Magenta);
+
+	const int32 NumVertices = Positions.Num();
+	if ((Indices.Num() % 3) != 0 || Indices.Num() <= TargetNumIndices)
+	{
+		return 0;
+	}
+
+	for (const uint32 Index : Indices)
+	{
+		if (Index >= static_cast<uint32>(NumVertices))
+		{
+			return 0;
+		}
+	}
+
+	// vertices sharing the same position (Remap points to the first one, Wedge links them in a circular list)
+	TArray<uint32> Remap;
+	Remap.AddUninitialized(NumVertices);
+	TArray<uint32> Wedge;
+	Wedge.AddUninitialized(NumVertices);
+	{
+		TMap<FVector, uint32> PositionsMap;
+		PositionsMap.Reserve(NumVertices);
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			uint32 FirstVertex = VertexIndex;
+			if (const uint32* PositionVertex = PositionsMap.Find(Positions[VertexIndex]))
+			{
+				FirstVertex = *PositionVertex;
+			}
+			else
+			{
+				PositionsMap.Add(Positions[VertexIndex], VertexIndex);
+			}
+			Remap[VertexIndex] = FirstVertex;
+			if (FirstVertex != static_cast<uint32>(VertexIndex))
+			{
+				Wedge[VertexIndex] = Wedge[FirstVertex];
+				Wedge[FirstVertex] = VertexIndex;
+			}
+			else
+			{
+				Wedge[VertexIndex] = VertexIndex;
+			}
+		}
+	}
+
+	// open half edges (without an opposite one) in attributes space, MAX_uint32 when missing, the vertex itself when ambiguous
+	TArray<uint32> OpenIncoming;
+	OpenIncoming.Init(MAX_uint32, NumVertices);
+	TArray<uint32> OpenOutgoing;
+	OpenOutgoing.Init(MAX_uint32, NumVertices);
+	{
+		TArray<int32> EdgesOffsets;
+		EdgesOffsets.AddZeroed(NumVertices + 1);
+		for (const uint32 Index : Indices)
+		{
+			EdgesOffsets[Index + 1]++;
+		}
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			EdgesOffsets[VertexIndex + 1] += EdgesOffsets[VertexIndex];
+		}
+
+		TArray<uint32> EdgesTargets;
+		EdgesTargets.AddUninitialized(Indices.Num());
+		TArray<int32> EdgesFill(EdgesOffsets.GetData(), NumVertices);
+		for (int32 Index = 0; Index < Indices.Num(); Index += 3)
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				EdgesTargets[EdgesFill[Indices[Index + Corner]]++] = Indices[Index + (Corner + 1) % 3];
+			}
+		}
+
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			for (int32 EdgeIndex = EdgesOffsets[VertexIndex]; EdgeIndex < EdgesOffsets[VertexIndex + 1]; EdgeIndex++)
+			{
+				const uint32 Target = EdgesTargets[EdgeIndex];
+				bool bHasOpposite = false;
+				for (int32 OppositeIndex = EdgesOffsets[Target]; OppositeIndex < EdgesOffsets[Target + 1]; OppositeIndex++)
+				{
+					if (EdgesTargets[OppositeIndex] == static_cast<uint32>(VertexIndex))
+					{
+						bHasOpposite = true;
+						break;
+					}
+				}
+
+				if (!bHasOpposite)
+				{
+					OpenIncoming[Target] = OpenIncoming[Target] == MAX_uint32 ? VertexIndex : Target;
+					OpenOutgoing[VertexIndex] = OpenOutgoing[VertexIndex] == MAX_uint32 ? Target : VertexIndex;
+				}
+			}
+		}
+	}
+
+	TArray<EglTFRuntimeSimplifierVertexKind> Kinds;
+	Kinds.AddUninitialized(NumVertices);
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+	{
+		if (Remap[VertexIndex] != static_cast<uint32>(VertexIndex))
+		{
+			continue;
+		}
+
+		const uint32 Vertex = VertexIndex;
+		EglTFRuntimeSimplifierVertexKind Kind = EglTFRuntimeSimplifierVertexKind::Locked;
+		if (Wedge[Vertex] == Vertex)
+		{
+			if (OpenIncoming[Vertex] == MAX_uint32 && OpenOutgoing[Vertex] == MAX_uint32)
+			{
+				Kind = EglTFRuntimeSimplifierVertexKind::Manifold;
+			}
+			else if (OpenIncoming[Vertex] != Vertex && OpenOutgoing[Vertex] != Vertex)
+			{
+				Kind = EglTFRuntimeSimplifierVertexKind::Border;
+			}
+		}
+		else if (Wedge[Wedge[Vertex]] == Vertex)
+		{
+			// a seam has an open half edge for each side, and they need to connect the same positions
+			const uint32 Other = Wedge[Vertex];
+			const uint32 IncomingV = OpenIncoming[Vertex];
+			const uint32 OutgoingV = OpenOutgoing[Vertex];
+			const uint32 IncomingO = OpenIncoming[Other];
+			const uint32 OutgoingO = OpenOutgoing[Other];
+			if (IncomingV != MAX_uint32 && IncomingV != Vertex && OutgoingV != MAX_uint32 && OutgoingV != Vertex &&
+				IncomingO != MAX_uint32 && IncomingO != Other && OutgoingO != MAX_uint32 && OutgoingO != Other &&
+				Remap[IncomingV] == Remap[OutgoingO] && Remap[OutgoingV] == Remap[IncomingO] && Remap[IncomingV] != Remap[OutgoingV])
+			{
+				Kind = EglTFRuntimeSimplifierVertexKind::Seam;
+			}
+		}
+		Kinds[Vertex] = Kind;
+	}
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+	{
+		Kinds[VertexIndex] = Kinds[Remap[VertexIndex]];
+	}
+
+	// border and seams loops (updated after every pass)
+	TArray<uint32> Loop;
+	Loop.Init(MAX_uint32, NumVertices);
+	TArray<uint32> LoopBack;
+	LoopBack.Init(MAX_uint32, NumVertices);
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+	{
+		if (Kinds[VertexIndex] == EglTFRuntimeSimplifierVertexKind::Border || Kinds[VertexIndex] == EglTFRuntimeSimplifierVertexKind::Seam)
+		{
+			if (OpenOutgoing[VertexIndex] != MAX_uint32 && OpenOutgoing[VertexIndex] != static_cast<uint32>(VertexIndex))
+			{
+				Loop[VertexIndex] = OpenOutgoing[VertexIndex];
+			}
+			if (OpenIncoming[VertexIndex] != MAX_uint32 && OpenIncoming[VertexIndex] != static_cast<uint32>(VertexIndex))
+			{
+				LoopBack[VertexIndex] = OpenIncoming[VertexIndex];
+			}
+		}
+	}
+
+	// quadrics are stored on the first vertex of each position
+	TArray<FglTFRuntimeQuadric> Quadrics;
+	Quadrics.AddDefaulted(NumVertices);
+	for (int32 Index = 0; Index < Indices.Num(); Index += 3)
+	{
+		const uint32 Vertex0 = Remap[Indices[Index]];
+		const uint32 Vertex1 = Remap[Indices[Index + 1]];
+		const uint32 Vertex2 = Remap[Indices[Index + 2]];
+
+		const FVector& Position0 = Positions[Vertex0];
+		const FVector& Position1 = Positions[Vertex1];
+		const FVector& Position2 = Positions[Vertex2];
+
+		FVector Normal = FVector::CrossProduct(Position1 - Position0, Position2 - Position0);
+		const double Area = Normal.Size();
+		if (Area <= 0)
+		{
+			continue;
+		}
+		Normal /= Area;
+
+		FglTFRuntimeQuadric Quadric;
+		Quadric.AddPlane(Normal, -FVector::DotProduct(Normal, Position0), Area);
+		Quadrics[Vertex0].Add(Quadric);
+		Quadrics[Vertex1].Add(Quadric);
+		Quadrics[Vertex2].Add(Quadric);
+
+		// open edges get an additional plane perpendicular to the triangle to keep them in place
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			const uint32 From = Indices[Index + Corner];
+			const uint32 To = Indices[Index + (Corner + 1) % 3];
+			if (Loop[From] != To)
+			{
+				continue;
+			}
+
+			const FVector& FromPosition = Positions[Remap[From]];
+			const FVector Edge = Positions[Remap[To]] - FromPosition;
+			const double EdgeLength = Edge.Size();
+			const FVector EdgeNormal = FVector::CrossProduct(Edge, Normal).GetSafeNormal();
+			const double EdgeWeight = Kinds[From] == EglTFRuntimeSimplifierVertexKind::Seam ? SeamEdgeWeight : BorderEdgeWeight;
+
+			FglTFRuntimeQuadric EdgeQuadric;
+			EdgeQuadric.AddPlane(EdgeNormal, -FVector::DotProduct(EdgeNormal, FromPosition), EdgeLength * EdgeLength * EdgeWeight);
+			Quadrics[Remap[From]].Add(EdgeQuadric);
+			Quadrics[Remap[To]].Add(EdgeQuadric);
+		}
+	}
+
+	// attributes distances are scaled to the mesh size, so that they can be compared to the geometric error
+	FBox Bounds(Positions);
+	const double AttributesErrorScale = FMath::Square(Bounds.GetExtent().Size() * SkinWeightsErrorScale);
+
+	TArray<uint32> Result = Indices;
+	double ResultError = 0;
+
+	TArray<uint32> CollapseRemap;
+	CollapseRemap.AddUninitialized(NumVertices);
+	TArray<bool> CollapseLocked;
+	CollapseLocked.AddUninitialized(NumVertices);
+	TArray<FglTFRuntimeEdgeCollapse> Collapses;
+	TArray<int32> AdjacencyOffsets;
+	TArray<TPair<uint32, uint32>> Adjacency;
+
+	while (Result.Num() > TargetNumIndices)
+	{
+		// triangles around each position (as pairs of the other two positions)
+		AdjacencyOffsets.Reset();
+		AdjacencyOffsets.AddZeroed(NumVertices + 1);
+		for (const uint32 Index : Result)
+		{
+			AdjacencyOffsets[Remap[Index] + 1]++;
+		}
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			AdjacencyOffsets[VertexIndex + 1] += AdjacencyOffsets[VertexIndex];
+		}
+		Adjacency.SetNumUninitialized(Result.Num());
+		{
+			TArray<int32> AdjacencyFill(AdjacencyOffsets.GetData(), NumVertices);
+			for (int32 Index = 0; Index < Result.Num(); Index += 3)
+			{
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					const uint32 Vertex = Remap[Result[Index + Corner]];
+					Adjacency[AdjacencyFill[Vertex]++] = TPair<uint32, uint32>(Remap[Result[Index + (Corner + 1) % 3]], Remap[Result[Index + (Corner + 2) % 3]]);
+				}
+			}
+		}
+
+		// candidates
+		Collapses.Reset();
+		for (int32 Index = 0; Index < Result.Num(); Index += 3)
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const uint32 Vertex0 = Result[Index + Corner];
+				const uint32 Vertex1 = Result[Index + (Corner + 1) % 3];
+				const EglTFRuntimeSimplifierVertexKind Kind0 = Kinds[Vertex0];
+				const EglTFRuntimeSimplifierVertexKind Kind1 = Kinds[Vertex1];
+
+				const bool bCanCollapse01 = CanCollapse(Kind0, Kind1);
+				const bool bCanCollapse10 = CanCollapse(Kind1, Kind0);
+				if (!bCanCollapse01 && !bCanCollapse10)
+				{
+					continue;
+				}
+
+				// manifold edges are found twice
+				if (Kind0 == EglTFRuntimeSimplifierVertexKind::Manifold && Kind1 == EglTFRuntimeSimplifierVertexKind::Manifold && Remap[Vertex1] > Remap[Vertex0])
+				{
+					continue;
+				}
+
+				// two border (or seam) vertices not connected by the same loop
+				if (Kind0 == Kind1 && (Kind0 == EglTFRuntimeSimplifierVertexKind::Border || Kind0 == EglTFRuntimeSimplifierVertexKind::Seam) && Loop[Vertex0] != Vertex1 && LoopBack[Vertex0] != Vertex1)
+				{
+					continue;
+				}
+
+				FglTFRuntimeEdgeCollapse Collapse;
+				Collapse.From = bCanCollapse01 ? Vertex0 : Vertex1;
+				Collapse.To = bCanCollapse01 ? Vertex1 : Vertex0;
+				Collapse.bBidirectional = bCanCollapse01 && bCanCollapse10;
+				Collapses.Add(Collapse);
+			}
+		}
+
+		if (Collapses.Num() == 0)
+		{
+			break;
+		}
+
+		ParallelFor(Collapses.Num(), [&](const int32 CollapseIndex)
+			{
+				FglTFRuntimeEdgeCollapse& Collapse = Collapses[CollapseIndex];
+				const uint32 Remap0 = Remap[Collapse.From];
+				const uint32 Remap1 = Remap[Collapse.To];
+
+				const double ErrorFrom = Quadrics[Remap0].Error(Positions[Remap1]);
+				const double ErrorTo = Collapse.bBidirectional ? Quadrics[Remap1].Error(Positions[Remap0]) : TNumericLimits<double>::Max();
+
+				if (ErrorTo < ErrorFrom)
+				{
+					Swap(Collapse.From, Collapse.To);
+				}
+				Collapse.GeometricError = FMath::Min(ErrorFrom, ErrorTo);
+				Collapse.Error = Collapse.GeometricError + FMath::Square(AttributesDistance(Collapse.From, Collapse.To)) * AttributesErrorScale;
+			}, Collapses.Num() < 4096);
+
+		Algo::Sort(Collapses, [](const FglTFRuntimeEdgeCollapse& A, const FglTFRuntimeEdgeCollapse& B) { return A.Error < B.Error; });
+
+		const int32 TriangleCollapsesGoal = (Result.Num() - TargetNumIndices) / 3;
+		// each collapse removes ~2 triangles, the error of the goal candidate limits the pass to avoid collapsing too greedily
+		const int32 EdgeCollapsesGoal = TriangleCollapsesGoal / 2;
+		const double PassErrorLimit = EdgeCollapsesGoal < Collapses.Num() ? Collapses[EdgeCollapsesGoal].Error * 1.5 : TNumericLimits<double>::Max();
+
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			CollapseRemap[VertexIndex] = VertexIndex;
+			CollapseLocked[VertexIndex] = false;
+		}
+
+		int32 TriangleCollapses = 0;
+		int32 EdgeCollapses = 0;
+
+		for (const FglTFRuntimeEdgeCollapse& Collapse : Collapses)
+		{
+			if (TriangleCollapses >= TriangleCollapsesGoal || (Collapse.Error > PassErrorLimit && TriangleCollapses > TriangleCollapsesGoal / 10))
+			{
+				break;
+			}
+
+			const uint32 Remap0 = Remap[Collapse.From];
+			const uint32 Remap1 = Remap[Collapse.To];
+
+			if (CollapseLocked[Remap0] || CollapseLocked[Remap1])
+			{
+				continue;
+			}
+
+			// moving the vertex must not flip the triangles around it
+			bool bFlips = false;
+			for (int32 AdjacencyIndex = AdjacencyOffsets[Remap0]; AdjacencyIndex < AdjacencyOffsets[Remap0 + 1]; AdjacencyIndex++)
+			{
+				const uint32 VertexA = Remap[CollapseRemap[Adjacency[AdjacencyIndex].Key]];
+				const uint32 VertexB = Remap[CollapseRemap[Adjacency[AdjacencyIndex].Value]];
+				// the triangles sharing the edge are going to be removed
+				if (VertexA == Remap1 || VertexB == Remap1)
+				{
+					continue;
+				}
+
+				if (HasTriangleFlip(Positions[VertexA], Positions[VertexB], Positions[Remap0], Positions[Remap1]))
+				{
+					bFlips = true;
+					break;
+				}
+			}
+
+			if (bFlips)
+			{
+				continue;
+			}
+
+			const EglTFRuntimeSimplifierVertexKind Kind = Kinds[Collapse.From];
+			if (Kind == EglTFRuntimeSimplifierVertexKind::Seam)
+			{
+				// the other side of the seam follows
+				CollapseRemap[Collapse.From] = Collapse.To;
+				CollapseRemap[Wedge[Collapse.From]] = Wedge[Collapse.To];
+			}
+			else
+			{
+				uint32 WedgeVertex = Collapse.From;
+				do
+				{
+					CollapseRemap[WedgeVertex] = Collapse.To;
+					WedgeVertex = Wedge[WedgeVertex];
+				} while (WedgeVertex != Collapse.From);
+			}
+
+			CollapseLocked[Remap0] = true;
+			CollapseLocked[Remap1] = true;
+
+			TriangleCollapses += Kind == EglTFRuntimeSimplifierVertexKind::Border ? 1 : 2;
+			EdgeCollapses++;
+
+			ResultError = FMath::Max(ResultError, Collapse.GeometricError);
+		}
+
+		if (EdgeCollapses == 0)
+		{
+			break;
+		}
+
+		// the quadric is moved only once per position
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			if (CollapseRemap[VertexIndex] != static_cast<uint32>(VertexIndex) && Remap[VertexIndex] == static_cast<uint32>(VertexIndex))
+			{
+				Quadrics[Remap[CollapseRemap[VertexIndex]]].Add(Quadrics[VertexIndex]);
+			}
+		}
+
+		// the links are read from a copy: updating in place would make the result depend on the vertices order
+		auto RemapLoop = [NumVertices, &CollapseRemap](TArray<uint32>& Loops)
+			{
+				const TArray<uint32> SourceLoops = Loops;
+				for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+				{
+					const uint32 Next = SourceLoops[VertexIndex];
+					if (Next != MAX_uint32)
+					{
+						const uint32 NextRemapped = CollapseRemap[Next];
+						// the edge collapsed in the opposite direction of the loop, skip the collapsed vertex (its next one could have been collapsed too)
+						if (NextRemapped == static_cast<uint32>(VertexIndex))
+						{
+							const uint32 NextNext = SourceLoops[Next];
+							Loops[VertexIndex] = NextNext != MAX_uint32 ? CollapseRemap[NextNext] : MAX_uint32;
+						}
+						else
+						{
+							Loops[VertexIndex] = NextRemapped;
+						}
+					}
+				}
+			};
+		RemapLoop(Loop);
+		RemapLoop(LoopBack);
+
+		int32 NewNum = 0;
+		for (int32 Index = 0; Index < Result.Num(); Index += 3)
+		{
+			const uint32 Vertex0 = CollapseRemap[Result[Index]];
+			const uint32 Vertex1 = CollapseRemap[Result[Index + 1]];
+			const uint32 Vertex2 = CollapseRemap[Result[Index + 2]];
+
+			if (Remap[Vertex0] != Remap[Vertex1] && Remap[Vertex0] != Remap[Vertex2] && Remap[Vertex1] != Remap[Vertex2])
+			{
+				Result[NewNum++] = Vertex0;
+				Result[NewNum++] = Vertex1;
+				Result[NewNum++] = Vertex2;
+			}
+		}
+		Result.RemoveAt(NewNum, Result.Num() - NewNum, false);
+	}
+
+	Indices = MoveTemp(Result);
+
+	return FMath::Sqrt(ResultError);
+}
+
+bool FglTFRuntimeParser::GenerateSimplifiedLODs(const FglTFRuntimeMeshLOD& SourceLOD, const TArray<float>& TrianglesRatios, const float PixelError, TArray<FglTFRuntimeMeshLOD>& LODs, TArray<float>& ScreenSizes)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_GenerateSimplifiedLODs, FColor::Magenta);
+
+	FBox Bounds;
+	Bounds.Init();
+	for (const FglTFRuntimePrimitive& Primitive : SourceLOD.Primitives)
+	{
+		Bounds += FBox(Primitive.Positions);
+	}
+
+	const double Radius = Bounds.IsValid ? Bounds.GetExtent().Size() : 0;
+	if (Radius <= 0)
+	{
+		return false;
+	}
+
+	const int32 NumPrimitives = SourceLOD.Primitives.Num();
+
+	LODs.SetNum(TrianglesRatios.Num());
+	for (FglTFRuntimeMeshLOD& LOD : LODs)
+	{
+		LOD.Primitives.SetNum(NumPrimitives);
+		LOD.AdditionalTransforms = SourceLOD.AdditionalTransforms;
+		LOD.Skeleton = SourceLOD.Skeleton;
+		LOD.bHasNormals = SourceLOD.bHasNormals;
+		LOD.bHasTangents = SourceLOD.bHasTangents;
+		LOD.bHasUV = SourceLOD.bHasUV;
+		LOD.bHasVertexColors = SourceLOD.bHasVertexColors;
+	}
+
+	TArray<double> PrimitivesErrors;
+	PrimitivesErrors.AddZeroed(TrianglesRatios.Num() * NumPrimitives);
+
+	// every LOD is generated from the source one, so all of the primitives of all of the LODs are simplified in parallel
+	ParallelFor(TrianglesRatios.Num() * NumPrimitives, [&](const int32 TaskIndex)
+		{
+			const int32 LODIndex = TaskIndex / NumPrimitives;
+			const int32 PrimitiveIndex = TaskIndex % NumPrimitives;
+			const FglTFRuntimePrimitive& SourcePrimitive = SourceLOD.Primitives[PrimitiveIndex];
+			FglTFRuntimePrimitive& Primitive = LODs[LODIndex].Primitives[PrimitiveIndex];
+
+			Primitive = SourcePrimitive;
+
+			// points and lines
+			if (SourcePrimitive.Mode < 4)
+			{
+				return;
+			}
+
+			const int32 NumTriangles = SourcePrimitive.Indices.Num() / 3;
+			const int32 TargetNumTriangles = FMath::Max(1, FMath::RoundToInt(NumTriangles * FMath::Clamp(TrianglesRatios[LODIndex], 0.0f, 1.0f)));
+
+			// skin weights are compared as the amount of influence moving between bones (0 to 1)
+			const int32 NumJoints = FMath::Min(SourcePrimitive.Joints.Num(), SourcePrimitive.Weights.Num());
+			auto SkinWeightsDistance = [&SourcePrimitive, NumJoints](const uint32 VertexA, const uint32 VertexB) -> double
+				{
+					double Distance = 0;
+					double Total = 0;
+					for (int32 JointsIndex = 0; JointsIndex < NumJoints; JointsIndex++)
+					{
+						if (!SourcePrimitive.Joints[JointsIndex].IsValidIndex(VertexA) || !SourcePrimitive.Joints[JointsIndex].IsValidIndex(VertexB) ||
+							!SourcePrimitive.Weights[JointsIndex].IsValidIndex(VertexA) || !SourcePrimitive.Weights[JointsIndex].IsValidIndex(VertexB))
+						{
+							continue;
+						}
+
+						FglTFRuntimeUInt16Vector4 JointsA = SourcePrimitive.Joints[JointsIndex][VertexA];
+						FglTFRuntimeUInt16Vector4 JointsB = SourcePrimitive.Joints[JointsIndex][VertexB];
+						const FVector4& WeightsA = SourcePrimitive.Weights[JointsIndex][VertexA];
+						const FVector4& WeightsB = SourcePrimitive.Weights[JointsIndex][VertexB];
+
+						for (int32 InfluenceIndex = 0; InfluenceIndex < 4; InfluenceIndex++)
+						{
+							double WeightInB = 0;
+							for (int32 OtherIndex = 0; OtherIndex < 4; OtherIndex++)
+							{
+								if (JointsB[OtherIndex] == JointsA[InfluenceIndex])
+								{
+									WeightInB += WeightsB[OtherIndex];
+								}
+							}
+							Distance += FMath::Max(WeightsA[InfluenceIndex] - WeightInB, 0.0);
+							Total += WeightsA[InfluenceIndex];
+						}
+					}
+					return Total > 0 ? FMath::Min(Distance / Total, 1.0) : 0;
+				};
+
+			PrimitivesErrors[TaskIndex] = SimplifyTriangles(Primitive.Indices, SourcePrimitive.Positions, TargetNumTriangles * 3, SkinWeightsDistance);
+
+			CompactPrimitive(Primitive);
+		});
+
+	// the screen size is the projected diameter of the bounds relative to the screen height,
+	// so an error of RelativeError * Radius covers RelativeError * ScreenSize * 540 pixels on a 1080p screen
+	ScreenSizes.SetNum(TrianglesRatios.Num());
+	float PreviousScreenSize = 1;
+	for (int32 LODIndex = 0; LODIndex < TrianglesRatios.Num(); LODIndex++)
+	{
+		double LODError = 0;
+		for (int32 PrimitiveIndex = 0; PrimitiveIndex < NumPrimitives; PrimitiveIndex++)
+		{
+			LODError = FMath::Max(LODError, PrimitivesErrors[LODIndex * NumPrimitives + PrimitiveIndex]);
+		}
+		const double RelativeError = LODError / Radius;
+		const float ScreenSize = RelativeError > 0 ? static_cast<float>(PixelError / (RelativeError * 540)) : PreviousScreenSize;
+		ScreenSizes[LODIndex] = FMath::Min(ScreenSize, PreviousScreenSize);
+		PreviousScreenSize = ScreenSizes[LODIndex];
+	}
+
+	return true;
+}
+
+void FglTFRuntimeParser::CompactPrimitive(FglTFRuntimePrimitive& Primitive)
+{
+	const int32 NumVertices = Primitive.Positions.Num();
+
+	// partially defined attributes rely on their size, so leave them alone
+	auto IsCompactable = [NumVertices](const auto& Attribute)
+		{
+			return Attribute.Num() == 0 || Attribute.Num() == NumVertices;
+		};
+
+	bool bCompactable = IsCompactable(Primitive.Normals) && IsCompactable(Primitive.Tangents) && IsCompactable(Primitive.Colors);
+	for (const TArray<FVector2D>& UV : Primitive.UVs)
+	{
+		bCompactable &= IsCompactable(UV);
+	}
+	for (const TArray<FglTFRuntimeUInt16Vector4>& Joints : Primitive.Joints)
+	{
+		bCompactable &= IsCompactable(Joints);
+	}
+	for (const TArray<FVector4>& Weights : Primitive.Weights)
+	{
+		bCompactable &= IsCompactable(Weights);
+	}
+	for (const FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
+	{
+		bCompactable &= IsCompactable(MorphTarget.Positions) && IsCompactable(MorphTarget.Normals);
+	}
+
+	for (const uint32 Index : Primitive.Indices)
+	{
+		bCompactable &= Index < static_cast<uint32>(NumVertices);
+	}
+
+	if (!bCompactable)
+	{
+		return;
+	}
+
+	TArray<uint32> VerticesOrder;
+	OptimizeVertexFetch(Primitive.Indices, NumVertices, VerticesOrder);
+
+	auto Compact = [&VerticesOrder](auto& Attribute)
+		{
+			if (Attribute.Num() > 0)
+			{
+				CompactVertexAttribute(Attribute, VerticesOrder);
+			}
+		};
+
+	Compact(Primitive.Positions);
+	Compact(Primitive.Normals);
+	Compact(Primitive.Tangents);
+	Compact(Primitive.Colors);
+	for (TArray<FVector2D>& UV : Primitive.UVs)
+	{
+		Compact(UV);
+	}
+	for (TArray<FglTFRuntimeUInt16Vector4>& Joints : Primitive.Joints)
+	{
+		Compact(Joints);
+	}
+	for (TArray<FVector4>& Weights : Primitive.Weights)
+	{
+		Compact(Weights);
+	}
+	for (FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
+	{
+		Compact(MorphTarget.Positions);
+		Compact(MorphTarget.Normals);
+	}
+}
@@ -2,6 +2,7 @@
 
 #include "glTFRuntimeParser.h"
 #include "Runtime/Launch/Resources/Version.h"
+#include "Async/ParallelFor.h"
 #if ENGINE_MAJOR_VERSION > 4
 #include "Animation/AnimData/AnimDataModel.h"
 #include "Animation/AnimData/IAnimationDataController.h"
@@ -306,14 +307,13 @@ USkeletalMesh* FglTFRuntimeParser::CreateSkeletalMeshFromLODs(TSharedRef<FglTFRu
 	TMap<int32, FName> MainBoneMap;
 	if (!SkeletalMeshContext->SkeletalMeshConfig.bIgnoreSkin && SkeletalMeshContext->SkinIndex > INDEX_NONE)
 	{
-		TSharedPtr<FJsonObject>	JsonSkinObject = GetJsonObjectFromRootIndex("skins", SkeletalMeshContext->SkinIndex);
-		if (!JsonSkinObject)
+		if (!HasJsonRootObject("skins", SkeletalMeshContext->SkinIndex))
 		{
 			AddError("CreateSkeletalMeshFromLODs()", "Unable to fill RefSkeleton.");
 			return nullptr;
 		}
 
-		if (!FillReferenceSkeleton(JsonSkinObject.ToSharedRef(), RefSkeleton, MainBoneMap, SkeletalMeshContext->SkeletalMeshConfig.SkeletonConfig))
+		if (!FillReferenceSkeleton(SkeletalMeshContext->SkinIndex, RefSkeleton, MainBoneMap, SkeletalMeshContext->SkeletalMeshConfig.SkeletonConfig))
 		{
 			AddError("CreateSkeletalMeshFromLODs()", "Unable to fill RefSkeleton.");
 			return nullptr;
@@ -429,6 +429,20 @@ USkeletalMesh* FglTFRuntimeParser::CreateSkeletalMeshFromLODs(TSharedRef<FglTFRu
 
 	OnPreCreatedSkeletalMesh.Broadcast(SkeletalMeshContext);
 
+	if (SkeletalMeshContext->SkeletalMeshConfig.AutoLODsTrianglesRatios.Num() > 0 && SkeletalMeshContext->LODs.Num() == 1)
+	{
+		TArray<FglTFRuntimeMeshLOD> GeneratedLODs;
+		TArray<float> GeneratedScreenSizes;
+		if (GenerateSimplifiedLODs(*SkeletalMeshContext->LODs[0], SkeletalMeshContext->SkeletalMeshConfig.AutoLODsTrianglesRatios, SkeletalMeshContext->SkeletalMeshConfig.AutoLODsPixelError, GeneratedLODs, GeneratedScreenSizes))
+		{
+			for (int32 GeneratedLODIndex = 0; GeneratedLODIndex < GeneratedLODs.Num(); GeneratedLODIndex++)
+			{
+				SkeletalMeshContext->AddContextLOD() = MoveTemp(GeneratedLODs[GeneratedLODIndex]);
+				SkeletalMeshContext->GeneratedLODScreenSize.Add(SkeletalMeshContext->LODs.Num() - 1, GeneratedScreenSizes[GeneratedLODIndex]);
+			}
+		}
+	}
+
 	for (FglTFRuntimeMeshLOD* LOD : SkeletalMeshContext->LODs)
 	{
 		LOD->bHasTangents = true;
@@ -723,142 +737,71 @@ USkeletalMesh* FglTFRuntimeParser::CreateSkeletalMeshFromLODs(TSharedRef<FglTFRu
 
 		if ((!LOD->bHasTangents || !LOD->bHasNormals) && TotalVertexIndex % 3 == 0)
 		{
+			FStaticMeshVertexBuffer& StaticMeshVertexBuffer = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer;
 
-			//normals with NaNs are incorrectly handled on Android
-			auto FixVectorIfNan = [](FVector& Tangent, int32 Index)
-				{
-					if (Tangent.ContainsNaN() && Index >= 0 && Index < 3)
-					{
-						Tangent.Set(0.0, 0.0, 0.0);
-						Tangent[Index] = 1.0;
-					}
-				};
-
-			for (int32 VertexIndex = 0; VertexIndex < TotalVertexIndex; VertexIndex += 3)
+			TArray<FVector3f> Positions;
+			TArray<FVector3f> Normals;
+			Positions.SetNumUninitialized(TotalVertexIndex);
+			Normals.SetNumUninitialized(TotalVertexIndex);
+			for (int32 VertexIndex = 0; VertexIndex < TotalVertexIndex; VertexIndex++)
 			{
+				Positions[VertexIndex] = LodRenderData->StaticVertexBuffers.PositionVertexBuffer.VertexPosition(VertexIndex);
+				Normals[VertexIndex] = FVector3f(StaticMeshVertexBuffer.VertexTangentZ(VertexIndex));
+			}
 
-#if ENGINE_MAJOR_VERSION > 4
-				FVector Position0 = FVector(LodRenderData->StaticVertexBuffers.PositionVertexBuffer.VertexPosition(VertexIndex));
-				FVector4 TangentZ0 = FVector4(LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(VertexIndex));
-#else
-				FVector Position0 = LodRenderData->StaticVertexBuffers.PositionVertexBuffer.VertexPosition(VertexIndex);
-				FVector4 TangentZ0 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(VertexIndex);
-#endif
-
-
-#if ENGINE_MAJOR_VERSION > 4
-				FVector Position1 = FVector(LodRenderData->StaticVertexBuffers.PositionVertexBuffer.VertexPosition(VertexIndex + 1));
-				FVector4 TangentZ1 = FVector4(LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(VertexIndex + 1));
-#else
-				FVector Position1 = LodRenderData->StaticVertexBuffers.PositionVertexBuffer.VertexPosition(VertexIndex + 1);
-				FVector4 TangentZ1 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(VertexIndex + 1);
-#endif
-
-
-#if ENGINE_MAJOR_VERSION > 4
-				FVector Position2 = FVector(LodRenderData->StaticVertexBuffers.PositionVertexBuffer.VertexPosition(VertexIndex + 2));
-				FVector4 TangentZ2 = FVector4(LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(VertexIndex + 2));
-#else
-				FVector Position2 = LodRenderData->StaticVertexBuffers.PositionVertexBuffer.VertexPosition(VertexIndex + 2);
-				FVector4 TangentZ2 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(VertexIndex + 2);
-#endif
+			if (!LOD->bHasNormals)
+			{
+				GenerateFlatNormals(Positions, Normals);
+			}
 
-				if (!LOD->bHasNormals)
+			// if we do not have tangents but we have normals and a UV channel, we can compute them
+			if (!LOD->bHasTangents && LOD->bHasUV)
+			{
+				TArray<FVector2f> UVs;
+				UVs.SetNumUninitialized(TotalVertexIndex);
+				for (int32 VertexIndex = 0; VertexIndex < TotalVertexIndex; VertexIndex++)
 				{
-					const FVector SideA = Position1 - Position0;
-					const FVector SideB = Position2 - Position0;
-
-					const FVector NormalFromCross = FVector::CrossProduct(SideB, SideA).GetSafeNormal();
-
-					TangentZ0 = NormalFromCross;
-					TangentZ1 = NormalFromCross;
-					TangentZ2 = NormalFromCross;
+					UVs[VertexIndex] = StaticMeshVertexBuffer.GetVertexUV(VertexIndex, 0);
 				}
 
-				// if we do not have tangents but we have normals and a UV channel, we can compute them
-				if (!LOD->bHasTangents && LOD->bHasUV)
+				// the corners of the same source vertex are welded (unless the flat normals made them different)
+				TArray<uint32> Keys;
+				Keys.Reserve(TotalVertexIndex);
+				if (LOD->bHasNormals)
 				{
-					FVector DeltaPosition0 = Position1 - Position0;
-					FVector DeltaPosition1 = Position2 - Position0;
-
-
-#if ENGINE_MAJOR_VERSION > 4
-					const FVector2f& UV0 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.GetVertexUV(VertexIndex, 0);
-					const FVector2f& UV1 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.GetVertexUV(VertexIndex + 1, 0);
-					const FVector2f& UV2 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.GetVertexUV(VertexIndex + 2, 0);
-					FVector2f DeltaUV0 = UV1 - UV0;
-					FVector2f DeltaUV1 = UV2 - UV0;
-#else
-					const FVector2D& UV0 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.GetVertexUV(VertexIndex, 0);
-					const FVector2D& UV1 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.GetVertexUV(VertexIndex + 1, 0);
-					const FVector2D& UV2 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.GetVertexUV(VertexIndex + 2, 0);
-					FVector2D DeltaUV0 = UV1 - UV0;
-					FVector2D DeltaUV1 = UV2 - UV0;
-#endif
-
-					float Factor = 1.0f / (DeltaUV0.X * DeltaUV1.Y - DeltaUV0.Y * DeltaUV1.X);
-
-					FVector TriangleTangentX = ((DeltaPosition0 * DeltaUV1.Y) - (DeltaPosition1 * DeltaUV0.Y)) * Factor;
-					FVector TriangleTangentY = ((DeltaPosition0 * DeltaUV1.X) - (DeltaPosition1 * DeltaUV0.X)) * Factor;
-
-					FVector TangentX0 = TriangleTangentX - (TangentZ0 * FVector::DotProduct(TangentZ0, TriangleTangentX));
-					TangentX0.Normalize();
-
-					FVector TangentX1 = TriangleTangentX - (TangentZ1 * FVector::DotProduct(TangentZ1, TriangleTangentX));
-					TangentX1.Normalize();
-
-					FVector TangentX2 = TriangleTangentX - (TangentZ2 * FVector::DotProduct(TangentZ2, TriangleTangentX));
-					TangentX2.Normalize();
-
-#if PLATFORM_ANDROID
-					FixVectorIfNan(TangentX0, 0);
-					FixVectorIfNan(TangentX1, 0);
-					FixVectorIfNan(TangentX2, 0);
-#endif
-
-					FVector TangentY0 = ComputeTangentY(TangentZ0, TangentX0) * TangentsDirection;
-					FVector TangentY1 = ComputeTangentY(TangentZ1, TangentX1) * TangentsDirection;
-					FVector TangentY2 = ComputeTangentY(TangentZ2, TangentX2) * TangentsDirection;
-#if PLATFORM_ANDROID
-					FixVectorIfNan(TangentY0, 1);
-					FixVectorIfNan(TangentY1, 1);
-					FixVectorIfNan(TangentY2, 1);
-#endif
+					uint32 KeysBase = 0;
+					for (const FglTFRuntimePrimitive& Primitive : LOD->Primitives)
+					{
+						for (const uint32 Index : Primitive.Indices)
+						{
+							Keys.Add(KeysBase + Index);
+						}
+						KeysBase += Primitive.Positions.Num();
+					}
+				}
+				else
+				{
+					for (int32 VertexIndex = 0; VertexIndex < TotalVertexIndex; VertexIndex++)
+					{
+						Keys.Add(VertexIndex);
+					}
+				}
 
+				TArray<FVector4f> Tangents;
+				LoadOrGenerateTangents(Positions, Normals, UVs, Keys, Tangents);
 
-#if ENGINE_MAJOR_VERSION > 4
-					LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex, FVector3f(TangentX0), FVector3f(TangentY0), FVector3f(FVector(TangentZ0)));
-					LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex + 1, FVector3f(TangentX1), FVector3f(TangentY1), FVector3f(FVector(TangentZ1)));
-					LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex + 2, FVector3f(TangentX2), FVector3f(TangentY2), FVector3f(FVector(TangentZ2)));
-#else
-					LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex, TangentX0, TangentY0, TangentZ0);
-					LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex + 1, TangentX1, TangentY1, TangentZ1);
-					LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex + 2, TangentX2, TangentY2, TangentZ2);
-#endif
+				for (int32 VertexIndex = 0; VertexIndex < TotalVertexIndex; VertexIndex++)
+				{
+					const FVector3f TangentX = FVector3f(Tangents[VertexIndex]);
+					const FVector3f TangentY = FVector3f(ComputeTangentYWithW(FVector(Normals[VertexIndex]), FVector(TangentX), Tangents[VertexIndex].W * TangentsDirection));
+					StaticMeshVertexBuffer.SetVertexTangents(VertexIndex, TangentX, TangentY, Normals[VertexIndex]);
 				}
-				else if (!LOD->bHasNormals) // if we are here we need to reapply normals
+			}
+			else if (!LOD->bHasNormals) // if we are here we need to reapply normals
+			{
+				for (int32 VertexIndex = 0; VertexIndex < TotalVertexIndex; VertexIndex++)
 				{
-#if ENGINE_MAJOR_VERSION > 4
-					FVector4f TangentX0 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentX(VertexIndex);
-					FVector4f TangentX1 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentX(VertexIndex + 1);
-					FVector4f TangentX2 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentX(VertexIndex + 2);
-					FVector3f TangentY0 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentY(VertexIndex);
-					FVector3f TangentY1 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentY(VertexIndex + 1);
-					FVector3f TangentY2 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentY(VertexIndex + 2);
-					LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex, TangentX0, TangentY0, FVector4f(TangentZ0));
-					LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex + 1, TangentX1, TangentY1, FVector4f(TangentZ1));
-					LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex + 2, TangentX2, TangentY2, FVector4f(TangentZ2));
-#else
-					FVector4 TangentX0 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentX(VertexIndex);
-					FVector4 TangentX1 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentX(VertexIndex + 1);
-					FVector4 TangentX2 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentX(VertexIndex + 2);
-					FVector TangentY0 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentY(VertexIndex);
-					FVector TangentY1 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentY(VertexIndex + 1);
-					FVector TangentY2 = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.VertexTangentY(VertexIndex + 2);
-					LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex, TangentX0, TangentY0, TangentZ0);
-					LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex + 1, TangentX1, TangentY1, TangentZ1);
-					LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex + 2, TangentX2, TangentY2, TangentZ2);
-#endif
+					StaticMeshVertexBuffer.SetVertexTangents(VertexIndex, FVector3f(StaticMeshVertexBuffer.VertexTangentX(VertexIndex)), StaticMeshVertexBuffer.VertexTangentY(VertexIndex), Normals[VertexIndex]);
 				}
 			}
 		}
@@ -886,9 +829,96 @@ USkeletalMesh* FglTFRuntimeParser::CreateSkeletalMeshFromLODs(TSharedRef<FglTFRu
 #endif
 		LodRenderData->MultiSizeIndexContainer.CreateIndexBuffer(NumIndices > MAX_uint16 ? sizeof(uint32) : sizeof(uint16));
 
-		for (int32 Index = 0; Index < NumIndices; Index++)
+		// index the identical vertices of each section (the vertex buffers, and so morph targets, are left untouched) and reorder them for the GPU
+		if (SkeletalMeshContext->SkeletalMeshConfig.bOptimizeVertexCache && TotalVertexIndex == NumIndices)
 		{
-			LodRenderData->MultiSizeIndexContainer.GetIndexBuffer()->AddItem(Index);
+			TArray<TArray<uint32>> SectionsIndices;
+			SectionsIndices.SetNum(LOD->Primitives.Num());
+
+			ParallelFor(LOD->Primitives.Num(), [&](const int32 PrimitiveIndex)
+				{
+					const FSkelMeshRenderSection& MeshSection = LodRenderData->RenderSections[PrimitiveIndex];
+					const TArray<uint32>& SourceIndices = LOD->Primitives[PrimitiveIndex].Indices;
+					TArray<uint32>& Indices = SectionsIndices[PrimitiveIndex];
+
+					Indices.AddUninitialized(SourceIndices.Num());
+
+					if ((SourceIndices.Num() % 3) != 0)
+					{
+						for (int32 VertexIndex = 0; VertexIndex < SourceIndices.Num(); VertexIndex++)
+						{
+							Indices[VertexIndex] = MeshSection.BaseVertexIndex + VertexIndex;
+						}
+						return;
+					}
+
+					auto IsSameVertex = [&](const int32 A, const int32 B)
+						{
+							const FStaticMeshVertexBuffer& StaticMeshVertexBuffer = LodRenderData->StaticVertexBuffers.StaticMeshVertexBuffer;
+							return StaticMeshVertexBuffer.VertexTangentX(A) == StaticMeshVertexBuffer.VertexTangentX(B) &&
+								StaticMeshVertexBuffer.VertexTangentY(A) == StaticMeshVertexBuffer.VertexTangentY(B) &&
+								StaticMeshVertexBuffer.VertexTangentZ(A) == StaticMeshVertexBuffer.VertexTangentZ(B) &&
+								FMemory::Memcmp(&InWeights[A], &InWeights[B], sizeof(FSkinWeightInfo)) == 0;
+						};
+
+					// only the vertices coming from the same glTF vertex are candidates (so they share position, uvs, colors and morph targets deltas),
+					// generated normals and tangents can still differ
+					TMap<uint32, int32> FirstVertexBySource;
+					TArray<int32> NextVertexWithSameSource;
+					TArray<int32> WeldedVertices;
+
+					for (int32 VertexIndex = 0; VertexIndex < SourceIndices.Num(); VertexIndex++)
+					{
+						int32* FirstVertex = FirstVertexBySource.Find(SourceIndices[VertexIndex]);
+						int32 WeldedIndex = INDEX_NONE;
+						for (int32 Candidate = FirstVertex ? *FirstVertex : INDEX_NONE; Candidate != INDEX_NONE; Candidate = NextVertexWithSameSource[Candidate])
+						{
+							if (IsSameVertex(MeshSection.BaseVertexIndex + WeldedVertices[Candidate], MeshSection.BaseVertexIndex + VertexIndex))
+							{
+								WeldedIndex = Candidate;
+								break;
+							}
+						}
+
+						if (WeldedIndex == INDEX_NONE)
+						{
+							WeldedIndex = WeldedVertices.Add(VertexIndex);
+							NextVertexWithSameSource.Add(FirstVertex ? *FirstVertex : INDEX_NONE);
+							FirstVertexBySource.Add(SourceIndices[VertexIndex], WeldedIndex);
+						}
+
+						Indices[VertexIndex] = WeldedIndex;
+					}
+
+					TArray<FVector> Positions;
+					Positions.AddUninitialized(WeldedVertices.Num());
+					for (int32 WeldedIndex = 0; WeldedIndex < WeldedVertices.Num(); WeldedIndex++)
+					{
+						Positions[WeldedIndex] = FVector(LodRenderData->StaticVertexBuffers.PositionVertexBuffer.VertexPosition(MeshSection.BaseVertexIndex + WeldedVertices[WeldedIndex]));
+					}
+
+					OptimizeTrianglesOrder(Indices, Positions);
+
+					for (uint32& Index : Indices)
+					{
+						Index = MeshSection.BaseVertexIndex + WeldedVertices[Index];
+					}
+				});
+
+			for (const TArray<uint32>& Indices : SectionsIndices)
+			{
+				for (const uint32 Index : Indices)
+				{
+					LodRenderData->MultiSizeIndexContainer.GetIndexBuffer()->AddItem(Index);
+				}
+			}
+		}
+		else
+		{
+			for (int32 Index = 0; Index < NumIndices; Index++)
+			{
+				LodRenderData->MultiSizeIndexContainer.GetIndexBuffer()->AddItem(Index);
+			}
 		}
 
 	}
@@ -950,6 +980,10 @@ USkeletalMesh* FglTFRuntimeParser::FinalizeSkeletalMeshWithLODs(TSharedRef<FglTF
 		{
 			LODInfo.ScreenSize = SkeletalMeshContext->SkeletalMeshConfig.LODScreenSize[LODIndex];
 		}
+		else if (SkeletalMeshContext->GeneratedLODScreenSize.Contains(LODIndex))
+		{
+			LODInfo.ScreenSize = SkeletalMeshContext->GeneratedLODScreenSize[LODIndex];
+		}
 
 #if WITH_EDITOR
 		ImportedResource->LODModels.Add(new FSkeletalMeshLODModel());
@@ -1226,6 +1260,67 @@ USkeletalMesh* FglTFRuntimeParser::FinalizeSkeletalMeshWithLODs(TSharedRef<FglTF
 	return SkeletalMeshContext->SkeletalMesh;
 }
 
+// derives the auto generated body shape from a bone box (no UObjects involved, so it can run on any thread)
+static void FitPhysicsAssetAutoBody(const FBox& Box, const FglTFRuntimePhysicsAssetAutoBodyConfig& AutoBodyConfig, FKAggregateGeom& AggGeom)
+{
+	FVector BoxCenter(0, 0, 0), BoxExtent(0, 0, 0);
+	Box.GetCenterAndExtents(BoxCenter, BoxExtent);
+
+	FTransform BoneTransform = FTransform::Identity;
+	BoneTransform.SetTranslation(BoxCenter);
+
+	const float CollisionScale = AutoBodyConfig.CollisionScale;
+
+	if (AutoBodyConfig.CollisionType == EglTFRuntimePhysicsAssetAutoBodyCollisionType::Capsule)
+	{
+		FKSphylElem Capsule;
+		// orient the capsule based on the longest axis
+		if (BoxExtent.X > BoxExtent.Z && BoxExtent.X > BoxExtent.Y)
+		{
+			Capsule.SetTransform(FTransform(FQuat(FVector(0, 1, 0), -PI * 0.5f)) * BoneTransform);
+			Capsule.Radius = FMath::Max(BoxExtent.Y, BoxExtent.Z) * CollisionScale;
+			Capsule.Length = BoxExtent.X * CollisionScale;
+
+		}
+		else if (BoxExtent.Y > BoxExtent.Z && BoxExtent.Y > BoxExtent.X)
+		{
+			Capsule.SetTransform(FTransform(FQuat(FVector(1, 0, 0), PI * 0.5f)) * BoneTransform);
+			Capsule.Radius = FMath::Max(BoxExtent.X, BoxExtent.Z) * CollisionScale;
+			Capsule.Length = BoxExtent.Y * CollisionScale;
+		}
+		else
+		{
+			Capsule.SetTransform(BoneTransform);
+
+			Capsule.Radius = FMath::Max(BoxExtent.X, BoxExtent.Y) * CollisionScale;
+			Capsule.Length = BoxExtent.Z * CollisionScale;
+		}
+
+		AggGeom.SphylElems.Add(Capsule);
+	}
+	else if (AutoBodyConfig.CollisionType == EglTFRuntimePhysicsAssetAutoBodyCollisionType::Sphere)
+	{
+		FKSphereElem Sphere;
+
+		Sphere.Center = BoneTransform.GetTranslation();
+		Sphere.Radius = BoxExtent.GetMax() * CollisionScale;
+
+		AggGeom.SphereElems.Add(Sphere);
+	}
+	else if (AutoBodyConfig.CollisionType == EglTFRuntimePhysicsAssetAutoBodyCollisionType::Box)
+	{
+		FKBoxElem BoxElem;
+
+		BoxElem.SetTransform(BoneTransform);
+
+		BoxElem.X = BoxExtent.X * 2.0f * CollisionScale;
+		BoxElem.Y = BoxExtent.Y * 2.0f * CollisionScale;
+		BoxElem.Z = BoxExtent.Z * 2.0f * CollisionScale;
+
+		AggGeom.BoxElems.Add(BoxElem);
+	}
+}
+
 void FglTFRuntimeParser::GeneratePhysicsAsset_Internal(FglTFRuntimeSkeletalMeshContextRef SkeletalMeshContext)
 {
 	if ((SkeletalMeshContext->SkeletalMeshConfig.PhysicsBodies.Num() == 0) && !SkeletalMeshContext->SkeletalMeshConfig.PhysicsAssetTemplate && !SkeletalMeshContext->SkeletalMeshConfig.bAutoGeneratePhysicsAssetBodies)
@@ -1269,95 +1364,50 @@ void FglTFRuntimeParser::GeneratePhysicsAsset_Internal(FglTFRuntimeSkeletalMeshC
 	if (SkeletalMeshContext->SkeletalMeshConfig.bAutoGeneratePhysicsAssetBodies)
 	{
 		const int32 NumBones = SkeletalMeshContext->GetNumBones();
-		TMap<int32, FBox> ValidBoneBoxes;
-
-		const float MinBoneSize = SkeletalMeshContext->SkeletalMeshConfig.PhysicsAssetAutoBodyConfig.MinBoneSize;
-
-		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
-		{
-			const FBox& Box = SkeletalMeshContext->GetBoneBox(BoneIndex);
-			if (Box.GetExtent().Size() >= MinBoneSize)
-			{
-				ValidBoneBoxes.Add(BoneIndex, Box);
-			}
-		}
+		const FglTFRuntimePhysicsAssetAutoBodyConfig& AutoBodyConfig = SkeletalMeshContext->SkeletalMeshConfig.PhysicsAssetAutoBodyConfig;
+		// the bounds filter could be a blueprint delegate, so filtered boxes get their shapes on this thread
+		const bool bFilterBoneBounds = SkeletalMeshContext->SkeletalMeshConfig.BoneBoundsFilter.Filter.IsBound();
 
-		for (const TPair<int32, FBox>& Pair : ValidBoneBoxes)
-		{
-			const int32 BoneIndex = Pair.Key;
-			FVector BoxCenter(0, 0, 0), BoxExtent(0, 0, 0);
-			const FBox& Box = Pair.Value;
+		// shapes are fitted in the same parallel pass of the boxes, only the body setups (UObjects) are created here
+		TArray<bool> ValidBones;
+		ValidBones.AddZeroed(NumBones);
+		TArray<FKAggregateGeom> BonesAggGeoms;
+		BonesAggGeoms.SetNum(NumBones);
 
-			if (SkeletalMeshContext->SkeletalMeshConfig.BoneBoundsFilter.Filter.IsBound())
+		SkeletalMeshContext->ParallelForEachBoneBox([&](const int32 BoneIndex, const FBox& Box)
 			{
-				const FBox BoxBounds = SkeletalMeshContext->SkeletalMeshConfig.BoneBoundsFilter.Filter.Execute(SkeletalMeshContext->GetBoneName(BoneIndex).ToString(), Box, SkeletalMeshContext->SkeletalMeshConfig.BoneBoundsFilter.Context);
-				BoxBounds.GetCenterAndExtents(BoxCenter, BoxExtent);
-			}
-			else
-			{
-				Box.GetCenterAndExtents(BoxCenter, BoxExtent);
-			}
-
-			USkeletalBodySetup* NewBodySetup = NewObject<USkeletalBodySetup>(PhysicsAsset, NAME_None, RF_Public);
-			NewBodySetup->CollisionTraceFlag = SkeletalMeshContext->SkeletalMeshConfig.PhysicsAssetAutoBodyConfig.CollisionTraceFlag;
-			NewBodySetup->PhysicsType = SkeletalMeshContext->SkeletalMeshConfig.PhysicsAssetAutoBodyConfig.PhysicsType;
-			NewBodySetup->BoneName = SkeletalMeshContext->GetBoneName(BoneIndex);
-			NewBodySetup->bConsiderForBounds = SkeletalMeshContext->SkeletalMeshConfig.PhysicsAssetAutoBodyConfig.bConsiderForBounds;
-
-			FTransform BoneTransform = FTransform::Identity;
-			BoneTransform.SetTranslation(BoxCenter);
-
-			const float CollisionScale = SkeletalMeshContext->SkeletalMeshConfig.PhysicsAssetAutoBodyConfig.CollisionScale;
-
-			if (SkeletalMeshContext->SkeletalMeshConfig.PhysicsAssetAutoBodyConfig.CollisionType == EglTFRuntimePhysicsAssetAutoBodyCollisionType::Capsule)
-			{
-				FKSphylElem Capsule;
-				// orient the capsule based on the longest axis
-				if (BoxExtent.X > BoxExtent.Z && BoxExtent.X > BoxExtent.Y)
-				{
-					Capsule.SetTransform(FTransform(FQuat(FVector(0, 1, 0), -PI * 0.5f)) * BoneTransform);
-					Capsule.Radius = FMath::Max(BoxExtent.Y, BoxExtent.Z) * CollisionScale;
-					Capsule.Length = BoxExtent.X * CollisionScale;
-
-				}
-				else if (BoxExtent.Y > BoxExtent.Z && BoxExtent.Y > BoxExtent.X)
+				if (BoneIndex >= NumBones || Box.GetExtent().Size() < AutoBodyConfig.MinBoneSize)
 				{
-					Capsule.SetTransform(FTransform(FQuat(FVector(1, 0, 0), PI * 0.5f)) * BoneTransform);
-					Capsule.Radius = FMath::Max(BoxExtent.X, BoxExtent.Z) * CollisionScale;
-					Capsule.Length = BoxExtent.Y * CollisionScale;
+					return;
 				}
-				else
-				{
-					Capsule.SetTransform(BoneTransform);
 
-					Capsule.Radius = FMath::Max(BoxExtent.X, BoxExtent.Y) * CollisionScale;
-					Capsule.Length = BoxExtent.Z * CollisionScale;
+				ValidBones[BoneIndex] = true;
+				if (!bFilterBoneBounds)
+				{
+					FitPhysicsAssetAutoBody(Box, AutoBodyConfig, BonesAggGeoms[BoneIndex]);
 				}
+			});
 
-				NewBodySetup->AggGeom.SphylElems.Add(Capsule);
-			}
-			else if (SkeletalMeshContext->SkeletalMeshConfig.PhysicsAssetAutoBodyConfig.CollisionType == EglTFRuntimePhysicsAssetAutoBodyCollisionType::Sphere)
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			if (!ValidBones[BoneIndex])
 			{
-				FKSphereElem Sphere;
-
-				Sphere.Center = BoneTransform.GetTranslation();
-				Sphere.Radius = BoxExtent.GetMax() * CollisionScale;
-
-				NewBodySetup->AggGeom.SphereElems.Add(Sphere);
+				continue;
 			}
-			else if (SkeletalMeshContext->SkeletalMeshConfig.PhysicsAssetAutoBodyConfig.CollisionType == EglTFRuntimePhysicsAssetAutoBodyCollisionType::Box)
-			{
-				FKBoxElem BoxElem;
-
-				BoxElem.SetTransform(BoneTransform);
-
-				BoxElem.X = BoxExtent.X * 2.0f * CollisionScale;
-				BoxElem.Y = BoxExtent.Y * 2.0f * CollisionScale;
-				BoxElem.Z = BoxExtent.Z * 2.0f * CollisionScale;
 
-				NewBodySetup->AggGeom.BoxElems.Add(BoxElem);
+			if (bFilterBoneBounds)
+			{
+				const FBox BoxBounds = SkeletalMeshContext->SkeletalMeshConfig.BoneBoundsFilter.Filter.Execute(SkeletalMeshContext->GetBoneName(BoneIndex).ToString(), SkeletalMeshContext->GetBoneBox(BoneIndex), SkeletalMeshContext->SkeletalMeshConfig.BoneBoundsFilter.Context);
+				FitPhysicsAssetAutoBody(BoxBounds, AutoBodyConfig, BonesAggGeoms[BoneIndex]);
 			}
 
+			USkeletalBodySetup* NewBodySetup = NewObject<USkeletalBodySetup>(PhysicsAsset, NAME_None, RF_Public);
+			NewBodySetup->CollisionTraceFlag = AutoBodyConfig.CollisionTraceFlag;
+			NewBodySetup->PhysicsType = AutoBodyConfig.PhysicsType;
+			NewBodySetup->BoneName = SkeletalMeshContext->GetBoneName(BoneIndex);
+			NewBodySetup->bConsiderForBounds = AutoBodyConfig.bConsiderForBounds;
+			NewBodySetup->AggGeom = MoveTemp(BonesAggGeoms[BoneIndex]);
+
 			PhysicsAsset->SkeletalBodySetups.Add(NewBodySetup);
 		}
 
@@ -1666,15 +1716,14 @@ USkeletalMesh* FglTFRuntimeParser::LoadSkeletalMesh(const int32 MeshIndex, const
 		return SkeletalMeshesCache[MeshIndex];
 	}
 
-	TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-	if (!JsonMeshObject)
+	if (!HasJsonRootObject("meshes", MeshIndex))
 	{
 		AddError("LoadSkeletalMesh()", FString::Printf(TEXT("Unable to find Mesh with index %d"), MeshIndex));
 		return nullptr;
 	}
 
 	FglTFRuntimeMeshLOD* LOD = nullptr;
-	if (!LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, SkeletalMeshConfig.MaterialsConfig))
+	if (!LoadMeshIntoMeshLOD(MeshIndex, LOD, SkeletalMeshConfig.MaterialsConfig))
 	{
 		return nullptr;
 	}
@@ -1713,15 +1762,14 @@ void FglTFRuntimeParser::LoadSkeletalMeshAsync(const int32 MeshIndex, const int3
 		{
 			FglTFRuntimeSkeletalMeshContextFinalizer AsyncFinalizer(SkeletalMeshContext, AsyncCallback);
 
-			TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-			if (!JsonMeshObject)
+			if (!HasJsonRootObject("meshes", MeshIndex))
 			{
 				AddError("LoadSkeletalMeshAsync()", FString::Printf(TEXT("Unable to find Mesh with index %d"), MeshIndex));
 				return;
 			}
 
 			FglTFRuntimeMeshLOD* LOD = nullptr;
-			if (!LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, SkeletalMeshContext->SkeletalMeshConfig.MaterialsConfig))
+			if (!LoadMeshIntoMeshLOD(MeshIndex, LOD, SkeletalMeshContext->SkeletalMeshConfig.MaterialsConfig))
 			{
 				return;
 			}
@@ -1739,15 +1787,14 @@ USkeletalMesh* FglTFRuntimeParser::LoadSkeletalMeshLODs(const TArray<int32>& Mes
 
 	for (const int32 MeshIndex : MeshIndices)
 	{
-		TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-		if (!JsonMeshObject)
+		if (!HasJsonRootObject("meshes", MeshIndex))
 		{
 			AddError("LoadSkeletalMesh()", FString::Printf(TEXT("Unable to find Mesh with index %d"), MeshIndex));
 			return nullptr;
 		}
 
 		FglTFRuntimeMeshLOD* LOD = nullptr;
-		if (!LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, SkeletalMeshConfig.MaterialsConfig))
+		if (!LoadMeshIntoMeshLOD(MeshIndex, LOD, SkeletalMeshConfig.MaterialsConfig))
 		{
 			return nullptr;
 		}
@@ -1814,23 +1861,24 @@ UAnimSequence* FglTFRuntimeParser::LoadSkeletalAnimationByName(USkeletalMesh* Sk
 		return nullptr;
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonAnimations;
-	if (!Root->TryGetArrayField("animations", JsonAnimations))
+	const int32 AnimationsNum = GetJsonRootArrayNum("animations");
+	if (AnimationsNum < 0)
 	{
 		AddError("LoadSkeletalAnimationByName()", "No animations defined in the asset.");
 		return nullptr;
 	}
 
-	for (int32 AnimationIndex = 0; AnimationIndex < JsonAnimations->Num(); AnimationIndex++)
+	for (int32 AnimationIndex = 0; AnimationIndex < AnimationsNum; AnimationIndex++)
 	{
-		TSharedPtr<FJsonObject> JsonAnimationObject = (*JsonAnimations)[AnimationIndex]->AsObject();
-		if (!JsonAnimationObject)
+		const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+		const int32 JsonAnimationNode = JsonTape->GetRootArrayItem("animations", AnimationIndex);
+		if (!JsonTape->IsObject(JsonAnimationNode))
 		{
 			return nullptr;
 		}
 
 		FString JsonAnimationName;
-		if (JsonAnimationObject->TryGetStringField("name", JsonAnimationName))
+		if (JsonTape->TryGetStringField(JsonAnimationNode, "name", JsonAnimationName))
 		{
 			if (JsonAnimationName == AnimationName)
 			{
@@ -1861,41 +1909,42 @@ UAnimSequence* FglTFRuntimeParser::LoadNodeSkeletalAnimation(USkeletalMesh* Skel
 	// this could be a static mesh read as a skeletal one...
 	if (Node.SkinIndex > INDEX_NONE)
 	{
-		TSharedPtr<FJsonObject> JsonSkinObject = GetJsonObjectFromRootIndex("skins", Node.SkinIndex);
-		if (!JsonSkinObject)
+		const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+		const int32 JsonSkinNode = JsonTape->GetRootArrayItem("skins", Node.SkinIndex);
+		if (!JsonTape->IsObject(JsonSkinNode))
 		{
 			AddError("LoadNodeSkeletalAnimation()", "No skins defined in the asset");
 			return nullptr;
 		}
 
-		const TArray<TSharedPtr<FJsonValue>>* JsonJoints;
-		if (!JsonSkinObject->TryGetArrayField("joints", JsonJoints))
+		const int32 JsonJointsNode = JsonTape->GetArrayField(JsonSkinNode, "joints");
+		if (JsonJointsNode == INDEX_NONE)
 		{
 			AddError("LoadNodeSkeletalAnimation()", "No joints defined in the skin");
 			return nullptr;
 		}
 
-		for (TSharedPtr<FJsonValue> JsonJoint : (*JsonJoints))
+		const int32 JointsNum = JsonTape->GetArrayNum(JsonJointsNode);
+		for (int32 JointIndex = 0; JointIndex < JointsNum; JointIndex++)
 		{
-			int64 JointIndex;
-			if (!JsonJoint->TryGetNumber(JointIndex))
+			int64 JointNodeIndex;
+			if (!JsonTape->TryGetNumber(JsonTape->GetArrayItem(JsonJointsNode, JointIndex), JointNodeIndex))
 			{
 				return nullptr;
 			}
-			Joints.Add(JointIndex);
+			Joints.Add(JointNodeIndex);
 		}
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonAnimations;
-	if (!Root->TryGetArrayField("animations", JsonAnimations))
+	const int32 AnimationsNum = GetJsonRootArrayNum("animations");
+	if (AnimationsNum < 0)
 	{
 		return nullptr;
 	}
 
-	for (int32 JsonAnimationIndex = 0; JsonAnimationIndex < JsonAnimations->Num(); JsonAnimationIndex++)
+	for (int32 JsonAnimationIndex = 0; JsonAnimationIndex < AnimationsNum; JsonAnimationIndex++)
 	{
-		TSharedPtr<FJsonObject> JsonAnimationObject = (*JsonAnimations)[JsonAnimationIndex]->AsObject();
-		if (!JsonAnimationObject)
+		if (!HasJsonRootObject("animations", JsonAnimationIndex))
 		{
 			return nullptr;
 		}
@@ -1903,7 +1952,7 @@ UAnimSequence* FglTFRuntimeParser::LoadNodeSkeletalAnimation(USkeletalMesh* Skel
 		TMap<FString, FRawAnimSequenceTrack> Tracks;
 		TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
 		bool bAnimationFound = false;
-		if (!LoadSkeletalAnimation_Internal(JsonAnimationObject.ToSharedRef(), Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig, [&Joints, &bAnimationFound, NodeIndex](const FglTFRuntimeNode& Node) -> bool
+		if (!LoadSkeletalAnimation_Internal(JsonAnimationIndex, Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig, [&Joints, &bAnimationFound, NodeIndex](const FglTFRuntimeNode& Node) -> bool
 			{
 				if (!bAnimationFound)
 				{
@@ -1933,8 +1982,7 @@ UAnimSequence* FglTFRuntimeParser::LoadSkeletalAnimation(USkeletalMesh* Skeletal
 		return nullptr;
 	}
 
-	TSharedPtr<FJsonObject> JsonAnimationObject = GetJsonObjectFromRootIndex("animations", AnimationIndex);
-	if (!JsonAnimationObject)
+	if (!HasJsonRootObject("animations", AnimationIndex))
 	{
 		AddError("LoadNodeSkeletalAnimation()", FString::Printf(TEXT("Unable to find animation %d"), AnimationIndex));
 		return nullptr;
@@ -1944,7 +1992,7 @@ UAnimSequence* FglTFRuntimeParser::LoadSkeletalAnimation(USkeletalMesh* Skeletal
 	TMap<FString, FRawAnimSequenceTrack> Tracks;
 
 	TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
-	if (!LoadSkeletalAnimation_Internal(JsonAnimationObject.ToSharedRef(), Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig, [](const FglTFRuntimeNode& Node) -> bool { return true; }))
+	if (!LoadSkeletalAnimation_Internal(AnimationIndex, Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig, [](const FglTFRuntimeNode& Node) -> bool { return true; }))
 	{
 		return nullptr;
 	}
@@ -2450,12 +2498,13 @@ UAnimSequence* FglTFRuntimeParser::CreateAnimationFromPose(USkeletalMesh* Skelet
 	TArray<int32> Joints;
 	if (SkinIndex > INDEX_NONE)
 	{
-		TSharedPtr<FJsonObject> SkinObject = GetJsonObjectFromRootIndex("skins", SkinIndex);
-		if (!SkinObject)
+		const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+		const int32 JsonSkinNode = JsonTape->GetRootArrayItem("skins", SkinIndex);
+		if (!JsonTape->IsObject(JsonSkinNode))
 		{
 			return nullptr;
 		}
-		if (!GetRootBoneIndex(SkinObject.ToSharedRef(), RootBoneIndex, Joints, FglTFRuntimeSkeletonConfig()))
+		if (!GetRootBoneIndex(*JsonTape, JsonSkinNode, RootBoneIndex, Joints, FglTFRuntimeSkeletonConfig()))
 		{
 			return nullptr;
 		}
@@ -2840,7 +2889,7 @@ FVector4 FglTFRuntimeParser::CubicSpline(const float TC, const float T0, const f
 	return CubicValue;
 }
 
-bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject> JsonAnimationObject, TMap<FString, FRawAnimSequenceTrack>& Tracks, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, float& Duration, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, TFunctionRef<bool(const FglTFRuntimeNode& Node)> Filter)
+bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(const int32 AnimationIndex, TMap<FString, FRawAnimSequenceTrack>& Tracks, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, float& Duration, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, TFunctionRef<bool(const FglTFRuntimeNode& Node)> Filter)
 {
 	TArray<FTransform> AnimWorldTransforms;
 	TArray<FTransform> RetargetWorldTransforms;
@@ -2852,8 +2901,7 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 	{
 		if (SkeletalAnimationConfig.RetargetSkinIndex > INDEX_NONE)
 		{
-			TSharedPtr<FJsonObject>	JsonSkinObject = GetJsonObjectFromRootIndex("skins", SkeletalAnimationConfig.RetargetSkinIndex);
-			if (!JsonSkinObject)
+			if (!HasJsonRootObject("skins", SkeletalAnimationConfig.RetargetSkinIndex))
 			{
 				AddError("LoadSkeletalAnimation_Internal()", "Unable to find retarget skin.");
 				return false;
@@ -2862,7 +2910,7 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 
 			TMap<int32, FName> AnimBoneMap;
 
-			if (!FillReferenceSkeleton(JsonSkinObject.ToSharedRef(), AnimRefSkeleton, AnimBoneMap, FglTFRuntimeSkeletonConfig()))
+			if (!FillReferenceSkeleton(SkeletalAnimationConfig.RetargetSkinIndex, AnimRefSkeleton, AnimBoneMap, FglTFRuntimeSkeletonConfig()))
 			{
 				AddError("LoadSkeletalAnimation_Internal()", "Unable to fill retarget RefSkeleton.");
 				return false;
@@ -2954,6 +3002,10 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 
 			float FrameDelta = 1.f / SkeletalAnimationConfig.FramesPerSecond;
 
+			const FMatrix SceneBasisInverse = SceneBasis.Inverse();
+			// frames are sampled in order, so each curve is walked only once
+			int32 FrameCursor = 0;
+
 			if (Path == "rotation" && !SkeletalAnimationConfig.bRemoveRotations)
 			{
 				if (Curve.Timeline.Num() != Curve.Values.Num())
@@ -2968,6 +3020,7 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 				}
 
 				FRawAnimSequenceTrack& Track = Tracks[TrackName];
+				Track.RotKeys.Reserve(Track.RotKeys.Num() + NumFrames);
 
 				for (int32 Frame = 0; Frame < NumFrames; Frame++)
 				{
@@ -2975,7 +3028,7 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 					FQuat AnimQuat;
 					int32 FirstIndex;
 					int32 SecondIndex;
-					float Alpha = FindBestFrames(Curve.Timeline, FrameBase, FirstIndex, SecondIndex);
+					float Alpha = FindBestFrames(Curve.Timeline, FrameBase, FirstIndex, SecondIndex, FrameCursor);
 					FVector4 FirstQuatV = Curve.Values[FirstIndex];
 					FVector4 SecondQuatV = Curve.Values[SecondIndex];
 					FQuat FirstQuat = FQuat(FirstQuatV.X, FirstQuatV.Y, FirstQuatV.Z, FirstQuatV.W).GetNormalized();
@@ -2988,21 +3041,21 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 
 						AnimQuat = { CubicValue.X, CubicValue.Y, CubicValue.Z, CubicValue.W };
 
-						FMatrix RotationMatrix = SceneBasis.Inverse() * FQuatRotationMatrix(AnimQuat.GetNormalized()) * SceneBasis;
+						FMatrix RotationMatrix = SceneBasisInverse * FQuatRotationMatrix(AnimQuat.GetNormalized()) * SceneBasis;
 
 						AnimQuat = RotationMatrix.ToQuat();
 					}
 					else if (FirstIndex == SecondIndex)
 					{
-						FMatrix RotationMatrix = SceneBasis.Inverse() * FQuatRotationMatrix(FirstQuat) * SceneBasis;
+						FMatrix RotationMatrix = SceneBasisInverse * FQuatRotationMatrix(FirstQuat) * SceneBasis;
 
 						AnimQuat = RotationMatrix.ToQuat();
 					}
 					else
 					{
 
-						FMatrix FirstMatrix = SceneBasis.Inverse() * FQuatRotationMatrix(FirstQuat) * SceneBasis;
-						FMatrix SecondMatrix = SceneBasis.Inverse() * FQuatRotationMatrix(SecondQuat) * SceneBasis;
+						FMatrix FirstMatrix = SceneBasisInverse * FQuatRotationMatrix(FirstQuat) * SceneBasis;
+						FMatrix SecondMatrix = SceneBasisInverse * FQuatRotationMatrix(SecondQuat) * SceneBasis;
 						FirstQuat = FirstMatrix.ToQuat();
 						SecondQuat = SecondMatrix.ToQuat();
 						AnimQuat = FQuat::Slerp(FirstQuat, SecondQuat, Alpha);
@@ -3073,6 +3126,7 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 				}
 
 				FRawAnimSequenceTrack& Track = Tracks[TrackName];
+				Track.PosKeys.Reserve(Track.PosKeys.Num() + NumFrames);
 
 				for (int32 Frame = 0; Frame < NumFrames; Frame++)
 				{
@@ -3080,7 +3134,7 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 					FVector AnimLocation;
 					int32 FirstIndex;
 					int32 SecondIndex;
-					float Alpha = FindBestFrames(Curve.Timeline, FrameBase, FirstIndex, SecondIndex);
+					float Alpha = FindBestFrames(Curve.Timeline, FrameBase, FirstIndex, SecondIndex, FrameCursor);
 					FVector4 First = Curve.Values[FirstIndex];
 					FVector4 Second = Curve.Values[SecondIndex];
 
@@ -3167,19 +3221,20 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 				}
 
 				FRawAnimSequenceTrack& Track = Tracks[TrackName];
+				Track.ScaleKeys.Reserve(Track.ScaleKeys.Num() + NumFrames);
 
 				for (int32 Frame = 0; Frame < NumFrames; Frame++)
 				{
 					const float FrameBase = FrameDelta * Frame;
 					int32 FirstIndex;
 					int32 SecondIndex;
-					float Alpha = FindBestFrames(Curve.Timeline, FrameBase, FirstIndex, SecondIndex);
+					float Alpha = FindBestFrames(Curve.Timeline, FrameBase, FirstIndex, SecondIndex, FrameCursor);
 					FVector4 First = Curve.Values[FirstIndex];
 					FVector4 Second = Curve.Values[SecondIndex];
 #if ENGINE_MAJOR_VERSION > 4
-					Track.ScaleKeys.Add(FVector3f((SceneBasis.Inverse() * FScaleMatrix(FMath::Lerp(First, Second, Alpha)) * SceneBasis).ExtractScaling()));
+					Track.ScaleKeys.Add(FVector3f((SceneBasisInverse * FScaleMatrix(FMath::Lerp(First, Second, Alpha)) * SceneBasis).ExtractScaling()));
 #else
-					Track.ScaleKeys.Add((SceneBasis.Inverse() * FScaleMatrix(FMath::Lerp(First, Second, Alpha)) * SceneBasis).ExtractScaling());
+					Track.ScaleKeys.Add((SceneBasisInverse * FScaleMatrix(FMath::Lerp(First, Second, Alpha)) * SceneBasis).ExtractScaling());
 #endif
 				}
 			}
@@ -3214,7 +3269,7 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 		};
 
 	FString IgnoredName;
-	return LoadAnimation_Internal(JsonAnimationObject, Duration, IgnoredName, Callback, Filter, SkeletalAnimationConfig.OverrideTrackNameFromExtension);
+	return LoadAnimation_Internal(AnimationIndex, Duration, IgnoredName, Callback, Filter, SkeletalAnimationConfig.OverrideTrackNameFromExtension);
 }
 
 
@@ -3300,8 +3355,7 @@ bool FglTFRuntimeParser::LoadSkinnedMeshRecursiveAsRuntimeLOD(const FString& Nod
 		}
 		if (ChildNode.MeshIndex > INDEX_NONE)
 		{
-			TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", ChildNode.MeshIndex);
-			if (!JsonMeshObject)
+			if (!HasJsonRootObject("meshes", ChildNode.MeshIndex))
 			{
 				AddError("LoadSkinnedMeshRecursiveAsRuntimeLOD()", FString::Printf(TEXT("Unable to find Mesh with index %d"), ChildNode.MeshIndex));
 				return false;
@@ -3311,7 +3365,7 @@ bool FglTFRuntimeParser::LoadSkinnedMeshRecursiveAsRuntimeLOD(const FString& Nod
 			int32 PrimitiveFirstIndex = RuntimeLOD.Primitives.Num();
 
 			FglTFRuntimeMeshLOD* LOD = nullptr;
-			if (!LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, MaterialsConfig))
+			if (!LoadMeshIntoMeshLOD(ChildNode.MeshIndex, LOD, MaterialsConfig))
 			{
 				return false;
 			}
@@ -3325,14 +3379,13 @@ bool FglTFRuntimeParser::LoadSkinnedMeshRecursiveAsRuntimeLOD(const FString& Nod
 			{
 				FReferenceSkeleton FakeRefSkeleton;
 
-				TSharedPtr<FJsonObject> JsonSkinObject = GetJsonObjectFromRootIndex("skins", ChildNode.SkinIndex);
-				if (!JsonSkinObject)
+				if (!HasJsonRootObject("skins", ChildNode.SkinIndex))
 				{
 					AddError("LoadSkinnedMeshRecursiveAsRuntimeLOD()", FString::Printf(TEXT("Unable to fill skin %d"), ChildNode.SkinIndex));
 					return false;
 				}
 
-				if (!FillReferenceSkeleton(JsonSkinObject.ToSharedRef(), FakeRefSkeleton, BoneMap, SkeletonConfig))
+				if (!FillReferenceSkeleton(ChildNode.SkinIndex, FakeRefSkeleton, BoneMap, SkeletonConfig))
 				{
 					AddError("LoadSkinnedMeshRecursiveAsRuntimeLOD()", "Unable to fill RefSkeleton.");
 					return false;
@@ -3603,6 +3656,11 @@ USkeletalMesh* FglTFRuntimeParser::LoadSkeletalMeshFromRuntimeLODs(const TArray<
 
 const FBox& FglTFRuntimeSkeletalMeshContext::GetBoneBox(const int32 BoneIndex)
 {
+	if (!bPerBoneBoundingBoxCached)
+	{
+		BuildBoneBoxes();
+	}
+
 	if (PerBoneBoundingBoxCache.Contains(BoneIndex))
 	{
 		return PerBoneBoundingBoxCache[BoneIndex];
@@ -3610,33 +3668,121 @@ const FBox& FglTFRuntimeSkeletalMeshContext::GetBoneBox(const int32 BoneIndex)
 
 	FBox& Box = PerBoneBoundingBoxCache.Add(BoneIndex);
 	Box.Init();
+	return Box;
+}
 
-	const FSkeletalMeshLODRenderData& LOD0 = SkeletalMesh->GetResourceForRendering()->LODRenderData[0];
-	const uint32 NumVertices = LOD0.GetNumVertices();
-	for (uint32 Index = 0; Index < NumVertices; Index++)
+void FglTFRuntimeSkeletalMeshContext::BuildBoneBoxes()
+{
+	BuildBoneBoxes([](const int32 BoneIndex, const FBox& Box) {});
+}
+
+void FglTFRuntimeSkeletalMeshContext::ParallelForEachBoneBox(TFunctionRef<void(const int32 BoneIndex, const FBox& Box)> BoneBoxFitted)
+{
+	if (!bPerBoneBoundingBoxCached)
 	{
-		const uint32 VertexIndex = LOD0.MultiSizeIndexContainer.GetIndexBuffer()->Get(Index);
+		BuildBoneBoxes(BoneBoxFitted);
+		return;
+	}
 
-		const uint32 MaxBoneInfluences = LOD0.SkinWeightVertexBuffer.GetMaxBoneInfluences();
+	ParallelFor(GetNumBones(), [&](const int32 BoneIndex)
+		{
+			if (const FBox* Box = PerBoneBoundingBoxCache.Find(BoneIndex))
+			{
+				BoneBoxFitted(BoneIndex, *Box);
+			}
+			else
+			{
+				BoneBoxFitted(BoneIndex, FBox(ForceInit));
+			}
+		});
+}
 
-		int32 BestBoneIndex = INDEX_NONE;
-		uint16 BestWeight = 0;
-		for (uint32 InfluenceIndex = 0; InfluenceIndex < MaxBoneInfluences; InfluenceIndex++)
+void FglTFRuntimeSkeletalMeshContext::BuildBoneBoxes(TFunctionRef<void(const int32 BoneIndex, const FBox& Box)> BoneBoxFitted)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeSkeletalMeshContext_BuildBoneBoxes, FColor::Magenta);
+
+	bPerBoneBoundingBoxCached = true;
+
+	const int32 NumBones = GetNumBones();
+	const FSkeletalMeshLODRenderData& LOD0 = SkeletalMesh->GetResourceForRendering()->LODRenderData[0];
+	const int32 NumVertices = static_cast<int32>(LOD0.GetNumVertices());
+	const uint32 MaxBoneInfluences = LOD0.SkinWeightVertexBuffer.GetMaxBoneInfluences();
+
+	// first pass: assign every vertex to its most influential bone
+	TArray<uint32> VerticesIndices;
+	TArray<int32> VerticesBones;
+	VerticesIndices.AddUninitialized(NumVertices);
+	VerticesBones.AddUninitialized(NumVertices);
+
+	ParallelFor(NumVertices, [&](const int32 Index)
 		{
-			const uint32 VertexBoneIndex = LOD0.SkinWeightVertexBuffer.GetBoneIndex(VertexIndex, InfluenceIndex);
-			const uint16 VertexBoneWeight = LOD0.SkinWeightVertexBuffer.GetBoneWeight(VertexIndex, InfluenceIndex);
-			if (VertexBoneWeight > BestWeight)
+			const uint32 VertexIndex = LOD0.MultiSizeIndexContainer.GetIndexBuffer()->Get(Index);
+
+			int32 BestBoneIndex = INDEX_NONE;
+			uint16 BestWeight = 0;
+			for (uint32 InfluenceIndex = 0; InfluenceIndex < MaxBoneInfluences; InfluenceIndex++)
 			{
-				BestBoneIndex = VertexBoneIndex;
-				BestWeight = VertexBoneWeight;
+				const uint32 VertexBoneIndex = LOD0.SkinWeightVertexBuffer.GetBoneIndex(VertexIndex, InfluenceIndex);
+				const uint16 VertexBoneWeight = LOD0.SkinWeightVertexBuffer.GetBoneWeight(VertexIndex, InfluenceIndex);
+				if (VertexBoneWeight > BestWeight)
+				{
+					BestBoneIndex = VertexBoneIndex;
+					BestWeight = VertexBoneWeight;
+				}
 			}
+
+			VerticesIndices[Index] = VertexIndex;
+			VerticesBones[Index] = BestBoneIndex;
+		});
+
+	// bucket the vertices by bone (preserving their order)
+	TArray<int32> BonesOffsets;
+	BonesOffsets.AddZeroed(NumBones + 1);
+	for (const int32 BoneIndex : VerticesBones)
+	{
+		if (BoneIndex > INDEX_NONE && BoneIndex < NumBones)
+		{
+			BonesOffsets[BoneIndex + 1]++;
 		}
+	}
+
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+	{
+		BonesOffsets[BoneIndex + 1] += BonesOffsets[BoneIndex];
+	}
 
-		if (BestBoneIndex == BoneIndex)
+	TArray<uint32> BonesVertices;
+	BonesVertices.AddUninitialized(BonesOffsets[NumBones]);
+	TArray<int32> BonesFill = BonesOffsets;
+	for (int32 Index = 0; Index < NumVertices; Index++)
+	{
+		const int32 BoneIndex = VerticesBones[Index];
+		if (BoneIndex > INDEX_NONE && BoneIndex < NumBones)
 		{
-			Box += FVector(SkeletalMesh->GetRefBasesInvMatrix()[BoneIndex].TransformPosition(LOD0.StaticVertexBuffers.PositionVertexBuffer.VertexPosition(VertexIndex)));
+			BonesVertices[BonesFill[BoneIndex]++] = VerticesIndices[Index];
 		}
 	}
 
-	return PerBoneBoundingBoxCache[BoneIndex];
+	// second pass: fit the boxes in bone space, each bone only reads its own bucket
+	TArray<FBox> BonesBoxes;
+	BonesBoxes.AddUninitialized(NumBones);
+
+	const auto& RefBasesInvMatrix = SkeletalMesh->GetRefBasesInvMatrix();
+	ParallelFor(NumBones, [&](const int32 BoneIndex)
+		{
+			FBox Box;
+			Box.Init();
+			for (int32 BucketIndex = BonesOffsets[BoneIndex]; BucketIndex < BonesOffsets[BoneIndex + 1]; BucketIndex++)
+			{
+				Box += FVector(RefBasesInvMatrix[BoneIndex].TransformPosition(LOD0.StaticVertexBuffers.PositionVertexBuffer.VertexPosition(BonesVertices[BucketIndex])));
+			}
+			BonesBoxes[BoneIndex] = Box;
+			BoneBoxFitted(BoneIndex, Box);
+		});
+
+	PerBoneBoundingBoxCache.Reserve(NumBones);
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+	{
+		PerBoneBoundingBoxCache.Add(BoneIndex, BonesBoxes[BoneIndex]);
+	}
 }
\ No newline at end of file
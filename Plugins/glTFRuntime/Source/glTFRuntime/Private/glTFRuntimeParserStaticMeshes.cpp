@@ -1,11 +1,13 @@
 // Copyright 2020-2022, Roberto De Ioris.
 
 #include "glTFRuntimeParser.h"
+#include "Async/ParallelFor.h"
 #include "MeshDescription.h"
 #include "StaticMeshAttributes.h"
 #include "StaticMeshOperations.h"
 #include "Engine/StaticMeshSocket.h"
 #include "Engine/World.h"
+#include "Misc/ScopeLock.h"
 #if WITH_EDITOR
 #include "Editor/EditorEngine.h"
 #endif
@@ -48,11 +50,16 @@ FglTFRuntimeStaticMeshContext::FglTFRuntimeStaticMeshContext(TSharedRef<FglTFRun
 
 
 void FglTFRuntimeParser::LoadStaticMeshAsync(const int32 MeshIndex, const FglTFRuntimeStaticMeshAsync& AsyncCallback, const FglTFRuntimeStaticMeshConfig& StaticMeshConfig)
+{
+	LoadStaticMeshAsync(MeshIndex, [AsyncCallback](UStaticMesh* StaticMesh) { AsyncCallback.ExecuteIfBound(StaticMesh); }, StaticMeshConfig);
+}
+
+void FglTFRuntimeParser::LoadStaticMeshAsync(const int32 MeshIndex, TFunction<void(UStaticMesh*)> AsyncCallback, const FglTFRuntimeStaticMeshConfig& StaticMeshConfig)
 {
 	// first check cache
 	if (CanReadFromCache(StaticMeshConfig.CacheMode) && StaticMeshesCache.Contains(MeshIndex))
 	{
-		AsyncCallback.ExecuteIfBound(StaticMeshesCache[MeshIndex]);
+		AsyncCallback(StaticMeshesCache[MeshIndex]);
 		return;
 	}
 
@@ -61,12 +68,11 @@ void FglTFRuntimeParser::LoadStaticMeshAsync(const int32 MeshIndex, const FglTFR
 	Async(EAsyncExecution::Thread, [this, StaticMeshContext, MeshIndex, AsyncCallback]()
 		{
 
-			TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-			if (JsonMeshObject)
+			if (HasJsonRootObject("meshes", MeshIndex))
 			{
 
 				FglTFRuntimeMeshLOD* LOD = nullptr;
-				if (LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, StaticMeshContext->StaticMeshConfig.MaterialsConfig))
+				if (LoadMeshIntoMeshLOD(MeshIndex, LOD, StaticMeshContext->StaticMeshConfig.MaterialsConfig))
 				{
 					StaticMeshContext->LODs.Add(LOD);
 
@@ -89,7 +95,7 @@ void FglTFRuntimeParser::LoadStaticMeshAsync(const int32 MeshIndex, const FglTFR
 						}
 					}
 
-					AsyncCallback.ExecuteIfBound(StaticMeshContext->StaticMesh);
+					AsyncCallback(StaticMeshContext->StaticMesh);
 				}, TStatId(), nullptr, ENamedThreads::GameThread);
 			FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
 		});
@@ -101,6 +107,20 @@ UStaticMesh* FglTFRuntimeParser::LoadStaticMesh_Internal(TSharedRef<FglTFRuntime
 
 	OnPreCreatedStaticMesh.Broadcast(StaticMeshContext);
 
+	if (StaticMeshContext->StaticMeshConfig.AutoLODsTrianglesRatios.Num() > 0 && StaticMeshContext->LODs.Num() == 1)
+	{
+		TArray<FglTFRuntimeMeshLOD> GeneratedLODs;
+		TArray<float> GeneratedScreenSizes;
+		if (GenerateSimplifiedLODs(*StaticMeshContext->LODs[0], StaticMeshContext->StaticMeshConfig.AutoLODsTrianglesRatios, StaticMeshContext->StaticMeshConfig.AutoLODsPixelError, GeneratedLODs, GeneratedScreenSizes))
+		{
+			for (int32 GeneratedLODIndex = 0; GeneratedLODIndex < GeneratedLODs.Num(); GeneratedLODIndex++)
+			{
+				StaticMeshContext->AddContextLOD() = MoveTemp(GeneratedLODs[GeneratedLODIndex]);
+				StaticMeshContext->GeneratedLODScreenSize.Add(StaticMeshContext->LODs.Num() - 1, GeneratedScreenSizes[GeneratedLODIndex]);
+			}
+		}
+	}
+
 	UStaticMesh* StaticMesh = StaticMeshContext->StaticMesh;
 	FStaticMeshRenderData* RenderData = StaticMeshContext->RenderData;
 	const FglTFRuntimeStaticMeshConfig& StaticMeshConfig = StaticMeshContext->StaticMeshConfig;
@@ -304,35 +324,25 @@ UStaticMesh* FglTFRuntimeParser::LoadStaticMesh_Internal(TSharedRef<FglTFRuntime
 
 			const bool bCanGenerateNormals = (bMissingNormals && StaticMeshConfig.NormalsGenerationStrategy == EglTFRuntimeNormalsGenerationStrategy::IfMissing) ||
 				StaticMeshConfig.NormalsGenerationStrategy == EglTFRuntimeNormalsGenerationStrategy::Always;
+			bool bGeneratedNormals = false;
 			if (bCanGenerateNormals && (NumVertexInstancesPerSection % 3) == 0)
 			{
-				for (int32 VertexInstanceSectionIndex = 0; VertexInstanceSectionIndex < NumVertexInstancesPerSection; VertexInstanceSectionIndex += 3)
+				TArray<FVector3f> Positions;
+				Positions.SetNumUninitialized(NumVertexInstancesPerSection);
+				for (int32 VertexInstanceSectionIndex = 0; VertexInstanceSectionIndex < NumVertexInstancesPerSection; VertexInstanceSectionIndex++)
 				{
-					FStaticMeshBuildVertex& StaticMeshVertex0 = StaticMeshBuildVertices[VertexInstanceBaseIndex + VertexInstanceSectionIndex];
-					FStaticMeshBuildVertex& StaticMeshVertex1 = StaticMeshBuildVertices[VertexInstanceBaseIndex + VertexInstanceSectionIndex + 1];
-					FStaticMeshBuildVertex& StaticMeshVertex2 = StaticMeshBuildVertices[VertexInstanceBaseIndex + VertexInstanceSectionIndex + 2];
-
-#if ENGINE_MAJOR_VERSION > 4
-					FVector SideA = FVector(StaticMeshVertex1.Position - StaticMeshVertex0.Position);
-					FVector SideB = FVector(StaticMeshVertex2.Position - StaticMeshVertex0.Position);
-					FVector NormalFromCross = FVector::CrossProduct(SideB, SideA).GetSafeNormal();
-
-					StaticMeshVertex0.TangentZ = FVector3f(NormalFromCross);
-					StaticMeshVertex1.TangentZ = FVector3f(NormalFromCross);
-					StaticMeshVertex2.TangentZ = FVector3f(NormalFromCross);
-#else
-					FVector SideA = StaticMeshVertex1.Position - StaticMeshVertex0.Position;
-					FVector SideB = StaticMeshVertex2.Position - StaticMeshVertex0.Position;
-					FVector NormalFromCross = FVector::CrossProduct(SideB, SideA).GetSafeNormal();
-
-					StaticMeshVertex0.TangentZ = NormalFromCross;
-					StaticMeshVertex1.TangentZ = NormalFromCross;
-					StaticMeshVertex2.TangentZ = NormalFromCross;
-#endif
+					Positions[VertexInstanceSectionIndex] = StaticMeshBuildVertices[VertexInstanceBaseIndex + VertexInstanceSectionIndex].Position;
+				}
 
+				TArray<FVector3f> Normals;
+				GenerateFlatNormals(Positions, Normals);
 
+				for (int32 VertexInstanceSectionIndex = 0; VertexInstanceSectionIndex < NumVertexInstancesPerSection; VertexInstanceSectionIndex++)
+				{
+					StaticMeshBuildVertices[VertexInstanceBaseIndex + VertexInstanceSectionIndex].TangentZ = Normals[VertexInstanceSectionIndex];
 				}
 				bMissingNormals = false;
+				bGeneratedNormals = true;
 			}
 
 			const bool bCanGenerateTangents = (bMissingTangents && StaticMeshConfig.TangentsGenerationStrategy == EglTFRuntimeTangentsGenerationStrategy::IfMissing) ||
@@ -340,92 +350,159 @@ UStaticMesh* FglTFRuntimeParser::LoadStaticMesh_Internal(TSharedRef<FglTFRuntime
 			// recompute tangents if required (need normals and uvs)
 			if (bCanGenerateTangents && !bMissingNormals && Primitive.UVs.Num() > 0 && (NumVertexInstancesPerSection % 3) == 0)
 			{
-				for (int32 VertexInstanceSectionIndex = 0; VertexInstanceSectionIndex < NumVertexInstancesPerSection; VertexInstanceSectionIndex += 3)
+				TArray<FVector3f> Positions;
+				TArray<FVector3f> Normals;
+				TArray<FVector2f> UVs;
+				TArray<uint32> Keys;
+				Positions.SetNumUninitialized(NumVertexInstancesPerSection);
+				Normals.SetNumUninitialized(NumVertexInstancesPerSection);
+				UVs.SetNumUninitialized(NumVertexInstancesPerSection);
+				Keys.SetNumUninitialized(NumVertexInstancesPerSection);
+
+				for (int32 VertexInstanceSectionIndex = 0; VertexInstanceSectionIndex < NumVertexInstancesPerSection; VertexInstanceSectionIndex++)
 				{
-					FStaticMeshBuildVertex& StaticMeshVertex0 = StaticMeshBuildVertices[VertexInstanceBaseIndex + VertexInstanceSectionIndex];
-					FStaticMeshBuildVertex& StaticMeshVertex1 = StaticMeshBuildVertices[VertexInstanceBaseIndex + VertexInstanceSectionIndex + 1];
-					FStaticMeshBuildVertex& StaticMeshVertex2 = StaticMeshBuildVertices[VertexInstanceBaseIndex + VertexInstanceSectionIndex + 2];
-
-
-#if ENGINE_MAJOR_VERSION > 4
-					FVector Position0 = FVector(StaticMeshVertex0.Position);
-					FVector4 TangentZ0 = FVector(StaticMeshVertex0.TangentZ);
-					FVector2D UV0 = FVector2D(StaticMeshVertex0.UVs[0]);
-#else
-					FVector Position0 = StaticMeshVertex0.Position;
-					FVector4 TangentZ0 = StaticMeshVertex0.TangentZ;
-					FVector2D UV0 = StaticMeshVertex0.UVs[0];
-#endif
-
+					const FStaticMeshBuildVertex& StaticMeshVertex = StaticMeshBuildVertices[VertexInstanceBaseIndex + VertexInstanceSectionIndex];
+					Positions[VertexInstanceSectionIndex] = StaticMeshVertex.Position;
+					Normals[VertexInstanceSectionIndex] = StaticMeshVertex.TangentZ;
+					UVs[VertexInstanceSectionIndex] = StaticMeshVertex.UVs[0];
+
+					// the corners of the same source vertex are welded (unless the flat normals made them different)
+					int32 SourceVertexInstanceSectionIndex = VertexInstanceSectionIndex;
+					if (StaticMeshConfig.bReverseWinding && (VertexInstanceSectionIndex % 3) > 0)
+					{
+						SourceVertexInstanceSectionIndex += (VertexInstanceSectionIndex % 3) == 1 ? 1 : -1;
+					}
+					const uint32 VertexIndex = Primitive.Indices[SourceVertexInstanceSectionIndex];
+					const bool bWeld = !bGeneratedNormals && VertexIndex < static_cast<uint32>(Primitive.Positions.Num());
+					Keys[VertexInstanceSectionIndex] = bWeld ? VertexIndex : Primitive.Positions.Num() + VertexInstanceSectionIndex;
+				}
 
+				TArray<FVector4f> Tangents;
+				LoadOrGenerateTangents(Positions, Normals, UVs, Keys, Tangents);
 
-#if ENGINE_MAJOR_VERSION > 4
-					FVector Position1 = FVector(StaticMeshVertex1.Position);
-					FVector4 TangentZ1 = FVector(StaticMeshVertex1.TangentZ);
-					FVector2D UV1 = FVector2D(StaticMeshVertex1.UVs[0]);
-#else
-					FVector Position1 = StaticMeshVertex1.Position;
-					FVector4 TangentZ1 = StaticMeshVertex1.TangentZ;
-					FVector2D UV1 = StaticMeshVertex1.UVs[0];
-#endif
+				for (int32 VertexInstanceSectionIndex = 0; VertexInstanceSectionIndex < NumVertexInstancesPerSection; VertexInstanceSectionIndex++)
+				{
+					FStaticMeshBuildVertex& StaticMeshVertex = StaticMeshBuildVertices[VertexInstanceBaseIndex + VertexInstanceSectionIndex];
+					StaticMeshVertex.TangentX = FVector3f(Tangents[VertexInstanceSectionIndex]);
+					StaticMeshVertex.TangentY = FVector3f(ComputeTangentYWithW(FVector(StaticMeshVertex.TangentZ), FVector(StaticMeshVertex.TangentX), Tangents[VertexInstanceSectionIndex].W * TangentsDirection));
+				}
+			}
 
+			VertexInstanceBaseIndex += NumVertexInstancesPerSection;
+		}
 
+		// weld the identical vertex instances of each section and reorder them for the GPU
+		if (StaticMeshConfig.bOptimizeVertexCache && Sections.Num() == LOD->Primitives.Num())
+		{
+			TArray<TArray<FStaticMeshBuildVertex>> SectionsVertices;
+			SectionsVertices.SetNum(Sections.Num());
+			TArray<TArray<uint32>> SectionsIndices;
+			SectionsIndices.SetNum(Sections.Num());
 
-#if ENGINE_MAJOR_VERSION > 4
-					FVector Position2 = FVector(StaticMeshVertex2.Position);
-					FVector4 TangentZ2 = FVector(StaticMeshVertex2.TangentZ);
-					FVector2D UV2 = FVector2D(StaticMeshVertex2.UVs[0]);
-#else
-					FVector Position2 = StaticMeshVertex2.Position;
-					FVector4 TangentZ2 = StaticMeshVertex2.TangentZ;
-					FVector2D UV2 = StaticMeshVertex2.UVs[0];
-#endif
+			ParallelFor(Sections.Num(), [&](const int32 SectionIndex)
+				{
+					const FStaticMeshSection& Section = Sections[SectionIndex];
+					const int32 NumVertexInstancesPerSection = LOD->Primitives[SectionIndex].Indices.Num();
+					TArray<FStaticMeshBuildVertex>& Vertices = SectionsVertices[SectionIndex];
+					TArray<uint32>& Indices = SectionsIndices[SectionIndex];
 
+					Indices.AddUninitialized(NumVertexInstancesPerSection);
 
-					FVector DeltaPosition0 = Position1 - Position0;
-					FVector DeltaPosition1 = Position2 - Position0;
+					if ((NumVertexInstancesPerSection % 3) != 0)
+					{
+						Vertices.Append(&StaticMeshBuildVertices[Section.FirstIndex], NumVertexInstancesPerSection);
+						for (int32 VertexInstanceSectionIndex = 0; VertexInstanceSectionIndex < NumVertexInstancesPerSection; VertexInstanceSectionIndex++)
+						{
+							Indices[VertexInstanceSectionIndex] = VertexInstanceSectionIndex;
+						}
+						return;
+					}
 
-					FVector2D DeltaUV0 = UV1 - UV0;
-					FVector2D DeltaUV1 = UV2 - UV0;
+					auto IsSameVertex = [NumUVs, bHasVertexColors](const FStaticMeshBuildVertex& A, const FStaticMeshBuildVertex& B)
+						{
+							if (A.Position != B.Position || A.TangentX != B.TangentX || A.TangentY != B.TangentY || A.TangentZ != B.TangentZ || (bHasVertexColors && A.Color != B.Color))
+							{
+								return false;
+							}
+							for (int32 UVIndex = 0; UVIndex < NumUVs; UVIndex++)
+							{
+								if (A.UVs[UVIndex] != B.UVs[UVIndex])
+								{
+									return false;
+								}
+							}
+							return true;
+						};
+
+					// vertices are bucketed by position, a bucket is a linked list of candidates
+					TMap<uint32, int32> FirstVertexByPosition;
+					TArray<int32> NextVertexWithSamePosition;
+
+					for (int32 VertexInstanceSectionIndex = 0; VertexInstanceSectionIndex < NumVertexInstancesPerSection; VertexInstanceSectionIndex++)
+					{
+						const FStaticMeshBuildVertex& StaticMeshVertex = StaticMeshBuildVertices[Section.FirstIndex + VertexInstanceSectionIndex];
+						const uint32 PositionHash = FCrc::MemCrc32(&StaticMeshVertex.Position, sizeof(StaticMeshVertex.Position));
 
-					float Factor = 1.0f / (DeltaUV0.X * DeltaUV1.Y - DeltaUV0.Y * DeltaUV1.X);
+						int32* FirstVertex = FirstVertexByPosition.Find(PositionHash);
+						int32 WeldedIndex = INDEX_NONE;
+						for (int32 Candidate = FirstVertex ? *FirstVertex : INDEX_NONE; Candidate != INDEX_NONE; Candidate = NextVertexWithSamePosition[Candidate])
+						{
+							if (IsSameVertex(Vertices[Candidate], StaticMeshVertex))
+							{
+								WeldedIndex = Candidate;
+								break;
+							}
+						}
 
-					FVector TriangleTangentX = ((DeltaPosition0 * DeltaUV1.Y) - (DeltaPosition1 * DeltaUV0.Y)) * Factor;
-					FVector TriangleTangentY = ((DeltaPosition0 * DeltaUV1.X) - (DeltaPosition1 * DeltaUV0.X)) * Factor;
+						if (WeldedIndex == INDEX_NONE)
+						{
+							WeldedIndex = Vertices.Add(StaticMeshVertex);
+							NextVertexWithSamePosition.Add(FirstVertex ? *FirstVertex : INDEX_NONE);
+							FirstVertexByPosition.Add(PositionHash, WeldedIndex);
+						}
 
-					FVector TangentX0 = TriangleTangentX - (TangentZ0 * FVector::DotProduct(TangentZ0, TriangleTangentX));
-					TangentX0.Normalize();
+						Indices[VertexInstanceSectionIndex] = WeldedIndex;
+					}
 
-					FVector TangentX1 = TriangleTangentX - (TangentZ1 * FVector::DotProduct(TangentZ1, TriangleTangentX));
-					TangentX1.Normalize();
+					TArray<FVector> Positions;
+					Positions.AddUninitialized(Vertices.Num());
+					for (int32 VertexIndex = 0; VertexIndex < Vertices.Num(); VertexIndex++)
+					{
+						Positions[VertexIndex] = FVector(Vertices[VertexIndex].Position);
+					}
 
-					FVector TangentX2 = TriangleTangentX - (TangentZ2 * FVector::DotProduct(TangentZ2, TriangleTangentX));
-					TangentX2.Normalize();
+					OptimizeTrianglesOrder(Indices, Positions);
 
-#if ENGINE_MAJOR_VERSION > 4
-					StaticMeshVertex0.TangentX = FVector3f(TangentX0);
-					StaticMeshVertex0.TangentY = FVector3f(ComputeTangentY(FVector(StaticMeshVertex0.TangentZ), FVector(StaticMeshVertex0.TangentX)) * TangentsDirection);
+					TArray<uint32> VerticesOrder;
+					OptimizeVertexFetch(Indices, Vertices.Num(), VerticesOrder);
 
-					StaticMeshVertex1.TangentX = FVector3f(TangentX1);
-					StaticMeshVertex1.TangentY = FVector3f(ComputeTangentY(FVector(StaticMeshVertex1.TangentZ), FVector(StaticMeshVertex1.TangentX)) * TangentsDirection);
+					TArray<FStaticMeshBuildVertex> OrderedVertices;
+					OrderedVertices.AddUninitialized(VerticesOrder.Num());
+					for (int32 VertexIndex = 0; VertexIndex < VerticesOrder.Num(); VertexIndex++)
+					{
+						OrderedVertices[VertexIndex] = Vertices[VerticesOrder[VertexIndex]];
+					}
+					Vertices = MoveTemp(OrderedVertices);
+				});
 
-					StaticMeshVertex2.TangentX = FVector3f(TangentX2);
-					StaticMeshVertex2.TangentY = FVector3f(ComputeTangentY(FVector(StaticMeshVertex2.TangentZ), FVector(StaticMeshVertex2.TangentX)) * TangentsDirection);
-#else
-					StaticMeshVertex0.TangentX = TangentX0;
-					StaticMeshVertex0.TangentY = ComputeTangentY(StaticMeshVertex0.TangentZ, StaticMeshVertex0.TangentX) * TangentsDirection;
+			StaticMeshBuildVertices.Reset();
+			LODIndices.Reset();
 
-					StaticMeshVertex1.TangentX = TangentX1;
-					StaticMeshVertex1.TangentY = ComputeTangentY(StaticMeshVertex1.TangentZ, StaticMeshVertex1.TangentX) * TangentsDirection;
+			for (int32 SectionIndex = 0; SectionIndex < Sections.Num(); SectionIndex++)
+			{
+				FStaticMeshSection& Section = Sections[SectionIndex];
+				const uint32 BaseVertexIndex = StaticMeshBuildVertices.Num();
 
-					StaticMeshVertex2.TangentX = TangentX2;
-					StaticMeshVertex2.TangentY = ComputeTangentY(StaticMeshVertex2.TangentZ, StaticMeshVertex2.TangentX) * TangentsDirection;
-#endif
+				Section.FirstIndex = LODIndices.Num();
+				Section.MinVertexIndex = BaseVertexIndex;
+				Section.MaxVertexIndex = BaseVertexIndex + FMath::Max(SectionsVertices[SectionIndex].Num() - 1, 0);
 
+				for (const uint32 Index : SectionsIndices[SectionIndex])
+				{
+					LODIndices.Add(BaseVertexIndex + Index);
 				}
+				StaticMeshBuildVertices.Append(SectionsVertices[SectionIndex]);
 			}
-
-			VertexInstanceBaseIndex += NumVertexInstancesPerSection;
 		}
 
 		// check for pivot repositioning
@@ -609,6 +686,14 @@ UStaticMesh* FglTFRuntimeParser::FinalizeStaticMesh(TSharedRef<FglTFRuntimeStati
 		ScreenSize -= DeltaScreenSize;
 	}
 
+	for (const TPair<int32, float>& Pair : StaticMeshContext->GeneratedLODScreenSize)
+	{
+		if (Pair.Key < RenderData->LODResources.Num())
+		{
+			RenderData->ScreenSize[Pair.Key].Default = Pair.Value;
+		}
+	}
+
 	// Override LODs ScreenSize
 	for (const TPair<int32, float>& Pair : StaticMeshConfig.LODScreenSize)
 	{
@@ -735,14 +820,14 @@ UStaticMesh* FglTFRuntimeParser::FinalizeStaticMesh(TSharedRef<FglTFRuntimeStati
 
 bool FglTFRuntimeParser::LoadStaticMeshes(TArray<UStaticMesh*>& StaticMeshes, const FglTFRuntimeStaticMeshConfig& StaticMeshConfig)
 {
-	const TArray<TSharedPtr<FJsonValue>>* JsonMeshes;
+	const int32 MeshesNum = GetJsonRootArrayNum("meshes");
 	// no meshes ?
-	if (!Root->TryGetArrayField("meshes", JsonMeshes))
+	if (MeshesNum < 0)
 	{
 		return false;
 	}
 
-	for (int32 Index = 0; Index < JsonMeshes->Num(); Index++)
+	for (int32 Index = 0; Index < MeshesNum; Index++)
 	{
 		UStaticMesh* StaticMesh = LoadStaticMesh(Index, StaticMeshConfig);
 		if (!StaticMesh)
@@ -755,33 +840,40 @@ bool FglTFRuntimeParser::LoadStaticMeshes(TArray<UStaticMesh*>& StaticMeshes, co
 	return true;
 }
 
-bool FglTFRuntimeParser::LoadMeshIntoMeshLOD(TSharedRef<FJsonObject> JsonMeshObject, FglTFRuntimeMeshLOD*& LOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+bool FglTFRuntimeParser::LoadMeshIntoMeshLOD(const int32 MeshIndex, FglTFRuntimeMeshLOD*& LOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
 {
-	if (LODsCache.Contains(JsonMeshObject))
 	{
-		LOD = &LODsCache[JsonMeshObject];
-		return true;
+		FScopeLock Lock(&LODsCacheLock);
+		if (LODsCache.Contains(MeshIndex))
+		{
+			LOD = LODsCache[MeshIndex].Get();
+			return true;
+		}
 	}
 
 	TArray<FglTFRuntimePrimitive> Primitives;
-	if (!LoadPrimitives(JsonMeshObject, Primitives, MaterialsConfig))
+	if (!LoadPrimitives(MeshIndex, Primitives, MaterialsConfig))
 	{
 		return false;
 	}
 
-	FglTFRuntimeMeshLOD NewLOD;
-	NewLOD.Primitives = MoveTemp(Primitives);
+	TUniquePtr<FglTFRuntimeMeshLOD> NewLOD = MakeUnique<FglTFRuntimeMeshLOD>();
+	NewLOD->Primitives = MoveTemp(Primitives);
 
-	FglTFRuntimeMeshLOD& CachedLOD = LODsCache.Add(JsonMeshObject, MoveTemp(NewLOD));
-	LOD = &CachedLOD;
+	// another thread could have decoded the same mesh in the meantime, the first one wins
+	FScopeLock Lock(&LODsCacheLock);
+	if (!LODsCache.Contains(MeshIndex))
+	{
+		LODsCache.Add(MeshIndex, MoveTemp(NewLOD));
+	}
+	LOD = LODsCache[MeshIndex].Get();
 	return true;
 }
 
 UStaticMesh* FglTFRuntimeParser::LoadStaticMesh(const int32 MeshIndex, const FglTFRuntimeStaticMeshConfig& StaticMeshConfig)
 {
 
-	TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-	if (!JsonMeshObject)
+	if (!HasJsonRootObject("meshes", MeshIndex))
 	{
 		return nullptr;
 	}
@@ -793,7 +885,7 @@ UStaticMesh* FglTFRuntimeParser::LoadStaticMesh(const int32 MeshIndex, const Fgl
 
 	TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext = MakeShared<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe>(AsShared(), StaticMeshConfig);
 	FglTFRuntimeMeshLOD* LOD = nullptr;
-	if (!LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, StaticMeshConfig.MaterialsConfig))
+	if (!LoadMeshIntoMeshLOD(MeshIndex, LOD, StaticMeshConfig.MaterialsConfig))
 	{
 		return nullptr;
 	}
@@ -823,14 +915,13 @@ TArray<UStaticMesh*> FglTFRuntimeParser::LoadStaticMeshesFromPrimitives(const in
 {
 	TArray<UStaticMesh*> StaticMeshes;
 
-	TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-	if (!JsonMeshObject)
+	if (!HasJsonRootObject("meshes", MeshIndex))
 	{
 		return StaticMeshes;
 	}
 
 	FglTFRuntimeMeshLOD* LOD = nullptr;
-	if (!LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, StaticMeshConfig.MaterialsConfig))
+	if (!LoadMeshIntoMeshLOD(MeshIndex, LOD, StaticMeshConfig.MaterialsConfig))
 	{
 		return StaticMeshes;
 	}
@@ -869,15 +960,14 @@ UStaticMesh* FglTFRuntimeParser::LoadStaticMeshLODs(const TArray<int32>& MeshInd
 
 	for (const int32 MeshIndex : MeshIndices)
 	{
-		TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-		if (!JsonMeshObject)
+		if (!HasJsonRootObject("meshes", MeshIndex))
 		{
 			return nullptr;
 		}
 
 		FglTFRuntimeMeshLOD* LOD = nullptr;
 
-		if (!LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, StaticMeshConfig.MaterialsConfig))
+		if (!LoadMeshIntoMeshLOD(MeshIndex, LOD, StaticMeshConfig.MaterialsConfig))
 		{
 			return nullptr;
 		}
@@ -902,8 +992,7 @@ void FglTFRuntimeParser::LoadStaticMeshLODsAsync(const TArray<int32>& MeshIndice
 			bool bSuccess = true;
 			for (const int32 MeshIndex : MeshIndices)
 			{
-				TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-				if (!JsonMeshObject)
+				if (!HasJsonRootObject("meshes", MeshIndex))
 				{
 					bSuccess = false;
 					break;
@@ -911,7 +1000,7 @@ void FglTFRuntimeParser::LoadStaticMeshLODsAsync(const TArray<int32>& MeshIndice
 
 				FglTFRuntimeMeshLOD* LOD = nullptr;
 
-				if (!LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, StaticMeshContext->StaticMeshConfig.MaterialsConfig))
+				if (!LoadMeshIntoMeshLOD(MeshIndex, LOD, StaticMeshContext->StaticMeshConfig.MaterialsConfig))
 				{
 					bSuccess = false;
 					break;
@@ -945,14 +1034,13 @@ bool FglTFRuntimeParser::LoadStaticMeshIntoProceduralMeshComponent(const int32 M
 		return false;
 	}
 
-	TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-	if (!JsonMeshObject)
+	if (!HasJsonRootObject("meshes", MeshIndex))
 	{
 		return false;
 	}
 
 	TArray<FglTFRuntimePrimitive> Primitives;
-	if (!LoadPrimitives(JsonMeshObject.ToSharedRef(), Primitives, ProceduralMeshConfig.MaterialsConfig))
+	if (!LoadPrimitives(MeshIndex, Primitives, ProceduralMeshConfig.MaterialsConfig))
 	{
 		return false;
 	}
@@ -995,21 +1083,22 @@ bool FglTFRuntimeParser::LoadStaticMeshIntoProceduralMeshComponent(const int32 M
 
 UStaticMesh* FglTFRuntimeParser::LoadStaticMeshByName(const FString Name, const FglTFRuntimeStaticMeshConfig& StaticMeshConfig)
 {
-	const TArray<TSharedPtr<FJsonValue>>* JsonMeshes;
-	if (!Root->TryGetArrayField("meshes", JsonMeshes))
+	const int32 MeshesNum = GetJsonRootArrayNum("meshes");
+	if (MeshesNum < 0)
 	{
 		return nullptr;
 	}
 
-	for (int32 MeshIndex = 0; MeshIndex < JsonMeshes->Num(); MeshIndex++)
+	for (int32 MeshIndex = 0; MeshIndex < MeshesNum; MeshIndex++)
 	{
-		TSharedPtr<FJsonObject> JsonMeshObject = (*JsonMeshes)[MeshIndex]->AsObject();
-		if (!JsonMeshObject)
+		const TSharedRef<FglTFRuntimeJsonTape> JsonTape = GetJsonTape();
+		const int32 JsonMeshNode = JsonTape->GetRootArrayItem("meshes", MeshIndex);
+		if (!JsonTape->IsObject(JsonMeshNode))
 		{
 			return nullptr;
 		}
 		FString MeshName;
-		if (JsonMeshObject->TryGetStringField("name", MeshName))
+		if (JsonTape->TryGetStringField(JsonMeshNode, "name", MeshName))
 		{
 			if (MeshName == Name)
 			{
@@ -1073,14 +1162,13 @@ UStaticMesh* FglTFRuntimeParser::LoadStaticMeshRecursive(const FString& NodeName
 
 		if (ChildNode.MeshIndex != INDEX_NONE)
 		{
-			TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", ChildNode.MeshIndex);
-			if (!JsonMeshObject)
+			if (!HasJsonRootObject("meshes", ChildNode.MeshIndex))
 			{
 				return nullptr;
 			}
 
 			FglTFRuntimeMeshLOD* LOD = nullptr;
-			if (!LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, StaticMeshConfig.MaterialsConfig))
+			if (!LoadMeshIntoMeshLOD(ChildNode.MeshIndex, LOD, StaticMeshConfig.MaterialsConfig))
 			{
 				return nullptr;
 			}
@@ -1176,14 +1264,13 @@ void FglTFRuntimeParser::LoadStaticMeshRecursiveAsync(const FString& NodeName, c
 
 				if (ChildNode.MeshIndex != INDEX_NONE)
 				{
-					TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", ChildNode.MeshIndex);
-					if (!JsonMeshObject)
+					if (!HasJsonRootObject("meshes", ChildNode.MeshIndex))
 					{
 						return;
 					}
 
 					FglTFRuntimeMeshLOD* LOD = nullptr;
-					if (!LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, StaticMeshConfig.MaterialsConfig))
+					if (!LoadMeshIntoMeshLOD(ChildNode.MeshIndex, LOD, StaticMeshConfig.MaterialsConfig))
 					{
 						return;
 					}
@@ -1231,14 +1318,13 @@ void FglTFRuntimeParser::LoadStaticMeshRecursiveAsync(const FString& NodeName, c
 
 bool FglTFRuntimeParser::LoadMeshAsRuntimeLOD(const int32 MeshIndex, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
 {
-	TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-	if (!JsonMeshObject)
+	if (!HasJsonRootObject("meshes", MeshIndex))
 	{
 		return false;
 	}
 
 	FglTFRuntimeMeshLOD* LOD;
-	if (LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, MaterialsConfig))
+	if (LoadMeshIntoMeshLOD(MeshIndex, LOD, MaterialsConfig))
 	{
 		RuntimeLOD = *LOD; // slow copy :(
 		return true;
@@ -0,0 +1,237 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+#include "Async/ParallelFor.h"
+
+namespace glTFRuntimeTangents
+{
+#if ENGINE_MAJOR_VERSION < 5
+	typedef VectorRegister VectorRegister4Float;
+#endif
+
+	// big enough to amortize the task dispatching, small enough to balance the load between workers
+	constexpr int32 ItemsPerRange = 4096;
+
+	void ParallelForRanges(const int32 Num, TFunctionRef<void(const int32 Start, const int32 End)> Callback, const bool bForceSingleThread)
+	{
+		if (Num <= ItemsPerRange)
+		{
+			Callback(0, Num);
+			return;
+		}
+
+		const int32 NumRanges = FMath::DivideAndRoundUp(Num, ItemsPerRange);
+		ParallelFor(NumRanges, [Num, Callback](const int32 RangeIndex)
+			{
+				const int32 Start = RangeIndex * ItemsPerRange;
+				Callback(Start, FMath::Min(Start + ItemsPerRange, Num));
+			}, bForceSingleThread);
+	}
+
+	FORCEINLINE VectorRegister4Float LoadVector(const float* Vector)
+	{
+		return VectorLoadFloat3_W0(Vector);
+	}
+
+	FORCEINLINE float GetFirstComponent(const VectorRegister4Float& Vector)
+	{
+		float Value;
+		VectorStoreFloat1(Vector, &Value);
+		return Value;
+	}
+
+	// same tolerance of GetSafeNormal(), degenerate vectors become zero
+	FORCEINLINE VectorRegister4Float SafeNormalize(const VectorRegister4Float& Vector)
+	{
+		const VectorRegister4Float LengthSquared = VectorDot3(Vector, Vector);
+		const VectorRegister4Float Mask = VectorCompareGT(LengthSquared, VectorSetFloat1(1.e-8f));
+		return VectorSelect(Mask, VectorMultiply(Vector, VectorReciprocalSqrtAccurate(LengthSquared)), VectorSetFloat1(0));
+	}
+
+	FORCEINLINE VectorRegister4Float ProjectOnPlane(const VectorRegister4Float& Vector, const VectorRegister4Float& Normal)
+	{
+		return VectorSubtract(Vector, VectorMultiply(Normal, VectorDot3(Normal, Vector)));
+	}
+}
+
+void FglTFRuntimeParser::ParallelForTriangles(const int32 NumTriangles, TFunctionRef<void(const int32 TriangleStart, const int32 TriangleEnd)> Callback, const bool bForceSingleThread)
+{
+	glTFRuntimeTangents::ParallelForRanges(NumTriangles, Callback, bForceSingleThread);
+}
+
+void FglTFRuntimeParser::GenerateFlatNormals(const TArray<FVector3f>& Positions, TArray<FVector3f>& Normals, const bool bForceSingleThread)
+{
+	using namespace glTFRuntimeTangents;
+
+	const int32 NumTriangles = Positions.Num() / 3;
+	Normals.SetNumUninitialized(Positions.Num());
+
+	ParallelForTriangles(NumTriangles, [&](const int32 TriangleStart, const int32 TriangleEnd)
+		{
+			for (int32 Corner = TriangleStart * 3; Corner < TriangleEnd * 3; Corner += 3)
+			{
+				const VectorRegister4Float Position0 = LoadVector(&Positions[Corner].X);
+				const VectorRegister4Float SideA = VectorSubtract(LoadVector(&Positions[Corner + 1].X), Position0);
+				const VectorRegister4Float SideB = VectorSubtract(LoadVector(&Positions[Corner + 2].X), Position0);
+				VectorStoreFloat3(SafeNormalize(VectorCross(SideB, SideA)), &Normals[Corner].X);
+				Normals[Corner + 1] = Normals[Corner];
+				Normals[Corner + 2] = Normals[Corner];
+			}
+		}, bForceSingleThread);
+
+	for (int32 Corner = NumTriangles * 3; Corner < Positions.Num(); Corner++)
+	{
+		Normals[Corner] = FVector3f::ZeroVector;
+	}
+}
+
+void FglTFRuntimeParser::LoadOrGenerateTangents(const TArray<FVector3f>& Positions, const TArray<FVector3f>& Normals, const TArray<FVector2f>& UVs, const TArray<uint32>& Keys, TArray<FVector4f>& Tangents)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadOrGenerateTangents, FColor::Magenta);
+
+	if (!DerivedDataCache)
+	{
+		GenerateTangents(Positions, Normals, UVs, Keys, Tangents);
+		return;
+	}
+
+	// the inputs are already transformed and welded, hashing them is an order of magnitude cheaper than the generation
+	FglTFRuntimeDerivedDataKey Key(TEXT("tangents"));
+	Key.UpdateBytes(reinterpret_cast<const uint8*>(Positions.GetData()), Positions.Num() * sizeof(FVector3f));
+	Key.UpdateBytes(reinterpret_cast<const uint8*>(Normals.GetData()), Normals.Num() * sizeof(FVector3f));
+	Key.UpdateBytes(reinterpret_cast<const uint8*>(UVs.GetData()), UVs.Num() * sizeof(FVector2f));
+	Key.UpdateBytes(reinterpret_cast<const uint8*>(Keys.GetData()), Keys.Num() * sizeof(uint32));
+	const FSHAHash DerivedDataKey = Key.Finalize();
+
+	const uint8* PayloadData = nullptr;
+	int64 PayloadNum = 0;
+	TSharedPtr<FglTFRuntimeMappedFile> MappedFile = DerivedDataCache->Load(DerivedDataKey, PayloadData, PayloadNum);
+	if (MappedFile)
+	{
+		FglTFRuntimeDerivedDataReader Reader(PayloadData, PayloadNum);
+		if (Reader.ReadArray(Tangents) && Reader.Offset == Reader.Num && Tangents.Num() == Positions.Num())
+		{
+			return;
+		}
+	}
+
+	GenerateTangents(Positions, Normals, UVs, Keys, Tangents);
+
+	FglTFRuntimeDerivedDataWriter Writer;
+	Writer.WriteArray(Tangents);
+	DerivedDataCache->Save(DerivedDataKey, Writer.Bytes);
+}
+
+void FglTFRuntimeParser::GenerateTangents(const TArray<FVector3f>& Positions, const TArray<FVector3f>& Normals, const TArray<FVector2f>& UVs, const TArray<uint32>& Keys, TArray<FVector4f>& Tangents, const bool bForceSingleThread)
+{
+	using namespace glTFRuntimeTangents;
+
+	Tangents.Init(FVector4f(1, 0, 0, 1), Positions.Num());
+	if (Normals.Num() != Positions.Num() || UVs.Num() != Positions.Num() || Keys.Num() != Positions.Num())
+	{
+		return;
+	}
+
+	const int32 NumTriangles = Positions.Num() / 3;
+	const int32 NumCorners = NumTriangles * 3;
+
+	// the tangent of every corner (projected on its normal) weighted by the corner angle, W is the handedness
+	TArray<FVector4f> CornersTangents;
+	CornersTangents.SetNumUninitialized(NumCorners);
+
+	ParallelForTriangles(NumTriangles, [&](const int32 TriangleStart, const int32 TriangleEnd)
+		{
+			for (int32 Corner = TriangleStart * 3; Corner < TriangleEnd * 3; Corner += 3)
+			{
+				const VectorRegister4Float TrianglePositions[3] = { LoadVector(&Positions[Corner].X), LoadVector(&Positions[Corner + 1].X), LoadVector(&Positions[Corner + 2].X) };
+				const VectorRegister4Float DeltaPosition0 = VectorSubtract(TrianglePositions[1], TrianglePositions[0]);
+				const VectorRegister4Float DeltaPosition1 = VectorSubtract(TrianglePositions[2], TrianglePositions[0]);
+
+				const FVector2f DeltaUV0 = UVs[Corner + 1] - UVs[Corner];
+				const FVector2f DeltaUV1 = UVs[Corner + 2] - UVs[Corner];
+				const float Determinant = DeltaUV0.X * DeltaUV1.Y - DeltaUV0.Y * DeltaUV1.X;
+				// triangles without uv area do not contribute
+				const VectorRegister4Float Factor = VectorSetFloat1(FMath::Abs(Determinant) > FLT_MIN ? 1.f / Determinant : 0.f);
+
+				// derivatives of the position along u and v
+				const VectorRegister4Float TriangleTangent = VectorMultiply(VectorSubtract(VectorMultiply(DeltaPosition0, VectorSetFloat1(DeltaUV1.Y)), VectorMultiply(DeltaPosition1, VectorSetFloat1(DeltaUV0.Y))), Factor);
+				const VectorRegister4Float TriangleBitangent = VectorMultiply(VectorSubtract(VectorMultiply(DeltaPosition1, VectorSetFloat1(DeltaUV0.X)), VectorMultiply(DeltaPosition0, VectorSetFloat1(DeltaUV1.X))), Factor);
+
+				for (int32 TriangleCorner = 0; TriangleCorner < 3; TriangleCorner++)
+				{
+					const VectorRegister4Float Normal = LoadVector(&Normals[Corner + TriangleCorner].X);
+					const VectorRegister4Float Tangent = SafeNormalize(ProjectOnPlane(TriangleTangent, Normal));
+
+					const VectorRegister4Float EdgeA = SafeNormalize(VectorSubtract(TrianglePositions[(TriangleCorner + 1) % 3], TrianglePositions[TriangleCorner]));
+					const VectorRegister4Float EdgeB = SafeNormalize(VectorSubtract(TrianglePositions[(TriangleCorner + 2) % 3], TrianglePositions[TriangleCorner]));
+					const float Angle = FMath::Acos(FMath::Clamp(GetFirstComponent(VectorDot3(EdgeA, EdgeB)), -1.f, 1.f));
+
+					FVector4f& CornerTangent = CornersTangents[Corner + TriangleCorner];
+					VectorStoreFloat3(VectorMultiply(Tangent, VectorSetFloat1(Angle)), &CornerTangent.X);
+					CornerTangent.W = GetFirstComponent(VectorDot3(VectorCross(Normal, Tangent), TriangleBitangent)) < 0 ? -1.f : 1.f;
+				}
+			}
+		}, bForceSingleThread);
+
+	// group the corners by key, a counting sort keeps the corners of each group in ascending order
+	uint32 NumKeys = 0;
+	for (int32 Corner = 0; Corner < NumCorners; Corner++)
+	{
+		NumKeys = FMath::Max(NumKeys, Keys[Corner] + 1);
+	}
+
+	TArray<int32> KeysOffsets;
+	KeysOffsets.AddZeroed(NumKeys + 1);
+	for (int32 Corner = 0; Corner < NumCorners; Corner++)
+	{
+		KeysOffsets[Keys[Corner] + 1]++;
+	}
+	for (uint32 Key = 0; Key < NumKeys; Key++)
+	{
+		KeysOffsets[Key + 1] += KeysOffsets[Key];
+	}
+
+	TArray<int32> KeysCorners;
+	KeysCorners.SetNumUninitialized(NumCorners);
+	TArray<int32> KeysFill = KeysOffsets;
+	for (int32 Corner = 0; Corner < NumCorners; Corner++)
+	{
+		KeysCorners[KeysFill[Keys[Corner]]++] = Corner;
+	}
+
+	ParallelForRanges(NumKeys, [&](const int32 KeyStart, const int32 KeyEnd)
+		{
+			for (int32 Key = KeyStart; Key < KeyEnd; Key++)
+			{
+				// one sum for each handedness, always accumulated in the same order
+				VectorRegister4Float Sums[2] = { VectorSetFloat1(0), VectorSetFloat1(0) };
+				for (int32 KeyCorner = KeysOffsets[Key]; KeyCorner < KeysOffsets[Key + 1]; KeyCorner++)
+				{
+					const FVector4f& CornerTangent = CornersTangents[KeysCorners[KeyCorner]];
+					VectorRegister4Float& Sum = Sums[CornerTangent.W < 0 ? 1 : 0];
+					Sum = VectorAdd(Sum, LoadVector(&CornerTangent.X));
+				}
+
+				for (int32 KeyCorner = KeysOffsets[Key]; KeyCorner < KeysOffsets[Key + 1]; KeyCorner++)
+				{
+					const int32 Corner = KeysCorners[KeyCorner];
+					const float W = CornersTangents[Corner].W;
+					const VectorRegister4Float Normal = LoadVector(&Normals[Corner].X);
+					VectorRegister4Float Tangent = SafeNormalize(ProjectOnPlane(Sums[W < 0 ? 1 : 0], Normal));
+					// degenerate uvs, any direction on the normal plane will do
+					if (GetFirstComponent(VectorDot3(Tangent, Tangent)) == 0)
+					{
+						const VectorRegister4Float Axis = FMath::Abs(Normals[Corner].X) < 0.9f ? MakeVectorRegister(1.f, 0.f, 0.f, 0.f) : MakeVectorRegister(0.f, 1.f, 0.f, 0.f);
+						Tangent = SafeNormalize(ProjectOnPlane(Axis, Normal));
+						if (GetFirstComponent(VectorDot3(Tangent, Tangent)) == 0)
+						{
+							Tangent = MakeVectorRegister(1.f, 0.f, 0.f, 0.f);
+						}
+					}
+
+					VectorStoreFloat3(Tangent, &Tangents[Corner].X);
+					Tangents[Corner].W = W;
+				}
+			}
+		}, bForceSingleThread);
+}
@@ -22,6 +22,9 @@ protected:
 
 	virtual void ProcessNode(USceneComponent* NodeParentComponent, const FName SocketName, FglTFRuntimeNode& Node);
 
+	// the meshes ProcessNode will load from the node and its children (static and skeletal ones use different configs)
+	void GetNodeMeshes(const FglTFRuntimeNode& Node, TArray<int32>& StaticMeshesIndices, TArray<int32>& SkeletalMeshesIndices);
+
 	TMap<USceneComponent*, float>  CurveBasedAnimationsTimeTracker;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
@@ -7,6 +7,21 @@
 #include "glTFRuntimeAsset.h"
 #include "glTFRuntimeAssetActorAsync.generated.h"
 
+USTRUCT()
+struct FglTFRuntimeAssetActorAsyncLoadedMesh
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UPrimitiveComponent* PrimitiveComponent = nullptr;
+
+	UPROPERTY()
+	UStaticMesh* StaticMesh = nullptr;
+
+	UPROPERTY()
+	USkeletalMesh* SkeletalMesh = nullptr;
+};
+
 UCLASS()
 class GLTFRUNTIME_API AglTFRuntimeAssetActorAsync : public AActor
 {
@@ -20,6 +35,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void Tick(float DeltaTime) override;
+
 	virtual void ProcessNode(USceneComponent* NodeParentComponent, const FName SocketName, FglTFRuntimeNode& Node);
 
 	template<typename T>
@@ -54,6 +71,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime")
 	bool bStaticMeshesAsSkeletal;
 
+	// max number of static meshes loaded concurrently (skeletal meshes are always loaded one at a time)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = 1), Category = "glTFRuntime")
+	int32 MaxConcurrentMeshes;
+
+	// time (in milliseconds) per frame spent assigning loaded meshes to their components (at least one is assigned per frame, 0 means no limit)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = 0), Category = "glTFRuntime")
+	float MeshesCommitBudgetMs;
+
 	virtual void PostUnregisterAllComponents() override;
 
 private:
@@ -64,13 +89,20 @@ private:
 
 	void LoadNextMeshAsync();
 
-	UFUNCTION()
-	void LoadStaticMeshAsync(UStaticMesh* StaticMesh);
-
 	UFUNCTION()
 	void LoadSkeletalMeshAsync(USkeletalMesh* SkeletalMesh);
 
-	// this is safe to share between game and async threads because everything is sequential
+	void CommitStaticMesh(UStaticMeshComponent* StaticMeshComponent, UStaticMesh* StaticMesh);
+	void CommitSkeletalMesh(USkeletalMeshComponent* SkeletalMeshComponent, USkeletalMesh* SkeletalMesh);
+
+	// meshes loaded but not yet assigned to their components (assigned in Tick within MeshesCommitBudgetMs)
+	UPROPERTY(Transient)
+	TArray<FglTFRuntimeAssetActorAsyncLoadedMesh> LoadedMeshesToCommit;
+
+	int32 MeshesInFlight;
+	bool bLoadingMeshes;
+
+	// skeletal meshes are loaded exclusively, so this is safe to share between game and async threads
 	UPrimitiveComponent* CurrentPrimitiveComponent;
 
 	double LoadingStartTime;
@@ -0,0 +1,129 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+#include "glTFRuntimeMappedFile.h"
+
+/**
+ * Builds the key of a derived data cache entry.
+ * Bulk data is hashed with CityHash64, everything is then accumulated into a SHA1.
+ */
+class GLTFRUNTIME_API FglTFRuntimeDerivedDataKey
+{
+public:
+	FglTFRuntimeDerivedDataKey(const TCHAR* Kind);
+
+	template<typename T>
+	void Update(const T& Value)
+	{
+		Sha1.Update(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	void Update(const FString& Value);
+	void UpdateBytes(const uint8* Data, const int64 Num);
+
+	FSHAHash Finalize();
+
+protected:
+	FSHA1 Sha1;
+};
+
+/**
+ * Appends plain values and arrays of plain values to a derived data payload.
+ */
+struct FglTFRuntimeDerivedDataWriter
+{
+	TArray64<uint8> Bytes;
+
+	template<typename T>
+	void Write(const T& Value)
+	{
+		Bytes.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	template<typename T, typename AllocatorType>
+	void WriteArray(const TArray<T, AllocatorType>& Array)
+	{
+		Write<int64>(Array.Num());
+		Bytes.Append(reinterpret_cast<const uint8*>(Array.GetData()), Array.Num() * sizeof(T));
+	}
+
+	void WriteString(const FString& Value);
+};
+
+/**
+ * Reads back a payload built by FglTFRuntimeDerivedDataWriter, failing on truncated data.
+ */
+struct FglTFRuntimeDerivedDataReader
+{
+	const uint8* Data;
+	int64 Num;
+	int64 Offset;
+
+	FglTFRuntimeDerivedDataReader(const uint8* InData, const int64 InNum) : Data(InData), Num(InNum), Offset(0)
+	{
+	}
+
+	template<typename T>
+	bool Read(T& Value)
+	{
+		if (Offset + static_cast<int64>(sizeof(T)) > Num)
+		{
+			return false;
+		}
+		FMemory::Memcpy(&Value, Data + Offset, sizeof(T));
+		Offset += sizeof(T);
+		return true;
+	}
+
+	template<typename T, typename AllocatorType>
+	bool ReadArray(TArray<T, AllocatorType>& Array)
+	{
+		int64 ArrayNum = 0;
+		if (!Read(ArrayNum) || ArrayNum < 0 || ArrayNum > (Num - Offset) / static_cast<int64>(sizeof(T)))
+		{
+			return false;
+		}
+		Array.Empty(ArrayNum);
+		Array.AddUninitialized(ArrayNum);
+		FMemory::Memcpy(Array.GetData(), Data + Offset, ArrayNum * sizeof(T));
+		Offset += ArrayNum * sizeof(T);
+		return true;
+	}
+
+	bool ReadString(FString& Value);
+};
+
+/**
+ * Persistent cache of the data derived from glTF assets (decoded geometry, mips chains).
+ * Each entry is a versioned binary file named after its key: entries are memory mapped on read
+ * and the least recently used ones are removed when the directory grows over the configured size.
+ * Instances are shared by all the parsers using the same directory.
+ */
+class GLTFRUNTIME_API FglTFRuntimeDerivedDataCache
+{
+public:
+	static TSharedPtr<FglTFRuntimeDerivedDataCache> Get(const FString& Directory, const int64 MaxSize);
+
+	// the payload points into the returned mapped file (that must outlive its usage)
+	TSharedPtr<FglTFRuntimeMappedFile> Load(const FSHAHash& Key, const uint8*& PayloadData, int64& PayloadNum);
+	bool Save(const FSHAHash& Key, const TArray64<uint8>& Payload);
+
+	const FString& GetDirectory() const { return Directory; }
+	// INDEX_NONE until the first Save() has scanned the directory
+	int64 GetTotalSize();
+
+protected:
+	FglTFRuntimeDerivedDataCache(const FString& InDirectory, const int64 InMaxSize);
+
+	FString GetEntryFilename(const FSHAHash& Key) const;
+	void Evict();
+
+	FString Directory;
+	int64 MaxSize;
+	// INDEX_NONE until the directory has been scanned
+	int64 TotalSize;
+	FCriticalSection TotalSizeLock;
+};
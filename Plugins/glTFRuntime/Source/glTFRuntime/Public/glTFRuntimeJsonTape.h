@@ -0,0 +1,104 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Read-only flat representation of a JSON document.
+ * Every value is a fixed-size node (containers are followed by their children) and all of the strings
+ * live in a single arena, so parsing does not allocate per value.
+ * Subtrees can be converted to FJsonObject/FJsonValue on demand.
+ */
+class GLTFRUNTIME_API FglTFRuntimeJsonTape
+{
+public:
+	enum class ENodeType : uint8
+	{
+		Null,
+		Boolean,
+		Number,
+		String,
+		Array,
+		Object
+	};
+
+	static TSharedPtr<FglTFRuntimeJsonTape> FromUTF8(const uint8* DataPtr, const int64 DataNum);
+	static TSharedPtr<FglTFRuntimeJsonTape> FromString(const FString& JsonData);
+	// flattens an already parsed tree, without serializing it back to text
+	static TSharedRef<FglTFRuntimeJsonTape> FromJsonObject(TSharedRef<FJsonObject> JsonObject);
+
+	int32 GetRootNode() const { return 0; }
+	ENodeType GetNodeType(const int32 Node) const { return Nodes.IsValidIndex(Node) ? Nodes[Node].Type : ENodeType::Null; }
+	bool IsObject(const int32 Node) const { return GetNodeType(Node) == ENodeType::Object; }
+	bool IsArray(const int32 Node) const { return GetNodeType(Node) == ENodeType::Array; }
+
+	int32 GetArrayNum(const int32 ArrayNode) const;
+	int32 GetArrayItem(const int32 ArrayNode, const int32 Index) const;
+	int32 GetRootArrayItem(const ANSICHAR* FieldName, const int32 Index) const { return GetArrayItem(GetArrayField(GetRootNode(), FieldName), Index); }
+
+	// like FJsonObject, the last value wins when a key is duplicated
+	int32 FindField(const int32 ObjectNode, const ANSICHAR* FieldName) const;
+	int32 GetObjectField(const int32 ObjectNode, const ANSICHAR* FieldName) const;
+	int32 GetArrayField(const int32 ObjectNode, const ANSICHAR* FieldName) const;
+	void ForEachField(const int32 ObjectNode, TFunctionRef<void(const FString& FieldName, const int32 ValueNode)> Callback) const;
+
+	// conversions follow the FJsonValue ones (booleans are numbers, numeric strings are numbers, numbers are booleans...)
+	bool TryGetNumber(const int32 Node, double& Value) const;
+	bool TryGetNumber(const int32 Node, float& Value) const;
+	bool TryGetNumber(const int32 Node, int32& Value) const;
+	bool TryGetNumber(const int32 Node, int64& Value) const;
+	bool TryGetBool(const int32 Node, bool& Value) const;
+	bool TryGetString(const int32 Node, FString& Value) const;
+	// fails if the array does not have exactly ValuesNum numbers
+	bool TryGetNumbers(const int32 ArrayNode, double* Values, const int32 ValuesNum) const;
+
+	template<typename T>
+	bool TryGetNumberField(const int32 ObjectNode, const ANSICHAR* FieldName, T& Value) const
+	{
+		return TryGetNumber(FindField(ObjectNode, FieldName), Value);
+	}
+	bool TryGetBoolField(const int32 ObjectNode, const ANSICHAR* FieldName, bool& Value) const;
+	bool TryGetStringField(const int32 ObjectNode, const ANSICHAR* FieldName, FString& Value) const;
+	bool TryGetStringArrayField(const int32 ObjectNode, const ANSICHAR* FieldName, TArray<FString>& Values) const;
+
+	int64 GetIndexField(const int32 ObjectNode, const ANSICHAR* FieldName, const int64 DefaultValue = INDEX_NONE) const;
+	FString GetStringField(const int32 ObjectNode, const ANSICHAR* FieldName, const FString& DefaultValue = FString()) const;
+
+	TSharedPtr<FJsonValue> ToJsonValue(const int32 Node) const;
+	TSharedPtr<FJsonObject> ToJsonObject(const int32 Node) const;
+
+	// appends a compact encoding of the subtree that does not depend on where it lives in the tape (useful for hashing)
+	void AppendNodeBytes(const int32 Node, TArray<uint8>& Bytes) const;
+
+protected:
+	struct FNode
+	{
+		double Number;
+		// index of the first node after this value (children included)
+		int32 Next;
+		// string length in bytes or number of items/fields
+		int32 Num;
+		// offset in the string arena or in the array items table
+		int32 Offset;
+		ENodeType Type;
+	};
+
+	bool Parse(const uint8* DataPtr, const int64 DataNum);
+	bool ParseValue(const uint8*& Ptr, const uint8* End, const int32 Depth);
+	bool ParseString(const uint8*& Ptr, const uint8* End, int32& Offset, int32& Len);
+	bool ParseNumber(const uint8*& Ptr, const uint8* End, double& Number);
+	void AppendJsonValue(const TSharedPtr<FJsonValue>& JsonValue);
+	void AppendJsonObject(const TSharedRef<FJsonObject>& JsonObject);
+	void AppendString(const FString& Value, int32& Offset, int32& Len);
+
+	FString GetString(const FNode& Node) const;
+
+	TArray<FNode> Nodes;
+	// array items node indices, each array owns a contiguous range
+	TArray<int32> Items;
+	TArray<int32> ItemsStack;
+	TArray<ANSICHAR> Strings;
+};
@@ -0,0 +1,33 @@
+// Copyright 2020-2023, Roberto De Ioris.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Read-only memory-mapped file.
+ * Pages are loaded by the OS on access, so blobs can point straight into the file without copying it.
+ */
+class GLTFRUNTIME_API FglTFRuntimeMappedFile
+{
+public:
+	~FglTFRuntimeMappedFile();
+
+	static TSharedPtr<FglTFRuntimeMappedFile> Open(const FString& Filename);
+
+	const uint8* GetData() const;
+	int64 GetSize() const;
+
+	bool Contains(const uint8* DataPtr, const int64 DataNum) const;
+
+protected:
+	FglTFRuntimeMappedFile() = default;
+
+	// the handle must outlive the region
+	TUniquePtr<IMappedFileHandle> MappedFileHandle;
+	TUniquePtr<IMappedFileRegion> MappedFileRegion;
+};
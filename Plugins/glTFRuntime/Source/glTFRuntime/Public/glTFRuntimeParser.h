@@ -17,10 +17,14 @@
 #include "Engine/Texture2DArray.h"
 #include "Engine/TextureCube.h"
 #include "Engine/TextureMipDataProviderFactory.h"
+#include "GenericPlatform/GenericPlatformFile.h"
 #include "Camera/CameraComponent.h"
 #include "Components/AudioComponent.h"
 #include "Components/LightComponent.h"
 #include "glTFRuntimeAnimationCurve.h"
+#include "glTFRuntimeDerivedDataCache.h"
+#include "glTFRuntimeJsonTape.h"
+#include "glTFRuntimeMappedFile.h"
 #include "ProceduralMeshComponent.h"
 #if WITH_EDITOR
 #include "Rendering/SkeletalMeshLODImporterData.h"
@@ -30,6 +34,13 @@
 #include "UObject/Package.h"
 #include "glTFRuntimeParser.generated.h"
 
+#if ENGINE_MAJOR_VERSION < 5
+// single precision vectors of UE5 (used by the normals and tangents generators)
+typedef FVector FVector3f;
+typedef FVector2D FVector2f;
+typedef FVector4 FVector4f;
+#endif
+
 GLTFRUNTIME_API DECLARE_LOG_CATEGORY_EXTERN(LogGLTFRuntime, Log, All);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FglTFRuntimeError, const FString, ErrorContext, const FString, ErrorMessage);
@@ -194,6 +205,16 @@ struct FglTFRuntimeConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	FString PrefixForUnnamedNodes;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bUseMemoryMappedFiles;
+
+	// persistent cache for decoded geometry and mips (relative to the project Saved directory), disabled when empty
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	FString DerivedDataCacheDirectory;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	int32 DerivedDataCacheMaxSizeMB;
+
 	FglTFRuntimeConfig()
 	{
 		TransformBaseType = EglTFRuntimeTransformBaseType::Default;
@@ -207,6 +228,8 @@ struct FglTFRuntimeConfig
 		RuntimeContextObject = nullptr;
 		bAsBlob = false;
 		PrefixForUnnamedNodes = "node";
+		bUseMemoryMappedFiles = false;
+		DerivedDataCacheMaxSizeMB = 1024;
 	}
 
 	FMatrix GetMatrix() const
@@ -479,6 +502,8 @@ struct FglTFRuntimeTextureSampler
 	}
 };
 
+struct FglTFRuntimePrefetchedTextures;
+
 USTRUCT(BlueprintType)
 struct FglTFRuntimeMaterialsConfig
 {
@@ -508,6 +533,10 @@ struct FglTFRuntimeMaterialsConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	bool bGeneratesMipMaps;
 
+	// generated mips are box filtered from the previous level (vectorized, much faster, but not bit exact with the default resize of the full image)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bGenerateMipMapsFromPreviousMip;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	bool bMergeSectionsByMaterial;
 
@@ -538,10 +567,14 @@ struct FglTFRuntimeMaterialsConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	bool bLoadMipMaps;
 
+	// textures already decoded for the meshes being loaded (see FglTFRuntimeParser::PrefetchMeshesTextures)
+	TSharedPtr<const FglTFRuntimePrefetchedTextures> PrefetchedTextures;
+
 	FglTFRuntimeMaterialsConfig()
 	{
 		CacheMode = EglTFRuntimeCacheMode::ReadWrite;
 		bGeneratesMipMaps = false;
+		bGenerateMipMapsFromPreviousMip = false;
 		bMergeSectionsByMaterial = false;
 		SpecularFactor = 0;
 		bDisableVertexColors = false;
@@ -626,6 +659,18 @@ struct FglTFRuntimeStaticMeshConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	float LODScreenSizeMultiplier;
 
+	// weld identical vertices and reorder sections for the GPU vertex cache, overdraw and vertex fetch
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bOptimizeVertexCache;
+
+	// generate an additional LOD (from LOD0) for each triangles ratio when the asset has a single LOD
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	TArray<float> AutoLODsTrianglesRatios;
+
+	// the screen size of the generated LODs is computed for this error (in pixels on a 1080p screen)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	float AutoLODsPixelError;
+
 	template<typename T>
 	T* GetCustomConfig() const
 	{
@@ -656,6 +701,8 @@ struct FglTFRuntimeStaticMeshConfig
 		bGenerateStaticMeshDescription = false;
 		bBuildNavCollision = false;
 		LODScreenSizeMultiplier = 2;
+		bOptimizeVertexCache = false;
+		AutoLODsPixelError = 1;
 	}
 };
 
@@ -1093,6 +1140,18 @@ struct FglTFRuntimeSkeletalMeshConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	FglTFRuntimeBoneBoundsFilterHook BoneBoundsFilter;
 
+	// index identical vertices and reorder sections for the GPU vertex cache and overdraw (the vertex buffers are left untouched)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bOptimizeVertexCache;
+
+	// generate an additional LOD (from LOD0) for each triangles ratio when the asset has a single LOD, skin weights are preserved along with borders and seams
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	TArray<float> AutoLODsTrianglesRatios;
+
+	// the screen size of the generated LODs is computed for this error (in pixels on a 1080p screen)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	float AutoLODsPixelError;
+
 	FglTFRuntimeSkeletalMeshConfig()
 	{
 		CacheMode = EglTFRuntimeCacheMode::ReadWrite;
@@ -1118,6 +1177,8 @@ struct FglTFRuntimeSkeletalMeshConfig
 		bReverseTangents = false;
 		bAutoGeneratePhysicsAssetBodies = false;
 		bAutoGeneratePhysicsAssetConstraints = false;
+		bOptimizeVertexCache = false;
+		AutoLODsPixelError = 1;
 	}
 };
 
@@ -1346,6 +1407,7 @@ struct FglTFRuntimeSkeletalMeshContext : public FGCObject
 	FBox BoundingBox;
 
 	TMap<int32, FBox> PerBoneBoundingBoxCache;
+	bool bPerBoneBoundingBoxCached;
 
 	// here we cache per-context LODs
 	TArray<FglTFRuntimeMeshLOD> CachedRuntimeMeshLODs;
@@ -1353,6 +1415,8 @@ struct FglTFRuntimeSkeletalMeshContext : public FGCObject
 	// for LOD generators
 	TArray<FglTFRuntimeMeshLOD> ContextLODs;
 	TMap<int32, int32> ContextLODsMap;
+	// screen sizes of the automatically generated LODs
+	TMap<int32, float> GeneratedLODScreenSize;
 
 	FglTFRuntimeSkeletalMeshContext(TSharedRef<FglTFRuntimeParser> InParser, const FglTFRuntimeSkeletalMeshConfig& InSkeletalMeshConfig) : Parser(InParser), SkeletalMeshConfig(InSkeletalMeshConfig)
 	{
@@ -1391,6 +1455,7 @@ struct FglTFRuntimeSkeletalMeshContext : public FGCObject
 		SkeletalMesh->NeverStream = true;
 		BoundingBox = FBox(EForceInit::ForceInitToZero);
 		SkinIndex = -1;
+		bPerBoneBoundingBoxCached = false;
 	}
 
 	FString GetReferencerName() const override
@@ -1516,6 +1581,13 @@ struct FglTFRuntimeSkeletalMeshContext : public FGCObject
 	}
 
 	const FBox& GetBoneBox(const int32 BoneIndex);
+	// fills PerBoneBoundingBoxCache for every bone with a single pass over the vertices
+	void BuildBoneBoxes();
+	// calls BoneBoxFitted (concurrently) for every bone from the same ParallelFor fitting the boxes (or over the cached ones)
+	void ParallelForEachBoneBox(TFunctionRef<void(const int32 BoneIndex, const FBox& Box)> BoneBoxFitted);
+
+private:
+	void BuildBoneBoxes(TFunctionRef<void(const int32 BoneIndex, const FBox& Box)> BoneBoxFitted);
 };
 
 USTRUCT(BlueprintType)
@@ -1558,6 +1630,8 @@ struct FglTFRuntimeStaticMeshContext : public FGCObject
 	TMap<FString, FTransform> AdditionalSockets;
 	TArray<FglTFRuntimeMeshLOD> ContextLODs;
 	TMap<int32, int32> ContextLODsMap;
+	// screen sizes of the automatically generated LODs
+	TMap<int32, float> GeneratedLODScreenSize;
 
 	FglTFRuntimeStaticMeshContext(TSharedRef<FglTFRuntimeParser> InParser, const FglTFRuntimeStaticMeshConfig& InStaticMeshConfig);
 
@@ -1632,6 +1706,17 @@ struct FglTFRuntimeMipMap
 	}
 };
 
+// textures decoded in advance (in parallel) for a batch of meshes, never modified once built so concurrent loads can share it
+struct FglTFRuntimePrefetchedTextures
+{
+	// image index of every texture (OnTextureImageIndex is broadcast only by the prefetch)
+	TMap<int32, int64> TexturesImages;
+	// content of every texture slot (texture index and sRGB): hash of the compressed image and of the color space
+	TMap<TPair<int32, bool>, FSHAHash> TexturesContents;
+	// decoded mips by content, textures with the same image share them
+	TMap<FSHAHash, TArray<FglTFRuntimeMipMap>> ContentsMips;
+};
+
 class FglTFRuntimeTextureMipDataProvider : public FTextureMipDataProvider
 {
 public:
@@ -1835,12 +1920,30 @@ struct FglTFRuntimeMaterial
 	}
 };
 
+class FglTFRuntimeGzipStream;
+
+/**
+ * Random-access zip reader.
+ * Only the central directory is parsed upfront, entries are inflated on demand
+ * (straight into the destination buffer) and can be read concurrently from multiple threads.
+ */
 class FglTFRuntimeZipFile
 {
 public:
-	bool FromData(const uint8* DataPtr, const int64 DataNum);
+	FglTFRuntimeZipFile() : ArchiveSize(0), ArchiveData(nullptr)
+	{
+	}
+
+	// mapped archives are referenced instead of being copied
+	bool FromData(const uint8* DataPtr, const int64 DataNum, TSharedPtr<FglTFRuntimeMappedFile> InMappedFile = nullptr);
+	// the archive is never fully loaded in memory, entries are read from the file when requested
+	bool FromFile(const FString& Filename);
 
 	bool GetFileContent(const FString& Filename, TArray64<uint8>& OutData);
+	// OutData must be able to store at least GetFileSize() bytes
+	bool GetFileContent(const FString& Filename, uint8* OutData, const int64 OutDataNum);
+
+	int64 GetFileSize(const FString& Filename) const;
 
 	bool FileExists(const FString& Filename) const;
 
@@ -1848,12 +1951,34 @@ public:
 
 	void GetItems(TArray<FString>& Items) const
 	{
-		OffsetsMap.GetKeys(Items);
+		EntriesMap.GetKeys(Items);
 	}
 
 protected:
-	TMap<FString, uint32> OffsetsMap;
-	FArrayReader Data;
+	struct FEntry
+	{
+		int64 LocalHeaderOffset;
+		int64 CompressedSize;
+		int64 UncompressedSize;
+		uint32 Crc32;
+		uint16 Compression;
+	};
+
+	bool ParseCentralDirectory();
+	bool ReadEntry(const FEntry& Entry, uint8* OutData);
+	bool ReadBytes(const int64 Offset, uint8* OutData, const int64 Num);
+
+	TMap<FString, FEntry> EntriesMap;
+	int64 ArchiveSize;
+
+	// in-memory archives (owned or mapped)
+	const uint8* ArchiveData;
+	TArray64<uint8> Data;
+	TSharedPtr<FglTFRuntimeMappedFile> MappedFile;
+
+	// file-backed archives share a single handle, so only the raw reads are serialized
+	TUniquePtr<IFileHandle> FileHandle;
+	FCriticalSection FileHandleLock;
 };
 
 USTRUCT(BlueprintType)
@@ -1953,11 +2078,14 @@ class GLTFRUNTIME_API FglTFRuntimeParser : public FGCObject, public TSharedFromT
 {
 public:
 	FglTFRuntimeParser(TSharedRef<FJsonObject> JsonObject, const FMatrix& InSceneBasis, float InSceneScale);
+	FglTFRuntimeParser(TSharedRef<FglTFRuntimeJsonTape> InJsonTape, const FMatrix& InSceneBasis, float InSceneScale);
 
 	static TSharedPtr<FglTFRuntimeParser> FromFilename(const FString& Filename, const FglTFRuntimeConfig& LoaderConfig);
-	static TSharedPtr<FglTFRuntimeParser> FromBinary(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeZipFile> InZipFile = nullptr);
+	static TSharedPtr<FglTFRuntimeParser> FromBinary(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeZipFile> InZipFile = nullptr, TSharedPtr<FglTFRuntimeMappedFile> InMappedFile = nullptr);
 	static TSharedPtr<FglTFRuntimeParser> FromString(const FString& JsonData, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeZipFile> InZipFile = nullptr);
-	static TSharedPtr<FglTFRuntimeParser> FromData(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig);
+	static TSharedPtr<FglTFRuntimeParser> FromData(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeMappedFile> InMappedFile = nullptr);
+	static TSharedPtr<FglTFRuntimeParser> FromJsonTape(TSharedRef<FglTFRuntimeJsonTape> InJsonTape, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeZipFile> InZipFile = nullptr);
+	static TSharedPtr<FglTFRuntimeParser> FromZipFile(TSharedRef<FglTFRuntimeZipFile> InZipFile, const FglTFRuntimeConfig& LoaderConfig);
 
 	static FORCEINLINE TSharedPtr<FglTFRuntimeParser> FromBinary(const TArray<uint8> Data, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeZipFile> InZipFile = nullptr) { return FromBinary(Data.GetData(), Data.Num(), LoaderConfig, InZipFile); }
 	static FORCEINLINE TSharedPtr<FglTFRuntimeParser> FromBinary(const TArray64<uint8> Data, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeZipFile> InZipFile = nullptr) { return FromBinary(Data.GetData(), Data.Num(), LoaderConfig, InZipFile); }
@@ -1984,6 +2112,10 @@ public:
 	UMaterialInterface* LoadMaterial(const int32 MaterialIndex, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const bool bUseVertexColors, FString& MaterialName);
 	UTexture2D* LoadTexture(const int32 TextureIndex, TArray<FglTFRuntimeMipMap>& Mips, const bool sRGB, const FglTFRuntimeMaterialsConfig& MaterialsConfig, FglTFRuntimeTextureSampler& Sampler);
 
+	// decodes in parallel the textures of the materials of the given meshes into MaterialsConfig.PrefetchedTextures,
+	// the meshes loaded with that config (for example all the meshes of a scene) take them from there
+	void PrefetchMeshesTextures(const TArray<int32>& MeshesIndices, FglTFRuntimeMaterialsConfig& MaterialsConfig);
+
 	bool LoadNodes();
 	bool LoadNode(const int32 NodeIndex, FglTFRuntimeNode& Node);
 	bool LoadNodeByName(const FString& NodeName, FglTFRuntimeNode& Node);
@@ -2003,6 +2135,8 @@ public:
 
 	void LoadSkeletalMeshAsync(const int32 MeshIndex, const int32 SkinIndex, const FglTFRuntimeSkeletalMeshAsync& AsyncCallback, const FglTFRuntimeSkeletalMeshConfig& SkeletalMeshConfig);
 	void LoadStaticMeshAsync(const int32 MeshIndex, const FglTFRuntimeStaticMeshAsync& AsyncCallback, const FglTFRuntimeStaticMeshConfig& StaticMeshConfig);
+	// native variant (the callback is called in the game thread), multiple loads can be in flight concurrently
+	void LoadStaticMeshAsync(const int32 MeshIndex, TFunction<void(UStaticMesh*)> AsyncCallback, const FglTFRuntimeStaticMeshConfig& StaticMeshConfig);
 
 	void LoadStaticMeshLODsAsync(const TArray<int32>& MeshIndices, const FglTFRuntimeStaticMeshAsync& AsyncCallback, const FglTFRuntimeStaticMeshConfig& StaticMeshConfig);
 
@@ -2061,6 +2195,22 @@ public:
 	void SetBinaryBuffer(const TArray64<uint8>& InBinaryBuffer)
 	{
 		BinaryBuffer = InBinaryBuffer;
+		BinaryMappedFile.Reset();
+	}
+
+	void SetBinaryBuffer(TArray64<uint8>&& InBinaryBuffer)
+	{
+		BinaryBuffer = MoveTemp(InBinaryBuffer);
+		BinaryMappedFile.Reset();
+	}
+
+	// the binary chunk is accessed directly from the mapped file
+	void SetBinaryBuffer(TSharedRef<FglTFRuntimeMappedFile> InMappedFile, const uint8* DataPtr, const int64 DataNum)
+	{
+		BinaryBuffer.Empty();
+		BinaryMappedFile = InMappedFile;
+		BinaryMappedBlob.Data = const_cast<uint8*>(DataPtr);
+		BinaryMappedBlob.Num = DataNum;
 	}
 
 	bool LoadStaticMeshIntoProceduralMeshComponent(const int32 MeshIndex, UProceduralMeshComponent* ProceduralMeshComponent, const FglTFRuntimeProceduralMeshConfig& ProceduralMeshConfig);
@@ -2103,7 +2253,11 @@ public:
 
 	TArray<FString> MaterialsVariants;
 
-	TSharedPtr<FJsonObject> GetJsonRoot() const { return Root; }
+	/**
+	 * The returned tree can be changed: the parser flattens it again before its next lookup.
+	 * Call it again after changing a tree obtained before the last load.
+	 */
+	TSharedPtr<FJsonObject> GetJsonRoot() const;
 
 	static FVector4 CubicSpline(const float TC, const float T0, const float T1, const FVector4 Value0, const FVector4 OutTangent, const FVector4 Value1, const FVector4 InTangent);
 
@@ -2118,6 +2272,7 @@ public:
 	TSharedPtr<FJsonObject> GetJsonObjectExtension(TSharedRef<FJsonObject> JsonObject, const FString& Name) const;
 	int64 GetJsonObjectIndex(TSharedRef<FJsonObject> JsonObject, const FString& Name) const;
 
+	// the primitive objects passed to these delegates are copies built from the parsed document
 	static FglTFRuntimeOnLoadedPrimitive OnPreLoadedPrimitive;
 	static FglTFRuntimeOnLoadedPrimitive OnLoadedPrimitive;
 	static FglTFRuntimeOnLoadedRefSkeleton OnLoadedRefSkeleton;
@@ -2204,7 +2359,24 @@ public:
 
 protected:
 	void LoadAndFillBaseMaterials();
-	TSharedRef<FJsonObject> Root;
+	void InitializeFromJsonRoot();
+
+	// loaders read from the tape, the FJsonObject tree is built only when required (extensions, extras, delegates, custom queries...)
+	TSharedRef<FJsonObject> GetJsonRootObject() const;
+	// node indices are valid only for the returned tape, so keep it for the whole lookup
+	TSharedRef<FglTFRuntimeJsonTape> GetJsonTape() const;
+	bool GetCachedBuffer(const int32 Index, FglTFRuntimeBlob& Blob);
+	void AddCachedBuffer(const int32 Index, TArray64<uint8>&& Buffer, FglTFRuntimeBlob& Blob);
+	int32 GetJsonRootArrayNum(const ANSICHAR* FieldName) const;
+	bool HasJsonRootObject(const ANSICHAR* FieldName, const int32 Index) const;
+
+	mutable TSharedRef<FglTFRuntimeJsonTape> CurrentJsonTape;
+	// set when the tree has been handed to the user, who could have changed it
+	mutable bool bJsonTapeStale;
+	mutable TSharedPtr<FJsonObject> Root;
+	// root array items materialized from the tape, shared with the Root tree for keeping identity stable
+	mutable TMap<FString, TArray<TSharedPtr<FJsonObject>>> JsonRootItemsCache;
+	mutable FCriticalSection JsonRootLock;
 
 	TMap<int32, UStaticMesh*> StaticMeshesCache;
 	TMap<int32, UMaterialInterface*> MaterialsCache;
@@ -2212,7 +2384,14 @@ protected:
 	TMap<int32, USkeletalMesh*> SkeletalMeshesCache;
 	TMap<int32, UTexture2D*> TexturesCache;
 
+	// guards MaterialsCache, MaterialsNameCache and TexturesCache (primitives of async loads resolve their materials concurrently)
+	FCriticalSection MaterialsCacheLock;
+
+	// guards BuffersCache, MappedBuffersCache and the decompressed buffer views (async loads fill them concurrently)
+	FCriticalSection BuffersCacheLock;
 	TMap<int32, TArray64<uint8>> BuffersCache;
+	// identity of the source of each buffer (external file stat or embedded content), for the derived data keys
+	TMap<int32, FSHAHash> BuffersIdentitiesCache;
 	TMap<int32, TArray64<uint8>> CompressedBufferViewsCache;
 	TMap<int32, int64> CompressedBufferViewsStridesCache;
 
@@ -2221,23 +2400,59 @@ protected:
 	TArray<FglTFRuntimeNode> AllNodesCache;
 	bool bAllNodesCached;
 
-	TMap<TSharedRef<FJsonObject>, FglTFRuntimeMeshLOD> LODsCache;
+	// flattened nodes hierarchy (built by LoadNodes), indexed by node index
+	TArray<FTransform> NodesWorldTransformsCache;
+	TArray<int32> NodesDepthCache;
+	// first and last position of each node in the Euler tour (INDEX_NONE for nodes not reachable from a root)
+	TArray<int32> NodesEulerFirstCache;
+	TArray<int32> NodesEulerLastCache;
+	TArray<int32> NodesEulerTourCache;
+	// sparse table of the shallowest node in each power-of-two range of the Euler tour (for O(1) LCA queries)
+	TArray<int32> NodesEulerSparseTableCache;
+
+	// LODs are heap allocated so their address is stable while other threads add to the cache
+	TMap<int32, TUniquePtr<FglTFRuntimeMeshLOD>> LODsCache;
+	FCriticalSection LODsCacheLock;
 
 	TArray64<uint8> BinaryBuffer;
 
-	bool LoadMeshIntoMeshLOD(TSharedRef<FJsonObject> JsonMeshObject, FglTFRuntimeMeshLOD*& LOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
+	// blobs pointing to mapped files must never be written to
+	TSharedPtr<FglTFRuntimeMappedFile> BinaryMappedFile;
+	FglTFRuntimeBlob BinaryMappedBlob;
+	TMap<int32, TSharedPtr<FglTFRuntimeMappedFile>> MappedBuffersCache;
+	bool bUseMemoryMappedFiles;
+
+	TSharedPtr<FglTFRuntimeDerivedDataCache> DerivedDataCache;
+
+	// gzipped glTF binaries are inflated chunk by chunk, without an intermediate copy of the whole file
+	static TSharedPtr<FglTFRuntimeParser> FromBinaryStream(FglTFRuntimeGzipStream& Stream, const int64 DataNum, const FglTFRuntimeConfig& LoaderConfig);
+	static TSharedPtr<FglTFRuntimeParser> FromUncompressedData(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeZipFile> InZipFile, TSharedPtr<FglTFRuntimeMappedFile> InMappedFile);
+	bool LoadPrimitives(const int32 MeshIndex, TArray<FglTFRuntimePrimitive>& Primitives, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
+	bool LoadPrimitives(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonMeshNode, TArray<FglTFRuntimePrimitive>& Primitives, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
+	bool LoadPrimitive(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonPrimitiveNode, FglTFRuntimePrimitive& Primitive, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
+	bool GetPrimitiveDerivedDataKey(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonPrimitiveNode, FSHAHash& Key);
+	bool GetBufferIdentity(const int32 Index, FSHAHash& Identity);
+	// GenerateTangents() backed by the derived data cache (when enabled)
+	void LoadOrGenerateTangents(const TArray<FVector3f>& Positions, const TArray<FVector3f>& Normals, const TArray<FVector2f>& UVs, const TArray<uint32>& Keys, TArray<FVector4f>& Tangents);
+	bool LoadPrimitiveGeometry(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonPrimitiveNode, FglTFRuntimePrimitive& Primitive);
+
+	bool LoadMeshIntoMeshLOD(const int32 MeshIndex, FglTFRuntimeMeshLOD*& LOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
+
+	TSharedRef<const FglTFRuntimePrefetchedTextures> PrefetchMaterialsTextures(const TArray<int32>& MaterialsIndices, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
+	void GetMeshMaterials(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonMeshNode, TArray<int32>& MaterialsIndices) const;
 
 	UStaticMesh* LoadStaticMesh_Internal(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext);
-	UMaterialInterface* LoadMaterial_Internal(const int32 Index, const FString& MaterialName, TSharedRef<FJsonObject> JsonMaterialObject, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const bool bUseVertexColors);
-	bool LoadNode_Internal(int32 Index, TSharedRef<FJsonObject> JsonNodeObject, int32 NodesCount, FglTFRuntimeNode& Node);
+	UMaterialInterface* LoadMaterial_Internal(const int32 Index, const FString& MaterialName, const FglTFRuntimeJsonTape& JsonTape, const int32 JsonMaterialNode, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const bool bUseVertexColors);
+	bool LoadNode_Internal(int32 Index, const FglTFRuntimeJsonTape& JsonTape, const int32 JsonNodeNode, int32 NodesCount, FglTFRuntimeNode& Node);
 
-	bool LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject> JsonAnimationObject, TMap<FString, FRawAnimSequenceTrack>& Tracks, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, float& Duration, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, TFunctionRef<bool(const FglTFRuntimeNode& Node)> Filter);
+	bool LoadSkeletalAnimation_Internal(const int32 AnimationIndex, TMap<FString, FRawAnimSequenceTrack>& Tracks, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, float& Duration, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, TFunctionRef<bool(const FglTFRuntimeNode& Node)> Filter);
 
-	bool LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnimationObject, float& Duration, FString& Name, TFunctionRef<void(const FglTFRuntimeNode& Node, const FString& Path, const FglTFRuntimeAnimationCurve& Curve)> Callback, TFunctionRef<bool(const FglTFRuntimeNode& Node)> NodeFilter, const TArray<FglTFRuntimePathItem>& OverrideTrackNameFromExtension);
+	bool LoadAnimation_Internal(const int32 AnimationIndex, float& Duration, FString& Name, TFunctionRef<void(const FglTFRuntimeNode& Node, const FString& Path, const FglTFRuntimeAnimationCurve& Curve)> Callback, TFunctionRef<bool(const FglTFRuntimeNode& Node)> NodeFilter, const TArray<FglTFRuntimePathItem>& OverrideTrackNameFromExtension);
 
 	USkeletalMesh* CreateSkeletalMeshFromLODs(TSharedRef<FglTFRuntimeSkeletalMeshContext, ESPMode::ThreadSafe> SkeletalMeshContext);
 
-	bool FillReferenceSkeleton(TSharedRef<FJsonObject> JsonSkinObject, FReferenceSkeleton& RefSkeleton, TMap<int32, FName>& BoneMap, const FglTFRuntimeSkeletonConfig& SkeletonConfig);
+	bool GetRootBoneIndex(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonSkinNode, int64& RootBoneIndex, TArray<int32>& Joints, const FglTFRuntimeSkeletonConfig& SkeletonConfig);
+	bool FillReferenceSkeleton(const int32 SkinIndex, FReferenceSkeleton& RefSkeleton, TMap<int32, FName>& BoneMap, const FglTFRuntimeSkeletonConfig& SkeletonConfig);
 	bool FillReferenceSkeletonFromNode(const FglTFRuntimeNode& RootNode, FReferenceSkeleton& RefSkeleton, TMap<int32, FName>& BoneMap, const FglTFRuntimeSkeletonConfig& SkeletonConfig);
 	bool FillFakeSkeleton(FReferenceSkeleton& RefSkeleton, TMap<int32, FName>& BoneMap, const FglTFRuntimeSkeletalMeshConfig& SkeletalMeshConfig);
 	bool FillLODSkeleton(FReferenceSkeleton& RefSkeleton, TMap<int32, FName>& BoneMap, const TArray<FglTFRuntimeBone>& Skeleton);
@@ -2245,7 +2460,9 @@ protected:
 
 	bool GetMorphTargetNames(const int32 MeshIndex, TArray<FName>& MorphTargetNames);
 
-	void FixNodeParent(FglTFRuntimeNode& Node);
+	void BuildNodesHierarchy();
+	bool IsNodeAncestor(const int32 NodeIndex, const int32 AncestorIndex) const;
+	int32 FindLowestCommonAncestor(const int32 NodeIndexA, const int32 NodeIndexB) const;
 
 	int32 FindCommonRoot(const TArray<int32>& NodeIndices);
 	int32 FindTopRoot(int32 NodeIndex);
@@ -2258,13 +2475,13 @@ public:
 	UMaterialInterface* BuildVertexColorOnlyMaterial(const FglTFRuntimeMaterialsConfig& MaterialsConfig);
 
 	bool CheckJsonIndex(TSharedRef<FJsonObject> JsonObject, const FString& FieldName, const int32 Index, TArray<TSharedRef<FJsonValue>>& JsonItems);
-	bool CheckJsonRootIndex(const FString FieldName, const int32 Index, TArray<TSharedRef<FJsonValue>>& JsonItems) { return CheckJsonIndex(Root, FieldName, Index, JsonItems); }
+	bool CheckJsonRootIndex(const FString FieldName, const int32 Index, TArray<TSharedRef<FJsonValue>>& JsonItems) { return CheckJsonIndex(GetJsonRootObject(), FieldName, Index, JsonItems); }
 	TSharedPtr<FJsonObject> GetJsonObjectFromIndex(TSharedRef<FJsonObject> JsonObject, const FString& FieldName, const int32 Index);
-	TSharedPtr<FJsonObject> GetJsonObjectFromRootIndex(const FString& FieldName, const int32 Index) { return GetJsonObjectFromIndex(Root, FieldName, Index); }
+	TSharedPtr<FJsonObject> GetJsonObjectFromRootIndex(const FString& FieldName, const int32 Index) const;
 	TSharedPtr<FJsonObject> GetJsonObjectFromExtensionIndex(TSharedRef<FJsonObject> JsonObject, const FString& ExtensionName, const FString& FieldName, const int32 Index);
-	TSharedPtr<FJsonObject> GetJsonObjectFromRootExtensionIndex(const FString& ExtensionName, const FString& FieldName, const int32 Index) { return GetJsonObjectFromExtensionIndex(Root, ExtensionName, FieldName, Index); }
+	TSharedPtr<FJsonObject> GetJsonObjectFromRootExtensionIndex(const FString& ExtensionName, const FString& FieldName, const int32 Index) { return GetJsonObjectFromExtensionIndex(GetJsonRootObject(), ExtensionName, FieldName, Index); }
 	TArray<TSharedRef<FJsonObject>> GetJsonObjectArrayFromExtension(TSharedRef<FJsonObject> JsonObject, const FString& ExtensionName, const FString& FieldName);
-	TArray<TSharedRef<FJsonObject>> GetJsonObjectArrayFromRootExtension(const FString& ExtensionName, const FString& FieldName) { return GetJsonObjectArrayFromExtension(Root, ExtensionName, FieldName); }
+	TArray<TSharedRef<FJsonObject>> GetJsonObjectArrayFromRootExtension(const FString& ExtensionName, const FString& FieldName) { return GetJsonObjectArrayFromExtension(GetJsonRootObject(), ExtensionName, FieldName); }
 
 
 	bool GetJsonObjectBytes(TSharedRef<FJsonObject> JsonObject, TArray64<uint8>& Bytes);
@@ -2280,10 +2497,14 @@ public:
 
 	void CopySkeletonLocationsFrom(FReferenceSkeleton& RefSkeleton, const FReferenceSkeleton& SrcRefSkeleton);
 
+	static float FindBestFrames(const TArray<float>& FramesTimes, float WantedTime, int32& FirstIndex, int32& SecondIndex);
+	// sequential sampling, Cursor (initialized to 0) keeps the position between calls with non-decreasing WantedTime
+	static float FindBestFrames(const TArray<float>& FramesTimes, float WantedTime, int32& FirstIndex, int32& SecondIndex, int32& Cursor);
+
 protected:
 	bool FillJsonMatrix(const TArray<TSharedPtr<FJsonValue>>* JsonMatrixValues, FMatrix& Matrix);
 
-	float FindBestFrames(const TArray<float>& FramesTimes, float WantedTime, int32& FirstIndex, int32& SecondIndex);
+	static float GetBestFramesAlpha(const TArray<float>& FramesTimes, float WantedTime, const int32 FoundIndex, int32& FirstIndex, int32& SecondIndex);
 
 	void NormalizeSkeletonScale(FReferenceSkeleton& RefSkeleton);
 	void NormalizeSkeletonBoneScale(FReferenceSkeletonModifier& Modifier, const int32 BoneIndex, FVector BoneScale);
@@ -2297,8 +2518,6 @@ protected:
 	bool CanReadFromCache(const EglTFRuntimeCacheMode CacheMode) { return CacheMode == EglTFRuntimeCacheMode::Read || CacheMode == EglTFRuntimeCacheMode::ReadWrite; }
 	bool CanWriteToCache(const EglTFRuntimeCacheMode CacheMode) { return CacheMode == EglTFRuntimeCacheMode::Write || CacheMode == EglTFRuntimeCacheMode::ReadWrite; }
 
-	bool DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, const int64 Stride, const int64 Elements, const FString& Mode, const FString& Filter, TArray64<uint8>& UncompressedBytes);
-
 	FMatrix SceneBasis;
 	float SceneScale;
 
@@ -2310,6 +2529,8 @@ protected:
 	TMap<EglTFRuntimeMaterialType, UMaterialInterface*> RampMetallicRoughnessMaterialsMap;
 
 	TArray<FString> Errors;
+	// errors can be reported by parallel decoding tasks
+	FCriticalSection ErrorsLock;
 
 	FString BaseDirectory;
 
@@ -2331,20 +2552,191 @@ public:
 		return FTransform(SceneBasis.Inverse() * M * SceneBasis);
 	}
 
-	template<typename T, typename Callback>
-	bool BuildFromAccessorField(TSharedRef<FJsonObject> JsonObject, const FString& Name, TArray<T>& Data, const TArray<int64>& SupportedElements, const TArray<int64>& SupportedTypes, Callback Filter, const int64 AdditionalBufferView, const bool bDefaultNormalized, int64* ComponentTypePtr)
+public:
+	// convert tightly packed components to float with the same results of the per component formulas (vectorized where available)
+	static void DecodeAccessorComponents(const int8* Components, const int64 Num, const bool bNormalized, float* Values);
+	static void DecodeAccessorComponents(const uint8* Components, const int64 Num, const bool bNormalized, float* Values);
+	static void DecodeAccessorComponents(const int16* Components, const int64 Num, const bool bNormalized, float* Values);
+	static void DecodeAccessorComponents(const uint16* Components, const int64 Num, const bool bNormalized, float* Values);
+	static void DecodeAccessorComponents(const float* Components, const int64 Num, const bool bNormalized, float* Values);
+
+	// widen tightly packed indices to uint32
+	static void DecodeIndices(const uint8* Indices, const int64 Num, uint32* Values);
+	static void DecodeIndices(const uint16* Indices, const int64 Num, uint32* Values);
+	static void DecodeIndices(const uint32* Indices, const int64 Num, uint32* Values);
+
+	// flat normals of a triangle list (every triangle has its own 3 corners)
+	static void GenerateFlatNormals(const TArray<FVector3f>& Positions, TArray<FVector3f>& Normals, const bool bForceSingleThread = false);
+	// MikkTSpace style tangents of a triangle list: the corners with the same key (the source vertex) and the same handedness share the sum of their
+	// angle weighted tangents, W is the handedness (the bitangent is Normal ^ Tangent * W). The sums follow the corners order, so the results are the same with any number of threads.
+	static void GenerateTangents(const TArray<FVector3f>& Positions, const TArray<FVector3f>& Normals, const TArray<FVector2f>& UVs, const TArray<uint32>& Keys, TArray<FVector4f>& Tangents, const bool bForceSingleThread = false);
+
+	// EXT_meshopt_compression buffer view decoder (vectorized where available, bForceScalar runs the scalar reference paths)
+	bool DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, const int64 Stride, const int64 Elements, const FString& Mode, const FString& Filter, TArray64<uint8>& UncompressedBytes, const bool bForceScalar = false);
+
+	// 2x2 box filter of a BGRA8 mip into the next level (Width / 2 x Height / 2, at least 1), sRGB colors are averaged in linear space,
+	// linear ones are vectorized where available (bForceScalar runs the scalar reference path, the results are the same)
+	static void DownsampleMipMap(const FColor* Pixels, const int32 Width, const int32 Height, FColor* MipPixels, const bool sRGB, const bool bForceScalar = false);
+
+protected:
+	static bool IsSupportedAccessorComponentType(const int64 ComponentType)
 	{
-		int64 AccessorIndex;
-		if (!JsonObject->TryGetNumberField(Name, AccessorIndex))
+		return ComponentType == 5126 || ComponentType == 5120 || ComponentType == 5121 || ComponentType == 5122 || ComponentType == 5123;
+	}
+
+	// same conversions (and same float rounding) as the glTF normalized integers specs
+	static FORCEINLINE float DecodeAccessorComponent(const float Value, const bool bNormalized) { return Value; }
+	static FORCEINLINE float DecodeAccessorComponent(const int8 Value, const bool bNormalized) { return bNormalized ? FMath::Max(((float)Value) / 127.f, -1.f) : Value; }
+	static FORCEINLINE float DecodeAccessorComponent(const uint8 Value, const bool bNormalized) { return bNormalized ? ((float)Value) / 255.f : Value; }
+	static FORCEINLINE float DecodeAccessorComponent(const int16 Value, const bool bNormalized) { return bNormalized ? FMath::Max(((float)Value) / 32767.f, -1.f) : Value; }
+	static FORCEINLINE float DecodeAccessorComponent(const uint16 Value, const bool bNormalized) { return bNormalized ? ((float)Value) / 65535.f : Value; }
+
+	// number of components stored in T, based on the type returned by its operator[] (so FVector counts 3 components both with and without large world coordinates)
+	template<typename T>
+	struct TAccessorValueComponents
+	{
+		static constexpr int32 Value = sizeof(T) / sizeof(typename TRemoveReference<decltype(DeclVal<T&>()[0])>::Type);
+	};
+
+	// number of floats converted at once by the vectorized kernels (kept on the stack)
+	static constexpr int32 AccessorBlockSize = 1024;
+
+	// NumElements == 0 means the number of elements is known only at runtime, bNormalized is a template parameter so the branch is resolved once per accessor
+	template<typename T, typename ComponentType, bool bNormalized, int32 NumElements, typename Callback>
+	static void DecodeAccessorElements(const uint8* BlobData, const int64 Stride, const int64 Count, const int64 Elements, T* Values, Callback& Filter)
+	{
+		const int32 ElementsNum = NumElements > 0 ? NumElements : static_cast<int32>(Elements);
+
+		// tightly packed integer components are converted to float a block at a time by the vectorized kernels
+		if (!TIsSame<ComponentType, float>::Value && Stride == ElementsNum * static_cast<int64>(sizeof(ComponentType)) && ElementsNum > 0 && ElementsNum <= AccessorBlockSize)
 		{
-			return false;
+			float Block[AccessorBlockSize];
+			const int64 BlockCount = AccessorBlockSize / ElementsNum;
+			const ComponentType* Components = reinterpret_cast<const ComponentType*>(BlobData);
+			for (int64 FirstElementIndex = 0; FirstElementIndex < Count; FirstElementIndex += BlockCount)
+			{
+				const int64 BlockElements = FMath::Min(BlockCount, Count - FirstElementIndex);
+				DecodeAccessorComponents(Components + FirstElementIndex * ElementsNum, BlockElements * ElementsNum, bNormalized, Block);
+				for (int64 ElementIndex = 0; ElementIndex < BlockElements; ElementIndex++)
+				{
+					T Value;
+					for (int32 i = 0; i < ElementsNum; i++)
+					{
+						Value[i] = Block[ElementIndex * ElementsNum + i];
+					}
+					Values[FirstElementIndex + ElementIndex] = Filter(Value);
+				}
+			}
+			return;
+		}
+
+		for (int64 ElementIndex = 0; ElementIndex < Count; ElementIndex++)
+		{
+			const ComponentType* Ptr = reinterpret_cast<const ComponentType*>(BlobData + ElementIndex * Stride);
+			T Value;
+			for (int32 i = 0; i < ElementsNum; i++)
+			{
+				Value[i] = DecodeAccessorComponent(Ptr[i], bNormalized);
+			}
+			Values[ElementIndex] = Filter(Value);
 		}
+	}
 
+	template<typename T, typename ComponentType, bool bNormalized, typename Callback>
+	static void DecodeAccessorScalars(const uint8* BlobData, const int64 Stride, const int64 Count, T* Values, Callback& Filter)
+	{
+		if (!TIsSame<ComponentType, float>::Value && Stride == sizeof(ComponentType))
+		{
+			float Block[AccessorBlockSize];
+			const ComponentType* Components = reinterpret_cast<const ComponentType*>(BlobData);
+			for (int64 FirstElementIndex = 0; FirstElementIndex < Count; FirstElementIndex += AccessorBlockSize)
+			{
+				const int64 BlockElements = FMath::Min<int64>(AccessorBlockSize, Count - FirstElementIndex);
+				DecodeAccessorComponents(Components + FirstElementIndex, BlockElements, bNormalized, Block);
+				for (int64 ElementIndex = 0; ElementIndex < BlockElements; ElementIndex++)
+				{
+					T Value = Block[ElementIndex];
+					Values[FirstElementIndex + ElementIndex] = Filter(Value);
+				}
+			}
+			return;
+		}
+
+		for (int64 ElementIndex = 0; ElementIndex < Count; ElementIndex++)
+		{
+			const ComponentType* Ptr = reinterpret_cast<const ComponentType*>(BlobData + ElementIndex * Stride);
+			T Value = DecodeAccessorComponent(*Ptr, bNormalized);
+			Values[ElementIndex] = Filter(Value);
+		}
+	}
+
+	template<typename T, typename ComponentType, bool bNormalized, bool bScalar, typename Callback>
+	static typename TEnableIf<bScalar>::Type DecodeAccessorByElements(const uint8* BlobData, const int64 Stride, const int64 Count, const int64 Elements, T* Values, Callback& Filter)
+	{
+		DecodeAccessorScalars<T, ComponentType, bNormalized>(BlobData, Stride, Count, Values, Filter);
+	}
+
+	template<typename T, typename ComponentType, bool bNormalized, bool bScalar, typename Callback>
+	static typename TEnableIf<!bScalar>::Type DecodeAccessorByElements(const uint8* BlobData, const int64 Stride, const int64 Count, const int64 Elements, T* Values, Callback& Filter)
+	{
+		// the unrolled kernels are instantiated only for element counts fitting in T
+		switch (Elements)
+		{
+		case 2:
+			DecodeAccessorElements<T, ComponentType, bNormalized, (TAccessorValueComponents<T>::Value >= 2 ? 2 : 0)>(BlobData, Stride, Count, Elements, Values, Filter);
+			break;
+		case 3:
+			DecodeAccessorElements<T, ComponentType, bNormalized, (TAccessorValueComponents<T>::Value >= 3 ? 3 : 0)>(BlobData, Stride, Count, Elements, Values, Filter);
+			break;
+		case 4:
+			DecodeAccessorElements<T, ComponentType, bNormalized, (TAccessorValueComponents<T>::Value >= 4 ? 4 : 0)>(BlobData, Stride, Count, Elements, Values, Filter);
+			break;
+		default:
+			DecodeAccessorElements<T, ComponentType, bNormalized, 0>(BlobData, Stride, Count, Elements, Values, Filter);
+			break;
+		}
+	}
+
+	// the kernel is selected once per accessor instead of per element
+	template<typename T, bool bNormalized, bool bScalar, typename Callback>
+	static void DecodeAccessorByComponentType(const int64 ComponentType, const uint8* BlobData, const int64 Stride, const int64 Count, const int64 Elements, T* Values, Callback& Filter)
+	{
+		switch (ComponentType)
+		{
+			// FLOAT (normalization does not apply)
+		case 5126:
+			DecodeAccessorByElements<T, float, false, bScalar>(BlobData, Stride, Count, Elements, Values, Filter);
+			break;
+			// BYTE
+		case 5120:
+			DecodeAccessorByElements<T, int8, bNormalized, bScalar>(BlobData, Stride, Count, Elements, Values, Filter);
+			break;
+			// UNSIGNED_BYTE
+		case 5121:
+			DecodeAccessorByElements<T, uint8, bNormalized, bScalar>(BlobData, Stride, Count, Elements, Values, Filter);
+			break;
+			// SHORT
+		case 5122:
+			DecodeAccessorByElements<T, int16, bNormalized, bScalar>(BlobData, Stride, Count, Elements, Values, Filter);
+			break;
+			// UNSIGNED_SHORT
+		case 5123:
+			DecodeAccessorByElements<T, uint16, bNormalized, bScalar>(BlobData, Stride, Count, Elements, Values, Filter);
+			break;
+		default:
+			break;
+		}
+	}
+
+public:
+	template<typename T, typename Callback>
+	bool BuildFromAccessorIndex(const int64 AccessorIndex, TArray<T>& Data, const TArray<int64>& SupportedElements, const TArray<int64>& SupportedTypes, Callback Filter, const FglTFRuntimeBlob* AdditionalBufferView, const bool bDefaultNormalized, int64* ComponentTypePtr)
+	{
 		FglTFRuntimeBlob Blob;
 		int64 ComponentType = 0, Stride = 0, Elements = 0, ElementSize = 0, Count = 0;
 		bool bNormalized = bDefaultNormalized;
 
-		if (!GetAccessor(AccessorIndex, ComponentType, Stride, Elements, ElementSize, Count, bNormalized, Blob, GetAdditionalBufferView(AdditionalBufferView, Name)))
+		if (!GetAccessor(AccessorIndex, ComponentType, Stride, Elements, ElementSize, Count, bNormalized, Blob, AdditionalBufferView))
 		{
 			return false;
 		}
@@ -2364,83 +2756,33 @@ public:
 			*ComponentTypePtr = ComponentType;
 		}
 
-		Data.AddUninitialized(Count);
-		for (int64 ElementIndex = 0; ElementIndex < Count; ElementIndex++)
+		if (!IsSupportedAccessorComponentType(ComponentType))
 		{
-			int64 Index = ElementIndex * Stride;
-			T Value;
-			// FLOAT
-			if (ComponentType == 5126)
-			{
-				float* Ptr = (float*)&(Blob.Data[Index]);
-				for (int32 i = 0; i < Elements; i++)
-				{
-					Value[i] = Ptr[i];
-				}
-			}
-			// BYTE
-			else if (ComponentType == 5120)
-			{
-				int8* Ptr = (int8*)&(Blob.Data[Index]);
-				for (int32 i = 0; i < Elements; i++)
-				{
-					Value[i] = bNormalized ? FMath::Max(((float)Ptr[i]) / 127.f, -1.f) : Ptr[i];
-				}
-
-			}
-			// UNSIGNED_BYTE
-			else if (ComponentType == 5121)
-			{
-				uint8* Ptr = (uint8*)&(Blob.Data[Index]);
-				for (int32 i = 0; i < Elements; i++)
-				{
-					Value[i] = bNormalized ? ((float)Ptr[i]) / 255.f : Ptr[i];
-				}
-			}
-			// SHORT
-			else if (ComponentType == 5122)
-			{
-				int16* Ptr = (int16*)&(Blob.Data[Index]);
-				for (int32 i = 0; i < Elements; i++)
-				{
-					Value[i] = bNormalized ? FMath::Max(((float)Ptr[i]) / 32767.f, -1.f) : Ptr[i];
-				}
-			}
-			// UNSIGNED_SHORT
-			else if (ComponentType == 5123)
-			{
-				uint16* Ptr = (uint16*)&(Blob.Data[Index]);
-				for (int32 i = 0; i < Elements; i++)
-				{
-					Value[i] = bNormalized ? ((float)Ptr[i]) / 65535.f : Ptr[i];
-				}
-			}
-			else
-			{
-				UE_LOG(LogGLTFRuntime, Error, TEXT("Unsupported type %d"), ComponentType);
-				return false;
-			}
+			UE_LOG(LogGLTFRuntime, Error, TEXT("Unsupported type %d"), ComponentType);
+			return false;
+		}
 
-			Data[ElementIndex] = Filter(Value);
+		const int64 FirstElement = Data.AddUninitialized(Count);
+		if (bNormalized)
+		{
+			DecodeAccessorByComponentType<T, true, false>(ComponentType, Blob.Data, Stride, Count, Elements, Data.GetData() + FirstElement, Filter);
+		}
+		else
+		{
+			DecodeAccessorByComponentType<T, false, false>(ComponentType, Blob.Data, Stride, Count, Elements, Data.GetData() + FirstElement, Filter);
 		}
 
 		return true;
 	}
 
 	template<typename T, typename Callback>
-	bool BuildFromAccessorField(TSharedRef<FJsonObject> JsonObject, const FString& Name, TArray<T>& Data, const TArray<int64>& SupportedTypes, Callback Filter, const int64 AdditionalBufferView, const bool bDefaultNormalized, int64* ComponentTypePtr)
+	bool BuildFromAccessorIndex(const int64 AccessorIndex, TArray<T>& Data, const TArray<int64>& SupportedTypes, Callback Filter, const FglTFRuntimeBlob* AdditionalBufferView, const bool bDefaultNormalized, int64* ComponentTypePtr)
 	{
-		int64 AccessorIndex;
-		if (!JsonObject->TryGetNumberField(Name, AccessorIndex))
-		{
-			return false;
-		}
-
 		FglTFRuntimeBlob Blob;
 		int64 ComponentType, Stride, Elements, ElementSize, Count;
 		bool bNormalized = bDefaultNormalized;
 
-		if (!GetAccessor(AccessorIndex, ComponentType, Stride, Elements, ElementSize, Count, bNormalized, Blob, GetAdditionalBufferView(AdditionalBufferView, Name)))
+		if (!GetAccessor(AccessorIndex, ComponentType, Stride, Elements, ElementSize, Count, bNormalized, Blob, AdditionalBufferView))
 		{
 			return false;
 		}
@@ -2460,53 +2802,49 @@ public:
 			*ComponentTypePtr = ComponentType;
 		}
 
-		Data.AddUninitialized(Count);
-		for (int64 ElementIndex = 0; ElementIndex < Count; ElementIndex++)
+		if (!IsSupportedAccessorComponentType(ComponentType))
 		{
-			int64 Index = ElementIndex * Stride;
-			T Value;
-			// FLOAT
-			if (ComponentType == 5126)
-			{
-				float* Ptr = (float*)&(Blob.Data[Index]);
-				Value = *Ptr;
-			}
-			// BYTE
-			else if (ComponentType == 5120)
-			{
-				int8* Ptr = (int8*)&(Blob.Data[Index]);
-				Value = bNormalized ? FMath::Max(((float)(*Ptr)) / 127.f, -1.f) : *Ptr;
-			}
-			// UNSIGNED_BYTE
-			else if (ComponentType == 5121)
-			{
-				uint8* Ptr = (uint8*)&(Blob.Data[Index]);
-				Value = bNormalized ? ((float)(*Ptr)) / 255.f : *Ptr;
-			}
-			// SHORT
-			else if (ComponentType == 5122)
-			{
-				int16* Ptr = (int16*)&(Blob.Data[Index]);
-				Value = bNormalized ? FMath::Max(((float)(*Ptr)) / 32767.f, -1.f) : *Ptr;
-			}
-			// UNSIGNED_SHORT
-			else if (ComponentType == 5123)
-			{
-				uint16* Ptr = (uint16*)&(Blob.Data[Index]);
-				Value = bNormalized ? ((float)(*Ptr)) / 65535.f : *Ptr;
-			}
-			else
-			{
-				UE_LOG(LogGLTFRuntime, Error, TEXT("Unsupported type %d"), ComponentType);
-				return false;
-			}
+			UE_LOG(LogGLTFRuntime, Error, TEXT("Unsupported type %d"), ComponentType);
+			return false;
+		}
 
-			Data[ElementIndex] = Filter(Value);
+		const int64 FirstElement = Data.AddUninitialized(Count);
+		if (bNormalized)
+		{
+			DecodeAccessorByComponentType<T, true, true>(ComponentType, Blob.Data, Stride, Count, Elements, Data.GetData() + FirstElement, Filter);
+		}
+		else
+		{
+			DecodeAccessorByComponentType<T, false, true>(ComponentType, Blob.Data, Stride, Count, Elements, Data.GetData() + FirstElement, Filter);
 		}
 
 		return true;
 	}
 
+	template<typename T, typename Callback>
+	bool BuildFromAccessorField(TSharedRef<FJsonObject> JsonObject, const FString& Name, TArray<T>& Data, const TArray<int64>& SupportedElements, const TArray<int64>& SupportedTypes, Callback Filter, const int64 AdditionalBufferView, const bool bDefaultNormalized, int64* ComponentTypePtr)
+	{
+		int64 AccessorIndex;
+		if (!JsonObject->TryGetNumberField(Name, AccessorIndex))
+		{
+			return false;
+		}
+
+		return BuildFromAccessorIndex(AccessorIndex, Data, SupportedElements, SupportedTypes, Filter, GetAdditionalBufferView(AdditionalBufferView, Name), bDefaultNormalized, ComponentTypePtr);
+	}
+
+	template<typename T, typename Callback>
+	bool BuildFromAccessorField(TSharedRef<FJsonObject> JsonObject, const FString& Name, TArray<T>& Data, const TArray<int64>& SupportedTypes, Callback Filter, const int64 AdditionalBufferView, const bool bDefaultNormalized, int64* ComponentTypePtr)
+	{
+		int64 AccessorIndex;
+		if (!JsonObject->TryGetNumberField(Name, AccessorIndex))
+		{
+			return false;
+		}
+
+		return BuildFromAccessorIndex(AccessorIndex, Data, SupportedTypes, Filter, GetAdditionalBufferView(AdditionalBufferView, Name), bDefaultNormalized, ComponentTypePtr);
+	}
+
 	template<typename T>
 	bool BuildFromAccessorField(TSharedRef<FJsonObject> JsonObject, const FString& Name, TArray<T>& Data, const TArray<int64>& SupportedElements, const TArray<int64>& SupportedTypes, const int64 AdditionalBufferView, const bool bDefaultNormalized, int64* ComponentTypePtr)
 	{
@@ -2519,6 +2857,42 @@ public:
 		return BuildFromAccessorField(JsonObject, Name, Data, SupportedTypes, [&](T InValue) -> T {return InValue; }, AdditionalBufferView, bDefaultNormalized, ComponentTypePtr);
 	}
 
+	template<typename T, typename Callback>
+	bool BuildFromAccessorField(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonObjectNode, const ANSICHAR* Name, TArray<T>& Data, const TArray<int64>& SupportedElements, const TArray<int64>& SupportedTypes, Callback Filter, const int64 AdditionalBufferView, const bool bDefaultNormalized, int64* ComponentTypePtr)
+	{
+		int64 AccessorIndex;
+		if (!JsonTape.TryGetNumberField(JsonObjectNode, Name, AccessorIndex))
+		{
+			return false;
+		}
+
+		return BuildFromAccessorIndex(AccessorIndex, Data, SupportedElements, SupportedTypes, Filter, AdditionalBufferView > INDEX_NONE ? GetAdditionalBufferView(AdditionalBufferView, Name) : nullptr, bDefaultNormalized, ComponentTypePtr);
+	}
+
+	template<typename T, typename Callback>
+	bool BuildFromAccessorField(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonObjectNode, const ANSICHAR* Name, TArray<T>& Data, const TArray<int64>& SupportedTypes, Callback Filter, const int64 AdditionalBufferView, const bool bDefaultNormalized, int64* ComponentTypePtr)
+	{
+		int64 AccessorIndex;
+		if (!JsonTape.TryGetNumberField(JsonObjectNode, Name, AccessorIndex))
+		{
+			return false;
+		}
+
+		return BuildFromAccessorIndex(AccessorIndex, Data, SupportedTypes, Filter, AdditionalBufferView > INDEX_NONE ? GetAdditionalBufferView(AdditionalBufferView, Name) : nullptr, bDefaultNormalized, ComponentTypePtr);
+	}
+
+	template<typename T>
+	bool BuildFromAccessorField(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonObjectNode, const ANSICHAR* Name, TArray<T>& Data, const TArray<int64>& SupportedElements, const TArray<int64>& SupportedTypes, const int64 AdditionalBufferView, const bool bDefaultNormalized, int64* ComponentTypePtr)
+	{
+		return BuildFromAccessorField(JsonTape, JsonObjectNode, Name, Data, SupportedElements, SupportedTypes, [&](T InValue) -> T {return InValue; }, AdditionalBufferView, bDefaultNormalized, ComponentTypePtr);
+	}
+
+	template<typename T>
+	bool BuildFromAccessorField(const FglTFRuntimeJsonTape& JsonTape, const int32 JsonObjectNode, const ANSICHAR* Name, TArray<T>& Data, const TArray<int64>& SupportedTypes, const int64 AdditionalBufferView, const bool bDefaultNormalized, int64* ComponentTypePtr)
+	{
+		return BuildFromAccessorField(JsonTape, JsonObjectNode, Name, Data, SupportedTypes, [&](T InValue) -> T {return InValue; }, AdditionalBufferView, bDefaultNormalized, ComponentTypePtr);
+	}
+
 	template<int32 Num, typename T>
 	bool GetJsonVector(const TArray<TSharedPtr<FJsonValue>>* JsonValues, T& Value)
 	{
@@ -2558,9 +2932,30 @@ protected:
 	FVector ComputeTangentY(const FVector Normal, const FVector TangetX);
 	FVector ComputeTangentYWithW(const FVector Normal, const FVector TangetX, const float W);
 
-	TArray64<uint8> ZeroBuffer;
+	// runs Callback over contiguous ranges of triangles in parallel (each range is processed by a single worker, so the results do not depend on the number of threads)
+	static void ParallelForTriangles(const int32 NumTriangles, TFunctionRef<void(const int32 TriangleStart, const int32 TriangleEnd)> Callback, const bool bForceSingleThread = false);
+
+	// reorders the triangles of an indexed list for the post-transform vertex cache (Tipsify) and then sorts the resulting clusters to reduce overdraw
+	static void OptimizeTrianglesOrder(TArray<uint32>& Indices, const TArray<FVector>& Positions);
+	// renumbers the vertices by first use, VerticesOrder maps each new vertex to the old one
+	static void OptimizeVertexFetch(TArray<uint32>& Indices, const int32 NumVertices, TArray<uint32>& VerticesOrder);
+
+	// collapses edges by quadric error until TargetNumIndices is reached (or nothing else can be collapsed) preserving open borders and attributes seams,
+	// AttributesDistance (0 to 1) penalizes collapses between vertices with different attributes, returns the geometric error
+	static double SimplifyTriangles(TArray<uint32>& Indices, const TArray<FVector>& Positions, const int32 TargetNumIndices, TFunctionRef<double(const uint32 VertexA, const uint32 VertexB)> AttributesDistance);
+	// builds a simplified copy of SourceLOD for each ratio, ScreenSizes are the ones where the simplification error gets lower than PixelError (on a 1080p screen)
+	static bool GenerateSimplifiedLODs(const FglTFRuntimeMeshLOD& SourceLOD, const TArray<float>& TrianglesRatios, const float PixelError, TArray<FglTFRuntimeMeshLOD>& LODs, TArray<float>& ScreenSizes);
+	// removes the vertices not referenced by the indices
+	static void CompactPrimitive(FglTFRuntimePrimitive& Primitive);
+
+	// zero filled blocks are never reallocated (a bigger one is added when needed) so blobs from other threads stay valid
+	TArray<TUniquePtr<TArray64<uint8>>> ZeroBuffers;
+	FCriticalSection ZeroBuffersLock;
+	uint8* GetZeroBuffer(const int64 Size);
+
 	TMap<int32, TArray64<uint8>> SparseAccessorsCache;
 	TMap<int32, int64> SparseAccessorsStridesCache;
+	FCriticalSection SparseAccessorsCacheLock;
 
 	TMap<int64, TMap<FString, FglTFRuntimeBlob>> AdditionalBufferViewsCache;
 	TArray<TArray64<uint8>> AdditionalBufferViewsData;
@@ -49,6 +49,49 @@ bool FFLAC_RuntimeCodec::GetHeaderInfo(FEncodedAudioStruct EncodedData, FRuntime
 	return true;
 }
 
+bool FFLAC_RuntimeCodec::PrepareRangeDecode(const uint8* AudioData, int64 AudioDataSize, FRuntimeAudioHeaderInfo& HeaderInfo)
+{
+	drflac* FLAC = drflac_open_memory(AudioData, AudioDataSize, nullptr);
+	if (!FLAC)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to initialize FLAC Decoder"));
+		return false;
+	}
+
+	{
+		HeaderInfo.Duration = static_cast<float>(FLAC->totalPCMFrameCount) / FLAC->sampleRate;
+		HeaderInfo.NumOfChannels = FLAC->channels;
+		HeaderInfo.SampleRate = FLAC->sampleRate;
+		HeaderInfo.PCMDataSize = FLAC->totalPCMFrameCount * FLAC->channels;
+		HeaderInfo.AudioFormat = GetAudioFormat();
+	}
+
+	drflac_close(FLAC);
+	return true;
+}
+
+int64 FFLAC_RuntimeCodec::DecodeRange(const uint8* AudioData, int64 AudioDataSize, int64 StartFrame, int64 NumOfFrames, float* OutPCMData)
+{
+	// Every range uses its own decoder, the decoders only read from the shared audio data
+	drflac* FLAC_Decoder = drflac_open_memory(AudioData, AudioDataSize, nullptr);
+	if (!FLAC_Decoder)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to initialize FLAC Decoder"));
+		return 0;
+	}
+
+	if (!drflac_seek_to_pcm_frame(FLAC_Decoder, StartFrame))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to seek to the PCM frame %lld of the FLAC audio data"), StartFrame);
+		drflac_close(FLAC_Decoder);
+		return 0;
+	}
+
+	const int64 NumOfDecodedFrames = static_cast<int64>(drflac_read_pcm_frames_f32(FLAC_Decoder, NumOfFrames, OutPCMData));
+	drflac_close(FLAC_Decoder);
+	return NumOfDecodedFrames;
+}
+
 bool FFLAC_RuntimeCodec::Encode(FDecodedAudioStruct DecodedData, FEncodedAudioStruct& EncodedData, uint8 Quality)
 {
 	ensureMsgf(false, TEXT("FLAC codec does not support encoding at the moment"));
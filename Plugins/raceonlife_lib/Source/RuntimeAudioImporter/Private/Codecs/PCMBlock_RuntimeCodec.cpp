@@ -0,0 +1,585 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Codecs/PCMBlock_RuntimeCodec.h"
+#include "RuntimeAudioImporterDefines.h"
+#include "RuntimeAudioImporterTypes.h"
+
+namespace PCMBlockCodec
+{
+	/** How the samples of a block are stored */
+	enum class EBlockEncoding : uint8
+	{
+		/** Raw 32-bit floats */
+		Verbatim,
+
+		/** 16-bit integers (scaled by 2^15), predicted and Rice coded */
+		Int16,
+
+		/** 24-bit integers (scaled by 2^23), predicted and Rice coded */
+		Int24
+	};
+
+	/** Highest fixed predictor order */
+	constexpr int32 MaxPredictorOrder = 4;
+
+	/** Number of residuals sharing a Rice parameter */
+	constexpr int32 NumOfResidualsPerPartition = 256;
+
+	/** Number of bits used to store a Rice parameter */
+	constexpr int32 RiceParameterNumOfBits = 5;
+
+	/** Unary quotients this large are escaped, with the residual stored in 32 bits instead */
+	constexpr uint32 RiceEscapeQuotient = 32;
+
+	float GetIntegerScale(EBlockEncoding Encoding)
+	{
+		return Encoding == EBlockEncoding::Int16 ? 32768.f : 8388608.f;
+	}
+
+	uint32 ZigZagEncode(int32 Value)
+	{
+		return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+	}
+
+	int32 ZigZagDecode(uint32 Value)
+	{
+		return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+	}
+
+	/** Fixed polynomial prediction of the sample at the given index (requires Index >= Order) */
+	int64 Predict(const int32* Samples, int32 Index, int32 Order)
+	{
+		switch (Order)
+		{
+		case 1:
+			return Samples[Index - 1];
+		case 2:
+			return 2ll * Samples[Index - 1] - Samples[Index - 2];
+		case 3:
+			return 3ll * Samples[Index - 1] - 3ll * Samples[Index - 2] + Samples[Index - 3];
+		case 4:
+			return 4ll * Samples[Index - 1] - 6ll * Samples[Index - 2] + 4ll * Samples[Index - 3] - Samples[Index - 4];
+		default:
+			return 0;
+		}
+	}
+
+	/** Picks the fixed predictor order yielding the smallest residuals, the same way FLAC does */
+	int32 ChoosePredictorOrder(const int32* Samples, int32 NumOfSamples)
+	{
+		if (NumOfSamples <= MaxPredictorOrder)
+		{
+			return 0;
+		}
+
+		uint64 ResidualSums[MaxPredictorOrder + 1] = {};
+		for (int32 Index = MaxPredictorOrder; Index < NumOfSamples; ++Index)
+		{
+			const int64 Error0 = Samples[Index];
+			const int64 Error1 = Error0 - Samples[Index - 1];
+			const int64 Error2 = Error1 - (static_cast<int64>(Samples[Index - 1]) - Samples[Index - 2]);
+			const int64 Error3 = Error2 - (static_cast<int64>(Samples[Index - 1]) - 2ll * Samples[Index - 2] + Samples[Index - 3]);
+			const int64 Error4 = Error3 - (static_cast<int64>(Samples[Index - 1]) - 3ll * Samples[Index - 2] + 3ll * Samples[Index - 3] - Samples[Index - 4]);
+
+			ResidualSums[0] += FMath::Abs(Error0);
+			ResidualSums[1] += FMath::Abs(Error1);
+			ResidualSums[2] += FMath::Abs(Error2);
+			ResidualSums[3] += FMath::Abs(Error3);
+			ResidualSums[4] += FMath::Abs(Error4);
+		}
+
+		int32 BestOrder = 0;
+		for (int32 Order = 1; Order <= MaxPredictorOrder; ++Order)
+		{
+			if (ResidualSums[Order] < ResidualSums[BestOrder])
+			{
+				BestOrder = Order;
+			}
+		}
+		return BestOrder;
+	}
+
+	/** Picks the Rice parameter for a partition from the mean of its zigzag-encoded residuals */
+	uint32 ChooseRiceParameter(const uint32* Values, int32 NumOfValues)
+	{
+		uint64 Sum = 0;
+		for (int32 Index = 0; Index < NumOfValues; ++Index)
+		{
+			Sum += Values[Index];
+		}
+
+		const uint64 Mean = Sum / FMath::Max(NumOfValues, 1);
+		return Mean > 0 ? FMath::Min<uint32>(FMath::FloorLog2_64(Mean), (1u << RiceParameterNumOfBits) - 1) : 0;
+	}
+
+	/** MSB-first bit writer appending to a byte array */
+	class FBitWriter
+	{
+	public:
+		explicit FBitWriter(TArray64<uint8>& InData)
+			: Data(InData)
+			, Accumulator(0)
+			, NumOfAccumulatedBits(0)
+		{}
+
+		void WriteBits(uint32 Value, int32 NumOfBits)
+		{
+			if (NumOfBits <= 0)
+			{
+				return;
+			}
+			Accumulator = (Accumulator << NumOfBits) | (static_cast<uint64>(Value) & ((1ull << NumOfBits) - 1));
+			NumOfAccumulatedBits += NumOfBits;
+			while (NumOfAccumulatedBits >= 8)
+			{
+				NumOfAccumulatedBits -= 8;
+				Data.Add(static_cast<uint8>(Accumulator >> NumOfAccumulatedBits));
+			}
+		}
+
+		void WriteRice(uint32 Value, uint32 RiceParameter)
+		{
+			const uint32 Quotient = Value >> RiceParameter;
+			if (Quotient >= RiceEscapeQuotient)
+			{
+				WriteOnes(RiceEscapeQuotient);
+				WriteBits(Value, 32);
+				return;
+			}
+			WriteOnes(Quotient);
+			WriteBits(0, 1);
+			WriteBits(Value, RiceParameter);
+		}
+
+		/** Pads the last byte with zeros */
+		void Flush()
+		{
+			if (NumOfAccumulatedBits > 0)
+			{
+				WriteBits(0, 8 - NumOfAccumulatedBits);
+			}
+		}
+
+	private:
+		void WriteOnes(uint32 NumOfOnes)
+		{
+			while (NumOfOnes > 0)
+			{
+				const int32 NumOfBits = FMath::Min<uint32>(NumOfOnes, 16);
+				WriteBits((1u << NumOfBits) - 1, NumOfBits);
+				NumOfOnes -= NumOfBits;
+			}
+		}
+
+		TArray64<uint8>& Data;
+		uint64 Accumulator;
+		int32 NumOfAccumulatedBits;
+	};
+
+	/** MSB-first bit reader with a 64-bit left-aligned cache */
+	class FBitReader
+	{
+	public:
+		FBitReader(const uint8* InData, const uint8* InDataEnd)
+			: Data(InData)
+			, DataEnd(InDataEnd)
+			, Cache(0)
+			, NumOfCachedBits(0)
+			, bOverrun(false)
+		{}
+
+		uint32 ReadBits(int32 NumOfBits)
+		{
+			if (NumOfBits <= 0)
+			{
+				return 0;
+			}
+			Refill();
+			if (NumOfCachedBits < NumOfBits)
+			{
+				bOverrun = true;
+				return 0;
+			}
+			const uint32 Value = static_cast<uint32>(Cache >> (64 - NumOfBits));
+			Cache <<= NumOfBits;
+			NumOfCachedBits -= NumOfBits;
+			return Value;
+		}
+
+		uint32 ReadRice(uint32 RiceParameter)
+		{
+			uint32 Quotient = 0;
+			while (true)
+			{
+				Refill();
+				if (NumOfCachedBits == 0)
+				{
+					bOverrun = true;
+					return 0;
+				}
+
+				// Bits below the cached ones are zero, so the leading ones of the cache never extend past the cached bits
+				const int32 NumOfOnes = FMath::Min<int32>(FMath::Min<int32>(static_cast<int32>(FMath::CountLeadingZeros64(~Cache)), NumOfCachedBits), RiceEscapeQuotient - Quotient);
+				Quotient += NumOfOnes;
+				Cache <<= NumOfOnes;
+				NumOfCachedBits -= NumOfOnes;
+
+				if (Quotient >= RiceEscapeQuotient)
+				{
+					return ReadBits(32);
+				}
+
+				// Unless the cached bits ran out, the next bit is the terminating zero
+				if (NumOfCachedBits > 0)
+				{
+					Cache <<= 1;
+					--NumOfCachedBits;
+					break;
+				}
+			}
+			return (Quotient << RiceParameter) | ReadBits(RiceParameter);
+		}
+
+		bool HasOverrun() const
+		{
+			return bOverrun;
+		}
+
+	private:
+		void Refill()
+		{
+			while (NumOfCachedBits <= 56 && Data < DataEnd)
+			{
+				Cache |= static_cast<uint64>(*Data++) << (56 - NumOfCachedBits);
+				NumOfCachedBits += 8;
+			}
+		}
+
+		const uint8* Data;
+		const uint8* DataEnd;
+		uint64 Cache;
+		int32 NumOfCachedBits;
+		bool bOverrun;
+	};
+
+	/** Whether every sample of the block converts to an integer of the given encoding and back to the very same float */
+	bool IsExactlyRepresentable(const float* Samples, int32 NumOfSamples, EBlockEncoding Encoding)
+	{
+		const float Scale = GetIntegerScale(Encoding);
+		const float InvScale = 1.f / Scale;
+		for (int32 Index = 0; Index < NumOfSamples; ++Index)
+		{
+			const float Scaled = Samples[Index] * Scale;
+			if (!(Scaled >= -Scale && Scaled <= Scale - 1.f))
+			{
+				return false;
+			}
+			const float Reconstructed = static_cast<float>(static_cast<int32>(Scaled)) * InvScale;
+			if (FMemory::Memcmp(&Reconstructed, &Samples[Index], sizeof(float)) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void EncodeChannel(FBitWriter& Writer, const int32* Samples, int32 NumOfSamples, TArray<uint32>& ResidualScratch)
+	{
+		const int32 Order = ChoosePredictorOrder(Samples, NumOfSamples);
+		Writer.WriteBits(Order, 3);
+
+		for (int32 Index = 0; Index < Order; ++Index)
+		{
+			Writer.WriteBits(static_cast<uint32>(Samples[Index]), 32);
+		}
+
+		ResidualScratch.SetNumUninitialized(NumOfSamples - Order);
+		for (int32 Index = Order; Index < NumOfSamples; ++Index)
+		{
+			ResidualScratch[Index - Order] = ZigZagEncode(static_cast<int32>(Samples[Index] - Predict(Samples, Index, Order)));
+		}
+
+		for (int32 PartitionStart = 0; PartitionStart < ResidualScratch.Num(); PartitionStart += NumOfResidualsPerPartition)
+		{
+			const int32 NumOfResiduals = FMath::Min(NumOfResidualsPerPartition, ResidualScratch.Num() - PartitionStart);
+			const uint32 RiceParameter = ChooseRiceParameter(ResidualScratch.GetData() + PartitionStart, NumOfResiduals);
+			Writer.WriteBits(RiceParameter, RiceParameterNumOfBits);
+			for (int32 Index = 0; Index < NumOfResiduals; ++Index)
+			{
+				Writer.WriteRice(ResidualScratch[PartitionStart + Index], RiceParameter);
+			}
+		}
+	}
+
+	bool DecodeChannel(FBitReader& Reader, int32* Samples, int32 NumOfSamples)
+	{
+		const int32 Order = static_cast<int32>(Reader.ReadBits(3));
+		if (Order > MaxPredictorOrder || Order > NumOfSamples)
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < Order; ++Index)
+		{
+			Samples[Index] = static_cast<int32>(Reader.ReadBits(32));
+		}
+
+		for (int32 PartitionStart = Order; PartitionStart < NumOfSamples; PartitionStart += NumOfResidualsPerPartition)
+		{
+			const int32 PartitionEnd = FMath::Min(PartitionStart + NumOfResidualsPerPartition, NumOfSamples);
+			const uint32 RiceParameter = Reader.ReadBits(RiceParameterNumOfBits);
+			for (int32 Index = PartitionStart; Index < PartitionEnd; ++Index)
+			{
+				Samples[Index] = static_cast<int32>(Predict(Samples, Index, Order) + ZigZagDecode(Reader.ReadRice(RiceParameter)));
+			}
+		}
+
+		return !Reader.HasOverrun();
+	}
+}
+
+FCompressedPCMDataPtr FPCMBlock_RuntimeCodec::Compress(const float* PCMData, int64 NumOfSamples, int32 NumOfChannels, bool bQuantizeTo16Bit)
+{
+	using namespace PCMBlockCodec;
+
+	if (!PCMData || NumOfChannels <= 0 || NumOfSamples <= 0 || NumOfSamples % NumOfChannels != 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to compress PCM data because the number of samples '%lld' does not match the number of channels '%d'"), NumOfSamples, NumOfChannels);
+		return nullptr;
+	}
+
+	TSharedPtr<FCompressedPCMData, ESPMode::ThreadSafe> CompressedData = MakeShared<FCompressedPCMData, ESPMode::ThreadSafe>();
+	CompressedData->NumOfChannels = NumOfChannels;
+	CompressedData->NumOfFrames = NumOfSamples / NumOfChannels;
+
+	const int64 NumOfBlocks = (CompressedData->NumOfFrames + FCompressedPCMData::NumOfFramesPerBlock - 1) / FCompressedPCMData::NumOfFramesPerBlock;
+	if (NumOfBlocks >= TNumericLimits<int32>::Max())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to compress PCM data because it is too large (%lld frames)"), CompressedData->NumOfFrames);
+		return nullptr;
+	}
+	CompressedData->BlockOffsets.Reserve(static_cast<int32>(NumOfBlocks) + 1);
+
+	// Scratch buffers reused by all blocks
+	TArray<int32> ChannelSamples;
+	ChannelSamples.SetNumUninitialized(FCompressedPCMData::NumOfFramesPerBlock);
+	TArray<uint32> ResidualScratch;
+	ResidualScratch.Reserve(FCompressedPCMData::NumOfFramesPerBlock);
+
+	FBitWriter Writer(CompressedData->Data);
+	for (int32 BlockIndex = 0; BlockIndex < NumOfBlocks; ++BlockIndex)
+	{
+		CompressedData->BlockOffsets.Add(CompressedData->Data.Num());
+
+		const int32 NumOfFramesInBlock = CompressedData->GetNumOfFramesInBlock(BlockIndex);
+		const int32 NumOfSamplesInBlock = NumOfFramesInBlock * NumOfChannels;
+		const float* BlockSamples = PCMData + static_cast<int64>(BlockIndex) * FCompressedPCMData::NumOfFramesPerBlock * NumOfChannels;
+
+		EBlockEncoding Encoding = EBlockEncoding::Verbatim;
+		if (bQuantizeTo16Bit || IsExactlyRepresentable(BlockSamples, NumOfSamplesInBlock, EBlockEncoding::Int16))
+		{
+			Encoding = EBlockEncoding::Int16;
+		}
+		else if (IsExactlyRepresentable(BlockSamples, NumOfSamplesInBlock, EBlockEncoding::Int24))
+		{
+			Encoding = EBlockEncoding::Int24;
+		}
+
+		Writer.WriteBits(static_cast<uint8>(Encoding), 8);
+
+		if (Encoding == EBlockEncoding::Verbatim)
+		{
+			CompressedData->Data.Append(reinterpret_cast<const uint8*>(BlockSamples), NumOfSamplesInBlock * sizeof(float));
+			continue;
+		}
+
+		const float Scale = GetIntegerScale(Encoding);
+		for (int32 ChannelIndex = 0; ChannelIndex < NumOfChannels; ++ChannelIndex)
+		{
+			for (int32 FrameIndex = 0; FrameIndex < NumOfFramesInBlock; ++FrameIndex)
+			{
+				const float Sample = BlockSamples[FrameIndex * NumOfChannels + ChannelIndex];
+				ChannelSamples[FrameIndex] = bQuantizeTo16Bit
+					? FMath::Clamp(FMath::RoundToInt(Sample * Scale), -32768, 32767)
+					: static_cast<int32>(Sample * Scale);
+			}
+			EncodeChannel(Writer, ChannelSamples.GetData(), NumOfFramesInBlock, ResidualScratch);
+		}
+
+		// Blocks start at byte boundaries so that each of them can be decoded on its own
+		Writer.Flush();
+	}
+	CompressedData->BlockOffsets.Add(CompressedData->Data.Num());
+	CompressedData->Data.Shrink();
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Compressed PCM data from %lld to %lld bytes (%.1f%%)"), static_cast<int64>(NumOfSamples * sizeof(float)), CompressedData->GetAllocatedSize(),
+		100. * CompressedData->GetAllocatedSize() / (NumOfSamples * sizeof(float)));
+
+	return CompressedData;
+}
+
+bool FPCMBlock_RuntimeCodec::DecodeBlock(const FCompressedPCMData& CompressedData, int32 BlockIndex, float* OutPCMData, TArray<int32>& ChannelScratch)
+{
+	using namespace PCMBlockCodec;
+
+	if (BlockIndex < 0 || BlockIndex >= CompressedData.GetNumOfBlocks())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to decode PCM block '%d' because there are only '%d' blocks"), BlockIndex, CompressedData.GetNumOfBlocks());
+		return false;
+	}
+
+	const uint8* BlockData = CompressedData.Data.GetData() + CompressedData.BlockOffsets[BlockIndex];
+	const uint8* BlockDataEnd = CompressedData.Data.GetData() + CompressedData.BlockOffsets[BlockIndex + 1];
+	const int32 NumOfChannels = CompressedData.NumOfChannels;
+	const int32 NumOfFramesInBlock = CompressedData.GetNumOfFramesInBlock(BlockIndex);
+	const int32 NumOfSamplesInBlock = NumOfFramesInBlock * NumOfChannels;
+
+	const EBlockEncoding Encoding = static_cast<EBlockEncoding>(*BlockData++);
+	if (Encoding == EBlockEncoding::Verbatim)
+	{
+		if (BlockDataEnd - BlockData != NumOfSamplesInBlock * static_cast<int64>(sizeof(float)))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to decode verbatim PCM block '%d' because its size is invalid"), BlockIndex);
+			return false;
+		}
+		FMemory::Memcpy(OutPCMData, BlockData, NumOfSamplesInBlock * sizeof(float));
+		return true;
+	}
+
+	if (Encoding != EBlockEncoding::Int16 && Encoding != EBlockEncoding::Int24)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to decode PCM block '%d' because its encoding '%d' is unknown"), BlockIndex, static_cast<int32>(Encoding));
+		return false;
+	}
+
+	if (ChannelScratch.Num() < FCompressedPCMData::NumOfFramesPerBlock)
+	{
+		ChannelScratch.SetNumUninitialized(FCompressedPCMData::NumOfFramesPerBlock);
+	}
+	int32* ChannelSamples = ChannelScratch.GetData();
+	const float InvScale = 1.f / GetIntegerScale(Encoding);
+
+	FBitReader Reader(BlockData, BlockDataEnd);
+	for (int32 ChannelIndex = 0; ChannelIndex < NumOfChannels; ++ChannelIndex)
+	{
+		if (!DecodeChannel(Reader, ChannelSamples, NumOfFramesInBlock))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to decode channel '%d' of PCM block '%d' because the data is corrupted"), ChannelIndex, BlockIndex);
+			return false;
+		}
+
+		for (int32 FrameIndex = 0; FrameIndex < NumOfFramesInBlock; ++FrameIndex)
+		{
+			OutPCMData[FrameIndex * NumOfChannels + ChannelIndex] = static_cast<float>(ChannelSamples[FrameIndex]) * InvScale;
+		}
+	}
+
+	return true;
+}
+
+bool FPCMBlock_RuntimeCodec::Decompress(const FCompressedPCMData& CompressedData, FRuntimeBulkDataBuffer<float>& OutPCMData)
+{
+	const int64 NumOfSamples = CompressedData.NumOfFrames * CompressedData.NumOfChannels;
+	float* PCMData = static_cast<float*>(FMemory::Malloc(NumOfSamples * sizeof(float)));
+	if (!PCMData)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to allocate memory to decompress PCM data (%lld samples)"), NumOfSamples);
+		return false;
+	}
+
+	TArray<int32> ChannelScratch;
+	for (int32 BlockIndex = 0; BlockIndex < CompressedData.GetNumOfBlocks(); ++BlockIndex)
+	{
+		if (!DecodeBlock(CompressedData, BlockIndex, PCMData + static_cast<int64>(BlockIndex) * FCompressedPCMData::NumOfFramesPerBlock * CompressedData.NumOfChannels, ChannelScratch))
+		{
+			FMemory::Free(PCMData);
+			return false;
+		}
+	}
+
+	OutPCMData = FRuntimeBulkDataBuffer<float>(PCMData, NumOfSamples);
+	return true;
+}
+
+FPCMBlockCache::FPCMBlockCache(int32 InMaxNumOfBlocks)
+	: MaxNumOfBlocks(FMath::Max(InMaxNumOfBlocks, 1))
+	, UseTick(0)
+{
+}
+
+int64 FPCMBlockCache::CopyFrames(const FCompressedPCMDataPtr& CompressedData, int64 StartFrame, int64 NumOfFrames, float* OutPCMData)
+{
+	if (!CompressedData.IsValid())
+	{
+		return 0;
+	}
+
+	if (CachedData != CompressedData)
+	{
+		Reset();
+		CachedData = CompressedData;
+	}
+
+	const int32 NumOfChannels = CompressedData->NumOfChannels;
+	NumOfFrames = FMath::Min(NumOfFrames, CompressedData->NumOfFrames - StartFrame);
+
+	int64 NumOfCopiedFrames = 0;
+	while (NumOfCopiedFrames < NumOfFrames)
+	{
+		const int64 Frame = StartFrame + NumOfCopiedFrames;
+		const int32 BlockIndex = static_cast<int32>(Frame / FCompressedPCMData::NumOfFramesPerBlock);
+		const int32 FrameInBlock = static_cast<int32>(Frame % FCompressedPCMData::NumOfFramesPerBlock);
+
+		const float* BlockPCMData = GetBlock(BlockIndex);
+		if (!BlockPCMData)
+		{
+			break;
+		}
+
+		const int64 NumOfFramesToCopy = FMath::Min<int64>(CompressedData->GetNumOfFramesInBlock(BlockIndex) - FrameInBlock, NumOfFrames - NumOfCopiedFrames);
+		FMemory::Memcpy(OutPCMData + NumOfCopiedFrames * NumOfChannels, BlockPCMData + FrameInBlock * NumOfChannels, NumOfFramesToCopy * NumOfChannels * sizeof(float));
+		NumOfCopiedFrames += NumOfFramesToCopy;
+	}
+
+	return NumOfCopiedFrames;
+}
+
+void FPCMBlockCache::Reset()
+{
+	Blocks.Reset();
+	CachedData.Reset();
+}
+
+const float* FPCMBlockCache::GetBlock(int32 BlockIndex)
+{
+	const FCompressedPCMData& CompressedData = *CachedData;
+	++UseTick;
+
+	FCachedBlock* LeastRecentlyUsedBlock = nullptr;
+	for (FCachedBlock& Block : Blocks)
+	{
+		if (Block.BlockIndex == BlockIndex)
+		{
+			Block.LastUseTick = UseTick;
+			return Block.PCMData.GetData();
+		}
+		if (!LeastRecentlyUsedBlock || Block.LastUseTick < LeastRecentlyUsedBlock->LastUseTick)
+		{
+			LeastRecentlyUsedBlock = &Block;
+		}
+	}
+
+	FCachedBlock* TargetBlock = Blocks.Num() < MaxNumOfBlocks ? &Blocks.AddDefaulted_GetRef() : LeastRecentlyUsedBlock;
+
+	// Decoded blocks of the same data never exceed this size, so the buffer is only allocated once per slot
+	TargetBlock->PCMData.SetNumUninitialized(FCompressedPCMData::NumOfFramesPerBlock * CompressedData.NumOfChannels);
+	if (!FPCMBlock_RuntimeCodec::DecodeBlock(CompressedData, BlockIndex, TargetBlock->PCMData.GetData(), ChannelScratch))
+	{
+		TargetBlock->BlockIndex = INDEX_NONE;
+		return nullptr;
+	}
+
+	TargetBlock->BlockIndex = BlockIndex;
+	TargetBlock->LastUseTick = UseTick;
+	return TargetBlock->PCMData.GetData();
+}
@@ -3,6 +3,7 @@
 #include "Codecs/WAV_RuntimeCodec.h"
 #include "RuntimeAudioImporterDefines.h"
 #include "RuntimeAudioImporterTypes.h"
+#include "RuntimeAudioMappedFile.h"
 #include "HAL/UnrealMemory.h"
 
 #define INCLUDE_WAV
@@ -12,6 +13,44 @@
 
 namespace
 {
+	/**
+	 * Check if the WAV audio data has the unset sizes in the RIFF container that CheckAndFixWavDurationErrors would fix, without modifying it
+	 */
+	bool HasWavDurationErrors(const uint8* WavData, int64 WavDataSize)
+	{
+		if (WavDataSize < 12 || FMemory::Memcmp(WavData, "RIFF", 4) != 0 || FMemory::Memcmp(WavData + 8, "WAVE", 4) != 0)
+		{
+			return false;
+		}
+
+		auto ReadUInt32 = [WavData](int64 Offset)
+		{
+			uint32 Value;
+			FMemory::Memcpy(&Value, WavData + Offset, sizeof(Value));
+			return Value;
+		};
+
+		// "FFFFFFFF" in place of the overall file size
+		if (ReadUInt32(4) == MAX_uint32)
+		{
+			return true;
+		}
+
+		// "FFFFFFFF" in place of the data chunk size. Walking the chunk list rather than scanning the bytes, since sample data or metadata may contain "data" as well
+		for (int64 ChunkOffset = 12; ChunkOffset + 8 <= WavDataSize;)
+		{
+			const uint32 ChunkSize = ReadUInt32(ChunkOffset + 4);
+			if (FMemory::Memcmp(WavData + ChunkOffset, "data", 4) == 0)
+			{
+				return ChunkSize == MAX_uint32;
+			}
+
+			// Chunks are padded to an even size
+			ChunkOffset += 8 + static_cast<int64>(ChunkSize) + (ChunkSize & 1);
+		}
+		return false;
+	}
+
 	/**
 	 * Check and fix the WAV audio data with the correct byte size in the RIFF container
 	 * Made by https://github.com/kass-kass
@@ -119,6 +158,95 @@ bool FWAV_RuntimeCodec::GetHeaderInfo(FEncodedAudioStruct EncodedData, FRuntimeA
 	return true;
 }
 
+bool FWAV_RuntimeCodec::PrepareRangeDecode(const uint8* AudioData, int64 AudioDataSize, FRuntimeAudioHeaderInfo& HeaderInfo)
+{
+	// Fixing the duration errors requires writing into the audio data, such data is decoded as a whole instead
+	if (HasWavDurationErrors(AudioData, AudioDataSize))
+	{
+		return false;
+	}
+
+	drwav WAV;
+	if (!drwav_init_memory(&WAV, AudioData, AudioDataSize, nullptr))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to initialize WAV Decoder"));
+		return false;
+	}
+
+	{
+		HeaderInfo.Duration = static_cast<float>(WAV.totalPCMFrameCount) / WAV.sampleRate;
+		HeaderInfo.NumOfChannels = WAV.channels;
+		HeaderInfo.SampleRate = WAV.sampleRate;
+		HeaderInfo.PCMDataSize = WAV.totalPCMFrameCount * WAV.channels;
+		HeaderInfo.AudioFormat = GetAudioFormat();
+	}
+
+	drwav_uninit(&WAV);
+	return true;
+}
+
+int64 FWAV_RuntimeCodec::DecodeRange(const uint8* AudioData, int64 AudioDataSize, int64 StartFrame, int64 NumOfFrames, float* OutPCMData)
+{
+	// Every range uses its own decoder, the decoders only read from the shared audio data
+	drwav WAV_Decoder;
+	if (!drwav_init_memory(&WAV_Decoder, AudioData, AudioDataSize, nullptr))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to initialize WAV Decoder"));
+		return 0;
+	}
+
+	if (!drwav_seek_to_pcm_frame(&WAV_Decoder, StartFrame))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to seek to the PCM frame %lld of the WAV audio data"), StartFrame);
+		drwav_uninit(&WAV_Decoder);
+		return 0;
+	}
+
+	const int64 NumOfDecodedFrames = static_cast<int64>(drwav_read_pcm_frames_f32(&WAV_Decoder, NumOfFrames, OutPCMData));
+	drwav_uninit(&WAV_Decoder);
+	return NumOfDecodedFrames;
+}
+
+bool FWAV_RuntimeCodec::GetDirectPCMLayout(const uint8* AudioData, int64 AudioDataSize, FMappedPCMData& MappedPCMData, FRuntimeAudioHeaderInfo& HeaderInfo)
+{
+	if (HasWavDurationErrors(AudioData, AudioDataSize))
+	{
+		return false;
+	}
+
+	drwav WAV;
+	if (!drwav_init_memory(&WAV, AudioData, AudioDataSize, nullptr))
+	{
+		return false;
+	}
+
+	const bool bInt16 = WAV.translatedFormatTag == DR_WAVE_FORMAT_PCM && WAV.bitsPerSample == 16;
+	const bool bFloat32 = WAV.translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT && WAV.bitsPerSample == 32;
+	const int64 SampleSize = WAV.bitsPerSample / 8;
+
+	// The samples are read in place, so they have to be aligned and fully contained in the audio data
+	const bool bDirectlyPlayable = (bInt16 || bFloat32) && WAV.container != drwav_container_rifx && WAV.channels > 0
+		&& WAV.dataChunkDataPos % SampleSize == 0
+		&& static_cast<int64>(WAV.dataChunkDataPos + WAV.totalPCMFrameCount * WAV.channels * SampleSize) <= AudioDataSize;
+
+	if (bDirectlyPlayable)
+	{
+		MappedPCMData.DataOffset = static_cast<int64>(WAV.dataChunkDataPos);
+		MappedPCMData.SampleFormat = bInt16 ? ERuntimeRAWAudioFormat::Int16 : ERuntimeRAWAudioFormat::Float32;
+		MappedPCMData.NumOfChannels = WAV.channels;
+		MappedPCMData.NumOfFrames = static_cast<int64>(WAV.totalPCMFrameCount);
+
+		HeaderInfo.Duration = static_cast<float>(WAV.totalPCMFrameCount) / WAV.sampleRate;
+		HeaderInfo.NumOfChannels = WAV.channels;
+		HeaderInfo.SampleRate = WAV.sampleRate;
+		HeaderInfo.PCMDataSize = WAV.totalPCMFrameCount * WAV.channels;
+		HeaderInfo.AudioFormat = ERuntimeAudioFormat::Wav;
+	}
+
+	drwav_uninit(&WAV);
+	return bDirectlyPlayable;
+}
+
 bool FWAV_RuntimeCodec::Encode(FDecodedAudioStruct DecodedData, FEncodedAudioStruct& EncodedData, uint8 Quality)
 {
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Encoding uncompressed audio data to WAV audio format.\nDecoded audio info: %s."), *DecodedData.ToString());
@@ -0,0 +1,438 @@
+﻿// Georgy Treshchev 2024.
+
+#include "RuntimeAudioDirectoryIndex.h"
+
+#include "RuntimeAudioHeaderReader.h"
+#include "RuntimeAudioImporterDefines.h"
+#include "RuntimeAudioMappedFile.h"
+#include "Codecs/BaseRuntimeCodec.h"
+#include "Codecs/RuntimeCodecFactory.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	/** Bump when the serialization of FRuntimeAudioIndexEntry changes, outdated index files are then ignored */
+	constexpr uint32 AudioDirectoryIndexMagic = 0x52414449; // "RADI"
+	constexpr int32 AudioDirectoryIndexVersion = 2;
+
+	/** Below this number of records the persisted index is never rewritten, so that small libraries are not compacted over and over */
+	constexpr int32 MinNumOfRecordsToCompact = 1024;
+
+	/** Type of a record appended to the persisted index */
+	enum class EAudioDirectoryIndexRecord : uint8
+	{
+		/** Followed by an entry that was added or modified */
+		Update,
+		/** Followed by the path of an entry that was removed */
+		Remove
+	};
+
+	FArchive& operator<<(FArchive& Ar, EAudioDirectoryIndexRecord& RecordType)
+	{
+		uint8 RecordTypeValue = static_cast<uint8>(RecordType);
+		Ar << RecordTypeValue;
+		RecordType = static_cast<EAudioDirectoryIndexRecord>(RecordTypeValue);
+		return Ar;
+	}
+
+	/** An audio file found while enumerating a directory */
+	struct FFoundAudioFile
+	{
+		FString FilePath;
+		FFileStatData StatData;
+	};
+}
+
+FRuntimeAudioDirectoryIndex& FRuntimeAudioDirectoryIndex::Get()
+{
+	static FRuntimeAudioDirectoryIndex DirectoryIndex(FPaths::ProjectSavedDir() / TEXT("RuntimeAudioImporter") / TEXT("AudioDirectoryIndex.idx"));
+	return DirectoryIndex;
+}
+
+FRuntimeAudioDirectoryIndex::FRuntimeAudioDirectoryIndex(const FString& InIndexFilePath)
+	: IndexFilePath(InIndexFilePath)
+  , NumOfPersistedRecords(0)
+  , bCompactionRequired(true)
+  , bLoaded(false)
+{
+}
+
+bool FRuntimeAudioDirectoryIndex::Scan(const FString& Directory, bool bRecursive, TArray<FRuntimeAudioIndexEntry>& OutEntries)
+{
+	const FString NormalizedDirectory = NormalizeDirectory(Directory);
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (!PlatformFile.DirectoryExists(*NormalizedDirectory))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to scan directory '%s' for audio files because it does not exist"), *NormalizedDirectory);
+		return false;
+	}
+
+	// Only the extension is checked while enumerating, so the codecs are retrieved once instead of locking the modular features for every file
+	FRuntimeCodecFactory CodecFactory;
+	const TArray<FBaseRuntimeCodec*> RuntimeCodecs = CodecFactory.GetCodecs();
+	auto IsAudioFile = [&RuntimeCodecs](const TCHAR* FilePath)
+	{
+		const FString Extension = FPaths::GetExtension(FilePath, false);
+		return RuntimeCodecs.ContainsByPredicate([&Extension](FBaseRuntimeCodec* RuntimeCodec)
+		{
+			return RuntimeCodec->IsExtensionSupported(Extension);
+		});
+	};
+
+	// Enumerating the tree level by level, with the directories of each level stat'ed in parallel
+	TArray<FFoundAudioFile> FoundAudioFiles;
+	TArray<FString> PendingDirectories{NormalizedDirectory};
+	while (PendingDirectories.Num() > 0)
+	{
+		TArray<TArray<FFoundAudioFile>> FoundAudioFilesPerDirectory;
+		TArray<TArray<FString>> SubdirectoriesPerDirectory;
+		FoundAudioFilesPerDirectory.SetNum(PendingDirectories.Num());
+		SubdirectoriesPerDirectory.SetNum(PendingDirectories.Num());
+
+		ParallelFor(PendingDirectories.Num(), [&](int32 DirectoryIndex)
+		{
+			PlatformFile.IterateDirectoryStat(*PendingDirectories[DirectoryIndex], [&](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+			{
+				if (StatData.bIsDirectory)
+				{
+					if (bRecursive)
+					{
+						SubdirectoriesPerDirectory[DirectoryIndex].Add(FilenameOrDirectory);
+					}
+				}
+				else if (IsAudioFile(FilenameOrDirectory))
+				{
+					FoundAudioFilesPerDirectory[DirectoryIndex].Add({FilenameOrDirectory, StatData});
+				}
+				return true;
+			});
+		});
+
+		PendingDirectories.Reset();
+		for (int32 DirectoryIndex = 0; DirectoryIndex < FoundAudioFilesPerDirectory.Num(); ++DirectoryIndex)
+		{
+			FoundAudioFiles.Append(MoveTemp(FoundAudioFilesPerDirectory[DirectoryIndex]));
+			PendingDirectories.Append(MoveTemp(SubdirectoriesPerDirectory[DirectoryIndex]));
+		}
+	}
+
+	// Matching the found files against the index, only new or modified files need their headers read
+	TArray<FRuntimeAudioIndexEntry> ChangedEntries;
+	TSet<FString> FoundFilePaths;
+	{
+		FRAIScopeLock Lock(&CriticalSection);
+		Load_Internal();
+
+		FoundFilePaths.Reserve(FoundAudioFiles.Num());
+		for (FFoundAudioFile& FoundAudioFile : FoundAudioFiles)
+		{
+			const FRuntimeAudioIndexEntry* KnownEntry = Entries.Find(FoundAudioFile.FilePath);
+			if (!KnownEntry || KnownEntry->FileSize != FoundAudioFile.StatData.FileSize || KnownEntry->ModificationTime != FoundAudioFile.StatData.ModificationTime)
+			{
+				FRuntimeAudioIndexEntry Entry;
+				Entry.FilePath = FoundAudioFile.FilePath;
+				Entry.FileSize = FoundAudioFile.StatData.FileSize;
+				Entry.ModificationTime = FoundAudioFile.StatData.ModificationTime;
+				ChangedEntries.Add(MoveTemp(Entry));
+			}
+			FoundFilePaths.Add(MoveTemp(FoundAudioFile.FilePath));
+		}
+	}
+
+	ParallelFor(ChangedEntries.Num(), [&ChangedEntries](int32 EntryIndex)
+	{
+		ReadEntryInfo(ChangedEntries[EntryIndex]);
+	});
+
+	{
+		FRAIScopeLock Lock(&CriticalSection);
+
+		TArray<FString> RemovedFilePaths;
+		for (auto EntryIt = Entries.CreateIterator(); EntryIt; ++EntryIt)
+		{
+			if (IsInDirectory(EntryIt.Key(), NormalizedDirectory, bRecursive) && !FoundFilePaths.Contains(EntryIt.Key()))
+			{
+				RemovedFilePaths.Add(EntryIt.Key());
+				EntryIt.RemoveCurrent();
+			}
+		}
+
+		for (const FRuntimeAudioIndexEntry& ChangedEntry : ChangedEntries)
+		{
+			Entries.Add(ChangedEntry.FilePath, ChangedEntry);
+		}
+
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Scanned directory '%s' for audio files: %d files found, %d new or modified, %d removed"), *NormalizedDirectory, FoundFilePaths.Num(), ChangedEntries.Num(), RemovedFilePaths.Num());
+
+		if (ChangedEntries.Num() > 0 || RemovedFilePaths.Num() > 0)
+		{
+			Save_Internal(ChangedEntries, RemovedFilePaths);
+		}
+
+		CollectEntries_Internal(NormalizedDirectory, bRecursive, OutEntries);
+	}
+
+	return true;
+}
+
+TArray<FRuntimeAudioIndexEntry> FRuntimeAudioDirectoryIndex::Query(const FString& Directory, bool bRecursive)
+{
+	FRAIScopeLock Lock(&CriticalSection);
+	Load_Internal();
+
+	TArray<FRuntimeAudioIndexEntry> FoundEntries;
+	CollectEntries_Internal(NormalizeDirectory(Directory), bRecursive, FoundEntries);
+	return FoundEntries;
+}
+
+void FRuntimeAudioDirectoryIndex::Clear()
+{
+	FRAIScopeLock Lock(&CriticalSection);
+	Entries.Empty();
+	NumOfPersistedRecords = 0;
+	bCompactionRequired = true;
+	bLoaded = true;
+	IFileManager::Get().Delete(*IndexFilePath, false, false, true);
+}
+
+void FRuntimeAudioDirectoryIndex::Load_Internal()
+{
+	if (bLoaded)
+	{
+		return;
+	}
+	bLoaded = true;
+
+	TArray<uint8> IndexData;
+	if (!FFileHelper::LoadFileToArray(IndexData, *IndexFilePath, FILEREAD_Silent))
+	{
+		return;
+	}
+
+	FMemoryReader Reader(IndexData);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != AudioDirectoryIndexMagic || Version != AudioDirectoryIndexVersion)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Ignoring the outdated audio directory index '%s'"), *IndexFilePath);
+		return;
+	}
+
+	// Replaying the records in the order they were appended, so that later records override earlier ones
+	while (!Reader.AtEnd())
+	{
+		EAudioDirectoryIndexRecord RecordType;
+		Reader << RecordType;
+
+		if (RecordType == EAudioDirectoryIndexRecord::Update)
+		{
+			FRuntimeAudioIndexEntry Entry;
+			Reader << Entry;
+			if (Reader.IsError())
+			{
+				break;
+			}
+			FString FilePath = Entry.FilePath;
+			Entries.Add(MoveTemp(FilePath), MoveTemp(Entry));
+		}
+		else if (RecordType == EAudioDirectoryIndexRecord::Remove)
+		{
+			FString FilePath;
+			Reader << FilePath;
+			if (Reader.IsError())
+			{
+				break;
+			}
+			Entries.Remove(FilePath);
+		}
+		else
+		{
+			Reader.SetError();
+		}
+
+		if (Reader.IsError())
+		{
+			break;
+		}
+		++NumOfPersistedRecords;
+	}
+
+	// A record cut short (e.g. by a crash while appending) keeps everything before it, the index is rewritten on the next save so that nothing is appended after the damaged tail
+	bCompactionRequired = Reader.IsError();
+	if (bCompactionRequired)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("The audio directory index '%s' is damaged after %d records, it will be rewritten"), *IndexFilePath, NumOfPersistedRecords);
+	}
+}
+
+void FRuntimeAudioDirectoryIndex::Save_Internal(const TArray<FRuntimeAudioIndexEntry>& UpdatedEntries, const TArray<FString>& RemovedFilePaths)
+{
+	const int32 NumOfNewRecords = UpdatedEntries.Num() + RemovedFilePaths.Num();
+	if (bCompactionRequired || NumOfPersistedRecords + NumOfNewRecords > FMath::Max(Entries.Num() * 2, MinNumOfRecordsToCompact))
+	{
+		Compact_Internal();
+		return;
+	}
+
+	TArray<uint8> RecordsData;
+	FMemoryWriter Writer(RecordsData);
+	for (const FRuntimeAudioIndexEntry& UpdatedEntry : UpdatedEntries)
+	{
+		EAudioDirectoryIndexRecord RecordType = EAudioDirectoryIndexRecord::Update;
+		Writer << RecordType;
+		Writer << const_cast<FRuntimeAudioIndexEntry&>(UpdatedEntry);
+	}
+	for (const FString& RemovedFilePath : RemovedFilePaths)
+	{
+		EAudioDirectoryIndexRecord RecordType = EAudioDirectoryIndexRecord::Remove;
+		Writer << RecordType;
+		Writer << const_cast<FString&>(RemovedFilePath);
+	}
+
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*IndexFilePath, FILEWRITE_Append | FILEWRITE_Silent));
+	if (!FileWriter)
+	{
+		Compact_Internal();
+		return;
+	}
+	FileWriter->Serialize(RecordsData.GetData(), RecordsData.Num());
+	if (!FileWriter->Close())
+	{
+		// Part of the records may have been written, so the file can no longer be appended to
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Failed to append to the audio directory index '%s', rewriting it"), *IndexFilePath);
+		FileWriter.Reset();
+		Compact_Internal();
+		return;
+	}
+	NumOfPersistedRecords += NumOfNewRecords;
+}
+
+void FRuntimeAudioDirectoryIndex::Compact_Internal()
+{
+	TArray<uint8> IndexData;
+	FMemoryWriter Writer(IndexData);
+	uint32 Magic = AudioDirectoryIndexMagic;
+	int32 Version = AudioDirectoryIndexVersion;
+	Writer << Magic;
+	Writer << Version;
+	for (TPair<FString, FRuntimeAudioIndexEntry>& Entry : Entries)
+	{
+		EAudioDirectoryIndexRecord RecordType = EAudioDirectoryIndexRecord::Update;
+		Writer << RecordType;
+		Writer << Entry.Value;
+	}
+
+	if (!FFileHelper::SaveArrayToFile(IndexData, *IndexFilePath))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Failed to save the audio directory index to '%s'"), *IndexFilePath);
+		bCompactionRequired = true;
+		return;
+	}
+	NumOfPersistedRecords = Entries.Num();
+	bCompactionRequired = false;
+}
+
+void FRuntimeAudioDirectoryIndex::CollectEntries_Internal(const FString& Directory, bool bRecursive, TArray<FRuntimeAudioIndexEntry>& OutEntries) const
+{
+	OutEntries.Reset();
+	for (const TPair<FString, FRuntimeAudioIndexEntry>& Entry : Entries)
+	{
+		if (IsInDirectory(Entry.Key, Directory, bRecursive))
+		{
+			OutEntries.Add(Entry.Value);
+		}
+	}
+
+	OutEntries.Sort([](const FRuntimeAudioIndexEntry& A, const FRuntimeAudioIndexEntry& B)
+	{
+		return A.FilePath < B.FilePath;
+	});
+}
+
+FString FRuntimeAudioDirectoryIndex::NormalizeDirectory(const FString& Directory)
+{
+	FString NormalizedDirectory = FPaths::ConvertRelativePathToFull(Directory);
+	FPaths::NormalizeDirectoryName(NormalizedDirectory);
+	return NormalizedDirectory;
+}
+
+bool FRuntimeAudioDirectoryIndex::IsInDirectory(const FString& FilePath, const FString& Directory, bool bRecursive)
+{
+	// Root directories (e.g. "C:/") keep their trailing slash after normalization
+	const int32 PrefixLength = Directory.EndsWith(TEXT("/")) ? Directory.Len() : Directory.Len() + 1;
+	if (FilePath.Len() <= PrefixLength || FilePath[PrefixLength - 1] != TEXT('/') || !FilePath.StartsWith(Directory))
+	{
+		return false;
+	}
+
+	int32 SlashIndex;
+	return bRecursive || (FilePath.FindLastChar(TEXT('/'), SlashIndex) && SlashIndex == PrefixLength - 1);
+}
+
+void FRuntimeAudioDirectoryIndex::ReadEntryInfo(FRuntimeAudioIndexEntry& Entry)
+{
+	Entry.bHeaderInfoValid = ReadHeaderInfo(Entry.FilePath, Entry.HeaderInfo);
+
+	// Only MP3 files commonly carry ID3 tags, and reading them costs another open of the file
+	if (Entry.HeaderInfo.AudioFormat == ERuntimeAudioFormat::Mp3 || FPaths::GetExtension(Entry.FilePath).Equals(TEXT("mp3"), ESearchCase::IgnoreCase))
+	{
+		FRuntimeAudioHeaderReader::ReadID3Tags(Entry.FilePath, Entry.Title, Entry.Artist);
+	}
+}
+
+bool FRuntimeAudioDirectoryIndex::ReadHeaderInfo(const FString& FilePath, FRuntimeAudioHeaderInfo& HeaderInfo)
+{
+	// The MP3 frame headers give the duration without decoding, whereas the MP3 codec would need the whole file
+	if (FPaths::GetExtension(FilePath).Equals(TEXT("mp3"), ESearchCase::IgnoreCase) && FRuntimeAudioHeaderReader::ReadMP3HeaderInfo(FilePath, HeaderInfo))
+	{
+		return true;
+	}
+
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	FRuntimeCodecFactory CodecFactory;
+	const TArray<FBaseRuntimeCodec*> RuntimeCodecs = CodecFactory.GetCodecs(FilePath);
+
+	// Codecs supporting range decoding read the header straight from the mapped file, so only the pages holding the header are loaded
+	if (const FRuntimeAudioMappedFilePtr MappedFile = FRuntimeAudioMappedFile::Open(FilePath))
+	{
+		for (FBaseRuntimeCodec* RuntimeCodec : RuntimeCodecs)
+		{
+			if (RuntimeCodec->PrepareRangeDecode(MappedFile->GetData(), MappedFile->GetSize(), HeaderInfo))
+			{
+				return true;
+			}
+		}
+	}
+
+	TArray64<uint8> AudioBuffer;
+	if (!RuntimeAudioImporter::LoadAudioFileToArray(AudioBuffer, *FilePath))
+	{
+		return false;
+	}
+
+	FEncodedAudioStruct EncodedData;
+	EncodedData.AudioData = FRuntimeBulkDataBuffer<uint8>(AudioBuffer);
+	for (FBaseRuntimeCodec* RuntimeCodec : RuntimeCodecs)
+	{
+		EncodedData.AudioFormat = RuntimeCodec->GetAudioFormat();
+		if (RuntimeCodec->GetHeaderInfo(EncodedData, HeaderInfo))
+		{
+			return true;
+		}
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Failed to read the header of the audio file '%s' while indexing it"), *FilePath);
+	return false;
+#else
+	return false;
+#endif
+}
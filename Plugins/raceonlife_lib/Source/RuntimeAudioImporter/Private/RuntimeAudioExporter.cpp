@@ -103,7 +103,9 @@ void URuntimeAudioExporter::ExportSoundWaveToBuffer(TWeakObjectPtr<UImportedSoun
 	{
 		FRAIScopeLock Lock(&*ImportedSoundWavePtr->DataGuard);
 
-		if (!ImportedSoundWavePtr->GetPCMBuffer().IsValid())
+		FPCMStruct DecompressedPCMBuffer;
+		const FPCMStruct& PCMBuffer = ImportedSoundWavePtr->GetDecompressedPCMBuffer(DecompressedPCMBuffer);
+		if (!PCMBuffer.IsValid())
 		{
 			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to export sound wave as the PCM data is invalid"));
 			ExecuteResult(false, TArray64<uint8>());
@@ -111,7 +113,7 @@ void URuntimeAudioExporter::ExportSoundWaveToBuffer(TWeakObjectPtr<UImportedSoun
 		}
 
 		{
-			DecodedAudioInfo.PCMInfo = ImportedSoundWavePtr->GetPCMBuffer();
+			DecodedAudioInfo.PCMInfo = PCMBuffer;
 			FSoundWaveBasicStruct SoundWaveBasicInfo;
 			{
 				SoundWaveBasicInfo.NumOfChannels = ImportedSoundWavePtr->GetNumOfChannels();
@@ -266,7 +268,9 @@ void URuntimeAudioExporter::ExportSoundWaveToRAWBuffer(TWeakObjectPtr<UImportedS
 
 	FRAIScopeLock Lock(&*ImportedSoundWavePtr->DataGuard);
 
-	if (!ImportedSoundWavePtr->GetPCMBuffer().IsValid())
+	FPCMStruct DecompressedPCMBuffer;
+	const FPCMStruct& PCMBuffer = ImportedSoundWavePtr->GetDecompressedPCMBuffer(DecompressedPCMBuffer);
+	if (!PCMBuffer.IsValid())
 	{
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to export sound wave as the PCM data is invalid"));
 		ExecuteResult(false, TArray64<uint8>());
@@ -278,7 +282,7 @@ void URuntimeAudioExporter::ExportSoundWaveToRAWBuffer(TWeakObjectPtr<UImportedS
 	// Check if the number of channels and the sampling rate of the sound wave and desired override options are not the same
 	if (OverrideOptions.IsOverriden() && (ImportedSoundWavePtr->GetSampleRate() != OverrideOptions.SampleRate || ImportedSoundWavePtr->GetNumOfChannels() != OverrideOptions.NumOfChannels))
 	{
-		Audio::FAlignedFloatBuffer WaveData(ImportedSoundWavePtr->GetPCMBuffer().PCMData.GetView().GetData(), ImportedSoundWavePtr->GetPCMBuffer().PCMData.GetView().Num());
+		Audio::FAlignedFloatBuffer WaveData(PCMBuffer.PCMData.GetView().GetData(), PCMBuffer.PCMData.GetView().Num());
 
 		// Resampling if needed
 		if (OverrideOptions.IsSampleRateOverriden() && ImportedSoundWavePtr->GetSampleRate() != OverrideOptions.SampleRate)
@@ -311,7 +315,7 @@ void URuntimeAudioExporter::ExportSoundWaveToRAWBuffer(TWeakObjectPtr<UImportedS
 	}
 	else
 	{
-		RAWDataFrom = TArray64<uint8>(reinterpret_cast<uint8*>(ImportedSoundWavePtr->GetPCMBuffer().PCMData.GetView().GetData()), ImportedSoundWavePtr->GetPCMBuffer().PCMData.GetView().Num() * sizeof(float));
+		RAWDataFrom = TArray64<uint8>(reinterpret_cast<uint8*>(PCMBuffer.PCMData.GetView().GetData()), PCMBuffer.PCMData.GetView().Num() * sizeof(float));
 	}
 
 	URuntimeAudioTranscoder::TranscodeRAWDataFromBuffer(MoveTemp(RAWDataFrom), ERuntimeRAWAudioFormat::Float32, RAWFormat, FOnRAWDataTranscodeFromBufferResultNative::CreateWeakLambda(ImportedSoundWavePtr.Get(), [ExecuteResult](bool bSucceeded, const TArray64<uint8>& RAWData)
@@ -0,0 +1,310 @@
+﻿// Georgy Treshchev 2024.
+
+#include "RuntimeAudioHeaderReader.h"
+
+#include "RuntimeAudioImporterTypes.h"
+#include "HAL/PlatformFileManager.h"
+
+namespace
+{
+	/** Upper bound for the ID3v2 tag bytes we are willing to walk, frames past it (usually embedded pictures) are skipped */
+	constexpr int64 MaxID3TagBytesToRead = 64 * 1024;
+
+	/** Bytes read at the start of the MP3 audio to find the first frame header and its Xing/Info or VBRI header */
+	constexpr int32 MP3HeaderBytesToRead = 16 * 1024;
+
+	/** Fields of an MPEG audio Layer III frame header */
+	struct FMP3FrameHeader
+	{
+		int32 SampleRate = 0;
+		int32 NumOfChannels = 0;
+		int32 Bitrate = 0; // In kbit/s
+		int32 SamplesPerFrame = 0;
+		int32 FrameSize = 0;
+		int32 SideInfoSize = 0;
+	};
+
+	/** Parses the 4 byte frame header at Data, returns false if it is not a valid Layer III header */
+	bool ParseMP3FrameHeader(const uint8* Data, FMP3FrameHeader& OutHeader)
+	{
+		if (Data[0] != 0xFF || (Data[1] & 0xE0) != 0xE0)
+		{
+			return false;
+		}
+
+		// Version: 0 - MPEG 2.5, 1 - reserved, 2 - MPEG 2, 3 - MPEG 1. Layer: 1 - Layer III
+		const int32 Version = (Data[1] >> 3) & 0x03;
+		const int32 Layer = (Data[1] >> 1) & 0x03;
+		const int32 BitrateIndex = Data[2] >> 4;
+		const int32 SampleRateIndex = (Data[2] >> 2) & 0x03;
+		if (Version == 1 || Layer != 1 || BitrateIndex == 0 || BitrateIndex == 15 || SampleRateIndex == 3)
+		{
+			return false;
+		}
+
+		static constexpr int32 MPEG1Bitrates[] = {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320};
+		static constexpr int32 MPEG2Bitrates[] = {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160};
+		static constexpr int32 MPEG1SampleRates[] = {44100, 48000, 32000};
+
+		const bool bMPEG1 = Version == 3;
+		OutHeader.SampleRate = MPEG1SampleRates[SampleRateIndex] >> (bMPEG1 ? 0 : Version == 2 ? 1 : 2);
+		OutHeader.NumOfChannels = (Data[3] >> 6) == 3 ? 1 : 2;
+		OutHeader.Bitrate = bMPEG1 ? MPEG1Bitrates[BitrateIndex] : MPEG2Bitrates[BitrateIndex];
+		OutHeader.SamplesPerFrame = bMPEG1 ? 1152 : 576;
+		OutHeader.FrameSize = (bMPEG1 ? 144 : 72) * OutHeader.Bitrate * 1000 / OutHeader.SampleRate + ((Data[2] >> 1) & 0x01);
+		OutHeader.SideInfoSize = bMPEG1 ? (OutHeader.NumOfChannels == 1 ? 17 : 32) : (OutHeader.NumOfChannels == 1 ? 9 : 17);
+		return true;
+	}
+
+	uint32 ReadBigEndian32(const uint8* Data)
+	{
+		return static_cast<uint32>(Data[0]) << 24 | static_cast<uint32>(Data[1]) << 16 | static_cast<uint32>(Data[2]) << 8 | Data[3];
+	}
+
+	FString DecodeID3Text(const uint8* Data, int32 Size)
+	{
+		if (Size <= 1)
+		{
+			return FString();
+		}
+
+		const uint8 Encoding = Data[0];
+		++Data;
+		--Size;
+
+		FString Result;
+		switch (Encoding)
+		{
+		case 1: // UTF-16 with BOM
+		case 2: // UTF-16BE without BOM
+		{
+			bool bBigEndian = Encoding == 2;
+			if (Encoding == 1 && Size >= 2)
+			{
+				bBigEndian = Data[0] == 0xFE && Data[1] == 0xFF;
+				Data += 2;
+				Size -= 2;
+			}
+			Result.Reserve(Size / 2);
+			for (int32 Index = 0; Index + 1 < Size; Index += 2)
+			{
+				const TCHAR Char = bBigEndian ? static_cast<TCHAR>((Data[Index] << 8) | Data[Index + 1]) : static_cast<TCHAR>(Data[Index] | (Data[Index + 1] << 8));
+				if (Char == 0)
+				{
+					break;
+				}
+				Result.AppendChar(Char);
+			}
+			break;
+		}
+		case 3: // UTF-8
+		{
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Size);
+			Result = FString(Converted.Length(), Converted.Get());
+			break;
+		}
+		default: // ISO-8859-1
+		{
+			Result.Reserve(Size);
+			for (int32 Index = 0; Index < Size && Data[Index] != 0; ++Index)
+			{
+				Result.AppendChar(static_cast<TCHAR>(Data[Index]));
+			}
+			break;
+		}
+		}
+
+		// Some taggers pad text frames with trailing terminators
+		int32 NullIndex;
+		if (Result.FindChar(TEXT('\0'), NullIndex))
+		{
+			Result.LeftInline(NullIndex);
+		}
+		return Result.TrimStartAndEnd();
+	}
+
+	FString DecodeID3v1Text(const uint8* Data, int32 Size)
+	{
+		FString Result;
+		for (int32 Index = 0; Index < Size && Data[Index] != 0; ++Index)
+		{
+			Result.AppendChar(static_cast<TCHAR>(Data[Index]));
+		}
+		return Result.TrimStartAndEnd();
+	}
+}
+
+void FRuntimeAudioHeaderReader::ReadID3Tags(const FString& FilePath, FString& OutTitle, FString& OutArtist)
+{
+	TUniquePtr<IFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+	if (!FileHandle)
+	{
+		return;
+	}
+
+	uint8 Header[10];
+	if (FileHandle->Read(Header, sizeof(Header)) && Header[0] == 'I' && Header[1] == 'D' && Header[2] == '3')
+	{
+		const uint8 MajorVersion = Header[3];
+		const int64 TagSize = (Header[6] & 0x7F) << 21 | (Header[7] & 0x7F) << 14 | (Header[8] & 0x7F) << 7 | (Header[9] & 0x7F);
+
+		// ID3v2.2 uses 3 character frame IDs with 6 byte frame headers, ID3v2.3 and ID3v2.4 use 4 character IDs with 10 byte headers
+		const bool bShortFrames = MajorVersion == 2;
+		const int32 FrameHeaderSize = bShortFrames ? 6 : 10;
+
+		TArray<uint8> TagData;
+		TagData.SetNumUninitialized(static_cast<int32>(FMath::Min(TagSize, MaxID3TagBytesToRead)));
+		if (FileHandle->Read(TagData.GetData(), TagData.Num()))
+		{
+			int32 Offset = 0;
+			while (Offset + FrameHeaderSize <= TagData.Num() && (OutTitle.IsEmpty() || OutArtist.IsEmpty()))
+			{
+				const uint8* Frame = TagData.GetData() + Offset;
+				if (Frame[0] == 0)
+				{
+					break; // Padding
+				}
+
+				int32 FrameSize;
+				if (bShortFrames)
+				{
+					FrameSize = Frame[3] << 16 | Frame[4] << 8 | Frame[5];
+				}
+				else if (MajorVersion >= 4)
+				{
+					FrameSize = (Frame[4] & 0x7F) << 21 | (Frame[5] & 0x7F) << 14 | (Frame[6] & 0x7F) << 7 | (Frame[7] & 0x7F);
+				}
+				else
+				{
+					FrameSize = Frame[4] << 24 | Frame[5] << 16 | Frame[6] << 8 | Frame[7];
+				}
+
+				const int32 PayloadOffset = Offset + FrameHeaderSize;
+				if (FrameSize <= 0 || PayloadOffset + FrameSize > TagData.Num())
+				{
+					break;
+				}
+
+				const uint8* Payload = TagData.GetData() + PayloadOffset;
+				const bool bIsTitle = bShortFrames ? FMemory::Memcmp(Frame, "TT2", 3) == 0 : FMemory::Memcmp(Frame, "TIT2", 4) == 0;
+				const bool bIsArtist = bShortFrames ? FMemory::Memcmp(Frame, "TP1", 3) == 0 : FMemory::Memcmp(Frame, "TPE1", 4) == 0;
+				if (bIsTitle && OutTitle.IsEmpty())
+				{
+					OutTitle = DecodeID3Text(Payload, FrameSize);
+				}
+				else if (bIsArtist && OutArtist.IsEmpty())
+				{
+					OutArtist = DecodeID3Text(Payload, FrameSize);
+				}
+
+				Offset = PayloadOffset + FrameSize;
+			}
+		}
+	}
+
+	if (!OutTitle.IsEmpty())
+	{
+		return;
+	}
+
+	// Fall back to the ID3v1 tag in the last 128 bytes of the file
+	const int64 FileSize = FileHandle->Size();
+	uint8 ID3v1Tag[128];
+	if (FileSize >= 128 && FileHandle->Seek(FileSize - 128) && FileHandle->Read(ID3v1Tag, sizeof(ID3v1Tag)) && FMemory::Memcmp(ID3v1Tag, "TAG", 3) == 0)
+	{
+		OutTitle = DecodeID3v1Text(ID3v1Tag + 3, 30);
+		if (OutArtist.IsEmpty())
+		{
+			OutArtist = DecodeID3v1Text(ID3v1Tag + 33, 30);
+		}
+	}
+}
+
+bool FRuntimeAudioHeaderReader::ReadMP3HeaderInfo(const FString& FilePath, FRuntimeAudioHeaderInfo& HeaderInfo)
+{
+	TUniquePtr<IFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+	if (!FileHandle)
+	{
+		return false;
+	}
+	const int64 FileSize = FileHandle->Size();
+
+	// The audio starts after the ID3v2 tag, whose size is known from its header alone
+	int64 AudioOffset = 0;
+	uint8 TagHeader[10];
+	if (FileSize >= 10 && FileHandle->Read(TagHeader, sizeof(TagHeader)) && TagHeader[0] == 'I' && TagHeader[1] == 'D' && TagHeader[2] == '3')
+	{
+		const bool bHasFooter = (TagHeader[5] & 0x10) != 0;
+		AudioOffset = 10 + ((TagHeader[6] & 0x7F) << 21 | (TagHeader[7] & 0x7F) << 14 | (TagHeader[8] & 0x7F) << 7 | (TagHeader[9] & 0x7F)) + (bHasFooter ? 10 : 0);
+	}
+
+	// The ID3v1 tag, if any, is not audio either
+	int64 AudioEnd = FileSize;
+	uint8 ID3v1Marker[3];
+	if (FileSize >= AudioOffset + 128 && FileHandle->Seek(FileSize - 128) && FileHandle->Read(ID3v1Marker, sizeof(ID3v1Marker)) && FMemory::Memcmp(ID3v1Marker, "TAG", 3) == 0)
+	{
+		AudioEnd -= 128;
+	}
+
+	TArray<uint8> AudioData;
+	AudioData.SetNumUninitialized(static_cast<int32>(FMath::Clamp<int64>(AudioEnd - AudioOffset, 0, MP3HeaderBytesToRead)));
+	if (AudioData.Num() < 4 || !FileHandle->Seek(AudioOffset) || !FileHandle->Read(AudioData.GetData(), AudioData.Num()))
+	{
+		return false;
+	}
+
+	// Looking for the first frame header followed by another one, so that a stray sync word in leftover junk is not taken for a frame
+	FMP3FrameHeader FrameHeader;
+	int32 FrameOffset = 0;
+	for (; FrameOffset + 4 <= AudioData.Num(); ++FrameOffset)
+	{
+		if (!ParseMP3FrameHeader(AudioData.GetData() + FrameOffset, FrameHeader))
+		{
+			continue;
+		}
+		const int32 NextFrameOffset = FrameOffset + FrameHeader.FrameSize;
+		FMP3FrameHeader NextFrameHeader;
+		if (NextFrameOffset + 4 > AudioData.Num() || ParseMP3FrameHeader(AudioData.GetData() + NextFrameOffset, NextFrameHeader))
+		{
+			break;
+		}
+	}
+	if (FrameOffset + 4 > AudioData.Num())
+	{
+		return false;
+	}
+
+	HeaderInfo.SampleRate = FrameHeader.SampleRate;
+	HeaderInfo.NumOfChannels = FrameHeader.NumOfChannels;
+	HeaderInfo.AudioFormat = ERuntimeAudioFormat::Mp3;
+
+	// VBR files carry the total number of frames in a Xing/Info header right after the side information, or in a VBRI header at a fixed offset
+	const uint8* Frame = AudioData.GetData() + FrameOffset;
+	const int32 AvailableFrameBytes = AudioData.Num() - FrameOffset;
+	const int32 XingOffset = 4 + FrameHeader.SideInfoSize;
+	const int32 VBRIOffset = 4 + 32;
+	uint32 NumOfFrames = 0;
+	if (XingOffset + 12 <= AvailableFrameBytes && (FMemory::Memcmp(Frame + XingOffset, "Xing", 4) == 0 || FMemory::Memcmp(Frame + XingOffset, "Info", 4) == 0))
+	{
+		if (ReadBigEndian32(Frame + XingOffset + 4) & 0x01)
+		{
+			NumOfFrames = ReadBigEndian32(Frame + XingOffset + 8);
+		}
+	}
+	else if (VBRIOffset + 18 <= AvailableFrameBytes && FMemory::Memcmp(Frame + VBRIOffset, "VBRI", 4) == 0)
+	{
+		NumOfFrames = ReadBigEndian32(Frame + VBRIOffset + 14);
+	}
+
+	if (NumOfFrames > 0)
+	{
+		HeaderInfo.Duration = static_cast<float>(static_cast<double>(NumOfFrames) * FrameHeader.SamplesPerFrame / FrameHeader.SampleRate);
+	}
+	else
+	{
+		// Constant bitrate, the duration follows from the size of the audio
+		HeaderInfo.Duration = static_cast<float>(static_cast<double>(AudioEnd - AudioOffset - FrameOffset) * 8 / (FrameHeader.Bitrate * 1000));
+	}
+	HeaderInfo.PCMDataSize = static_cast<int64>(HeaderInfo.Duration * HeaderInfo.SampleRate) * HeaderInfo.NumOfChannels;
+	return true;
+}
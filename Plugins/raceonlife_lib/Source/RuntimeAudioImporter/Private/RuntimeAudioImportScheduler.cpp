@@ -0,0 +1,257 @@
+﻿// Georgy Treshchev 2024.
+
+#include "RuntimeAudioImportScheduler.h"
+
+#include "RuntimeAudioImporterDefines.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Async/Async.h"
+#include "HAL/PlatformMisc.h"
+
+namespace
+{
+	/** The import running on the current thread */
+	thread_local FRuntimeAudioImportJob* CurrentImportJob = nullptr;
+}
+
+FRuntimeAudioImportJob::FRuntimeAudioImportJob(ERuntimeImportPriority InPriority, int64 InReservedMemory, FRuntimeAudioImportCancellationTokenPtr InCancellationToken, TUniqueFunction<void()>&& InWork, TUniqueFunction<void()>&& InOnCancelled)
+	: Priority(InPriority)
+	, ReservedMemory(FMath::Max<int64>(InReservedMemory, 0))
+	, CancellationToken(MoveTemp(InCancellationToken))
+	, Work(MoveTemp(InWork))
+	, OnCancelled(MoveTemp(InOnCancelled))
+	, bStarted(false)
+{
+}
+
+FRuntimeAudioImportJob::~FRuntimeAudioImportJob()
+{
+	// Memory is only accounted for once the import has been started
+	if (bStarted)
+	{
+		FRuntimeAudioImportScheduler::Get().AdjustMemoryInFlight(-ReservedMemory.Load());
+	}
+}
+
+bool FRuntimeAudioImportJob::IsCancelled() const
+{
+	return CancellationToken.IsValid() && CancellationToken->IsCancelled();
+}
+
+void FRuntimeAudioImportJob::UpdateReservedMemory(int64 NewReservedMemory)
+{
+	FRuntimeAudioImportScheduler::Get().ReplaceReservedMemory(*this, FMath::Max<int64>(NewReservedMemory, 0));
+}
+
+int64 FRuntimeAudioImportJob::GetReservedMemory() const
+{
+	return ReservedMemory.Load();
+}
+
+FRuntimeAudioImportScheduler& FRuntimeAudioImportScheduler::Get()
+{
+	static FRuntimeAudioImportScheduler Scheduler;
+	return Scheduler;
+}
+
+FRuntimeAudioImportScheduler::FRuntimeAudioImportScheduler()
+	: MaxConcurrentImports(FMath::Max(1, FPlatformMisc::NumberOfWorkerThreadsToSpawn() / 2))
+	, NumOfRunningImports(0)
+	, MemoryBudget(512ll * 1024 * 1024)
+	, MemoryInFlight(0)
+{
+	Queues.SetNum(static_cast<int32>(ERuntimeImportPriority::Low) + 1);
+}
+
+void FRuntimeAudioImportScheduler::EnqueueImport(ERuntimeImportPriority Priority, int64 EstimatedMemory, FRuntimeAudioImportCancellationTokenPtr CancellationToken, TUniqueFunction<void()>&& Work, TUniqueFunction<void()>&& OnCancelled)
+{
+	{
+		FRAIScopeLock Lock(&CriticalSection);
+		Queues[static_cast<int32>(Priority)].Add(MakeShared<FRuntimeAudioImportJob, ESPMode::ThreadSafe>(Priority, EstimatedMemory, MoveTemp(CancellationToken), MoveTemp(Work), MoveTemp(OnCancelled)));
+	}
+
+	PumpQueue();
+}
+
+FRuntimeAudioImportJobPtr FRuntimeAudioImportScheduler::GetCurrentJob()
+{
+	return CurrentImportJob ? CurrentImportJob->AsShared() : FRuntimeAudioImportJobPtr();
+}
+
+void FRuntimeAudioImportScheduler::SetMaxConcurrentImports(int32 InMaxConcurrentImports)
+{
+	{
+		FRAIScopeLock Lock(&CriticalSection);
+		MaxConcurrentImports = FMath::Max(1, InMaxConcurrentImports);
+	}
+
+	PumpQueue();
+}
+
+int32 FRuntimeAudioImportScheduler::GetMaxConcurrentImports() const
+{
+	FRAIScopeLock Lock(&CriticalSection);
+	return MaxConcurrentImports;
+}
+
+void FRuntimeAudioImportScheduler::SetMemoryBudget(int64 InMemoryBudget)
+{
+	{
+		FRAIScopeLock Lock(&CriticalSection);
+		MemoryBudget = FMath::Max<int64>(InMemoryBudget, 0);
+	}
+
+	PumpQueue();
+}
+
+int64 FRuntimeAudioImportScheduler::GetMemoryBudget() const
+{
+	FRAIScopeLock Lock(&CriticalSection);
+	return MemoryBudget;
+}
+
+int64 FRuntimeAudioImportScheduler::GetMemoryInFlight() const
+{
+	FRAIScopeLock Lock(&CriticalSection);
+	return MemoryInFlight;
+}
+
+int32 FRuntimeAudioImportScheduler::GetNumOfRunningImports() const
+{
+	FRAIScopeLock Lock(&CriticalSection);
+	return NumOfRunningImports;
+}
+
+int32 FRuntimeAudioImportScheduler::GetNumOfQueuedImports() const
+{
+	FRAIScopeLock Lock(&CriticalSection);
+	int32 NumOfQueuedImports = 0;
+	for (const TArray<FRuntimeAudioImportJobPtr>& Queue : Queues)
+	{
+		NumOfQueuedImports += Queue.Num();
+	}
+	return NumOfQueuedImports;
+}
+
+void FRuntimeAudioImportScheduler::PumpQueue()
+{
+	TArray<FRuntimeAudioImportJobPtr> JobsToStart;
+	TArray<FRuntimeAudioImportJobPtr> CancelledJobs;
+	{
+		FRAIScopeLock Lock(&CriticalSection);
+
+		// Queues are drained strictly in priority order, so a blocked higher priority import also holds back lower priority ones
+		bool bBlocked = false;
+		for (TArray<FRuntimeAudioImportJobPtr>& Queue : Queues)
+		{
+			while (!bBlocked && Queue.Num() > 0)
+			{
+				const FRuntimeAudioImportJobPtr& Job = Queue[0];
+				if (Job->IsCancelled())
+				{
+					CancelledJobs.Add(Job);
+					Queue.RemoveAt(0);
+					continue;
+				}
+
+				// An import is always allowed to start when nothing else is in flight, so an import larger than the budget cannot stall the queue
+				if (NumOfRunningImports >= MaxConcurrentImports || (MemoryInFlight > 0 && MemoryInFlight + Job->GetReservedMemory() > MemoryBudget))
+				{
+					bBlocked = true;
+					break;
+				}
+
+				Job->bStarted = true;
+				MemoryInFlight += Job->GetReservedMemory();
+				++NumOfRunningImports;
+
+				JobsToStart.Add(Job);
+				Queue.RemoveAt(0);
+			}
+		}
+	}
+
+	for (FRuntimeAudioImportJobPtr& Job : JobsToStart)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("Starting an import reserving %lld bytes"), Job->GetReservedMemory());
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, Job = MoveTemp(Job)]()
+		{
+			RunJob(Job);
+		});
+	}
+
+	for (const FRuntimeAudioImportJobPtr& Job : CancelledJobs)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("A queued import was cancelled before it started"));
+		if (Job->OnCancelled)
+		{
+			Job->OnCancelled();
+		}
+	}
+}
+
+void FRuntimeAudioImportScheduler::RunJob(const FRuntimeAudioImportJobPtr& Job)
+{
+	{
+		// Moving the work out of the job so that its captures (e.g. the encoded audio data) are released as soon as it returns
+		TUniqueFunction<void()> Work = MoveTemp(Job->Work);
+		TUniqueFunction<void()> OnCancelled = MoveTemp(Job->OnCancelled);
+
+		CurrentImportJob = Job.Get();
+		if (!Job->IsCancelled())
+		{
+			Work();
+		}
+		else if (OnCancelled)
+		{
+			OnCancelled();
+		}
+		CurrentImportJob = nullptr;
+	}
+
+	{
+		FRAIScopeLock Lock(&CriticalSection);
+		--NumOfRunningImports;
+	}
+
+	PumpQueue();
+}
+
+void FRuntimeAudioImportScheduler::ReplaceReservedMemory(FRuntimeAudioImportJob& Job, int64 NewReservedMemory)
+{
+	int64 Delta = 0;
+	{
+		FRAIScopeLock Lock(&CriticalSection);
+
+		// The delta is taken from the value the exchange actually replaced, and the lock orders it with PumpQueue starting the import,
+		// so that concurrent updates are each accounted for exactly once, whether they happen before or after the import starts
+		const int64 PreviousReservedMemory = Job.ReservedMemory.Exchange(NewReservedMemory);
+		if (Job.bStarted)
+		{
+			Delta = NewReservedMemory - PreviousReservedMemory;
+			MemoryInFlight += Delta;
+		}
+	}
+
+	if (Delta < 0)
+	{
+		PumpQueue();
+	}
+}
+
+void FRuntimeAudioImportScheduler::AdjustMemoryInFlight(int64 Delta)
+{
+	if (Delta == 0)
+	{
+		return;
+	}
+
+	{
+		FRAIScopeLock Lock(&CriticalSection);
+		MemoryInFlight += Delta;
+	}
+
+	if (Delta < 0)
+	{
+		PumpQueue();
+	}
+}
@@ -9,12 +9,17 @@
 #include "PreImportedSoundAsset.h"
 #include "RuntimeAudioTranscoder.h"
 #include "RuntimeAudioUtilities.h"
+#include "RuntimeAudioMappedFile.h"
 
 #include "Codecs/RAW_RuntimeCodec.h"
+#include "Codecs/PCMBlock_RuntimeCodec.h"
+#include "Codecs/WAV_RuntimeCodec.h"
 
 #include "Misc/FileHelper.h"
 #include "HAL/PlatformFileManager.h"
+#include "HAL/FileManager.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "Codecs/RuntimeCodecFactory.h"
 #include "Engine/Engine.h"
 #include "UObject/WeakObjectPtrTemplates.h"
@@ -24,17 +29,68 @@
 
 #include "Interfaces/IAudioFormat.h"
 
+URuntimeAudioImporterLibrary::URuntimeAudioImporterLibrary(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+  , ImportPriority(ERuntimeImportPriority::Normal)
+  , PCMStorageMode(ERuntimePCMStorageMode::Uncompressed)
+  , bPlayWavFromMappedFile(false)
+  , CancellationToken(MakeShared<FRuntimeAudioImportCancellationToken, ESPMode::ThreadSafe>())
+{
+}
+
 URuntimeAudioImporterLibrary* URuntimeAudioImporterLibrary::CreateRuntimeAudioImporter()
 {
 	return NewObject<URuntimeAudioImporterLibrary>();
 }
 
+void URuntimeAudioImporterLibrary::CancelImport()
+{
+	CancellationToken->Cancel();
+
+	// Imports started after the cancellation get a fresh token
+	CancellationToken = MakeShared<FRuntimeAudioImportCancellationToken, ESPMode::ThreadSafe>();
+}
+
+void URuntimeAudioImporterLibrary::SetMaxConcurrentImports(int32 MaxConcurrentImports)
+{
+	FRuntimeAudioImportScheduler::Get().SetMaxConcurrentImports(MaxConcurrentImports);
+}
+
+void URuntimeAudioImporterLibrary::SetImportMemoryBudget(int64 MemoryBudget)
+{
+	FRuntimeAudioImportScheduler::Get().SetMemoryBudget(MemoryBudget);
+}
+
+void URuntimeAudioImporterLibrary::ScheduleImport(int64 EstimatedMemory, TUniqueFunction<void()>&& Work)
+{
+	FRuntimeAudioImportScheduler::Get().EnqueueImport(ImportPriority, EstimatedMemory, CancellationToken, MoveTemp(Work), [WeakThis = MakeWeakObjectPtr(this)]()
+	{
+		if (WeakThis.IsValid())
+		{
+			WeakThis->OnResult_Internal(nullptr, ERuntimeImportStatus::Cancelled);
+		}
+	});
+}
+
+bool URuntimeAudioImporterLibrary::HandleCancellation_Internal()
+{
+	const FRuntimeAudioImportJobPtr Job = FRuntimeAudioImportScheduler::GetCurrentJob();
+	if (!Job.IsValid() || !Job->IsCancelled())
+	{
+		return false;
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The audio import was cancelled"));
+	OnResult_Internal(nullptr, ERuntimeImportStatus::Cancelled);
+	return true;
+}
+
 void URuntimeAudioImporterLibrary::ImportAudioFromFile(const FString& FilePath, ERuntimeAudioFormat AudioFormat)
 {
 #if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
 	if (IsInGameThread())
 	{
-		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [WeakThis = MakeWeakObjectPtr(this), FilePath, AudioFormat]()
+		ScheduleImport(IFileManager::Get().FileSize(*FilePath), [WeakThis = MakeWeakObjectPtr(this), FilePath, AudioFormat]()
 		{
 			if (WeakThis.IsValid())
 			{
@@ -59,6 +115,11 @@ void URuntimeAudioImporterLibrary::ImportAudioFromFile(const FString& FilePath,
 	AudioFormat = AudioFormat == ERuntimeAudioFormat::Auto ? (PossibleFormats.Num() == 0 ? ERuntimeAudioFormat::Invalid : PossibleFormats[0]) : AudioFormat;
 	AudioFormat = AudioFormat == ERuntimeAudioFormat::Invalid ? ERuntimeAudioFormat::Auto : AudioFormat;
 
+	if ((AudioFormat == ERuntimeAudioFormat::Wav || AudioFormat == ERuntimeAudioFormat::Flac) && ImportAudioFromMappedFile_Internal(FilePath, AudioFormat))
+	{
+		return;
+	}
+
 	TArray64<uint8> AudioBuffer;
 	if (!RuntimeAudioImporter::LoadAudioFileToArray(AudioBuffer, *FilePath))
 	{
@@ -66,6 +127,11 @@ void URuntimeAudioImporterLibrary::ImportAudioFromFile(const FString& FilePath,
 		return;
 	}
 
+	if (HandleCancellation_Internal())
+	{
+		return;
+	}
+
 	ImportAudioFromBuffer(MoveTemp(AudioBuffer), AudioFormat);
 #else
 	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to import audio from file '%s' because the file operation support is disabled"), *FilePath);
@@ -73,6 +139,58 @@ void URuntimeAudioImporterLibrary::ImportAudioFromFile(const FString& FilePath,
 #endif
 }
 
+bool URuntimeAudioImporterLibrary::ImportAudioFromMappedFile_Internal(const FString& FilePath, ERuntimeAudioFormat AudioFormat)
+{
+	const FRuntimeAudioMappedFilePtr MappedFile = FRuntimeAudioMappedFile::Open(FilePath);
+	if (!MappedFile.IsValid())
+	{
+		return false;
+	}
+
+	OnProgress_Internal(25);
+
+	FDecodedAudioStruct DecodedAudioInfo;
+	FRuntimeAudioHeaderInfo HeaderInfo;
+	TSharedRef<FMappedPCMData, ESPMode::ThreadSafe> MappedPCMData = MakeShared<FMappedPCMData, ESPMode::ThreadSafe>();
+
+	// Uncompressed sound waves can play 16-bit integer and 32-bit float WAV data straight from the mapped file without decoding it at all
+	if (bPlayWavFromMappedFile && PCMStorageMode == ERuntimePCMStorageMode::Uncompressed && AudioFormat == ERuntimeAudioFormat::Wav
+		&& FWAV_RuntimeCodec::GetDirectPCMLayout(MappedFile->GetData(), MappedFile->GetSize(), *MappedPCMData, HeaderInfo))
+	{
+		MappedPCMData->MappedFile = MappedFile;
+
+		// Paging in the beginning of the sample data here, so that the first playback callbacks do not page fault on the audio render thread
+		MappedFile->ReadAhead(MappedPCMData->DataOffset, FMappedPCMData::ReadAheadSize);
+		DecodedAudioInfo.PCMInfo.MappedPCMData = MappedPCMData;
+		DecodedAudioInfo.PCMInfo.PCMNumOfFrames = MappedPCMData->NumOfFrames;
+		DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = HeaderInfo.NumOfChannels;
+		DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = HeaderInfo.SampleRate;
+		DecodedAudioInfo.SoundWaveBasicInfo.Duration = HeaderInfo.Duration;
+		DecodedAudioInfo.SoundWaveBasicInfo.AudioFormat = HeaderInfo.AudioFormat;
+	}
+	// Files the codecs cannot decode in ranges (e.g. WAV files with a broken header) are imported through the regular loading path
+	else if (!DecodeAudioDataInRanges(MappedFile->GetData(), MappedFile->GetSize(), AudioFormat, DecodedAudioInfo))
+	{
+		return false;
+	}
+
+	// Only the decoded PCM data is in flight now, the pages of the mapped file are reclaimed by the OS as needed
+	if (const FRuntimeAudioImportJobPtr Job = FRuntimeAudioImportScheduler::GetCurrentJob())
+	{
+		Job->UpdateReservedMemory(DecodedAudioInfo.PCMInfo.PCMData.GetView().Num() * sizeof(float));
+	}
+
+	if (HandleCancellation_Internal())
+	{
+		return true;
+	}
+
+	OnProgress_Internal(65);
+
+	ImportAudioFromDecodedInfo(MoveTemp(DecodedAudioInfo));
+	return true;
+}
+
 void URuntimeAudioImporterLibrary::ImportAudioFromPreImportedSound(UPreImportedSoundAsset* PreImportedSoundAsset)
 {
 	ImportAudioFromBuffer(PreImportedSoundAsset->AudioDataArray, PreImportedSoundAsset->AudioFormat);
@@ -87,7 +205,8 @@ void URuntimeAudioImporterLibrary::ImportAudioFromBuffer(TArray64<uint8> AudioDa
 {
 	if (IsInGameThread())
 	{
-		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [WeakThis = MakeWeakObjectPtr(this), AudioData = MoveTemp(AudioData), AudioFormat]() mutable
+		const int64 EstimatedMemory = AudioData.Num();
+		ScheduleImport(EstimatedMemory, [WeakThis = MakeWeakObjectPtr(this), AudioData = MoveTemp(AudioData), AudioFormat]() mutable
 		{
 			if (WeakThis.IsValid())
 			{
@@ -121,6 +240,17 @@ void URuntimeAudioImporterLibrary::ImportAudioFromBuffer(TArray64<uint8> AudioDa
 		return;
 	}
 
+	// The encoded data is released together with this scope, from now on only the decoded PCM data is in flight
+	if (const FRuntimeAudioImportJobPtr Job = FRuntimeAudioImportScheduler::GetCurrentJob())
+	{
+		Job->UpdateReservedMemory(DecodedAudioInfo.PCMInfo.PCMData.GetView().Num() * sizeof(float));
+	}
+
+	if (HandleCancellation_Internal())
+	{
+		return;
+	}
+
 	OnProgress_Internal(65);
 
 	ImportAudioFromDecodedInfo(MoveTemp(DecodedAudioInfo));
@@ -131,7 +261,7 @@ void URuntimeAudioImporterLibrary::ImportAudioFromRAWFile(const FString& FilePat
 #if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
 	if (IsInGameThread())
 	{
-		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [WeakThis = MakeWeakObjectPtr(this), FilePath, RAWFormat, SampleRate, NumOfChannels]()
+		ScheduleImport(IFileManager::Get().FileSize(*FilePath), [WeakThis = MakeWeakObjectPtr(this), FilePath, RAWFormat, SampleRate, NumOfChannels]()
 		{
 			if (WeakThis.IsValid())
 			{
@@ -160,6 +290,11 @@ void URuntimeAudioImporterLibrary::ImportAudioFromRAWFile(const FString& FilePat
 		return;
 	}
 
+	if (HandleCancellation_Internal())
+	{
+		return;
+	}
+
 	OnProgress_Internal(35);
 	ImportAudioFromRAWBuffer(MoveTemp(AudioBuffer), RAWFormat, SampleRate, NumOfChannels);
 #else
@@ -175,6 +310,23 @@ void URuntimeAudioImporterLibrary::ImportAudioFromRAWBuffer(TArray<uint8> RAWBuf
 
 void URuntimeAudioImporterLibrary::ImportAudioFromRAWBuffer(TArray64<uint8> RAWBuffer, ERuntimeRAWAudioFormat RAWFormat, int32 SampleRate, int32 NumOfChannels)
 {
+	if (IsInGameThread())
+	{
+		const int64 EstimatedMemory = RAWBuffer.Num();
+		ScheduleImport(EstimatedMemory, [WeakThis = MakeWeakObjectPtr(this), RAWBuffer = MoveTemp(RAWBuffer), RAWFormat, SampleRate, NumOfChannels]() mutable
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->ImportAudioFromRAWBuffer(MoveTemp(RAWBuffer), RAWFormat, SampleRate, NumOfChannels);
+			}
+			else
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to import RAW audio from buffer because the RuntimeAudioImporterLibrary object has been destroyed"));
+			}
+		});
+		return;
+	}
+
 	uint8* ByteDataPtr = RAWBuffer.GetData();
 	const int64 ByteDataSize = RAWBuffer.Num();
 
@@ -239,6 +391,18 @@ void URuntimeAudioImporterLibrary::ImportAudioFromRAWBuffer(TArray64<uint8> RAWB
 		return;
 	}
 
+	// The RAW buffer is released together with this scope, from now on only the transcoded PCM data is in flight
+	if (const FRuntimeAudioImportJobPtr Job = FRuntimeAudioImportScheduler::GetCurrentJob())
+	{
+		Job->UpdateReservedMemory(NumOfSamples * sizeof(float));
+	}
+
+	if (HandleCancellation_Internal())
+	{
+		FMemory::Free(Float32DataPtr);
+		return;
+	}
+
 	ImportAudioFromFloat32Buffer(FRuntimeBulkDataBuffer<float>(Float32DataPtr, NumOfSamples), SampleRate, NumOfChannels);
 }
 
@@ -436,10 +600,31 @@ void URuntimeAudioImporterLibrary::ImportAudioFromDecodedInfo(FDecodedAudioStruc
 	// Making sure we are in the game thread
 	if (!IsInGameThread())
 	{
-		AsyncTask(ENamedThreads::GameThread, [WeakThis = MakeWeakObjectPtr(this), DecodedAudioInfo = MoveTemp(DecodedAudioInfo)]() mutable
+		// Compressing the PCM data while still on the worker thread so that only the compressed data is handed over to the game thread
+		if (PCMStorageMode != ERuntimePCMStorageMode::Uncompressed && !DecodedAudioInfo.PCMInfo.IsCompressed() && DecodedAudioInfo.PCMInfo.PCMData.GetView().Num() > 0)
+		{
+			if (FCompressedPCMDataPtr CompressedPCMData = FPCMBlock_RuntimeCodec::Compress(DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData(), DecodedAudioInfo.PCMInfo.PCMData.GetView().Num(), DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels, PCMStorageMode == ERuntimePCMStorageMode::Compressed16Bit))
+			{
+				DecodedAudioInfo.PCMInfo.CompressedPCMData = MoveTemp(CompressedPCMData);
+				DecodedAudioInfo.PCMInfo.PCMData.Empty();
+
+				if (const FRuntimeAudioImportJobPtr Job = FRuntimeAudioImportScheduler::GetCurrentJob())
+				{
+					Job->UpdateReservedMemory(DecodedAudioInfo.PCMInfo.CompressedPCMData->GetAllocatedSize());
+				}
+			}
+		}
+
+		// The scheduled import (if any) is kept alive until the decoded data is handed over to the sound wave, so that its memory stays reserved
+		AsyncTask(ENamedThreads::GameThread, [WeakThis = MakeWeakObjectPtr(this), DecodedAudioInfo = MoveTemp(DecodedAudioInfo), Job = FRuntimeAudioImportScheduler::GetCurrentJob()]() mutable
 		{
 			if (WeakThis.IsValid())
 			{
+				if (Job.IsValid() && Job->IsCancelled())
+				{
+					WeakThis->OnResult_Internal(nullptr, ERuntimeImportStatus::Cancelled);
+					return;
+				}
 				WeakThis->ImportAudioFromDecodedInfo(MoveTemp(DecodedAudioInfo));
 			}
 			else
@@ -459,6 +644,7 @@ void URuntimeAudioImporterLibrary::ImportAudioFromDecodedInfo(FDecodedAudioStruc
 	}
 
 	ImportedSoundWave->AddToRoot();
+	ImportedSoundWave->SetPCMStorageMode(PCMStorageMode);
 
 	OnProgress_Internal(75);
 
@@ -571,6 +757,59 @@ bool URuntimeAudioImporterLibrary::DecodeAudioData(FEncodedAudioStruct&& Encoded
 	return false;
 }
 
+bool URuntimeAudioImporterLibrary::DecodeAudioDataInRanges(const uint8* AudioData, int64 AudioDataSize, ERuntimeAudioFormat AudioFormat, FDecodedAudioStruct& DecodedAudioInfo)
+{
+	// Number of frames decoded by a single task
+	constexpr int64 NumOfFramesPerRange = 65536;
+
+	FRuntimeCodecFactory CodecFactory;
+	for (FBaseRuntimeCodec* RuntimeCodec : CodecFactory.GetCodecs(AudioFormat))
+	{
+		FRuntimeAudioHeaderInfo HeaderInfo;
+		if (!RuntimeCodec->PrepareRangeDecode(AudioData, AudioDataSize, HeaderInfo) || HeaderInfo.NumOfChannels <= 0 || HeaderInfo.PCMDataSize <= 0)
+		{
+			continue;
+		}
+
+		const int64 NumOfFrames = HeaderInfo.PCMDataSize / HeaderInfo.NumOfChannels;
+		float* PCMData = static_cast<float*>(FMemory::Malloc(HeaderInfo.PCMDataSize * sizeof(float)));
+		if (!PCMData)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to allocate memory for decoding '%s' audio data"), *UEnum::GetValueAsString(RuntimeCodec->GetAudioFormat()));
+			return false;
+		}
+
+		const int32 NumOfRanges = static_cast<int32>(FMath::DivideAndRoundUp(NumOfFrames, NumOfFramesPerRange));
+		TAtomic<bool> bSucceeded(true);
+		ParallelFor(NumOfRanges, [&](int32 RangeIndex)
+		{
+			const int64 RangeStartFrame = RangeIndex * NumOfFramesPerRange;
+			const int64 NumOfRangeFrames = FMath::Min(NumOfFramesPerRange, NumOfFrames - RangeStartFrame);
+			if (RuntimeCodec->DecodeRange(AudioData, AudioDataSize, RangeStartFrame, NumOfRangeFrames, PCMData + RangeStartFrame * HeaderInfo.NumOfChannels) != NumOfRangeFrames)
+			{
+				bSucceeded = false;
+			}
+		});
+
+		if (!bSucceeded)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Something went wrong while decoding '%s' audio data in ranges"), *UEnum::GetValueAsString(RuntimeCodec->GetAudioFormat()));
+			FMemory::Free(PCMData);
+			return false;
+		}
+
+		DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(PCMData, HeaderInfo.PCMDataSize);
+		DecodedAudioInfo.PCMInfo.PCMNumOfFrames = NumOfFrames;
+		DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = HeaderInfo.NumOfChannels;
+		DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = HeaderInfo.SampleRate;
+		DecodedAudioInfo.SoundWaveBasicInfo.Duration = HeaderInfo.Duration;
+		DecodedAudioInfo.SoundWaveBasicInfo.AudioFormat = HeaderInfo.AudioFormat;
+		return true;
+	}
+
+	return false;
+}
+
 bool URuntimeAudioImporterLibrary::EncodeAudioData(FDecodedAudioStruct&& DecodedAudioInfo, FEncodedAudioStruct& EncodedAudioInfo, uint8 Quality)
 {
 	if (EncodedAudioInfo.AudioFormat == ERuntimeAudioFormat::Auto || EncodedAudioInfo.AudioFormat == ERuntimeAudioFormat::Invalid)
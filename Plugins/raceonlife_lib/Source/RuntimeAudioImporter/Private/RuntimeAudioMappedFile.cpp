@@ -0,0 +1,146 @@
+﻿// Georgy Treshchev 2024.
+
+#include "RuntimeAudioMappedFile.h"
+
+#include "RuntimeAudioImporterDefines.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+
+FRuntimeAudioMappedFile::FRuntimeAudioMappedFile()
+	: ReadAheadStart(0)
+	, ReadAheadEnd(0)
+	, bReadAheadInFlight(false)
+{
+}
+
+FRuntimeAudioMappedFile::~FRuntimeAudioMappedFile()
+{
+	// The region has to be released before the handle it was mapped from
+	MappedFileRegion.Reset();
+	MappedFileHandle.Reset();
+}
+
+FRuntimeAudioMappedFilePtr FRuntimeAudioMappedFile::Open(const FString& FilePath)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	RuntimeAudioImporter::CheckAndRequestPermissions();
+
+	TUniquePtr<IMappedFileHandle> MappedFileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	if (!MappedFileHandle.IsValid() || MappedFileHandle->GetFileSize() <= 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Unable to memory-map the audio file '%s'"), *FilePath);
+		return nullptr;
+	}
+
+	TUniquePtr<IMappedFileRegion> MappedFileRegion(MappedFileHandle->MapRegion(0, MappedFileHandle->GetFileSize()));
+	if (!MappedFileRegion.IsValid() || !MappedFileRegion->GetMappedPtr())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Unable to map the region of the audio file '%s'"), *FilePath);
+		return nullptr;
+	}
+
+	FRuntimeAudioMappedFilePtr MappedFile = MakeShareable(new FRuntimeAudioMappedFile());
+	MappedFile->MappedFileHandle = MoveTemp(MappedFileHandle);
+	MappedFile->MappedFileRegion = MoveTemp(MappedFileRegion);
+	return MappedFile;
+#else
+	return nullptr;
+#endif
+}
+
+const uint8* FRuntimeAudioMappedFile::GetData() const
+{
+	return MappedFileRegion->GetMappedPtr();
+}
+
+int64 FRuntimeAudioMappedFile::GetSize() const
+{
+	return MappedFileRegion->GetMappedSize();
+}
+
+void FRuntimeAudioMappedFile::ReadAhead(int64 Offset, int64 Size)
+{
+	Offset = FMath::Clamp<int64>(Offset, 0, GetSize());
+	const int64 End = FMath::Min(Offset + Size, GetSize());
+
+	// Volatile reads, so that the compiler cannot drop the otherwise unused loads
+	const volatile uint8* Data = GetData();
+	const int64 PageSize = FPlatformMemory::GetConstants().PageSize;
+	uint8 Touched = 0;
+	for (int64 PageOffset = Offset; PageOffset < End; PageOffset += PageSize)
+	{
+		Touched ^= Data[PageOffset];
+	}
+	(void)Touched;
+
+	ReadAheadStart = Offset;
+	ReadAheadEnd = End;
+}
+
+void FRuntimeAudioMappedFile::ReadAheadAsync(int64 Offset, int64 Size)
+{
+	// Nothing to do while at least half of the range is still ahead within the last paged in range
+	if (Offset >= ReadAheadStart && FMath::Min(Offset + Size / 2, GetSize()) <= ReadAheadEnd)
+	{
+		return;
+	}
+
+	bool bExpected = false;
+	if (!bReadAheadInFlight.CompareExchange(bExpected, true))
+	{
+		return;
+	}
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [MappedFile = AsShared(), Offset, Size]()
+	{
+		MappedFile->ReadAhead(Offset, Size);
+		MappedFile->bReadAheadInFlight = false;
+	});
+}
+
+FMappedPCMData::FMappedPCMData()
+	: DataOffset(0)
+	, SampleFormat(ERuntimeRAWAudioFormat::Float32)
+	, NumOfChannels(0)
+	, NumOfFrames(0)
+{
+}
+
+int64 FMappedPCMData::CopyFrames(int64 StartFrame, int64 NumOfFramesToCopy, float* OutPCMData) const
+{
+	NumOfFramesToCopy = FMath::Min(NumOfFramesToCopy, NumOfFrames - StartFrame);
+	if (!MappedFile.IsValid() || StartFrame < 0 || NumOfFramesToCopy <= 0)
+	{
+		return 0;
+	}
+
+	const int64 StartSample = StartFrame * NumOfChannels;
+	const int64 NumOfSamples = NumOfFramesToCopy * NumOfChannels;
+
+	if (SampleFormat == ERuntimeRAWAudioFormat::Float32)
+	{
+		FMemory::Memcpy(OutPCMData, MappedFile->GetData() + DataOffset + StartSample * sizeof(float), NumOfSamples * sizeof(float));
+		ReadAheadAsync(StartFrame + NumOfFramesToCopy);
+		return NumOfFramesToCopy;
+	}
+
+	// Same scale as the WAV decoder uses, so that the mapped playback matches the decoded data exactly
+	const int16* Samples = reinterpret_cast<const int16*>(MappedFile->GetData() + DataOffset) + StartSample;
+	for (int64 SampleIndex = 0; SampleIndex < NumOfSamples; ++SampleIndex)
+	{
+		OutPCMData[SampleIndex] = Samples[SampleIndex] * (1.f / 32768.f);
+	}
+	ReadAheadAsync(StartFrame + NumOfFramesToCopy);
+	return NumOfFramesToCopy;
+}
+
+void FMappedPCMData::ReadAheadAsync(int64 StartFrame) const
+{
+	if (MappedFile.IsValid() && StartFrame < NumOfFrames)
+	{
+		const int64 SampleSize = SampleFormat == ERuntimeRAWAudioFormat::Float32 ? sizeof(float) : sizeof(int16);
+		MappedFile->ReadAheadAsync(DataOffset + StartFrame * NumOfChannels * SampleSize, FMath::Min(ReadAheadSize, (NumOfFrames - StartFrame) * NumOfChannels * SampleSize));
+	}
+}
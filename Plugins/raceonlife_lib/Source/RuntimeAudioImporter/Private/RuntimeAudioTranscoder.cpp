@@ -5,7 +5,377 @@
 
 #include "RuntimeAudioImporterLibrary.h"
 #include "Codecs/RAW_RuntimeCodec.h"
+#include "Codecs/RuntimeCodecFactory.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Algo/Count.h"
+
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+namespace RuntimeAudioBatchTranscoder
+{
+	/** Number of frames in a segment, the unit of parallel decoding and conversion of a single item */
+	constexpr int64 NumOfFramesPerSegment = 65536;
+
+	/** Number of segments kept in memory at the same time when streaming the output to disk */
+	constexpr int64 NumOfSegmentsPerWindow = 16;
+
+	int32 GetRAWSampleSize(ERuntimeRAWAudioFormat RAWFormat)
+	{
+		switch (RAWFormat)
+		{
+		case ERuntimeRAWAudioFormat::Int8:
+		case ERuntimeRAWAudioFormat::UInt8:
+			return sizeof(int8);
+		case ERuntimeRAWAudioFormat::Int16:
+		case ERuntimeRAWAudioFormat::UInt16:
+			return sizeof(int16);
+		case ERuntimeRAWAudioFormat::Int32:
+		case ERuntimeRAWAudioFormat::UInt32:
+			return sizeof(int32);
+		case ERuntimeRAWAudioFormat::Float32:
+			return sizeof(float);
+		}
+		return 0;
+	}
+
+	template <typename FromType>
+	void TranscodeSamplesTo(ERuntimeRAWAudioFormat RAWFormatTo, const FromType* RAWDataFrom, int64 NumOfSamples, uint8* RAWDataTo)
+	{
+		switch (RAWFormatTo)
+		{
+		case ERuntimeRAWAudioFormat::Int8:
+			FRAW_RuntimeCodec::TranscodeRAWDataToBuffer<FromType, int8>(RAWDataFrom, NumOfSamples, reinterpret_cast<int8*>(RAWDataTo));
+			break;
+		case ERuntimeRAWAudioFormat::UInt8:
+			FRAW_RuntimeCodec::TranscodeRAWDataToBuffer<FromType, uint8>(RAWDataFrom, NumOfSamples, RAWDataTo);
+			break;
+		case ERuntimeRAWAudioFormat::Int16:
+			FRAW_RuntimeCodec::TranscodeRAWDataToBuffer<FromType, int16>(RAWDataFrom, NumOfSamples, reinterpret_cast<int16*>(RAWDataTo));
+			break;
+		case ERuntimeRAWAudioFormat::UInt16:
+			FRAW_RuntimeCodec::TranscodeRAWDataToBuffer<FromType, uint16>(RAWDataFrom, NumOfSamples, reinterpret_cast<uint16*>(RAWDataTo));
+			break;
+		case ERuntimeRAWAudioFormat::Int32:
+			FRAW_RuntimeCodec::TranscodeRAWDataToBuffer<FromType, int32>(RAWDataFrom, NumOfSamples, reinterpret_cast<int32*>(RAWDataTo));
+			break;
+		case ERuntimeRAWAudioFormat::UInt32:
+			FRAW_RuntimeCodec::TranscodeRAWDataToBuffer<FromType, uint32>(RAWDataFrom, NumOfSamples, reinterpret_cast<uint32*>(RAWDataTo));
+			break;
+		case ERuntimeRAWAudioFormat::Float32:
+			FRAW_RuntimeCodec::TranscodeRAWDataToBuffer<FromType, float>(RAWDataFrom, NumOfSamples, reinterpret_cast<float*>(RAWDataTo));
+			break;
+		}
+	}
+
+	/**
+	 * Transcode the given number of samples from one RAW format into another, both buffers must be allocated by the caller
+	 */
+	void TranscodeSamples(ERuntimeRAWAudioFormat RAWFormatFrom, const uint8* RAWDataFrom, int64 NumOfSamples, ERuntimeRAWAudioFormat RAWFormatTo, uint8* RAWDataTo)
+	{
+		switch (RAWFormatFrom)
+		{
+		case ERuntimeRAWAudioFormat::Int8:
+			TranscodeSamplesTo<int8>(RAWFormatTo, reinterpret_cast<const int8*>(RAWDataFrom), NumOfSamples, RAWDataTo);
+			break;
+		case ERuntimeRAWAudioFormat::UInt8:
+			TranscodeSamplesTo<uint8>(RAWFormatTo, RAWDataFrom, NumOfSamples, RAWDataTo);
+			break;
+		case ERuntimeRAWAudioFormat::Int16:
+			TranscodeSamplesTo<int16>(RAWFormatTo, reinterpret_cast<const int16*>(RAWDataFrom), NumOfSamples, RAWDataTo);
+			break;
+		case ERuntimeRAWAudioFormat::UInt16:
+			TranscodeSamplesTo<uint16>(RAWFormatTo, reinterpret_cast<const uint16*>(RAWDataFrom), NumOfSamples, RAWDataTo);
+			break;
+		case ERuntimeRAWAudioFormat::Int32:
+			TranscodeSamplesTo<int32>(RAWFormatTo, reinterpret_cast<const int32*>(RAWDataFrom), NumOfSamples, RAWDataTo);
+			break;
+		case ERuntimeRAWAudioFormat::UInt32:
+			TranscodeSamplesTo<uint32>(RAWFormatTo, reinterpret_cast<const uint32*>(RAWDataFrom), NumOfSamples, RAWDataTo);
+			break;
+		case ERuntimeRAWAudioFormat::Float32:
+			TranscodeSamplesTo<float>(RAWFormatTo, reinterpret_cast<const float*>(RAWDataFrom), NumOfSamples, RAWDataTo);
+			break;
+		}
+	}
+
+	/**
+	 * Transcode the RAW data window by window, converting the segments of each window in parallel and writing them to the file in order
+	 *
+	 * @param ReadWindow Provides the source samples of the given range of frames
+	 */
+	bool StreamRAWDataToFile(int64 NumOfFrames, int32 NumOfChannels, ERuntimeRAWAudioFormat RAWFormatFrom, ERuntimeRAWAudioFormat RAWFormatTo, FArchive& Writer, TFunctionRef<const uint8*(int64 StartFrame, int64 NumOfFrames)> ReadWindow)
+	{
+		const int64 SampleSizeFrom = GetRAWSampleSize(RAWFormatFrom);
+		const int64 SampleSizeTo = GetRAWSampleSize(RAWFormatTo);
+
+		TArray64<uint8> WindowData;
+		for (int64 WindowStartFrame = 0; WindowStartFrame < NumOfFrames; WindowStartFrame += NumOfFramesPerSegment * NumOfSegmentsPerWindow)
+		{
+			const int64 NumOfWindowFrames = FMath::Min(NumOfFramesPerSegment * NumOfSegmentsPerWindow, NumOfFrames - WindowStartFrame);
+			const uint8* WindowDataFrom = ReadWindow(WindowStartFrame, NumOfWindowFrames);
+			if (!WindowDataFrom)
+			{
+				return false;
+			}
+
+			WindowData.SetNumUninitialized(NumOfWindowFrames * NumOfChannels * SampleSizeTo);
+
+			const int32 NumOfSegments = static_cast<int32>(FMath::DivideAndRoundUp(NumOfWindowFrames, NumOfFramesPerSegment));
+			ParallelFor(NumOfSegments, [&](int32 SegmentIndex)
+			{
+				const int64 SegmentStartSample = SegmentIndex * NumOfFramesPerSegment * NumOfChannels;
+				const int64 NumOfSegmentSamples = FMath::Min(NumOfFramesPerSegment, NumOfWindowFrames - SegmentIndex * NumOfFramesPerSegment) * NumOfChannels;
+				TranscodeSamples(RAWFormatFrom, WindowDataFrom + SegmentStartSample * SampleSizeFrom, NumOfSegmentSamples, RAWFormatTo, WindowData.GetData() + SegmentStartSample * SampleSizeTo);
+			});
+
+			Writer.Serialize(WindowData.GetData(), WindowData.Num());
+			if (Writer.IsError())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Write the header of a 16-bit PCM WAV file (the same format FWAV_RuntimeCodec encodes into), the sample data is expected to follow
+	 */
+	bool WriteWAVHeader(FArchive& Writer, int32 NumOfChannels, int32 SampleRate, int64 NumOfFrames)
+	{
+		const int64 DataSize = NumOfFrames * NumOfChannels * sizeof(int16);
+		if (DataSize > MAX_uint32 - 36)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to write WAV data of %lld bytes as it exceeds the maximum size of a RIFF container"), DataSize);
+			return false;
+		}
+
+		uint32 RIFFChunkSize = static_cast<uint32>(36 + DataSize);
+		uint32 FormatChunkSize = 16;
+		uint16 FormatTag = 1;
+		uint16 NumOfChannelsValue = static_cast<uint16>(NumOfChannels);
+		uint32 SampleRateValue = static_cast<uint32>(SampleRate);
+		uint32 ByteRate = SampleRateValue * NumOfChannels * sizeof(int16);
+		uint16 BlockAlign = static_cast<uint16>(NumOfChannels * sizeof(int16));
+		uint16 BitsPerSample = 16;
+		uint32 DataChunkSize = static_cast<uint32>(DataSize);
+
+		Writer.Serialize(const_cast<ANSICHAR*>("RIFF"), 4);
+		Writer << RIFFChunkSize;
+		Writer.Serialize(const_cast<ANSICHAR*>("WAVEfmt "), 8);
+		Writer << FormatChunkSize << FormatTag << NumOfChannelsValue << SampleRateValue << ByteRate << BlockAlign << BitsPerSample;
+		Writer.Serialize(const_cast<ANSICHAR*>("data"), 4);
+		Writer << DataChunkSize;
+		return !Writer.IsError();
+	}
+
+	/**
+	 * Decode the encoded audio data, splitting it into segments decoded in parallel if the codec supports decoding independent ranges of frames
+	 */
+	bool DecodeAudioDataInSegments(FEncodedAudioStruct&& EncodedAudioInfo, FDecodedAudioStruct& DecodedAudioInfo)
+	{
+		// Every codec recognizing the audio data is tried in turn, the same way DecodeAudioData does
+		TArray<ERuntimeAudioFormat> AudioFormats;
+		if (EncodedAudioInfo.AudioFormat == ERuntimeAudioFormat::Auto)
+		{
+			FRuntimeCodecFactory CodecFactory;
+			for (FBaseRuntimeCodec* RuntimeCodec : CodecFactory.GetCodecs(EncodedAudioInfo.AudioData))
+			{
+				AudioFormats.AddUnique(RuntimeCodec->GetAudioFormat());
+			}
+		}
+		else
+		{
+			AudioFormats.Add(EncodedAudioInfo.AudioFormat);
+		}
+
+		for (const ERuntimeAudioFormat AudioFormat : AudioFormats)
+		{
+			if (URuntimeAudioImporterLibrary::DecodeAudioDataInRanges(EncodedAudioInfo.AudioData.GetView().GetData(), EncodedAudioInfo.AudioData.GetView().Num(), AudioFormat, DecodedAudioInfo))
+			{
+				return true;
+			}
+		}
+
+		// The codec does not support decoding ranges of frames, decoding the whole audio data at once
+		return URuntimeAudioImporterLibrary::DecodeAudioData(MoveTemp(EncodedAudioInfo), DecodedAudioInfo);
+	}
+
+	/**
+	 * Transcode a single item into the opened destination file
+	 */
+	bool WriteItem(const FRuntimeAudioBatchTranscodeItem& Item, const FString& SourceName, FArchive& Writer)
+	{
+		// RAW to RAW without overriding is streamed from the source to the destination without holding the whole data in memory
+		if (Item.bRAWFrom && Item.bRAWTo && !Item.OverrideOptions.IsOverriden())
+		{
+			const int64 FrameSizeFrom = GetRAWSampleSize(Item.RAWFormatFrom) * Item.NumOfChannelsFrom;
+
+			if (Item.FilePathFrom.IsEmpty())
+			{
+				const int64 NumOfFrames = Item.DataFrom.Num() / FrameSizeFrom;
+				if (NumOfFrames <= 0)
+				{
+					UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to transcode RAW audio data from '%s' because it does not contain any frames"), *SourceName);
+					return false;
+				}
+
+				return StreamRAWDataToFile(NumOfFrames, Item.NumOfChannelsFrom, Item.RAWFormatFrom, Item.RAWFormatTo, Writer, [&Item, FrameSizeFrom](int64 StartFrame, int64 NumOfFrames)
+				{
+					return Item.DataFrom.GetData() + StartFrame * FrameSizeFrom;
+				});
+			}
+
+			TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Item.FilePathFrom));
+			if (!Reader)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Something went wrong when reading RAW data on the path '%s'"), *Item.FilePathFrom);
+				return false;
+			}
+
+			const int64 NumOfFrames = Reader->TotalSize() / FrameSizeFrom;
+			if (NumOfFrames <= 0)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to transcode RAW audio data from '%s' because it does not contain any frames"), *SourceName);
+				return false;
+			}
+
+			TArray64<uint8> WindowDataFrom;
+			return StreamRAWDataToFile(NumOfFrames, Item.NumOfChannelsFrom, Item.RAWFormatFrom, Item.RAWFormatTo, Writer, [&Reader, &WindowDataFrom, FrameSizeFrom](int64 StartFrame, int64 NumOfFrames) -> const uint8*
+			{
+				WindowDataFrom.SetNumUninitialized(NumOfFrames * FrameSizeFrom);
+				Reader->Serialize(WindowDataFrom.GetData(), WindowDataFrom.Num());
+				return Reader->IsError() ? nullptr : WindowDataFrom.GetData();
+			});
+		}
+
+		TArray64<uint8> DataFrom;
+		if (Item.FilePathFrom.IsEmpty())
+		{
+			DataFrom = TArray64<uint8>(Item.DataFrom.GetData(), Item.DataFrom.Num());
+		}
+		else if (!RuntimeAudioImporter::LoadAudioFileToArray(DataFrom, *Item.FilePathFrom))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Something went wrong when reading audio data on the path '%s' for transcoding"), *Item.FilePathFrom);
+			return false;
+		}
+
+		FDecodedAudioStruct DecodedAudioInfo;
+		if (Item.bRAWFrom)
+		{
+			const int64 NumOfFrames = DataFrom.Num() / (GetRAWSampleSize(Item.RAWFormatFrom) * Item.NumOfChannelsFrom);
+			const int64 NumOfSamples = NumOfFrames * Item.NumOfChannelsFrom;
+			if (NumOfSamples <= 0)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to transcode RAW audio data from '%s' because it does not contain any frames"), *SourceName);
+				return false;
+			}
+
+			float* PCMData = static_cast<float*>(FMemory::Malloc(NumOfSamples * sizeof(float)));
+			if (!PCMData)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to allocate memory for transcoding RAW audio data from '%s'"), *SourceName);
+				return false;
+			}
+
+			const int32 NumOfSegments = static_cast<int32>(FMath::DivideAndRoundUp(NumOfFrames, NumOfFramesPerSegment));
+			ParallelFor(NumOfSegments, [&](int32 SegmentIndex)
+			{
+				const int64 SegmentStartSample = SegmentIndex * NumOfFramesPerSegment * Item.NumOfChannelsFrom;
+				const int64 NumOfSegmentSamples = FMath::Min(NumOfFramesPerSegment * Item.NumOfChannelsFrom, NumOfSamples - SegmentStartSample);
+				TranscodeSamples(Item.RAWFormatFrom, DataFrom.GetData() + SegmentStartSample * GetRAWSampleSize(Item.RAWFormatFrom), NumOfSegmentSamples, ERuntimeRAWAudioFormat::Float32, reinterpret_cast<uint8*>(PCMData + SegmentStartSample));
+			});
+
+			DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(PCMData, NumOfSamples);
+			DecodedAudioInfo.PCMInfo.PCMNumOfFrames = NumOfFrames;
+			DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = Item.NumOfChannelsFrom;
+			DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = Item.SampleRateFrom;
+			DecodedAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(NumOfFrames) / Item.SampleRateFrom;
+		}
+		else if (!DecodeAudioDataInSegments(FEncodedAudioStruct(FRuntimeBulkDataBuffer<uint8>(DataFrom), Item.EncodedFormatFrom), DecodedAudioInfo))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to decode audio data from '%s'"), *SourceName);
+			return false;
+		}
+		DataFrom.Empty();
+
+		// Resampling and mixing the channels if needed
+		if (Item.OverrideOptions.IsOverriden())
+		{
+			if (!URuntimeAudioImporterLibrary::ResampleAndMixChannelsInDecodedInfo(DecodedAudioInfo,
+				Item.OverrideOptions.IsSampleRateOverriden() ? Item.OverrideOptions.SampleRate : DecodedAudioInfo.SoundWaveBasicInfo.SampleRate,
+				Item.OverrideOptions.IsNumOfChannelsOverriden() ? Item.OverrideOptions.NumOfChannels : DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels))
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to resample or mix audio data from '%s' to the overriden options"), *SourceName);
+				return false;
+			}
+			DecodedAudioInfo.PCMInfo.PCMNumOfFrames = DecodedAudioInfo.PCMInfo.PCMData.GetView().Num() / DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels;
+		}
+
+		const int32 NumOfChannels = DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels;
+		const int64 NumOfFrames = DecodedAudioInfo.PCMInfo.PCMData.GetView().Num() / NumOfChannels;
+		auto ReadDecodedWindow = [&DecodedAudioInfo, NumOfChannels](int64 StartFrame, int64) -> const uint8*
+		{
+			return reinterpret_cast<const uint8*>(DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData() + StartFrame * NumOfChannels);
+		};
+
+		if (Item.bRAWTo)
+		{
+			return StreamRAWDataToFile(NumOfFrames, NumOfChannels, ERuntimeRAWAudioFormat::Float32, Item.RAWFormatTo, Writer, ReadDecodedWindow);
+		}
+
+		// WAV is uncompressed, so its sample data can be converted in parallel and streamed the same way as RAW data
+		if (Item.EncodedFormatTo == ERuntimeAudioFormat::Wav)
+		{
+			return WriteWAVHeader(Writer, NumOfChannels, DecodedAudioInfo.SoundWaveBasicInfo.SampleRate, NumOfFrames)
+				&& StreamRAWDataToFile(NumOfFrames, NumOfChannels, ERuntimeRAWAudioFormat::Float32, ERuntimeRAWAudioFormat::Int16, Writer, ReadDecodedWindow);
+		}
+
+		// Other formats can only be encoded as a whole
+		FEncodedAudioStruct EncodedAudioInfo;
+		EncodedAudioInfo.AudioFormat = Item.EncodedFormatTo;
+		if (!URuntimeAudioImporterLibrary::EncodeAudioData(MoveTemp(DecodedAudioInfo), EncodedAudioInfo, Item.Quality))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to encode audio data from '%s'"), *SourceName);
+			return false;
+		}
+
+		Writer.Serialize(EncodedAudioInfo.AudioData.GetView().GetData(), EncodedAudioInfo.AudioData.GetView().Num());
+		return !Writer.IsError();
+	}
+
+	bool TranscodeItem(const FRuntimeAudioBatchTranscodeItem& Item)
+	{
+		const FString SourceName = Item.FilePathFrom.IsEmpty() ? FString(TEXT("buffer")) : Item.FilePathFrom;
+
+		if (Item.bRAWFrom && (Item.NumOfChannelsFrom <= 0 || Item.SampleRateFrom <= 0))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to transcode RAW audio data from '%s' because the number of channels (%d) or the sample rate (%d) is invalid"), *SourceName, Item.NumOfChannelsFrom, Item.SampleRateFrom);
+			return false;
+		}
+
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Item.FilePathTo));
+		if (!Writer)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to open the file '%s' for writing the transcoded audio data"), *Item.FilePathTo);
+			return false;
+		}
+
+		if (WriteItem(Item, SourceName, *Writer) && Writer->Close())
+		{
+			return true;
+		}
+
+		// Not leaving a partially written or empty file behind
+		Writer.Reset();
+		if (!IFileManager::Get().Delete(*Item.FilePathTo, false, true, true))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to delete the incomplete transcoded file '%s'"), *Item.FilePathTo);
+		}
+		return false;
+	}
+}
+#endif
 
 void URuntimeAudioTranscoder::TranscodeRAWDataFromBuffer(TArray<uint8> RAWDataFrom, ERuntimeRAWAudioFormat RAWFormatFrom, ERuntimeRAWAudioFormat RAWFormatTo, const FOnRAWDataTranscodeFromBufferResult& Result)
 {
@@ -279,3 +649,56 @@ void URuntimeAudioTranscoder::TranscodeEncodedDataFromFile(const FString& FilePa
 	Result.ExecuteIfBound(false);
 #endif
 }
+
+void URuntimeAudioTranscoder::TranscodeBatch(TArray<FRuntimeAudioBatchTranscodeItem> Items, int32 MaxConcurrentItems, const FOnBatchTranscodeResult& Result)
+{
+	TranscodeBatch(MoveTemp(Items), MaxConcurrentItems, FOnBatchTranscodeResultNative::CreateLambda([Result](const TArray<bool>& Results)
+	{
+		Result.ExecuteIfBound(Results);
+	}));
+}
+
+void URuntimeAudioTranscoder::TranscodeBatch(TArray<FRuntimeAudioBatchTranscodeItem> Items, int32 MaxConcurrentItems, const FOnBatchTranscodeResultNative& Result)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	if (IsInGameThread())
+	{
+		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [Items = MoveTemp(Items), MaxConcurrentItems, Result]() mutable
+		{
+			TranscodeBatch(MoveTemp(Items), MaxConcurrentItems, Result);
+		});
+		return;
+	}
+
+	RuntimeAudioImporter::CheckAndRequestPermissions();
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<bool> Results;
+	Results.SetNumZeroed(Items.Num());
+
+	// Every worker picks the next pending item once it is done with the previous one, while the segments of the items are spread over all task graph workers
+	const int32 NumOfWorkers = FMath::Clamp(MaxConcurrentItems > 0 ? MaxConcurrentItems : FTaskGraphInterface::Get().GetNumWorkerThreads(), 1, FMath::Max(Items.Num(), 1));
+	TAtomic<int32> NextItemIndex(0);
+	ParallelFor(NumOfWorkers, [&Items, &Results, &NextItemIndex](int32)
+	{
+		for (int32 ItemIndex = NextItemIndex++; ItemIndex < Items.Num(); ItemIndex = NextItemIndex++)
+		{
+			Results[ItemIndex] = RuntimeAudioBatchTranscoder::TranscodeItem(Items[ItemIndex]);
+		}
+	});
+
+	const int32 NumOfSucceededItems = Algo::Count(Results, true);
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Batch transcoding of %d items finished in %.3f seconds using %d concurrent items (%d succeeded)"), Items.Num(), FPlatformTime::Seconds() - StartTime, NumOfWorkers, NumOfSucceededItems);
+
+	AsyncTask(ENamedThreads::GameThread, [Result, Results = MoveTemp(Results)]()
+	{
+		Result.ExecuteIfBound(Results);
+	});
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to transcode the batch of %d items because the file operation support is disabled"), Items.Num());
+	TArray<bool> Results;
+	Results.SetNumZeroed(Items.Num());
+	Result.ExecuteIfBound(Results);
+#endif
+}
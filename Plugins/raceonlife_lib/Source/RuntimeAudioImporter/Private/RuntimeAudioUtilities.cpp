@@ -3,6 +3,7 @@
 
 #include "RuntimeAudioUtilities.h"
 
+#include "RuntimeAudioDirectoryIndex.h"
 #include "Codecs/BaseRuntimeCodec.h"
 #include "Codecs/RuntimeCodecFactory.h"
 #include "HAL/PlatformFileManager.h"
@@ -229,3 +230,30 @@ void URuntimeAudioUtilities::ScanDirectoryForAudioFiles(const FString& Directory
 		ExecuteResult(bSucceeded, MoveTemp(DirectoryVisitor_AudioScanner.AudioFilePaths));
 	});
 }
+
+void URuntimeAudioUtilities::ScanDirectoryForIndexedAudioFiles(const FString& Directory, bool bRecursive, const FOnScanDirectoryForIndexedAudioFilesResult& Result)
+{
+	ScanDirectoryForIndexedAudioFiles(Directory, bRecursive, FOnScanDirectoryForIndexedAudioFilesResultNative::CreateLambda([Result](bool bSucceeded, const TArray<FRuntimeAudioIndexEntry>& AudioFiles)
+	{
+		Result.ExecuteIfBound(bSucceeded, AudioFiles);
+	}));
+}
+
+void URuntimeAudioUtilities::ScanDirectoryForIndexedAudioFiles(const FString& Directory, bool bRecursive, const FOnScanDirectoryForIndexedAudioFilesResultNative& Result)
+{
+	AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [Directory, bRecursive, Result]
+	{
+		TArray<FRuntimeAudioIndexEntry> AudioFiles;
+		const bool bSucceeded = FRuntimeAudioDirectoryIndex::Get().Scan(Directory, bRecursive, AudioFiles);
+
+		AsyncTask(ENamedThreads::GameThread, [Result, bSucceeded, AudioFiles = MoveTemp(AudioFiles)]()
+		{
+			Result.ExecuteIfBound(bSucceeded, AudioFiles);
+		});
+	});
+}
+
+TArray<FRuntimeAudioIndexEntry> URuntimeAudioUtilities::QueryIndexedAudioFiles(const FString& Directory, bool bRecursive)
+{
+	return FRuntimeAudioDirectoryIndex::Get().Query(Directory, bRecursive);
+}
@@ -7,6 +7,16 @@
 #include "Async/Async.h"
 #include "UObject/WeakObjectPtrTemplates.h"
 
+namespace
+{
+	/** How much audio the capture ring holds before the oldest samples are dropped, in seconds */
+	constexpr int64 CaptureRingDuration = 2;
+
+	/** The format the capture ring is sized for if the capture device does not report its own */
+	constexpr int32 DefaultCaptureSampleRate = 48000;
+	constexpr int32 DefaultCaptureNumOfChannels = 2;
+}
+
 UCapturableSoundWave::UCapturableSoundWave(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -19,6 +29,16 @@ void UCapturableSoundWave::BeginDestroy()
 	AudioCapture.CloseStream();
 #endif
 
+	if (CaptureConsumptionTickerHandle.IsValid())
+	{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+		FTicker::GetCoreTicker().RemoveTicker(CaptureConsumptionTickerHandle);
+#else
+		FTSTicker::GetCoreTicker().RemoveTicker(CaptureConsumptionTickerHandle);
+#endif
+		CaptureConsumptionTickerHandle.Reset();
+	}
+
 	Super::BeginDestroy();
 }
 
@@ -104,24 +124,16 @@ bool UCapturableSoundWave::StartCapture_Implementation(int32 DeviceId)
 			return;
 		}
 
+		// Only copying into the preallocated capture ring here, the consumer converts the data and appends it to the sound wave
 		if (WeakThis->AudioCapture.IsCapturing())
 		{
-			const int64 PCMDataSize = NumOfChannels * NumFrames;
-			int64 PCMDataSizeInBytes = PCMDataSize * sizeof(float);
-
-			if (PCMDataSizeInBytes > TNumericLimits<int32>::Max())
-			{
-				UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to append audio data as the size of the data exceeds the maximum size of int32 (PCMDataSizeInBytes: %lld, Max: %d)"), PCMDataSizeInBytes, TNumericLimits<int32>::Max());
-				PCMDataSizeInBytes = TNumericLimits<int32>::Max();
-			}
-
-			WeakThis->AppendAudioDataFromRAW(TArray<uint8>(reinterpret_cast<const uint8*>(PCMData), static_cast<int32>(PCMDataSizeInBytes)), ERuntimeRAWAudioFormat::Float32,
+			WeakThis->CaptureRing.Write(static_cast<const float*>(PCMData), NumFrames, NumOfChannels,
 #if UE_VERSION_NEWER_THAN(4, 25, 0)
 				InSampleRate
 #else
 				WeakThis->AudioCapture.GetSampleRate()
 #endif
-			  , NumOfChannels);
+			);
 		}
 	};
 
@@ -131,6 +143,21 @@ bool UCapturableSoundWave::StartCapture_Implementation(int32 DeviceId)
 		return false;
 	}
 
+	// The capture ring is allocated before the stream is opened, so that the capture callback never allocates
+	// It is sized for the format of the device, since a device capturing more channels or at a higher rate fills it faster
+	Audio::FCaptureDeviceInfo DeviceInfo;
+	const bool bHasDeviceInfo = AudioCapture.GetCaptureDeviceInfo(DeviceInfo, DeviceId);
+	const int32 CaptureSampleRate = bHasDeviceInfo && DeviceInfo.PreferredSampleRate > 0 ? DeviceInfo.PreferredSampleRate : DefaultCaptureSampleRate;
+	const int32 CaptureNumOfChannels = bHasDeviceInfo && DeviceInfo.InputChannels > 0 ? DeviceInfo.InputChannels : DefaultCaptureNumOfChannels;
+	const int64 CaptureRingNumOfSamples = CaptureRingDuration * CaptureSampleRate * CaptureNumOfChannels;
+	{
+		FRAIScopeLock Lock(&CaptureConsumerGuard);
+		CaptureRing.Initialize(CaptureRingNumOfSamples);
+		CapturedPCMData.SetNumUninitialized(CaptureRingNumOfSamples);
+		CaptureConverter.Reset();
+		NumOfReportedDroppedSamples = 0;
+	}
+
 	if (!AudioCapture.
 #if UE_VERSION_NEWER_THAN(5, 2, 9)
 		OpenAudioCaptureStream
@@ -149,6 +176,8 @@ bool UCapturableSoundWave::StartCapture_Implementation(int32 DeviceId)
 		return false;
 	}
 
+	StartConsumingCapturedAudioData();
+
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully started capturing for sound wave %s"), *GetName());
 	return true;
 #else
@@ -164,6 +193,7 @@ void UCapturableSoundWave::StopCapture_Implementation()
 	{
 		AudioCapture.CloseStream();
 	}
+	StopConsumingCapturedAudioData();
 #else
 	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to stop capturing as its support is disabled (please enable in RuntimeAudioImporter.Build.cs)"));
 #endif
@@ -234,3 +264,118 @@ bool UCapturableSoundWave::IsCapturing_Implementation() const
 	return false;
 #endif
 }
+
+int64 UCapturableSoundWave::GetNumOfDroppedCaptureSamples() const
+{
+	return CaptureRing.GetNumOfOverrunSamples();
+}
+
+void UCapturableSoundWave::ConsumeCapturedAudioData()
+{
+	bCaptureConsumptionScheduled = false;
+
+	FDecodedAudioStruct DecodedAudioInfo;
+	{
+		FRAIScopeLock Lock(&CaptureConsumerGuard);
+
+		const int32 SourceNumOfChannels = CaptureRing.GetNumOfChannels();
+		const int32 SourceSampleRate = CaptureRing.GetSampleRate();
+		const int64 NumOfSamples = CaptureRing.Read(CapturedPCMData.GetData(), CapturedPCMData.Num());
+
+		const int64 NumOfDroppedSamples = CaptureRing.GetNumOfOverrunSamples();
+		if (NumOfDroppedSamples > NumOfReportedDroppedSamples)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Dropped %lld captured samples for sound wave %s as they were not consumed fast enough"), NumOfDroppedSamples - NumOfReportedDroppedSamples, *GetName());
+			NumOfReportedDroppedSamples = NumOfDroppedSamples;
+		}
+
+		if (NumOfSamples <= 0 || SourceNumOfChannels <= 0 || SourceSampleRate <= 0)
+		{
+			return;
+		}
+
+		// Converting straight to the format of the sound wave, so that appending does not need to resample and mix the channels again
+		int32 DestinationSampleRate;
+		int32 DestinationNumOfChannels;
+		{
+			FRAIScopeLock DataLock(&*DataGuard);
+			if (PCMBufferInfo->PCMData.GetView().Num() > 0)
+			{
+				DestinationSampleRate = SampleRate;
+				DestinationNumOfChannels = NumChannels;
+			}
+			else
+			{
+				DestinationSampleRate = InitialDesiredSampleRate.IsSet() ? InitialDesiredSampleRate.GetValue() : SourceSampleRate;
+				DestinationNumOfChannels = InitialDesiredNumOfChannels.IsSet() ? InitialDesiredNumOfChannels.GetValue() : SourceNumOfChannels;
+			}
+		}
+
+		CaptureConverter.Convert(MakeArrayView(CapturedPCMData.GetData(), static_cast<int32>(NumOfSamples)), SourceSampleRate, SourceNumOfChannels, DestinationSampleRate, DestinationNumOfChannels, ConvertedCapturedPCMData);
+		if (ConvertedCapturedPCMData.Num() <= 0)
+		{
+			return;
+		}
+
+		DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(ConvertedCapturedPCMData);
+		DecodedAudioInfo.PCMInfo.PCMNumOfFrames = ConvertedCapturedPCMData.Num() / DestinationNumOfChannels;
+		DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = DestinationNumOfChannels;
+		DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = DestinationSampleRate;
+		DecodedAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(DecodedAudioInfo.PCMInfo.PCMNumOfFrames) / DestinationSampleRate;
+	}
+
+	PopulateAudioDataFromDecodedInfo(MoveTemp(DecodedAudioInfo));
+}
+
+void UCapturableSoundWave::StartConsumingCapturedAudioData()
+{
+	if (CaptureConsumptionTickerHandle.IsValid())
+	{
+		return;
+	}
+
+	auto ScheduleConsumption = [this](float DeltaTime)
+	{
+		if (CaptureRing.GetNumOfAvailableSamples() > 0 && !bCaptureConsumptionScheduled.exchange(true))
+		{
+			AudioTaskPipe->Launch(AudioTaskPipe->GetDebugName(), [WeakThis = MakeWeakObjectPtr(this)]()
+			{
+				if (WeakThis.IsValid())
+				{
+					WeakThis->ConsumeCapturedAudioData();
+				}
+			}, UE::Tasks::ETaskPriority::BackgroundHigh);
+		}
+		return true;
+	};
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	CaptureConsumptionTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, MoveTemp(ScheduleConsumption)));
+#else
+	CaptureConsumptionTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, MoveTemp(ScheduleConsumption)));
+#endif
+}
+
+void UCapturableSoundWave::StopConsumingCapturedAudioData()
+{
+	if (!CaptureConsumptionTickerHandle.IsValid())
+	{
+		return;
+	}
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FTicker::GetCoreTicker().RemoveTicker(CaptureConsumptionTickerHandle);
+#else
+	FTSTicker::GetCoreTicker().RemoveTicker(CaptureConsumptionTickerHandle);
+#endif
+	CaptureConsumptionTickerHandle.Reset();
+
+	// Appending what has been captured since the last tick
+	AudioTaskPipe->Launch(AudioTaskPipe->GetDebugName(), [WeakThis = MakeWeakObjectPtr(this)]()
+	{
+		if (WeakThis.IsValid())
+		{
+			WeakThis->ConsumeCapturedAudioData();
+		}
+	}, UE::Tasks::ETaskPriority::BackgroundHigh);
+}
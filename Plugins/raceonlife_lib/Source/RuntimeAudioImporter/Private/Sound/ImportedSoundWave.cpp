@@ -17,6 +17,37 @@
 #include "Codecs/VORBIS_RuntimeCodec.h"
 #endif
 #include "Codecs/RAW_RuntimeCodec.h"
+#include "Codecs/PCMBlock_RuntimeCodec.h"
+#include "RuntimeAudioMappedFile.h"
+
+namespace
+{
+	/**
+	 * Copy the PCM data played from a memory-mapped file into 32-bit float PCM data
+	 *
+	 * @param MappedPCMData The mapped PCM data to copy
+	 * @param OutPCMData The resulting PCM data
+	 * @return True if the data was copied successfully
+	 */
+	bool CopyMappedPCMData(const FMappedPCMData& MappedPCMData, FRuntimeBulkDataBuffer<float>& OutPCMData)
+	{
+		const int64 NumOfSamples = MappedPCMData.NumOfFrames * MappedPCMData.NumOfChannels;
+		float* PCMDataPtr = static_cast<float*>(FMemory::Malloc(NumOfSamples * sizeof(float)));
+		if (!PCMDataPtr)
+		{
+			return false;
+		}
+
+		if (MappedPCMData.CopyFrames(0, MappedPCMData.NumOfFrames, PCMDataPtr) != MappedPCMData.NumOfFrames)
+		{
+			FMemory::Free(PCMDataPtr);
+			return false;
+		}
+
+		OutPCMData = FRuntimeBulkDataBuffer<float>(PCMDataPtr, NumOfSamples);
+		return true;
+	}
+}
 
 UImportedSoundWave::UImportedSoundWave(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -24,6 +55,7 @@ UImportedSoundWave::UImportedSoundWave(const FObjectInitializer& ObjectInitializ
   , PlaybackFinishedBroadcast(false)
   , PlayedNumOfFrames(0)
   , PCMBufferInfo(MakeShared<FPCMStruct>())
+  , PCMStorageMode(ERuntimePCMStorageMode::Uncompressed)
   , bStopSoundOnPlaybackFinish(true)
   , ImportedAudioFormat(ERuntimeAudioFormat::Invalid)
 {
@@ -93,6 +125,7 @@ void UImportedSoundWave::DuplicateSoundWave(bool bUseSharedAudioBuffer, const FO
 	DuplicatedSoundWave->SetInternalFlags(EInternalObjectFlags::Async);
 	FRAIScopeLock Lock(&*DataGuard);
 	DuplicatedSoundWave->PCMBufferInfo = bUseSharedAudioBuffer ? PCMBufferInfo : MakeShared<FPCMStruct>(*PCMBufferInfo);
+	DuplicatedSoundWave->PCMStorageMode = PCMStorageMode;
 	DuplicatedSoundWave->bStopSoundOnPlaybackFinish = bStopSoundOnPlaybackFinish;
 	DuplicatedSoundWave->ImportedAudioFormat = ImportedAudioFormat;
 	DuplicatedSoundWave->Duration = Duration;
@@ -139,7 +172,8 @@ bool UImportedSoundWave::InitAudioResource(FName Format)
 	{
 		FRAIScopeLock Lock(&*DataGuard);
 		{
-			DecodedAudioInfo.PCMInfo = GetPCMBuffer();
+			FPCMStruct DecompressedPCMBuffer;
+			DecodedAudioInfo.PCMInfo = GetDecompressedPCMBuffer(DecompressedPCMBuffer);
 			FSoundWaveBasicStruct SoundWaveBasicInfo;
 			{
 				SoundWaveBasicInfo.NumOfChannels = NumChannels;
@@ -179,7 +213,7 @@ bool UImportedSoundWave::InitAudioResource(FName Format)
 bool UImportedSoundWave::IsSeekable() const
 {
 	FRAIScopeLock Lock(&*DataGuard);
-	return PCMBufferInfo.IsValid() && PCMBufferInfo.Get()->PCMData.GetView().Num() > 0 && PCMBufferInfo.Get()->PCMNumOfFrames > 0;
+	return PCMBufferInfo.IsValid() && (PCMBufferInfo.Get()->PCMData.GetView().Num() > 0 || PCMBufferInfo.Get()->IsCompressed() || PCMBufferInfo.Get()->IsMapped()) && PCMBufferInfo.Get()->PCMNumOfFrames > 0;
 }
 #endif
 
@@ -206,19 +240,49 @@ int32 UImportedSoundWave::OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 NumS
 			NumSamples = (PCMBufferInfo->PCMNumOfFrames - GetNumOfPlayedFrames_Internal()) * NumChannels;
 		}
 
-		// Retrieving a part of PCM data
-		RetrievedPCMDataPtr = PCMBufferInfo->PCMData.GetView().GetData() + (GetNumOfPlayedFrames_Internal() * NumChannels);
 		const int32 RetrievedPCMDataSize = NumSamples * sizeof(float);
 
-		// Ensure we got a valid PCM data
-		if (RetrievedPCMDataSize <= 0 || !RetrievedPCMDataPtr)
+		// Decoding the needed blocks of the compressed PCM data directly into OutAudio
+		if (PCMBufferInfo->IsCompressed())
 		{
-			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to get PCM audio from imported sound wave since the retrieved PCM data is invalid"));
-			return 0;
+			OutAudio.SetNumUninitialized(RetrievedPCMDataSize);
+			RetrievedPCMDataPtr = reinterpret_cast<float*>(OutAudio.GetData());
+
+			const int64 NumOfRetrievedFrames = PCMBlockCache.CopyFrames(PCMBufferInfo->CompressedPCMData, GetNumOfPlayedFrames_Internal(), NumSamples / NumChannels, RetrievedPCMDataPtr);
+			if (RetrievedPCMDataSize <= 0 || NumOfRetrievedFrames != NumSamples / NumChannels)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to get PCM audio from imported sound wave since the compressed PCM data could not be decoded"));
+				return 0;
+			}
 		}
+		// Converting the needed frames of the memory-mapped PCM data directly into OutAudio
+		else if (PCMBufferInfo->IsMapped())
+		{
+			OutAudio.SetNumUninitialized(RetrievedPCMDataSize);
+			RetrievedPCMDataPtr = reinterpret_cast<float*>(OutAudio.GetData());
+
+			const int64 NumOfRetrievedFrames = PCMBufferInfo->MappedPCMData->CopyFrames(GetNumOfPlayedFrames_Internal(), NumSamples / NumChannels, RetrievedPCMDataPtr);
+			if (RetrievedPCMDataSize <= 0 || NumOfRetrievedFrames != NumSamples / NumChannels)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to get PCM audio from imported sound wave since the memory-mapped PCM data could not be read"));
+				return 0;
+			}
+		}
+		else
+		{
+			// Retrieving a part of PCM data
+			RetrievedPCMDataPtr = PCMBufferInfo->PCMData.GetView().GetData() + (GetNumOfPlayedFrames_Internal() * NumChannels);
+
+			// Ensure we got a valid PCM data
+			if (RetrievedPCMDataSize <= 0 || !RetrievedPCMDataPtr)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to get PCM audio from imported sound wave since the retrieved PCM data is invalid"));
+				return 0;
+			}
 
-		// Filling in OutAudio array with the retrieved PCM data
-		OutAudio = TArray<uint8>(reinterpret_cast<uint8*>(RetrievedPCMDataPtr), RetrievedPCMDataSize);
+			// Filling in OutAudio array with the retrieved PCM data
+			OutAudio = TArray<uint8>(reinterpret_cast<uint8*>(RetrievedPCMDataPtr), RetrievedPCMDataSize);
+		}
 
 		// Increasing the number of frames played
 		SetNumOfPlayedFrames_Internal(GetNumOfPlayedFrames_Internal() + (NumSamples / NumChannels));
@@ -339,6 +403,16 @@ void UImportedSoundWave::PopulateAudioDataFromDecodedInfo(FDecodedAudioStruct&&
 	// If the sound wave has not yet been filled in with audio data and the initial desired sample rate and the number of channels are set, resample and mix the channels
 	if (InitialDesiredSampleRate.IsSet() || InitialDesiredNumOfChannels.IsSet())
 	{
+		if (DecodedAudioInfo.PCMInfo.IsCompressed())
+		{
+			FPCMBlock_RuntimeCodec::Decompress(*DecodedAudioInfo.PCMInfo.CompressedPCMData, DecodedAudioInfo.PCMInfo.PCMData);
+			DecodedAudioInfo.PCMInfo.CompressedPCMData.Reset();
+		}
+		else if (DecodedAudioInfo.PCMInfo.IsMapped())
+		{
+			CopyMappedPCMData(*DecodedAudioInfo.PCMInfo.MappedPCMData, DecodedAudioInfo.PCMInfo.PCMData);
+			DecodedAudioInfo.PCMInfo.MappedPCMData.Reset();
+		}
 		URuntimeAudioImporterLibrary::ResampleAndMixChannelsInDecodedInfo(DecodedAudioInfo,
 			InitialDesiredSampleRate.IsSet() ? InitialDesiredSampleRate.GetValue() : DecodedAudioInfo.SoundWaveBasicInfo.SampleRate,
 			InitialDesiredNumOfChannels.IsSet() ? InitialDesiredNumOfChannels.GetValue() : DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels);
@@ -355,7 +429,10 @@ void UImportedSoundWave::PopulateAudioDataFromDecodedInfo(FDecodedAudioStruct&&
 	ImportedAudioFormat = DecodedAudioInfo.SoundWaveBasicInfo.AudioFormat;
 
 	PCMBufferInfo->PCMData = MoveTemp(DecodedAudioInfo.PCMInfo.PCMData);
+	PCMBufferInfo->CompressedPCMData = MoveTemp(DecodedAudioInfo.PCMInfo.CompressedPCMData);
+	PCMBufferInfo->MappedPCMData = MoveTemp(DecodedAudioInfo.PCMInfo.MappedPCMData);
 	PCMBufferInfo->PCMNumOfFrames = DecodedAudioInfo.PCMInfo.PCMNumOfFrames;
+	PCMBlockCache.Reset();
 
 	{
 		const bool IsBound = [this]()
@@ -365,7 +442,9 @@ void UImportedSoundWave::PopulateAudioDataFromDecodedInfo(FDecodedAudioStruct&&
 		}();
 		if (IsBound)
 		{
-			TArray<float> PCMData(PCMBufferInfo->PCMData.GetView().GetData(), PCMBufferInfo->PCMData.GetView().Num());
+			FPCMStruct DecompressedPCMBuffer;
+			const FPCMStruct& PopulatedPCMBuffer = GetDecompressedPCMBuffer(DecompressedPCMBuffer);
+			TArray<float> PCMData(PopulatedPCMBuffer.PCMData.GetView().GetData(), PopulatedPCMBuffer.PCMData.GetView().Num());
 			AsyncTask(ENamedThreads::GameThread, [WeakThis = MakeWeakObjectPtr(this), PCMData = MoveTemp(PCMData)]() mutable
 			{
 				if (WeakThis.IsValid())
@@ -412,6 +491,20 @@ void UImportedSoundWave::PopulateAudioDataFromDecodedInfo(FDecodedAudioStruct&&
 		}
 	}
 
+	// Storing the populated data according to the storage mode, the data may have been compressed by the importer already
+	// Memory-mapped data is kept mapped when stored uncompressed, as it is converted on the fly during playback
+	if (PCMStorageMode == ERuntimePCMStorageMode::Uncompressed)
+	{
+		if (PCMBufferInfo->IsCompressed())
+		{
+			DecompressPCMData_Internal();
+		}
+	}
+	else
+	{
+		CompressPCMData_Internal();
+	}
+
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The audio data has been populated successfully. Information about audio data:\n%s"), *DecodedAudioInfoString);
 }
 
@@ -466,7 +559,10 @@ void UImportedSoundWave::ReleaseMemory()
 	FRAIScopeLock Lock(&*DataGuard);
 	UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Releasing memory for the sound wave '%s'"), *GetName());
 	PCMBufferInfo->PCMData.Empty();
+	PCMBufferInfo->CompressedPCMData.Reset();
+	PCMBufferInfo->MappedPCMData.Reset();
 	PCMBufferInfo->PCMNumOfFrames = 0;
+	PCMBlockCache.Reset();
 	Duration = 0;
 }
 
@@ -520,12 +616,22 @@ bool UImportedSoundWave::RewindPlaybackTime_Internal(float PlaybackTime)
 		return false;
 	}
 
-	return SetNumOfPlayedFrames_Internal(PlaybackTime * SampleRate);
+	if (!SetNumOfPlayedFrames_Internal(PlaybackTime * SampleRate))
+	{
+		return false;
+	}
+
+	// Paging in the mapped sample data at the new position before the audio render thread gets to it
+	if (PCMBufferInfo->IsMapped())
+	{
+		PCMBufferInfo->MappedPCMData->ReadAheadAsync(GetNumOfPlayedFrames_Internal());
+	}
+	return true;
 }
 
 bool UImportedSoundWave::SetInitialDesiredSampleRate(int32 DesiredSampleRate)
 {
-	if (PCMBufferInfo->PCMData.GetView().Num() > 0)
+	if (PCMBufferInfo->PCMData.GetView().Num() > 0 || PCMBufferInfo->IsCompressed() || PCMBufferInfo->IsMapped())
 	{
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to set the initial desired sample rate for the imported sound wave '%s' to '%d' because the PCM data has already been populated"), *GetName(), DesiredSampleRate);
 		return false;
@@ -545,7 +651,7 @@ bool UImportedSoundWave::SetInitialDesiredSampleRate(int32 DesiredSampleRate)
 
 bool UImportedSoundWave::SetInitialDesiredNumOfChannels(int32 DesiredNumOfChannels)
 {
-	if (PCMBufferInfo->PCMData.GetView().Num() > 0)
+	if (PCMBufferInfo->PCMData.GetView().Num() > 0 || PCMBufferInfo->IsCompressed() || PCMBufferInfo->IsMapped())
 	{
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to set the initial desired number of channels for the imported sound wave '%s' to '%d' because the PCM data has already been populated"), *GetName(), DesiredNumOfChannels);
 		return false;
@@ -579,6 +685,11 @@ bool UImportedSoundWave::ResampleSoundWave(int32 NewSampleRate)
 
 	FRAIScopeLock Lock(&*DataGuard);
 
+	if (!DecompressPCMData_Internal())
+	{
+		return false;
+	}
+
 	Audio::FAlignedFloatBuffer NewPCMData;
 	Audio::FAlignedFloatBuffer SourcePCMData = Audio::FAlignedFloatBuffer(PCMBufferInfo->PCMData.GetView().GetData(), PCMBufferInfo->PCMData.GetView().Num());
 
@@ -594,7 +705,7 @@ bool UImportedSoundWave::ResampleSoundWave(int32 NewSampleRate)
 		PCMBufferInfo->PCMNumOfFrames = NewPCMData.Num() / GetNumOfChannels();
 		PCMBufferInfo->PCMData = FRuntimeBulkDataBuffer<float>(NewPCMData);
 	}
-	return true;
+	return CompressPCMData_Internal();
 }
 
 bool UImportedSoundWave::MixSoundWaveChannels(int32 NewNumOfChannels)
@@ -613,6 +724,11 @@ bool UImportedSoundWave::MixSoundWaveChannels(int32 NewNumOfChannels)
 
 	FRAIScopeLock Lock(&*DataGuard);
 
+	if (!DecompressPCMData_Internal())
+	{
+		return false;
+	}
+
 	Audio::FAlignedFloatBuffer NewPCMData;
 	Audio::FAlignedFloatBuffer SourcePCMData = Audio::FAlignedFloatBuffer(PCMBufferInfo->PCMData.GetView().GetData(), PCMBufferInfo->PCMData.GetView().Num());
 
@@ -628,7 +744,7 @@ bool UImportedSoundWave::MixSoundWaveChannels(int32 NewNumOfChannels)
 		PCMBufferInfo->PCMNumOfFrames = NewPCMData.Num() / GetNumOfChannels();
 		PCMBufferInfo->PCMData = FRuntimeBulkDataBuffer<float>(NewPCMData);
 	}
-	return true;
+	return CompressPCMData_Internal();
 }
 
 void UImportedSoundWave::StopPlayback(const UObject* WorldContextObject, const FOnStopPlaybackResult& Result)
@@ -727,7 +843,7 @@ void UImportedSoundWave::ReverseAudioBuffer(const FOnReverseAudioDataNative& Res
 
 	FRAIScopeLock Lock(&*DataGuard);
 
-	if (PCMBufferInfo->PCMData.GetView().Num() <= 0)
+	if (!DecompressPCMData_Internal() || PCMBufferInfo->PCMData.GetView().Num() <= 0)
 	{
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to reverse the audio buffer for the imported sound wave '%s' because the PCM data is empty"), *GetName());
 		ExecuteResult(false);
@@ -739,7 +855,7 @@ void UImportedSoundWave::ReverseAudioBuffer(const FOnReverseAudioDataNative& Res
 
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully reversed the audio buffer for the imported sound wave '%s'"), *GetName());
 	PCMBufferInfo->PCMData = FRuntimeBulkDataBuffer<float>(PCMData);
-	ExecuteResult(true);
+	ExecuteResult(CompressPCMData_Internal());
 }
 
 bool UImportedSoundWave::SetNumOfPlayedFrames(uint32 NumOfFrames)
@@ -929,7 +1045,7 @@ bool UImportedSoundWave::GetAudioHeaderInfo(FRuntimeAudioHeaderInfo& HeaderInfo)
 		HeaderInfo.AudioFormat = GetAudioFormat();
 		HeaderInfo.SampleRate = GetSampleRate();
 		HeaderInfo.NumOfChannels = GetNumOfChannels();
-		HeaderInfo.PCMDataSize = PCMBufferInfo->PCMData.GetView().Num();
+		HeaderInfo.PCMDataSize = PCMBufferInfo->IsCompressed() || PCMBufferInfo->IsMapped() ? static_cast<int64>(PCMBufferInfo->PCMNumOfFrames) * GetNumOfChannels() : PCMBufferInfo->PCMData.GetView().Num();
 	}
 	
 	return true;
@@ -943,7 +1059,9 @@ void UImportedSoundWave::ResetPlaybackFinish()
 TArray<float> UImportedSoundWave::GetPCMBufferCopy()
 {
 	FRAIScopeLock Lock(&*DataGuard);
-	return TArray<float>(PCMBufferInfo.Get()->PCMData.GetView().GetData(), PCMBufferInfo.Get()->PCMData.GetView().Num());
+	FPCMStruct DecompressedPCMBuffer;
+	const FPCMStruct& PCMBuffer = GetDecompressedPCMBuffer(DecompressedPCMBuffer);
+	return TArray<float>(PCMBuffer.PCMData.GetView().GetData(), PCMBuffer.PCMData.GetView().Num());
 }
 
 const FPCMStruct& UImportedSoundWave::GetPCMBuffer() const
@@ -951,6 +1069,116 @@ const FPCMStruct& UImportedSoundWave::GetPCMBuffer() const
 	return *PCMBufferInfo.Get();
 }
 
+const FPCMStruct& UImportedSoundWave::GetDecompressedPCMBuffer(FPCMStruct& DecompressedPCMBuffer) const
+{
+	if (PCMBufferInfo->IsMapped())
+	{
+		if (CopyMappedPCMData(*PCMBufferInfo->MappedPCMData, DecompressedPCMBuffer.PCMData))
+		{
+			DecompressedPCMBuffer.PCMNumOfFrames = PCMBufferInfo->PCMNumOfFrames;
+		}
+		else
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to copy the memory-mapped PCM data of the imported sound wave '%s'"), *GetName());
+		}
+		return DecompressedPCMBuffer;
+	}
+
+	if (!PCMBufferInfo->IsCompressed())
+	{
+		return *PCMBufferInfo.Get();
+	}
+
+	if (FPCMBlock_RuntimeCodec::Decompress(*PCMBufferInfo->CompressedPCMData, DecompressedPCMBuffer.PCMData))
+	{
+		DecompressedPCMBuffer.PCMNumOfFrames = PCMBufferInfo->PCMNumOfFrames;
+	}
+	else
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to decompress the PCM data of the imported sound wave '%s'"), *GetName());
+	}
+	return DecompressedPCMBuffer;
+}
+
+bool UImportedSoundWave::SetPCMStorageMode(ERuntimePCMStorageMode StorageMode)
+{
+	FRAIScopeLock Lock(&*DataGuard);
+
+	if (StorageMode == PCMStorageMode)
+	{
+		return true;
+	}
+
+	PCMStorageMode = StorageMode;
+
+	// Switching between the compressed modes requires compressing the data again
+	if (!DecompressPCMData_Internal())
+	{
+		return false;
+	}
+	return CompressPCMData_Internal();
+}
+
+ERuntimePCMStorageMode UImportedSoundWave::GetPCMStorageMode() const
+{
+	return PCMStorageMode;
+}
+
+bool UImportedSoundWave::CompressPCMData_Internal()
+{
+	if (PCMStorageMode != ERuntimePCMStorageMode::Uncompressed && PCMBufferInfo->IsMapped() && !DecompressPCMData_Internal())
+	{
+		return false;
+	}
+
+	if (PCMStorageMode == ERuntimePCMStorageMode::Uncompressed || PCMBufferInfo->IsCompressed() || PCMBufferInfo->PCMData.GetView().Num() <= 0)
+	{
+		return true;
+	}
+
+	FCompressedPCMDataPtr CompressedPCMData = FPCMBlock_RuntimeCodec::Compress(PCMBufferInfo->PCMData.GetView().GetData(), PCMBufferInfo->PCMData.GetView().Num(), GetNumOfChannels(), PCMStorageMode == ERuntimePCMStorageMode::Compressed16Bit);
+	if (!CompressedPCMData.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to compress the PCM data of the imported sound wave '%s', keeping it uncompressed"), *GetName());
+		return false;
+	}
+
+	PCMBufferInfo->CompressedPCMData = MoveTemp(CompressedPCMData);
+	PCMBufferInfo->PCMData.Empty();
+	PCMBlockCache.Reset();
+	return true;
+}
+
+bool UImportedSoundWave::DecompressPCMData_Internal()
+{
+	if (PCMBufferInfo->IsMapped())
+	{
+		if (!CopyMappedPCMData(*PCMBufferInfo->MappedPCMData, PCMBufferInfo->PCMData))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to copy the memory-mapped PCM data of the imported sound wave '%s'"), *GetName());
+			return false;
+		}
+
+		PCMBufferInfo->MappedPCMData.Reset();
+		return true;
+	}
+
+	if (!PCMBufferInfo->IsCompressed())
+	{
+		return true;
+	}
+
+	if (!FPCMBlock_RuntimeCodec::Decompress(*PCMBufferInfo->CompressedPCMData, PCMBufferInfo->PCMData))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to decompress the PCM data of the imported sound wave '%s'"), *GetName());
+		return false;
+	}
+
+	PCMBufferInfo->CompressedPCMData.Reset();
+	PCMBlockCache.Reset();
+	return true;
+}
+
 ERuntimeAudioFormat UImportedSoundWave::GetAudioFormat() const
 {
 	return ImportedAudioFormat;
@@ -65,7 +65,7 @@ void UStreamingSoundWave::PopulateAudioDataFromDecodedInfo(FDecodedAudioStruct&&
 	// Process VAD if necessary
 	if (VADInstance)
 	{
-		bool bDetected = VADInstance->ProcessVAD(TArray<float>(reinterpret_cast<const float*>(DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData()), static_cast<int32>(DecodedAudioInfo.PCMInfo.PCMData.GetView().Num())), DecodedAudioInfo.SoundWaveBasicInfo.SampleRate, DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels);
+		bool bDetected = VADInstance->ProcessVAD(TArrayView<const float>(DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData(), static_cast<int32>(DecodedAudioInfo.PCMInfo.PCMData.GetView().Num())), DecodedAudioInfo.SoundWaveBasicInfo.SampleRate, DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels);
 		if (!bDetected)
 		{
 			UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("VAD detected silence, skipping audio data append"));
@@ -183,6 +183,17 @@ UStreamingSoundWave* UStreamingSoundWave::CreateStreamingSoundWave()
 	return NewObject<UStreamingSoundWave>();
 }
 
+bool UStreamingSoundWave::SetPCMStorageMode(ERuntimePCMStorageMode StorageMode)
+{
+	// The audio data is appended continuously, so it is always stored uncompressed
+	if (StorageMode != ERuntimePCMStorageMode::Uncompressed)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to set the PCM storage mode for the streaming sound wave '%s' as compressed storage is not supported for streaming sound waves"), *GetName());
+		return false;
+	}
+	return Super::SetPCMStorageMode(StorageMode);
+}
+
 void UStreamingSoundWave::PreAllocateAudioData(int64 NumOfBytesToPreAllocate, const FOnPreAllocateAudioDataResult& Result)
 {
 	PreAllocateAudioData(NumOfBytesToPreAllocate, FOnPreAllocateAudioDataResultNative::CreateWeakLambda(this, [Result](bool bSucceeded)
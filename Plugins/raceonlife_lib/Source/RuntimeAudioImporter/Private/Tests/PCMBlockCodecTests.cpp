@@ -0,0 +1,165 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestUtils.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Codecs/PCMBlock_RuntimeCodec.h"
+#include "HAL/PlatformTime.h"
+
+namespace PCMBlockCodecTests
+{
+	/** Rounds the samples to the given integer scale, as decoding WAV or FLAC data of that bit depth would produce */
+	TArray<float> Quantize(TArray<float> PCMData, float Scale)
+	{
+		for (float& Sample : PCMData)
+		{
+			Sample = FMath::Clamp(FMath::RoundToFloat(Sample * Scale), -Scale, Scale - 1.f) / Scale;
+		}
+		return PCMData;
+	}
+
+	struct FCodecCase
+	{
+		const TCHAR* Name;
+		int32 NumOfChannels;
+		TArray<float> PCMData;
+		bool bQuantizeTo16Bit;
+	};
+
+	/** 16-bit stereo and 24-bit mono (integer blocks), float stereo (verbatim blocks) and float stereo quantized on compression */
+	TArray<FCodecCase> MakeCodecCases(int32 NumOfFrames)
+	{
+		TArray<FCodecCase> Cases;
+		Cases.Add({TEXT("16-bit stereo"), 2, Quantize(RuntimeAudioImporterTests::MakeTestSignal(44100, 2, NumOfFrames, 1), 32768.f), false});
+		Cases.Add({TEXT("24-bit mono"), 1, Quantize(RuntimeAudioImporterTests::MakeTestSignal(48000, 1, NumOfFrames, 2), 8388608.f), false});
+		Cases.Add({TEXT("float stereo"), 2, RuntimeAudioImporterTests::MakeTestSignal(44100, 2, NumOfFrames, 3), false});
+		Cases.Add({TEXT("float stereo quantized to 16-bit"), 2, RuntimeAudioImporterTests::MakeTestSignal(44100, 2, NumOfFrames, 4), true});
+		return Cases;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCMBlockCodecSampleExactTest, "RuntimeAudioImporter.PCMBlockCodec.SampleExact", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPCMBlockCodecSampleExactTest::RunTest(const FString& Parameters)
+{
+	// Not a multiple of the block size, so the short last block is covered too
+	const int32 NumOfFrames = FCompressedPCMData::NumOfFramesPerBlock * 5 + 1234;
+
+	for (const PCMBlockCodecTests::FCodecCase& Case : PCMBlockCodecTests::MakeCodecCases(NumOfFrames))
+	{
+		const FCompressedPCMDataPtr CompressedData = FPCMBlock_RuntimeCodec::Compress(Case.PCMData.GetData(), Case.PCMData.Num(), Case.NumOfChannels, Case.bQuantizeTo16Bit);
+		if (!TestTrue(FString::Printf(TEXT("%s compressed"), Case.Name), CompressedData.IsValid()))
+		{
+			continue;
+		}
+
+		// Quantization is the only lossy step, compare against the quantized source in that case
+		const TArray<float> ExpectedPCMData = Case.bQuantizeTo16Bit ? PCMBlockCodecTests::Quantize(Case.PCMData, 32768.f) : Case.PCMData;
+
+		FRuntimeBulkDataBuffer<float> DecompressedPCMData;
+		if (!TestTrue(FString::Printf(TEXT("%s decompressed"), Case.Name), FPCMBlock_RuntimeCodec::Decompress(*CompressedData, DecompressedPCMData)))
+		{
+			continue;
+		}
+		TestEqual(FString::Printf(TEXT("%s number of samples"), Case.Name), static_cast<int32>(DecompressedPCMData.GetView().Num()), ExpectedPCMData.Num());
+		TestTrue(FString::Printf(TEXT("%s decompressed samples are bit-identical"), Case.Name),
+			DecompressedPCMData.GetView().Num() == ExpectedPCMData.Num() && FMemory::Memcmp(DecompressedPCMData.GetView().GetData(), ExpectedPCMData.GetData(), ExpectedPCMData.Num() * sizeof(float)) == 0);
+
+		// Playback-sized reads at offsets that straddle block boundaries, through a cache smaller than the number of blocks
+		FPCMBlockCache BlockCache(2);
+		TArray<float> CallbackPCMData;
+		const int32 NumOfFramesPerCallback = 1000;
+		CallbackPCMData.SetNumUninitialized(NumOfFramesPerCallback * Case.NumOfChannels);
+		bool bCallbacksMatch = true;
+		for (int64 StartFrame = 0; StartFrame < NumOfFrames; StartFrame += NumOfFramesPerCallback)
+		{
+			const int64 NumOfCopiedFrames = BlockCache.CopyFrames(CompressedData, StartFrame, NumOfFramesPerCallback, CallbackPCMData.GetData());
+			bCallbacksMatch &= NumOfCopiedFrames == FMath::Min<int64>(NumOfFramesPerCallback, NumOfFrames - StartFrame)
+				&& FMemory::Memcmp(CallbackPCMData.GetData(), ExpectedPCMData.GetData() + StartFrame * Case.NumOfChannels, NumOfCopiedFrames * Case.NumOfChannels * sizeof(float)) == 0;
+		}
+		TestTrue(FString::Printf(TEXT("%s samples copied through the block cache are bit-identical"), Case.Name), bCallbacksMatch);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCMBlockCodecAllocationFreeTest, "RuntimeAudioImporter.PCMBlockCodec.AllocationFree", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPCMBlockCodecAllocationFreeTest::RunTest(const FString& Parameters)
+{
+	const int32 NumOfFrames = FCompressedPCMData::NumOfFramesPerBlock * 16;
+	const TArray<float> PCMData = PCMBlockCodecTests::Quantize(RuntimeAudioImporterTests::MakeTestSignal(44100, 2, NumOfFrames), 32768.f);
+	const FCompressedPCMDataPtr CompressedData = FPCMBlock_RuntimeCodec::Compress(PCMData.GetData(), PCMData.Num(), 2, false);
+	if (!TestTrue(TEXT("Compressed"), CompressedData.IsValid()))
+	{
+		return false;
+	}
+
+	const int32 NumOfFramesPerCallback = 1024;
+	TArray<float> CallbackPCMData;
+	CallbackPCMData.SetNumUninitialized(NumOfFramesPerCallback * 2);
+
+	// The first blocks fill every cache slot and the scratch buffer, which allocates once each
+	FPCMBlockCache BlockCache;
+	int64 StartFrame = 0;
+	for (; StartFrame < FCompressedPCMData::NumOfFramesPerBlock * 5; StartFrame += NumOfFramesPerCallback)
+	{
+		BlockCache.CopyFrames(CompressedData, StartFrame, NumOfFramesPerCallback, CallbackPCMData.GetData());
+	}
+
+	int32 NumOfAllocations = 0;
+	{
+		RuntimeAudioImporterTests::FScopedAllocationCounter AllocationCounter;
+		for (; StartFrame < NumOfFrames; StartFrame += NumOfFramesPerCallback)
+		{
+			BlockCache.CopyFrames(CompressedData, StartFrame, NumOfFramesPerCallback, CallbackPCMData.GetData());
+		}
+		NumOfAllocations = AllocationCounter.GetNumOfAllocations();
+	}
+	TestEqual(TEXT("Heap allocations while decoding blocks for playback"), NumOfAllocations, 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCMBlockCodecBenchmarkTest, "RuntimeAudioImporter.PCMBlockCodec.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FPCMBlockCodecBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// One minute of audio, played back in 1024-frame callbacks as the audio mixer requests it
+	const int32 NumOfFrames = 48000 * 60;
+	const int32 NumOfFramesPerCallback = 1024;
+
+	for (const PCMBlockCodecTests::FCodecCase& Case : PCMBlockCodecTests::MakeCodecCases(NumOfFrames))
+	{
+		const double CompressStartTime = FPlatformTime::Seconds();
+		const FCompressedPCMDataPtr CompressedData = FPCMBlock_RuntimeCodec::Compress(Case.PCMData.GetData(), Case.PCMData.Num(), Case.NumOfChannels, Case.bQuantizeTo16Bit);
+		const double CompressTime = FPlatformTime::Seconds() - CompressStartTime;
+		if (!TestTrue(FString::Printf(TEXT("%s compressed"), Case.Name), CompressedData.IsValid()))
+		{
+			continue;
+		}
+
+		TArray<float> CallbackPCMData;
+		CallbackPCMData.SetNumUninitialized(NumOfFramesPerCallback * Case.NumOfChannels);
+		FPCMBlockCache BlockCache;
+		int32 NumOfCallbacks = 0;
+		double MaxCallbackTime = 0;
+		const double PlaybackStartTime = FPlatformTime::Seconds();
+		for (int64 StartFrame = 0; StartFrame < NumOfFrames; StartFrame += NumOfFramesPerCallback, ++NumOfCallbacks)
+		{
+			const double CallbackStartTime = FPlatformTime::Seconds();
+			BlockCache.CopyFrames(CompressedData, StartFrame, NumOfFramesPerCallback, CallbackPCMData.GetData());
+			MaxCallbackTime = FMath::Max(MaxCallbackTime, FPlatformTime::Seconds() - CallbackStartTime);
+		}
+		const double PlaybackTime = FPlatformTime::Seconds() - PlaybackStartTime;
+
+		const int64 UncompressedSize = static_cast<int64>(Case.PCMData.Num()) * sizeof(float);
+		AddInfo(FString::Printf(TEXT("%s: compressed to %.1f%% of the float size in %.1f ms, %.2f us per %d-frame callback on average, %.2f us at most"),
+			Case.Name, 100. * CompressedData->GetAllocatedSize() / UncompressedSize, CompressTime * 1000.,
+			PlaybackTime * 1000000. / FMath::Max(NumOfCallbacks, 1), NumOfFramesPerCallback, MaxCallbackTime * 1000000.));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,250 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestUtils.h"
+#include "Sound/RuntimeAudioCaptureRing.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+
+namespace RuntimeAudioCaptureRingTests
+{
+	/** Sample values encode the frame position modulo this, which keeps them exact as floats */
+	constexpr int64 FramePositionPeriod = 1 << 23;
+
+	/** Fills a block of frames whose samples all hold the position of their frame */
+	void FillPositionBlock(TArray<float>& Block, int64 FirstFramePosition, int32 NumOfFrames, int32 NumOfChannels)
+	{
+		Block.SetNumUninitialized(NumOfFrames * NumOfChannels, false);
+		for (int32 FrameIndex = 0; FrameIndex < NumOfFrames; ++FrameIndex)
+		{
+			const float Value = static_cast<float>((FirstFramePosition + FrameIndex) % FramePositionPeriod);
+			for (int32 ChannelIndex = 0; ChannelIndex < NumOfChannels; ++ChannelIndex)
+			{
+				Block[FrameIndex * NumOfChannels + ChannelIndex] = Value;
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioCaptureRingTornReadTest, "RuntimeAudioImporter.CaptureRing.TornReads", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioCaptureRingTornReadTest::RunTest(const FString& Parameters)
+{
+	using namespace RuntimeAudioCaptureRingTests;
+
+	// A ring much smaller than the blocks in flight, so that the producer keeps overwriting what the consumer is copying
+	const int32 NumOfChannels = 3;
+	const int32 NumOfFramesPerBlock = 97;
+	const int64 NumOfFramesToWrite = 4000000; // Below FramePositionPeriod, so positions never wrap
+	FRuntimeAudioCaptureRing CaptureRing;
+	CaptureRing.Initialize(1000);
+
+	std::atomic<bool> bProducerFinished{false};
+	TFuture<void> Producer = Async(EAsyncExecution::Thread, [&CaptureRing, &bProducerFinished, NumOfChannels, NumOfFramesPerBlock, NumOfFramesToWrite]()
+	{
+		TArray<float> Block;
+		for (int64 FramePosition = 0; FramePosition < NumOfFramesToWrite; FramePosition += NumOfFramesPerBlock)
+		{
+			FillPositionBlock(Block, FramePosition, NumOfFramesPerBlock, NumOfChannels);
+			CaptureRing.Write(Block.GetData(), NumOfFramesPerBlock, NumOfChannels, 48000);
+		}
+		bProducerFinished = true;
+	});
+
+	// Every sample read must hold the position of its frame: the frames of a read are consecutive, and never go back in time across reads
+	TArray<float> ReadData;
+	ReadData.SetNumUninitialized(777);
+	int64 NumOfReadSamples = 0;
+	int64 LastFramePosition = -1;
+	int32 NumOfReads = 0;
+	bool bConsistent = true;
+	while (bConsistent)
+	{
+		const bool bFinished = bProducerFinished;
+		const int64 NumOfSamples = CaptureRing.Read(ReadData.GetData(), ReadData.Num());
+		if (NumOfSamples % NumOfChannels != 0)
+		{
+			AddError(FString::Printf(TEXT("Read %lld samples, not a whole number of frames"), NumOfSamples));
+			break;
+		}
+		for (int64 SampleIndex = 0; SampleIndex < NumOfSamples && bConsistent; SampleIndex += NumOfChannels)
+		{
+			const int64 FramePosition = static_cast<int64>(ReadData[SampleIndex]);
+			for (int32 ChannelIndex = 1; ChannelIndex < NumOfChannels; ++ChannelIndex)
+			{
+				if (ReadData[SampleIndex + ChannelIndex] != ReadData[SampleIndex])
+				{
+					AddError(FString::Printf(TEXT("Read %d holds a torn frame: %f and %f"), NumOfReads, ReadData[SampleIndex], ReadData[SampleIndex + ChannelIndex]));
+					bConsistent = false;
+				}
+			}
+			const bool bFollowsLastFrame = SampleIndex == 0 ? FramePosition > LastFramePosition : FramePosition == LastFramePosition + 1;
+			if (bConsistent && !bFollowsLastFrame)
+			{
+				AddError(FString::Printf(TEXT("Read %d holds frame %lld after frame %lld"), NumOfReads, FramePosition, LastFramePosition));
+				bConsistent = false;
+			}
+			LastFramePosition = FramePosition;
+		}
+		NumOfReadSamples += NumOfSamples;
+		++NumOfReads;
+
+		if (bFinished && CaptureRing.GetNumOfAvailableSamples() == 0)
+		{
+			break;
+		}
+	}
+	Producer.Wait();
+
+	const int64 NumOfWrittenSamples = (NumOfFramesToWrite + NumOfFramesPerBlock - 1) / NumOfFramesPerBlock * NumOfFramesPerBlock * NumOfChannels;
+	AddInfo(FString::Printf(TEXT("%d reads, %lld samples read, %lld samples dropped"), NumOfReads, NumOfReadSamples, CaptureRing.GetNumOfOverrunSamples()));
+	if (bConsistent)
+	{
+		TestEqual(TEXT("Every written sample is either read or counted as an overrun"), NumOfReadSamples + CaptureRing.GetNumOfOverrunSamples(), NumOfWrittenSamples);
+		TestEqual(TEXT("The last frame is read"), LastFramePosition, NumOfWrittenSamples / NumOfChannels - 1);
+	}
+	return bConsistent;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioCaptureRingAllocationFreeTest, "RuntimeAudioImporter.CaptureRing.AllocationFree", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioCaptureRingAllocationFreeTest::RunTest(const FString& Parameters)
+{
+	const TArray<float> Block = RuntimeAudioImporterTests::MakeTestSignal(48000, 2, 480);
+	FRuntimeAudioCaptureRing CaptureRing;
+	CaptureRing.Initialize(48000 * 2);
+
+	TArray<float> ReadData;
+	ReadData.SetNumUninitialized(48000 * 2);
+	TArray<float> ConvertedData;
+	FRuntimeAudioCaptureConverter CaptureConverter;
+
+	// The first conversion sizes the buffers of the converter
+	CaptureRing.Write(Block.GetData(), 480, 2, 48000);
+	int64 NumOfSamples = CaptureRing.Read(ReadData.GetData(), ReadData.Num());
+	CaptureConverter.Convert(MakeArrayView(ReadData.GetData(), static_cast<int32>(NumOfSamples)), 48000, 2, 44100, 1, ConvertedData);
+
+	int32 NumOfAllocations = 0;
+	{
+		RuntimeAudioImporterTests::FScopedAllocationCounter AllocationCounter;
+		for (int32 BlockIndex = 0; BlockIndex < 100; ++BlockIndex)
+		{
+			CaptureRing.Write(Block.GetData(), 480, 2, 48000);
+			NumOfSamples = CaptureRing.Read(ReadData.GetData(), ReadData.Num());
+			CaptureConverter.Convert(MakeArrayView(ReadData.GetData(), static_cast<int32>(NumOfSamples)), 48000, 2, 44100, 1, ConvertedData);
+		}
+		NumOfAllocations = AllocationCounter.GetNumOfAllocations();
+	}
+	TestEqual(TEXT("Heap allocations while writing, reading and converting"), NumOfAllocations, 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioCaptureConverterMixTest, "RuntimeAudioImporter.CaptureRing.ConverterChannelMix", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioCaptureConverterMixTest::RunTest(const FString& Parameters)
+{
+	struct FMixCase
+	{
+		int32 SourceNumOfChannels;
+		int32 DestinationNumOfChannels;
+	};
+
+	// Each source channel holds a constant equal to its index, so resampling keeps the mixed values exactly and both paths must agree
+	const int32 NumOfFrames = 480;
+	for (const FMixCase& Case : {FMixCase{16, 10}, FMixCase{12, 9}, FMixCase{6, 2}, FMixCase{2, 12}})
+	{
+		TArray<float> PCMData;
+		PCMData.SetNumUninitialized(NumOfFrames * Case.SourceNumOfChannels);
+		for (int32 SampleIndex = 0; SampleIndex < PCMData.Num(); ++SampleIndex)
+		{
+			PCMData[SampleIndex] = static_cast<float>(SampleIndex % Case.SourceNumOfChannels);
+		}
+
+		TArray<float> ExpectedFrame;
+		for (int32 ChannelIndex = 0; ChannelIndex < Case.DestinationNumOfChannels; ++ChannelIndex)
+		{
+			if (Case.SourceNumOfChannels <= Case.DestinationNumOfChannels)
+			{
+				ExpectedFrame.Add(static_cast<float>(ChannelIndex % Case.SourceNumOfChannels));
+				continue;
+			}
+			float Sum = 0.f;
+			int32 NumOfFoldedChannels = 0;
+			for (int32 SourceChannelIndex = ChannelIndex; SourceChannelIndex < Case.SourceNumOfChannels; SourceChannelIndex += Case.DestinationNumOfChannels)
+			{
+				Sum += SourceChannelIndex;
+				++NumOfFoldedChannels;
+			}
+			ExpectedFrame.Add(Sum / NumOfFoldedChannels);
+		}
+
+		for (const int32 DestinationSampleRate : {48000, 44100, 16000})
+		{
+			FRuntimeAudioCaptureConverter CaptureConverter;
+			TArray<float> ConvertedData;
+			// Two blocks, so that the frame carried across the block boundary is covered as well
+			for (int32 BlockIndex = 0; BlockIndex < 2; ++BlockIndex)
+			{
+				CaptureConverter.Convert(PCMData, 48000, Case.SourceNumOfChannels, DestinationSampleRate, Case.DestinationNumOfChannels, ConvertedData);
+				const FString CaseName = FString::Printf(TEXT("%d to %d channels at %d Hz, block %d"), Case.SourceNumOfChannels, Case.DestinationNumOfChannels, DestinationSampleRate, BlockIndex);
+				if (!TestTrue(FString::Printf(TEXT("%s: whole frames converted"), *CaseName), ConvertedData.Num() > 0 && ConvertedData.Num() % Case.DestinationNumOfChannels == 0))
+				{
+					return false;
+				}
+				for (int32 SampleIndex = 0; SampleIndex < ConvertedData.Num(); ++SampleIndex)
+				{
+					const float Expected = ExpectedFrame[SampleIndex % Case.DestinationNumOfChannels];
+					if (!FMath::IsNearlyEqual(ConvertedData[SampleIndex], Expected, 1e-5f))
+					{
+						AddError(FString::Printf(TEXT("%s: sample %d is %f, expected %f"), *CaseName, SampleIndex, ConvertedData[SampleIndex], Expected));
+						return false;
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioCaptureRingBenchmarkTest, "RuntimeAudioImporter.CaptureRing.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRuntimeAudioCaptureRingBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// Ten seconds of capture in 1024 frame blocks, as the capture stream delivers them, consumed in 10 ms steps and converted to mono 16 kHz
+	const int32 SampleRate = 48000;
+	const int32 NumOfChannels = 2;
+	const int32 NumOfFramesPerBlock = 1024;
+	const TArray<float> Block = RuntimeAudioImporterTests::MakeTestSignal(SampleRate, NumOfChannels, NumOfFramesPerBlock);
+
+	FRuntimeAudioCaptureRing CaptureRing;
+	CaptureRing.Initialize(2 * SampleRate * NumOfChannels);
+	FRuntimeAudioCaptureConverter CaptureConverter;
+	TArray<float> ReadData;
+	ReadData.SetNumUninitialized(2 * SampleRate * NumOfChannels);
+	TArray<float> ConvertedData;
+
+	double WriteTime = 0;
+	double ConsumeTime = 0;
+	int64 NumOfConvertedSamples = 0;
+	for (int64 FramePosition = 0; FramePosition < SampleRate * 10; FramePosition += NumOfFramesPerBlock)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		CaptureRing.Write(Block.GetData(), NumOfFramesPerBlock, NumOfChannels, SampleRate);
+		WriteTime += FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		const int64 NumOfSamples = CaptureRing.Read(ReadData.GetData(), ReadData.Num());
+		CaptureConverter.Convert(MakeArrayView(ReadData.GetData(), static_cast<int32>(NumOfSamples)), SampleRate, NumOfChannels, 16000, 1, ConvertedData);
+		NumOfConvertedSamples += ConvertedData.Num();
+		ConsumeTime += FPlatformTime::Seconds() - StartTime;
+	}
+
+	AddInfo(FString::Printf(TEXT("10 s of capture: writing %.3f ms, reading and converting %.3f ms, %lld samples converted, %lld dropped"), WriteTime * 1000.0, ConsumeTime * 1000.0, NumOfConvertedSamples, CaptureRing.GetNumOfOverrunSamples()));
+	TestEqual(TEXT("Nothing dropped while the consumer keeps up"), CaptureRing.GetNumOfOverrunSamples(), static_cast<int64>(0));
+	return true;
+}
+
+#endif
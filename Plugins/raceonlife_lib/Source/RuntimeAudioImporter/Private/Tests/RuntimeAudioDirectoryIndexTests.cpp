@@ -0,0 +1,426 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestUtils.h"
+#include "RuntimeAudioDirectoryIndex.h"
+#include "RuntimeAudioHeaderReader.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace RuntimeAudioDirectoryIndexTests
+{
+	/** Appends an ID3v2.3 text frame holding ISO-8859-1 text */
+	void AppendID3TextFrame(TArray<uint8>& Data, const char* FrameID, const FString& Text)
+	{
+		const uint32 FrameSize = 1 + Text.Len();
+		const uint8 FrameHeader[10] = {
+			static_cast<uint8>(FrameID[0]), static_cast<uint8>(FrameID[1]), static_cast<uint8>(FrameID[2]), static_cast<uint8>(FrameID[3]),
+			static_cast<uint8>(FrameSize >> 24), static_cast<uint8>(FrameSize >> 16), static_cast<uint8>(FrameSize >> 8), static_cast<uint8>(FrameSize),
+			0, 0
+		};
+		Data.Append(FrameHeader, UE_ARRAY_COUNT(FrameHeader));
+		Data.Add(0);
+		for (const TCHAR Char : Text)
+		{
+			Data.Add(static_cast<uint8>(Char));
+		}
+	}
+
+	/**
+	 * Builds a minimal MP3 file: an ID3v2 tag, a few junk bytes holding a stray sync word, NumOfFrames silent frames and an ID3v1 tag
+	 * If XingNumOfFrames is set, the first frame carries a Xing header with that frame count, as VBR encoders write it
+	 * The ID3v2 tag holds the title and artist if they are set, the ID3v1 tag always holds ID3v1Title
+	 */
+	TArray<uint8> MakeTestMP3(const uint8 (&FrameHeader)[4], int32 FrameSize, int32 SideInfoSize, int32 NumOfFrames, uint32 XingNumOfFrames, const FString& Title = FString(), const FString& Artist = FString(), const FString& ID3v1Title = FString())
+	{
+		TArray<uint8> TagData;
+		if (!Title.IsEmpty())
+		{
+			AppendID3TextFrame(TagData, "TIT2", Title);
+		}
+		if (!Artist.IsEmpty())
+		{
+			AppendID3TextFrame(TagData, "TPE1", Artist);
+		}
+		TagData.AddZeroed(20);
+
+		TArray<uint8> Data;
+		const uint8 ID3v2Header[10] = {'I', 'D', '3', 3, 0, 0, 0, 0, static_cast<uint8>((TagData.Num() >> 7) & 0x7F), static_cast<uint8>(TagData.Num() & 0x7F)};
+		Data.Append(ID3v2Header, UE_ARRAY_COUNT(ID3v2Header));
+		Data.Append(TagData);
+
+		const uint8 Junk[3] = {0xFF, 0xFB, 0x90};
+		Data.Append(Junk, UE_ARRAY_COUNT(Junk));
+
+		for (int32 FrameIndex = 0; FrameIndex < NumOfFrames; ++FrameIndex)
+		{
+			const int32 FrameOffset = Data.Num();
+			Data.AddZeroed(FrameSize);
+			FMemory::Memcpy(Data.GetData() + FrameOffset, FrameHeader, 4);
+
+			if (FrameIndex == 0 && XingNumOfFrames > 0)
+			{
+				uint8* Xing = Data.GetData() + FrameOffset + 4 + SideInfoSize;
+				FMemory::Memcpy(Xing, "Xing", 4);
+				Xing[7] = 0x01;
+				Xing[8] = static_cast<uint8>(XingNumOfFrames >> 24);
+				Xing[9] = static_cast<uint8>(XingNumOfFrames >> 16);
+				Xing[10] = static_cast<uint8>(XingNumOfFrames >> 8);
+				Xing[11] = static_cast<uint8>(XingNumOfFrames);
+			}
+		}
+
+		const int32 ID3v1Offset = Data.Num();
+		Data.AddZeroed(128);
+		FMemory::Memcpy(Data.GetData() + ID3v1Offset, "TAG", 3);
+		for (int32 CharIndex = 0; CharIndex < FMath::Min(ID3v1Title.Len(), 30); ++CharIndex)
+		{
+			Data[ID3v1Offset + 3 + CharIndex] = static_cast<uint8>(ID3v1Title[CharIndex]);
+		}
+		return Data;
+	}
+
+	/** MPEG 1 Layer III, 128 kbit/s, 44.1 kHz, stereo: 417 byte frames */
+	const uint8 MPEG1Header[4] = {0xFF, 0xFB, 0x90, 0x00};
+
+	/** MPEG 2 Layer III, 64 kbit/s, 22.05 kHz, mono: 208 byte frames */
+	const uint8 MPEG2Header[4] = {0xFF, 0xF3, 0x80, 0xC0};
+
+	/** Returns a fresh directory for the test, removing whatever a previous run left behind */
+	FString MakeTestDirectory(const TCHAR* Name)
+	{
+		const FString Directory = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("RuntimeAudioDirectoryIndex") / Name);
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		IFileManager::Get().MakeDirectory(*Directory, true);
+		return Directory;
+	}
+
+	/** Whether both lists hold the same entries, header information included */
+	bool AreEntriesEqual(const TArray<FRuntimeAudioIndexEntry>& A, const TArray<FRuntimeAudioIndexEntry>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+		for (int32 EntryIndex = 0; EntryIndex < A.Num(); ++EntryIndex)
+		{
+			const FRuntimeAudioIndexEntry& EntryA = A[EntryIndex];
+			const FRuntimeAudioIndexEntry& EntryB = B[EntryIndex];
+			if (EntryA.FilePath != EntryB.FilePath || EntryA.FileSize != EntryB.FileSize || EntryA.ModificationTime != EntryB.ModificationTime
+				|| EntryA.bHeaderInfoValid != EntryB.bHeaderInfoValid || EntryA.HeaderInfo.Duration != EntryB.HeaderInfo.Duration
+				|| EntryA.HeaderInfo.SampleRate != EntryB.HeaderInfo.SampleRate || EntryA.HeaderInfo.NumOfChannels != EntryB.HeaderInfo.NumOfChannels
+				|| EntryA.Title != EntryB.Title || EntryA.Artist != EntryB.Artist)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	const FRuntimeAudioIndexEntry* FindEntry(const TArray<FRuntimeAudioIndexEntry>& Entries, const FString& FilePath)
+	{
+		return Entries.FindByPredicate([&FilePath](const FRuntimeAudioIndexEntry& Entry)
+		{
+			return Entry.FilePath == FilePath;
+		});
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioDirectoryIndexMP3HeaderTest, "RuntimeAudioImporter.DirectoryIndex.MP3HeaderInfo", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioDirectoryIndexMP3HeaderTest::RunTest(const FString& Parameters)
+{
+	using namespace RuntimeAudioDirectoryIndexTests;
+
+	struct FMP3HeaderCase
+	{
+		const TCHAR* Name;
+		TArray<uint8> Data;
+		float ExpectedDuration;
+		int32 ExpectedSampleRate;
+		int32 ExpectedNumOfChannels;
+	};
+
+	const FMP3HeaderCase Cases[] = {
+		{TEXT("CBR"), MakeTestMP3(MPEG1Header, 417, 32, 100, 0), 100 * 417 * 8 / 128000.f, 44100, 2},
+		{TEXT("Xing"), MakeTestMP3(MPEG1Header, 417, 32, 10, 250), 250 * 1152 / 44100.f, 44100, 2},
+		{TEXT("MPEG 2 mono Xing"), MakeTestMP3(MPEG2Header, 208, 9, 10, 400), 400 * 576 / 22050.f, 22050, 1},
+	};
+
+	const FString FilePath = MakeTestDirectory(TEXT("MP3HeaderInfo")) / TEXT("Test.mp3");
+	for (const FMP3HeaderCase& Case : Cases)
+	{
+		if (!TestTrue(FString::Printf(TEXT("%s: test file written"), Case.Name), FFileHelper::SaveArrayToFile(Case.Data, *FilePath)))
+		{
+			return false;
+		}
+
+		FRuntimeAudioHeaderInfo HeaderInfo;
+		if (TestTrue(FString::Printf(TEXT("%s: header read"), Case.Name), FRuntimeAudioHeaderReader::ReadMP3HeaderInfo(FilePath, HeaderInfo)))
+		{
+			TestEqual(FString::Printf(TEXT("%s: duration"), Case.Name), HeaderInfo.Duration, Case.ExpectedDuration, 0.001f);
+			TestEqual(FString::Printf(TEXT("%s: sample rate"), Case.Name), HeaderInfo.SampleRate, Case.ExpectedSampleRate);
+			TestEqual(FString::Printf(TEXT("%s: number of channels"), Case.Name), HeaderInfo.NumOfChannels, Case.ExpectedNumOfChannels);
+			TestTrue(FString::Printf(TEXT("%s: audio format"), Case.Name), HeaderInfo.AudioFormat == ERuntimeAudioFormat::Mp3);
+		}
+	}
+
+	IFileManager::Get().Delete(*FilePath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioDirectoryIndexID3TagsTest, "RuntimeAudioImporter.DirectoryIndex.ID3Tags", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioDirectoryIndexID3TagsTest::RunTest(const FString& Parameters)
+{
+	using namespace RuntimeAudioDirectoryIndexTests;
+
+	const FString FilePath = MakeTestDirectory(TEXT("ID3Tags")) / TEXT("Test.mp3");
+
+	// The ID3v2 frames win over the ID3v1 tag
+	FFileHelper::SaveArrayToFile(MakeTestMP3(MPEG1Header, 417, 32, 10, 0, TEXT("Night Drive"), TEXT("The Racers"), TEXT("Old Title")), *FilePath);
+	FString Title, Artist;
+	FRuntimeAudioHeaderReader::ReadID3Tags(FilePath, Title, Artist);
+	TestEqual(TEXT("ID3v2 title"), Title, FString(TEXT("Night Drive")));
+	TestEqual(TEXT("ID3v2 artist"), Artist, FString(TEXT("The Racers")));
+
+	// Without ID3v2 frames the title comes from the ID3v1 tag
+	FFileHelper::SaveArrayToFile(MakeTestMP3(MPEG1Header, 417, 32, 10, 0, FString(), FString(), TEXT("Old Title")), *FilePath);
+	Title.Reset();
+	Artist.Reset();
+	FRuntimeAudioHeaderReader::ReadID3Tags(FilePath, Title, Artist);
+	TestEqual(TEXT("ID3v1 title"), Title, FString(TEXT("Old Title")));
+	TestTrue(TEXT("ID3v1 artist is empty"), Artist.IsEmpty());
+
+	IFileManager::Get().Delete(*FilePath);
+	return true;
+}
+
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioDirectoryIndexInvalidationTest, "RuntimeAudioImporter.DirectoryIndex.IncrementalInvalidation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioDirectoryIndexInvalidationTest::RunTest(const FString& Parameters)
+{
+	using namespace RuntimeAudioDirectoryIndexTests;
+
+	const FString Directory = MakeTestDirectory(TEXT("IncrementalInvalidation"));
+	const FString SubDirectory = Directory / TEXT("Sub");
+	const FString IndexFilePath = Directory + TEXT("_Index.idx");
+	IFileManager::Get().Delete(*IndexFilePath, false, true, true);
+
+	const FString UnchangedPath = Directory / TEXT("Unchanged.wav");
+	const FString ModifiedPath = Directory / TEXT("Modified.wav");
+	const FString DeletedPath = SubDirectory / TEXT("Deleted.wav");
+	const FString AddedPath = SubDirectory / TEXT("Added.wav");
+	const FString TaggedPath = SubDirectory / TEXT("Tagged.mp3");
+
+	FFileHelper::SaveArrayToFile(RuntimeAudioImporterTests::MakeTestWAVData(44100, 2, 44100), *UnchangedPath);
+	FFileHelper::SaveArrayToFile(RuntimeAudioImporterTests::MakeTestWAVData(48000, 1, 24000), *ModifiedPath);
+	FFileHelper::SaveArrayToFile(RuntimeAudioImporterTests::MakeTestWAVData(22050, 1, 22050), *DeletedPath);
+	FFileHelper::SaveArrayToFile(MakeTestMP3(MPEG1Header, 417, 32, 10, 250, TEXT("Night Drive"), TEXT("The Racers")), *TaggedPath);
+	FFileHelper::SaveStringToFile(TEXT("Not audio"), *(Directory / TEXT("Notes.txt")));
+
+	TArray<FRuntimeAudioIndexEntry> Entries;
+	{
+		FRuntimeAudioDirectoryIndex DirectoryIndex(IndexFilePath);
+		if (!TestTrue(TEXT("Initial scan succeeded"), DirectoryIndex.Scan(Directory, true, Entries)))
+		{
+			return false;
+		}
+		TestEqual(TEXT("Audio files found by the initial scan"), Entries.Num(), 4);
+
+		TArray<FRuntimeAudioIndexEntry> TopLevelEntries;
+		DirectoryIndex.Scan(Directory, false, TopLevelEntries);
+		TestEqual(TEXT("Audio files found by a non-recursive scan"), TopLevelEntries.Num(), 2);
+
+		if (const FRuntimeAudioIndexEntry* Entry = FindEntry(Entries, ModifiedPath))
+		{
+			TestTrue(TEXT("Header of the WAV file read"), Entry->bHeaderInfoValid);
+			TestEqual(TEXT("Duration of the WAV file"), Entry->HeaderInfo.Duration, 0.5f, 0.001f);
+		}
+		if (const FRuntimeAudioIndexEntry* Entry = FindEntry(Entries, TaggedPath))
+		{
+			TestTrue(TEXT("Header of the MP3 file read"), Entry->bHeaderInfoValid);
+			TestEqual(TEXT("Title of the MP3 file"), Entry->Title, FString(TEXT("Night Drive")));
+			TestEqual(TEXT("Artist of the MP3 file"), Entry->Artist, FString(TEXT("The Racers")));
+		}
+	}
+
+	// The unchanged file is overwritten with garbage of the same size and its modification time is restored, so it is only still valid if its header is not read again
+	const FDateTime UnchangedTime = IFileManager::Get().GetTimeStamp(*UnchangedPath);
+	TArray<uint8> Garbage;
+	Garbage.SetNumZeroed(IFileManager::Get().FileSize(*UnchangedPath));
+	FFileHelper::SaveArrayToFile(Garbage, *UnchangedPath);
+	IFileManager::Get().SetTimeStamp(*UnchangedPath, UnchangedTime);
+
+	FFileHelper::SaveArrayToFile(RuntimeAudioImporterTests::MakeTestWAVData(48000, 1, 96000), *ModifiedPath);
+	IFileManager::Get().Delete(*DeletedPath);
+	FFileHelper::SaveArrayToFile(RuntimeAudioImporterTests::MakeTestWAVData(32000, 2, 8000), *AddedPath);
+
+	// A fresh instance, so the entries come from the persisted index
+	FRuntimeAudioDirectoryIndex DirectoryIndex(IndexFilePath);
+	if (!TestTrue(TEXT("Rescan succeeded"), DirectoryIndex.Scan(Directory, true, Entries)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Audio files found by the rescan"), Entries.Num(), 4);
+	TestNull(TEXT("Deleted file dropped"), FindEntry(Entries, DeletedPath));
+
+	const FRuntimeAudioIndexEntry* UnchangedEntry = FindEntry(Entries, UnchangedPath);
+	if (TestNotNull(TEXT("Unchanged file kept"), UnchangedEntry))
+	{
+		TestTrue(TEXT("Unchanged file served from the index"), UnchangedEntry->bHeaderInfoValid);
+		TestEqual(TEXT("Duration of the unchanged file"), UnchangedEntry->HeaderInfo.Duration, 1.f, 0.001f);
+	}
+	const FRuntimeAudioIndexEntry* ModifiedEntry = FindEntry(Entries, ModifiedPath);
+	if (TestNotNull(TEXT("Modified file kept"), ModifiedEntry))
+	{
+		TestEqual(TEXT("Duration of the modified file reread"), ModifiedEntry->HeaderInfo.Duration, 2.f, 0.001f);
+	}
+	const FRuntimeAudioIndexEntry* AddedEntry = FindEntry(Entries, AddedPath);
+	if (TestNotNull(TEXT("Added file found"), AddedEntry))
+	{
+		TestEqual(TEXT("Sample rate of the added file"), AddedEntry->HeaderInfo.SampleRate, 32000);
+	}
+
+	TestTrue(TEXT("Query matches the last scan"), AreEntriesEqual(DirectoryIndex.Query(Directory, true), Entries));
+
+	DirectoryIndex.Clear();
+	TestFalse(TEXT("Persisted index deleted"), IFileManager::Get().FileExists(*IndexFilePath));
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioDirectoryIndexAppendTest, "RuntimeAudioImporter.DirectoryIndex.AppendOnlyPersistence", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioDirectoryIndexAppendTest::RunTest(const FString& Parameters)
+{
+	using namespace RuntimeAudioDirectoryIndexTests;
+
+	const FString Directory = MakeTestDirectory(TEXT("AppendOnlyPersistence"));
+	const FString IndexFilePath = Directory + TEXT("_Index.idx");
+	IFileManager::Get().Delete(*IndexFilePath, false, true, true);
+
+	const int32 NumOfFiles = 200;
+	for (int32 FileIndex = 0; FileIndex < NumOfFiles; ++FileIndex)
+	{
+		FFileHelper::SaveArrayToFile(RuntimeAudioImporterTests::MakeTestWAVData(44100, 1, 441, FileIndex), *(Directory / FString::Printf(TEXT("Track%03d.wav"), FileIndex)));
+	}
+
+	FRuntimeAudioDirectoryIndex DirectoryIndex(IndexFilePath);
+	TArray<FRuntimeAudioIndexEntry> Entries;
+	DirectoryIndex.Scan(Directory, true, Entries);
+	const int64 FullIndexSize = IFileManager::Get().FileSize(*IndexFilePath);
+	if (!TestTrue(TEXT("Index persisted"), FullIndexSize > 0))
+	{
+		return false;
+	}
+
+	// A single modified and a single deleted file only append two records
+	FFileHelper::SaveArrayToFile(RuntimeAudioImporterTests::MakeTestWAVData(44100, 1, 882), *(Directory / TEXT("Track000.wav")));
+	IFileManager::Get().Delete(*(Directory / TEXT("Track001.wav")));
+	DirectoryIndex.Scan(Directory, true, Entries);
+	const int64 AppendedIndexSize = IFileManager::Get().FileSize(*IndexFilePath);
+	const int64 RecordSize = FullIndexSize / NumOfFiles;
+	AddInfo(FString::Printf(TEXT("Index of %d files: %lld bytes, %lld bytes after one update and one removal"), NumOfFiles, FullIndexSize, AppendedIndexSize));
+	TestTrue(TEXT("Index grew instead of being rewritten"), AppendedIndexSize > FullIndexSize && AppendedIndexSize - FullIndexSize < RecordSize * 3);
+
+	{
+		FRuntimeAudioDirectoryIndex ReloadedIndex(IndexFilePath);
+		TestTrue(TEXT("Replayed index matches the live one"), AreEntriesEqual(ReloadedIndex.Query(Directory, true), Entries));
+	}
+
+	// A record cut short by a crash keeps the records before it and makes the next save rewrite the file
+	// The removal is the last record, so cutting it short brings the deleted file back until the next scan
+	TArray<uint8> IndexData;
+	FFileHelper::LoadFileToArray(IndexData, *IndexFilePath);
+	IndexData.SetNum(IndexData.Num() - 3);
+	FFileHelper::SaveArrayToFile(IndexData, *IndexFilePath);
+	{
+		FRuntimeAudioDirectoryIndex DamagedIndex(IndexFilePath);
+		TestEqual(TEXT("Records before the damaged one are kept"), DamagedIndex.Query(Directory, true).Num(), NumOfFiles);
+
+		TArray<FRuntimeAudioIndexEntry> RepairedEntries;
+		DamagedIndex.Scan(Directory, true, RepairedEntries);
+		TestTrue(TEXT("Rescan of the damaged index matches the live one"), AreEntriesEqual(RepairedEntries, Entries));
+	}
+	{
+		FRuntimeAudioDirectoryIndex RepairedIndex(IndexFilePath);
+		TestTrue(TEXT("Rewritten index matches the live one"), AreEntriesEqual(RepairedIndex.Query(Directory, true), Entries));
+	}
+
+	DirectoryIndex.Clear();
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioDirectoryIndexBenchmarkTest, "RuntimeAudioImporter.DirectoryIndex.ScanBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRuntimeAudioDirectoryIndexBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RuntimeAudioDirectoryIndexTests;
+
+	// 10000 short files spread over 100 directories
+	const FString Directory = MakeTestDirectory(TEXT("ScanBenchmark"));
+	const FString IndexFilePath = Directory + TEXT("_Index.idx");
+	IFileManager::Get().Delete(*IndexFilePath, false, true, true);
+
+	const int32 NumOfDirectories = 100;
+	const int32 NumOfFilesPerDirectory = 100;
+	const TArray<uint8> WAVData = RuntimeAudioImporterTests::MakeTestWAVData(44100, 2, 4410);
+	for (int32 AlbumIndex = 0; AlbumIndex < NumOfDirectories; ++AlbumIndex)
+	{
+		for (int32 FileIndex = 0; FileIndex < NumOfFilesPerDirectory; ++FileIndex)
+		{
+			FFileHelper::SaveArrayToFile(WAVData, *(Directory / FString::Printf(TEXT("Album%03d/Track%03d.wav"), AlbumIndex, FileIndex)));
+		}
+	}
+	const int32 NumOfFiles = NumOfDirectories * NumOfFilesPerDirectory;
+
+	auto TimeScan = [this, &Directory, NumOfFiles](FRuntimeAudioDirectoryIndex& DirectoryIndex, const TCHAR* Name)
+	{
+		TArray<FRuntimeAudioIndexEntry> Entries;
+		const double StartTime = FPlatformTime::Seconds();
+		DirectoryIndex.Scan(Directory, true, Entries);
+		const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+		TestEqual(FString::Printf(TEXT("%s: audio files found"), Name), Entries.Num(), NumOfFiles);
+		AddInfo(FString::Printf(TEXT("%s scan of %d files: %.1f ms"), Name, NumOfFiles, ElapsedTime * 1000.0));
+		return ElapsedTime;
+	};
+
+	double ColdTime, WarmTime, ReloadedTime, IncrementalTime;
+	{
+		FRuntimeAudioDirectoryIndex DirectoryIndex(IndexFilePath);
+		ColdTime = TimeScan(DirectoryIndex, TEXT("Cold"));
+		WarmTime = TimeScan(DirectoryIndex, TEXT("Warm"));
+	}
+	{
+		FRuntimeAudioDirectoryIndex DirectoryIndex(IndexFilePath);
+		ReloadedTime = TimeScan(DirectoryIndex, TEXT("Reloaded"));
+
+		// One file per directory changed
+		for (int32 AlbumIndex = 0; AlbumIndex < NumOfDirectories; ++AlbumIndex)
+		{
+			FFileHelper::SaveArrayToFile(RuntimeAudioImporterTests::MakeTestWAVData(44100, 2, 8820), *(Directory / FString::Printf(TEXT("Album%03d/Track000.wav"), AlbumIndex)));
+		}
+		IncrementalTime = TimeScan(DirectoryIndex, TEXT("Incremental"));
+	}
+
+	AddInfo(FString::Printf(TEXT("Speedup over the cold scan: warm %.1fx, reloaded %.1fx, incremental %.1fx"), ColdTime / WarmTime, ColdTime / ReloadedTime, ColdTime / IncrementalTime));
+	TestTrue(TEXT("Warm scan is faster than the cold scan"), WarmTime < ColdTime);
+	TestTrue(TEXT("Reloaded scan is faster than the cold scan"), ReloadedTime < ColdTime);
+
+	IFileManager::Get().Delete(*IndexFilePath, false, true, true);
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	return true;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,262 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImportScheduler.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Async/ParallelFor.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/ScopeLock.h"
+
+namespace RuntimeAudioImportSchedulerTests
+{
+	constexpr int32 NumOfPriorities = static_cast<int32>(ERuntimeImportPriority::Low) + 1;
+
+	/** State shared between the drain test and the imports it queues, which run on background threads */
+	struct FDrainState
+	{
+		int32 MaxConcurrentImports = 0;
+		int64 MemoryBudget = 0;
+
+		/** Number of imports expected to run, per priority */
+		int32 NumOfExpectedImports[NumOfPriorities] = {};
+
+		/** Number of imports whose work has started, per priority */
+		TAtomic<int32> NumOfStartedImports[NumOfPriorities] = {{0}, {0}, {0}};
+
+		TAtomic<int32> NumOfCancelledImports {0};
+		TAtomic<int32> MaxNumOfRunningImports {0};
+
+		/** Whether the import holding back the queue may return */
+		FThreadSafeBool bReleaseGate;
+
+		/** Errors raised on the worker threads, reported by the test once the queue is drained */
+		FCriticalSection ErrorsCriticalSection;
+		TArray<FString> Errors;
+
+		void AddError(const FString& Error)
+		{
+			FScopeLock Lock(&ErrorsCriticalSection);
+			Errors.Add(Error);
+		}
+
+		int32 GetNumOfStartedImports() const
+		{
+			int32 NumOfStarted = 0;
+			for (const TAtomic<int32>& NumOfStartedWithPriority : NumOfStartedImports)
+			{
+				NumOfStarted += NumOfStartedWithPriority.Load();
+			}
+			return NumOfStarted;
+		}
+	};
+
+	/** Waits until no import is queued, running or holding memory, returns false on timeout */
+	bool WaitForIdleScheduler(double Timeout)
+	{
+		const FRuntimeAudioImportScheduler& Scheduler = FRuntimeAudioImportScheduler::Get();
+		const double StartTime = FPlatformTime::Seconds();
+		while (Scheduler.GetNumOfQueuedImports() > 0 || Scheduler.GetNumOfRunningImports() > 0 || Scheduler.GetMemoryInFlight() != 0)
+		{
+			if (FPlatformTime::Seconds() - StartTime > Timeout)
+			{
+				return false;
+			}
+			FPlatformProcess::Sleep(0.001f);
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioImportSchedulerReservationTest, "RuntimeAudioImporter.ImportScheduler.ConcurrentReservationUpdates", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioImportSchedulerReservationTest::RunTest(const FString& Parameters)
+{
+	FRuntimeAudioImportScheduler& Scheduler = FRuntimeAudioImportScheduler::Get();
+	const int64 InitialMemoryInFlight = Scheduler.GetMemoryInFlight();
+	const int64 FinalReservedMemory = 12345;
+
+	FEvent* WorkDoneEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	const TSharedRef<TAtomic<int64>, ESPMode::ThreadSafe> MemoryInFlightAfterUpdates = MakeShared<TAtomic<int64>, ESPMode::ThreadSafe>(0);
+
+	// Many threads replacing the reservation of a running import at once, then a last update from the import itself
+	Scheduler.EnqueueImport(ERuntimeImportPriority::High, 1024, nullptr, [WorkDoneEvent, FinalReservedMemory, MemoryInFlightAfterUpdates]()
+	{
+		const FRuntimeAudioImportJobPtr Job = FRuntimeAudioImportScheduler::GetCurrentJob();
+		ParallelFor(64, [&Job](int32 TaskIndex)
+		{
+			for (int32 UpdateIndex = 0; UpdateIndex < 1000; ++UpdateIndex)
+			{
+				Job->UpdateReservedMemory(((TaskIndex * 1000 + UpdateIndex) % 4096) * 1024);
+			}
+		});
+		Job->UpdateReservedMemory(FinalReservedMemory);
+		*MemoryInFlightAfterUpdates = FRuntimeAudioImportScheduler::Get().GetMemoryInFlight();
+		WorkDoneEvent->Trigger();
+	}, TUniqueFunction<void()>());
+
+	const bool bWorkDone = WorkDoneEvent->Wait(FTimespan::FromSeconds(30));
+	FPlatformProcess::ReturnSynchEventToPool(WorkDoneEvent);
+	if (!TestTrue(TEXT("Import ran"), bWorkDone))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Memory in flight after the concurrent updates"), MemoryInFlightAfterUpdates->Load() - InitialMemoryInFlight, FinalReservedMemory);
+
+	// The reservation is released once the last reference to the import is dropped, right after its work returns
+	const double StartTime = FPlatformTime::Seconds();
+	while (Scheduler.GetMemoryInFlight() != InitialMemoryInFlight && FPlatformTime::Seconds() - StartTime < 10.0)
+	{
+		FPlatformProcess::Sleep(0.001f);
+	}
+	TestEqual(TEXT("Memory in flight once the import is done"), Scheduler.GetMemoryInFlight(), InitialMemoryInFlight);
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioImportSchedulerDrainTest, "RuntimeAudioImporter.ImportScheduler.Drain", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioImportSchedulerDrainTest::RunTest(const FString& Parameters)
+{
+	using namespace RuntimeAudioImportSchedulerTests;
+
+	FRuntimeAudioImportScheduler& Scheduler = FRuntimeAudioImportScheduler::Get();
+	if (!WaitForIdleScheduler(10.0))
+	{
+		AddError(TEXT("The import scheduler is busy with other imports"));
+		return false;
+	}
+
+	const int32 PreviousMaxConcurrentImports = Scheduler.GetMaxConcurrentImports();
+	const int64 PreviousMemoryBudget = Scheduler.GetMemoryBudget();
+
+	const int32 NumOfImports = 100;
+	const int32 OversizedImportIndex = 42;
+	const int64 MegaByte = 1024 * 1024;
+
+	const TSharedRef<FDrainState, ESPMode::ThreadSafe> State = MakeShared<FDrainState, ESPMode::ThreadSafe>();
+	State->MaxConcurrentImports = 4;
+	State->MemoryBudget = 8 * MegaByte;
+	Scheduler.SetMaxConcurrentImports(State->MaxConcurrentImports);
+	Scheduler.SetMemoryBudget(State->MemoryBudget);
+
+	// An import larger than the budget starts right away since nothing else is in flight, and holds back everything queued after it
+	Scheduler.EnqueueImport(ERuntimeImportPriority::High, 2 * State->MemoryBudget, nullptr, [State]()
+	{
+		while (!State->bReleaseGate)
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
+	}, TUniqueFunction<void()>());
+
+	TArray<FRuntimeAudioImportCancellationTokenPtr> CancellationTokens;
+	for (int32 ImportIndex = 0; ImportIndex < NumOfImports; ++ImportIndex)
+	{
+		const ERuntimeImportPriority Priority = static_cast<ERuntimeImportPriority>((ImportIndex * 7) % NumOfPriorities);
+		const int64 EstimatedMemory = ImportIndex == OversizedImportIndex ? 3 * State->MemoryBudget : (1 + ImportIndex % 3) * MegaByte;
+		const FRuntimeAudioImportCancellationTokenPtr CancellationToken = MakeShared<FRuntimeAudioImportCancellationToken, ESPMode::ThreadSafe>();
+		CancellationTokens.Add(CancellationToken);
+
+		Scheduler.EnqueueImport(Priority, EstimatedMemory, CancellationToken, [State, Priority, EstimatedMemory, CancellationToken]()
+		{
+			const FRuntimeAudioImportScheduler& ImportScheduler = FRuntimeAudioImportScheduler::Get();
+			if (CancellationToken->IsCancelled())
+			{
+				State->AddError(TEXT("A cancelled import was started"));
+			}
+
+			const int32 NumOfRunningImports = ImportScheduler.GetNumOfRunningImports();
+			if (NumOfRunningImports > State->MaxConcurrentImports)
+			{
+				State->AddError(FString::Printf(TEXT("%d imports running with a limit of %d"), NumOfRunningImports, State->MaxConcurrentImports));
+			}
+			int32 MaxNumOfRunningImports = State->MaxNumOfRunningImports.Load();
+			while (NumOfRunningImports > MaxNumOfRunningImports && !State->MaxNumOfRunningImports.CompareExchange(MaxNumOfRunningImports, NumOfRunningImports))
+			{
+			}
+
+			// Nothing else can start while an oversized import is in flight, and nothing else may be in flight when it starts
+			const int64 MemoryInFlight = ImportScheduler.GetMemoryInFlight();
+			if (EstimatedMemory > State->MemoryBudget ? MemoryInFlight != EstimatedMemory : MemoryInFlight > State->MemoryBudget)
+			{
+				State->AddError(FString::Printf(TEXT("%lld bytes in flight while running an import reserving %lld bytes with a budget of %lld bytes"), MemoryInFlight, EstimatedMemory, State->MemoryBudget));
+			}
+
+			// Every higher priority import was dequeued before this one, so those whose work has not started yet still hold one of the other running slots
+			const int32 PriorityIndex = static_cast<int32>(Priority);
+			for (int32 HigherPriorityIndex = 0; HigherPriorityIndex < PriorityIndex; ++HigherPriorityIndex)
+			{
+				const int32 NumOfPendingImports = State->NumOfExpectedImports[HigherPriorityIndex] - State->NumOfStartedImports[HigherPriorityIndex].Load();
+				if (NumOfPendingImports > State->MaxConcurrentImports - 1)
+				{
+					State->AddError(FString::Printf(TEXT("An import with priority %d started while %d imports with priority %d were still queued"), PriorityIndex, NumOfPendingImports, HigherPriorityIndex));
+				}
+			}
+			++State->NumOfStartedImports[PriorityIndex];
+
+			FPlatformProcess::Sleep(0.001f);
+		}, [State]()
+		{
+			++State->NumOfCancelledImports;
+		});
+	}
+
+	TestEqual(TEXT("Imports held back by the oversized import"), Scheduler.GetNumOfQueuedImports(), NumOfImports);
+
+	// Cancelling a tenth of the queued imports, which must be dropped without running
+	int32 NumOfCancelledImports = 0;
+	for (int32 ImportIndex = 0; ImportIndex < NumOfImports; ++ImportIndex)
+	{
+		const int32 PriorityIndex = (ImportIndex * 7) % NumOfPriorities;
+		if (ImportIndex % 10 == 3)
+		{
+			CancellationTokens[ImportIndex]->Cancel();
+			++NumOfCancelledImports;
+		}
+		else
+		{
+			++State->NumOfExpectedImports[PriorityIndex];
+		}
+	}
+
+	State->bReleaseGate = true;
+
+	bool bWithinConcurrencyLimit = true;
+	bool bWithinMemoryBudget = true;
+	const double StartTime = FPlatformTime::Seconds();
+	while (State->GetNumOfStartedImports() + State->NumOfCancelledImports.Load() < NumOfImports && FPlatformTime::Seconds() - StartTime < 60.0)
+	{
+		bWithinConcurrencyLimit &= Scheduler.GetNumOfRunningImports() <= State->MaxConcurrentImports;
+
+		// Only a single import, the gate or the oversized one, may exceed the budget on its own
+		const int64 MemoryInFlight = Scheduler.GetMemoryInFlight();
+		bWithinMemoryBudget &= MemoryInFlight <= State->MemoryBudget || MemoryInFlight == 2 * State->MemoryBudget || MemoryInFlight == 3 * State->MemoryBudget;
+
+		FPlatformProcess::Sleep(0.0005f);
+	}
+	const bool bIdle = WaitForIdleScheduler(10.0);
+
+	Scheduler.SetMaxConcurrentImports(PreviousMaxConcurrentImports);
+	Scheduler.SetMemoryBudget(PreviousMemoryBudget);
+
+	TestTrue(TEXT("Queue drained"), bIdle);
+	TestTrue(TEXT("Running imports within the concurrency limit"), bWithinConcurrencyLimit);
+	TestTrue(TEXT("Memory in flight within the budget"), bWithinMemoryBudget);
+	TestEqual(TEXT("Cancelled imports"), State->NumOfCancelledImports.Load(), NumOfCancelledImports);
+	TestEqual(TEXT("Started imports"), State->GetNumOfStartedImports(), NumOfImports - NumOfCancelledImports);
+	TestTrue(TEXT("Imports ran concurrently"), State->MaxNumOfRunningImports.Load() > 1);
+
+	FScopeLock Lock(&State->ErrorsCriticalSection);
+	for (const FString& Error : State->Errors)
+	{
+		AddError(Error);
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,158 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RuntimeAudioImporterTests
+{
+	/**
+	 * Counts the heap allocations made by the current thread while in scope
+	 * GMalloc is temporarily replaced by a forwarding proxy, allocations made by other threads are forwarded but not counted
+	 */
+	class FScopedAllocationCounter
+	{
+	public:
+		FScopedAllocationCounter()
+			: PreviousMalloc(GMalloc)
+		{
+			FCountingMalloc& CountingMalloc = GetCountingMalloc();
+			CountingMalloc.InnerMalloc = PreviousMalloc;
+			CountingMalloc.OwnerThreadId = FPlatformTLS::GetCurrentThreadId();
+			CountingMalloc.NumOfAllocations = 0;
+			FPlatformMisc::MemoryBarrier();
+			GMalloc = &CountingMalloc;
+		}
+
+		~FScopedAllocationCounter()
+		{
+			GMalloc = PreviousMalloc;
+			FPlatformMisc::MemoryBarrier();
+		}
+
+		/** The number of Malloc and Realloc calls made by the owning thread so far */
+		int32 GetNumOfAllocations() const
+		{
+			return GetCountingMalloc().NumOfAllocations;
+		}
+
+	private:
+		class FCountingMalloc : public FMalloc
+		{
+		public:
+			virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+			{
+				CountAllocation();
+				return InnerMalloc->Malloc(Count, Alignment);
+			}
+
+			virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+			{
+				CountAllocation();
+				return InnerMalloc->Realloc(Original, Count, Alignment);
+			}
+
+			virtual void Free(void* Original) override
+			{
+				InnerMalloc->Free(Original);
+			}
+
+			virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+			{
+				return InnerMalloc->GetAllocationSize(Original, SizeOut);
+			}
+
+			virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+			{
+				return InnerMalloc->QuantizeSize(Count, Alignment);
+			}
+
+			virtual const TCHAR* GetDescriptiveName() override
+			{
+				return TEXT("RuntimeAudioImporterCountingMalloc");
+			}
+
+			FMalloc* InnerMalloc = nullptr;
+			uint32 OwnerThreadId = 0;
+			int32 NumOfAllocations = 0;
+
+		private:
+			void CountAllocation()
+			{
+				if (FPlatformTLS::GetCurrentThreadId() == OwnerThreadId)
+				{
+					++NumOfAllocations;
+				}
+			}
+		};
+
+		/** Never destroyed, since other threads may still be inside it right after GMalloc has been restored */
+		static FCountingMalloc& GetCountingMalloc()
+		{
+			static FCountingMalloc* CountingMalloc = new FCountingMalloc();
+			return *CountingMalloc;
+		}
+
+		FMalloc* PreviousMalloc;
+	};
+
+	/**
+	 * Generates an interleaved test signal: a 220 Hz tone with a slightly detuned copy per channel and a bit of deterministic noise
+	 */
+	inline TArray<float> MakeTestSignal(int32 SampleRate, int32 NumOfChannels, int32 NumOfFrames, int32 Seed = 0)
+	{
+		FRandomStream RandomStream(Seed);
+		TArray<float> PCMData;
+		PCMData.SetNumUninitialized(NumOfFrames * NumOfChannels);
+		for (int32 FrameIndex = 0; FrameIndex < NumOfFrames; ++FrameIndex)
+		{
+			for (int32 ChannelIndex = 0; ChannelIndex < NumOfChannels; ++ChannelIndex)
+			{
+				const float Frequency = 220.f * (1.f + ChannelIndex * 0.01f);
+				PCMData[FrameIndex * NumOfChannels + ChannelIndex] = 0.5f * FMath::Sin(2.f * PI * Frequency * FrameIndex / SampleRate) + 0.05f * RandomStream.FRandRange(-1.f, 1.f);
+			}
+		}
+		return PCMData;
+	}
+
+	/**
+	 * Builds a 16-bit PCM WAV file holding MakeTestSignal
+	 */
+	inline TArray<uint8> MakeTestWAVData(int32 SampleRate, int32 NumOfChannels, int32 NumOfFrames, int32 Seed = 0)
+	{
+		const TArray<float> PCMData = MakeTestSignal(SampleRate, NumOfChannels, NumOfFrames, Seed);
+		const uint32 DataSize = PCMData.Num() * sizeof(int16);
+
+		TArray<uint8> WAVData;
+		WAVData.SetNumUninitialized(44 + DataSize);
+		uint8* Header = WAVData.GetData();
+		auto WriteUInt32 = [](uint8* Data, uint32 Value) { FMemory::Memcpy(Data, &Value, sizeof(Value)); };
+		auto WriteUInt16 = [](uint8* Data, uint16 Value) { FMemory::Memcpy(Data, &Value, sizeof(Value)); };
+
+		FMemory::Memcpy(Header, "RIFF", 4);
+		WriteUInt32(Header + 4, 36 + DataSize);
+		FMemory::Memcpy(Header + 8, "WAVEfmt ", 8);
+		WriteUInt32(Header + 16, 16);
+		WriteUInt16(Header + 20, 1);
+		WriteUInt16(Header + 22, NumOfChannels);
+		WriteUInt32(Header + 24, SampleRate);
+		WriteUInt32(Header + 28, SampleRate * NumOfChannels * sizeof(int16));
+		WriteUInt16(Header + 32, NumOfChannels * sizeof(int16));
+		WriteUInt16(Header + 34, 16);
+		FMemory::Memcpy(Header + 36, "data", 4);
+		WriteUInt32(Header + 40, DataSize);
+
+		int16* Samples = reinterpret_cast<int16*>(WAVData.GetData() + 44);
+		for (int32 SampleIndex = 0; SampleIndex < PCMData.Num(); ++SampleIndex)
+		{
+			Samples[SampleIndex] = static_cast<int16>(FMath::Clamp(FMath::RoundToInt(PCMData[SampleIndex] * 32767.f), -32768, 32767));
+		}
+		return WAVData;
+	}
+}
+
+#endif
@@ -0,0 +1,298 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+
+#include "RuntimeAudioImporterTestUtils.h"
+#include "RuntimeAudioImporterLibrary.h"
+#include "RuntimeAudioImporterDefines.h"
+#include "RuntimeAudioMappedFile.h"
+#include "Codecs/WAV_RuntimeCodec.h"
+#include "Sound/ImportedSoundWave.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+namespace RuntimeAudioMappedFileTests
+{
+	/** How long a latent step may wait for an import before the test fails */
+	constexpr double ImportTimeout = 300.0;
+
+	void WriteUInt32(TArray<uint8>& Data, int64 Offset, uint32 Value)
+	{
+		FMemory::Memcpy(Data.GetData() + Offset, &Value, sizeof(Value));
+	}
+
+	/**
+	 * Write a 16-bit stereo WAV file of the given number of frames, chunk by chunk, so that it is never held in memory as a whole
+	 */
+	bool WriteLargeWAVFile(const FString& FilePath, int32 SampleRate, int64 NumOfFrames)
+	{
+		const int32 NumOfChannels = 2;
+		const int32 NumOfFramesPerChunk = SampleRate;
+
+		// The header of a short file with the sizes patched for the full one
+		TArray<uint8> Header = RuntimeAudioImporterTests::MakeTestWAVData(SampleRate, NumOfChannels, 0);
+		const uint32 DataSize = static_cast<uint32>(NumOfFrames * NumOfChannels * sizeof(int16));
+		WriteUInt32(Header, 4, 36 + DataSize);
+		WriteUInt32(Header, 40, DataSize);
+
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Writer)
+		{
+			return false;
+		}
+		Writer->Serialize(Header.GetData(), Header.Num());
+
+		const TArray<uint8> Chunk = RuntimeAudioImporterTests::MakeTestWAVData(SampleRate, NumOfChannels, NumOfFramesPerChunk);
+		for (int64 Frame = 0; Frame < NumOfFrames; Frame += NumOfFramesPerChunk)
+		{
+			const int64 NumOfChunkFrames = FMath::Min<int64>(NumOfFramesPerChunk, NumOfFrames - Frame);
+			Writer->Serialize(const_cast<uint8*>(Chunk.GetData()) + 44, NumOfChunkFrames * NumOfChannels * sizeof(int16));
+		}
+		return Writer->Close();
+	}
+
+	enum class EImportMode : uint8
+	{
+		/** Played directly from the memory-mapped file */
+		MappedDirect,
+
+		/** Decoded in parallel ranges from the memory-mapped file */
+		MappedDecoded,
+
+		/** Loaded into memory as a whole and decoded from there, as imports worked before memory mapping */
+		Buffered
+	};
+
+	const TCHAR* LexToString(EImportMode ImportMode)
+	{
+		switch (ImportMode)
+		{
+		case EImportMode::MappedDirect:
+			return TEXT("mapped, played directly");
+		case EImportMode::MappedDecoded:
+			return TEXT("mapped, decoded");
+		default:
+			return TEXT("buffered");
+		}
+	}
+
+	/** The outcome of an import, with the peak physical memory used by the process while it ran */
+	struct FImportResult
+	{
+		ERuntimeImportStatus Status = ERuntimeImportStatus::FailedToReadAudioDataArray;
+		float Duration = 0.f;
+		double ElapsedTime = 0.0;
+		int64 PeakMemoryIncrease = 0;
+	};
+
+	/**
+	 * Returns a latent step that imports the file in the given mode, polls the physical memory used by the process on a background thread until the import finishes, then passes the result to OnFinished
+	 */
+	TFunction<bool()> MakeImportStep(FAutomationTestBase* Test, const FString& FilePath, EImportMode ImportMode, TFunction<void(const FImportResult&)> OnFinished)
+	{
+		struct FImportState
+		{
+			URuntimeAudioImporterLibrary* Importer = nullptr;
+			FImportResult Result;
+			bool bStarted = false;
+			bool bFinished = false;
+			double StartTime = 0.0;
+			uint64 BaselineUsedPhysical = 0;
+			TAtomic<uint64> PeakUsedPhysical {0};
+			TAtomic<bool> bSampling {false};
+			TFuture<void> Sampler;
+		};
+		const TSharedRef<FImportState, ESPMode::ThreadSafe> State = MakeShared<FImportState, ESPMode::ThreadSafe>();
+
+		return [Test, FilePath, ImportMode, OnFinished = MoveTemp(OnFinished), State]()
+		{
+			if (!State->bStarted)
+			{
+				State->bStarted = true;
+				State->Importer = URuntimeAudioImporterLibrary::CreateRuntimeAudioImporter();
+				State->Importer->AddToRoot();
+				State->Importer->bPlayWavFromMappedFile = ImportMode == EImportMode::MappedDirect;
+				State->Importer->OnResultNative.AddLambda([State](URuntimeAudioImporterLibrary*, UImportedSoundWave* ImportedSoundWave, ERuntimeImportStatus Status)
+				{
+					State->Result.Status = Status;
+					State->Result.Duration = ImportedSoundWave ? ImportedSoundWave->GetDurationConst() : 0.f;
+					State->Result.ElapsedTime = FPlatformTime::Seconds() - State->StartTime;
+					State->bFinished = true;
+				});
+
+				State->BaselineUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+				State->PeakUsedPhysical = State->BaselineUsedPhysical;
+				State->bSampling = true;
+				State->Sampler = Async(EAsyncExecution::Thread, [State]()
+				{
+					while (State->bSampling)
+					{
+						State->PeakUsedPhysical = FMath::Max<uint64>(State->PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+						FPlatformProcess::Sleep(0.001f);
+					}
+				});
+
+				State->StartTime = FPlatformTime::Seconds();
+				if (ImportMode == EImportMode::Buffered)
+				{
+					TArray64<uint8> AudioData;
+					RuntimeAudioImporter::LoadAudioFileToArray(AudioData, FilePath);
+					State->Importer->ImportAudioFromBuffer(MoveTemp(AudioData), ERuntimeAudioFormat::Wav);
+				}
+				else
+				{
+					State->Importer->ImportAudioFromFile(FilePath, ERuntimeAudioFormat::Wav);
+				}
+				return false;
+			}
+
+			const bool bTimedOut = !State->bFinished && FPlatformTime::Seconds() - State->StartTime > ImportTimeout;
+			if (!State->bFinished && !bTimedOut)
+			{
+				return false;
+			}
+
+			State->bSampling = false;
+			State->Sampler.Wait();
+			State->Result.PeakMemoryIncrease = static_cast<int64>(State->PeakUsedPhysical) - static_cast<int64>(State->BaselineUsedPhysical);
+			State->Importer->RemoveFromRoot();
+
+			if (bTimedOut)
+			{
+				Test->AddError(FString::Printf(TEXT("Timed out importing '%s' (%s)"), *FilePath, LexToString(ImportMode)));
+			}
+			else
+			{
+				OnFinished(State->Result);
+			}
+			return true;
+		};
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioMappedWavChunksTest, "RuntimeAudioImporter.MappedFile.WavChunks", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioMappedWavChunksTest::RunTest(const FString& Parameters)
+{
+	using namespace RuntimeAudioMappedFileTests;
+
+	const int32 NumOfFrames = 1000;
+	const TArray<uint8> WAVData = RuntimeAudioImporterTests::MakeTestWAVData(44100, 2, NumOfFrames);
+
+	FMappedPCMData MappedPCMData;
+	FRuntimeAudioHeaderInfo HeaderInfo;
+	if (TestTrue(TEXT("Plain WAV data can be played directly"), FWAV_RuntimeCodec::GetDirectPCMLayout(WAVData.GetData(), WAVData.Num(), MappedPCMData, HeaderInfo)))
+	{
+		TestEqual(TEXT("Offset of the plain sample data"), MappedPCMData.DataOffset, static_cast<int64>(44));
+		TestEqual(TEXT("Number of frames of the plain sample data"), MappedPCMData.NumOfFrames, static_cast<int64>(NumOfFrames));
+	}
+
+	// A LIST chunk before the sample data whose text holds "data" followed by what would be an unset size
+	TArray<uint8> ListWAVData(WAVData.GetData(), 36);
+	const uint8 ListChunk[] = {'L', 'I', 'S', 'T', 12, 0, 0, 0, 'I', 'N', 'F', 'O', 'd', 'a', 't', 'a', 0xFF, 0xFF, 0xFF, 0xFF};
+	ListWAVData.Append(ListChunk, UE_ARRAY_COUNT(ListChunk));
+	ListWAVData.Append(WAVData.GetData() + 36, WAVData.Num() - 36);
+	WriteUInt32(ListWAVData, 4, ListWAVData.Num() - 8);
+	if (TestTrue(TEXT("WAV data with \"data\" inside a LIST chunk can be played directly"), FWAV_RuntimeCodec::GetDirectPCMLayout(ListWAVData.GetData(), ListWAVData.Num(), MappedPCMData, HeaderInfo)))
+	{
+		TestEqual(TEXT("Offset of the sample data after the LIST chunk"), MappedPCMData.DataOffset, static_cast<int64>(44 + UE_ARRAY_COUNT(ListChunk)));
+		TestEqual(TEXT("Number of frames of the sample data after the LIST chunk"), MappedPCMData.NumOfFrames, static_cast<int64>(NumOfFrames));
+	}
+
+	// An unset data chunk size, as written by some streaming recorders, needs the duration fix-up of the buffered path
+	TArray<uint8> UnsetSizeWAVData = WAVData;
+	WriteUInt32(UnsetSizeWAVData, 40, MAX_uint32);
+	TestFalse(TEXT("WAV data with an unset data chunk size is not played directly"), FWAV_RuntimeCodec::GetDirectPCMLayout(UnsetSizeWAVData.GetData(), UnsetSizeWAVData.Num(), MappedPCMData, HeaderInfo));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioMappedPeakMemoryTest, "RuntimeAudioImporter.MappedFile.PeakMemory", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioMappedPeakMemoryTest::RunTest(const FString& Parameters)
+{
+	using namespace RuntimeAudioMappedFileTests;
+
+	// About 256 MB of 16-bit stereo audio
+	const int32 SampleRate = 44100;
+	const int64 NumOfFrames = static_cast<int64>(SampleRate) * 60 * 25;
+	const int64 FileSize = NumOfFrames * 2 * sizeof(int16);
+
+	const FString Directory = FPaths::AutomationTransientDir() / TEXT("MappedPeakMemory");
+	const FString FilePath = Directory / TEXT("Large.wav");
+	if (!TestTrue(TEXT("Large WAV file written"), WriteLargeWAVFile(FilePath, SampleRate, NumOfFrames)))
+	{
+		return false;
+	}
+
+	// Playing directly from the mapping keeps neither the encoded nor the decoded data in memory, only what the read-ahead pages in
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand(MakeImportStep(this, FilePath, EImportMode::MappedDirect, [this, SampleRate, NumOfFrames, FileSize](const FImportResult& Result)
+	{
+		TestTrue(TEXT("Imported successfully"), Result.Status == ERuntimeImportStatus::SuccessfulImport);
+		TestTrue(TEXT("Duration of the imported sound wave"), FMath::IsNearlyEqual(Result.Duration, static_cast<float>(NumOfFrames) / SampleRate, 0.01f));
+		AddInfo(FString::Printf(TEXT("Peak physical memory increase while importing %lld MB: %lld MB"), FileSize >> 20, Result.PeakMemoryIncrease >> 20));
+		TestTrue(FString::Printf(TEXT("Peak physical memory increase (%lld MB) stays below an eighth of the file size"), Result.PeakMemoryIncrease >> 20), Result.PeakMemoryIncrease < FileSize / 8);
+	})));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Directory]()
+	{
+		// Garbage collection releases the imported sound wave and with it the mapping, which has to go before the file can be deleted on some platforms
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		return true;
+	}));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioMappedImportBenchmarkTest, "RuntimeAudioImporter.MappedFile.ImportBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRuntimeAudioMappedImportBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RuntimeAudioMappedFileTests;
+
+	const int32 SampleRate = 44100;
+	const FString Directory = FPaths::AutomationTransientDir() / TEXT("MappedImportBenchmark");
+
+	// About 256 MB and 512 MB of 16-bit stereo audio
+	for (const int32 NumOfMinutes : {25, 50})
+	{
+		const int64 NumOfFrames = static_cast<int64>(SampleRate) * 60 * NumOfMinutes;
+		const int64 FileSize = NumOfFrames * 2 * sizeof(int16);
+		const FString FilePath = Directory / FString::Printf(TEXT("%dmin.wav"), NumOfMinutes);
+		if (!TestTrue(TEXT("Large WAV file written"), WriteLargeWAVFile(FilePath, SampleRate, NumOfFrames)))
+		{
+			return false;
+		}
+
+		for (const EImportMode ImportMode : {EImportMode::MappedDirect, EImportMode::MappedDecoded, EImportMode::Buffered})
+		{
+			ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand(MakeImportStep(this, FilePath, ImportMode, [this, ImportMode, FileSize](const FImportResult& Result)
+			{
+				TestTrue(FString::Printf(TEXT("Imported successfully (%s)"), LexToString(ImportMode)), Result.Status == ERuntimeImportStatus::SuccessfulImport);
+				AddInfo(FString::Printf(TEXT("%lld MB WAV, %s: imported in %.3f s, peak physical memory increase %lld MB"), FileSize >> 20, LexToString(ImportMode), Result.ElapsedTime, Result.PeakMemoryIncrease >> 20));
+			})));
+
+			// Releasing the previous sound wave so that the next import starts from the same baseline
+			ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([]()
+			{
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+				return true;
+			}));
+		}
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Directory]()
+	{
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		return true;
+	}));
+	return true;
+}
+
+#endif
@@ -0,0 +1,227 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+
+#include "RuntimeAudioImporterTestUtils.h"
+#include "RuntimeAudioTranscoder.h"
+#include "Algo/Count.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace RuntimeAudioTranscoderTests
+{
+	/** How long a latent step may wait for a batch before the test fails */
+	constexpr double BatchTimeout = 300.0;
+
+	FRuntimeAudioBatchTranscodeItem MakeRAWItem(const FString& FilePathTo, int32 NumOfChannels, int32 SampleRate)
+	{
+		FRuntimeAudioBatchTranscodeItem Item;
+		Item.bRAWFrom = true;
+		Item.RAWFormatFrom = ERuntimeRAWAudioFormat::Float32;
+		Item.NumOfChannelsFrom = NumOfChannels;
+		Item.SampleRateFrom = SampleRate;
+		Item.FilePathTo = FilePathTo;
+		return Item;
+	}
+
+	/** State shared by the latent steps of a batch test */
+	struct FBatchTestState
+	{
+		FString Directory;
+		TArray<bool> Results;
+		bool bFinished = false;
+		double StartTime = 0.0;
+		double ToRAWTime = 0.0;
+	};
+
+	/** Starts the batch and returns a latent step that waits for its results */
+	TFunction<bool()> RunBatch(FAutomationTestBase* Test, const TSharedRef<FBatchTestState>& State, TArray<FRuntimeAudioBatchTranscodeItem> Items, int32 MaxConcurrentItems)
+	{
+		State->bFinished = false;
+		State->StartTime = FPlatformTime::Seconds();
+		URuntimeAudioTranscoder::TranscodeBatch(MoveTemp(Items), MaxConcurrentItems, FOnBatchTranscodeResultNative::CreateLambda([State](const TArray<bool>& Results)
+		{
+			State->Results = Results;
+			State->bFinished = true;
+		}));
+
+		return [Test, State]()
+		{
+			if (!State->bFinished && FPlatformTime::Seconds() - State->StartTime > BatchTimeout)
+			{
+				Test->AddError(TEXT("Timed out waiting for the batch transcoding"));
+				return true;
+			}
+			return State->bFinished;
+		};
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioTranscoderBatchFailureTest, "RuntimeAudioImporter.Transcoder.BatchFailureCleanup", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioTranscoderBatchFailureTest::RunTest(const FString& Parameters)
+{
+	using namespace RuntimeAudioTranscoderTests;
+
+	const TSharedRef<FBatchTestState> State = MakeShared<FBatchTestState>();
+	State->Directory = FPaths::AutomationTransientDir() / TEXT("TranscoderBatchFailure");
+	IFileManager::Get().DeleteDirectory(*State->Directory, false, true);
+
+	const FString EmptyRAWFilePath = State->Directory / TEXT("Empty.raw");
+	FFileHelper::SaveArrayToFile(TArray<uint8>(), *EmptyRAWFilePath);
+
+	TArray<FRuntimeAudioBatchTranscodeItem> Items;
+
+	// An empty RAW buffer, streamed RAW to RAW
+	Items.Add(MakeRAWItem(State->Directory / TEXT("EmptyBuffer.raw"), 2, 44100));
+	Items.Last().bRAWTo = true;
+
+	// An empty RAW file, streamed RAW to RAW
+	Items.Add(MakeRAWItem(State->Directory / TEXT("EmptyFile.raw"), 2, 44100));
+	Items.Last().FilePathFrom = EmptyRAWFilePath;
+	Items.Last().bRAWTo = true;
+
+	// An empty RAW buffer, encoded to WAV
+	Items.Add(MakeRAWItem(State->Directory / TEXT("EmptyBuffer.wav"), 2, 44100));
+
+	// Garbage claiming to be WAV, which fails after the destination file has been opened
+	FRuntimeAudioBatchTranscodeItem& CorruptedItem = Items.AddDefaulted_GetRef();
+	CorruptedItem.DataFrom = {'R', 'I', 'F', 'F', 0xFF, 0xFF, 0xFF, 0xFF, 'W', 'A', 'V', 'E'};
+	CorruptedItem.EncodedFormatFrom = ERuntimeAudioFormat::Wav;
+	CorruptedItem.bRAWTo = true;
+	CorruptedItem.FilePathTo = State->Directory / TEXT("Corrupted.raw");
+
+	// A valid item in the same batch still succeeds
+	const TArray<float> PCMData = RuntimeAudioImporterTests::MakeTestSignal(44100, 2, 4410);
+	FRuntimeAudioBatchTranscodeItem& ValidItem = Items.Add_GetRef(MakeRAWItem(State->Directory / TEXT("Valid.raw"), 2, 44100));
+	ValidItem.DataFrom = TArray<uint8>(reinterpret_cast<const uint8*>(PCMData.GetData()), PCMData.Num() * sizeof(float));
+	ValidItem.bRAWTo = true;
+	ValidItem.RAWFormatTo = ERuntimeRAWAudioFormat::Int16;
+
+	TArray<FString> FilePathsTo;
+	for (const FRuntimeAudioBatchTranscodeItem& Item : Items)
+	{
+		FilePathsTo.Add(Item.FilePathTo);
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand(RunBatch(this, State, MoveTemp(Items), 0)));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, FilePathsTo]()
+	{
+		if (TestEqual(TEXT("Number of results"), State->Results.Num(), FilePathsTo.Num()))
+		{
+			for (int32 ItemIndex = 0; ItemIndex < FilePathsTo.Num() - 1; ++ItemIndex)
+			{
+				TestFalse(FString::Printf(TEXT("Item '%s' failed"), *FPaths::GetCleanFilename(FilePathsTo[ItemIndex])), State->Results[ItemIndex]);
+				TestFalse(FString::Printf(TEXT("No file is left behind for '%s'"), *FPaths::GetCleanFilename(FilePathsTo[ItemIndex])), IFileManager::Get().FileExists(*FilePathsTo[ItemIndex]));
+			}
+			TestTrue(TEXT("The valid item succeeded"), State->Results.Last());
+			TestEqual(TEXT("Size of the valid item's file"), IFileManager::Get().FileSize(*FilePathsTo.Last()), static_cast<int64>(4410 * 2 * sizeof(int16)));
+		}
+		IFileManager::Get().DeleteDirectory(*State->Directory, false, true);
+		return true;
+	}));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioTranscoderBatchBenchmarkTest, "RuntimeAudioImporter.Transcoder.BatchBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRuntimeAudioTranscoderBatchBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RuntimeAudioTranscoderTests;
+
+	// 200 WAV files of 3 seconds of 16-bit stereo audio
+	const int32 NumOfFiles = 200;
+	const int32 SampleRate = 44100;
+	const int32 NumOfChannels = 2;
+	const int32 NumOfFrames = SampleRate * 3;
+
+	const TSharedRef<FBatchTestState> State = MakeShared<FBatchTestState>();
+	State->Directory = FPaths::AutomationTransientDir() / TEXT("TranscoderBatchBenchmark");
+	IFileManager::Get().DeleteDirectory(*State->Directory, false, true);
+
+	for (int32 FileIndex = 0; FileIndex < NumOfFiles; ++FileIndex)
+	{
+		if (!FFileHelper::SaveArrayToFile(RuntimeAudioImporterTests::MakeTestWAVData(SampleRate, NumOfChannels, NumOfFrames, FileIndex), *(State->Directory / FString::Printf(TEXT("%03d.wav"), FileIndex))))
+		{
+			AddError(TEXT("Unable to write the test WAV files"));
+			return false;
+		}
+	}
+
+	// Converting WAV to RAW float and back, with an increasing number of items transcoded at once up to the number of worker threads
+	TArray<int32> ConcurrencyLevels;
+	const int32 NumOfWorkerThreads = FTaskGraphInterface::Get().GetNumWorkerThreads();
+	for (int32 ConcurrencyLevel = 1; ConcurrencyLevel < NumOfWorkerThreads; ConcurrencyLevel *= 2)
+	{
+		ConcurrencyLevels.Add(ConcurrencyLevel);
+	}
+	ConcurrencyLevels.Add(NumOfWorkerThreads);
+
+	const int64 TotalSize = static_cast<int64>(NumOfFiles) * NumOfFrames * NumOfChannels * (sizeof(int16) + sizeof(float));
+	for (const int32 ConcurrencyLevel : ConcurrencyLevels)
+	{
+		for (const bool bToRAW : {true, false})
+		{
+			ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, ConcurrencyLevel, bToRAW, NumOfFiles, NumOfChannels, SampleRate, TotalSize, WaitForBatch = TFunction<bool()>()]() mutable
+			{
+				if (!WaitForBatch)
+				{
+					TArray<FRuntimeAudioBatchTranscodeItem> Items;
+					for (int32 FileIndex = 0; FileIndex < NumOfFiles; ++FileIndex)
+					{
+						const FString WAVFilePath = State->Directory / FString::Printf(TEXT("%03d.wav"), FileIndex);
+						const FString RAWFilePath = State->Directory / FString::Printf(TEXT("%03d.raw"), FileIndex);
+						const FString RoundTripFilePath = State->Directory / FString::Printf(TEXT("%03d_roundtrip.wav"), FileIndex);
+
+						FRuntimeAudioBatchTranscodeItem Item = bToRAW ? FRuntimeAudioBatchTranscodeItem() : MakeRAWItem(RoundTripFilePath, NumOfChannels, SampleRate);
+						Item.FilePathFrom = bToRAW ? WAVFilePath : RAWFilePath;
+						if (bToRAW)
+						{
+							Item.EncodedFormatFrom = ERuntimeAudioFormat::Wav;
+							Item.bRAWTo = true;
+							Item.RAWFormatTo = ERuntimeRAWAudioFormat::Float32;
+							Item.FilePathTo = RAWFilePath;
+						}
+						Items.Add(MoveTemp(Item));
+					}
+					WaitForBatch = RunBatch(this, State, MoveTemp(Items), ConcurrencyLevel);
+					return false;
+				}
+
+				if (!WaitForBatch())
+				{
+					return false;
+				}
+
+				const double ElapsedTime = FPlatformTime::Seconds() - State->StartTime;
+				TestEqual(FString::Printf(TEXT("Transcoded files %s with %d concurrent items"), bToRAW ? TEXT("to RAW float") : TEXT("back to WAV"), ConcurrencyLevel), static_cast<int32>(Algo::Count(State->Results, true)), NumOfFiles);
+				if (bToRAW)
+				{
+					State->ToRAWTime = ElapsedTime;
+					return true;
+				}
+
+				// Each direction reads the data in one format and writes it in the other
+				AddInfo(FString::Printf(TEXT("%d concurrent item(s) on %d worker threads: WAV to RAW float %.2f s (%.1f files/s, %.0f MB/s), RAW float to WAV %.2f s (%.1f files/s, %.0f MB/s)"),
+					ConcurrencyLevel, FTaskGraphInterface::Get().GetNumWorkerThreads(),
+					State->ToRAWTime, NumOfFiles / State->ToRAWTime, TotalSize / State->ToRAWTime / (1024. * 1024.),
+					ElapsedTime, NumOfFiles / ElapsedTime, TotalSize / ElapsedTime / (1024. * 1024.)));
+				return true;
+			}));
+		}
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([State]()
+	{
+		IFileManager::Get().DeleteDirectory(*State->Directory, false, true);
+		return true;
+	}));
+	return true;
+}
+
+#endif
@@ -0,0 +1,208 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+
+#include "RuntimeAudioImporterTestUtils.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "VAD/RuntimeVoiceActivityDetector.h"
+#include "VAD/RuntimeVoiceActivityDetectorService.h"
+#include "HAL/PlatformTime.h"
+
+namespace FVAD_RuntimeAudioImporter
+{
+	/** The scalar reference, compiled along with the rest of libfvad in RuntimeVoiceActivityDetector.cpp */
+	int32_t WebRtcVad_GaussianProbability(int16_t input, int16_t mean, int16_t std, int16_t* delta);
+}
+
+namespace
+{
+	/**
+	 * Generates the blocks of a test stream, alternating between silence, faint noise and a loud signal every quarter of a second
+	 * so that both the low energy path and the GMM path of libfvad are taken
+	 */
+	TArray<TArray<float>> MakeTestStreamBlocks(int32 SampleRate, int32 NumOfChannels, int32 BlockNumOfFrames, int32 NumOfBlocks, int32 Seed)
+	{
+		const TArray<float> PCMData = RuntimeAudioImporterTests::MakeTestSignal(SampleRate, NumOfChannels, BlockNumOfFrames * NumOfBlocks, Seed);
+		const int32 BlocksPerSegment = FMath::Max(1, SampleRate / 4 / BlockNumOfFrames);
+
+		TArray<TArray<float>> Blocks;
+		Blocks.SetNum(NumOfBlocks);
+		for (int32 BlockIndex = 0; BlockIndex < NumOfBlocks; ++BlockIndex)
+		{
+			static constexpr float SegmentGains[] = {0.f, 0.01f, 1.f};
+			const float Gain = SegmentGains[(BlockIndex / BlocksPerSegment + Seed) % UE_ARRAY_COUNT(SegmentGains)];
+
+			Blocks[BlockIndex].SetNumUninitialized(BlockNumOfFrames * NumOfChannels);
+			for (int32 SampleIndex = 0; SampleIndex < BlockNumOfFrames * NumOfChannels; ++SampleIndex)
+			{
+				Blocks[BlockIndex][SampleIndex] = PCMData[BlockIndex * BlockNumOfFrames * NumOfChannels + SampleIndex] * Gain;
+			}
+		}
+		return Blocks;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeVADServiceGaussianKernelTest, "RuntimeAudioImporter.VAD.Service.GaussianKernel", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeVADServiceGaussianKernelTest::RunTest(const FString& Parameters)
+{
+	// Features, means and stds span the range libfvad keeps them in. An odd count covers the scalar tail as well
+	const int32 NumOfEvaluations = 1000003;
+	TArray<int32> Inputs, Means, Stds, Probabilities, Deltas;
+	Inputs.SetNumUninitialized(NumOfEvaluations);
+	Means.SetNumUninitialized(NumOfEvaluations);
+	Stds.SetNumUninitialized(NumOfEvaluations);
+	Probabilities.SetNumUninitialized(NumOfEvaluations);
+	Deltas.SetNumUninitialized(NumOfEvaluations);
+
+	FRandomStream RandomStream(0);
+	for (int32 Index = 0; Index < NumOfEvaluations; ++Index)
+	{
+		Inputs[Index] = RandomStream.RandRange(0, 2047);
+		Means[Index] = RandomStream.RandRange(0, 12000);
+		Stds[Index] = RandomStream.RandRange(378, 8191);
+	}
+
+	FRuntimeVoiceActivityDetectorService::EvaluateGaussianProbabilities(Inputs.GetData(), Means.GetData(), Stds.GetData(), Probabilities.GetData(), Deltas.GetData(), NumOfEvaluations);
+
+	for (int32 Index = 0; Index < NumOfEvaluations; ++Index)
+	{
+		int16_t ExpectedDelta;
+		const int32 ExpectedProbability = FVAD_RuntimeAudioImporter::WebRtcVad_GaussianProbability(Inputs[Index], Means[Index], Stds[Index], &ExpectedDelta);
+		if (Probabilities[Index] != ExpectedProbability || Deltas[Index] != ExpectedDelta)
+		{
+			AddError(FString::Printf(TEXT("Gaussian (input %d, mean %d, std %d) is %d with delta %d, expected %d with delta %d"),
+				Inputs[Index], Means[Index], Stds[Index], Probabilities[Index], Deltas[Index], ExpectedProbability, ExpectedDelta));
+			return false;
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeVADServiceEquivalenceTest, "RuntimeAudioImporter.VAD.Service.Equivalence", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeVADServiceEquivalenceTest::RunTest(const FString& Parameters)
+{
+	struct FEquivalenceCase
+	{
+		int32 SampleRate;
+		int32 NumOfChannels;
+		int32 BlockNumOfFrames;
+	};
+
+	// 10 ms blocks at a native and at a resampled rate, and 70 ms blocks holding several frames per stream
+	for (const FEquivalenceCase& Case : {FEquivalenceCase{48000, 2, 480}, FEquivalenceCase{44100, 1, 441}, FEquivalenceCase{16000, 1, 1120}})
+	{
+		const int32 NumOfStreams = 13;
+		const int32 NumOfBlocks = 200;
+
+		TSharedRef<FRuntimeVoiceActivityDetectorService, ESPMode::ThreadSafe> Service = MakeShared<FRuntimeVoiceActivityDetectorService, ESPMode::ThreadSafe>();
+		TArray<URuntimeVoiceActivityDetector*> Detectors;
+		TArray<TArray<TArray<float>>> StreamBlocks;
+		for (int32 StreamIndex = 0; StreamIndex < NumOfStreams; ++StreamIndex)
+		{
+			const ERuntimeVADMode Mode = static_cast<ERuntimeVADMode>(StreamIndex % 4);
+			TestEqual(TEXT("Stream handle"), Service->AddStream(Mode), StreamIndex);
+
+			URuntimeVoiceActivityDetector* Detector = NewObject<URuntimeVoiceActivityDetector>();
+			Detector->SetVADMode(Mode);
+			Detectors.Add(Detector);
+
+			StreamBlocks.Add(MakeTestStreamBlocks(Case.SampleRate, Case.NumOfChannels, Case.BlockNumOfFrames, NumOfBlocks, StreamIndex));
+		}
+
+		TArray<TArrayView<const float>> BlockViews;
+		TArray<bool> VoiceDetected;
+		int32 NumOfVoiceDecisions = 0;
+		for (int32 BlockIndex = 0; BlockIndex < NumOfBlocks; ++BlockIndex)
+		{
+			BlockViews.Reset();
+			for (int32 StreamIndex = 0; StreamIndex < NumOfStreams; ++StreamIndex)
+			{
+				BlockViews.Add(MakeArrayView(StreamBlocks[StreamIndex][BlockIndex]));
+			}
+			if (!TestTrue(TEXT("Block processed"), Service->ProcessBlock(BlockViews, Case.SampleRate, Case.NumOfChannels, VoiceDetected)))
+			{
+				return false;
+			}
+
+			for (int32 StreamIndex = 0; StreamIndex < NumOfStreams; ++StreamIndex)
+			{
+				const bool bExpectedVoiceDetected = Detectors[StreamIndex]->ProcessVAD(BlockViews[StreamIndex], Case.SampleRate, Case.NumOfChannels);
+				if (VoiceDetected[StreamIndex] != bExpectedVoiceDetected)
+				{
+					AddError(FString::Printf(TEXT("%d Hz: stream %d decided %d for block %d, the per-stream detector decided %d"), Case.SampleRate, StreamIndex, VoiceDetected[StreamIndex], BlockIndex, bExpectedVoiceDetected));
+					return false;
+				}
+				NumOfVoiceDecisions += bExpectedVoiceDetected ? 1 : 0;
+			}
+		}
+
+		// Both kinds of decisions must have been compared for the test to mean anything
+		TestTrue(FString::Printf(TEXT("%d Hz: voice detected in some blocks"), Case.SampleRate), NumOfVoiceDecisions > 0);
+		TestTrue(FString::Printf(TEXT("%d Hz: voice not detected in some blocks"), Case.SampleRate), NumOfVoiceDecisions < NumOfStreams * NumOfBlocks);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeVADServiceThroughputTest, "RuntimeAudioImporter.VAD.Service.Throughput", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRuntimeVADServiceThroughputTest::RunTest(const FString& Parameters)
+{
+	// Ten seconds of 48 kHz stereo audio per stream, fed in 10 ms blocks as a voice chat would, all on the calling thread
+	const int32 SampleRate = 48000;
+	const int32 NumOfChannels = 2;
+	const int32 BlockNumOfFrames = SampleRate / 100;
+	const int32 NumOfBlocks = 1000;
+	const double AudioSeconds = static_cast<double>(NumOfBlocks) * BlockNumOfFrames / SampleRate;
+
+	for (const int32 NumOfStreams : {8, 64})
+	{
+		TSharedRef<FRuntimeVoiceActivityDetectorService, ESPMode::ThreadSafe> Service = MakeShared<FRuntimeVoiceActivityDetectorService, ESPMode::ThreadSafe>();
+		TArray<URuntimeVoiceActivityDetector*> Detectors;
+		TArray<TArray<TArray<float>>> StreamBlocks;
+		for (int32 StreamIndex = 0; StreamIndex < NumOfStreams; ++StreamIndex)
+		{
+			Service->AddStream(ERuntimeVADMode::VeryAggressive);
+			Detectors.Add(NewObject<URuntimeVoiceActivityDetector>());
+			StreamBlocks.Add(MakeTestStreamBlocks(SampleRate, NumOfChannels, BlockNumOfFrames, NumOfBlocks, StreamIndex));
+		}
+
+		TArray<TArrayView<const float>> BlockViews;
+		TArray<bool> VoiceDetected;
+		const double ServiceStartTime = FPlatformTime::Seconds();
+		for (int32 BlockIndex = 0; BlockIndex < NumOfBlocks; ++BlockIndex)
+		{
+			BlockViews.Reset();
+			for (int32 StreamIndex = 0; StreamIndex < NumOfStreams; ++StreamIndex)
+			{
+				BlockViews.Add(MakeArrayView(StreamBlocks[StreamIndex][BlockIndex]));
+			}
+			Service->ProcessBlock(BlockViews, SampleRate, NumOfChannels, VoiceDetected);
+		}
+		const double ServiceElapsedTime = FPlatformTime::Seconds() - ServiceStartTime;
+
+		const double DetectorsStartTime = FPlatformTime::Seconds();
+		for (int32 BlockIndex = 0; BlockIndex < NumOfBlocks; ++BlockIndex)
+		{
+			for (int32 StreamIndex = 0; StreamIndex < NumOfStreams; ++StreamIndex)
+			{
+				Detectors[StreamIndex]->ProcessVAD(MakeArrayView(StreamBlocks[StreamIndex][BlockIndex]), SampleRate, NumOfChannels);
+			}
+		}
+		const double DetectorsElapsedTime = FPlatformTime::Seconds() - DetectorsStartTime;
+
+		// The number of real-time streams one core sustains
+		auto StreamsPerCore = [NumOfStreams, AudioSeconds](double ElapsedTime)
+		{
+			return ElapsedTime > 0 ? NumOfStreams * AudioSeconds / ElapsedTime : 0.0;
+		};
+		AddInfo(FString::Printf(TEXT("%d streams: service %.2f ms (%.0f streams per core), per-stream detectors %.2f ms (%.0f streams per core)"),
+			NumOfStreams, ServiceElapsedTime * 1000.0, StreamsPerCore(ServiceElapsedTime), DetectorsElapsedTime * 1000.0, StreamsPerCore(DetectorsElapsedTime)));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,96 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+
+#include "RuntimeAudioImporterTestUtils.h"
+#include "VAD/RuntimeVADFrameStager.h"
+#include "VAD/RuntimeVoiceActivityDetector.h"
+#include "HAL/PlatformTime.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeVADAllocationFreeTest, "RuntimeAudioImporter.VAD.AllocationFree", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeVADAllocationFreeTest::RunTest(const FString& Parameters)
+{
+	URuntimeVoiceActivityDetector* VAD = NewObject<URuntimeVoiceActivityDetector>();
+
+	// 10 ms blocks, which do not line up with the 30 ms frames, both at a native and at a resampled rate
+	const TArray<float> NativePCMData = RuntimeAudioImporterTests::MakeTestSignal(48000, 2, 480);
+	const TArray<float> ResampledPCMData = RuntimeAudioImporterTests::MakeTestSignal(44100, 2, 441);
+
+	for (const TPair<const TArray<float>*, int32>& Block : {MakeTuple(&ResampledPCMData, 44100), MakeTuple(&NativePCMData, 48000)})
+	{
+		// Switching the sample rate may log, so do it before counting
+		VAD->ProcessVAD(MakeArrayView(*Block.Key), Block.Value, 2);
+
+		int32 NumOfAllocations = 0;
+		{
+			RuntimeAudioImporterTests::FScopedAllocationCounter AllocationCounter;
+			for (int32 BlockIndex = 0; BlockIndex < 100; ++BlockIndex)
+			{
+				VAD->ProcessVAD(MakeArrayView(*Block.Key), Block.Value, 2);
+			}
+			NumOfAllocations = AllocationCounter.GetNumOfAllocations();
+		}
+		TestEqual(FString::Printf(TEXT("Heap allocations while processing VAD at %d Hz"), Block.Value), NumOfAllocations, 0);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeVADStereoMixTest, "RuntimeAudioImporter.VAD.StereoMix", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeVADStereoMixTest::RunTest(const FString& Parameters)
+{
+	// An odd number of frames covers both the SIMD loop and the scalar tail
+	const int32 NumOfFrames = 1023;
+	const TArray<float> PCMData = RuntimeAudioImporterTests::MakeTestSignal(48000, 2, NumOfFrames);
+
+	TArray<float> MonoData;
+	MonoData.SetNumZeroed(NumOfFrames);
+	FRuntimeVADFrameStager::MixBlockToMono(PCMData.GetData(), MonoData.GetData(), NumOfFrames, 2, 0.5f);
+
+	for (int32 FrameIndex = 0; FrameIndex < NumOfFrames; ++FrameIndex)
+	{
+		const float Expected = (PCMData[FrameIndex * 2] + PCMData[FrameIndex * 2 + 1]) * 0.5f;
+		if (MonoData[FrameIndex] != Expected)
+		{
+			AddError(FString::Printf(TEXT("Mono sample %d is %f, expected %f"), FrameIndex, MonoData[FrameIndex], Expected));
+			return false;
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeVADThroughputTest, "RuntimeAudioImporter.VAD.Throughput", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRuntimeVADThroughputTest::RunTest(const FString& Parameters)
+{
+	URuntimeVoiceActivityDetector* VAD = NewObject<URuntimeVoiceActivityDetector>();
+
+	struct FThroughputCase
+	{
+		int32 SampleRate;
+		int32 NumOfChannels;
+	};
+
+	// Ten seconds of audio, fed in 10 ms blocks as a capture device would
+	for (const FThroughputCase& Case : {FThroughputCase{48000, 1}, FThroughputCase{48000, 2}, FThroughputCase{44100, 2}})
+	{
+		const int32 BlockNumOfFrames = Case.SampleRate / 100;
+		const TArray<float> PCMData = RuntimeAudioImporterTests::MakeTestSignal(Case.SampleRate, Case.NumOfChannels, Case.SampleRate * 10);
+
+		VAD->ResetVAD();
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 FrameIndex = 0; FrameIndex + BlockNumOfFrames <= PCMData.Num() / Case.NumOfChannels; FrameIndex += BlockNumOfFrames)
+		{
+			VAD->ProcessVAD(MakeArrayView(PCMData.GetData() + FrameIndex * Case.NumOfChannels, BlockNumOfFrames * Case.NumOfChannels), Case.SampleRate, Case.NumOfChannels);
+		}
+		const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+		AddInfo(FString::Printf(TEXT("%d Hz, %d channel(s): 10 s of audio processed in %.2f ms (%.0fx real time)"), Case.SampleRate, Case.NumOfChannels, ElapsedTime * 1000.0, ElapsedTime > 0 ? 10.0 / ElapsedTime : 0.0));
+	}
+	return true;
+}
+
+#endif
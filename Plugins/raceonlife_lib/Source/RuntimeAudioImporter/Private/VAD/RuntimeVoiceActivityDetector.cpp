@@ -6,7 +6,6 @@
 #include "RuntimeAudioImporterTypes.h"
 #include "VADIncludes.h"
 #include "HAL/UnrealMemory.h"
-#include "Codecs/RAW_RuntimeCodec.h"
 #if !UE_VERSION_OLDER_THAN(5, 1, 0)
 #include "DSP/FloatArrayMath.h"
 #endif
@@ -17,6 +16,10 @@ URuntimeVoiceActivityDetector::URuntimeVoiceActivityDetector()
 	  , VADInstance(nullptr)
 #endif
 {
+	// Preallocate the frame buffers so that processing never allocates
+	StagedPCMData.SetNumZeroed(FRuntimeVADFrameStager::MaxFrameNumOfSamples);
+	Int16FrameData.SetNumZeroed(FRuntimeVADFrameStager::MaxFrameNumOfSamples);
+
 #if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
 	VADInstance = FVAD_RuntimeAudioImporter::fvad_new();
 	if (VADInstance)
@@ -59,6 +62,7 @@ bool URuntimeVoiceActivityDetector::ResetVAD()
 	FVAD_RuntimeAudioImporter::fvad_reset(VADInstance);
 	SetVADMode(ERuntimeVADMode::VeryAggressive);
 	AppliedSampleRate = 0;
+	FrameStager.Reset();
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully reset VAD for %s"), *GetName());
 	return true;
 #else
@@ -88,7 +92,28 @@ bool URuntimeVoiceActivityDetector::SetVADMode(ERuntimeVADMode Mode)
 #endif
 }
 
-bool URuntimeVoiceActivityDetector::ProcessVAD(TArray<float> PCMData, int32 InSampleRate, int32 NumOfChannels)
+int32 URuntimeVoiceActivityDetector::ProcessStagedFrame(int32 NumOfSamples)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+	FRuntimeVADFrameStager::ConvertToPcm16(StagedPCMData.GetData(), Int16FrameData.GetData(), NumOfSamples);
+
+	const int32 VADResult = FVAD_RuntimeAudioImporter::fvad_process(VADInstance, Int16FrameData.GetData(), NumOfSamples);
+	if (VADResult < 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process VAD for %s due to %d error code"), *GetName(), VADResult);
+	}
+	return VADResult;
+#else
+	return -1;
+#endif
+}
+
+bool URuntimeVoiceActivityDetector::ProcessVAD(const TArray<float>& PCMData, int32 InSampleRate, int32 NumOfChannels)
+{
+	return ProcessVAD(MakeArrayView(PCMData), InSampleRate, NumOfChannels);
+}
+
+bool URuntimeVoiceActivityDetector::ProcessVAD(TArrayView<const float> PCMData, int32 InSampleRate, int32 NumOfChannels)
 {
 #if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
 	if (!VADInstance)
@@ -106,126 +131,47 @@ bool URuntimeVoiceActivityDetector::ProcessVAD(TArray<float> PCMData, int32 InSa
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process VAD for %s as the sample rate is invalid"), *GetName());
 		return false;
 	}
-	if (NumOfChannels <= 0)
+	if (NumOfChannels <= 0 || PCMData.Num() < NumOfChannels)
 	{
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process VAD for %s as the number of channels is invalid"), *GetName());
 		return false;
 	}
 
-	Audio::FAlignedFloatBuffer AlignedPCMData;
-	AlignedPCMData = MoveTemp(PCMData);
-
-	// Mix channels if necessary (VAD only supports mono audio data)
-	if (NumOfChannels > 1)
-	{
-		Audio::FAlignedFloatBuffer AlignedPCMData_Mixed;
-		if (!FRAW_RuntimeCodec::MixChannelsRAWData(AlignedPCMData, InSampleRate, NumOfChannels, 1, AlignedPCMData_Mixed))
-		{
-			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to mix audio data for %s"), *GetName());
-			return false;
-		}
-		AlignedPCMData = MoveTemp(AlignedPCMData_Mixed);
-	}
-
-	// Resample the audio data if necessary (VAD only supports 8 kHz audio data)
-	static constexpr int32 VADTargetSampleRate = 8000;
-	if (InSampleRate != VADTargetSampleRate)
-	{
-		Audio::FAlignedFloatBuffer AlignedPCMData_Resampled;
-		if (!FRAW_RuntimeCodec::ResampleRAWData(AlignedPCMData, 1, InSampleRate, VADTargetSampleRate, AlignedPCMData_Resampled))
-		{
-			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to resample audio data for %s"), *GetName());
-			return false;
-		}
-
-		AlignedPCMData = MoveTemp(AlignedPCMData_Resampled);
-		InSampleRate = VADTargetSampleRate;
-		UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("Successfully resampled audio data for %s to %d sample rate"), *GetName(), VADTargetSampleRate);
-	}
-
 	// Apply the sample rate to the VAD instance if it is different from the current sample rate
-	if (AppliedSampleRate != InSampleRate)
+	const int32 VADSampleRate = FRuntimeVADFrameStager::GetVADSampleRate(InSampleRate);
+	if (AppliedSampleRate != VADSampleRate)
 	{
-		if (FVAD_RuntimeAudioImporter::fvad_set_sample_rate(VADInstance, InSampleRate) != 0)
+		if (FVAD_RuntimeAudioImporter::fvad_set_sample_rate(VADInstance, VADSampleRate) != 0)
 		{
 			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to set VAD sample rate for %s"), *GetName());
 			return false;
 		}
-		AppliedSampleRate = InSampleRate;
+		AppliedSampleRate = VADSampleRate;
 		UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("Successfully set VAD sample rate for %s to %d"), *GetName(), AppliedSampleRate);
 	}
-	
-	// Convert float PCM data to int16 PCM data
-	TArray<int16> Int16PCMData;
-	{
-#if UE_VERSION_OLDER_THAN(5, 1, 0)
-		int16* Int16PCMDataPtr;
-		FRAW_RuntimeCodec::TranscodeRAWData<float, int16>(AlignedPCMData.GetData(), AlignedPCMData.Num(), Int16PCMDataPtr);
-		Int16PCMData.Append(Int16PCMDataPtr, AlignedPCMData.Num());
-		FMemory::Free(Int16PCMDataPtr);
-#else
-		Int16PCMData.AddUninitialized(AlignedPCMData.Num());
-		Audio::ArrayFloatToPcm16(MakeArrayView(AlignedPCMData), MakeArrayView(Int16PCMData));
-#endif
-	}
-
-	// Append the new PCM data to the accumulated data
-	AccumulatedPCMData.Append(MoveTemp(Int16PCMData));
-
-	// Calculate the length of the accumulated audio data in milliseconds
-	float AudioDataLengthMs = static_cast<float>(AccumulatedPCMData.Num()) / static_cast<float>(AppliedSampleRate) * 1000;
 
-	// Process the accumulated audio data if it reaches 10, 20, or 30 ms (VAD only supports these frame lengths)
-	if (AudioDataLengthMs >= 10)
+	// Mix to mono and resample in a single pass, processing every full 30 ms frame as soon as it is staged
+	bool bVoiceDetected = false;
+	const int32 NumOfProcessedFrames = FrameStager.Stage(PCMData, InSampleRate, NumOfChannels, AppliedSampleRate, StagedPCMData.GetData(), [this, &bVoiceDetected](int32 FrameNumOfSamples)
 	{
-		int32 ValidLength = [this, AudioDataLengthMs]()
-		{
-			if (AudioDataLengthMs >= 30)
-			{
-				return 30;
-			}
-			else if (AudioDataLengthMs >= 20)
-			{
-				return 20;
-			}
-			else if (AudioDataLengthMs >= 10)
-			{
-				return 10;
-			}
-			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process VAD for %s as the audio data length is invalid"), *GetName());
-			return 0;
-		}();
-
-		// Calculate the number of samples to process
-		int32 NumToProcess = ValidLength * AppliedSampleRate / 1000;
-
-		// Process the VAD
-		int32 VADResult = FVAD_RuntimeAudioImporter::fvad_process(VADInstance, AccumulatedPCMData.GetData(), NumToProcess);
+		bVoiceDetected |= ProcessStagedFrame(FrameNumOfSamples) == 1;
+	});
 
-		// Remove processed data from the accumulated buffer
-		AccumulatedPCMData.RemoveAt(0, NumToProcess);
-
-		if (VADResult == 1)
-		{
-			UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("VAD detected voice activity for %s"), *GetName());
-			return true;
-		}
-		else if (VADResult == 0)
-		{
-			UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("VAD detected no voice activity for %s"), *GetName());
-			return false;
-		}
-		else
+	// If the provided data was too short to fill a 30 ms frame, process a 20 or 10 ms frame if possible to keep the latency low
+	if (NumOfProcessedFrames == 0)
+	{
+		const int32 PartialFrameNumOfSamples = FrameStager.GetPartialFrameNumOfSamples(AppliedSampleRate);
+		if (PartialFrameNumOfSamples == 0)
 		{
-			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process VAD for %s due to %d error code"), *GetName(), VADResult);
+			UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("Accumulating audio data until it reaches 10, 20 or 30 ms for %s. Current number of staged samples: %d"), *GetName(), FrameStager.NumOfStagedSamples);
 			return false;
 		}
+		bVoiceDetected = ProcessStagedFrame(PartialFrameNumOfSamples) == 1;
+		FrameStager.ConsumePartialFrame(StagedPCMData.GetData(), PartialFrameNumOfSamples);
 	}
-	else
-	{
-		UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("Accumulating audio data until it reaches 10, 20 or 30 ms for %s. Current length: %f ms"), *GetName(), AudioDataLengthMs);
-		return false;
-	}
+
+	UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("VAD detected %s for %s"), bVoiceDetected ? TEXT("voice activity") : TEXT("no voice activity"), *GetName());
+	return bVoiceDetected;
 #else
 	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process VAD for %s as VAD support is disabled"), *GetName());
 	return false;
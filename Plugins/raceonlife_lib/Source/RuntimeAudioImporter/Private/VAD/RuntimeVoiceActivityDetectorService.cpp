@@ -0,0 +1,405 @@
+﻿// Georgy Treshchev 2024.
+
+#include "VAD/RuntimeVoiceActivityDetectorService.h"
+
+#include "RuntimeAudioImporterDefines.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Async/Async.h"
+#include "Misc/EngineVersionComparison.h"
+
+#if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+THIRD_PARTY_INCLUDES_START
+namespace FVAD_RuntimeAudioImporter
+{
+#include "fvad.h"
+}
+THIRD_PARTY_INCLUDES_END
+#endif
+
+namespace
+{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	using FVADVectorRegisterInt = VectorRegisterInt;
+#else
+	using FVADVectorRegisterInt = VectorRegister4Int;
+#endif
+	using FVADVectorRegister = FRuntimeVADFrameStager::FVADVectorRegister;
+
+	/**
+	 * Scalar WebRtcVad_GaussianProbability, used for the evaluations not filling a whole SIMD register
+	 */
+	int32 EvaluateGaussianProbability(int16 Input, int16 Mean, int16 Std, int32& OutDelta)
+	{
+		const int16 InvStd = static_cast<int16>((131072 + (Std >> 1)) / Std);
+		const int16 InvStdQ8 = static_cast<int16>(InvStd >> 2);
+		const int16 InvStd2 = static_cast<int16>((InvStdQ8 * InvStdQ8) >> 2);
+		const int16 Difference = static_cast<int16>(static_cast<int16>(Input << 3) - Mean);
+		const int16 Delta = static_cast<int16>((InvStd2 * Difference) >> 10);
+		const int32 Exponent = (Delta * Difference) >> 9;
+		OutDelta = Delta;
+
+		int16 ExpValue = 0;
+		if (Exponent < 22005)
+		{
+			int16 Log2Exponent = static_cast<int16>(-static_cast<int16>((5909 * Exponent) >> 12));
+			ExpValue = static_cast<int16>(0x0400 | (Log2Exponent & 0x03FF));
+			Log2Exponent = static_cast<int16>(Log2Exponent ^ 0xFFFF);
+			ExpValue >>= ((Log2Exponent >> 10) + 1) & 31;
+		}
+		return InvStd * ExpValue;
+	}
+
+	/**
+	 * Sign-extends the low 16 bits of each lane, which reproduces the int16_t truncations of the scalar implementation
+	 */
+	FORCEINLINE FVADVectorRegisterInt SignExtend16(const FVADVectorRegisterInt& Value)
+	{
+		return VectorShiftRightImmArithmetic(VectorShiftLeftImm(Value, 16), 16);
+	}
+}
+
+FRuntimeVoiceActivityDetectorService::FRuntimeVoiceActivityDetectorService()
+{
+	Int16FrameData.SetNumZeroed(FRuntimeVADFrameStager::MaxFrameNumOfSamples);
+}
+
+FRuntimeVoiceActivityDetectorService::~FRuntimeVoiceActivityDetectorService()
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+	for (FVAD_RuntimeAudioImporter::Fvad* VADInstance : VADInstances)
+	{
+		if (VADInstance)
+		{
+			FVAD_RuntimeAudioImporter::fvad_free(VADInstance);
+		}
+	}
+#endif
+}
+
+int32 FRuntimeVoiceActivityDetectorService::AddStream(ERuntimeVADMode Mode)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+	FVAD_RuntimeAudioImporter::Fvad* VADInstance = FVAD_RuntimeAudioImporter::fvad_new();
+	if (!VADInstance)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to add VAD stream as the VAD instance could not be created"));
+		return INDEX_NONE;
+	}
+	if (FVAD_RuntimeAudioImporter::fvad_set_mode(VADInstance, VoiceActivityDetector::GetVADModeInt(Mode)) != 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to add VAD stream as the mode is invalid"));
+		FVAD_RuntimeAudioImporter::fvad_free(VADInstance);
+		return INDEX_NONE;
+	}
+
+	FRAIScopeLock Lock(&DataGuard);
+
+	int32 StreamHandle;
+	if (FreeStreamHandles.Num() > 0)
+	{
+		StreamHandle = FreeStreamHandles.Pop();
+		VADInstances[StreamHandle] = VADInstance;
+		AppliedSampleRates[StreamHandle] = 0;
+		FrameStagers[StreamHandle].Reset();
+	}
+	else
+	{
+		StreamHandle = VADInstances.Add(VADInstance);
+		AppliedSampleRates.Add(0);
+		FrameStagers.AddDefaulted();
+		StagedPCMData.AddZeroed(FRuntimeVADFrameStager::MaxFrameNumOfSamples);
+
+		QueuedStreamHandles.Reserve(VADInstances.Num());
+		QueuedFrameIndices.Add(INDEX_NONE);
+		for (TArray<int32>* GaussianData : {&GaussianInputs, &GaussianMeans, &GaussianStds, &GaussianProbabilities, &GaussianDeltas})
+		{
+			GaussianData->AddZeroed(FVAD_RuntimeAudioImporter::FVAD_NUM_GAUSSIANS_PER_FRAME);
+		}
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully added VAD stream %d"), StreamHandle);
+	return StreamHandle;
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to add VAD stream as VAD support is disabled"));
+	return INDEX_NONE;
+#endif
+}
+
+void FRuntimeVoiceActivityDetectorService::RemoveStream(int32 StreamHandle)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+	FRAIScopeLock Lock(&DataGuard);
+	if (!VADInstances.IsValidIndex(StreamHandle) || !VADInstances[StreamHandle])
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to remove VAD stream %d as it does not exist"), StreamHandle);
+		return;
+	}
+
+	FVAD_RuntimeAudioImporter::fvad_free(VADInstances[StreamHandle]);
+	VADInstances[StreamHandle] = nullptr;
+	FreeStreamHandles.Add(StreamHandle);
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully removed VAD stream %d"), StreamHandle);
+#endif
+}
+
+bool FRuntimeVoiceActivityDetectorService::ResetStream(int32 StreamHandle)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+	FRAIScopeLock Lock(&DataGuard);
+	if (!VADInstances.IsValidIndex(StreamHandle) || !VADInstances[StreamHandle])
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to reset VAD stream %d as it does not exist"), StreamHandle);
+		return false;
+	}
+
+	FVAD_RuntimeAudioImporter::fvad_reset(VADInstances[StreamHandle]);
+	FVAD_RuntimeAudioImporter::fvad_set_mode(VADInstances[StreamHandle], VoiceActivityDetector::GetVADModeInt(ERuntimeVADMode::VeryAggressive));
+	AppliedSampleRates[StreamHandle] = 0;
+	FrameStagers[StreamHandle].Reset();
+	return true;
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to reset VAD stream as VAD support is disabled"));
+	return false;
+#endif
+}
+
+bool FRuntimeVoiceActivityDetectorService::SetStreamMode(int32 StreamHandle, ERuntimeVADMode Mode)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+	FRAIScopeLock Lock(&DataGuard);
+	if (!VADInstances.IsValidIndex(StreamHandle) || !VADInstances[StreamHandle])
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to set VAD mode for stream %d as it does not exist"), StreamHandle);
+		return false;
+	}
+	if (FVAD_RuntimeAudioImporter::fvad_set_mode(VADInstances[StreamHandle], VoiceActivityDetector::GetVADModeInt(Mode)) != 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to set VAD mode for stream %d as the mode is invalid"), StreamHandle);
+		return false;
+	}
+	return true;
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to set VAD mode as VAD support is disabled"));
+	return false;
+#endif
+}
+
+int32 FRuntimeVoiceActivityDetectorService::GetNumOfStreamSlots() const
+{
+	FRAIScopeLock Lock(&DataGuard);
+	return FrameStagers.Num();
+}
+
+void FRuntimeVoiceActivityDetectorService::EvaluateGaussianProbabilities(const int32* Inputs, const int32* Means, const int32* Stds, int32* OutProbabilities, int32* OutDeltas, int32 NumOfEvaluations)
+{
+	const FVADVectorRegisterInt Zero = VectorIntSet1(0);
+	const FVADVectorRegisterInt One = VectorIntSet1(1);
+	const FVADVectorRegisterInt Q17One = VectorIntSet1(131072);
+	const FVADVectorRegisterInt CompVar = VectorIntSet1(22005);
+	const FVADVectorRegisterInt Log2Exp = VectorIntSet1(5909);
+	const FVADVectorRegisterInt ExpImplicitBit = VectorIntSet1(0x0400);
+	const FVADVectorRegisterInt ExpMantissaMask = VectorIntSet1(0x03FF);
+	const FVADVectorRegisterInt Low16Mask = VectorIntSet1(0xFFFF);
+	const FVADVectorRegisterInt ShiftMask = VectorIntSet1(31);
+	const FVADVectorRegisterInt FloatExponentBias = VectorIntSet1(127);
+
+	int32 Index = 0;
+	for (; Index + 4 <= NumOfEvaluations; Index += 4)
+	{
+		const FVADVectorRegisterInt Input = VectorIntLoad(Inputs + Index);
+		const FVADVectorRegisterInt Mean = VectorIntLoad(Means + Index);
+		const FVADVectorRegisterInt Std = VectorIntLoad(Stds + Index);
+
+		// 1 / s in Q10, rounded. The float quotient is off by at most one from the truncated integer one, and gets corrected using the remainder
+		const FVADVectorRegisterInt Numerator = VectorIntAdd(Q17One, VectorShiftRightImmArithmetic(Std, 1));
+		FVADVectorRegisterInt InvStd = VectorFloatToInt(VectorDivide(VectorIntToFloat(Numerator), VectorIntToFloat(Std)));
+		const FVADVectorRegisterInt Remainder = VectorIntSubtract(Numerator, VectorIntMultiply(InvStd, Std));
+		// Comparison masks are -1 where true
+		InvStd = VectorIntSubtract(InvStd, VectorIntCompareGE(Remainder, Std));
+		InvStd = VectorIntAdd(InvStd, VectorIntCompareLT(Remainder, Zero));
+		InvStd = SignExtend16(InvStd);
+
+		// 1 / s^2 in Q14
+		const FVADVectorRegisterInt InvStdQ8 = VectorShiftRightImmArithmetic(InvStd, 2);
+		const FVADVectorRegisterInt InvStd2 = SignExtend16(VectorShiftRightImmArithmetic(VectorIntMultiply(InvStdQ8, InvStdQ8), 2));
+
+		// x - m in Q7, (x - m) / s^2 in Q11 and (x - m)^2 / (2 * s^2) in Q10
+		const FVADVectorRegisterInt Difference = SignExtend16(VectorIntSubtract(SignExtend16(VectorShiftLeftImm(Input, 3)), Mean));
+		const FVADVectorRegisterInt Delta = SignExtend16(VectorShiftRightImmArithmetic(VectorIntMultiply(InvStd2, Difference), 10));
+		const FVADVectorRegisterInt Exponent = VectorShiftRightImmArithmetic(VectorIntMultiply(Delta, Difference), 9);
+
+		// Lanes with a too large exponent get a zero probability, the values computed for them below are discarded
+		const FVADVectorRegisterInt NonZeroMask = VectorIntCompareLT(Exponent, CompVar);
+
+		// exp2(-log2(exp(1)) * exponent) in Q10, as an 11-bit mantissa shifted right by the integer part
+		// The shift is within [0, 31] for any input within the model's range, it is masked to five bits like the x86 shift instruction for the rest
+		const FVADVectorRegisterInt Log2Exponent = SignExtend16(VectorIntSubtract(Zero, SignExtend16(VectorShiftRightImmArithmetic(VectorIntMultiply(Log2Exp, Exponent), 12))));
+		const FVADVectorRegisterInt ExpMantissa = VectorIntOr(ExpImplicitBit, VectorIntAnd(Log2Exponent, ExpMantissaMask));
+		const FVADVectorRegisterInt ExpShift = VectorIntAnd(VectorIntAdd(VectorShiftRightImmArithmetic(SignExtend16(VectorIntXor(Log2Exponent, Low16Mask)), 10), One), ShiftMask);
+
+		// There is no per-lane variable shift, so the mantissa is scaled by 2^-shift in float, which is exact, and truncated
+		const FVADVectorRegister ExpScale = VectorCastIntToFloat(VectorShiftLeftImm(VectorIntSubtract(FloatExponentBias, ExpShift), 23));
+		const FVADVectorRegisterInt ExpValue = VectorIntAnd(VectorFloatToInt(VectorMultiply(VectorIntToFloat(ExpMantissa), ExpScale)), NonZeroMask);
+
+		VectorIntStore(VectorIntMultiply(InvStd, ExpValue), OutProbabilities + Index);
+		VectorIntStore(Delta, OutDeltas + Index);
+	}
+
+	for (; Index < NumOfEvaluations; ++Index)
+	{
+		OutProbabilities[Index] = EvaluateGaussianProbability(static_cast<int16>(Inputs[Index]), static_cast<int16>(Means[Index]), static_cast<int16>(Stds[Index]), OutDeltas[Index]);
+	}
+}
+
+void FRuntimeVoiceActivityDetectorService::QueueStagedFrame(int32 StreamHandle, int32 NumOfSamples, TArray<bool>& OutVoiceDetected)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+	// The decision of the previous frame updates the models whose parameters the GMM of this frame is evaluated with
+	if (QueuedFrameIndices[StreamHandle] != INDEX_NONE)
+	{
+		FlushQueuedFrames(OutVoiceDetected);
+	}
+
+	const float* StreamStagedData = StagedPCMData.GetData() + StreamHandle * FRuntimeVADFrameStager::MaxFrameNumOfSamples;
+	FRuntimeVADFrameStager::ConvertToPcm16(StreamStagedData, Int16FrameData.GetData(), NumOfSamples);
+
+	const int32 QueuedFrameIndex = QueuedStreamHandles.Num();
+	const int32 GaussianOffset = QueuedFrameIndex * FVAD_RuntimeAudioImporter::FVAD_NUM_GAUSSIANS_PER_FRAME;
+	const int32 FeaturesResult = FVAD_RuntimeAudioImporter::fvad_process_features(VADInstances[StreamHandle], Int16FrameData.GetData(), NumOfSamples,
+		GaussianInputs.GetData() + GaussianOffset, GaussianMeans.GetData() + GaussianOffset, GaussianStds.GetData() + GaussianOffset);
+	if (FeaturesResult < 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process VAD for stream %d due to %d error code"), StreamHandle, FeaturesResult);
+		return;
+	}
+
+	// Frames too quiet for the GMM are decided right away
+	if (FeaturesResult == 0)
+	{
+		OutVoiceDetected[StreamHandle] |= FVAD_RuntimeAudioImporter::fvad_process_decision(VADInstances[StreamHandle], nullptr, nullptr) == 1;
+		return;
+	}
+
+	QueuedStreamHandles.Add(StreamHandle);
+	QueuedFrameIndices[StreamHandle] = QueuedFrameIndex;
+#endif
+}
+
+void FRuntimeVoiceActivityDetectorService::FlushQueuedFrames(TArray<bool>& OutVoiceDetected)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+	if (QueuedStreamHandles.Num() == 0)
+	{
+		return;
+	}
+
+	EvaluateGaussianProbabilities(GaussianInputs.GetData(), GaussianMeans.GetData(), GaussianStds.GetData(), GaussianProbabilities.GetData(), GaussianDeltas.GetData(),
+		QueuedStreamHandles.Num() * FVAD_RuntimeAudioImporter::FVAD_NUM_GAUSSIANS_PER_FRAME);
+
+	for (int32 QueuedFrameIndex = 0; QueuedFrameIndex < QueuedStreamHandles.Num(); ++QueuedFrameIndex)
+	{
+		const int32 StreamHandle = QueuedStreamHandles[QueuedFrameIndex];
+		const int32 GaussianOffset = QueuedFrameIndex * FVAD_RuntimeAudioImporter::FVAD_NUM_GAUSSIANS_PER_FRAME;
+		OutVoiceDetected[StreamHandle] |= FVAD_RuntimeAudioImporter::fvad_process_decision(VADInstances[StreamHandle], GaussianProbabilities.GetData() + GaussianOffset, GaussianDeltas.GetData() + GaussianOffset) == 1;
+		QueuedFrameIndices[StreamHandle] = INDEX_NONE;
+	}
+	QueuedStreamHandles.Reset();
+#endif
+}
+
+bool FRuntimeVoiceActivityDetectorService::ProcessBlock(TArrayView<const TArrayView<const float>> StreamPCMData, int32 InSampleRate, int32 NumOfChannels, TArray<bool>& OutVoiceDetected)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+	if (InSampleRate <= 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process VAD block as the sample rate is invalid"));
+		return false;
+	}
+	if (NumOfChannels <= 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process VAD block as the number of channels is invalid"));
+		return false;
+	}
+
+	FRAIScopeLock Lock(&DataGuard);
+
+	const int32 NumOfStreams = FMath::Min(StreamPCMData.Num(), VADInstances.Num());
+	OutVoiceDetected.Reset(VADInstances.Num());
+	OutVoiceDetected.AddZeroed(VADInstances.Num());
+
+	const int32 VADSampleRate = FRuntimeVADFrameStager::GetVADSampleRate(InSampleRate);
+
+	for (int32 StreamHandle = 0; StreamHandle < NumOfStreams; ++StreamHandle)
+	{
+		const TArrayView<const float>& PCMData = StreamPCMData[StreamHandle];
+		if (!VADInstances[StreamHandle] || PCMData.Num() < NumOfChannels)
+		{
+			continue;
+		}
+
+		if (AppliedSampleRates[StreamHandle] != VADSampleRate)
+		{
+			if (FVAD_RuntimeAudioImporter::fvad_set_sample_rate(VADInstances[StreamHandle], VADSampleRate) != 0)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to set VAD sample rate for stream %d"), StreamHandle);
+				continue;
+			}
+			AppliedSampleRates[StreamHandle] = VADSampleRate;
+		}
+
+		FRuntimeVADFrameStager& FrameStager = FrameStagers[StreamHandle];
+		float* StreamStagedData = StagedPCMData.GetData() + StreamHandle * FRuntimeVADFrameStager::MaxFrameNumOfSamples;
+
+		const int32 NumOfProcessedFrames = FrameStager.Stage(PCMData, InSampleRate, NumOfChannels, VADSampleRate, StreamStagedData, [this, StreamHandle, &OutVoiceDetected](int32 FrameNumOfSamples)
+		{
+			QueueStagedFrame(StreamHandle, FrameNumOfSamples, OutVoiceDetected);
+		});
+
+		// Same partial frame handling as URuntimeVoiceActivityDetector::ProcessVAD to keep the decisions identical
+		if (NumOfProcessedFrames == 0)
+		{
+			const int32 PartialFrameNumOfSamples = FrameStager.GetPartialFrameNumOfSamples(VADSampleRate);
+			if (PartialFrameNumOfSamples > 0)
+			{
+				QueueStagedFrame(StreamHandle, PartialFrameNumOfSamples, OutVoiceDetected);
+				FrameStager.ConsumePartialFrame(StreamStagedData, PartialFrameNumOfSamples);
+			}
+		}
+	}
+
+	// The frames of all streams are queued by now, their GMMs are evaluated together
+	FlushQueuedFrames(OutVoiceDetected);
+
+	return true;
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process VAD block as VAD support is disabled"));
+	return false;
+#endif
+}
+
+void FRuntimeVoiceActivityDetectorService::ProcessBlockAsync(TArray<TArray<float>> StreamPCMData, int32 InSampleRate, int32 NumOfChannels, const FOnVADBlockProcessedNative& Result)
+{
+	AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [WeakThis = TWeakPtr<FRuntimeVoiceActivityDetectorService, ESPMode::ThreadSafe>(AsShared()), StreamPCMData = MoveTemp(StreamPCMData), InSampleRate, NumOfChannels, Result]() mutable
+	{
+		TArray<bool> VoiceDetected;
+		if (TSharedPtr<FRuntimeVoiceActivityDetectorService, ESPMode::ThreadSafe> PinnedThis = WeakThis.Pin())
+		{
+			TArray<TArrayView<const float>> StreamPCMDataViews;
+			StreamPCMDataViews.Reserve(StreamPCMData.Num());
+			for (const TArray<float>& PCMData : StreamPCMData)
+			{
+				StreamPCMDataViews.Add(MakeArrayView(PCMData));
+			}
+			PinnedThis->ProcessBlock(StreamPCMDataViews, InSampleRate, NumOfChannels, VoiceDetected);
+		}
+		else
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process VAD block as the VAD service has been destroyed"));
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [Result, VoiceDetected = MoveTemp(VoiceDetected)]()
+		{
+			Result.ExecuteIfBound(VoiceDetected);
+		});
+	});
+}
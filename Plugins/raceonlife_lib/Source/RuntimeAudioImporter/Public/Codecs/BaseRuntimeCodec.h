@@ -37,6 +37,23 @@ public:
 	 */
 	virtual bool Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData) PURE_VIRTUAL(FBaseRuntimeCodec::Decode, return false;)
 
+	/**
+	 * Check that the encoded audio data can be decoded in independent ranges of frames and retrieve its header information
+	 * Codecs that can seek to an arbitrary frame should override this together with DecodeRange, so that large inputs can be decoded in parallel segments
+	 * The audio data is only read, so it can also reside in a read-only memory-mapped file
+	 *
+	 * @return True if the codec supports range decoding and the audio data can be decoded in place
+	 */
+	virtual bool PrepareRangeDecode(const uint8* AudioData, int64 AudioDataSize, FRuntimeAudioHeaderInfo& HeaderInfo) { return false; }
+
+	/**
+	 * Decode a range of frames into interleaved 32-bit float PCM data
+	 * Can be called concurrently for different ranges of the same audio data once PrepareRangeDecode has succeeded
+	 *
+	 * @return The number of decoded frames
+	 */
+	virtual int64 DecodeRange(const uint8* AudioData, int64 AudioDataSize, int64 StartFrame, int64 NumOfFrames, float* OutPCMData) { return 0; }
+
 	/**
 	 * Retrieve the format applicable to this codec
 	 */
@@ -13,6 +13,8 @@ public:
 	virtual bool GetHeaderInfo(FEncodedAudioStruct EncodedData, FRuntimeAudioHeaderInfo& HeaderInfo) override;
 	virtual bool Encode(FDecodedAudioStruct DecodedData, FEncodedAudioStruct& EncodedData, uint8 Quality) override;
 	virtual bool Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData) override;
+	virtual bool PrepareRangeDecode(const uint8* AudioData, int64 AudioDataSize, FRuntimeAudioHeaderInfo& HeaderInfo) override;
+	virtual int64 DecodeRange(const uint8* AudioData, int64 AudioDataSize, int64 StartFrame, int64 NumOfFrames, float* OutPCMData) override;
 	virtual ERuntimeAudioFormat GetAudioFormat() const override { return ERuntimeAudioFormat::Flac; }
 	virtual bool IsExtensionSupported(const FString& Extension) const override { return Extension.Equals(TEXT("flac"), ESearchCase::IgnoreCase); }
 	//~ End FBaseRuntimeCodec Interface
@@ -0,0 +1,149 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+
+template <typename DataType>
+class FRuntimeBulkDataBuffer;
+
+/**
+ * Interleaved PCM data compressed with FPCMBlock_RuntimeCodec
+ * The data is split into blocks of NumOfFramesPerBlock frames that can be decoded independently, which allows decoding just the blocks needed for playback
+ */
+struct RUNTIMEAUDIOIMPORTER_API FCompressedPCMData
+{
+	/** Number of frames per block. The last block may contain fewer frames */
+	static constexpr int32 NumOfFramesPerBlock = 4096;
+
+	FCompressedPCMData()
+		: NumOfChannels(0)
+		, NumOfFrames(0)
+	{}
+
+	/** Returns the number of blocks */
+	int32 GetNumOfBlocks() const
+	{
+		return FMath::Max(BlockOffsets.Num() - 1, 0);
+	}
+
+	/** Returns the number of frames in the given block */
+	int32 GetNumOfFramesInBlock(int32 BlockIndex) const
+	{
+		return static_cast<int32>(FMath::Min<int64>(NumOfFramesPerBlock, NumOfFrames - static_cast<int64>(BlockIndex) * NumOfFramesPerBlock));
+	}
+
+	/** Returns the size of the compressed data, in bytes */
+	int64 GetAllocatedSize() const
+	{
+		return Data.GetAllocatedSize() + BlockOffsets.GetAllocatedSize();
+	}
+
+	/** Number of interleaved channels */
+	int32 NumOfChannels;
+
+	/** Total number of frames */
+	int64 NumOfFrames;
+
+	/** Offset of each block in Data, followed by the end offset of the last block */
+	TArray<int64> BlockOffsets;
+
+	/** Encoded blocks */
+	TArray64<uint8> Data;
+};
+
+using FCompressedPCMDataPtr = TSharedPtr<const FCompressedPCMData, ESPMode::ThreadSafe>;
+
+/**
+ * Lossless block codec for in-memory 32-bit float PCM data
+ * Blocks whose samples are exactly representable as 16-bit or 24-bit integers (e.g. decoded from WAV or FLAC) are coded FLAC-style,
+ * with a fixed polynomial predictor per channel and Rice coded residuals. Other blocks (e.g. decoded from MP3 or Vorbis) are stored verbatim,
+ * unless quantization to 16-bit is requested
+ * Decoding is sample-exact: the decoded floats are bit-identical to the original ones
+ */
+class RUNTIMEAUDIOIMPORTER_API FPCMBlock_RuntimeCodec
+{
+public:
+	/**
+	 * Compress interleaved 32-bit float PCM data
+	 *
+	 * @param PCMData The interleaved PCM data to compress
+	 * @param NumOfSamples The number of samples in PCMData
+	 * @param NumOfChannels The number of channels
+	 * @param bQuantizeTo16Bit Whether to quantize the samples to 16-bit before compression. Makes the compression lossy but effective for any source
+	 * @return The compressed data, or null if the data could not be compressed
+	 */
+	static FCompressedPCMDataPtr Compress(const float* PCMData, int64 NumOfSamples, int32 NumOfChannels, bool bQuantizeTo16Bit);
+
+	/**
+	 * Decode a single block
+	 *
+	 * @param CompressedData The compressed data
+	 * @param BlockIndex The index of the block to decode
+	 * @param OutPCMData Receives the interleaved PCM data of the block. Must have room for NumOfFramesInBlock * NumOfChannels samples
+	 * @param ChannelScratch Scratch buffer for the integer samples of a channel. Grown to NumOfFramesPerBlock on first use, so reusing it keeps decoding allocation-free
+	 * @return True if the block was successfully decoded
+	 */
+	static bool DecodeBlock(const FCompressedPCMData& CompressedData, int32 BlockIndex, float* OutPCMData, TArray<int32>& ChannelScratch);
+
+	/**
+	 * Decode all blocks
+	 *
+	 * @param CompressedData The compressed data
+	 * @param OutPCMData Receives the interleaved PCM data
+	 * @return True if the data was successfully decoded
+	 */
+	static bool Decompress(const FCompressedPCMData& CompressedData, FRuntimeBulkDataBuffer<float>& OutPCMData);
+};
+
+/**
+ * Small LRU cache of decoded blocks, used to decode compressed PCM data just in time for playback
+ * Consecutive playback callbacks mostly hit the block decoded by a previous callback, so only one block is decoded every NumOfFramesPerBlock frames
+ * Not thread-safe, guard it with the lock protecting the compressed data
+ */
+class RUNTIMEAUDIOIMPORTER_API FPCMBlockCache
+{
+public:
+	explicit FPCMBlockCache(int32 InMaxNumOfBlocks = 4);
+
+	/**
+	 * Copy frames from the compressed data, decoding the blocks that are not cached
+	 *
+	 * @param CompressedData The compressed data. The cache is reset if it differs from the data cached blocks were decoded from
+	 * @param StartFrame The first frame to copy
+	 * @param NumOfFrames The number of frames to copy
+	 * @param OutPCMData Receives the interleaved PCM data. Must have room for NumOfFrames * NumOfChannels samples
+	 * @return The number of frames copied
+	 */
+	int64 CopyFrames(const FCompressedPCMDataPtr& CompressedData, int64 StartFrame, int64 NumOfFrames, float* OutPCMData);
+
+	/** Drops all cached blocks */
+	void Reset();
+
+private:
+	/** Returns the decoded block, decoding it into the least recently used slot if it is not cached */
+	const float* GetBlock(int32 BlockIndex);
+
+	struct FCachedBlock
+	{
+		int32 BlockIndex;
+		uint64 LastUseTick;
+		TArray<float> PCMData;
+	};
+
+	/** Cached blocks */
+	TArray<FCachedBlock> Blocks;
+
+	/** Maximum number of cached blocks */
+	int32 MaxNumOfBlocks;
+
+	/** Scratch buffer passed to DecodeBlock, kept per cache so that decoding on the audio thread neither allocates nor uses a large stack frame */
+	TArray<int32> ChannelScratch;
+
+	/** Incremented on every block access, used to find the least recently used block */
+	uint64 UseTick;
+
+	/** The compressed data the cached blocks were decoded from. Referenced so that it cannot be replaced by other data at the same address */
+	FCompressedPCMDataPtr CachedData;
+};
@@ -100,6 +100,19 @@ public:
 		/** Creating an empty PCM buffer */
 		RAWDataTo = static_cast<IntegralTypeTo*>(FMemory::Malloc(NumOfSamples * sizeof(IntegralTypeTo)));
 
+		TranscodeRAWDataToBuffer<IntegralTypeFrom, IntegralTypeTo>(RAWDataFrom, NumOfSamples, RAWDataTo);
+	}
+
+	/**
+	 * Transcoding one RAW Data format to another into an already allocated buffer
+	 *
+	 * @param RAWDataFrom Pointer to memory location of the RAW data for transcoding
+	 * @param NumOfSamples Number of samples in the RAW data
+	 * @param RAWDataTo Pointer to memory location for the transcoded RAW data with the specified format. Must be able to hold NumOfSamples samples
+	 */
+	template <typename IntegralTypeFrom, typename IntegralTypeTo>
+	static void TranscodeRAWDataToBuffer(const IntegralTypeFrom* RAWDataFrom, int64 NumOfSamples, IntegralTypeTo* RAWDataTo)
+	{
 		const TTuple<long long, long long> MinAndMaxValuesFrom{GetRawMinAndMaxValues<IntegralTypeFrom>()};
 		const TTuple<long long, long long> MinAndMaxValuesTo{GetRawMinAndMaxValues<IntegralTypeTo>()};
 
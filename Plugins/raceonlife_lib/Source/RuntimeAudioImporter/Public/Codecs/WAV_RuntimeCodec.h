@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "BaseRuntimeCodec.h"
 
+struct FMappedPCMData;
+
 class RUNTIMEAUDIOIMPORTER_API FWAV_RuntimeCodec : public FBaseRuntimeCodec
 {
 public:
@@ -13,6 +15,8 @@ public:
 	virtual bool GetHeaderInfo(FEncodedAudioStruct EncodedData, FRuntimeAudioHeaderInfo& HeaderInfo) override;
 	virtual bool Encode(FDecodedAudioStruct DecodedData, FEncodedAudioStruct& EncodedData, uint8 Quality) override;
 	virtual bool Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData) override;
+	virtual bool PrepareRangeDecode(const uint8* AudioData, int64 AudioDataSize, FRuntimeAudioHeaderInfo& HeaderInfo) override;
+	virtual int64 DecodeRange(const uint8* AudioData, int64 AudioDataSize, int64 StartFrame, int64 NumOfFrames, float* OutPCMData) override;
 	virtual ERuntimeAudioFormat GetAudioFormat() const override { return ERuntimeAudioFormat::Wav; }
 	virtual bool IsExtensionSupported(const FString& Extension) const override
 	{
@@ -20,4 +24,16 @@ public:
 		|| Extension.Equals(TEXT("wave"), ESearchCase::IgnoreCase);
 	}
 	//~ End FBaseRuntimeCodec Interface
+
+	/**
+	 * Retrieve the location of the sample data if it can be played directly from the encoded data without decoding
+	 * This is the case for 16-bit integer and 32-bit float PCM data in a little-endian container
+	 *
+	 * @param AudioData The encoded audio data
+	 * @param AudioDataSize The size of the encoded audio data, in bytes
+	 * @param MappedPCMData The layout of the sample data. The mapped file is left unset
+	 * @param HeaderInfo The header information of the audio data
+	 * @return True if the sample data can be played directly
+	 */
+	static bool GetDirectPCMLayout(const uint8* AudioData, int64 AudioDataSize, FMappedPCMData& MappedPCMData, FRuntimeAudioHeaderInfo& HeaderInfo);
 };
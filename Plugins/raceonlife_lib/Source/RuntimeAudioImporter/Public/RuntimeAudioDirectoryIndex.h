@@ -0,0 +1,102 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAudioImporterTypes.h"
+
+/**
+ * Runtime Audio Directory Index
+ * Persistent index of the audio files found while scanning directories, keyed by file path and validated by file size and modification time
+ * Rescanning a directory only reads the headers of new or modified files, and directories are enumerated in parallel
+ * Changes are appended to the persisted index as records, which is rewritten only once the outdated records outnumber the live ones
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeAudioDirectoryIndex
+{
+public:
+	/**
+	 * @param InIndexFilePath The path to the file the index is persisted to
+	 */
+	explicit FRuntimeAudioDirectoryIndex(const FString& InIndexFilePath);
+
+	/** Returns the index shared by all scans, persisted to the project's Saved directory */
+	static FRuntimeAudioDirectoryIndex& Get();
+
+	/**
+	 * Bring the index up to date with the directory and retrieve the audio files in it
+	 * New or modified files have their headers read, files that no longer exist are dropped from the index
+	 * Blocks until the directory has been scanned, so it should be called from a background thread
+	 *
+	 * @param Directory The directory to scan
+	 * @param bRecursive Whether to scan subdirectories as well
+	 * @param OutEntries The indexed audio files in the directory, sorted by path
+	 * @return True if the directory was scanned successfully
+	 */
+	bool Scan(const FString& Directory, bool bRecursive, TArray<FRuntimeAudioIndexEntry>& OutEntries);
+
+	/**
+	 * Retrieve the audio files in the directory as of the last scan, without accessing the file system
+	 *
+	 * @param Directory The directory to query
+	 * @param bRecursive Whether to include the files in subdirectories as well
+	 * @return The indexed audio files in the directory, sorted by path
+	 */
+	TArray<FRuntimeAudioIndexEntry> Query(const FString& Directory, bool bRecursive);
+
+	/** Drop all entries and delete the persisted index */
+	void Clear();
+
+	/** Returns the path to the file the index is persisted to */
+	const FString& GetIndexFilePath() const
+	{
+		return IndexFilePath;
+	}
+
+private:
+	/** Loads the persisted index if it has not been loaded yet. Should only be used if CriticalSection is locked */
+	void Load_Internal();
+
+	/**
+	 * Appends the changes to the persisted index, or rewrites it if it has accumulated too many outdated records. Should only be used if CriticalSection is locked
+	 *
+	 * @param UpdatedEntries The entries that were added or modified
+	 * @param RemovedFilePaths The paths of the entries that were removed
+	 */
+	void Save_Internal(const TArray<FRuntimeAudioIndexEntry>& UpdatedEntries, const TArray<FString>& RemovedFilePaths);
+
+	/** Rewrites the persisted index from the current entries. Should only be used if CriticalSection is locked */
+	void Compact_Internal();
+
+	/** Collects the entries located in the directory. Should only be used if CriticalSection is locked */
+	void CollectEntries_Internal(const FString& Directory, bool bRecursive, TArray<FRuntimeAudioIndexEntry>& OutEntries) const;
+
+	/** Returns the directory in the form used for the index keys (absolute, without trailing slash) */
+	static FString NormalizeDirectory(const FString& Directory);
+
+	/** Whether the file is located in the directory, or in one of its subdirectories if bRecursive is true */
+	static bool IsInDirectory(const FString& FilePath, const FString& Directory, bool bRecursive);
+
+	/** Reads the header information and the ID3 tags of the audio file into the entry */
+	static void ReadEntryInfo(FRuntimeAudioIndexEntry& Entry);
+
+	/** Reads the header information of the audio file */
+	static bool ReadHeaderInfo(const FString& FilePath, FRuntimeAudioHeaderInfo& HeaderInfo);
+
+	/** Path to the file the index is persisted to */
+	FString IndexFilePath;
+
+	/** Indexed audio files, keyed by file path */
+	TMap<FString, FRuntimeAudioIndexEntry> Entries;
+
+	/** Number of records in the persisted index, including the ones outdated by later records */
+	int32 NumOfPersistedRecords;
+
+	/** Whether the persisted index has to be rewritten before anything can be appended to it (e.g. it is missing or its tail is damaged) */
+	bool bCompactionRequired;
+
+	/** Whether the persisted index has been loaded */
+	bool bLoaded;
+
+	/** Guards the entries */
+	FCriticalSection CriticalSection;
+};
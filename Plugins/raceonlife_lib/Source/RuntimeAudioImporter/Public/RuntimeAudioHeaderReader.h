@@ -0,0 +1,33 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FRuntimeAudioHeaderInfo;
+
+/**
+ * Reads audio file metadata straight from the file, without loading or decoding the audio data
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeAudioHeaderReader
+{
+public:
+	/**
+	 * Read the duration, sample rate and number of channels of an MP3 file from its first frame header and Xing/Info or VBRI header
+	 * Only the tag headers and the first few kilobytes of audio are read from disk
+	 *
+	 * @param FilePath The path to the MP3 file
+	 * @param HeaderInfo The header information of the file
+	 * @return True if a valid frame header was found
+	 */
+	static bool ReadMP3HeaderInfo(const FString& FilePath, FRuntimeAudioHeaderInfo& HeaderInfo);
+
+	/**
+	 * Read the title and artist from the ID3v2 or ID3v1 tags of the file. Only the tag bytes are read from disk
+	 *
+	 * @param FilePath The path to the audio file
+	 * @param OutTitle The title, left unchanged if the file has none
+	 * @param OutArtist The artist, left unchanged if the file has none
+	 */
+	static void ReadID3Tags(const FString& FilePath, FString& OutTitle, FString& OutArtist);
+};
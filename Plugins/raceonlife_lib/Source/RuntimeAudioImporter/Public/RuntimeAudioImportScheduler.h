@@ -0,0 +1,175 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/Function.h"
+#include "Templates/Atomic.h"
+
+enum class ERuntimeImportPriority : uint8;
+
+/**
+ * Cancellation token shared between an import request and the scheduler
+ * Cancelling a queued import drops it before it starts, cancelling a running import stops it at the next stage boundary
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeAudioImportCancellationToken
+{
+public:
+	FRuntimeAudioImportCancellationToken()
+		: bCancelled(false)
+	{
+	}
+
+	/** Requests cancellation of all imports sharing this token */
+	void Cancel()
+	{
+		bCancelled = true;
+	}
+
+	/** Whether cancellation has been requested */
+	bool IsCancelled() const
+	{
+		return bCancelled;
+	}
+
+private:
+	FThreadSafeBool bCancelled;
+};
+
+using FRuntimeAudioImportCancellationTokenPtr = TSharedPtr<FRuntimeAudioImportCancellationToken, ESPMode::ThreadSafe>;
+
+/**
+ * A single import scheduled by FRuntimeAudioImportScheduler
+ * Holds the memory reserved for the import until the last reference to it is released, which allows the reservation to outlive
+ * the worker task while the decoded data is handed over to the game thread
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeAudioImportJob : public TSharedFromThis<FRuntimeAudioImportJob, ESPMode::ThreadSafe>
+{
+public:
+	FRuntimeAudioImportJob(ERuntimeImportPriority InPriority, int64 InReservedMemory, FRuntimeAudioImportCancellationTokenPtr InCancellationToken, TUniqueFunction<void()>&& InWork, TUniqueFunction<void()>&& InOnCancelled);
+	~FRuntimeAudioImportJob();
+
+	/** Whether the import has been cancelled */
+	bool IsCancelled() const;
+
+	/**
+	 * Replaces the amount of memory reserved for the import, e.g. once the actual size of the decoded PCM data is known
+	 *
+	 * @param NewReservedMemory The new amount of memory, in bytes
+	 */
+	void UpdateReservedMemory(int64 NewReservedMemory);
+
+	/** Returns the amount of memory reserved for the import, in bytes */
+	int64 GetReservedMemory() const;
+
+private:
+	friend class FRuntimeAudioImportScheduler;
+
+	/** Priority class the import was queued with */
+	ERuntimeImportPriority Priority;
+
+	/** Memory reserved for the import, in bytes */
+	TAtomic<int64> ReservedMemory;
+
+	/** Token used to cancel the import */
+	FRuntimeAudioImportCancellationTokenPtr CancellationToken;
+
+	/** The import work, executed on a background thread */
+	TUniqueFunction<void()> Work;
+
+	/** Executed instead of the work if the import is cancelled before the work starts */
+	TUniqueFunction<void()> OnCancelled;
+
+	/** Whether the import has been started, i.e. its memory is accounted for in the scheduler. Guarded by the scheduler's critical section */
+	bool bStarted;
+};
+
+using FRuntimeAudioImportJobPtr = TSharedPtr<FRuntimeAudioImportJob, ESPMode::ThreadSafe>;
+
+/**
+ * Runtime Audio Import Scheduler
+ * Queues audio imports and runs them on a bounded number of normal priority background tasks instead of dispatching every import
+ * to the high priority background pool at once, which starves engine tasks when importing many files
+ * New imports are delayed while the memory in flight (encoded data and decoded PCM data not yet handed over to a sound wave) exceeds the memory budget
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeAudioImportScheduler
+{
+public:
+	/** Returns the scheduler shared by all importers */
+	static FRuntimeAudioImportScheduler& Get();
+
+	/**
+	 * Queues an import
+	 *
+	 * @param Priority Priority class of the import
+	 * @param EstimatedMemory The estimated amount of memory the import will hold in flight, in bytes
+	 * @param CancellationToken Token used to cancel the import. Can be null
+	 * @param Work The import work, executed on a background thread
+	 * @param OnCancelled Executed instead of the work if the import is cancelled before the work starts. Can be empty
+	 */
+	void EnqueueImport(ERuntimeImportPriority Priority, int64 EstimatedMemory, FRuntimeAudioImportCancellationTokenPtr CancellationToken, TUniqueFunction<void()>&& Work, TUniqueFunction<void()>&& OnCancelled);
+
+	/**
+	 * Returns the import running on the calling thread, if any
+	 * Capture it when handing the import over to another thread to keep its memory reserved until the handover is done
+	 */
+	static FRuntimeAudioImportJobPtr GetCurrentJob();
+
+	/** Sets the maximum number of imports running at the same time. Must be at least 1 */
+	void SetMaxConcurrentImports(int32 InMaxConcurrentImports);
+
+	/** Returns the maximum number of imports running at the same time */
+	int32 GetMaxConcurrentImports() const;
+
+	/** Sets the memory budget for imports in flight, in bytes. An import is always started if nothing else is in flight, even if it exceeds the budget */
+	void SetMemoryBudget(int64 InMemoryBudget);
+
+	/** Returns the memory budget for imports in flight, in bytes */
+	int64 GetMemoryBudget() const;
+
+	/** Returns the amount of memory currently reserved by imports in flight, in bytes */
+	int64 GetMemoryInFlight() const;
+
+	/** Returns the number of imports currently running */
+	int32 GetNumOfRunningImports() const;
+
+	/** Returns the number of imports waiting to be started */
+	int32 GetNumOfQueuedImports() const;
+
+private:
+	friend class FRuntimeAudioImportJob;
+
+	FRuntimeAudioImportScheduler();
+
+	/** Starts as many queued imports as the concurrency limit and the memory budget allow */
+	void PumpQueue();
+
+	/** Runs the import on the current (background) thread */
+	void RunJob(const FRuntimeAudioImportJobPtr& Job);
+
+	/** Adjusts the memory in flight by the given amount and starts queued imports if memory was released */
+	void AdjustMemoryInFlight(int64 Delta);
+
+	/** Replaces the memory reserved by the import, accounting for the difference if the import has been started */
+	void ReplaceReservedMemory(FRuntimeAudioImportJob& Job, int64 NewReservedMemory);
+
+	/** Queued imports, one FIFO queue per priority class */
+	TArray<TArray<FRuntimeAudioImportJobPtr>> Queues;
+
+	/** Maximum number of imports running at the same time */
+	int32 MaxConcurrentImports;
+
+	/** Number of imports currently running */
+	int32 NumOfRunningImports;
+
+	/** Memory budget for imports in flight, in bytes */
+	int64 MemoryBudget;
+
+	/** Memory currently reserved by imports in flight, in bytes */
+	int64 MemoryInFlight;
+
+	/** Guards the queues and the counters */
+	mutable FCriticalSection CriticalSection;
+};
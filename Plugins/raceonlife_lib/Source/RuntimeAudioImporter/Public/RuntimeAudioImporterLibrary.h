@@ -4,6 +4,7 @@
 
 #include "Sound/ImportedSoundWave.h"
 #include "RuntimeAudioImporterTypes.h"
+#include "RuntimeAudioImportScheduler.h"
 #include "RuntimeAudioImporterLibrary.generated.h"
 
 class UPreImportedSoundAsset;
@@ -38,6 +39,8 @@ class RUNTIMEAUDIOIMPORTER_API URuntimeAudioImporterLibrary : public UObject
 	GENERATED_BODY()
 
 public:
+	URuntimeAudioImporterLibrary(const FObjectInitializer& ObjectInitializer);
+
 	/** Bind to know when audio import is on progress. Suitable for use in C++ */
 	FOnAudioImporterProgressNative OnProgressNative;
 
@@ -52,6 +55,44 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Runtime Audio Importer|Delegates")
 	FOnAudioImporterResult OnResult;
 
+	/** Priority class used for the imports started by this importer. Imports are queued by the import scheduler and higher priority imports are started first */
+	UPROPERTY(BlueprintReadWrite, Category = "Runtime Audio Importer|Import")
+	ERuntimeImportPriority ImportPriority;
+
+	/** How the PCM data of the imported sound waves is stored in memory. Compressed data is decoded block by block during playback */
+	UPROPERTY(BlueprintReadWrite, Category = "Runtime Audio Importer|Import")
+	ERuntimePCMStorageMode PCMStorageMode;
+
+	/**
+	 * Whether 16-bit integer and 32-bit float WAV files imported uncompressed should be played directly from the memory-mapped file instead of being decoded into memory
+	 * The file stays mapped (and may be locked by the OS) as long as the imported sound wave holds its audio data
+	 */
+	UPROPERTY(BlueprintReadWrite, Category = "Runtime Audio Importer|Import")
+	bool bPlayWavFromMappedFile;
+
+	/**
+	 * Cancel all imports started by this importer that have not finished yet
+	 * Queued imports are dropped, running imports are stopped at the next stage. Each cancelled import broadcasts the Cancelled status
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Audio Importer|Import")
+	void CancelImport();
+
+	/**
+	 * Set the maximum number of imports running at the same time, shared by all importers
+	 *
+	 * @param MaxConcurrentImports The maximum number of concurrent imports. Must be at least 1
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Audio Importer|Import")
+	static void SetMaxConcurrentImports(int32 MaxConcurrentImports);
+
+	/**
+	 * Set the memory budget for imports in flight, shared by all importers. New imports are delayed while the encoded and decoded data of running imports exceeds the budget
+	 *
+	 * @param MemoryBudget The memory budget, in bytes
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Audio Importer|Import")
+	static void SetImportMemoryBudget(int64 MemoryBudget);
+
 	/**
 	 * Tries to retrieve audio data from a given regular sound wave
 	 * 
@@ -165,6 +206,18 @@ public:
 	 */
 	static bool DecodeAudioData(FEncodedAudioStruct&& EncodedAudioInfo, FDecodedAudioStruct& DecodedAudioInfo);
 
+	/**
+	 * Decode compressed audio data to uncompressed in independent ranges of frames decoded in parallel
+	 * The audio data is only read, so it can reside in a read-only memory-mapped file
+	 *
+	 * @param AudioData The encoded audio data
+	 * @param AudioDataSize The size of the encoded audio data, in bytes
+	 * @param AudioFormat The format of the encoded audio data. Must not be Auto
+	 * @param DecodedAudioInfo The decoded audio data
+	 * @return Whether the decoding was successful or not. Fails if no codec of the format supports decoding ranges of frames
+	 */
+	static bool DecodeAudioDataInRanges(const uint8* AudioData, int64 AudioDataSize, ERuntimeAudioFormat AudioFormat, FDecodedAudioStruct& DecodedAudioInfo);
+
 	/**
 	 * Encode uncompressed audio data to compressed.
 	 *
@@ -202,6 +255,30 @@ public:
 	static bool ResampleAndMixChannelsInDecodedInfo(FDecodedAudioStruct& DecodedAudioInfo, uint32 NewSampleRate, uint32 NewNumOfChannels);
 
 protected:
+	/**
+	 * Queue the background part of an import in the import scheduler using this importer's priority and cancellation token
+	 *
+	 * @param EstimatedMemory The estimated amount of memory the import will hold in flight, in bytes
+	 * @param Work The import work, executed on a background thread
+	 */
+	void ScheduleImport(int64 EstimatedMemory, TUniqueFunction<void()>&& Work);
+
+	/**
+	 * Check whether the import running on the calling thread has been cancelled, broadcasting the Cancelled status if so
+	 *
+	 * @return True if the import has been cancelled and should not continue
+	 */
+	bool HandleCancellation_Internal();
+
+	/**
+	 * Import WAV or FLAC audio data directly from the memory-mapped file, so that the encoded data is paged in on demand instead of being loaded into memory as a whole
+	 *
+	 * @param FilePath The path to the audio file to import
+	 * @param AudioFormat The format of the audio file, either Wav or Flac
+	 * @return True if the import was handled, false if the file should be imported through the regular loading path instead
+	 */
+	bool ImportAudioFromMappedFile_Internal(const FString& FilePath, ERuntimeAudioFormat AudioFormat);
+
 	/**
 	 * Audio transcoding progress callback
 	 * 
@@ -216,4 +293,7 @@ protected:
 	 * @param Status Importing status
 	 */
 	void OnResult_Internal(UImportedSoundWave* ImportedSoundWave, ERuntimeImportStatus Status);
+
+	/** Token shared by all imports started by this importer since the last cancellation */
+	FRuntimeAudioImportCancellationTokenPtr CancellationToken;
 };
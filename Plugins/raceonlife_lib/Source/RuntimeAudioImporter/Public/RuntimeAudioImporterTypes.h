@@ -159,7 +159,38 @@ enum class ERuntimeImportStatus : uint8
 	AudioDoesNotExist UMETA(DisplayName = "Audio does not exist"),
 
 	/** Load file to array error */
-	LoadFileToArrayError UMETA(DisplayName = "Load file to array error")
+	LoadFileToArrayError UMETA(DisplayName = "Load file to array error"),
+
+	/** The import was cancelled before it finished */
+	Cancelled UMETA(DisplayName = "Cancelled")
+};
+
+/** How the PCM data of an imported sound wave is kept in memory */
+UENUM(BlueprintType, Category = "Runtime Audio Importer")
+enum class ERuntimePCMStorageMode : uint8
+{
+	/** 32-bit float PCM data. Fastest playback, largest memory footprint */
+	Uncompressed,
+
+	/** Lossless block compression, decoded just in time for playback. Effective for audio decoded from integer PCM (e.g. WAV or FLAC); float PCM decoded from MP3 or Vorbis is kept as is */
+	Compressed,
+
+	/** Same as Compressed, but quantizes the samples to 16-bit first, which makes it effective for any audio. The quantization is lossy */
+	Compressed16Bit UMETA(DisplayName = "Compressed 16-bit")
+};
+
+/** Priority classes of queued imports. Higher priority imports are started first */
+UENUM(BlueprintType, Category = "Runtime Audio Importer")
+enum class ERuntimeImportPriority : uint8
+{
+	/** Imports needed right away, e.g. the track about to be played */
+	High,
+
+	/** Regular imports */
+	Normal,
+
+	/** Background imports, e.g. prefetching or library scans */
+	Low
 };
 
 /** Possible audio formats (extensions) */
@@ -478,6 +509,9 @@ struct FSoundWaveBasicStruct
 	}
 };
 
+struct FCompressedPCMData;
+struct FMappedPCMData;
+
 /** PCM data buffer structure */
 struct FPCMStruct
 {
@@ -493,6 +527,22 @@ struct FPCMStruct
 		return PCMData.GetView().GetData() && PCMNumOfFrames > 0 && PCMData.GetView().Num() > 0;
 	}
 
+	/**
+	 * Whether the audio data is stored compressed (see ERuntimePCMStorageMode). If so, PCMData is empty
+	 */
+	bool IsCompressed() const
+	{
+		return CompressedPCMData.IsValid();
+	}
+
+	/**
+	 * Whether the audio data is played directly from a memory-mapped file. If so, PCMData is empty
+	 */
+	bool IsMapped() const
+	{
+		return MappedPCMData.IsValid();
+	}
+
 	/**
 	 * Converts PCM struct to a readable format
 	 *
@@ -500,13 +550,19 @@ struct FPCMStruct
 	 */
 	FString ToString() const
 	{
-		return FString::Printf(TEXT("Validity of PCM data in memory: %s, number of PCM frames: %d, PCM data size: %lld"),
-			PCMData.GetView().IsValidIndex(0) ? TEXT("Valid") : TEXT("Invalid"), PCMNumOfFrames, static_cast<int64>(PCMData.GetView().Num()));
+		return FString::Printf(TEXT("Validity of PCM data in memory: %s, number of PCM frames: %d, PCM data size: %lld, compressed: %s, mapped: %s"),
+			PCMData.GetView().IsValidIndex(0) ? TEXT("Valid") : TEXT("Invalid"), PCMNumOfFrames, static_cast<int64>(PCMData.GetView().Num()), IsCompressed() ? TEXT("Yes") : TEXT("No"), IsMapped() ? TEXT("Yes") : TEXT("No"));
 	}
 
 	/** 32-bit float PCM data */
 	FRuntimeBulkDataBuffer<float> PCMData;
 
+	/** Compressed PCM data, used instead of PCMData if the audio data is stored compressed. Immutable, so it can be shared between copies */
+	TSharedPtr<const FCompressedPCMData, ESPMode::ThreadSafe> CompressedPCMData;
+
+	/** PCM data in a memory-mapped file, used instead of PCMData if the audio data is played directly from the file */
+	TSharedPtr<const FMappedPCMData, ESPMode::ThreadSafe> MappedPCMData;
+
 	/** Number of PCM frames */
 	uint32 PCMNumOfFrames;
 };
@@ -752,3 +808,132 @@ struct FRuntimeAudioExportOverrideOptions
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
 	int32 SampleRate;
 };
+
+/** A single entry of the batch transcoding, describing where the audio data comes from and how it should be written */
+USTRUCT(BlueprintType, Category = "Runtime Audio Importer")
+struct FRuntimeAudioBatchTranscodeItem
+{
+	GENERATED_BODY()
+
+	FRuntimeAudioBatchTranscodeItem()
+		: bRAWFrom(false)
+	  , EncodedFormatFrom(ERuntimeAudioFormat::Auto)
+	  , RAWFormatFrom(ERuntimeRAWAudioFormat::Float32)
+	  , SampleRateFrom(44100)
+	  , NumOfChannelsFrom(1)
+	  , bRAWTo(false)
+	  , EncodedFormatTo(ERuntimeAudioFormat::Wav)
+	  , RAWFormatTo(ERuntimeRAWAudioFormat::Float32)
+	  , Quality(100)
+	{}
+
+	/** Path to the file with the audio data to transcode. If empty, DataFrom is used instead */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	FString FilePathFrom;
+
+	/** The audio data to transcode. Only used if FilePathFrom is empty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	TArray<uint8> DataFrom;
+
+	/** Whether the source audio data is RAW (uncompressed, PCM) instead of encoded */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, DisplayName = "Is RAW From", Category = "Runtime Audio Importer")
+	bool bRAWFrom;
+
+	/** The format of the encoded source audio data. Only used if bRAWFrom is false */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	ERuntimeAudioFormat EncodedFormatFrom;
+
+	/** The format of the RAW source audio data. Only used if bRAWFrom is true */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, DisplayName = "RAW Format From", Category = "Runtime Audio Importer")
+	ERuntimeRAWAudioFormat RAWFormatFrom;
+
+	/** The sample rate of the RAW source audio data. Only used if bRAWFrom is true */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	int32 SampleRateFrom;
+
+	/** The number of channels of the RAW source audio data. Only used if bRAWFrom is true */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	int32 NumOfChannelsFrom;
+
+	/** File path for saving the transcoded audio data */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	FString FilePathTo;
+
+	/** Whether the transcoded audio data should be written as RAW (uncompressed, PCM) instead of encoded */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, DisplayName = "Is RAW To", Category = "Runtime Audio Importer")
+	bool bRAWTo;
+
+	/** The desired format of the encoded audio data. Only used if bRAWTo is false */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	ERuntimeAudioFormat EncodedFormatTo;
+
+	/** The desired format of the RAW audio data. Only used if bRAWTo is true */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, DisplayName = "RAW Format To", Category = "Runtime Audio Importer")
+	ERuntimeRAWAudioFormat RAWFormatTo;
+
+	/** The quality of the encoded audio data. Only used if bRAWTo is false */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	uint8 Quality;
+
+	/** The override options for the transcoded audio data (fill with -1 if you don't want to override) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	FRuntimeAudioExportOverrideOptions OverrideOptions;
+};
+
+/** An audio file indexed by the audio directory index */
+USTRUCT(BlueprintType, Category = "Runtime Audio Importer")
+struct FRuntimeAudioIndexEntry
+{
+	GENERATED_BODY()
+
+	FRuntimeAudioIndexEntry()
+		: FileSize(0)
+	  , bHeaderInfoValid(false)
+	{}
+
+	friend FArchive& operator<<(FArchive& Ar, FRuntimeAudioIndexEntry& Entry)
+	{
+		uint8 AudioFormat = static_cast<uint8>(Entry.HeaderInfo.AudioFormat);
+		Ar << Entry.FilePath;
+		Ar << Entry.FileSize;
+		Ar << Entry.ModificationTime;
+		Ar << Entry.bHeaderInfoValid;
+		Ar << Entry.HeaderInfo.Duration;
+		Ar << Entry.HeaderInfo.NumOfChannels;
+		Ar << Entry.HeaderInfo.SampleRate;
+		Ar << Entry.HeaderInfo.PCMDataSize;
+		Ar << AudioFormat;
+		Entry.HeaderInfo.AudioFormat = static_cast<ERuntimeAudioFormat>(AudioFormat);
+		Ar << Entry.Title;
+		Ar << Entry.Artist;
+		return Ar;
+	}
+
+	/** Path to the audio file */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Runtime Audio Importer")
+	FString FilePath;
+
+	/** Size of the audio file when it was indexed, in bytes */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Runtime Audio Importer")
+	int64 FileSize;
+
+	/** Modification time of the audio file when it was indexed */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Runtime Audio Importer")
+	FDateTime ModificationTime;
+
+	/** Whether the header information was read successfully. Files are indexed by their extension, so a broken file is still listed */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Runtime Audio Importer")
+	bool bHeaderInfoValid;
+
+	/** Header information of the audio file (duration, number of channels, sample rate and format) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Runtime Audio Importer")
+	FRuntimeAudioHeaderInfo HeaderInfo;
+
+	/** Title from the ID3 tags of the audio file, empty if it has none */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Runtime Audio Importer")
+	FString Title;
+
+	/** Artist from the ID3 tags of the audio file, empty if it has none */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Runtime Audio Importer")
+	FString Artist;
+};
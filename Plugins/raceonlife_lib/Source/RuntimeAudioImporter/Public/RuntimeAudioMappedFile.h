@@ -0,0 +1,114 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/UniquePtr.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+enum class ERuntimeRAWAudioFormat : uint8;
+
+/**
+ * Read-only memory-mapped audio file
+ * The encoded bytes are paged in by the OS on demand instead of being loaded into memory as a whole
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeAudioMappedFile : public TSharedFromThis<FRuntimeAudioMappedFile, ESPMode::ThreadSafe>
+{
+public:
+	~FRuntimeAudioMappedFile();
+
+	/**
+	 * Map the whole file into memory
+	 *
+	 * @param FilePath The path to the file to map
+	 * @return The mapped file, or nullptr if the file could not be mapped (e.g. memory mapping is not supported on the platform)
+	 */
+	static TSharedPtr<FRuntimeAudioMappedFile, ESPMode::ThreadSafe> Open(const FString& FilePath);
+
+	/** The mapped bytes of the file */
+	const uint8* GetData() const;
+
+	/** The size of the mapped file, in bytes */
+	int64 GetSize() const;
+
+	/**
+	 * Page in the given range of the file on the calling thread, by touching every page of it
+	 *
+	 * @param Offset The offset of the range, in bytes
+	 * @param Size The size of the range, in bytes
+	 */
+	void ReadAhead(int64 Offset, int64 Size);
+
+	/**
+	 * Page in the given range of the file on a background thread, unless most of it has already been paged in or another read-ahead is running
+	 * Meant to be called from the audio render thread, which should not stall on page faults when it reads the range later
+	 *
+	 * @param Offset The offset of the range, in bytes
+	 * @param Size The size of the range, in bytes
+	 */
+	void ReadAheadAsync(int64 Offset, int64 Size);
+
+private:
+	FRuntimeAudioMappedFile();
+
+	/** The handle of the mapped file. Must outlive the mapped region */
+	TUniquePtr<IMappedFileHandle> MappedFileHandle;
+
+	/** The region covering the whole file */
+	TUniquePtr<IMappedFileRegion> MappedFileRegion;
+
+	/** The range paged in by the last read-ahead. Only a hint, the OS may evict the pages again under memory pressure */
+	TAtomic<int64> ReadAheadStart;
+	TAtomic<int64> ReadAheadEnd;
+
+	/** Whether a background read-ahead is running */
+	TAtomic<bool> bReadAheadInFlight;
+};
+
+using FRuntimeAudioMappedFilePtr = TSharedPtr<FRuntimeAudioMappedFile, ESPMode::ThreadSafe>;
+
+/**
+ * Interleaved PCM samples played directly from a memory-mapped file (16-bit integer or 32-bit float WAV data)
+ * Immutable, so it can be shared between copies of the PCM buffer
+ */
+struct RUNTIMEAUDIOIMPORTER_API FMappedPCMData
+{
+	FMappedPCMData();
+
+	/**
+	 * Convert the given range of frames into interleaved 32-bit float PCM data
+	 *
+	 * @param StartFrame The first frame to copy
+	 * @param NumOfFramesToCopy The number of frames to copy
+	 * @param OutPCMData The destination buffer, must be able to hold NumOfFramesToCopy * NumOfChannels samples
+	 * @return The number of copied frames, fewer than requested if the range exceeds the sample data
+	 */
+	int64 CopyFrames(int64 StartFrame, int64 NumOfFramesToCopy, float* OutPCMData) const;
+
+	/**
+	 * Page in the sample data following the given frame on a background thread. Called by CopyFrames for the frames after the copied ones
+	 *
+	 * @param StartFrame The first frame to page in
+	 */
+	void ReadAheadAsync(int64 StartFrame) const;
+
+	/** Number of bytes of sample data kept paged in ahead of the playback position */
+	static constexpr int64 ReadAheadSize = 2 * 1024 * 1024;
+
+	/** The mapped file holding the sample data */
+	FRuntimeAudioMappedFilePtr MappedFile;
+
+	/** The offset of the first sample within the mapped file, in bytes */
+	int64 DataOffset;
+
+	/** The format of the mapped samples, either Int16 or Float32 */
+	ERuntimeRAWAudioFormat SampleFormat;
+
+	/** Number of interleaved channels */
+	int32 NumOfChannels;
+
+	/** Number of frames in the sample data */
+	int64 NumOfFrames;
+};
@@ -40,6 +40,13 @@ DECLARE_DELEGATE_OneParam(FOnEncodedDataTranscodeFromFileResultNative, bool);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnEncodedDataTranscodeFromFileResult, bool, bSucceeded);
 
 
+/** Static delegate broadcasting the results of the batch transcoding, one per item */
+DECLARE_DELEGATE_OneParam(FOnBatchTranscodeResultNative, const TArray<bool>&);
+
+/** Dynamic delegate broadcasting the results of the batch transcoding, one per item */
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnBatchTranscodeResult, const TArray<bool>&, Results);
+
+
 /**
  * Runtime Audio Transcoder
  * Contains functions for transcoding audio data from one format to another
@@ -146,6 +153,29 @@ public:
 	 */
 	static void TranscodeEncodedDataFromFile(const FString& FilePathFrom, ERuntimeAudioFormat EncodedFormatFrom, const FString& FilePathTo, ERuntimeAudioFormat EncodedFormatTo, uint8 Quality, const FRuntimeAudioExportOverrideOptions& OverrideOptions, const FOnEncodedDataTranscodeFromFileResultNative& Result);
 
+	/**
+	 * Transcode a batch of files or buffers, writing the results to files
+	 * The items are processed concurrently on the task graph workers. Large WAV, FLAC and RAW inputs are additionally split into segments that are decoded and converted in parallel,
+	 * and RAW and WAV outputs are written to disk segment by segment instead of being assembled in memory
+	 *
+	 * @param Items The items to transcode
+	 * @param MaxConcurrentItems The maximum number of items transcoded at the same time. Set to 0 to use the number of worker threads
+	 * @param Result Delegate broadcasting the results, in the same order as the items
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Audio Transcoder")
+	static void TranscodeBatch(TArray<FRuntimeAudioBatchTranscodeItem> Items, int32 MaxConcurrentItems, const FOnBatchTranscodeResult& Result);
+
+	/**
+	 * Transcode a batch of files or buffers, writing the results to files
+	 * The items are processed concurrently on the task graph workers. Large WAV, FLAC and RAW inputs are additionally split into segments that are decoded and converted in parallel,
+	 * and RAW and WAV outputs are written to disk segment by segment instead of being assembled in memory
+	 *
+	 * @param Items The items to transcode
+	 * @param MaxConcurrentItems The maximum number of items transcoded at the same time. Set to 0 to use the number of worker threads
+	 * @param Result Delegate broadcasting the results, in the same order as the items
+	 */
+	static void TranscodeBatch(TArray<FRuntimeAudioBatchTranscodeItem> Items, int32 MaxConcurrentItems, const FOnBatchTranscodeResultNative& Result);
+
 	/**
 	 * Helper function for transcoding RAW format
 	 * 
@@ -20,6 +20,12 @@ DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnScanDirectoryForAudioFilesResult, bool, bS
 /** Static delegate broadcasting the result of scanning directory for audio files */
 DECLARE_DELEGATE_TwoParams(FOnScanDirectoryForAudioFilesResultNative, bool, const TArray<FString>&);
 
+/** Dynamic delegate broadcasting the result of scanning directory for indexed audio files */
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnScanDirectoryForIndexedAudioFilesResult, bool, bSucceeded, const TArray<FRuntimeAudioIndexEntry>&, AudioFiles);
+
+/** Static delegate broadcasting the result of scanning directory for indexed audio files */
+DECLARE_DELEGATE_TwoParams(FOnScanDirectoryForIndexedAudioFilesResultNative, bool, const TArray<FRuntimeAudioIndexEntry>&);
+
 
 /**
  * Runtime Audio Utilities
@@ -125,4 +131,33 @@ public:
 	 * @param Result Delegate broadcasting the result
 	 */
 	static void ScanDirectoryForAudioFiles(const FString& Directory, bool bRecursive, const FOnScanDirectoryForAudioFilesResultNative& Result);
+
+	/**
+	 * Scan the specified directory for audio files, retrieving their header information from the persistent audio directory index
+	 *
+	 * @param Directory The directory path to scan for audio files
+	 * @param bRecursive Whether to search for files recursively in subdirectories
+	 * @param Result Delegate broadcasting the result
+	 */
+	UFUNCTION(BlueprintCallable, meta = (Keywords = "Folder"), Category = "Runtime Audio Utilities")
+	static void ScanDirectoryForIndexedAudioFiles(const FString& Directory, bool bRecursive, const FOnScanDirectoryForIndexedAudioFilesResult& Result);
+
+	/**
+	 * Scan the specified directory for audio files, retrieving their header information from the persistent audio directory index. Suitable for use in C++
+	 *
+	 * @param Directory The directory path to scan for audio files
+	 * @param bRecursive Whether to search for files recursively in subdirectories
+	 * @param Result Delegate broadcasting the result
+	 */
+	static void ScanDirectoryForIndexedAudioFiles(const FString& Directory, bool bRecursive, const FOnScanDirectoryForIndexedAudioFilesResultNative& Result);
+
+	/**
+	 * Get the audio files of the specified directory as of its last scan, without accessing the file system
+	 *
+	 * @param Directory The directory path to query
+	 * @param bRecursive Whether to include the files in subdirectories
+	 * @return The indexed audio files, sorted by path
+	 */
+	UFUNCTION(BlueprintCallable, meta = (Keywords = "Folder"), Category = "Runtime Audio Utilities")
+	static TArray<FRuntimeAudioIndexEntry> QueryIndexedAudioFiles(const FString& Directory, bool bRecursive);
 };
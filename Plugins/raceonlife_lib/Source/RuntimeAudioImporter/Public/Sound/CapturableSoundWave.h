@@ -12,6 +12,8 @@
 #endif
 #endif
 #include "StreamingSoundWave.h"
+#include "RuntimeAudioCaptureRing.h"
+#include "Containers/Ticker.h"
 #include "CapturableSoundWave.generated.h"
 
 /** Static delegate broadcasting available audio input devices */
@@ -58,6 +60,14 @@ public:
 	 */
 	static void GetAvailableAudioInputDevices(const FOnGetAvailableAudioInputDevicesResultNative& Result);
 
+	/**
+	 * Get the number of captured samples dropped because they were not consumed fast enough
+	 *
+	 * @return The number of dropped samples since the capture was started
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Capturable Sound Wave|Info")
+	int64 GetNumOfDroppedCaptureSamples() const;
+
 	/**
 	 * Start the capture process
 	 *
@@ -103,6 +113,46 @@ protected:
 	virtual bool IsCapturing_Implementation() const;
 
 private:
+	/**
+	 * Consume the captured audio data from the capture ring and append it to the sound wave
+	 * Runs on the audio task pipe, so it is serialized with the other appends
+	 */
+	void ConsumeCapturedAudioData();
+
+	/** Start consuming the capture ring on every tick */
+	void StartConsumingCapturedAudioData();
+
+	/** Stop consuming the capture ring, appending what is left in it */
+	void StopConsumingCapturedAudioData();
+
+	/** Ring between the capture callback and the consumer. The capture callback only copies into it, never allocating nor locking */
+	FRuntimeAudioCaptureRing CaptureRing;
+
+	/** Converts the captured audio data to the format of the sound wave. Only used by the consumer */
+	FRuntimeAudioCaptureConverter CaptureConverter;
+
+	/** Guards the consumer state against the capture ring being reinitialized when a new capture is started. Never taken by the capture callback */
+	FCriticalSection CaptureConsumerGuard;
+
+	/** Buffer the consumer reads the captured audio data into. Sized together with the capture ring */
+	TArray<float> CapturedPCMData;
+
+	/** Buffer holding the converted captured audio data. Only used by the consumer */
+	TArray<float> ConvertedCapturedPCMData;
+
+	/** The number of dropped samples already reported by the consumer */
+	int64 NumOfReportedDroppedSamples = 0;
+
+	/** Whether consuming the capture ring has been scheduled on the audio task pipe and has not started yet */
+	std::atomic<bool> bCaptureConsumptionScheduled{false};
+
+	/** Handle of the ticker scheduling the consumption of the capture ring */
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FDelegateHandle CaptureConsumptionTickerHandle;
+#else
+	FTSTicker::FDelegateHandle CaptureConsumptionTickerHandle;
+#endif
+
 #if WITH_RUNTIMEAUDIOIMPORTER_CAPTURE_SUPPORT
 #if PLATFORM_IOS && !PLATFORM_TVOS
 	/** Audio capture instance specific to iOS. Implemented manually due to the engine not properly supporting iOS audio capture at the moment */
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "RuntimeAudioImporterTypes.h"
+#include "Codecs/PCMBlock_RuntimeCodec.h"
 #include "Sound/SoundWaveProcedural.h"
 #include "Misc/Optional.h"
 #include "ImportedSoundWave.generated.h"
@@ -459,11 +460,37 @@ public:
 	/**
 	 * Get immutable PCM buffer. Use DataGuard to make it thread safe
 	 * Use PopulateAudioDataFromDecodedInfo to populate it
+	 * While the PCM data is stored compressed (see SetPCMStorageMode), the 32-bit float PCM data is empty. Use GetDecompressedPCMBuffer to access it regardless of the storage mode
 	 *
 	 * @return PCM buffer in 32-bit float format
 	 */
 	const FPCMStruct& GetPCMBuffer() const;
 
+	/**
+	 * Get immutable PCM buffer with 32-bit float PCM data regardless of the storage mode. Use DataGuard to make it thread safe
+	 *
+	 * @param DecompressedPCMBuffer Storage for the decompressed PCM data, used only if the PCM data is stored compressed
+	 * @return The PCM buffer if it is uncompressed, otherwise DecompressedPCMBuffer populated with the decompressed PCM data
+	 */
+	const FPCMStruct& GetDecompressedPCMBuffer(FPCMStruct& DecompressedPCMBuffer) const;
+
+	/**
+	 * Set how the PCM data is kept in memory. Compressed storage decodes the audio data just in time for playback, in blocks, which reduces the memory footprint of long sounds
+	 * If the sound wave already has PCM data, it is compressed or decompressed right away on the calling thread, otherwise the mode applies to the PCM data populated later
+	 *
+	 * @param StorageMode The PCM storage mode
+	 * @return True if the storage mode was successfully applied
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Main")
+	virtual bool SetPCMStorageMode(ERuntimePCMStorageMode StorageMode);
+
+	/**
+	 * Get how the PCM data is kept in memory
+	 * @return The PCM storage mode
+	 */
+	UFUNCTION(BlueprintPure, Category = "Imported Sound Wave|Info")
+	ERuntimePCMStorageMode GetPCMStorageMode() const;
+
 	/**
 	 * Get audio format of the audio imported into the sound wave
 	 * @return Audio format
@@ -475,6 +502,22 @@ public:
 	mutable TSharedPtr<FCriticalSection> DataGuard;
 
 protected:
+	/**
+	 * Compress the PCM data according to the storage mode if it is not compressed yet
+	 * Should only be used if DataGuard is locked
+	 *
+	 * @return True if the PCM data is stored according to the storage mode
+	 */
+	bool CompressPCMData_Internal();
+
+	/**
+	 * Decompress the PCM data back to 32-bit float PCM data if it is compressed or played from a memory-mapped file
+	 * Should only be used if DataGuard is locked
+	 *
+	 * @return True if the PCM data is uncompressed
+	 */
+	bool DecompressPCMData_Internal();
+
 	/** Bool to control the behaviour of the OnAudioPlaybackFinished delegate */
 	bool PlaybackFinishedBroadcast;
 
@@ -484,6 +527,12 @@ protected:
 	/** Contains PCM data for sound wave playback */
 	TSharedPtr<FPCMStruct> PCMBufferInfo;
 
+	/** How the PCM data is kept in memory */
+	ERuntimePCMStorageMode PCMStorageMode;
+
+	/** Decoded blocks of the compressed PCM data, used for playback. Guarded by DataGuard */
+	FPCMBlockCache PCMBlockCache;
+
 	/** Whether to stop the sound at the end of playback or not. Sound wave will not be garbage collected if playback was completed while this parameter is set to false */
 	bool bStopSoundOnPlaybackFinish;
 
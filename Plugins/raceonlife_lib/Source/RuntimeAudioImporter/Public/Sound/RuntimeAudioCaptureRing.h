@@ -0,0 +1,327 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Single-producer single-consumer ring of interleaved 32-bit float PCM data, placed between an audio capture callback and its consumer
+ * The storage is allocated up front, so writing from the capture callback never allocates nor locks
+ * If the consumer falls behind, the producer overwrites the oldest samples (drop-oldest) and the consumer counts them as overruns
+ * Torn reads are detected the seqlock way: the producer publishes the end of the range it is about to overwrite before copying,
+ * and the consumer checks its copy against that reserved end once it is done
+ */
+class FRuntimeAudioCaptureRing
+{
+public:
+	FRuntimeAudioCaptureRing()
+		: WritePosition(0)
+	  , ReservedWritePosition(0)
+	  , ReadPosition(0)
+	  , NumOfOverrunSamples(0)
+	  , NumOfChannels(0)
+	  , SampleRate(0)
+	{}
+
+	/**
+	 * Allocate the storage and reset the ring. Must not be called while the producer or the consumer is running
+	 *
+	 * @param NumOfSamples The capacity of the ring, in samples
+	 */
+	void Initialize(int64 NumOfSamples)
+	{
+		Storage.SetNumZeroed(NumOfSamples);
+		WritePosition.store(0);
+		ReservedWritePosition.store(0);
+		ReadPosition.store(0);
+		NumOfOverrunSamples.store(0);
+		NumOfChannels.store(0);
+		SampleRate.store(0);
+	}
+
+	/**
+	 * Write whole frames into the ring. Called by the producer only, never allocates nor blocks
+	 *
+	 * @param PCMData Interleaved PCM data
+	 * @param NumOfFrames The number of frames in the PCM data
+	 * @param InNumOfChannels The number of channels of the PCM data. Must stay the same until the ring is initialized again
+	 * @param InSampleRate The sample rate of the PCM data
+	 */
+	void Write(const float* PCMData, int64 NumOfFrames, int32 InNumOfChannels, int32 InSampleRate)
+	{
+		const int64 Capacity = Storage.Num();
+		if (Capacity <= 0 || NumOfFrames <= 0 || InNumOfChannels <= 0)
+		{
+			return;
+		}
+
+		NumOfChannels.store(InNumOfChannels, std::memory_order_relaxed);
+		SampleRate.store(InSampleRate, std::memory_order_relaxed);
+
+		// A block larger than the whole ring only keeps its newest frames
+		int64 NumOfSamples = NumOfFrames * InNumOfChannels;
+		const int64 MaxNumOfSamples = Capacity / InNumOfChannels * InNumOfChannels;
+		if (NumOfSamples > MaxNumOfSamples)
+		{
+			NumOfOverrunSamples.fetch_add(NumOfSamples - MaxNumOfSamples, std::memory_order_relaxed);
+			PCMData += NumOfSamples - MaxNumOfSamples;
+			NumOfSamples = MaxNumOfSamples;
+		}
+
+		const int64 CurrentWritePosition = WritePosition.load(std::memory_order_relaxed);
+		const int64 NewWritePosition = CurrentWritePosition + NumOfSamples;
+
+		// The reserved end is published before any sample is overwritten, the fence orders it before the copy below
+		ReservedWritePosition.store(NewWritePosition, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		const int64 StorageIndex = CurrentWritePosition % Capacity;
+		const int64 NumOfSamplesBeforeWrap = FMath::Min(NumOfSamples, Capacity - StorageIndex);
+		FMemory::Memcpy(Storage.GetData() + StorageIndex, PCMData, NumOfSamplesBeforeWrap * sizeof(float));
+		FMemory::Memcpy(Storage.GetData(), PCMData + NumOfSamplesBeforeWrap, (NumOfSamples - NumOfSamplesBeforeWrap) * sizeof(float));
+
+		WritePosition.store(NewWritePosition, std::memory_order_release);
+	}
+
+	/**
+	 * Read whole frames from the ring. Called by the consumer only
+	 * Frames overwritten by the producer before they could be read are skipped and counted as overruns
+	 *
+	 * @param OutPCMData The destination buffer
+	 * @param MaxNumOfSamples The capacity of the destination buffer, in samples
+	 * @return The number of samples read, always a whole number of frames
+	 */
+	int64 Read(float* OutPCMData, int64 MaxNumOfSamples)
+	{
+		const int64 Capacity = Storage.Num();
+		const int32 CurrentNumOfChannels = NumOfChannels.load(std::memory_order_relaxed);
+		const int64 CurrentWritePosition = WritePosition.load(std::memory_order_acquire);
+		int64 CurrentReadPosition = ReadPosition.load(std::memory_order_relaxed);
+
+		if (Capacity <= 0 || CurrentNumOfChannels <= 0 || CurrentWritePosition == CurrentReadPosition)
+		{
+			return 0;
+		}
+
+		// Skipping what the producer has already overwritten. Positions of frame starts are multiples of the number of channels
+		if (CurrentWritePosition - CurrentReadPosition > Capacity)
+		{
+			CurrentReadPosition = AlignToFrame(CurrentWritePosition - Capacity, CurrentNumOfChannels);
+		}
+
+		const int64 NumOfSamples = FMath::Min(CurrentWritePosition - CurrentReadPosition, MaxNumOfSamples / CurrentNumOfChannels * CurrentNumOfChannels);
+		const int64 StorageIndex = CurrentReadPosition % Capacity;
+		const int64 NumOfSamplesBeforeWrap = FMath::Min(NumOfSamples, Capacity - StorageIndex);
+		FMemory::Memcpy(OutPCMData, Storage.GetData() + StorageIndex, NumOfSamplesBeforeWrap * sizeof(float));
+		FMemory::Memcpy(OutPCMData + NumOfSamplesBeforeWrap, Storage.GetData(), (NumOfSamples - NumOfSamplesBeforeWrap) * sizeof(float));
+
+		// The producer may have started overwriting the beginning of the copied range while it was being copied, such samples are dropped as well
+		// If the copy saw any sample of a write, the fence makes the reserved end of that write visible, including writes still in progress
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const int64 CurrentReservedWritePosition = ReservedWritePosition.load(std::memory_order_relaxed);
+		int64 NumOfValidSamples = NumOfSamples;
+		if (CurrentReservedWritePosition - Capacity > CurrentReadPosition)
+		{
+			const int64 NumOfTornSamples = FMath::Min(NumOfSamples, AlignToFrame(CurrentReservedWritePosition - Capacity, CurrentNumOfChannels) - CurrentReadPosition);
+			NumOfValidSamples -= NumOfTornSamples;
+			FMemory::Memmove(OutPCMData, OutPCMData + NumOfTornSamples, NumOfValidSamples * sizeof(float));
+		}
+
+		NumOfOverrunSamples.fetch_add((CurrentReadPosition - ReadPosition.load(std::memory_order_relaxed)) + (NumOfSamples - NumOfValidSamples), std::memory_order_relaxed);
+		ReadPosition.store(CurrentReadPosition + NumOfSamples, std::memory_order_relaxed);
+		return NumOfValidSamples;
+	}
+
+	/** Returns the number of samples written but not read yet (including samples about to be dropped) */
+	int64 GetNumOfAvailableSamples() const
+	{
+		return WritePosition.load(std::memory_order_acquire) - ReadPosition.load(std::memory_order_relaxed);
+	}
+
+	/** Returns the total number of samples dropped because the consumer fell behind */
+	int64 GetNumOfOverrunSamples() const
+	{
+		return NumOfOverrunSamples.load(std::memory_order_relaxed);
+	}
+
+	/** Returns the number of channels of the written PCM data, or 0 if nothing has been written yet */
+	int32 GetNumOfChannels() const
+	{
+		return NumOfChannels.load(std::memory_order_relaxed);
+	}
+
+	/** Returns the sample rate of the written PCM data, or 0 if nothing has been written yet */
+	int32 GetSampleRate() const
+	{
+		return SampleRate.load(std::memory_order_relaxed);
+	}
+
+private:
+	/** Rounds the position up to the start of the next frame */
+	static int64 AlignToFrame(int64 Position, int32 InNumOfChannels)
+	{
+		return (Position + InNumOfChannels - 1) / InNumOfChannels * InNumOfChannels;
+	}
+
+	/** Preallocated storage of the ring */
+	TArray64<float> Storage;
+
+	/** Total number of samples written, only advanced by the producer */
+	std::atomic<int64> WritePosition;
+
+	/** End of the write in progress, published by the producer before it starts copying. Equals WritePosition between writes */
+	std::atomic<int64> ReservedWritePosition;
+
+	/** Total number of samples consumed (read or dropped), only advanced by the consumer */
+	std::atomic<int64> ReadPosition;
+
+	/** Total number of samples dropped because the consumer fell behind */
+	std::atomic<int64> NumOfOverrunSamples;
+
+	/** The number of channels of the written PCM data */
+	std::atomic<int32> NumOfChannels;
+
+	/** The sample rate of the written PCM data */
+	std::atomic<int32> SampleRate;
+};
+
+/**
+ * Converts captured interleaved float PCM data to the format of the sound wave it is appended to
+ * Channel mixing and (linear) resampling are fused into a single pass over the input, keeping the resampler phase between blocks
+ */
+struct FRuntimeAudioCaptureConverter
+{
+	FRuntimeAudioCaptureConverter()
+		: ResamplePosition(0)
+	{}
+
+	/** Resets the resampler phase, e.g. when a new capture is started */
+	void Reset()
+	{
+		ResamplePosition = 0;
+		LastFrame.Reset();
+	}
+
+	/**
+	 * Converts a block of captured PCM data
+	 *
+	 * @param PCMData Interleaved PCM data of the block
+	 * @param SourceSampleRate The sample rate of the captured data
+	 * @param SourceNumOfChannels The number of channels of the captured data
+	 * @param DestinationSampleRate The desired sample rate
+	 * @param DestinationNumOfChannels The desired number of channels
+	 * @param OutPCMData The converted PCM data. Its allocation is reused between blocks
+	 */
+	void Convert(TArrayView<const float> PCMData, int32 SourceSampleRate, int32 SourceNumOfChannels, int32 DestinationSampleRate, int32 DestinationNumOfChannels, TArray<float>& OutPCMData)
+	{
+		OutPCMData.Reset();
+
+		const int32 NumOfInputFrames = PCMData.Num() / SourceNumOfChannels;
+		if (NumOfInputFrames <= 0 || DestinationSampleRate <= 0 || DestinationNumOfChannels <= 0)
+		{
+			return;
+		}
+
+		// Without resampling the pass only mixes the channels (or copies the data as is)
+		if (SourceSampleRate == DestinationSampleRate)
+		{
+			if (SourceNumOfChannels == DestinationNumOfChannels)
+			{
+				OutPCMData.Append(PCMData.GetData(), PCMData.Num());
+				return;
+			}
+
+			OutPCMData.SetNumUninitialized(NumOfInputFrames * DestinationNumOfChannels);
+			float* OutputData = OutPCMData.GetData();
+			for (int32 FrameIndex = 0; FrameIndex < NumOfInputFrames; ++FrameIndex)
+			{
+				MixFrame(PCMData.GetData() + FrameIndex * SourceNumOfChannels, SourceNumOfChannels, OutputData + FrameIndex * DestinationNumOfChannels, DestinationNumOfChannels);
+			}
+			return;
+		}
+
+		// Linear interpolation between adjacent mixed frames. Index -1 refers to the last frame of the previous block
+		if (LastFrame.Num() != DestinationNumOfChannels)
+		{
+			LastFrame.SetNumZeroed(DestinationNumOfChannels);
+		}
+
+		const double ResampleStep = static_cast<double>(SourceSampleRate) / DestinationSampleRate;
+		// The resampler phase stays within one input frame, so this bound does not depend on it and the allocation is reused for blocks of the same size
+		OutPCMData.Reserve((FMath::CeilToInt(NumOfInputFrames / ResampleStep) + 1) * DestinationNumOfChannels);
+
+		// The frames are mixed to the full destination layout, so that down-mixing folds the source channels the same way as without resampling
+		LeftFrame.SetNumUninitialized(DestinationNumOfChannels, false);
+		RightFrame.SetNumUninitialized(DestinationNumOfChannels, false);
+
+		double Position = ResamplePosition;
+		while (true)
+		{
+			const int32 LeftIndex = FMath::FloorToInt(Position);
+			if (LeftIndex + 1 >= NumOfInputFrames)
+			{
+				break;
+			}
+			const float Alpha = static_cast<float>(Position - LeftIndex);
+
+			if (LeftIndex < 0)
+			{
+				FMemory::Memcpy(LeftFrame.GetData(), LastFrame.GetData(), DestinationNumOfChannels * sizeof(float));
+			}
+			else
+			{
+				MixFrame(PCMData.GetData() + LeftIndex * SourceNumOfChannels, SourceNumOfChannels, LeftFrame.GetData(), DestinationNumOfChannels);
+			}
+			MixFrame(PCMData.GetData() + (LeftIndex + 1) * SourceNumOfChannels, SourceNumOfChannels, RightFrame.GetData(), DestinationNumOfChannels);
+
+			for (int32 ChannelIndex = 0; ChannelIndex < DestinationNumOfChannels; ++ChannelIndex)
+			{
+				OutPCMData.Add(LeftFrame[ChannelIndex] + (RightFrame[ChannelIndex] - LeftFrame[ChannelIndex]) * Alpha);
+			}
+			Position += ResampleStep;
+		}
+
+		MixFrame(PCMData.GetData() + (NumOfInputFrames - 1) * SourceNumOfChannels, SourceNumOfChannels, LastFrame.GetData(), DestinationNumOfChannels);
+		ResamplePosition = Position - NumOfInputFrames;
+	}
+
+private:
+	/**
+	 * Mixes a single interleaved frame to a different number of channels
+	 * Down-mixing averages the source channels folding onto each destination channel, up-mixing repeats the source channels
+	 */
+	static FORCEINLINE void MixFrame(const float* FrameData, int32 SourceNumOfChannels, float* OutFrameData, int32 DestinationNumOfChannels)
+	{
+		if (SourceNumOfChannels <= DestinationNumOfChannels)
+		{
+			for (int32 ChannelIndex = 0; ChannelIndex < DestinationNumOfChannels; ++ChannelIndex)
+			{
+				OutFrameData[ChannelIndex] = FrameData[ChannelIndex % SourceNumOfChannels];
+			}
+			return;
+		}
+
+		for (int32 ChannelIndex = 0; ChannelIndex < DestinationNumOfChannels; ++ChannelIndex)
+		{
+			float Sum = 0.f;
+			int32 NumOfFoldedChannels = 0;
+			for (int32 SourceChannelIndex = ChannelIndex; SourceChannelIndex < SourceNumOfChannels; SourceChannelIndex += DestinationNumOfChannels)
+			{
+				Sum += FrameData[SourceChannelIndex];
+				++NumOfFoldedChannels;
+			}
+			OutFrameData[ChannelIndex] = Sum / NumOfFoldedChannels;
+		}
+	}
+
+	/** Position of the next resampled frame, in input frames relative to the start of the next block */
+	double ResamplePosition;
+
+	/** The last mixed frame of the previous block, used to interpolate across block boundaries */
+	TArray<float> LastFrame;
+
+	/** The mixed frames interpolated between. Kept between blocks so that their allocation is reused */
+	TArray<float> LeftFrame;
+	TArray<float> RightFrame;
+};
@@ -113,6 +113,7 @@ public:
 
 	//~ Begin UImportedSoundWave Interface
 	virtual void PopulateAudioDataFromDecodedInfo(FDecodedAudioStruct&& DecodedAudioInfo) override;
+	virtual bool SetPCMStorageMode(ERuntimePCMStorageMode StorageMode) override;
 	//~ End UImportedSoundWave Interface
 
 protected:
@@ -0,0 +1,255 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+#include "DSP/FloatArrayMath.h"
+#endif
+
+/**
+ * Stages interleaved float PCM data into mono frames suitable for the VAD (Voice Activity Detector)
+ * Mixing to mono and resampling are fused into a single pass that writes straight into a caller-provided staging buffer,
+ * so that staging never allocates. The staging buffer must be able to hold at least MaxFrameNumOfSamples samples
+ */
+struct FRuntimeVADFrameStager
+{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	using FVADVectorRegister = VectorRegister;
+#else
+	using FVADVectorRegister = VectorRegister4Float;
+#endif
+
+	/** Sample rates natively supported by libfvad. Audio at these rates is passed to the VAD without resampling */
+	static constexpr int32 SupportedSampleRates[] = {8000, 16000, 32000, 48000};
+
+	/** The longest frame supported by libfvad (30 ms at 48 kHz), in samples */
+	static constexpr int32 MaxFrameNumOfSamples = 48000 * 30 / 1000;
+
+	FRuntimeVADFrameStager()
+		: IngestedSampleRate(0)
+	  , IngestedNumOfChannels(0)
+	  , NumOfStagedSamples(0)
+	  , ResamplePosition(0)
+	  , LastMonoSample(0.f)
+	{}
+
+	/**
+	 * Gets the sample rate at which the VAD should be applied for the given input sample rate
+	 * Picks the highest natively supported sample rate not exceeding the input one, so that libfvad's own
+	 * band-limited downsampler does the heavy lifting and the linear resampler only has to cover a small ratio
+	 */
+	static int32 GetVADSampleRate(int32 InSampleRate)
+	{
+		int32 VADSampleRate = SupportedSampleRates[0];
+		for (const int32 SupportedSampleRate : SupportedSampleRates)
+		{
+			if (SupportedSampleRate <= InSampleRate)
+			{
+				VADSampleRate = SupportedSampleRate;
+			}
+		}
+		return VADSampleRate;
+	}
+
+	/**
+	 * Converts staged float samples to 16-bit PCM as expected by libfvad
+	 */
+	static void ConvertToPcm16(const float* StagedData, int16* Int16Data, int32 NumOfSamples)
+	{
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+		for (int32 SampleIndex = 0; SampleIndex < NumOfSamples; ++SampleIndex)
+		{
+			Int16Data[SampleIndex] = static_cast<int16>(FMath::Clamp(StagedData[SampleIndex], -1.f, 1.f) * 32767.f);
+		}
+#else
+		Audio::ArrayFloatToPcm16(MakeArrayView(StagedData, NumOfSamples), MakeArrayView(Int16Data, NumOfSamples));
+#endif
+	}
+
+	/**
+	 * Resets the staging state (staged samples and resampler phase)
+	 */
+	void Reset()
+	{
+		IngestedSampleRate = 0;
+		IngestedNumOfChannels = 0;
+		NumOfStagedSamples = 0;
+		ResamplePosition = 0;
+		LastMonoSample = 0.f;
+	}
+
+	/**
+	 * Stages the provided audio data, invoking ProcessFrame every time a full 30 ms frame has been staged
+	 * ProcessFrame is called with the number of samples in the frame and must not retain the staging buffer
+	 *
+	 * @param PCMData PCM audio data in 32-bit floating point interleaved format
+	 * @param InSampleRate The sample rate of the provided PCM data
+	 * @param NumOfChannels The number of channels in the provided PCM data
+	 * @param VADSampleRate The sample rate at which the VAD is applied (see GetVADSampleRate)
+	 * @param StagedData The staging buffer, holding at least MaxFrameNumOfSamples samples
+	 * @param ProcessFrame Callable invoked for each full frame
+	 * @return The number of full frames staged and processed
+	 */
+	template <typename FrameProcessorType>
+	int32 Stage(TArrayView<const float> PCMData, int32 InSampleRate, int32 NumOfChannels, int32 VADSampleRate, float* StagedData, FrameProcessorType&& ProcessFrame)
+	{
+		// Staged samples and the resampler phase only make sense for the input format they were produced from
+		if (IngestedSampleRate != InSampleRate || IngestedNumOfChannels != NumOfChannels)
+		{
+			Reset();
+			IngestedSampleRate = InSampleRate;
+			IngestedNumOfChannels = NumOfChannels;
+		}
+
+		const int32 FrameNumOfSamples = VADSampleRate * 30 / 1000;
+		const int32 NumOfInputFrames = PCMData.Num() / NumOfChannels;
+		const float* InputData = PCMData.GetData();
+		const float ChannelGain = 1.f / NumOfChannels;
+		int32 NumOfProcessedFrames = 0;
+
+		if (NumOfInputFrames <= 0)
+		{
+			return 0;
+		}
+
+		auto FlushFullFrame = [this, FrameNumOfSamples, &ProcessFrame, &NumOfProcessedFrames]()
+		{
+			if (NumOfStagedSamples == FrameNumOfSamples)
+			{
+				ProcessFrame(FrameNumOfSamples);
+				NumOfStagedSamples = 0;
+				++NumOfProcessedFrames;
+			}
+		};
+
+		if (InSampleRate == VADSampleRate)
+		{
+			int32 InputFrameIndex = 0;
+			while (InputFrameIndex < NumOfInputFrames)
+			{
+				const int32 NumOfFramesToStage = FMath::Min(FrameNumOfSamples - NumOfStagedSamples, NumOfInputFrames - InputFrameIndex);
+				MixBlockToMono(InputData + InputFrameIndex * NumOfChannels, StagedData + NumOfStagedSamples, NumOfFramesToStage, NumOfChannels, ChannelGain);
+				NumOfStagedSamples += NumOfFramesToStage;
+				InputFrameIndex += NumOfFramesToStage;
+				FlushFullFrame();
+			}
+		}
+		else
+		{
+			// Linear interpolation between adjacent mono frames. Index -1 refers to the last frame of the previous block
+			const double ResampleStep = static_cast<double>(InSampleRate) / VADSampleRate;
+			double Position = ResamplePosition;
+			while (true)
+			{
+				const int32 LeftIndex = FMath::FloorToInt(Position);
+				if (LeftIndex + 1 >= NumOfInputFrames)
+				{
+					break;
+				}
+				const float Alpha = static_cast<float>(Position - LeftIndex);
+				const float LeftSample = LeftIndex < 0 ? LastMonoSample : MixFrameToMono(InputData + LeftIndex * NumOfChannels, NumOfChannels, ChannelGain);
+				const float RightSample = MixFrameToMono(InputData + (LeftIndex + 1) * NumOfChannels, NumOfChannels, ChannelGain);
+
+				StagedData[NumOfStagedSamples++] = LeftSample + (RightSample - LeftSample) * Alpha;
+				Position += ResampleStep;
+				FlushFullFrame();
+			}
+			LastMonoSample = MixFrameToMono(InputData + (NumOfInputFrames - 1) * NumOfChannels, NumOfChannels, ChannelGain);
+			ResamplePosition = Position - NumOfInputFrames;
+		}
+
+		return NumOfProcessedFrames;
+	}
+
+	/**
+	 * Gets the number of samples of the longest partial (10 or 20 ms) frame that can be processed from the staged data
+	 *
+	 * @param VADSampleRate The sample rate at which the VAD is applied
+	 * @return The number of samples, or 0 if less than 10 ms is staged
+	 */
+	int32 GetPartialFrameNumOfSamples(int32 VADSampleRate) const
+	{
+		const int32 StagedLengthMs = NumOfStagedSamples * 1000 / VADSampleRate;
+		const int32 ValidLengthMs = StagedLengthMs >= 20 ? 20 : StagedLengthMs >= 10 ? 10 : 0;
+		return ValidLengthMs * VADSampleRate / 1000;
+	}
+
+	/**
+	 * Removes the first NumOfSamples samples from the staging buffer after they have been processed as a partial frame
+	 * This moves less than a frame of data and never allocates
+	 */
+	void ConsumePartialFrame(float* StagedData, int32 NumOfSamples)
+	{
+		check(NumOfSamples <= NumOfStagedSamples);
+		const int32 NumOfRemainingSamples = NumOfStagedSamples - NumOfSamples;
+		if (NumOfRemainingSamples > 0)
+		{
+			FMemory::Memmove(StagedData, StagedData + NumOfSamples, NumOfRemainingSamples * sizeof(float));
+		}
+		NumOfStagedSamples = NumOfRemainingSamples;
+	}
+
+	/** The sample rate of the most recently staged audio data. Used to detect input format changes */
+	int32 IngestedSampleRate;
+
+	/** The number of channels of the most recently staged audio data. Used to detect input format changes */
+	int32 IngestedNumOfChannels;
+
+	/** The number of valid samples in the staging buffer */
+	int32 NumOfStagedSamples;
+
+	/** Position of the next resampled sample, in input frames relative to the start of the next staged block */
+	double ResamplePosition;
+
+	/** The last mono sample of the previously staged block, used to interpolate across block boundaries */
+	float LastMonoSample;
+
+	/**
+	 * Mixes a block of interleaved frames down to mono
+	 * Mono input is copied as is, stereo input (the most common capture format) is mixed four frames at a time with SIMD
+	 */
+	static void MixBlockToMono(const float* InputData, float* MonoData, int32 NumOfFrames, int32 NumOfChannels, float ChannelGain)
+	{
+		if (NumOfChannels == 1)
+		{
+			FMemory::Memcpy(MonoData, InputData, NumOfFrames * sizeof(float));
+			return;
+		}
+
+		int32 FrameIndex = 0;
+		if (NumOfChannels == 2)
+		{
+			const FVADVectorRegister Gain = VectorSetFloat1(ChannelGain);
+			for (; FrameIndex + 4 <= NumOfFrames; FrameIndex += 4)
+			{
+				// L0 R0 L1 R1 | L2 R2 L3 R3 -> (L0 L1 L2 L3) + (R0 R1 R2 R3)
+				const FVADVectorRegister First = VectorLoad(InputData + FrameIndex * 2);
+				const FVADVectorRegister Second = VectorLoad(InputData + FrameIndex * 2 + 4);
+				const FVADVectorRegister Left = VectorShuffle(First, Second, 0, 2, 0, 2);
+				const FVADVectorRegister Right = VectorShuffle(First, Second, 1, 3, 1, 3);
+				VectorStore(VectorMultiply(VectorAdd(Left, Right), Gain), MonoData + FrameIndex);
+			}
+		}
+
+		for (; FrameIndex < NumOfFrames; ++FrameIndex)
+		{
+			MonoData[FrameIndex] = MixFrameToMono(InputData + FrameIndex * NumOfChannels, NumOfChannels, ChannelGain);
+		}
+	}
+
+private:
+	/**
+	 * Mixes a single interleaved frame down to mono
+	 */
+	static FORCEINLINE float MixFrameToMono(const float* FrameData, int32 NumOfChannels, float ChannelGain)
+	{
+		float Sum = 0.f;
+		for (int32 ChannelIndex = 0; ChannelIndex < NumOfChannels; ++ChannelIndex)
+		{
+			Sum += FrameData[ChannelIndex];
+		}
+		return Sum * ChannelGain;
+	}
+};
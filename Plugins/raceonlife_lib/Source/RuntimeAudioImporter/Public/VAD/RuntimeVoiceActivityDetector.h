@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "SampleBuffer.h"
+#include "VAD/RuntimeVADFrameStager.h"
 #include "RuntimeVoiceActivityDetector.generated.h"
 
 enum class ERuntimeVADMode : uint8;
@@ -59,9 +61,29 @@ public:
 	 * @return True if the VAD decision was successfully calculated
 	 */
 	UFUNCTION(BlueprintCallable, meta = (Keywords = "Voice Activity Detector Process"), Category = "Voice Activity Detector")
-	bool ProcessVAD(TArray<float> PCMData, UPARAM(DisplayName = "Sample Rate") int32 InSampleRate, int32 NumOfChannels);
+	bool ProcessVAD(const TArray<float>& PCMData, UPARAM(DisplayName = "Sample Rate") int32 InSampleRate, int32 NumOfChannels);
+
+	/**
+	 * Calculates a VAD (Voice Activity Detection) decision for audio data without copying it
+	 * Mixing to mono, resampling and conversion to 16-bit PCM are fused into a single pass into a preallocated frame buffer,
+	 * so no allocations happen once the detector has been created
+	 *
+	 * @param PCMData PCM audio data in 32-bit floating point interleaved format
+	 * @param InSampleRate The sample rate of the provided PCM data
+	 * @param NumOfChannels The number of channels in the provided PCM data
+	 * @return True if voice activity was detected in any of the frames processed during this call
+	 */
+	bool ProcessVAD(TArrayView<const float> PCMData, int32 InSampleRate, int32 NumOfChannels);
 
 protected:
+	/**
+	 * Runs the VAD on the first NumOfSamples staged samples
+	 *
+	 * @param NumOfSamples The number of samples to process. Must correspond to 10, 20 or 30 ms at the applied sample rate
+	 * @return 1 if voice activity was detected, 0 if not, -1 on error
+	 */
+	int32 ProcessStagedFrame(int32 NumOfSamples);
+
 	/** The sample rate at which the VAD is currently applied */
 	int32 AppliedSampleRate;
 
@@ -71,9 +93,15 @@ protected:
 #endif
 
 	/**
-	 * The accumulated PCM data used for VAD processing. Reset after each VAD decision
+	 * Stages the provided PCM data into VAD frames
 	 * VAD requires frames with a length of 10, 20, or 30 ms. Therefore, if the provided data does not match these lengths,
 	 * we need to either accumulate data (if too short) or split data (if too long) to match the required frame length
 	 */
-	TArray<int16> AccumulatedPCMData;
+	FRuntimeVADFrameStager FrameStager;
+
+	/** The mono PCM data staged for VAD processing, at the applied sample rate. Preallocated to hold the longest supported frame */
+	Audio::FAlignedFloatBuffer StagedPCMData;
+
+	/** The staged frame converted to 16-bit PCM, as expected by the VAD. Preallocated to the same size as StagedPCMData */
+	TArray<int16> Int16FrameData;
 };
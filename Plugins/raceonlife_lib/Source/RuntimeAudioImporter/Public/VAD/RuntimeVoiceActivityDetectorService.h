@@ -0,0 +1,161 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SampleBuffer.h"
+#include "Templates/SharedPointer.h"
+#include "VAD/RuntimeVADFrameStager.h"
+
+enum class ERuntimeVADMode : uint8;
+
+namespace FVAD_RuntimeAudioImporter
+{
+	struct Fvad;
+}
+
+/** Static delegate broadcasting the VAD decisions of a processed audio block, one per stream (indexed by stream handle) */
+DECLARE_DELEGATE_OneParam(FOnVADBlockProcessedNative, const TArray<bool>&);
+
+/**
+ * Runtime Voice Activity Detector Service
+ * Runs VAD (Voice Activity Detection) for many audio streams at once, e.g. for all participants of a voice chat
+ * Instead of one pipeline per stream running on whichever thread feeds it, all streams of an audio block are processed by a single
+ * worker task, with per-stream state kept in contiguous arrays and a single set of scratch buffers shared by all streams
+ * The GMM (Gaussian Mixture Model) of libfvad is evaluated across streams: the frames of all streams are first reduced to their features,
+ * then the Gaussian probabilities of all of them are evaluated together with SIMD, and only then is the decision of each stream made
+ * The decisions are identical to those of URuntimeVoiceActivityDetector fed with the same data
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeVoiceActivityDetectorService : public TSharedFromThis<FRuntimeVoiceActivityDetectorService, ESPMode::ThreadSafe>
+{
+public:
+	FRuntimeVoiceActivityDetectorService();
+	~FRuntimeVoiceActivityDetectorService();
+
+	FRuntimeVoiceActivityDetectorService(const FRuntimeVoiceActivityDetectorService&) = delete;
+	FRuntimeVoiceActivityDetectorService& operator=(const FRuntimeVoiceActivityDetectorService&) = delete;
+
+	/**
+	 * Adds a stream to the service. Freed stream handles are reused
+	 *
+	 * @param Mode The VAD mode to use for the stream
+	 * @return The stream handle, or INDEX_NONE if the VAD instance could not be created
+	 */
+	int32 AddStream(ERuntimeVADMode Mode);
+
+	/**
+	 * Removes a stream from the service
+	 *
+	 * @param StreamHandle The stream handle returned by AddStream
+	 */
+	void RemoveStream(int32 StreamHandle);
+
+	/**
+	 * Reinitializes the VAD state of a stream, clearing all state and resetting mode and sample rate to defaults
+	 *
+	 * @param StreamHandle The stream handle returned by AddStream
+	 * @return True if the stream was successfully reset
+	 */
+	bool ResetStream(int32 StreamHandle);
+
+	/**
+	 * Changes the operating ("aggressiveness") mode of a stream
+	 *
+	 * @param StreamHandle The stream handle returned by AddStream
+	 * @param Mode The VAD mode to set
+	 * @return True if the VAD mode was successfully set
+	 */
+	bool SetStreamMode(int32 StreamHandle, ERuntimeVADMode Mode);
+
+	/**
+	 * Gets the number of stream slots (the size of the decision arrays produced by ProcessBlock)
+	 */
+	int32 GetNumOfStreamSlots() const;
+
+	/**
+	 * Processes one audio block for all streams on the calling thread
+	 * Streams without data in this block (empty view) or removed streams keep their state and get a negative decision
+	 *
+	 * @param StreamPCMData PCM audio data in 32-bit floating point interleaved format, indexed by stream handle
+	 * @param InSampleRate The sample rate of the provided PCM data, shared by all streams
+	 * @param NumOfChannels The number of channels in the provided PCM data, shared by all streams
+	 * @param OutVoiceDetected Filled with the VAD decision of each stream, indexed by stream handle
+	 * @return True if the block was successfully processed
+	 */
+	bool ProcessBlock(TArrayView<const TArrayView<const float>> StreamPCMData, int32 InSampleRate, int32 NumOfChannels, TArray<bool>& OutVoiceDetected);
+
+	/**
+	 * Processes one audio block for all streams in a single background worker task
+	 * The result is broadcast on the game thread
+	 *
+	 * @param StreamPCMData PCM audio data in 32-bit floating point interleaved format, indexed by stream handle
+	 * @param InSampleRate The sample rate of the provided PCM data, shared by all streams
+	 * @param NumOfChannels The number of channels in the provided PCM data, shared by all streams
+	 * @param Result Delegate broadcasting the VAD decision of each stream
+	 */
+	void ProcessBlockAsync(TArray<TArray<float>> StreamPCMData, int32 InSampleRate, int32 NumOfChannels, const FOnVADBlockProcessedNative& Result);
+
+	/**
+	 * Evaluates libfvad's Gaussian probability (WebRtcVad_GaussianProbability) for many arguments at once, four at a time with SIMD
+	 * The results are bit-exact with the fixed-point scalar implementation
+	 *
+	 * @param Inputs The feature values, in Q4
+	 * @param Means The Gaussian means, in Q7
+	 * @param Stds The Gaussian standard deviations, in Q7. Must be positive
+	 * @param OutProbabilities Filled with the probabilities, in Q20
+	 * @param OutDeltas Filled with the deltas used by the model update, in Q11
+	 * @param NumOfEvaluations The number of values in each array
+	 */
+	static void EvaluateGaussianProbabilities(const int32* Inputs, const int32* Means, const int32* Stds, int32* OutProbabilities, int32* OutDeltas, int32 NumOfEvaluations);
+
+private:
+	/**
+	 * Extracts the features of the first NumOfSamples staged samples of a stream and queues the frame for the batched GMM evaluation
+	 * Frames that do not need the GMM are decided right away
+	 */
+	void QueueStagedFrame(int32 StreamHandle, int32 NumOfSamples, TArray<bool>& OutVoiceDetected);
+
+	/**
+	 * Evaluates the Gaussian probabilities of all queued frames together and makes their VAD decisions
+	 */
+	void FlushQueuedFrames(TArray<bool>& OutVoiceDetected);
+
+	/** Guards the stream arrays against concurrent block processing and stream addition/removal */
+	mutable FCriticalSection DataGuard;
+
+#if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
+	/** The VAD instances, indexed by stream handle. Null for free slots */
+	TArray<FVAD_RuntimeAudioImporter::Fvad*> VADInstances;
+#endif
+
+	/** The sample rates at which the VAD instances are currently applied, indexed by stream handle */
+	TArray<int32> AppliedSampleRates;
+
+	/** The frame stagers, indexed by stream handle */
+	TArray<FRuntimeVADFrameStager> FrameStagers;
+
+	/** Staging storage of all streams. The staging buffer of a stream starts at StreamHandle * FRuntimeVADFrameStager::MaxFrameNumOfSamples */
+	Audio::FAlignedFloatBuffer StagedPCMData;
+
+	/** The staged frame converted to 16-bit PCM. Shared by all streams since features are extracted one frame at a time */
+	TArray<int16> Int16FrameData;
+
+	/** The streams whose frame is queued for the batched GMM evaluation, in queue order */
+	TArray<int32> QueuedStreamHandles;
+
+	/** The queue position of the frame of each stream, INDEX_NONE if none is queued. Indexed by stream handle */
+	TArray<int32> QueuedFrameIndices;
+
+	/**
+	 * Arguments and results of the batched Gaussian evaluations, in structure-of-arrays layout
+	 * The evaluations of the frame at queue position N start at N * FVAD_NUM_GAUSSIANS_PER_FRAME. Sized for all stream slots so that processing never allocates
+	 */
+	TArray<int32> GaussianInputs;
+	TArray<int32> GaussianMeans;
+	TArray<int32> GaussianStds;
+	TArray<int32> GaussianProbabilities;
+	TArray<int32> GaussianDeltas;
+
+	/** Stream handles that have been removed and can be reused */
+	TArray<int32> FreeStreamHandles;
+};
@@ -89,6 +89,47 @@ int fvad_set_sample_rate(Fvad* inst, int sample_rate);
  */
 int fvad_process(Fvad* inst, const int16_t* frame, size_t length);
 
+
+/*
+ * RuntimeAudioImporter: fvad_process() split in two, so that the Gaussian
+ * probabilities of many VAD instances can be evaluated together in between.
+ *
+ * The number of Gaussian evaluations needed by one frame.
+ */
+enum { FVAD_NUM_GAUSSIANS_PER_FRAME = 24 };
+
+/*
+ * Downsamples an audio frame and extracts its features, same frame
+ * requirements as fvad_process(). Must be followed by fvad_process_decision()
+ * before the next frame of the same instance.
+ *
+ * If the frame has enough energy for the GMM to be evaluated, `inputs`,
+ * `means` and `stds` (FVAD_NUM_GAUSSIANS_PER_FRAME values each) are filled with
+ * the arguments of the Gaussian evaluations: the noise model first, then the
+ * speech model.
+ *
+ * Returns              : 1 - (Gaussians must be evaluated),
+ *                        0 - (no Gaussian evaluation needed),
+ *                       -1 - (invalid frame length).
+ */
+int fvad_process_features(Fvad* inst, const int16_t* frame, size_t length,
+                          int32_t* inputs, int32_t* means, int32_t* stds);
+
+/*
+ * Calculates the VAD decision of the frame passed to fvad_process_features()
+ * and updates the models.
+ *
+ * `probabilities` and `deltas` hold the results of the Gaussian evaluations
+ * requested by fvad_process_features(), in the same order, or are NULL if none
+ * were requested.
+ *
+ * Returns              : 1 - (active voice),
+ *                        0 - (non-active Voice),
+ *                       -1 - (no pending frame).
+ */
+int fvad_process_decision(Fvad* inst, const int32_t* probabilities,
+                          const int32_t* deltas);
+
 #ifdef __cplusplus
 }
 #endif
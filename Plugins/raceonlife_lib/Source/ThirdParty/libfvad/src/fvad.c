@@ -25,6 +25,14 @@ static int (*const process_funcs[])(VadInstT*, const int16_t*, size_t) = {
     WebRtcVad_CalcVad48khz,
 };
 
+// RuntimeAudioImporter: feature extraction functions for each valid sample rate
+static size_t (*const features_funcs[])(VadInstT*, const int16_t*, size_t) = {
+    WebRtcVad_CalcFeatures8khz,
+    WebRtcVad_CalcFeatures16khz,
+    WebRtcVad_CalcFeatures32khz,
+    WebRtcVad_CalcFeatures48khz,
+};
+
 // valid frame lengths in ms
 static const size_t valid_frame_times[] = { 10, 20, 30 };
 
@@ -32,6 +40,7 @@ static const size_t valid_frame_times[] = { 10, 20, 30 };
 struct Fvad {
     VadInstT core;
     size_t rate_idx; // index in valid_rates and process_funcs arrays
+    size_t pending_length; // RuntimeAudioImporter: 8 kHz length of the frame awaiting fvad_process_decision(), 0 if none
 };
 
 
@@ -57,6 +66,7 @@ void fvad_reset(Fvad *inst)
     int rv = WebRtcVad_InitCore(&inst->core);
     assert(rv == 0);
     inst->rate_idx = 0;
+    inst->pending_length = 0;
 }
 
 
@@ -105,3 +115,47 @@ int fvad_process(Fvad* inst, const int16_t* frame, size_t length)
 
     return rv;
 }
+
+
+int fvad_process_features(Fvad* inst, const int16_t* frame, size_t length,
+                          int32_t* inputs, int32_t* means, int32_t* stds)
+{
+    assert(inst);
+    if (!valid_length(inst->rate_idx, length))
+        return -1;
+
+    VadInstT* core = &inst->core;
+    inst->pending_length = features_funcs[inst->rate_idx](core, frame, length);
+
+    // Same condition as in GmmProbability(), below it the GMM is not evaluated
+    if (core->total_power <= kMinEnergy)
+        return 0;
+
+    for (int gaussian = 0; gaussian < kTableSize; gaussian++) {
+        int32_t input = core->feature_vector[gaussian % kNumChannels];
+        inputs[gaussian] = input;
+        means[gaussian] = core->noise_means[gaussian];
+        stds[gaussian] = core->noise_stds[gaussian];
+        inputs[kTableSize + gaussian] = input;
+        means[kTableSize + gaussian] = core->speech_means[gaussian];
+        stds[kTableSize + gaussian] = core->speech_stds[gaussian];
+    }
+    return 1;
+}
+
+
+int fvad_process_decision(Fvad* inst, const int32_t* probabilities,
+                          const int32_t* deltas)
+{
+    assert(inst);
+    if (inst->pending_length == 0)
+        return -1;
+
+    int rv = WebRtcVad_CalcDecision(&inst->core, inst->pending_length,
+                                    probabilities, deltas);
+    assert (rv >= 0);
+    if (rv > 0) rv = 1;
+
+    inst->pending_length = 0;
+    return rv;
+}
@@ -126,10 +126,17 @@ static inline int32_t RTC_NO_SANITIZE("signed-integer-overflow")
 //                          = log10(energy in frequency band)
 // - total_power    [i]   : Total power in audio frame.
 // - frame_length   [i]   : Number of input samples
+// - gaussian_probabilities [i] : RuntimeAudioImporter: optional precomputed
+//                          WebRtcVad_GaussianProbability() results, noise
+//                          model first, then speech model (2 * kTableSize).
+//                          NULL to compute them here.
+// - gaussian_deltas [i]  : RuntimeAudioImporter: the matching |delta| outputs.
 //
 // - returns              : the VAD decision (0 - noise, 1 - speech).
 static int16_t GmmProbability(VadInstT* self, int16_t* features,
-                              int16_t total_power, size_t frame_length) {
+                              int16_t total_power, size_t frame_length,
+                              const int32_t* gaussian_probabilities,
+                              const int32_t* gaussian_deltas) {
   int channel, k;
   int16_t feature_minimum;
   int16_t h0, h1;
@@ -192,19 +199,29 @@ static int16_t GmmProbability(VadInstT* self, int16_t* features,
         gaussian = channel + k * kNumChannels;
         // Probability under H0, that is, probability of frame being noise.
         // Value given in Q27 = Q7 * Q20.
-        tmp1_s32 = WebRtcVad_GaussianProbability(features[channel],
-                                                 self->noise_means[gaussian],
-                                                 self->noise_stds[gaussian],
-                                                 &deltaN[gaussian]);
+        if (gaussian_probabilities) {
+          tmp1_s32 = gaussian_probabilities[gaussian];
+          deltaN[gaussian] = (int16_t)gaussian_deltas[gaussian];
+        } else {
+          tmp1_s32 = WebRtcVad_GaussianProbability(features[channel],
+                                                   self->noise_means[gaussian],
+                                                   self->noise_stds[gaussian],
+                                                   &deltaN[gaussian]);
+        }
         noise_probability[k] = kNoiseDataWeights[gaussian] * tmp1_s32;
         h0_test += noise_probability[k];  // Q27
 
         // Probability under H1, that is, probability of frame being speech.
         // Value given in Q27 = Q7 * Q20.
-        tmp1_s32 = WebRtcVad_GaussianProbability(features[channel],
-                                                 self->speech_means[gaussian],
-                                                 self->speech_stds[gaussian],
-                                                 &deltaS[gaussian]);
+        if (gaussian_probabilities) {
+          tmp1_s32 = gaussian_probabilities[kTableSize + gaussian];
+          deltaS[gaussian] = (int16_t)gaussian_deltas[kTableSize + gaussian];
+        } else {
+          tmp1_s32 = WebRtcVad_GaussianProbability(features[channel],
+                                                   self->speech_means[gaussian],
+                                                   self->speech_stds[gaussian],
+                                                   &deltaS[gaussian]);
+        }
         speech_probability[k] = kSpeechDataWeights[gaussian] * tmp1_s32;
         h1_test += speech_probability[k];  // Q27
       }
@@ -601,10 +618,12 @@ int WebRtcVad_set_mode_core(VadInstT* self, int mode) {
 
 // Calculate VAD decision by first extracting feature values and then calculate
 // probability for both speech and background noise.
+//
+// RuntimeAudioImporter: the two steps are split so that the Gaussian
+// probabilities of many instances can be evaluated together between them.
 
-int WebRtcVad_CalcVad48khz(VadInstT* inst, const int16_t* speech_frame,
-                           size_t frame_length) {
-  int vad;
+size_t WebRtcVad_CalcFeatures48khz(VadInstT* inst, const int16_t* speech_frame,
+                                   size_t frame_length) {
   size_t i;
   int16_t speech_nb[240];  // 30 ms in 8 kHz.
   // |tmp_mem| is a temporary memory used by resample function, length is
@@ -621,17 +640,14 @@ int WebRtcVad_CalcVad48khz(VadInstT* inst, const int16_t* speech_frame,
                                   tmp_mem);
   }
 
-  // Do VAD on an 8 kHz signal
-  vad = WebRtcVad_CalcVad8khz(inst, speech_nb, frame_length / 6);
-
-  return vad;
+  // Extract the features of an 8 kHz signal
+  return WebRtcVad_CalcFeatures8khz(inst, speech_nb, frame_length / 6);
 }
 
-int WebRtcVad_CalcVad32khz(VadInstT* inst, const int16_t* speech_frame,
-                           size_t frame_length)
+size_t WebRtcVad_CalcFeatures32khz(VadInstT* inst, const int16_t* speech_frame,
+                                   size_t frame_length)
 {
     size_t len;
-    int vad;
     int16_t speechWB[480]; // Downsampled speech frame: 960 samples (30ms in SWB)
     int16_t speechNB[240]; // Downsampled speech frame: 480 samples (30ms in WB)
 
@@ -644,17 +660,14 @@ int WebRtcVad_CalcVad32khz(VadInstT* inst, const int16_t* speech_frame,
     WebRtcVad_Downsampling(speechWB, speechNB, inst->downsampling_filter_states, len);
     len /= 2;
 
-    // Do VAD on an 8 kHz signal
-    vad = WebRtcVad_CalcVad8khz(inst, speechNB, len);
-
-    return vad;
+    // Extract the features of an 8 kHz signal
+    return WebRtcVad_CalcFeatures8khz(inst, speechNB, len);
 }
 
-int WebRtcVad_CalcVad16khz(VadInstT* inst, const int16_t* speech_frame,
-                           size_t frame_length)
+size_t WebRtcVad_CalcFeatures16khz(VadInstT* inst, const int16_t* speech_frame,
+                                   size_t frame_length)
 {
     size_t len;
-    int vad;
     int16_t speechNB[240]; // Downsampled speech frame: 480 samples (30ms in WB)
 
     // Wideband: Downsample signal before doing VAD
@@ -662,21 +675,51 @@ int WebRtcVad_CalcVad16khz(VadInstT* inst, const int16_t* speech_frame,
                            frame_length);
 
     len = frame_length / 2;
-    vad = WebRtcVad_CalcVad8khz(inst, speechNB, len);
-
-    return vad;
+    return WebRtcVad_CalcFeatures8khz(inst, speechNB, len);
 }
 
-int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
-                          size_t frame_length)
+size_t WebRtcVad_CalcFeatures8khz(VadInstT* inst, const int16_t* speech_frame,
+                                  size_t frame_length)
 {
 
     // Get power in the bands
     inst->total_power = WebRtcVad_CalculateFeatures(inst, speech_frame, frame_length,
                                               inst->feature_vector);
 
+    return frame_length;
+}
+
+int WebRtcVad_CalcDecision(VadInstT* inst, size_t frame_length,
+                           const int32_t* gaussian_probabilities,
+                           const int32_t* gaussian_deltas)
+{
     // Make a VAD
-    inst->vad = GmmProbability(inst, inst->feature_vector, inst->total_power, frame_length);
+    inst->vad = GmmProbability(inst, inst->feature_vector, inst->total_power, frame_length,
+                               gaussian_probabilities, gaussian_deltas);
 
     return inst->vad;
 }
+
+int WebRtcVad_CalcVad48khz(VadInstT* inst, const int16_t* speech_frame,
+                           size_t frame_length)
+{
+    return WebRtcVad_CalcDecision(inst, WebRtcVad_CalcFeatures48khz(inst, speech_frame, frame_length), NULL, NULL);
+}
+
+int WebRtcVad_CalcVad32khz(VadInstT* inst, const int16_t* speech_frame,
+                           size_t frame_length)
+{
+    return WebRtcVad_CalcDecision(inst, WebRtcVad_CalcFeatures32khz(inst, speech_frame, frame_length), NULL, NULL);
+}
+
+int WebRtcVad_CalcVad16khz(VadInstT* inst, const int16_t* speech_frame,
+                           size_t frame_length)
+{
+    return WebRtcVad_CalcDecision(inst, WebRtcVad_CalcFeatures16khz(inst, speech_frame, frame_length), NULL, NULL);
+}
+
+int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
+                          size_t frame_length)
+{
+    return WebRtcVad_CalcDecision(inst, WebRtcVad_CalcFeatures8khz(inst, speech_frame, frame_length), NULL, NULL);
+}
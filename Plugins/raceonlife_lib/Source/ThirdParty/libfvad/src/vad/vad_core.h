@@ -111,4 +111,28 @@ int WebRtcVad_CalcVad16khz(VadInstT* inst, const int16_t* speech_frame,
 int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
                           size_t frame_length);
 
+/****************************************************************************
+ * RuntimeAudioImporter: the two halves of WebRtcVad_CalcVadXkhz().
+ *
+ * WebRtcVad_CalcFeaturesXkhz() downsamples |speech_frame| to 8 kHz and
+ * extracts its features into |inst|. Returns the frame length at 8 kHz.
+ *
+ * WebRtcVad_CalcDecision() runs the GMM on the extracted features and updates
+ * the models. |gaussian_probabilities| and |gaussian_deltas| optionally hold
+ * the precomputed WebRtcVad_GaussianProbability() results of the noise model
+ * followed by those of the speech model (2 * kTableSize each), NULL to compute
+ * them. Returns the VAD decision like WebRtcVad_CalcVadXkhz().
+ */
+size_t WebRtcVad_CalcFeatures48khz(VadInstT* inst, const int16_t* speech_frame,
+                                   size_t frame_length);
+size_t WebRtcVad_CalcFeatures32khz(VadInstT* inst, const int16_t* speech_frame,
+                                   size_t frame_length);
+size_t WebRtcVad_CalcFeatures16khz(VadInstT* inst, const int16_t* speech_frame,
+                                   size_t frame_length);
+size_t WebRtcVad_CalcFeatures8khz(VadInstT* inst, const int16_t* speech_frame,
+                                  size_t frame_length);
+int WebRtcVad_CalcDecision(VadInstT* inst, size_t frame_length,
+                           const int32_t* gaussian_probabilities,
+                           const int32_t* gaussian_deltas);
+
 #endif  // COMMON_AUDIO_VAD_VAD_CORE_H_
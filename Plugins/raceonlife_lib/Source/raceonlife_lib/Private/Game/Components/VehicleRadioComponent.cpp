@@ -1,4 +1,5 @@
 #include "Game/Components/VehicleRadioComponent.h"
+#include "Game/Music/MusicLibraryIndex.h"
 #include "Misc/FileHelper.h"
 #include "Sound/SoundWave.h"
 #include "Engine/Texture2D.h"
@@ -18,8 +19,12 @@
 #include "UObject/ConstructorHelpers.h"
 
 UVehicleRadioComponent::UVehicleRadioComponent()
+    : CurrentTrackIndex(INDEX_NONE)
+    , CrossfadeDuration(0.f)
+    , bIsRepeatEnabled(false)
+    , MusicVolume(1.f)
+    , MusicLibraryIndex(nullptr)
 {
-    // maybe there will be something here, but it's unlikely. kek
 }
 
 void UVehicleRadioComponent::BeginPlay()
@@ -34,35 +39,136 @@ void UVehicleRadioComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 
 void UVehicleRadioComponent::PlayTrack(FMusicStruct MusicData, USoundAttenuation* AttenuationSettings)
 {
+    // Tracks from the music library are only decoded when they are about to be played
+    if (!MusicData.MusicReference && !MusicData.MusicFilePath.IsEmpty())
+    {
+        if (UImportedSoundWave** DecodedTrack = DecodedTracks.Find(MusicData.MusicFilePath))
+        {
+            MusicData.MusicReference = *DecodedTrack;
+        }
+        else
+        {
+            AwaitedTrackFilePath = MusicData.MusicFilePath;
+            TWeakObjectPtr<USoundAttenuation> WeakAttenuationSettings = AttenuationSettings;
+            DecodeTrack(MusicData.MusicFilePath, ERuntimeImportPriority::High, [WeakThis = MakeWeakObjectPtr(this), MusicData, WeakAttenuationSettings](UImportedSoundWave* SoundWave) mutable
+            {
+                // Ignore decodes of tracks the user has already skipped
+                if (!WeakThis.IsValid() || !SoundWave || WeakThis->AwaitedTrackFilePath != MusicData.MusicFilePath)
+                {
+                    return;
+                }
+                MusicData.MusicReference = SoundWave;
+                WeakThis->PlayTrack(MusicData, WeakAttenuationSettings.Get());
+            });
+            return;
+        }
+    }
+
     if (!MusicData.MusicReference)
     {
         UE_LOG(LogTemp, Warning, TEXT("No music reference provided!"));
         return;
     }
 
+    UAudioComponent* AudioComponent = GetRadioAudioComponent(false);
+    if (!AudioComponent)
+    {
+        return;
+    }
+
+    if (AudioComponent->IsPlaying())
+    {
+        UAudioComponent* FadeOutComponent = CrossfadeDuration > 0.f ? GetRadioAudioComponent(true) : nullptr;
+        if (FadeOutComponent)
+        {
+            // Swap roles so that the previous track fades out on its own component while the new one fades in
+            FadeOutComponent->Stop();
+            RadioAudioComponent = FadeOutComponent;
+            CrossfadeAudioComponent = AudioComponent;
+            AudioComponent->FadeOut(CrossfadeDuration, 0.f, EAudioFaderCurve::Sin);
+            AudioComponent = FadeOutComponent;
+        }
+        else
+        {
+            AudioComponent->Stop();
+        }
+    }
+
+    AudioComponent->SetSound(MusicData.MusicReference);
+    if (AttenuationSettings)
+    {
+        AudioComponent->AttenuationSettings = AttenuationSettings;
+    }
+
+    if (CrossfadeDuration > 0.f && CrossfadeAudioComponent.IsValid() && CrossfadeAudioComponent->IsPlaying())
+    {
+        AudioComponent->FadeIn(CrossfadeDuration, 1.f, 0.f, EAudioFaderCurve::Sin);
+    }
+    else
+    {
+        AudioComponent->Play();
+    }
+    CurrentPlayingMusic = MusicData;
+    AwaitedTrackFilePath.Reset();
+
+    PrefetchNextTrack();
+}
+
+void UVehicleRadioComponent::PlayTrackAtIndex(int32 TrackIndex, USoundAttenuation* AttenuationSettings)
+{
+    if (!ImportedMusic.IsValidIndex(TrackIndex))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Track index %d is out of range!"), TrackIndex);
+        return;
+    }
+
+    CurrentTrackIndex = TrackIndex;
+    PlayTrack(ImportedMusic[TrackIndex], AttenuationSettings);
+}
+
+UAudioComponent* UVehicleRadioComponent::GetRadioAudioComponent(bool bCrossfadeComponent)
+{
+    TWeakObjectPtr<UAudioComponent>& CachedComponent = bCrossfadeComponent ? CrossfadeAudioComponent : RadioAudioComponent;
+
     APlayerController* Owner = Cast<APlayerController>(GetOwner());
     if (!Owner)
     {
         UE_LOG(LogTemp, Warning, TEXT("Owner not found!"));
-        return;
+        return nullptr;
     }
 
     APawn* ControlledPawn = Cast<APawn>(Owner->GetPawn());
     if (!ControlledPawn)
     {
         UE_LOG(LogTemp, Warning, TEXT("Owner is not a controlled pawn!"));
-        return;
+        return nullptr;
+    }
+
+    if (CachedComponent.IsValid() && CachedComponent->GetOwner() == ControlledPawn)
+    {
+        return CachedComponent.Get();
+    }
+
+    // The pawn has changed (or this is the first track), so the other cached component is stale too
+    if (RadioAudioComponent.IsValid() && RadioAudioComponent->GetOwner() != ControlledPawn)
+    {
+        RadioAudioComponent->Stop();
+        RadioAudioComponent.Reset();
+    }
+    if (CrossfadeAudioComponent.IsValid() && CrossfadeAudioComponent->GetOwner() != ControlledPawn)
+    {
+        CrossfadeAudioComponent->Stop();
+        CrossfadeAudioComponent.Reset();
     }
 
     UMeshComponent* Mesh = ControlledPawn->FindComponentByClass<UMeshComponent>();
     if (!Mesh)
     {
         UE_LOG(LogTemp, Warning, TEXT("No mesh component found!"));
-        return;
+        return nullptr;
     }
 
-    UAudioComponent* AudioComponent = ControlledPawn->FindComponentByClass<UAudioComponent>();
-
+    UAudioComponent* AudioComponent = bCrossfadeComponent ? nullptr : ControlledPawn->FindComponentByClass<UAudioComponent>();
     if (!AudioComponent)
     {
         AudioComponent = NewObject<UAudioComponent>(ControlledPawn);
@@ -75,23 +181,92 @@ void UVehicleRadioComponent::PlayTrack(FMusicStruct MusicData, USoundAttenuation
         else
         {
             UE_LOG(LogTemp, Warning, TEXT("Failed to create audio component!"));
-            return;
+            return nullptr;
         }
     }
 
-    if (AudioComponent->IsPlaying())
+    CachedComponent = AudioComponent;
+    return AudioComponent;
+}
+
+int32 UVehicleRadioComponent::FindCurrentTrackIndex(const TArray<FMusicStruct>& MusicLibrary) const
+{
+    if (MusicLibrary.IsValidIndex(CurrentTrackIndex) && MusicLibrary[CurrentTrackIndex] == CurrentPlayingMusic)
     {
-        AudioComponent->Stop();
+        return CurrentTrackIndex;
     }
+    return MusicLibrary.Find(CurrentPlayingMusic);
+}
 
-    AudioComponent->SetSound(MusicData.MusicReference);
-    if (AttenuationSettings)
+void UVehicleRadioComponent::DecodeTrack(const FString& TrackFilePath, ERuntimeImportPriority Priority, TFunction<void(UImportedSoundWave*)>&& OnDecoded)
+{
+    if (UImportedSoundWave** DecodedTrack = DecodedTracks.Find(TrackFilePath))
     {
-        AudioComponent->AttenuationSettings = AttenuationSettings;
+        OnDecoded(*DecodedTrack);
+        return;
     }
 
-    AudioComponent->Play();
-    CurrentPlayingMusic = MusicData;
+    if (TArray<TFunction<void(UImportedSoundWave*)>>* WaitingCallbacks = PendingDecodes.Find(TrackFilePath))
+    {
+        WaitingCallbacks->Add(MoveTemp(OnDecoded));
+        return;
+    }
+    PendingDecodes.Add(TrackFilePath).Add(MoveTemp(OnDecoded));
+
+    URuntimeAudioImporterLibrary* AudioImporter = URuntimeAudioImporterLibrary::CreateRuntimeAudioImporter();
+    AudioImporter->ImportPriority = Priority;
+    // Decoded tracks stay cached for the whole session, keep them as compressed 16-bit PCM
+    AudioImporter->PCMStorageMode = ERuntimePCMStorageMode::Compressed16Bit;
+    ActiveImporters.Add(AudioImporter);
+
+    AudioImporter->OnResultNative.AddWeakLambda(this, [this, TrackFilePath](URuntimeAudioImporterLibrary* Importer, UImportedSoundWave* ImportedSoundWave, ERuntimeImportStatus Status)
+    {
+        ActiveImporters.Remove(Importer);
+
+        const bool bSucceeded = Status == ERuntimeImportStatus::SuccessfulImport && ImportedSoundWave;
+        if (bSucceeded)
+        {
+            DecodedTracks.Add(TrackFilePath, ImportedSoundWave);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Failed to decode track '%s'!"), *TrackFilePath);
+        }
+
+        TArray<TFunction<void(UImportedSoundWave*)>> WaitingCallbacks;
+        PendingDecodes.RemoveAndCopyValue(TrackFilePath, WaitingCallbacks);
+        for (TFunction<void(UImportedSoundWave*)>& Callback : WaitingCallbacks)
+        {
+            Callback(bSucceeded ? ImportedSoundWave : nullptr);
+        }
+    });
+
+    AudioImporter->ImportAudioFromFile(TrackFilePath, ERuntimeAudioFormat::Auto);
+}
+
+void UVehicleRadioComponent::PrefetchNextTrack()
+{
+    const int32 CurrentIndex = FindCurrentTrackIndex(ImportedMusic);
+    if (CurrentIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    const FMusicStruct& NextTrack = ImportedMusic[(CurrentIndex + 1) % ImportedMusic.Num()];
+
+    // Keep at most the current and the next track decoded
+    for (auto It = DecodedTracks.CreateIterator(); It; ++It)
+    {
+        if (It.Key() != CurrentPlayingMusic.MusicFilePath && It.Key() != NextTrack.MusicFilePath)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    if (!NextTrack.MusicReference && !NextTrack.MusicFilePath.IsEmpty())
+    {
+        DecodeTrack(NextTrack.MusicFilePath, ERuntimeImportPriority::Low, [](UImportedSoundWave*) {});
+    }
 }
 
 void UVehicleRadioComponent::ToggleRepeat()
@@ -99,12 +274,19 @@ void UVehicleRadioComponent::ToggleRepeat()
     bIsRepeatEnabled = !bIsRepeatEnabled;
 }
 
-FMusicStruct UVehicleRadioComponent::PlayNextTrack(TArray<FMusicStruct> MusicLibrary, bool IsUserChangedTrack)
+FMusicStruct UVehicleRadioComponent::PlayNextTrack(const TArray<FMusicStruct>& MusicLibrary, bool IsUserChangedTrack)
 {
-    int32 CurrentIndex = MusicLibrary.Find(CurrentPlayingMusic);
+    if (MusicLibrary.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Music library is empty!"));
+        return FMusicStruct();
+    }
+
+    int32 CurrentIndex = FindCurrentTrackIndex(MusicLibrary);
 
     if (CurrentIndex == -1)
     {
+        CurrentTrackIndex = 0;
         return MusicLibrary[0];
     }
 
@@ -116,13 +298,14 @@ FMusicStruct UVehicleRadioComponent::PlayNextTrack(TArray<FMusicStruct> MusicLib
     }
 
     CurrentPlayingMusic = MusicLibrary[NextIndex];
+    CurrentTrackIndex = NextIndex;
 
     return MusicLibrary[NextIndex];
 }
 
-FMusicStruct UVehicleRadioComponent::PlayPreviousTrack(TArray<FMusicStruct> MusicLibrary)
+FMusicStruct UVehicleRadioComponent::PlayPreviousTrack(const TArray<FMusicStruct>& MusicLibrary)
 {
-    int32 CurrentIndex = MusicLibrary.Find(CurrentPlayingMusic);
+    int32 CurrentIndex = FindCurrentTrackIndex(MusicLibrary);
 
     if (CurrentIndex == -1)
     {
@@ -138,6 +321,7 @@ FMusicStruct UVehicleRadioComponent::PlayPreviousTrack(TArray<FMusicStruct> Musi
     }
 
     CurrentPlayingMusic = MusicLibrary[PreviousIndex];
+    CurrentTrackIndex = PreviousIndex;
 
     return MusicLibrary[PreviousIndex];
 }
@@ -169,21 +353,7 @@ FString UVehicleRadioComponent::GetMusicName() const
 
 float UVehicleRadioComponent::GetMusicTimecode() const
 {
-    APlayerController* Owner = Cast<APlayerController>(GetOwner());
-    if (!Owner)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("Owner not found!"));
-        return 0.f;
-    }
-
-    APawn* ControlledPawn = Cast<APawn>(Owner->GetPawn());
-    if (!ControlledPawn)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("Owner is not a controlled pawn!"));
-        return 0.f;
-    }
-
-    UAudioComponent* AudioComponent = ControlledPawn->FindComponentByClass<UAudioComponent>();
+    const UAudioComponent* AudioComponent = RadioAudioComponent.Get();
     if (AudioComponent && AudioComponent->IsPlaying())
     {
         return 0.f;
@@ -193,38 +363,24 @@ float UVehicleRadioComponent::GetMusicTimecode() const
 
 void UVehicleRadioComponent::ImportMusicFromDisk(FString Path)
 {
-    TArray<FString> MusicFiles;
-    IFileManager& FileManager = IFileManager::Get();
-    FileManager.FindFilesRecursive(MusicFiles, *Path, TEXT("*.mp3"), true, false, false);
-
-    for (const FString& File : MusicFiles)
+    if (!MusicLibraryIndex)
     {
-        URuntimeAudioImporterLibrary* AudioImporter = URuntimeAudioImporterLibrary::CreateRuntimeAudioImporter();
-
-        FilePath = File;
-
-        AudioImporter->OnResult.AddDynamic(this, &UVehicleRadioComponent::OnAudioImportCompleted);
-
-        AudioImporter->ImportAudioFromFile(File, ERuntimeAudioFormat::Mp3);
+        MusicLibraryIndex = NewObject<UMusicLibraryIndex>(this);
     }
-}
-
-void UVehicleRadioComponent::OnAudioImportCompleted(URuntimeAudioImporterLibrary* Importer, UImportedSoundWave* ImportedSoundWave, ERuntimeImportStatus Status)
-{
-    if (Status == ERuntimeImportStatus::SuccessfulImport)
-    {
-        FMusicStruct NewMusic;
-        NewMusic.MusicReference = ImportedSoundWave;
 
-        NewMusic.MusicName = ImportedSoundWave->GetPathName();
-        NewMusic.MusicLength = ImportedSoundWave->Duration;
-
-        ImportedMusic.Add(NewMusic);
-    }
-    else
+    // Only headers and tags are read here, tracks are decoded when they are played
+    MusicLibraryIndex->Scan(Path, FOnMusicLibraryScanCompletedNative::CreateWeakLambda(this, [this](const TArray<FMusicLibraryEntry>& Entries)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Failed to import audio."));
-    }
+        ImportedMusic.Reset(Entries.Num());
+        for (const FMusicLibraryEntry& Entry : Entries)
+        {
+            FMusicStruct NewMusic;
+            NewMusic.MusicName = Entry.GetDisplayName();
+            NewMusic.MusicLength = Entry.Duration;
+            NewMusic.MusicFilePath = Entry.FilePath;
+            ImportedMusic.Add(MoveTemp(NewMusic));
+        }
+    }));
 }
 
 UTexture2D* UVehicleRadioComponent::ImportImageAsTexture2D(FString ImagePath)
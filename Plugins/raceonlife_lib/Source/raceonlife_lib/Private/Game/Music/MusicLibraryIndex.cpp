@@ -0,0 +1,254 @@
+#include "Game/Music/MusicLibraryIndex.h"
+#include "RuntimeAudioUtilities.h"
+#include "RuntimeAudioHeaderReader.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    /** Bump when the layout of FMusicLibraryEntry serialization changes, old index files are then ignored */
+    constexpr uint32 MusicLibraryIndexMagic = 0x4D4C4958; // "MLIX"
+    constexpr int32 MusicLibraryIndexVersion = 1;
+}
+
+FString FMusicLibraryEntry::GetDisplayName() const
+{
+    if (!Title.IsEmpty())
+    {
+        return Artist.IsEmpty() ? Title : FString::Printf(TEXT("%s - %s"), *Artist, *Title);
+    }
+    return FPaths::GetBaseFilename(FilePath);
+}
+
+FArchive& operator<<(FArchive& Ar, FMusicLibraryEntry& Entry)
+{
+    Ar << Entry.FilePath;
+    Ar << Entry.Title;
+    Ar << Entry.Artist;
+    Ar << Entry.Duration;
+    Ar << Entry.SampleRate;
+    Ar << Entry.NumOfChannels;
+    Ar << Entry.FileSize;
+    Ar << Entry.ModificationTime;
+    return Ar;
+}
+
+void UMusicLibraryIndex::Scan(const FString& Directory, const FOnMusicLibraryScanCompletedNative& OnCompleted)
+{
+    check(IsInGameThread());
+
+    if (IsScanning())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Music library scan of '%s' is already in progress!"), *ScannedDirectory);
+        return;
+    }
+
+    const FString FullDirectory = FPaths::ConvertRelativePathToFull(Directory);
+    if (ScannedDirectory != FullDirectory)
+    {
+        ScannedDirectory = FullDirectory;
+        Entries.Reset();
+        LoadIndex();
+    }
+
+    PendingOnCompleted = OnCompleted;
+    NumOfPendingHeaders = 1; // Keeps IsScanning() true while the files are being enumerated
+
+    TMap<FString, FMusicLibraryEntry> KnownEntries;
+    KnownEntries.Reserve(Entries.Num());
+    for (const FMusicLibraryEntry& Entry : Entries)
+    {
+        KnownEntries.Add(Entry.FilePath, Entry);
+    }
+
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis = MakeWeakObjectPtr(this), FullDirectory, KnownEntries = MoveTemp(KnownEntries)]() mutable
+    {
+        TArray<FMusicLibraryEntry> UnchangedEntries;
+        TArray<FMusicLibraryEntry> ChangedEntries;
+
+        // A single stat pass over the tree, the audio files themselves are not opened here
+        FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStatRecursively(*FullDirectory, [&](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+        {
+            if (StatData.bIsDirectory || URuntimeAudioUtilities::GetAudioFormats(FilenameOrDirectory).Num() == 0)
+            {
+                return true;
+            }
+
+            const FMusicLibraryEntry* KnownEntry = KnownEntries.Find(FilenameOrDirectory);
+            if (KnownEntry && KnownEntry->FileSize == StatData.FileSize && KnownEntry->ModificationTime == StatData.ModificationTime)
+            {
+                UnchangedEntries.Add(*KnownEntry);
+            }
+            else
+            {
+                FMusicLibraryEntry Entry;
+                Entry.FilePath = FilenameOrDirectory;
+                Entry.FileSize = StatData.FileSize;
+                Entry.ModificationTime = StatData.ModificationTime;
+                ChangedEntries.Add(MoveTemp(Entry));
+            }
+            return true;
+        });
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, UnchangedEntries = MoveTemp(UnchangedEntries), ChangedEntries = MoveTemp(ChangedEntries)]() mutable
+        {
+            if (WeakThis.IsValid())
+            {
+                WeakThis->OnFilesEnumerated(MoveTemp(UnchangedEntries), MoveTemp(ChangedEntries));
+            }
+        });
+    });
+}
+
+void UMusicLibraryIndex::OnFilesEnumerated(TArray<FMusicLibraryEntry>&& UnchangedEntries, TArray<FMusicLibraryEntry>&& ChangedEntries)
+{
+    ScanResults = MoveTemp(UnchangedEntries);
+    NumOfPendingHeaders = ChangedEntries.Num();
+
+    UE_LOG(LogTemp, Log, TEXT("Music library '%s': %d unchanged tracks, %d new or changed tracks to index"), *ScannedDirectory, ScanResults.Num(), ChangedEntries.Num());
+
+    if (NumOfPendingHeaders == 0)
+    {
+        FinishScan();
+        return;
+    }
+
+    for (FMusicLibraryEntry& ChangedEntry : ChangedEntries)
+    {
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis = MakeWeakObjectPtr(this), Entry = MoveTemp(ChangedEntry)]() mutable
+        {
+            FRuntimeAudioHeaderReader::ReadID3Tags(Entry.FilePath, Entry.Title, Entry.Artist);
+
+            // MP3 headers are parsed from the first frame, decoding the header through the importer would load the whole file
+            if (FPaths::GetExtension(Entry.FilePath).Equals(TEXT("mp3"), ESearchCase::IgnoreCase) && ReadMP3HeaderInfo(Entry.FilePath, Entry.Duration, Entry.SampleRate, Entry.NumOfChannels))
+            {
+                AsyncTask(ENamedThreads::GameThread, [WeakThis, Entry = MoveTemp(Entry)]() mutable
+                {
+                    if (WeakThis.IsValid())
+                    {
+                        WeakThis->OnHeaderRead(MoveTemp(Entry), true);
+                    }
+                });
+                return;
+            }
+
+            const FString EntryFilePath = Entry.FilePath;
+            URuntimeAudioUtilities::GetAudioHeaderInfoFromFile(EntryFilePath, FOnGetAudioHeaderInfoResultNative::CreateLambda([WeakThis, Entry = MoveTemp(Entry)](bool bSucceeded, FRuntimeAudioHeaderInfo HeaderInfo) mutable
+            {
+                if (!WeakThis.IsValid())
+                {
+                    return;
+                }
+                Entry.Duration = HeaderInfo.Duration;
+                Entry.SampleRate = HeaderInfo.SampleRate;
+                Entry.NumOfChannels = HeaderInfo.NumOfChannels;
+                WeakThis->OnHeaderRead(MoveTemp(Entry), bSucceeded);
+            }));
+        });
+    }
+}
+
+void UMusicLibraryIndex::OnHeaderRead(FMusicLibraryEntry&& Entry, bool bSucceeded)
+{
+    if (bSucceeded)
+    {
+        ScanResults.Add(MoveTemp(Entry));
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to read audio header of '%s', skipping it!"), *Entry.FilePath);
+    }
+
+    if (--NumOfPendingHeaders == 0)
+    {
+        FinishScan();
+    }
+}
+
+void UMusicLibraryIndex::FinishScan()
+{
+    ScanResults.Sort([](const FMusicLibraryEntry& A, const FMusicLibraryEntry& B)
+    {
+        return A.FilePath < B.FilePath;
+    });
+    Entries = MoveTemp(ScanResults);
+    ScanResults.Reset();
+    SaveIndex();
+
+    FOnMusicLibraryScanCompletedNative OnCompleted = MoveTemp(PendingOnCompleted);
+    PendingOnCompleted.Unbind();
+    OnCompleted.ExecuteIfBound(Entries);
+}
+
+FString UMusicLibraryIndex::GetIndexFilePath(const FString& Directory)
+{
+    return FPaths::ProjectSavedDir() / TEXT("MusicLibrary") / FString::Printf(TEXT("%08X.idx"), GetTypeHash(FPaths::ConvertRelativePathToFull(Directory)));
+}
+
+bool UMusicLibraryIndex::LoadIndex()
+{
+    TArray<uint8> IndexData;
+    if (!FFileHelper::LoadFileToArray(IndexData, *GetIndexFilePath(ScannedDirectory), FILEREAD_Silent))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(IndexData);
+    uint32 Magic = 0;
+    int32 Version = 0;
+    FString Directory;
+    Reader << Magic;
+    Reader << Version;
+    if (Magic != MusicLibraryIndexMagic || Version != MusicLibraryIndexVersion)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Ignoring outdated music library index for '%s'"), *ScannedDirectory);
+        return false;
+    }
+    Reader << Directory;
+    Reader << Entries;
+
+    if (Reader.IsError() || Directory != ScannedDirectory)
+    {
+        Entries.Reset();
+        return false;
+    }
+    return true;
+}
+
+void UMusicLibraryIndex::SaveIndex() const
+{
+    TArray<uint8> IndexData;
+    FMemoryWriter Writer(IndexData);
+    uint32 Magic = MusicLibraryIndexMagic;
+    int32 Version = MusicLibraryIndexVersion;
+    FString Directory = ScannedDirectory;
+    TArray<FMusicLibraryEntry> EntriesToSave = Entries;
+    Writer << Magic;
+    Writer << Version;
+    Writer << Directory;
+    Writer << EntriesToSave;
+
+    if (!FFileHelper::SaveArrayToFile(IndexData, *GetIndexFilePath(ScannedDirectory)))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to save music library index to '%s'!"), *GetIndexFilePath(ScannedDirectory));
+    }
+}
+
+bool UMusicLibraryIndex::ReadMP3HeaderInfo(const FString& FilePath, float& OutDuration, int32& OutSampleRate, int32& OutNumOfChannels)
+{
+    FRuntimeAudioHeaderInfo HeaderInfo;
+    if (!FRuntimeAudioHeaderReader::ReadMP3HeaderInfo(FilePath, HeaderInfo))
+    {
+        return false;
+    }
+
+    OutDuration = HeaderInfo.Duration;
+    OutSampleRate = HeaderInfo.SampleRate;
+    OutNumOfChannels = HeaderInfo.NumOfChannels;
+    return true;
+}
@@ -0,0 +1,284 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Game/Music/MusicLibraryIndex.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    /**
+     * Builds a minimal MP3 file: an ID3v2 tag, a few junk bytes holding a stray sync word, NumOfFrames silent frames and an ID3v1 tag
+     * If XingNumOfFrames is set, the first frame carries a Xing header with that frame count, as VBR encoders write it
+     */
+    TArray<uint8> MakeTestMP3(const uint8 (&FrameHeader)[4], int32 FrameSize, int32 SideInfoSize, int32 NumOfFrames, uint32 XingNumOfFrames)
+    {
+        TArray<uint8> Data;
+
+        const uint8 ID3v2Header[10] = {'I', 'D', '3', 3, 0, 0, 0, 0, 0, 20};
+        Data.Append(ID3v2Header, UE_ARRAY_COUNT(ID3v2Header));
+        Data.AddZeroed(20);
+
+        const uint8 Junk[3] = {0xFF, 0xFB, 0x90};
+        Data.Append(Junk, UE_ARRAY_COUNT(Junk));
+
+        for (int32 FrameIndex = 0; FrameIndex < NumOfFrames; ++FrameIndex)
+        {
+            const int32 FrameOffset = Data.Num();
+            Data.AddZeroed(FrameSize);
+            FMemory::Memcpy(Data.GetData() + FrameOffset, FrameHeader, 4);
+
+            if (FrameIndex == 0 && XingNumOfFrames > 0)
+            {
+                uint8* Xing = Data.GetData() + FrameOffset + 4 + SideInfoSize;
+                FMemory::Memcpy(Xing, "Xing", 4);
+                Xing[7] = 0x01;
+                Xing[8] = static_cast<uint8>(XingNumOfFrames >> 24);
+                Xing[9] = static_cast<uint8>(XingNumOfFrames >> 16);
+                Xing[10] = static_cast<uint8>(XingNumOfFrames >> 8);
+                Xing[11] = static_cast<uint8>(XingNumOfFrames);
+            }
+        }
+
+        const int32 ID3v1Offset = Data.Num();
+        Data.AddZeroed(128);
+        FMemory::Memcpy(Data.GetData() + ID3v1Offset, "TAG", 3);
+        return Data;
+    }
+
+    /** Builds a 16-bit PCM WAV file holding silence */
+    TArray<uint8> MakeTestWAV(int32 SampleRate, int32 NumOfChannels, int32 NumOfFrames)
+    {
+        const uint32 DataSize = NumOfFrames * NumOfChannels * sizeof(int16);
+
+        TArray<uint8> Data;
+        Data.SetNumZeroed(44 + DataSize);
+        uint8* Header = Data.GetData();
+        auto WriteUInt32 = [](uint8* Bytes, uint32 Value) { FMemory::Memcpy(Bytes, &Value, sizeof(Value)); };
+        auto WriteUInt16 = [](uint8* Bytes, uint16 Value) { FMemory::Memcpy(Bytes, &Value, sizeof(Value)); };
+
+        FMemory::Memcpy(Header, "RIFF", 4);
+        WriteUInt32(Header + 4, 36 + DataSize);
+        FMemory::Memcpy(Header + 8, "WAVEfmt ", 8);
+        WriteUInt32(Header + 16, 16);
+        WriteUInt16(Header + 20, 1);
+        WriteUInt16(Header + 22, NumOfChannels);
+        WriteUInt32(Header + 24, SampleRate);
+        WriteUInt32(Header + 28, SampleRate * NumOfChannels * sizeof(int16));
+        WriteUInt16(Header + 32, NumOfChannels * sizeof(int16));
+        WriteUInt16(Header + 34, 16);
+        FMemory::Memcpy(Header + 36, "data", 4);
+        WriteUInt32(Header + 40, DataSize);
+        return Data;
+    }
+
+    /** How long a latent step may wait for a library scan before the test fails */
+    constexpr double ScanTimeout = 300.0;
+
+    /** State shared by the latent steps of the scan benchmark */
+    struct FMusicLibraryScanBenchmarkState
+    {
+        FString Directory;
+        int32 NumOfFiles = 0;
+        UMusicLibraryIndex* LibraryIndex = nullptr;
+
+        double StartTime = 0.0;
+        double ElapsedTime = 0.0;
+        int32 NumOfScannedEntries = 0;
+        bool bScanCompleted = false;
+
+        /** Peak of the used physical memory, sampled by a separate thread while a scan runs */
+        int64 StartUsedPhysical = 0;
+        TSharedRef<FThreadSafeBool> bStopSampling = MakeShared<FThreadSafeBool>(false);
+        TFuture<int64> PeakUsedPhysical;
+    };
+
+    /** Starts a scan with a new library index, so that the persisted index (if any) is loaded from disk */
+    void StartBenchmarkScan(const TSharedRef<FMusicLibraryScanBenchmarkState>& State)
+    {
+        if (State->LibraryIndex)
+        {
+            State->LibraryIndex->RemoveFromRoot();
+        }
+        State->LibraryIndex = NewObject<UMusicLibraryIndex>();
+        State->LibraryIndex->AddToRoot();
+
+        State->bScanCompleted = false;
+        State->StartUsedPhysical = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+        State->bStopSampling = MakeShared<FThreadSafeBool>(false);
+        State->PeakUsedPhysical = Async(EAsyncExecution::Thread, [bStopSampling = State->bStopSampling, StartUsedPhysical = State->StartUsedPhysical]()
+        {
+            int64 Peak = StartUsedPhysical;
+            while (!*bStopSampling)
+            {
+                Peak = FMath::Max(Peak, static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical));
+                FPlatformProcess::Sleep(0.001f);
+            }
+            return Peak;
+        });
+
+        State->StartTime = FPlatformTime::Seconds();
+        State->LibraryIndex->Scan(State->Directory, FOnMusicLibraryScanCompletedNative::CreateLambda([State](const TArray<FMusicLibraryEntry>& Entries)
+        {
+            State->ElapsedTime = FPlatformTime::Seconds() - State->StartTime;
+            State->NumOfScannedEntries = Entries.Num();
+            State->bScanCompleted = true;
+        }));
+    }
+
+    /** Returns the peak memory growth of the scan started by StartBenchmarkScan */
+    int64 StopBenchmarkSampling(const TSharedRef<FMusicLibraryScanBenchmarkState>& State)
+    {
+        *State->bStopSampling = true;
+        return FMath::Max<int64>(State->PeakUsedPhysical.Get() - State->StartUsedPhysical, 0);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMusicLibraryMP3HeaderTest, "RaceOnLife.Music.MP3HeaderInfo", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FMusicLibraryMP3HeaderTest::RunTest(const FString& Parameters)
+{
+    struct FMP3HeaderCase
+    {
+        const TCHAR* Name;
+        TArray<uint8> Data;
+        float ExpectedDuration;
+        int32 ExpectedSampleRate;
+        int32 ExpectedNumOfChannels;
+    };
+
+    // MPEG 1 Layer III, 128 kbit/s, 44.1 kHz, stereo: 417 byte frames. MPEG 2 Layer III, 64 kbit/s, 22.05 kHz, mono: 208 byte frames
+    const uint8 MPEG1Header[4] = {0xFF, 0xFB, 0x90, 0x00};
+    const uint8 MPEG2Header[4] = {0xFF, 0xF3, 0x80, 0xC0};
+
+    const FMP3HeaderCase Cases[] = {
+        {TEXT("CBR"), MakeTestMP3(MPEG1Header, 417, 32, 100, 0), 100 * 417 * 8 / 128000.f, 44100, 2},
+        {TEXT("Xing"), MakeTestMP3(MPEG1Header, 417, 32, 10, 250), 250 * 1152 / 44100.f, 44100, 2},
+        {TEXT("MPEG 2 mono Xing"), MakeTestMP3(MPEG2Header, 208, 9, 10, 400), 400 * 576 / 22050.f, 22050, 1},
+    };
+
+    const FString FilePath = FPaths::AutomationTransientDir() / TEXT("MusicLibraryIndexTest.mp3");
+    for (const FMP3HeaderCase& Case : Cases)
+    {
+        if (!TestTrue(FString::Printf(TEXT("%s: test file written"), Case.Name), FFileHelper::SaveArrayToFile(Case.Data, *FilePath)))
+        {
+            return false;
+        }
+
+        float Duration = 0.f;
+        int32 SampleRate = 0;
+        int32 NumOfChannels = 0;
+        if (TestTrue(FString::Printf(TEXT("%s: header read"), Case.Name), UMusicLibraryIndex::ReadMP3HeaderInfo(FilePath, Duration, SampleRate, NumOfChannels)))
+        {
+            TestEqual(FString::Printf(TEXT("%s: duration"), Case.Name), Duration, Case.ExpectedDuration, 0.001f);
+            TestEqual(FString::Printf(TEXT("%s: sample rate"), Case.Name), SampleRate, Case.ExpectedSampleRate);
+            TestEqual(FString::Printf(TEXT("%s: number of channels"), Case.Name), NumOfChannels, Case.ExpectedNumOfChannels);
+        }
+    }
+
+    IFileManager::Get().Delete(*FilePath);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMusicLibraryScanBenchmarkTest, "RaceOnLife.Music.ScanBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMusicLibraryScanBenchmarkTest::RunTest(const FString& Parameters)
+{
+    // 4000 tracks over 40 albums, half MP3 (read from the first frame header) and half WAV (read through the importer)
+    const int32 NumOfAlbums = 40;
+    const int32 NumOfTracksPerAlbum = 100;
+    const uint8 MPEG1Header[4] = {0xFF, 0xFB, 0x90, 0x00};
+    const TArray<uint8> MP3Data = MakeTestMP3(MPEG1Header, 417, 32, 100, 0);
+    const TArray<uint8> WAVData = MakeTestWAV(44100, 2, 4410);
+
+    const TSharedRef<FMusicLibraryScanBenchmarkState> State = MakeShared<FMusicLibraryScanBenchmarkState>();
+    State->Directory = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("MusicLibraryScanBenchmark"));
+    State->NumOfFiles = NumOfAlbums * NumOfTracksPerAlbum;
+    IFileManager::Get().DeleteDirectory(*State->Directory, false, true);
+    IFileManager::Get().Delete(*UMusicLibraryIndex::GetIndexFilePath(State->Directory), false, true, true);
+
+    int64 LibrarySize = 0;
+    for (int32 AlbumIndex = 0; AlbumIndex < NumOfAlbums; ++AlbumIndex)
+    {
+        for (int32 TrackIndex = 0; TrackIndex < NumOfTracksPerAlbum; ++TrackIndex)
+        {
+            const bool bMP3 = TrackIndex % 2 == 0;
+            const FString FilePath = State->Directory / FString::Printf(TEXT("Album%02d/Track%03d.%s"), AlbumIndex, TrackIndex, bMP3 ? TEXT("mp3") : TEXT("wav"));
+            if (!FFileHelper::SaveArrayToFile(bMP3 ? MP3Data : WAVData, *FilePath))
+            {
+                AddError(FString::Printf(TEXT("Unable to write '%s'"), *FilePath));
+                return false;
+            }
+            LibrarySize += bMP3 ? MP3Data.Num() : WAVData.Num();
+        }
+    }
+    AddInfo(FString::Printf(TEXT("Library of %d tracks (MP3 and WAV): %.2f MB"), State->NumOfFiles, LibrarySize / (1024.0 * 1024.0)));
+
+    StartBenchmarkScan(State);
+
+    // Reports a completed scan, then starts the next one if it is the cold one
+    auto WaitForScan = [this, State](const TCHAR* Name, bool bStartNextScan, const TSharedRef<double>& OutElapsedTime)
+    {
+        return [this, State, Name, bStartNextScan, OutElapsedTime]()
+        {
+            if (!State->bScanCompleted)
+            {
+                if (FPlatformTime::Seconds() - State->StartTime > ScanTimeout)
+                {
+                    AddError(FString::Printf(TEXT("Timed out waiting for the %s scan"), Name));
+                    StopBenchmarkSampling(State);
+                    return true;
+                }
+                return false;
+            }
+
+            const int64 PeakMemoryGrowth = StopBenchmarkSampling(State);
+            const int64 IndexFileSize = IFileManager::Get().FileSize(*UMusicLibraryIndex::GetIndexFilePath(State->Directory));
+            *OutElapsedTime = State->ElapsedTime;
+
+            TestEqual(FString::Printf(TEXT("%s scan: tracks found"), Name), State->NumOfScannedEntries, State->NumOfFiles);
+            TestTrue(FString::Printf(TEXT("%s scan: index persisted"), Name), IndexFileSize > 0);
+            AddInfo(FString::Printf(TEXT("%s scan of %d tracks: %.1f ms, peak memory growth %.2f MB, persisted index %.1f KB"),
+                Name, State->NumOfFiles, State->ElapsedTime * 1000.0, PeakMemoryGrowth / (1024.0 * 1024.0), IndexFileSize / 1024.0));
+
+            if (bStartNextScan)
+            {
+                StartBenchmarkScan(State);
+            }
+            return true;
+        };
+    };
+
+    const TSharedRef<double> ColdTime = MakeShared<double>(0.0);
+    const TSharedRef<double> WarmTime = MakeShared<double>(0.0);
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand(WaitForScan(TEXT("Cold"), true, ColdTime)));
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand(WaitForScan(TEXT("Warm"), false, WarmTime)));
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, ColdTime, WarmTime]()
+    {
+        if (*ColdTime > 0.0 && *WarmTime > 0.0)
+        {
+            AddInfo(FString::Printf(TEXT("Warm scan speedup over the cold scan: %.1fx"), *ColdTime / *WarmTime));
+            TestTrue(TEXT("Warm scan is faster than the cold scan"), *WarmTime < *ColdTime);
+        }
+
+        if (State->LibraryIndex)
+        {
+            State->LibraryIndex->RemoveFromRoot();
+            State->LibraryIndex = nullptr;
+        }
+        IFileManager::Get().Delete(*UMusicLibraryIndex::GetIndexFilePath(State->Directory), false, true, true);
+        IFileManager::Get().DeleteDirectory(*State->Directory, false, true);
+        return true;
+    }));
+
+    return true;
+}
+
+#endif
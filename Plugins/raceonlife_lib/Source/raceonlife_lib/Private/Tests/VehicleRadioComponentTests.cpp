@@ -0,0 +1,202 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Game/Components/VehicleRadioComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/DefaultPawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    /** A skip to a prefetched track must start playback within a frame at 60 fps */
+    constexpr double PrefetchedSkipLatencyBudget = 1.0 / 60.0;
+
+    /** How long a latent step may wait for background decoding before the test fails */
+    constexpr double LatentStepTimeout = 60.0;
+
+    /** Writes a 16-bit stereo WAV file holding a sine tone */
+    bool WriteTestTrack(const FString& FilePath, int32 SampleRate, int32 NumOfSeconds, float Frequency)
+    {
+        const int32 NumOfChannels = 2;
+        const int32 NumOfFrames = SampleRate * NumOfSeconds;
+        const uint32 DataSize = NumOfFrames * NumOfChannels * sizeof(int16);
+
+        TArray<uint8> FileData;
+        FileData.SetNumUninitialized(44 + DataSize);
+        uint8* Header = FileData.GetData();
+        auto WriteUInt32 = [](uint8* Data, uint32 Value) { FMemory::Memcpy(Data, &Value, sizeof(Value)); };
+        auto WriteUInt16 = [](uint8* Data, uint16 Value) { FMemory::Memcpy(Data, &Value, sizeof(Value)); };
+
+        FMemory::Memcpy(Header, "RIFF", 4);
+        WriteUInt32(Header + 4, 36 + DataSize);
+        FMemory::Memcpy(Header + 8, "WAVEfmt ", 8);
+        WriteUInt32(Header + 16, 16);
+        WriteUInt16(Header + 20, 1);
+        WriteUInt16(Header + 22, NumOfChannels);
+        WriteUInt32(Header + 24, SampleRate);
+        WriteUInt32(Header + 28, SampleRate * NumOfChannels * sizeof(int16));
+        WriteUInt16(Header + 32, NumOfChannels * sizeof(int16));
+        WriteUInt16(Header + 34, 16);
+        FMemory::Memcpy(Header + 36, "data", 4);
+        WriteUInt32(Header + 40, DataSize);
+
+        int16* Samples = reinterpret_cast<int16*>(FileData.GetData() + 44);
+        for (int32 FrameIndex = 0; FrameIndex < NumOfFrames; ++FrameIndex)
+        {
+            const int16 Sample = static_cast<int16>(8000.f * FMath::Sin(2.f * PI * Frequency * FrameIndex / SampleRate));
+            Samples[FrameIndex * NumOfChannels] = Sample;
+            Samples[FrameIndex * NumOfChannels + 1] = Sample;
+        }
+
+        return FFileHelper::SaveArrayToFile(FileData, *FilePath);
+    }
+
+    /** State shared by the latent steps of the radio latency test */
+    struct FRadioLatencyTestState
+    {
+        FString TracksDirectory;
+        UWorld* World = nullptr;
+        UVehicleRadioComponent* Radio = nullptr;
+        double StepStartTime = 0.0;
+        double ColdSkipStartTime = 0.0;
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVehicleRadioSkipLatencyTest, "RaceOnLife.Music.RadioSkipLatency", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FVehicleRadioSkipLatencyTest::RunTest(const FString& Parameters)
+{
+    const int32 NumOfTracks = 4;
+    const TSharedRef<FRadioLatencyTestState> State = MakeShared<FRadioLatencyTestState>();
+    State->TracksDirectory = FPaths::AutomationTransientDir() / TEXT("RadioSkipLatency");
+    IFileManager::Get().DeleteDirectory(*State->TracksDirectory, false, true);
+
+    for (int32 TrackIndex = 0; TrackIndex < NumOfTracks; ++TrackIndex)
+    {
+        const FString FilePath = State->TracksDirectory / FString::Printf(TEXT("Track%d.wav"), TrackIndex);
+        if (!TestTrue(FString::Printf(TEXT("Test track %d written"), TrackIndex), WriteTestTrack(FilePath, 44100, 30, 220.f * (TrackIndex + 1))))
+        {
+            return false;
+        }
+    }
+
+    // The radio plays through an audio component attached to the mesh of the pawn its player controller possesses
+    State->World = UWorld::CreateWorld(EWorldType::Game, false);
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(State->World);
+    State->World->InitializeActorsForPlay(FURL());
+    State->World->BeginPlay();
+
+    APlayerController* PlayerController = State->World->SpawnActor<APlayerController>();
+    ADefaultPawn* Pawn = State->World->SpawnActor<ADefaultPawn>();
+    PlayerController->Possess(Pawn);
+
+    State->Radio = NewObject<UVehicleRadioComponent>(PlayerController);
+    State->Radio->RegisterComponent();
+    State->Radio->ImportMusicFromDisk(State->TracksDirectory);
+    State->StepStartTime = FPlatformTime::Seconds();
+
+    auto HasTimedOut = [this, State](const TCHAR* Step)
+    {
+        if (FPlatformTime::Seconds() - State->StepStartTime > LatentStepTimeout)
+        {
+            AddError(FString::Printf(TEXT("Timed out waiting for %s"), Step));
+            return true;
+        }
+        return false;
+    };
+
+    auto GetTrackFilePath = [State](int32 TrackIndex)
+    {
+        return State->Radio->GetImportedMusic()[TrackIndex].MusicFilePath;
+    };
+
+    // Skips to the next track and checks that it starts playing synchronously, within the latency budget
+    auto SkipToPrefetchedTrack = [this, State, GetTrackFilePath](const TCHAR* SkipName, int32 ExpectedTrackIndex)
+    {
+        UVehicleRadioComponent* Radio = State->Radio;
+        const double SkipStartTime = FPlatformTime::Seconds();
+        Radio->PlayTrack(Radio->PlayNextTrack(Radio->GetImportedMusic(), true), nullptr);
+        const double SkipLatency = FPlatformTime::Seconds() - SkipStartTime;
+
+        TestEqual(FString::Printf(TEXT("%s: track index"), SkipName), Radio->CurrentTrackIndex, ExpectedTrackIndex);
+        TestEqual(FString::Printf(TEXT("%s: playing track"), SkipName), Radio->CurrentPlayingMusic.MusicFilePath, GetTrackFilePath(ExpectedTrackIndex));
+        TestNotNull(FString::Printf(TEXT("%s: playback started without waiting"), SkipName), Radio->CurrentPlayingMusic.MusicReference);
+        TestTrue(FString::Printf(TEXT("%s: latency %.3f ms within the %.3f ms budget"), SkipName, SkipLatency * 1000.0, PrefetchedSkipLatencyBudget * 1000.0), SkipLatency <= PrefetchedSkipLatencyBudget);
+        State->StepStartTime = FPlatformTime::Seconds();
+    };
+
+    // The library scan only reads headers
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, NumOfTracks, HasTimedOut]()
+    {
+        if (State->Radio->GetImportedMusic().Num() < NumOfTracks)
+        {
+            return HasTimedOut(TEXT("the music library scan"));
+        }
+        TestEqual(TEXT("Number of library tracks"), State->Radio->GetImportedMusic().Num(), NumOfTracks);
+        State->Radio->PlayTrackAtIndex(0, nullptr);
+        State->StepStartTime = FPlatformTime::Seconds();
+        return true;
+    }));
+
+    // The first track has to be decoded, after which the next one is prefetched in the background
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([State, HasTimedOut, GetTrackFilePath, SkipToPrefetchedTrack]()
+    {
+        if (!State->Radio->CurrentPlayingMusic.MusicReference || !State->Radio->IsTrackDecoded(GetTrackFilePath(1)))
+        {
+            return HasTimedOut(TEXT("the first track and the prefetch of the second one"));
+        }
+        SkipToPrefetchedTrack(TEXT("Skip"), 1);
+        return true;
+    }));
+
+    // The same with a crossfade, which swaps the audio components
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([State, HasTimedOut, GetTrackFilePath, SkipToPrefetchedTrack]()
+    {
+        if (!State->Radio->IsTrackDecoded(GetTrackFilePath(2)))
+        {
+            return HasTimedOut(TEXT("the prefetch of the third track"));
+        }
+        State->Radio->CrossfadeDuration = 1.f;
+        SkipToPrefetchedTrack(TEXT("Crossfaded skip"), 2);
+        return true;
+    }));
+
+    // For reference, a jump to a track that was not prefetched waits for its decode
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([State]()
+    {
+        State->Radio->CrossfadeDuration = 0.f;
+        State->ColdSkipStartTime = FPlatformTime::Seconds();
+        State->StepStartTime = State->ColdSkipStartTime;
+        State->Radio->PlayTrackAtIndex(0, nullptr);
+        return true;
+    }));
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, HasTimedOut, GetTrackFilePath]()
+    {
+        const FMusicStruct& CurrentPlayingMusic = State->Radio->CurrentPlayingMusic;
+        if (!CurrentPlayingMusic.MusicReference || CurrentPlayingMusic.MusicFilePath != GetTrackFilePath(0))
+        {
+            return HasTimedOut(TEXT("the jump to a track that was not prefetched"));
+        }
+        AddInfo(FString::Printf(TEXT("Jump to a track that was not prefetched: %.2f ms"), (FPlatformTime::Seconds() - State->ColdSkipStartTime) * 1000.0));
+        return true;
+    }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([State]()
+    {
+        GEngine->DestroyWorldContext(State->World);
+        State->World->DestroyWorld(false);
+        IFileManager::Get().DeleteDirectory(*State->TracksDirectory, false, true);
+        return true;
+    }));
+
+    return true;
+}
+
+#endif
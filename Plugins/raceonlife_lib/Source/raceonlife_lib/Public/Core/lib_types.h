@@ -26,12 +26,20 @@ public:
 	UPROPERTY(BlueprintReadWrite)
 	UTexture2D* MusicImage;
 
+	/** Source file of the track. If set and MusicReference is null, the track is decoded on demand when played */
+	UPROPERTY(BlueprintReadWrite)
+	FString MusicFilePath;
+
 	FMusicStruct() : MusicReference(nullptr), MusicName(""), MusicLength(0.f), MusicImage(nullptr)
 	{
 	}
 
 	bool operator==(const FMusicStruct& Other) const
 	{
+		if (!MusicFilePath.IsEmpty() || !Other.MusicFilePath.IsEmpty())
+		{
+			return MusicFilePath == Other.MusicFilePath;
+		}
 		return MusicName == Other.MusicName;
 	}
 };
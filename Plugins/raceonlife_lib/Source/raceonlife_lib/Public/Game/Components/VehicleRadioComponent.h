@@ -6,6 +6,8 @@
 #include "RuntimeAudioImporterLibrary.h"
 #include "VehicleRadioComponent.generated.h"
 
+class UMusicLibraryIndex;
+
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class RACEONLIFE_LIB_API UVehicleRadioComponent : public UActorComponent
@@ -31,10 +33,14 @@ public:
     void ToggleRepeat();
 
     UFUNCTION(BlueprintCallable, Category = "Music")
-    FMusicStruct PlayNextTrack(TArray<FMusicStruct> MusicLibrary, bool IsUserChangedTrack);
+    FMusicStruct PlayNextTrack(const TArray<FMusicStruct>& MusicLibrary, bool IsUserChangedTrack);
+
+    UFUNCTION(BlueprintCallable, Category = "Music")
+    FMusicStruct PlayPreviousTrack(const TArray<FMusicStruct>& MusicLibrary);
 
+    /** Plays the imported music library track at the given index */
     UFUNCTION(BlueprintCallable, Category = "Music")
-    FMusicStruct PlayPreviousTrack(TArray<FMusicStruct> MusicLibrary);
+    void PlayTrackAtIndex(int32 TrackIndex, USoundAttenuation* AttenuationSettings);
 
     UFUNCTION(BlueprintCallable, Category = "Music")
     void PauseTrack(FMusicStruct MusicData);
@@ -57,6 +63,14 @@ public:
     UPROPERTY(BlueprintReadWrite, Category = "Music")
     FMusicStruct CurrentPlayingMusic;
 
+    /** Index of CurrentPlayingMusic in the library it was selected from, INDEX_NONE if unknown */
+    UPROPERTY(BlueprintReadOnly, Category = "Music")
+    int32 CurrentTrackIndex;
+
+    /** Duration of the equal-power crossfade between tracks, in seconds. 0 switches tracks immediately */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Music", meta = (ClampMin = "0.0"))
+    float CrossfadeDuration;
+
     UPROPERTY(BlueprintReadWrite, Category = "Music")
     TArray<FMusicStruct> MusicPlaylist;
 
@@ -69,14 +83,49 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Music")
     float GetCurrentMusicVolume() { return MusicVolume; }
 
+    /** Whether the library track at the given path is decoded and can start playing without waiting */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Music")
+    bool IsTrackDecoded(const FString& TrackFilePath) const { return DecodedTracks.Contains(TrackFilePath); }
+
 private:
-    UFUNCTION()
-    void OnAudioImportCompleted(URuntimeAudioImporterLibrary* Importer, UImportedSoundWave* ImportedSoundWave, ERuntimeImportStatus Status);
+    /**
+     * Returns the audio component the radio plays through, creating it if necessary
+     * The component is cached and only looked up again when the controlled pawn changes
+     */
+    UAudioComponent* GetRadioAudioComponent(bool bCrossfadeComponent);
+
+    /** Finds the index of the current track in the given library, trying the cached index before searching */
+    int32 FindCurrentTrackIndex(const TArray<FMusicStruct>& MusicLibrary) const;
+
+    /** Decodes the track at the given path with the given import priority, calling OnDecoded on the game thread with the sound wave (null on failure) */
+    void DecodeTrack(const FString& TrackFilePath, ERuntimeImportPriority Priority, TFunction<void(UImportedSoundWave*)>&& OnDecoded);
+
+    /** Starts decoding the track following the current one and drops every decoded track other than the current and the next one */
+    void PrefetchNextTrack();
 
     bool bIsRepeatEnabled;
     float MusicVolume;
 
-    FString FilePath;
-
     TArray<FMusicStruct> ImportedMusic;
+
+    UPROPERTY()
+    UMusicLibraryIndex* MusicLibraryIndex;
+
+    /** The audio component currently playing the radio, and the spare one used to fade out the previous track */
+    TWeakObjectPtr<UAudioComponent> RadioAudioComponent;
+    TWeakObjectPtr<UAudioComponent> CrossfadeAudioComponent;
+
+    /** Decoded tracks keyed by file path. Holds at most the current and the next track */
+    UPROPERTY()
+    TMap<FString, UImportedSoundWave*> DecodedTracks;
+
+    /** Importers of the tracks being decoded, kept alive until they report their result */
+    UPROPERTY()
+    TArray<URuntimeAudioImporterLibrary*> ActiveImporters;
+
+    /** Tracks being decoded, with the callbacks waiting for them */
+    TMap<FString, TArray<TFunction<void(UImportedSoundWave*)>>> PendingDecodes;
+
+    /** The track passed to the last PlayTrack call that had to wait for decoding, so that stale decodes do not start playback */
+    FString AwaitedTrackFilePath;
 };
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "MusicLibraryIndex.generated.h"
+
+/** Metadata of a single track in the music library. Obtained from the file header and tags, without decoding the audio */
+USTRUCT(BlueprintType)
+struct FMusicLibraryEntry
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(BlueprintReadOnly, Category = "Music")
+    FString FilePath;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Music")
+    FString Title;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Music")
+    FString Artist;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Music")
+    float Duration;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Music")
+    int32 SampleRate;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Music")
+    int32 NumOfChannels;
+
+    /** File size and modification time at the moment the entry was indexed. Used to detect changed files on rescan */
+    int64 FileSize;
+    FDateTime ModificationTime;
+
+    FMusicLibraryEntry() : Duration(0.f), SampleRate(0), NumOfChannels(0), FileSize(0)
+    {
+    }
+
+    /** Display name of the track: "Artist - Title", the title alone, or the file name if there are no tags */
+    FString GetDisplayName() const;
+
+    friend FArchive& operator<<(FArchive& Ar, FMusicLibraryEntry& Entry);
+};
+
+DECLARE_DELEGATE_OneParam(FOnMusicLibraryScanCompletedNative, const TArray<FMusicLibraryEntry>&);
+
+/**
+ * Index of the music files in a directory
+ * Scanning only reads file headers and ID3 tags, never the audio itself, and the index is persisted in the Saved directory
+ * together with file sizes and modification times, so that rescans only look at new or changed files
+ */
+UCLASS()
+class RACEONLIFE_LIB_API UMusicLibraryIndex : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * Scans the directory recursively for audio files and updates the index
+     * Must be called from the game thread. The result is broadcast on the game thread, sorted by file path
+     */
+    void Scan(const FString& Directory, const FOnMusicLibraryScanCompletedNative& OnCompleted);
+
+    const TArray<FMusicLibraryEntry>& GetEntries() const { return Entries; }
+
+    bool IsScanning() const { return NumOfPendingHeaders > 0; }
+
+    /**
+     * Reads the duration, sample rate and channel count of an MP3 file from its first frame header and Xing/Info or VBRI header
+     * Only the tag headers and the first few kilobytes of audio are read from disk
+     */
+    static bool ReadMP3HeaderInfo(const FString& FilePath, float& OutDuration, int32& OutSampleRate, int32& OutNumOfChannels);
+
+    /** Path of the file the index of the directory is persisted to */
+    static FString GetIndexFilePath(const FString& Directory);
+
+private:
+    void OnFilesEnumerated(TArray<FMusicLibraryEntry>&& UnchangedEntries, TArray<FMusicLibraryEntry>&& ChangedEntries);
+    void OnHeaderRead(FMusicLibraryEntry&& Entry, bool bSucceeded);
+    void FinishScan();
+
+    bool LoadIndex();
+    void SaveIndex() const;
+
+    FString ScannedDirectory;
+    TArray<FMusicLibraryEntry> Entries;
+    TArray<FMusicLibraryEntry> ScanResults;
+    int32 NumOfPendingHeaders = 0;
+    FOnMusicLibraryScanCompletedNative PendingOnCompleted;
+};